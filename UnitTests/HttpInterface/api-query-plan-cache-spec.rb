@@ -0,0 +1,133 @@
+# coding: utf-8
+
+require 'rspec'
+require 'arangodb.rb'
+require 'json'
+
+describe ArangoDB do
+
+  before do
+    @api = "/_api/query/plan-cache"
+    @prefix = "api-query-plan-cache"
+    @cursor = "/_api/cursor"
+    @cn = "UnitTestsPlanCache"
+  end
+
+  def run_query (query, bindVars = {}, options = {})
+    body = JSON.dump({query: query, bindVars: bindVars, options: options})
+    doc = ArangoDB.log_post("#{@prefix}-cursor", @cursor, :body => body)
+    doc.code.should eq(201)
+    doc.parsed_response['error'].should eq(false)
+    doc
+  end
+
+  def statistics
+    doc = ArangoDB.log_get(@prefix, @api)
+    doc.code.should eq(200)
+    doc.parsed_response
+  end
+
+  describe "plan cache" do
+
+    before do
+      ArangoDB.drop_collection(@cn)
+      ArangoDB.create_collection(@cn)
+      (1..10).each do |i|
+        run_query("INSERT { value: #{i} } INTO #{@cn}")
+      end
+      ArangoDB.log_delete(@prefix, @api)
+    end
+
+    after do
+      ArangoDB.drop_collection(@cn)
+      ArangoDB.log_delete(@prefix, @api)
+    end
+
+    it "returns the statistics" do
+      doc = ArangoDB.log_get(@prefix, @api)
+
+      doc.code.should eq(200)
+      doc.headers['content-type'].should eq("application/json; charset=utf-8")
+      doc.parsed_response['error'].should eq(false)
+      doc.parsed_response['maxEntries'].should be_kind_of(Integer)
+      doc.parsed_response['entries'].should eq(0)
+      doc.parsed_response['hits'].should eq(0)
+      doc.parsed_response['misses'].should eq(0)
+    end
+
+    it "reuses the plan of a repeated query" do
+      query = "FOR doc IN #{@cn} FILTER doc.value > @value SORT doc.value RETURN doc.value"
+
+      doc = run_query(query, { value: 5 })
+      doc.parsed_response['result'].should eq([ 6, 7, 8, 9, 10 ])
+
+      doc = run_query(query, { value: 5 })
+      doc.parsed_response['result'].should eq([ 6, 7, 8, 9, 10 ])
+
+      stats = statistics
+      stats['entries'].should eq(1)
+      stats['hits'].should eq(1)
+      stats['misses'].should eq(1)
+    end
+
+    it "does not reuse the plan for other bind parameter values" do
+      query = "FOR doc IN #{@cn} FILTER doc.value > @value SORT doc.value RETURN doc.value"
+
+      doc = run_query(query, { value: 5 })
+      doc.parsed_response['result'].should eq([ 6, 7, 8, 9, 10 ])
+
+      doc = run_query(query, { value: 8 })
+      doc.parsed_response['result'].should eq([ 9, 10 ])
+
+      stats = statistics
+      stats['entries'].should eq(2)
+      stats['hits'].should eq(0)
+      stats['misses'].should eq(2)
+    end
+
+    it "does not use the cache if turned off for the query" do
+      query = "FOR doc IN #{@cn} SORT doc.value LIMIT 2 RETURN doc.value"
+
+      run_query(query, { }, { planCache: false })
+      doc = run_query(query, { }, { planCache: false })
+      doc.parsed_response['result'].should eq([ 1, 2 ])
+
+      stats = statistics
+      stats['entries'].should eq(0)
+      stats['hits'].should eq(0)
+    end
+
+    it "invalidates plans when an index is created" do
+      query = "FOR doc IN #{@cn} FILTER doc.value == 3 RETURN doc.value"
+
+      run_query(query)
+      statistics['entries'].should eq(1)
+
+      cmd = "/_api/index?collection=#{@cn}"
+      body = "{ \"type\" : \"skiplist\", \"fields\" : [ \"value\" ] }"
+      doc = ArangoDB.log_post("#{@prefix}-index", cmd, :body => body)
+      doc.code.should eq(201)
+
+      stats = statistics
+      stats['entries'].should eq(0)
+      stats['invalidations'].should eq(1)
+
+      doc = run_query(query)
+      doc.parsed_response['result'].should eq([ 3 ])
+      statistics['hits'].should eq(0)
+    end
+
+    it "clears the cache" do
+      run_query("FOR doc IN #{@cn} RETURN doc.value")
+      statistics['entries'].should eq(1)
+
+      doc = ArangoDB.log_delete(@prefix, @api)
+      doc.code.should eq(200)
+      doc.parsed_response['error'].should eq(false)
+
+      statistics['entries'].should eq(0)
+    end
+
+  end
+
+end
@@ -26,6 +26,59 @@
 using namespace arangodb::basics;
 using namespace arangodb::aql;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the `null` value
+////////////////////////////////////////////////////////////////////////////////
+
+static inline AqlValue NullValue() {
+  return AqlValue(new arangodb::basics::Json(arangodb::basics::Json::Null));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a number can be used in an aggregation state
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool IsFinite(double number) {
+  return (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the numbers of a partial state that consists of an array
+/// of n numbers. returns false if the state does not have this structure
+////////////////////////////////////////////////////////////////////////////////
+
+static bool StateToNumbers(arangodb::AqlTransaction* trx,
+                           AqlValue const& state, double* numbers,
+                           size_t n) {
+  if (!state.isArray() || state.arraySize() != n) {
+    return false;
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    Json member = state.at(trx, i);
+    if (!member.isNumber()) {
+      return false;
+    }
+    numbers[i] = member.json()->_value._number;
+    if (!IsFinite(numbers[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a partial state that consists of an array of numbers
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue NumbersToState(double const* numbers, size_t n) {
+  auto state = std::make_unique<Json>(Json::Array, n);
+  for (size_t i = 0; i < n; ++i) {
+    state->add(Json(numbers[i]));
+  }
+  return AqlValue(state.release());
+}
+
 Aggregator* Aggregator::fromTypeString(arangodb::AqlTransaction* trx,
                                        std::string const& type) {
   if (type == "LENGTH" || type == "COUNT") {
@@ -85,6 +138,16 @@ bool Aggregator::isSupported(std::string const& type) {
           type == "STDDEV_SAMPLE");
 }
 
+std::string Aggregator::mergeType(std::string const& type) {
+  if (type == "LENGTH" || type == "COUNT") {
+    // the partial state of LENGTH/COUNT is the number of values, so the
+    // partial counts need to be added up
+    return "SUM";
+  }
+  // all other functions can merge their own partial states
+  return type;
+}
+
 bool Aggregator::requiresInput(std::string const& type) {
   if (type == "LENGTH" || type == "COUNT") {
     // LENGTH/COUNT do not require its input parameter, so
@@ -108,6 +171,17 @@ AqlValue AggregatorLength::stealValue() {
   return AqlValue(new Json(static_cast<double>(copy)));
 }
 
+void AggregatorLength::merge(AqlValue const& state,
+                             TRI_document_collection_t const*) {
+  bool failed = false;
+  double const number = state.toNumber(failed);
+  if (!failed && number > 0.0) {
+    count += static_cast<uint64_t>(number);
+  }
+}
+
+AqlValue AggregatorLength::stealState() { return stealValue(); }
+
 AggregatorMin::~AggregatorMin() { value.destroy(); }
 
 void AggregatorMin::reset() { value.destroy(); }
@@ -134,6 +208,18 @@ AqlValue AggregatorMin::stealValue() {
   return copy;
 }
 
+void AggregatorMin::merge(AqlValue const& state,
+                          TRI_document_collection_t const* stateColl) {
+  if (!value.isEmpty() && value.isNull(true) && !state.isNull(true)) {
+    // a partial minimum of `null` is only produced if there were no other
+    // values, so any other partial minimum replaces it
+    value.destroy();
+  }
+  reduce(state, stateColl);
+}
+
+AqlValue AggregatorMin::stealState() { return stealValue(); }
+
 AggregatorMax::~AggregatorMax() { value.destroy(); }
 
 void AggregatorMax::reset() { value.destroy(); }
@@ -157,6 +243,15 @@ AqlValue AggregatorMax::stealValue() {
   return copy;
 }
 
+void AggregatorMax::merge(AqlValue const& state,
+                          TRI_document_collection_t const* stateColl) {
+  // `null` compares lower than all other values, so the maximum of the
+  // partial maximums is the maximum
+  reduce(state, stateColl);
+}
+
+AqlValue AggregatorMax::stealState() { return stealValue(); }
+
 void AggregatorSum::reset() {
   sum = 0.0;
   invalid = false;
@@ -191,6 +286,29 @@ AqlValue AggregatorSum::stealValue() {
   return AqlValue(new arangodb::basics::Json(sum));
 }
 
+void AggregatorSum::merge(AqlValue const& state,
+                          TRI_document_collection_t const*) {
+  // the partial state is the sum, or `null` if the sum is invalid
+  if (!invalid && state.isNumber()) {
+    bool failed = false;
+    double const number = state.toNumber(failed);
+    if (!failed && IsFinite(number)) {
+      sum += number;
+      return;
+    }
+  }
+
+  invalid = true;
+}
+
+AqlValue AggregatorSum::stealState() {
+  if (invalid || !IsFinite(sum)) {
+    return NullValue();
+  }
+
+  return AqlValue(new arangodb::basics::Json(sum));
+}
+
 void AggregatorAverage::reset() {
   count = 0;
   sum = 0.0;
@@ -230,6 +348,28 @@ AqlValue AggregatorAverage::stealValue() {
   return AqlValue(new arangodb::basics::Json(sum / static_cast<double>(count)));
 }
 
+void AggregatorAverage::merge(AqlValue const& state,
+                              TRI_document_collection_t const*) {
+  // the partial state is [ count, sum ], or `null` if the values are invalid
+  double numbers[2];
+  if (!invalid && StateToNumbers(trx, state, numbers, 2)) {
+    count += static_cast<uint64_t>(numbers[0]);
+    sum += numbers[1];
+    return;
+  }
+
+  invalid = true;
+}
+
+AqlValue AggregatorAverage::stealState() {
+  if (invalid || !IsFinite(sum)) {
+    return NullValue();
+  }
+
+  double const numbers[] = {static_cast<double>(count), sum};
+  return NumbersToState(numbers, 2);
+}
+
 void AggregatorVarianceBase::reset() {
   count = 0;
   sum = 0.0;
@@ -261,6 +401,47 @@ void AggregatorVarianceBase::reduce(AqlValue const& cmpValue,
   invalid = true;
 }
 
+void AggregatorVarianceBase::merge(AqlValue const& state,
+                                   TRI_document_collection_t const*) {
+  // the partial state is [ count, sum, mean ], with sum being the sum of the
+  // squared differences from the mean, or `null` if the values are invalid.
+  // the states are combined with the pairwise algorithm by Chan et al.
+  double numbers[3];
+  if (!invalid && StateToNumbers(trx, state, numbers, 3)) {
+    uint64_t const otherCount = static_cast<uint64_t>(numbers[0]);
+
+    if (otherCount == 0) {
+      return;
+    }
+
+    if (count == 0) {
+      count = otherCount;
+      sum = numbers[1];
+      mean = numbers[2];
+      return;
+    }
+
+    double const n = static_cast<double>(count + otherCount);
+    double const delta = numbers[2] - mean;
+    mean += delta * static_cast<double>(otherCount) / n;
+    sum += numbers[1] + delta * delta * static_cast<double>(count) *
+                            static_cast<double>(otherCount) / n;
+    count += otherCount;
+    return;
+  }
+
+  invalid = true;
+}
+
+AqlValue AggregatorVarianceBase::stealState() {
+  if (invalid || !IsFinite(sum) || !IsFinite(mean)) {
+    return NullValue();
+  }
+
+  double const numbers[] = {static_cast<double>(count), sum, mean};
+  return NumbersToState(numbers, 3);
+}
+
 AqlValue AggregatorVariance::stealValue() {
   if (invalid || count == 0 || (count == 1 && !population) || std::isnan(sum) ||
       sum == HUGE_VAL || sum == -HUGE_VAL) {
@@ -49,6 +49,20 @@ struct Aggregator {
                       struct TRI_document_collection_t const*) = 0;
   virtual AqlValue stealValue() = 0;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief combine the aggregator with a partial state, as produced by
+  /// stealState() of another aggregator of the same type
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual void merge(AqlValue const&,
+                     struct TRI_document_collection_t const*) = 0;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the partial state of the aggregator
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual AqlValue stealState() = 0;
+
   static Aggregator* fromTypeString(arangodb::AqlTransaction*,
                                     std::string const&);
   static Aggregator* fromJson(arangodb::AqlTransaction*,
@@ -57,6 +71,13 @@ struct Aggregator {
   static bool isSupported(std::string const&);
   static bool requiresInput(std::string const&);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the aggregate function that merges the partial states of the
+  /// given aggregate function
+  //////////////////////////////////////////////////////////////////////////////
+
+  static std::string mergeType(std::string const&);
+
   arangodb::AqlTransaction* trx;
 };
 
@@ -72,6 +93,9 @@ struct AggregatorLength final : public Aggregator {
   void reduce(AqlValue const&,
               struct TRI_document_collection_t const*) override final;
   AqlValue stealValue() override final;
+  void merge(AqlValue const&,
+             struct TRI_document_collection_t const*) override final;
+  AqlValue stealState() override final;
 
   uint64_t count;
 };
@@ -88,6 +112,9 @@ struct AggregatorMin final : public Aggregator {
   void reduce(AqlValue const&,
               struct TRI_document_collection_t const*) override final;
   AqlValue stealValue() override final;
+  void merge(AqlValue const&,
+             struct TRI_document_collection_t const*) override final;
+  AqlValue stealState() override final;
 
   AqlValue value;
   struct TRI_document_collection_t const* coll;
@@ -105,6 +132,9 @@ struct AggregatorMax final : public Aggregator {
   void reduce(AqlValue const&,
               struct TRI_document_collection_t const*) override final;
   AqlValue stealValue() override final;
+  void merge(AqlValue const&,
+             struct TRI_document_collection_t const*) override final;
+  AqlValue stealState() override final;
 
   AqlValue value;
   struct TRI_document_collection_t const* coll;
@@ -120,6 +150,9 @@ struct AggregatorSum final : public Aggregator {
   void reduce(AqlValue const&,
               struct TRI_document_collection_t const*) override final;
   AqlValue stealValue() override final;
+  void merge(AqlValue const&,
+             struct TRI_document_collection_t const*) override final;
+  AqlValue stealState() override final;
 
   double sum;
   bool invalid;
@@ -135,6 +168,9 @@ struct AggregatorAverage final : public Aggregator {
   void reduce(AqlValue const&,
               struct TRI_document_collection_t const*) override final;
   AqlValue stealValue() override final;
+  void merge(AqlValue const&,
+             struct TRI_document_collection_t const*) override final;
+  AqlValue stealState() override final;
 
   uint64_t count;
   double sum;
@@ -153,6 +189,9 @@ struct AggregatorVarianceBase : public Aggregator {
   void reset() override final;
   void reduce(AqlValue const&,
               struct TRI_document_collection_t const*) override final;
+  void merge(AqlValue const&,
+             struct TRI_document_collection_t const*) override final;
+  AqlValue stealState() override final;
 
   bool const population;
   uint64_t count;
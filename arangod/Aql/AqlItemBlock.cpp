@@ -23,18 +23,30 @@
 
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionNode.h"
+#include "Aql/ResourceUsage.h"
+#include "Basics/VelocyPackHelper.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
 
 using namespace arangodb::aql;
 
 using Json = arangodb::basics::Json;
 using JsonHelper = arangodb::basics::JsonHelper;
+using VelocyPackHelper = arangodb::basics::VelocyPackHelper;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create the block
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlItemBlock::AqlItemBlock(size_t nrItems, RegisterId nrRegs)
-    : _nrItems(nrItems), _nrRegs(nrRegs) {
+AqlItemBlock::AqlItemBlock(ResourceMonitor* resourceMonitor, size_t nrItems,
+                           RegisterId nrRegs)
+    : _nrItems(nrItems),
+      _nrRegs(nrRegs),
+      _resourceMonitor(resourceMonitor),
+      _valueMemoryUsage(0) {
   TRI_ASSERT(nrItems > 0);  // no, empty AqlItemBlocks are not allowed!
 
   if (nrRegs > 0) {
@@ -50,13 +62,19 @@ AqlItemBlock::AqlItemBlock(size_t nrItems, RegisterId nrRegs)
       _docColls.emplace_back(nullptr);
     }
   }
+
+  if (_resourceMonitor != nullptr) {
+    // if this throws, the vectors are freed again by their destructors
+    _resourceMonitor->increaseMemoryUsage(blockMemoryUsage());
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create the block from Json, note that this can throw
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlItemBlock::AqlItemBlock(Json const& json) {
+AqlItemBlock::AqlItemBlock(ResourceMonitor* resourceMonitor, Json const& json)
+    : _resourceMonitor(resourceMonitor), _valueMemoryUsage(0) {
   bool exhausted = JsonHelper::getBooleanValue(json.json(), "exhausted", false);
 
   if (exhausted) {
@@ -80,6 +98,10 @@ AqlItemBlock::AqlItemBlock(Json const& json) {
     }
   }
 
+  if (_resourceMonitor != nullptr) {
+    _resourceMonitor->increaseMemoryUsage(blockMemoryUsage());
+  }
+
   // Now put in the data:
   Json data(json.get("data"));
   Json raw(json.get("raw"));
@@ -153,7 +175,205 @@ AqlItemBlock::AqlItemBlock(Json const& json) {
     }
   } catch (...) {
     destroy();
+    // the destructor is not called for a block whose constructor throws
+    if (_resourceMonitor != nullptr) {
+      _resourceMonitor->decreaseMemoryUsage(blockMemoryUsage());
+    }
+    throw;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the block from VelocyPack, note that this can throw. the
+/// format is the same as for the Json constructor
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock::AqlItemBlock(ResourceMonitor* resourceMonitor,
+                           VPackSlice const& slice)
+    : _resourceMonitor(resourceMonitor), _valueMemoryUsage(0) {
+  if (!slice.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "block must be an object");
+  }
+
+  bool exhausted = VelocyPackHelper::getBooleanValue(slice, "exhausted", false);
+
+  if (exhausted) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "exhausted must be false");
+  }
+
+  _nrItems = VelocyPackHelper::getNumericValue<size_t>(slice, "nrItems", 0);
+  if (_nrItems == 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "nrItems must be > 0");
+  }
+
+  _nrRegs = VelocyPackHelper::getNumericValue<RegisterId>(slice, "nrRegs", 0);
+
+  VPackSlice data = slice.get("data");
+  VPackSlice raw = slice.get("raw");
+
+  if (!data.isArray() || !raw.isArray()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "data and raw must be arrays");
+  }
+
+  // Initialize the data vector:
+  if (_nrRegs > 0) {
+    _data.resize(_nrItems * _nrRegs);
+    _docColls.reserve(_nrRegs);
+    for (size_t i = 0; i < _nrRegs; ++i) {
+      _docColls.emplace_back(nullptr);
+    }
+  }
+
+  // data and raw are both read front to back, so iterators avoid the
+  // index lookups
+  VPackArrayIterator dataIt(data);
+  VPackArrayIterator rawIt(raw);
+
+  // the first two entries of raw are always null
+  rawIt.next();
+  rawIt.next();
+
+  auto nextData = [&dataIt]() -> int64_t {
+    if (!dataIt.valid()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "data is too short");
+    }
+    VPackSlice entry = dataIt.value();
+    if (!entry.isNumber()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "data must contain only numbers");
+    }
+    dataIt.next();
+    return entry.getNumber<int64_t>();
+  };
+
+  std::vector<AqlValue> madeHere;
+  madeHere.reserve(static_cast<size_t>(raw.length()));
+  madeHere.emplace_back();  // an empty AqlValue
+  madeHere.emplace_back();  // another empty AqlValue, indices start w. 2
+
+  if (_resourceMonitor != nullptr) {
+    _resourceMonitor->increaseMemoryUsage(blockMemoryUsage());
+  }
+
+  try {
+    int64_t emptyRun = 0;
+
+    for (RegisterId column = 0; column < _nrRegs; column++) {
+      for (size_t i = 0; i < _nrItems; i++) {
+        if (emptyRun > 0) {
+          emptyRun--;
+          continue;
+        }
+
+        int64_t n = nextData();
+        if (n == 0) {
+          // empty, do nothing here
+        } else if (n == -1) {
+          // empty run:
+          emptyRun = nextData();
+          TRI_ASSERT(emptyRun > 0);
+          emptyRun--;
+        } else if (n == -2) {
+          // a range
+          int64_t low = nextData();
+          int64_t high = nextData();
+          AqlValue a(low, high);
+          try {
+            setValue(i, column, a);
+          } catch (...) {
+            a.destroy();
+            throw;
+          }
+        } else if (n == 1) {
+          // a JSON value
+          if (!rawIt.valid()) {
+            THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                           "raw is too short");
+          }
+          AqlValue a(new Json(TRI_UNKNOWN_MEM_ZONE,
+                              VelocyPackHelper::velocyPackToJson(
+                                  rawIt.value())));
+          rawIt.next();
+          try {
+            setValue(i, column, a);  // if this throws, a is destroyed again
+          } catch (...) {
+            a.destroy();
+            throw;
+          }
+          madeHere.emplace_back(a);
+        } else if (n >= 2 && static_cast<size_t>(n) < madeHere.size()) {
+          setValue(i, column, madeHere[static_cast<size_t>(n)]);
+          // If this throws, all is OK, because it was already put into
+          // the block elsewhere.
+        } else {
+          THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                         "found undefined data value");
+        }
+      }
+    }
+  } catch (...) {
+    destroy();
+    // the destructor is not called for a block whose constructor throws
+    if (_resourceMonitor != nullptr) {
+      _resourceMonitor->decreaseMemoryUsage(blockMemoryUsage());
+    }
+    throw;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the block
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock::~AqlItemBlock() {
+  destroy();
+
+  if (_resourceMonitor != nullptr) {
+    _resourceMonitor->decreaseMemoryUsage(blockMemoryUsage());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief charge the memory of a value the block becomes responsible for
+////////////////////////////////////////////////////////////////////////////////
+
+void AqlItemBlock::increaseValueMemoryUsage(AqlValue const& value) {
+  TRI_ASSERT(_resourceMonitor != nullptr);
+
+  size_t const size = value.memoryUsage();
+  _resourceMonitor->increaseMemoryUsage(size);
+  _valueMemoryUsage += size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief release the memory of a value the block is no longer responsible
+/// for. the size is computed again, so it is capped by the memory charged
+/// for all values of the block in case the value was modified in between
+////////////////////////////////////////////////////////////////////////////////
+
+void AqlItemBlock::decreaseValueMemoryUsage(AqlValue const& value) noexcept {
+  if (_resourceMonitor == nullptr) {
+    return;
   }
+
+  size_t const size = (std::min)(value.memoryUsage(), _valueMemoryUsage);
+  _resourceMonitor->decreaseMemoryUsage(size);
+  _valueMemoryUsage -= size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief release the memory of all values of the block
+////////////////////////////////////////////////////////////////////////////////
+
+void AqlItemBlock::releaseValueMemoryUsage() noexcept {
+  if (_resourceMonitor != nullptr) {
+    _resourceMonitor->decreaseMemoryUsage(_valueMemoryUsage);
+  }
+  _valueMemoryUsage = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -162,6 +382,7 @@ AqlItemBlock::AqlItemBlock(Json const& json) {
 
 void AqlItemBlock::destroy() {
   if (_valueCount.empty()) {
+    releaseValueMemoryUsage();
     return;
   }
 
@@ -174,6 +395,7 @@ void AqlItemBlock::destroy() {
           TRI_ASSERT(it2->second > 0);
 
           if (--(it2->second) == 0) {
+            decreaseValueMemoryUsage(it);
             it.destroy();
             try {
               _valueCount.erase(it2);
@@ -190,6 +412,7 @@ void AqlItemBlock::destroy() {
   }
 
   _valueCount.clear();
+  releaseValueMemoryUsage();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -222,6 +445,7 @@ void AqlItemBlock::shrink(size_t nrItems) {
           TRI_ASSERT(it->second > 0);
 
           if (--it->second == 0) {
+            decreaseValueMemoryUsage(a);
             a.destroy();
             try {
               _valueCount.erase(it);
@@ -256,6 +480,7 @@ void AqlItemBlock::clearRegisters(
           TRI_ASSERT(it->second > 0);
 
           if (--it->second == 0) {
+            decreaseValueMemoryUsage(a);
             a.destroy();
             try {
               _valueCount.erase(it);
@@ -280,7 +505,8 @@ AqlItemBlock* AqlItemBlock::slice(size_t from, size_t to) const {
   std::unordered_map<AqlValue, AqlValue> cache;
   cache.reserve((to - from) * _nrRegs / 4 + 1);
 
-  auto res = std::make_unique<AqlItemBlock>(to - from, _nrRegs);
+  auto res =
+      std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs);
 
   for (RegisterId col = 0; col < _nrRegs; col++) {
     res->_docColls[col] = _docColls[col];
@@ -320,7 +546,7 @@ AqlItemBlock* AqlItemBlock::slice(
     size_t row, std::unordered_set<RegisterId> const& registers) const {
   std::unordered_map<AqlValue, AqlValue> cache;
 
-  auto res = std::make_unique<AqlItemBlock>(1, _nrRegs);
+  auto res = std::make_unique<AqlItemBlock>(_resourceMonitor, 1, _nrRegs);
 
   for (RegisterId col = 0; col < _nrRegs; col++) {
     if (registers.find(col) == registers.end()) {
@@ -364,7 +590,8 @@ AqlItemBlock* AqlItemBlock::slice(std::vector<size_t>& chosen, size_t from,
   std::unordered_map<AqlValue, AqlValue> cache;
   cache.reserve((to - from) * _nrRegs / 4 + 1);
 
-  auto res = std::make_unique<AqlItemBlock>(to - from, _nrRegs);
+  auto res =
+      std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs);
 
   for (RegisterId col = 0; col < _nrRegs; col++) {
     res->_docColls[col] = _docColls[col];
@@ -409,7 +636,8 @@ AqlItemBlock* AqlItemBlock::steal(std::vector<size_t>& chosen, size_t from,
                                   size_t to) {
   TRI_ASSERT(from < to && to <= chosen.size());
 
-  auto res = std::make_unique<AqlItemBlock>(to - from, _nrRegs);
+  auto res =
+      std::make_unique<AqlItemBlock>(_resourceMonitor, to - from, _nrRegs);
 
   for (RegisterId col = 0; col < _nrRegs; col++) {
     res->_docColls[col] = _docColls[col];
@@ -460,7 +688,8 @@ AqlItemBlock* AqlItemBlock::concatenate(
   TRI_ASSERT(totalSize > 0);
   TRI_ASSERT(nrRegs > 0);
 
-  auto res = std::make_unique<AqlItemBlock>(totalSize, nrRegs);
+  auto res = std::make_unique<AqlItemBlock>(blocks[0]->_resourceMonitor,
+                                            totalSize, nrRegs);
 
   size_t pos = 0;
   for (it = blocks.begin(); it != blocks.end(); ++it) {
@@ -575,3 +804,74 @@ Json AqlItemBlock::toJson(arangodb::AqlTransaction* trx) const {
                                                        Json(false));
   return json;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toVelocyPack, add the attributes of a whole AqlItemBlock to an open
+/// VelocyPack object. The attributes are the same as for toJson, but all
+/// numbers in "data" are stored as integers
+////////////////////////////////////////////////////////////////////////////////
+
+void AqlItemBlock::toVelocyPack(arangodb::AqlTransaction* trx,
+                                VPackBuilder& builder) const {
+  TRI_ASSERT(builder.isOpenObject());
+
+  builder.add("nrItems", VPackValue(_nrItems));
+  builder.add("nrRegs", VPackValue(_nrRegs));
+  builder.add("error", VPackValue(false));
+  builder.add("exhausted", VPackValue(false));
+
+  // raw is built separately, as it is filled while data is written
+  VPackBuilder raw;
+  raw.openArray();
+  raw.add(VPackValue(VPackValueType::Null));  // Two nulls in the beginning
+  raw.add(VPackValue(VPackValueType::Null));  // such that indices start with 2
+
+  std::unordered_map<AqlValue, size_t> table;  // remember duplicates
+
+  size_t emptyCount = 0;  // here we count runs of empty AqlValues
+
+  builder.add("data", VPackValue(VPackValueType::Array));
+
+  auto commitEmpties = [&]() {  // this commits an empty run to the data
+    if (emptyCount > 0) {
+      if (emptyCount == 1) {
+        builder.add(VPackValue(0));
+      } else {
+        builder.add(VPackValue(-1));
+        builder.add(VPackValue(emptyCount));
+      }
+      emptyCount = 0;
+    }
+  };
+
+  size_t pos = 2;  // write position in raw
+  for (RegisterId column = 0; column < _nrRegs; column++) {
+    for (size_t i = 0; i < _nrItems; i++) {
+      AqlValue const& a(_data[i * _nrRegs + column]);
+      if (a.isEmpty()) {
+        emptyCount++;
+      } else {
+        commitEmpties();
+        if (a._type == AqlValue::RANGE) {
+          builder.add(VPackValue(-2));
+          builder.add(VPackValue(a._range->_low));
+          builder.add(VPackValue(a._range->_high));
+        } else {
+          auto it = table.find(a);
+          if (it == table.end()) {
+            a.toVelocyPack(trx, _docColls[column], raw);
+            builder.add(VPackValue(1));
+            table.emplace(a, pos++);
+          } else {
+            builder.add(VPackValue(it->second));
+          }
+        }
+      }
+    }
+  }
+  commitEmpties();
+  builder.close();  // data
+
+  raw.close();
+  builder.add("raw", raw.slice());
+}
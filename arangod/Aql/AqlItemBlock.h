@@ -33,8 +33,15 @@
 struct TRI_document_collection_t;
 
 namespace arangodb {
+namespace velocypack {
+class Builder;
+class Slice;
+}
+
 namespace aql {
 
+class ResourceMonitor;
+
 // an <AqlItemBlock> is a <nrItems>x<nrRegs> vector of <AqlValue>s (not
 // pointers). The size of an <AqlItemBlock> is the number of items.
 // Entries in a given column (i.e. all the values of a given register
@@ -52,28 +59,64 @@ namespace aql {
 // copies. Furthermore, when parts of an AqlItemBlock are handed on
 // to another AqlItemBlock, then the <AqlValue>s inside must be copied
 // (deep copy) to make the blocks independent.
+//
+// If the block is created with a <ResourceMonitor>, it charges the memory
+// for its rows and for the values it is responsible for to the monitor,
+// and releases it again when the values are removed or the block is
+// destroyed.
 
 class AqlItemBlock {
   friend class AqlItemBlockManager;
 
  public:
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief create the block
+  /// @brief create the block. the resource monitor may be a nullptr, in
+  /// which case the block's memory is not accounted for
   //////////////////////////////////////////////////////////////////////////////
 
-  AqlItemBlock(size_t nrItems, RegisterId nrRegs);
+  AqlItemBlock(ResourceMonitor*, size_t nrItems, RegisterId nrRegs);
 
-  AqlItemBlock(arangodb::basics::Json const& json);
+  AqlItemBlock(ResourceMonitor*, arangodb::basics::Json const& json);
+
+  AqlItemBlock(ResourceMonitor*, arangodb::velocypack::Slice const& slice);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief destroy the block
   //////////////////////////////////////////////////////////////////////////////
 
-  ~AqlItemBlock() { destroy(); }
+  ~AqlItemBlock();
 
  private:
   void destroy();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief charge the memory of a value the block becomes responsible for
+  //////////////////////////////////////////////////////////////////////////////
+
+  void increaseValueMemoryUsage(AqlValue const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief release the memory of a value the block is no longer responsible
+  /// for. must be called before the value is destroyed
+  //////////////////////////////////////////////////////////////////////////////
+
+  void decreaseValueMemoryUsage(AqlValue const&) noexcept;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief release the memory of all values of the block
+  //////////////////////////////////////////////////////////////////////////////
+
+  void releaseValueMemoryUsage() noexcept;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief memory used by the rows of the block
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t blockMemoryUsage() const {
+    return _data.capacity() * sizeof(AqlValue) +
+           _docColls.capacity() * sizeof(TRI_document_collection_t const*);
+  }
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief getValue, get the value of a register
@@ -109,7 +152,15 @@ class AqlItemBlock {
         TRI_IF_FAILURE("AqlItemBlock::setValue") {
           THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
         }
-        _valueCount.emplace(value, 1);
+        if (_resourceMonitor != nullptr) {
+          increaseValueMemoryUsage(value);
+        }
+        try {
+          _valueCount.emplace(value, 1);
+        } catch (...) {
+          decreaseValueMemoryUsage(value);
+          throw;
+        }
       } else {
         TRI_ASSERT(it->second > 0);
         ++(it->second);
@@ -150,6 +201,7 @@ class AqlItemBlock {
 
       if (it != _valueCount.end()) {
         if (--(it->second) == 0) {
+          decreaseValueMemoryUsage(element);
           try {
             _valueCount.erase(it);
             element.destroy();
@@ -177,6 +229,7 @@ class AqlItemBlock {
 
       if (it != _valueCount.end()) {
         if (--(it->second) == 0) {
+          decreaseValueMemoryUsage(element);
           try {
             _valueCount.erase(it);
           } catch (...) {
@@ -201,6 +254,7 @@ class AqlItemBlock {
     }
 
     _valueCount.clear();
+    releaseValueMemoryUsage();
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -229,6 +283,7 @@ class AqlItemBlock {
       auto it = _valueCount.find(v);
 
       if (it != _valueCount.end()) {
+        decreaseValueMemoryUsage(v);
         _valueCount.erase(it);
       }
     }
@@ -265,6 +320,12 @@ class AqlItemBlock {
 
   inline size_t size() const { return _nrItems; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the resource monitor the block charges its memory to
+  //////////////////////////////////////////////////////////////////////////////
+
+  ResourceMonitor* resourceMonitor() const { return _resourceMonitor; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief getter for _docColls
   //////////////////////////////////////////////////////////////////////////////
@@ -332,6 +393,15 @@ class AqlItemBlock {
 
   arangodb::basics::Json toJson(arangodb::AqlTransaction* trx) const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief toVelocyPack, add the attributes of a whole AqlItemBlock to an
+  /// open VelocyPack object. the result can be used to recreate the
+  /// AqlItemBlock via the VelocyPack constructor
+  //////////////////////////////////////////////////////////////////////////////
+
+  void toVelocyPack(arangodb::AqlTransaction* trx,
+                    arangodb::velocypack::Builder& builder) const;
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief _data, the actual data as a single vector of dimensions _nrItems
@@ -369,6 +439,20 @@ class AqlItemBlock {
   //////////////////////////////////////////////////////////////////////////////
 
   RegisterId _nrRegs;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief _resourceMonitor, the monitor the block charges its memory to,
+  /// may be a nullptr
+  //////////////////////////////////////////////////////////////////////////////
+
+  ResourceMonitor* _resourceMonitor;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief _valueMemoryUsage, memory of the values currently charged by
+  /// the block
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _valueMemoryUsage;
 };
 
 }  // namespace arangodb::aql
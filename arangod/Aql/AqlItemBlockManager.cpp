@@ -30,7 +30,8 @@ using namespace arangodb::aql;
 /// @brief create the manager
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlItemBlockManager::AqlItemBlockManager() : _last(nullptr) {}
+AqlItemBlockManager::AqlItemBlockManager(ResourceMonitor* resourceMonitor)
+    : _last(nullptr), _resourceMonitor(resourceMonitor) {}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the manager
@@ -50,11 +51,15 @@ AqlItemBlock* AqlItemBlockManager::requestBlock(size_t nrItems,
     // don't hand out the same block next time
     _last = nullptr;
     block->eraseAll();
+    // the block may be used for a different node now
+    for (auto& it : block->_docColls) {
+      it = nullptr;
+    }
 
     return block;
   }
 
-  return new AqlItemBlock(nrItems, nrRegs);
+  return new AqlItemBlock(_resourceMonitor, nrItems, nrRegs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -31,14 +31,16 @@ namespace arangodb {
 namespace aql {
 
 class AqlItemBlock;
+class ResourceMonitor;
 
 class AqlItemBlockManager {
  public:
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief create the manager
+  /// @brief create the manager. the blocks handed out charge their memory
+  /// to the resource monitor
   //////////////////////////////////////////////////////////////////////////////
 
-  AqlItemBlockManager();
+  explicit AqlItemBlockManager(ResourceMonitor*);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief destroy the manager
@@ -66,6 +68,12 @@ class AqlItemBlockManager {
   //////////////////////////////////////////////////////////////////////////////
 
   AqlItemBlock* _last;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief resource monitor for the blocks created by the manager
+  //////////////////////////////////////////////////////////////////////////////
+
+  ResourceMonitor* _resourceMonitor;
 };
 }
 }
@@ -110,6 +110,61 @@ void AqlValue::destroy() {
   _type = EMPTY;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief local helper to determine the heap memory used by a JSON value,
+/// not including the TRI_json_t struct itself
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t JsonMemoryUsage(TRI_json_t const* json) {
+  switch (json->_type) {
+    case TRI_JSON_STRING:
+      return json->_value._string.length;
+    case TRI_JSON_ARRAY:
+    case TRI_JSON_OBJECT: {
+      TRI_vector_t const* objects = &json->_value._objects;
+      size_t result = TRI_CapacityVector(objects) * sizeof(TRI_json_t);
+      size_t const n = TRI_LengthVector(objects);
+
+      for (size_t i = 0; i < n; ++i) {
+        result += JsonMemoryUsage(
+            static_cast<TRI_json_t const*>(TRI_AddressVector(objects, i)));
+      }
+      return result;
+    }
+    default:
+      return 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief approximate number of bytes the value owns on the heap
+////////////////////////////////////////////////////////////////////////////////
+
+size_t AqlValue::memoryUsage() const {
+  switch (_type) {
+    case JSON: {
+      TRI_json_t const* json = _json->json();
+      if (json == nullptr) {
+        return sizeof(Json);
+      }
+      return sizeof(Json) + sizeof(TRI_json_t) + JsonMemoryUsage(json);
+    }
+    case DOCVEC: {
+      return sizeof(std::vector<AqlItemBlock*>) +
+             _vector->capacity() * sizeof(AqlItemBlock*);
+    }
+    case RANGE: {
+      return sizeof(Range);
+    }
+    case SHAPED:
+    case EMPTY: {
+      return 0;
+    }
+  }
+
+  return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the name of an AqlValue type
 ////////////////////////////////////////////////////////////////////////////////
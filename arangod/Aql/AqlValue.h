@@ -198,6 +198,13 @@ struct AqlValue {
 
   AqlValue shallowClone() const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief approximate number of bytes the value owns on the heap. blocks of
+  /// a DOCVEC are not included, as they account for their memory themselves
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t memoryUsage() const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief whether or not the AqlValue contains a string value
   //////////////////////////////////////////////////////////////////////////////
@@ -73,6 +73,78 @@ bool IsUnsafeDivision(T l, T r) {
   // note: the caller still has to check whether r is zero (division by zero)
   return (l == (std::numeric_limits<T>::min)() && r == -1);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief batch kernels for the arithmetic operators. they process <n>
+/// values stored in plain arrays without branching on the values, so the
+/// compiler can turn them into SIMD loops. checking the divisor of a
+/// division or modulo for zero is left to the caller
+////////////////////////////////////////////////////////////////////////////////
+
+inline void BatchPlus(double const* l, double const* r, double* out,
+                      size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = l[i] + r[i];
+  }
+}
+
+inline void BatchMinus(double const* l, double const* r, double* out,
+                       size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = l[i] - r[i];
+  }
+}
+
+inline void BatchTimes(double const* l, double const* r, double* out,
+                       size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = l[i] * r[i];
+  }
+}
+
+inline void BatchDivide(double const* l, double const* r, double* out,
+                        size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = l[i] / r[i];
+  }
+}
+
+inline void BatchModulo(double const* l, double const* r, double* out,
+                        size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = fmod(l[i], r[i]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief batch comparison of numbers, producing -1, 0 or 1 per value. the
+/// results are the same as for comparing JSON numbers, i.e. all comparisons
+/// involving NaN produce 1
+////////////////////////////////////////////////////////////////////////////////
+
+inline void BatchCompareNumbers(double const* l, double const* r, int8_t* out,
+                                size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<int8_t>(1 - static_cast<int>(l[i] == r[i]) -
+                                 2 * static_cast<int>(l[i] < r[i]));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief batch comparison of type weights. where the types differ, the
+/// comparison result is replaced by the result of comparing the types
+////////////////////////////////////////////////////////////////////////////////
+
+inline void BatchCompareTypes(uint8_t const* l, uint8_t const* r, int8_t* out,
+                              size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    int const diff = static_cast<int>(l[i]) - static_cast<int>(r[i]);
+    out[i] = (diff == 0)
+                 ? out[i]
+                 : static_cast<int8_t>(static_cast<int>(diff > 0) -
+                                       static_cast<int>(diff < 0));
+  }
+}
 }
 }
 
@@ -1228,21 +1228,28 @@ AstNode* Ast::createNodeCollectionDirection(uint64_t direction, AstNode const* c
 AstNode* Ast::createNodeTraversal(char const* vertexVarName,
                                   size_t vertexVarLength,
                                   AstNode const* direction,
-                                  AstNode const* start, AstNode const* graph) {
+                                  AstNode const* start, AstNode const* graph,
+                                  AstNode const* options) {
   if (vertexVarName == nullptr) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
   AstNode* node = createNode(NODE_TYPE_TRAVERSAL);
 
+  if (options == nullptr) {
+    // no options given. now use default options
+    options = &NopNode;
+  }
+
   node->addMember(direction);
   node->addMember(start);
   node->addMember(graph);
+  node->addMember(options);
 
   AstNode* vertexVar =
       createNodeVariable(vertexVarName, vertexVarLength, false);
   node->addMember(vertexVar);
 
-  TRI_ASSERT(node->numMembers() == 4);
+  TRI_ASSERT(node->numMembers() == 5);
 
   _containsTraversal = true;
 
@@ -1257,17 +1264,18 @@ AstNode* Ast::createNodeTraversal(char const* vertexVarName,
                                   size_t vertexVarLength,
                                   char const* edgeVarName, size_t edgeVarLength,
                                   AstNode const* direction,
-                                  AstNode const* start, AstNode const* graph) {
+                                  AstNode const* start, AstNode const* graph,
+                                  AstNode const* options) {
   if (edgeVarName == nullptr) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
   AstNode* node = createNodeTraversal(vertexVarName, vertexVarLength, direction,
-                                      start, graph);
+                                      start, graph, options);
 
   AstNode* edgeVar = createNodeVariable(edgeVarName, edgeVarLength, false);
   node->addMember(edgeVar);
 
-  TRI_ASSERT(node->numMembers() == 5);
+  TRI_ASSERT(node->numMembers() == 6);
 
   _containsTraversal = true;
 
@@ -1283,13 +1291,114 @@ AstNode* Ast::createNodeTraversal(char const* vertexVarName,
                                   char const* edgeVarName, size_t edgeVarLength,
                                   char const* pathVarName, size_t pathVarLength,
                                   AstNode const* direction,
-                                  AstNode const* start, AstNode const* graph) {
+                                  AstNode const* start, AstNode const* graph,
+                                  AstNode const* options) {
   if (pathVarName == nullptr) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
   AstNode* node =
       createNodeTraversal(vertexVarName, vertexVarLength, edgeVarName,
-                          edgeVarLength, direction, start, graph);
+                          edgeVarLength, direction, start, graph, options);
+
+  AstNode* pathVar = createNodeVariable(pathVarName, pathVarLength, false);
+  node->addMember(pathVar);
+
+  TRI_ASSERT(node->numMembers() == 7);
+
+  _containsTraversal = true;
+
+  return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST shortest path node with only vertex variable
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::createNodeShortestPath(char const* vertexVarName,
+                                     size_t vertexVarLength, uint64_t direction,
+                                     AstNode const* start,
+                                     AstNode const* target,
+                                     AstNode const* graph,
+                                     AstNode const* options) {
+  if (vertexVarName == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+  AstNode* node = createNode(NODE_TYPE_SHORTEST_PATH);
+
+  if (options == nullptr) {
+    // no options given. now use default options
+    options = &NopNode;
+  }
+
+  node->addMember(createNodeValueInt(direction));
+  node->addMember(start);
+  node->addMember(target);
+  node->addMember(graph);
+  node->addMember(options);
+
+  AstNode* vertexVar =
+      createNodeVariable(vertexVarName, vertexVarLength, false);
+  node->addMember(vertexVar);
+
+  TRI_ASSERT(node->numMembers() == 6);
+
+  _containsTraversal = true;
+
+  return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST shortest path node with vertex and edge variable
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::createNodeShortestPath(char const* vertexVarName,
+                                     size_t vertexVarLength,
+                                     char const* edgeVarName,
+                                     size_t edgeVarLength, uint64_t direction,
+                                     AstNode const* start,
+                                     AstNode const* target,
+                                     AstNode const* graph,
+                                     AstNode const* options) {
+  if (edgeVarName == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+  AstNode* node =
+      createNodeShortestPath(vertexVarName, vertexVarLength, direction, start,
+                             target, graph, options);
+
+  AstNode* edgeVar = createNodeVariable(edgeVarName, edgeVarLength, false);
+  node->addMember(edgeVar);
+
+  TRI_ASSERT(node->numMembers() == 7);
+
+  return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AST k shortest paths node
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::createNodeKShortestPaths(char const* pathVarName,
+                                       size_t pathVarLength, uint64_t direction,
+                                       AstNode const* start,
+                                       AstNode const* target,
+                                       AstNode const* graph,
+                                       AstNode const* options) {
+  if (pathVarName == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+  AstNode* node = createNode(NODE_TYPE_K_SHORTEST_PATHS);
+
+  if (options == nullptr) {
+    // no options given. now use default options
+    options = &NopNode;
+  }
+
+  node->addMember(createNodeValueInt(direction));
+  node->addMember(start);
+  node->addMember(target);
+  node->addMember(graph);
+  node->addMember(options);
 
   AstNode* pathVar = createNodeVariable(pathVarName, pathVarLength, false);
   node->addMember(pathVar);
@@ -1508,8 +1617,13 @@ void Ast::injectBindParameters(BindParameters& parameters) {
       // convert into a regular attribute access node to simplify handling later
       return createNodeAttributeAccess(
           node->getMember(0), name->getStringValue(), name->getStringLength());
-    } else if (node->type == NODE_TYPE_TRAVERSAL) {
-      auto graphNode = node->getMember(2);
+    } else if (node->type == NODE_TYPE_TRAVERSAL ||
+               node->type == NODE_TYPE_SHORTEST_PATH ||
+               node->type == NODE_TYPE_K_SHORTEST_PATHS) {
+      // the graph is the third member of a traversal and the fourth member
+      // of a shortest path
+      auto graphNode =
+          node->getMember(node->type == NODE_TYPE_TRAVERSAL ? 2 : 3);
       if (graphNode->type == NODE_TYPE_VALUE) {
         TRI_ASSERT(graphNode->isStringValue());
         std::string graphName = graphNode->getStringValue();
@@ -1604,6 +1718,42 @@ AstNode* Ast::replaceVariableReference(AstNode* node, Variable const* variable,
   return traverseAndModify(node, visitor, nullptr);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace attribute accesses of a variable with the given
+/// expressions. the caller must make sure that there is an expression for
+/// each attribute that is accessed
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode* Ast::replaceAttributeAccess(
+    AstNode* node, Variable const* variable,
+    std::unordered_map<std::string, AstNode const*> const& replacements) {
+  auto visitor = [&](AstNode* node, void*) -> AstNode* {
+    if (node == nullptr) {
+      return nullptr;
+    }
+
+    // attribute access of the variable
+    if (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+      auto sub = node->getMemberUnchecked(0);
+
+      if (sub->type == NODE_TYPE_REFERENCE &&
+          static_cast<Variable const*>(sub->getData()) == variable) {
+        auto it = replacements.find(
+            std::string(node->getStringValue(), node->getStringLength()));
+        TRI_ASSERT(it != replacements.end());
+
+        if (it != replacements.end()) {
+          return clone((*it).second);
+        }
+      }
+    }
+
+    return node;
+  };
+
+  return traverseAndModify(node, visitor, nullptr);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief optimizes the AST
 /// this does not only optimize but also performs a few validations after
@@ -1799,7 +1949,9 @@ void Ast::validateAndOptimize() {
     }
 
     // traversal
-    if (node->type == NODE_TYPE_TRAVERSAL) {
+    if (node->type == NODE_TYPE_TRAVERSAL ||
+        node->type == NODE_TYPE_SHORTEST_PATH ||
+        node->type == NODE_TYPE_K_SHORTEST_PATHS) {
       // traversals must not be used after a modification operation
       if (static_cast<TraversalContext*>(data)->hasSeenAnyWriteNode) {
         THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_ACCESS_AFTER_MODIFICATION);
@@ -542,14 +542,16 @@ class Ast {
   //////////////////////////////////////////////////////////////////////////////
 
   AstNode* createNodeTraversal(char const*, size_t, AstNode const*,
-                               AstNode const*, AstNode const*);
+                               AstNode const*, AstNode const*,
+                               AstNode const*);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief create an AST traversal node with vertex and edge variable
   //////////////////////////////////////////////////////////////////////////////
 
   AstNode* createNodeTraversal(char const*, size_t, char const*, size_t,
-                               AstNode const*, AstNode const*, AstNode const*);
+                               AstNode const*, AstNode const*, AstNode const*,
+                               AstNode const*);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief create an AST traversal node with vertex, edge and path variable
@@ -557,7 +559,31 @@ class Ast {
 
   AstNode* createNodeTraversal(char const*, size_t, char const*, size_t,
                                char const*, size_t, AstNode const*,
-                               AstNode const*, AstNode const*);
+                               AstNode const*, AstNode const*, AstNode const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create an AST shortest path node with only vertex variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  AstNode* createNodeShortestPath(char const*, size_t, uint64_t,
+                                  AstNode const*, AstNode const*,
+                                  AstNode const*, AstNode const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create an AST shortest path node with vertex and edge variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  AstNode* createNodeShortestPath(char const*, size_t, char const*, size_t,
+                                  uint64_t, AstNode const*, AstNode const*,
+                                  AstNode const*, AstNode const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create an AST k shortest paths node
+  //////////////////////////////////////////////////////////////////////////////
+
+  AstNode* createNodeKShortestPaths(char const*, size_t, uint64_t,
+                                    AstNode const*, AstNode const*,
+                                    AstNode const*, AstNode const*);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief create an AST function call node
@@ -617,6 +643,15 @@ class Ast {
 
   AstNode* replaceVariableReference(AstNode*, Variable const*, AstNode const*);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief replace attribute accesses of a variable (e.g. `a.b`) with the
+  /// given expressions, looked up by attribute name
+  //////////////////////////////////////////////////////////////////////////////
+
+  AstNode* replaceAttributeAccess(
+      AstNode*, Variable const*,
+      std::unordered_map<std::string, AstNode const*> const&);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief optimizes the AST
   //////////////////////////////////////////////////////////////////////////////
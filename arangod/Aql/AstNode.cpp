@@ -164,6 +164,8 @@ std::unordered_map<int, std::string const> const AstNode::TypeNames{
     {static_cast<int>(NODE_TYPE_ARRAY_LIMIT), "array limit"},
     {static_cast<int>(NODE_TYPE_DISTINCT), "distinct"},
     {static_cast<int>(NODE_TYPE_TRAVERSAL), "traversal"},
+    {static_cast<int>(NODE_TYPE_SHORTEST_PATH), "shortest path"},
+    {static_cast<int>(NODE_TYPE_K_SHORTEST_PATHS), "k shortest paths"},
     {static_cast<int>(NODE_TYPE_DIRECTION), "direction"},
     {static_cast<int>(NODE_TYPE_COLLECTION_LIST), "collection list"},
     {static_cast<int>(NODE_TYPE_OPERATOR_NARY_AND), "n-ary and"},
@@ -636,6 +638,8 @@ AstNode::AstNode(Ast* ast, arangodb::basics::Json const& json)
     case NODE_TYPE_ARRAY_LIMIT:
     case NODE_TYPE_DISTINCT:
     case NODE_TYPE_TRAVERSAL:
+    case NODE_TYPE_SHORTEST_PATH:
+    case NODE_TYPE_K_SHORTEST_PATHS:
     case NODE_TYPE_DIRECTION:
     case NODE_TYPE_COLLECTION_LIST:
     case NODE_TYPE_OPERATOR_NARY_AND:
@@ -762,6 +766,8 @@ AstNode::AstNode(std::function<void(AstNode*)> registerNode,
     case NODE_TYPE_EXAMPLE:
     case NODE_TYPE_DISTINCT:
     case NODE_TYPE_TRAVERSAL:
+    case NODE_TYPE_SHORTEST_PATH:
+    case NODE_TYPE_K_SHORTEST_PATHS:
     case NODE_TYPE_DIRECTION:
     case NODE_TYPE_COLLECTION_LIST:
     case NODE_TYPE_PASSTHRU:
@@ -2721,6 +2727,8 @@ void AstNode::findVariableAccess(
     case NODE_TYPE_PASSTHRU:
     case NODE_TYPE_DISTINCT:
     case NODE_TYPE_TRAVERSAL:
+    case NODE_TYPE_SHORTEST_PATH:
+    case NODE_TYPE_K_SHORTEST_PATHS:
     case NODE_TYPE_COLLECTION_LIST:
     case NODE_TYPE_DIRECTION:
     case NODE_TYPE_WITH:
@@ -2872,6 +2880,8 @@ AstNode const* AstNode::findReference(AstNode const* findme) const {
     case NODE_TYPE_PASSTHRU:
     case NODE_TYPE_DISTINCT:
     case NODE_TYPE_TRAVERSAL:
+    case NODE_TYPE_SHORTEST_PATH:
+    case NODE_TYPE_K_SHORTEST_PATHS:
     case NODE_TYPE_COLLECTION_LIST:
     case NODE_TYPE_DIRECTION:
     case NODE_TYPE_OPERATOR_NARY_AND:
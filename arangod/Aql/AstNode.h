@@ -202,7 +202,9 @@ enum AstNodeType : uint32_t {
   NODE_TYPE_OPERATOR_BINARY_ARRAY_IN = 71,
   NODE_TYPE_OPERATOR_BINARY_ARRAY_NIN = 72,
   NODE_TYPE_QUANTIFIER = 73,
-  NODE_TYPE_WITH = 74
+  NODE_TYPE_WITH = 74,
+  NODE_TYPE_SHORTEST_PATH = 75,
+  NODE_TYPE_K_SHORTEST_PATHS = 76
 };
 
 static_assert(NODE_TYPE_VALUE < NODE_TYPE_ARRAY, "incorrect node types order");
@@ -85,7 +85,7 @@ int SingletonBlock::getOrSkipSome(size_t,  // atLeast,
   }
 
   if (!skipping) {
-    result = new AqlItemBlock(
+    result = requestBlock(
         1, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]);
 
     try {
@@ -438,7 +438,7 @@ AqlItemBlock* ReturnBlock::getSome(size_t atLeast, size_t atMost) {
   TRI_ASSERT(it != ep->getRegisterPlan()->varInfo.end());
   RegisterId const registerId = it->second.registerId;
 
-  auto stripped = std::make_unique<AqlItemBlock>(n, 1);
+  std::unique_ptr<AqlItemBlock> stripped(requestBlock(n, 1));
 
   for (size_t i = 0; i < n; i++) {
     auto a = res->getValueReference(i, registerId);
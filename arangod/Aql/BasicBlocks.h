@@ -63,7 +63,7 @@ class SingletonBlock : public ExecutionBlock {
 
   bool hasMore() override final { return !_done; }
 
-  int64_t count() const override final { return 1; }
+  int64_t count() override final { return 1; }
 
   int64_t remaining() override final { return _done ? 0 : 1; }
 
@@ -110,7 +110,7 @@ class FilterBlock : public ExecutionBlock {
 
   bool hasMore() override final;
 
-  int64_t count() const override final {
+  int64_t count() override final {
     return -1;  // refuse to work
   }
 
@@ -233,7 +233,7 @@ class NoResultsBlock : public ExecutionBlock {
 
   bool hasMore() override final { return false; }
 
-  int64_t count() const override final { return 0; }
+  int64_t count() override final { return 0; }
 
   int64_t remaining() override final { return 0; }
 
@@ -0,0 +1,743 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "BatchExpression.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/Arithmetic.h"
+#include "Aql/AstNode.h"
+#include "Aql/Expression.h"
+#include "Aql/Query.h"
+#include "Aql/Variable.h"
+#include "Basics/Exceptions.h"
+#include "Basics/JsonHelper.h"
+#include "Basics/json-utilities.h"
+#include "Basics/json.h"
+#include "VocBase/document-collection.h"
+#include "VocBase/VocShaper.h"
+
+using namespace arangodb::aql;
+using Json = arangodb::basics::Json;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build an AqlValue for row <i>
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue BatchColumn::toAqlValue(size_t i) const {
+  switch (types[i]) {
+    case TYPE_BOOL:
+      return AqlValue(new Json(
+          TRI_UNKNOWN_MEM_ZONE,
+          numbers[i] != 0.0 ? &Expression::TrueJson : &Expression::FalseJson,
+          Json::NOFREE));
+    case TYPE_NUMBER:
+      return AqlValue(new Json(numbers[i]));
+    case TYPE_STRING:
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, strings[i], lengths[i]));
+    default:
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &Expression::NullJson,
+                               Json::NOFREE));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the batch expression
+////////////////////////////////////////////////////////////////////////////////
+
+BatchExpression::BatchExpression(AstNode const* node, Query* query)
+    : _node(node),
+      _query(query),
+      _leaves(),
+      _warnings(),
+      _trx(nullptr),
+      _block(nullptr),
+      _vars(nullptr),
+      _regs(nullptr),
+      _fallback(nullptr),
+      _n(0) {
+  TRI_ASSERT(IsSupported(node));
+  collectLeaves(node);
+}
+
+BatchExpression::~BatchExpression() {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an expression can be evaluated in batches
+////////////////////////////////////////////////////////////////////////////////
+
+bool BatchExpression::IsSupported(AstNode const* node) {
+  // plain values, references and attribute accesses are handled more
+  // efficiently by the other expression types
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_UNARY_NOT:
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR:
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+    case NODE_TYPE_OPERATOR_BINARY_PLUS:
+    case NODE_TYPE_OPERATOR_BINARY_MINUS:
+    case NODE_TYPE_OPERATOR_BINARY_TIMES:
+    case NODE_TYPE_OPERATOR_BINARY_DIV:
+    case NODE_TYPE_OPERATOR_BINARY_MOD:
+    case NODE_TYPE_OPERATOR_TERNARY:
+      return IsSupportedNode(node);
+    default:
+      return false;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a node and its members can be evaluated in batches
+////////////////////////////////////////////////////////////////////////////////
+
+bool BatchExpression::IsSupportedNode(AstNode const* node) {
+  switch (node->type) {
+    case NODE_TYPE_VALUE:
+      return (node->isNullValue() || node->isBoolValue() ||
+              node->isNumericValue() || node->isStringValue());
+
+    case NODE_TYPE_REFERENCE:
+      return true;
+
+    case NODE_TYPE_ATTRIBUTE_ACCESS: {
+      auto member = node->getMember(0);
+      while (member->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+        member = member->getMember(0);
+      }
+      return (member->type == NODE_TYPE_REFERENCE);
+    }
+
+    case NODE_TYPE_OPERATOR_UNARY_NOT:
+      return IsSupportedNode(node->getMember(0));
+
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR:
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+    case NODE_TYPE_OPERATOR_BINARY_PLUS:
+    case NODE_TYPE_OPERATOR_BINARY_MINUS:
+    case NODE_TYPE_OPERATOR_BINARY_TIMES:
+    case NODE_TYPE_OPERATOR_BINARY_DIV:
+    case NODE_TYPE_OPERATOR_BINARY_MOD:
+      return (IsSupportedNode(node->getMember(0)) &&
+              IsSupportedNode(node->getMember(1)));
+
+    case NODE_TYPE_OPERATOR_TERNARY:
+      return (node->numMembers() == 3 && IsSupportedNode(node->getMember(0)) &&
+              IsSupportedNode(node->getMember(1)) &&
+              IsSupportedNode(node->getMember(2)));
+
+    default:
+      return false;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect the attribute access leaves of the expression
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::collectLeaves(AstNode const* node) {
+  if (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    AttributeLeaf leaf;
+    leaf.parts.emplace_back(static_cast<char const*>(node->getData()));
+
+    auto member = node->getMember(0);
+    while (member->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+      leaf.parts.insert(leaf.parts.begin(),
+                        static_cast<char const*>(member->getData()));
+      member = member->getMember(0);
+    }
+    TRI_ASSERT(member->type == NODE_TYPE_REFERENCE);
+
+    for (auto const& it : leaf.parts) {
+      if (!leaf.combinedName.empty()) {
+        leaf.combinedName.push_back('.');
+      }
+      leaf.combinedName.append(it);
+    }
+
+    leaf.variable = static_cast<Variable const*>(member->getData());
+    leaf.collection = nullptr;
+    leaf.shaper = nullptr;
+    leaf.pid = 0;
+
+    _leaves.emplace(node, leaf);
+    return;
+  }
+
+  size_t const n = node->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    collectLeaves(node->getMember(i));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the expression for the active rows of a block
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::execute(arangodb::AqlTransaction* trx,
+                              AqlItemBlock const* block,
+                              std::vector<Variable const*> const& vars,
+                              std::vector<RegisterId> const& regs,
+                              std::vector<uint8_t> const& active,
+                              BatchColumn& result,
+                              std::vector<uint8_t>& fallback) {
+  _trx = trx;
+  _block = block;
+  _vars = &vars;
+  _regs = &regs;
+  _fallback = &fallback;
+  _n = block->size();
+
+  TRI_ASSERT(active.size() == _n);
+
+  fallback.assign(_n, 0);
+  _warnings.assign(_n, 0);
+
+  evaluate(_node, active, result);
+
+  // warnings are only registered now, as the rows that are evaluated one by
+  // one will register their warnings themselves
+  // without a query, rows that produced warnings are flagged for fallback,
+  // so the caller can evaluate them again and register the warnings itself
+  for (size_t i = 0; i < _n; ++i) {
+    if (_warnings[i] > 0 && mustEvaluate(active, i)) {
+      if (_query == nullptr) {
+        fallback[i] = 1;
+        continue;
+      }
+      for (uint8_t j = 0; j < _warnings[i]; ++j) {
+        std::string msg("in function '/()': ");
+        msg.append(TRI_errno_string(TRI_ERROR_QUERY_DIVISION_BY_ZERO));
+        _query->registerWarning(TRI_ERROR_QUERY_DIVISION_BY_ZERO, msg.c_str());
+      }
+    }
+  }
+
+  _block = nullptr;
+  _fallback = nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate a node into a column
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::evaluate(AstNode const* node,
+                               std::vector<uint8_t> const& active,
+                               BatchColumn& out) {
+  switch (node->type) {
+    case NODE_TYPE_VALUE:
+      return evaluateValue(node, out);
+    case NODE_TYPE_REFERENCE:
+      return evaluateReference(node, active, out);
+    case NODE_TYPE_ATTRIBUTE_ACCESS:
+      return evaluateAttributeAccess(node, active, out);
+    case NODE_TYPE_OPERATOR_UNARY_NOT:
+      return evaluateNot(node, active, out);
+    case NODE_TYPE_OPERATOR_BINARY_AND:
+    case NODE_TYPE_OPERATOR_BINARY_OR:
+      return evaluateAndOr(node, active, out);
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      return evaluateComparison(node, active, out);
+    case NODE_TYPE_OPERATOR_BINARY_PLUS:
+    case NODE_TYPE_OPERATOR_BINARY_MINUS:
+    case NODE_TYPE_OPERATOR_BINARY_TIMES:
+    case NODE_TYPE_OPERATOR_BINARY_DIV:
+    case NODE_TYPE_OPERATOR_BINARY_MOD:
+      return evaluateArithmetic(node, active, out);
+    case NODE_TYPE_OPERATOR_TERNARY:
+      return evaluateTernary(node, active, out);
+    default: {
+      std::string msg("unhandled type '");
+      msg.append(node->getTypeString());
+      msg.append("' in BatchExpression::evaluate()");
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, msg);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate a constant value
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::evaluateValue(AstNode const* node, BatchColumn& out) {
+  out.reset(_n);
+
+  if (node->isBoolValue()) {
+    out.types.assign(_n, BatchColumn::TYPE_BOOL);
+    out.numbers.assign(_n, node->getBoolValue() ? 1.0 : 0.0);
+  } else if (node->isNumericValue()) {
+    out.types.assign(_n, BatchColumn::TYPE_NUMBER);
+    out.numbers.assign(_n, node->getDoubleValue());
+  } else if (node->isStringValue()) {
+    out.types.assign(_n, BatchColumn::TYPE_STRING);
+    out.strings.assign(_n, node->getStringValue());
+    out.lengths.assign(_n, node->getStringLength());
+    out.hasStrings = true;
+  }
+  // null values are what reset() produced
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate a variable reference
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::evaluateReference(AstNode const* node,
+                                        std::vector<uint8_t> const& active,
+                                        BatchColumn& out) {
+  out.reset(_n);
+
+  RegisterId const reg =
+      registerForVariable(static_cast<Variable const*>(node->getData()));
+
+  for (size_t i = 0; i < _n; ++i) {
+    if (!mustEvaluate(active, i)) {
+      continue;
+    }
+
+    AqlValue const& value = _block->getValueReference(i, reg);
+
+    if (value.isJson()) {
+      setJsonValue(out, i, value._json->json());
+    } else {
+      (*_fallback)[i] = 1;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate an attribute access, e.g. doc.a.b
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::evaluateAttributeAccess(
+    AstNode const* node, std::vector<uint8_t> const& active, BatchColumn& out) {
+  out.reset(_n);
+
+  auto it = _leaves.find(node);
+  TRI_ASSERT(it != _leaves.end());
+  auto& leaf = (*it).second;
+
+  RegisterId const reg = registerForVariable(leaf.variable);
+  TRI_document_collection_t const* collection =
+      _block->getDocumentCollection(reg);
+
+  size_t const numParts = leaf.parts.size();
+
+  for (size_t i = 0; i < _n; ++i) {
+    if (!mustEvaluate(active, i)) {
+      continue;
+    }
+
+    AqlValue const& value = _block->getValueReference(i, reg);
+
+    if (value.isShaped()) {
+      setShapedValue(out, i, leaf, value, collection);
+    } else if (value.isJson()) {
+      TRI_json_t const* json = value._json->json();
+
+      for (size_t j = 0; j < numParts && json != nullptr; ++j) {
+        if (!TRI_IsObjectJson(json)) {
+          json = nullptr;
+          break;
+        }
+        json = TRI_LookupObjectJson(json, leaf.parts[j]);
+      }
+
+      if (json != nullptr) {
+        setJsonValue(out, i, json);
+      }
+      // a missing attribute is null
+    } else {
+      (*_fallback)[i] = 1;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate a logical NOT
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::evaluateNot(AstNode const* node,
+                                  std::vector<uint8_t> const& active,
+                                  BatchColumn& out) {
+  BatchColumn operand;
+  evaluate(node->getMember(0), active, operand);
+
+  out.reset(_n);
+  out.types.assign(_n, BatchColumn::TYPE_BOOL);
+
+  for (size_t i = 0; i < _n; ++i) {
+    out.numbers[i] = operand.isTrue(i) ? 0.0 : 1.0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate a logical AND or OR. like the scalar version, this
+/// evaluates both operands and returns one of them
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::evaluateAndOr(AstNode const* node,
+                                    std::vector<uint8_t> const& active,
+                                    BatchColumn& out) {
+  BatchColumn rhs;
+  evaluate(node->getMember(0), active, out);
+  evaluate(node->getMember(1), active, rhs);
+
+  bool const isAnd = (node->type == NODE_TYPE_OPERATOR_BINARY_AND);
+
+  for (size_t i = 0; i < _n; ++i) {
+    // AND returns the right operand if the left one is true, OR returns it
+    // if the left one is false
+    if (out.isTrue(i) == isAnd) {
+      out.copyFrom(rhs, i);
+    }
+  }
+  out.hasStrings = (out.hasStrings || rhs.hasStrings);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate a comparison
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::evaluateComparison(AstNode const* node,
+                                         std::vector<uint8_t> const& active,
+                                         BatchColumn& out) {
+  BatchColumn lhs;
+  BatchColumn rhs;
+  evaluate(node->getMember(0), active, lhs);
+  evaluate(node->getMember(1), active, rhs);
+
+  std::vector<int8_t> cmp(_n);
+
+  // numbers, booleans and nulls compare by their numeric values if their
+  // types are equal, and by their types otherwise
+  BatchCompareNumbers(lhs.numbers.data(), rhs.numbers.data(), cmp.data(), _n);
+  BatchCompareTypes(lhs.types.data(), rhs.types.data(), cmp.data(), _n);
+
+  if (lhs.hasStrings && rhs.hasStrings) {
+    // strings are compared with the same function and flags as in
+    // Expression::executeSimpleExpressionComparison
+    bool const compareUtf8 = (node->type != NODE_TYPE_OPERATOR_BINARY_EQ &&
+                              node->type != NODE_TYPE_OPERATOR_BINARY_NE);
+
+    for (size_t i = 0; i < _n; ++i) {
+      if (lhs.types[i] != BatchColumn::TYPE_STRING ||
+          rhs.types[i] != BatchColumn::TYPE_STRING || !mustEvaluate(active, i)) {
+        continue;
+      }
+
+      cmp[i] = static_cast<int8_t>(TRI_CompareStringValuesJson(
+          lhs.strings[i], lhs.lengths[i], rhs.strings[i], rhs.lengths[i],
+          compareUtf8));
+    }
+  }
+
+  out.reset(_n);
+  out.types.assign(_n, BatchColumn::TYPE_BOOL);
+
+  double* result = out.numbers.data();
+  int8_t const* c = cmp.data();
+
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_EQ:
+      for (size_t i = 0; i < _n; ++i) {
+        result[i] = static_cast<double>(c[i] == 0);
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_NE:
+      for (size_t i = 0; i < _n; ++i) {
+        result[i] = static_cast<double>(c[i] != 0);
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_LT:
+      for (size_t i = 0; i < _n; ++i) {
+        result[i] = static_cast<double>(c[i] < 0);
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_LE:
+      for (size_t i = 0; i < _n; ++i) {
+        result[i] = static_cast<double>(c[i] <= 0);
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_GT:
+      for (size_t i = 0; i < _n; ++i) {
+        result[i] = static_cast<double>(c[i] > 0);
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_GE:
+      for (size_t i = 0; i < _n; ++i) {
+        result[i] = static_cast<double>(c[i] >= 0);
+      }
+      break;
+    default: {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "unhandled comparison operator");
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate an arithmetic operator
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::evaluateArithmetic(AstNode const* node,
+                                         std::vector<uint8_t> const& active,
+                                         BatchColumn& out) {
+  BatchColumn lhs;
+  BatchColumn rhs;
+  evaluate(node->getMember(0), active, lhs);
+  evaluate(node->getMember(1), active, rhs);
+
+  if (lhs.hasStrings || rhs.hasStrings) {
+    // converting strings to numbers is left to the scalar code
+    for (size_t i = 0; i < _n; ++i) {
+      if (lhs.types[i] == BatchColumn::TYPE_STRING ||
+          rhs.types[i] == BatchColumn::TYPE_STRING) {
+        (*_fallback)[i] = 1;
+      }
+    }
+  }
+
+  out.reset(_n);
+  out.types.assign(_n, BatchColumn::TYPE_NUMBER);
+
+  // nulls and booleans are stored as 0 and 0 / 1, which is exactly what
+  // they are converted to in arithmetic
+  double const* l = lhs.numbers.data();
+  double const* r = rhs.numbers.data();
+  double* result = out.numbers.data();
+
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_PLUS:
+      BatchPlus(l, r, result, _n);
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_MINUS:
+      BatchMinus(l, r, result, _n);
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_TIMES:
+      BatchTimes(l, r, result, _n);
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_DIV:
+      BatchDivide(l, r, result, _n);
+
+      for (size_t i = 0; i < _n; ++i) {
+        if (r[i] == 0.0) {
+          // division by zero produces null and a warning
+          out.types[i] = BatchColumn::TYPE_NULL;
+          result[i] = 0.0;
+
+          if (mustEvaluate(active, i)) {
+            ++_warnings[i];
+          }
+        }
+      }
+      break;
+    case NODE_TYPE_OPERATOR_BINARY_MOD:
+      BatchModulo(l, r, result, _n);
+      break;
+    default: {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "unhandled arithmetic operator");
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate a ternary operator. each branch is only evaluated for the
+/// rows that take it
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::evaluateTernary(AstNode const* node,
+                                      std::vector<uint8_t> const& active,
+                                      BatchColumn& out) {
+  BatchColumn condition;
+  evaluate(node->getMember(0), active, condition);
+
+  std::vector<uint8_t> activeTrue(_n);
+  std::vector<uint8_t> activeFalse(_n);
+
+  for (size_t i = 0; i < _n; ++i) {
+    bool const isTrue = condition.isTrue(i);
+    activeTrue[i] = (active[i] != 0 && isTrue) ? 1 : 0;
+    activeFalse[i] = (active[i] != 0 && !isTrue) ? 1 : 0;
+  }
+
+  BatchColumn falsePart;
+  evaluate(node->getMember(1), activeTrue, out);
+  evaluate(node->getMember(2), activeFalse, falsePart);
+
+  for (size_t i = 0; i < _n; ++i) {
+    if (activeFalse[i] != 0) {
+      out.copyFrom(falsePart, i);
+    }
+  }
+  out.hasStrings = (out.hasStrings || falsePart.hasStrings);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set row <i> of a column from a JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::setJsonValue(BatchColumn& out, size_t i,
+                                   TRI_json_t const* json) {
+  switch (json->_type) {
+    case TRI_JSON_UNUSED:
+    case TRI_JSON_NULL:
+      out.types[i] = BatchColumn::TYPE_NULL;
+      out.numbers[i] = 0.0;
+      break;
+    case TRI_JSON_BOOLEAN:
+      out.types[i] = BatchColumn::TYPE_BOOL;
+      out.numbers[i] = json->_value._boolean ? 1.0 : 0.0;
+      break;
+    case TRI_JSON_NUMBER:
+      out.types[i] = BatchColumn::TYPE_NUMBER;
+      out.numbers[i] = json->_value._number;
+      break;
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE:
+      out.types[i] = BatchColumn::TYPE_STRING;
+      out.strings[i] = json->_value._string.data;
+      out.lengths[i] = json->_value._string.length - 1;
+      out.hasStrings = true;
+      break;
+    default:
+      // arrays and objects
+      (*_fallback)[i] = 1;
+      break;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set row <i> of a column from an attribute of a shaped document
+////////////////////////////////////////////////////////////////////////////////
+
+void BatchExpression::setShapedValue(BatchColumn& out, size_t i,
+                                     AttributeLeaf& leaf, AqlValue const& value,
+                                     TRI_document_collection_t const* collection) {
+  char const* name = leaf.parts[0];
+
+  if (*name == '_' && leaf.parts.size() == 1) {
+    if (strcmp(name, TRI_VOC_ATTRIBUTE_KEY) == 0) {
+      char const* key = TRI_EXTRACT_MARKER_KEY(value._marker);
+      out.types[i] = BatchColumn::TYPE_STRING;
+      out.strings[i] = key;
+      out.lengths[i] = strlen(key);
+      out.hasStrings = true;
+      return;
+    }
+
+    if (strcmp(name, TRI_VOC_ATTRIBUTE_ID) == 0 ||
+        strcmp(name, TRI_VOC_ATTRIBUTE_REV) == 0 ||
+        strcmp(name, TRI_VOC_ATTRIBUTE_FROM) == 0 ||
+        strcmp(name, TRI_VOC_ATTRIBUTE_TO) == 0) {
+      // these must be assembled from the marker
+      (*_fallback)[i] = 1;
+      return;
+    }
+  }
+
+  TRI_ASSERT(collection != nullptr);
+
+  if (leaf.collection != collection) {
+    leaf.collection = collection;
+    leaf.shaper = collection->getShaper();
+    leaf.pid = leaf.shaper->lookupAttributePathByName(leaf.combinedName.c_str());
+  }
+
+  if (leaf.pid == 0) {
+    // attribute does not exist in any document of the collection
+    return;
+  }
+
+  TRI_shaped_json_t document;
+  TRI_EXTRACT_SHAPED_JSON_MARKER(document, value._marker);
+
+  TRI_shaped_json_t json;
+  TRI_shape_t const* shape;
+
+  if (!leaf.shaper->extractShapedJson(&document, 0, leaf.pid, &json, &shape) ||
+      shape == nullptr) {
+    // attribute not present in this document
+    return;
+  }
+
+  switch (shape->_type) {
+    case TRI_SHAPE_NULL:
+      break;
+    case TRI_SHAPE_BOOLEAN:
+      out.types[i] = BatchColumn::TYPE_BOOL;
+      out.numbers[i] =
+          (*reinterpret_cast<TRI_shape_boolean_t const*>(json._data.data) != 0)
+              ? 1.0
+              : 0.0;
+      break;
+    case TRI_SHAPE_NUMBER:
+      out.types[i] = BatchColumn::TYPE_NUMBER;
+      out.numbers[i] =
+          *reinterpret_cast<TRI_shape_number_t const*>(json._data.data);
+      break;
+    case TRI_SHAPE_SHORT_STRING:
+    case TRI_SHAPE_LONG_STRING: {
+      char* data;
+      size_t length;
+      TRI_StringValueShapedJson(shape, json._data.data, &data, &length);
+      out.types[i] = BatchColumn::TYPE_STRING;
+      out.strings[i] = data;
+      out.lengths[i] = length;
+      out.hasStrings = true;
+      break;
+    }
+    default:
+      // arrays and objects
+      (*_fallback)[i] = 1;
+      break;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the register that contains a variable's value
+////////////////////////////////////////////////////////////////////////////////
+
+RegisterId BatchExpression::registerForVariable(Variable const* variable) const {
+  size_t i = 0;
+  for (auto it = _vars->begin(); it != _vars->end(); ++it, ++i) {
+    if ((*it)->name == variable->name) {
+      return (*_regs)[i];
+    }
+  }
+
+  std::string msg("variable not found '");
+  msg.append(variable->name);
+  msg.append("' in BatchExpression");
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, msg);
+}
@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_BATCH_EXPRESSION_H
+#define ARANGOD_AQL_BATCH_EXPRESSION_H 1
+
+#include "Basics/Common.h"
+#include "Aql/AqlValue.h"
+#include "Aql/types.h"
+#include "VocBase/shaped-json.h"
+
+struct TRI_document_collection_t;
+struct TRI_json_t;
+class VocShaper;
+
+namespace arangodb {
+class AqlTransaction;
+
+namespace aql {
+
+class AqlItemBlock;
+struct AstNode;
+class Query;
+struct Variable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the values of an expression for a batch of rows, stored column-wise
+/// in typed vectors. numbers[i] holds the numeric value of numbers and
+/// booleans (0 or 1) and is 0 for null, so that it can be fed into the
+/// arithmetic kernels directly. strings point into the input values and are
+/// only valid as long as the input block is
+////////////////////////////////////////////////////////////////////////////////
+
+struct BatchColumn {
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief value types, in the order in which AQL compares values of
+  /// different types
+  //////////////////////////////////////////////////////////////////////////////
+
+  enum ValueType : uint8_t {
+    TYPE_NULL = 0,
+    TYPE_BOOL = 1,
+    TYPE_NUMBER = 2,
+    TYPE_STRING = 3
+  };
+
+  BatchColumn() : hasStrings(false) {}
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief reset the column to <n> null values
+  //////////////////////////////////////////////////////////////////////////////
+
+  void reset(size_t n) {
+    types.assign(n, TYPE_NULL);
+    numbers.assign(n, 0.0);
+    strings.assign(n, nullptr);
+    lengths.assign(n, 0);
+    hasStrings = false;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the value in row <i> is truthy
+  //////////////////////////////////////////////////////////////////////////////
+
+  inline bool isTrue(size_t i) const {
+    switch (types[i]) {
+      case TYPE_BOOL:
+      case TYPE_NUMBER:
+        return numbers[i] != 0.0;
+      case TYPE_STRING:
+        return lengths[i] != 0;
+      default:
+        return false;
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief copy the value of row <i> from another column
+  //////////////////////////////////////////////////////////////////////////////
+
+  inline void copyFrom(BatchColumn const& other, size_t i) {
+    types[i] = other.types[i];
+    numbers[i] = other.numbers[i];
+    strings[i] = other.strings[i];
+    lengths[i] = other.lengths[i];
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief build an AqlValue for row <i>
+  //////////////////////////////////////////////////////////////////////////////
+
+  AqlValue toAqlValue(size_t) const;
+
+  std::vector<uint8_t> types;
+  std::vector<double> numbers;
+  std::vector<char const*> strings;
+  std::vector<size_t> lengths;
+  bool hasStrings;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluates a simple expression for all rows of an AqlItemBlock at
+/// once. the supported expressions consist of comparison, arithmetic and
+/// logical operators on attribute accesses, variables and constants. rows
+/// whose values are not nulls, booleans, numbers or (for comparisons) strings
+/// are flagged so that the caller can evaluate them one by one
+////////////////////////////////////////////////////////////////////////////////
+
+class BatchExpression {
+ public:
+  BatchExpression(BatchExpression const&) = delete;
+  BatchExpression& operator=(BatchExpression const&) = delete;
+
+  BatchExpression(AstNode const*, Query*);
+
+  ~BatchExpression();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not an expression can be evaluated in batches
+  //////////////////////////////////////////////////////////////////////////////
+
+  static bool IsSupported(AstNode const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluate the expression for the rows of a block that are flagged
+  /// in <active>. rows that must be evaluated one by one are flagged in
+  /// <fallback>
+  //////////////////////////////////////////////////////////////////////////////
+
+  void execute(arangodb::AqlTransaction*, AqlItemBlock const*,
+               std::vector<Variable const*> const&,
+               std::vector<RegisterId> const&,
+               std::vector<uint8_t> const& active, BatchColumn& result,
+               std::vector<uint8_t>& fallback);
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief an attribute access leaf of the expression, e.g. doc.a.b
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct AttributeLeaf {
+    std::vector<char const*> parts;
+    std::string combinedName;
+    Variable const* variable;
+    TRI_document_collection_t const* collection;
+    VocShaper* shaper;
+    TRI_shape_pid_t pid;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not a node and its members can be evaluated in batches
+  //////////////////////////////////////////////////////////////////////////////
+
+  static bool IsSupportedNode(AstNode const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collect the attribute access leaves of the expression
+  //////////////////////////////////////////////////////////////////////////////
+
+  void collectLeaves(AstNode const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluate a node into a column
+  //////////////////////////////////////////////////////////////////////////////
+
+  void evaluate(AstNode const*, std::vector<uint8_t> const&, BatchColumn&);
+
+  void evaluateValue(AstNode const*, BatchColumn&);
+
+  void evaluateReference(AstNode const*, std::vector<uint8_t> const&,
+                         BatchColumn&);
+
+  void evaluateAttributeAccess(AstNode const*, std::vector<uint8_t> const&,
+                               BatchColumn&);
+
+  void evaluateNot(AstNode const*, std::vector<uint8_t> const&, BatchColumn&);
+
+  void evaluateAndOr(AstNode const*, std::vector<uint8_t> const&,
+                     BatchColumn&);
+
+  void evaluateComparison(AstNode const*, std::vector<uint8_t> const&,
+                          BatchColumn&);
+
+  void evaluateArithmetic(AstNode const*, std::vector<uint8_t> const&,
+                          BatchColumn&);
+
+  void evaluateTernary(AstNode const*, std::vector<uint8_t> const&,
+                       BatchColumn&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set row <i> of a column from a JSON value, flags the row for
+  /// fallback if the value type is not supported
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setJsonValue(BatchColumn&, size_t, TRI_json_t const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set row <i> of a column from an attribute of a shaped document,
+  /// flags the row for fallback if the value type is not supported
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setShapedValue(BatchColumn&, size_t, AttributeLeaf&, AqlValue const&,
+                      TRI_document_collection_t const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the register that contains a variable's value
+  //////////////////////////////////////////////////////////////////////////////
+
+  RegisterId registerForVariable(Variable const*) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether row <i> must be evaluated in the current call
+  //////////////////////////////////////////////////////////////////////////////
+
+  inline bool mustEvaluate(std::vector<uint8_t> const& active, size_t i) const {
+    return active[i] != 0 && (*_fallback)[i] == 0;
+  }
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the root node of the expression
+  //////////////////////////////////////////////////////////////////////////////
+
+  AstNode const* _node;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the query, used for registering warnings. may be a nullptr when
+  /// the expression is evaluated outside of the query's thread, in which
+  /// case rows producing warnings are flagged for fallback
+  //////////////////////////////////////////////////////////////////////////////
+
+  Query* _query;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the attribute access leaves of the expression
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unordered_map<AstNode const*, AttributeLeaf> _leaves;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief per-row number of division by zero warnings
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<uint8_t> _warnings;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief state of the current execute() call
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::AqlTransaction* _trx;
+
+  AqlItemBlock const* _block;
+
+  std::vector<Variable const*> const* _vars;
+
+  std::vector<RegisterId> const* _regs;
+
+  std::vector<uint8_t>* _fallback;
+
+  size_t _n;
+};
+}
+}
+
+#endif
@@ -71,6 +71,12 @@ class BindParameters {
 
   uint64_t hash() const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the parameters in their original JSON format
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_json_t const* json() const { return _json; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief strip collection name prefixes from the parameters
   /// the values must be a VelocyPack array
@@ -61,6 +61,10 @@ CalculationBlock::CalculationBlock(ExecutionEngine* engine,
 
   if (_isReference) {
     TRI_ASSERT(_inRegs.size() == 1);
+  } else if (_expression->isBatchable()) {
+    // the expression can be evaluated for a whole block at once
+    _batchExpression.reset(
+        new BatchExpression(_expression->node(), engine->getQuery()));
   }
 
   auto it3 = en->getRegisterPlan()->varInfo.find(en->_outVariable->id);
@@ -119,6 +123,24 @@ void CalculationBlock::executeExpression(AqlItemBlock* result) {
 
   size_t const n = result->size();
 
+  if (_batchExpression != nullptr) {
+    // evaluate the expression for all rows at once. rows with values that
+    // the batch evaluation cannot handle are flagged and evaluated one by one
+    // in the loop below
+    _batchActive.assign(n, 1);
+
+    if (hasCondition) {
+      for (size_t i = 0; i < n; i++) {
+        if (!result->getValueReference(i, _conditionReg).isTrue()) {
+          _batchActive[i] = 0;
+        }
+      }
+    }
+
+    _batchExpression->execute(_trx, result, _inVars, _inRegs, _batchActive,
+                              _batchResult, _batchFallback);
+  }
+
   for (size_t i = 0; i < n; i++) {
     // check the condition variable (if any)
     if (hasCondition) {
@@ -135,10 +157,17 @@ void CalculationBlock::executeExpression(AqlItemBlock* result) {
       }
     }
 
-    // execute the expression
-    TRI_document_collection_t const* myCollection = nullptr;
-    AqlValue a =
-        _expression->execute(_trx, result, i, _inVars, _inRegs, &myCollection);
+    AqlValue a;
+
+    if (_batchExpression != nullptr && _batchFallback[i] == 0) {
+      // take the result of the batch evaluation
+      a = _batchResult.toAqlValue(i);
+    } else {
+      // execute the expression
+      TRI_document_collection_t const* myCollection = nullptr;
+      a = _expression->execute(_trx, result, i, _inVars, _inRegs,
+                               &myCollection);
+    }
 
     try {
       TRI_IF_FAILURE("CalculationBlock::executeExpression") {
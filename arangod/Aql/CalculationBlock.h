@@ -24,6 +24,7 @@
 #ifndef ARANGOD_AQL_CALCULATION_BLOCK_H
 #define ARANGOD_AQL_CALCULATION_BLOCK_H 1
 
+#include "Aql/BatchExpression.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
 #include "Utils/AqlTransaction.h"
@@ -106,6 +107,23 @@ class CalculationBlock : public ExecutionBlock {
   //////////////////////////////////////////////////////////////////////////////
 
   bool _isReference;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluator for the whole block at once, if the expression
+  /// supports it
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unique_ptr<BatchExpression> _batchExpression;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief buffers for the batch evaluation, reused between blocks
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<uint8_t> _batchActive;
+
+  std::vector<uint8_t> _batchFallback;
+
+  BatchColumn _batchResult;
 };
 
 }  // namespace arangodb::aql
@@ -27,6 +27,7 @@
 #include "Basics/json-utilities.h"
 #include "Basics/StringUtils.h"
 #include "Basics/StringBuffer.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Cluster/ClusterComm.h"
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ClusterMethods.h"
@@ -35,6 +36,10 @@
 #include "VocBase/server.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 
@@ -62,7 +67,9 @@ using StringBuffer = arangodb::basics::StringBuffer;
 GatherBlock::GatherBlock(ExecutionEngine* engine, GatherNode const* en)
     : ExecutionBlock(engine, en),
       _sortRegisters(),
-      _isSimple(en->getElements().empty()) {
+      _isSimple(en->getElements().empty()),
+      _limit(en->limit()),
+      _produced(0) {
   if (!_isSimple) {
     for (auto const& p : en->getElements()) {
       // We know that planRegisters has been run, so
@@ -94,7 +101,6 @@ GatherBlock::~GatherBlock() {
 
 int GatherBlock::initialize() {
   ENTER_BLOCK
-  _atDep = 0;
   auto res = ExecutionBlock::initialize();
 
   if (res != TRI_ERROR_NO_ERROR) {
@@ -148,7 +154,12 @@ int GatherBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
     return res;
   }
 
-  _atDep = 0;
+  _activeDependencies.clear();
+  _activeDependencies.reserve(_dependencies.size());
+  for (size_t i = 0; i < _dependencies.size(); i++) {
+    _activeDependencies.emplace_back(i);
+  }
+  _produced = 0;
 
   if (!_isSimple) {
     for (std::deque<AqlItemBlock*>& x : _gatherBlockBuffer) {
@@ -178,7 +189,7 @@ int GatherBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
 /// dependency has count -1
 ////////////////////////////////////////////////////////////////////////////////
 
-int64_t GatherBlock::count() const {
+int64_t GatherBlock::count() {
   ENTER_BLOCK
   int64_t sum = 0;
   for (auto const& x : _dependencies) {
@@ -220,6 +231,13 @@ bool GatherBlock::hasMore() {
     return false;
   }
 
+  size_t atLeast = DefaultBatchSize;
+  size_t atMost = DefaultBatchSize;
+
+  if (!applyLimit(atLeast, atMost)) {
+    return false;
+  }
+
   if (_isSimple) {
     for (size_t i = 0; i < _dependencies.size(); i++) {
       if (_dependencies.at(i)->hasMore()) {
@@ -230,7 +248,7 @@ bool GatherBlock::hasMore() {
     for (size_t i = 0; i < _gatherBlockBuffer.size(); i++) {
       if (!_gatherBlockBuffer.at(i).empty()) {
         return true;
-      } else if (getBlock(i, DefaultBatchSize, DefaultBatchSize)) {
+      } else if (getBlock(i, atLeast, atMost)) {
         _gatherBlockPos.at(i) = std::make_pair(i, 0);
         return true;
       }
@@ -251,111 +269,66 @@ AqlItemBlock* GatherBlock::getSome(size_t atLeast, size_t atMost) {
     return nullptr;
   }
 
+  if (!applyLimit(atLeast, atMost)) {
+    return nullptr;
+  }
+
   // the simple case . . .
   if (_isSimple) {
-    auto res = _dependencies.at(_atDep)->getSome(atLeast, atMost);
-    while (res == nullptr && _atDep < _dependencies.size() - 1) {
-      _atDep++;
-      res = _dependencies.at(_atDep)->getSome(atLeast, atMost);
-    }
-    if (res == nullptr) {
-      _done = true;
+    // all shards work on their next block while we wait for the first one
+    prefetchDependencies(atLeast, atMost);
+
+    while (!_activeDependencies.empty()) {
+      size_t const pos = nextActiveDependency();
+      auto res = _dependencies.at(_activeDependencies[pos])
+                     ->getSomeProfiled(atLeast, atMost);
+      if (res != nullptr) {
+        _produced += res->size();
+        return res;
+      }
+      _activeDependencies.erase(_activeDependencies.begin() + pos);
     }
-    return res;
+    _done = true;
+    return nullptr;
   }
 
   // the non-simple case . . .
-  size_t available = 0;  // nr of available rows
-  size_t index = 0;      // an index of a non-empty buffer
+  prefetchDependencies(atLeast, atMost);
 
   // pull more blocks from dependencies . . .
   for (size_t i = 0; i < _dependencies.size(); i++) {
-    if (_gatherBlockBuffer.at(i).empty()) {
-      if (getBlock(i, atLeast, atMost)) {
-        index = i;
-        _gatherBlockPos.at(i) = std::make_pair(i, 0);
-      }
-    } else {
-      index = i;
-    }
-
-    auto cur = _gatherBlockBuffer.at(i);
-    if (!cur.empty()) {
-      available += cur.at(0)->size() - _gatherBlockPos.at(i).second;
-      for (size_t j = 1; j < cur.size(); j++) {
-        available += cur.at(j)->size();
-      }
+    if (_gatherBlockBuffer.at(i).empty() && getBlock(i, atLeast, atMost)) {
+      _gatherBlockPos.at(i) = std::make_pair(i, 0);
     }
   }
 
-  if (available == 0) {
+  std::vector<size_t> heap;
+  std::vector<TRI_document_collection_t const*> colls;
+  if (!buildHeap(heap, colls)) {
     _done = true;
     return nullptr;
   }
 
-  size_t toSend = (std::min)(available, atMost);  // nr rows in outgoing block
-
-  // get collections for ourLessThan . . .
-  std::vector<TRI_document_collection_t const*> colls;
-  for (RegisterId i = 0; i < _sortRegisters.size(); i++) {
-    colls.emplace_back(
-        _gatherBlockBuffer.at(index).front()->getDocumentCollection(
-            _sortRegisters[i].first));
-  }
-
-  // the following is similar to AqlItemBlock's slice method . . .
-  std::unordered_map<AqlValue, AqlValue> cache;
-
-  // comparison function
-  OurLessThan ourLessThan(_trx, _gatherBlockBuffer, _sortRegisters, colls);
-  AqlItemBlock* example = _gatherBlockBuffer.at(index).front();
+  AqlItemBlock* example = _gatherBlockBuffer.at(heap.front()).front();
   size_t nrRegs = example->getNrRegs();
 
-  auto res = std::make_unique<AqlItemBlock>(
-      toSend, static_cast<arangodb::aql::RegisterId>(nrRegs));
+  std::unique_ptr<AqlItemBlock> res(
+      requestBlock(atMost, static_cast<arangodb::aql::RegisterId>(nrRegs)));
   // automatically deleted if things go wrong
 
   for (RegisterId i = 0; i < nrRegs; i++) {
     res->setDocumentCollection(i, example->getDocumentCollection(i));
   }
 
-  for (size_t i = 0; i < toSend; i++) {
-    // get the next smallest row from the buffer . . .
-    std::pair<size_t, size_t> val = *(std::min_element(
-        _gatherBlockPos.begin(), _gatherBlockPos.end(), ourLessThan));
-
-    // copy the row in to the outgoing block . . .
-    for (RegisterId col = 0; col < nrRegs; col++) {
-      AqlValue const& x(
-          _gatherBlockBuffer.at(val.first).front()->getValue(val.second, col));
-      if (!x.isEmpty()) {
-        auto it = cache.find(x);
-        if (it == cache.end()) {
-          AqlValue y = x.clone();
-          try {
-            res->setValue(i, col, y);
-          } catch (...) {
-            y.destroy();
-            throw;
-          }
-          cache.emplace(x, y);
-        } else {
-          res->setValue(i, col, it->second);
-        }
-      }
-    }
+  size_t toSend = mergeRows(heap, colls, atLeast, atMost, res.get());
+  TRI_ASSERT(toSend > 0);
 
-    // renew the _gatherBlockPos and clean up the buffer if necessary
-    _gatherBlockPos.at(val.first).second++;
-    if (_gatherBlockPos.at(val.first).second ==
-        _gatherBlockBuffer.at(val.first).front()->size()) {
-      AqlItemBlock* cur = _gatherBlockBuffer.at(val.first).front();
-      delete cur;
-      _gatherBlockBuffer.at(val.first).pop_front();
-      _gatherBlockPos.at(val.first) = std::make_pair(val.first, 0);
-    }
+  if (toSend < atMost) {
+    res->shrink(toSend);
   }
 
+  _produced += toSend;
+
   return res.release();
   LEAVE_BLOCK
 }
@@ -370,77 +343,48 @@ size_t GatherBlock::skipSome(size_t atLeast, size_t atMost) {
     return 0;
   }
 
+  if (!applyLimit(atLeast, atMost)) {
+    return 0;
+  }
+
   // the simple case . . .
   if (_isSimple) {
-    auto skipped = _dependencies.at(_atDep)->skipSome(atLeast, atMost);
-    while (skipped == 0 && _atDep < _dependencies.size() - 1) {
-      _atDep++;
-      skipped = _dependencies.at(_atDep)->skipSome(atLeast, atMost);
-    }
-    if (skipped == 0) {
-      _done = true;
+    while (!_activeDependencies.empty()) {
+      size_t const pos = nextActiveDependency();
+      auto skipped = _dependencies.at(_activeDependencies[pos])
+                         ->skipSomeProfiled(atLeast, atMost);
+      if (skipped > 0) {
+        _produced += skipped;
+        return skipped;
+      }
+      _activeDependencies.erase(_activeDependencies.begin() + pos);
     }
-    return skipped;
+    _done = true;
+    return 0;
   }
 
   // the non-simple case . . .
-  size_t available = 0;  // nr of available rows
-  size_t index = 0;      // an index of a non-empty buffer
   TRI_ASSERT(_dependencies.size() != 0);
 
+  prefetchDependencies(atLeast, atMost);
+
   // pull more blocks from dependencies . . .
   for (size_t i = 0; i < _dependencies.size(); i++) {
-    if (_gatherBlockBuffer.at(i).empty()) {
-      if (getBlock(i, atLeast, atMost)) {
-        index = i;
-        _gatherBlockPos.at(i) = std::make_pair(i, 0);
-      }
-    } else {
-      index = i;
-    }
-
-    auto cur = _gatherBlockBuffer.at(i);
-    if (!cur.empty()) {
-      available += cur.at(0)->size() - _gatherBlockPos.at(i).second;
-      for (size_t j = 1; j < cur.size(); j++) {
-        available += cur.at(j)->size();
-      }
+    if (_gatherBlockBuffer.at(i).empty() && getBlock(i, atLeast, atMost)) {
+      _gatherBlockPos.at(i) = std::make_pair(i, 0);
     }
   }
 
-  if (available == 0) {
+  std::vector<size_t> heap;
+  std::vector<TRI_document_collection_t const*> colls;
+  if (!buildHeap(heap, colls)) {
     _done = true;
     return 0;
   }
 
-  size_t skipped = (std::min)(available, atMost);  // nr rows in outgoing block
-
-  // get collections for ourLessThan . . .
-  std::vector<TRI_document_collection_t const*> colls;
-  for (RegisterId i = 0; i < _sortRegisters.size(); i++) {
-    colls.emplace_back(
-        _gatherBlockBuffer.at(index).front()->getDocumentCollection(
-            _sortRegisters[i].first));
-  }
-
-  // comparison function
-  OurLessThan ourLessThan(_trx, _gatherBlockBuffer, _sortRegisters, colls);
-
-  for (size_t i = 0; i < skipped; i++) {
-    // get the next smallest row from the buffer . . .
-    std::pair<size_t, size_t> val = *(std::min_element(
-        _gatherBlockPos.begin(), _gatherBlockPos.end(), ourLessThan));
+  size_t skipped = mergeRows(heap, colls, atLeast, atMost, nullptr);
 
-    // renew the _gatherBlockPos and clean up the buffer if necessary
-    _gatherBlockPos.at(val.first).second++;
-    if (_gatherBlockPos.at(val.first).second ==
-        _gatherBlockBuffer.at(val.first).front()->size()) {
-      AqlItemBlock* cur = _gatherBlockBuffer.at(val.first).front();
-      delete cur;
-      _gatherBlockBuffer.at(val.first).pop_front();
-      _gatherBlockPos.at(val.first) = std::make_pair(val.first, 0);
-    }
-  }
+  _produced += skipped;
 
   return skipped;
   LEAVE_BLOCK
@@ -455,7 +399,7 @@ bool GatherBlock::getBlock(size_t i, size_t atLeast, size_t atMost) {
   ENTER_BLOCK
   TRI_ASSERT(i < _dependencies.size());
   TRI_ASSERT(!_isSimple);
-  AqlItemBlock* docs = _dependencies.at(i)->getSome(atLeast, atMost);
+  AqlItemBlock* docs = _dependencies.at(i)->getSomeProfiled(atLeast, atMost);
   if (docs != nullptr) {
     try {
       _gatherBlockBuffer.at(i).emplace_back(docs);
@@ -471,27 +415,211 @@ bool GatherBlock::getBlock(size_t i, size_t atLeast, size_t atMost) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief OurLessThan: comparison method for elements of _gatherBlockPos
+/// @brief reduce atLeast and atMost to the rows still allowed by the limit.
+/// once the limit is reached, no more rows are requested from the shards
 ////////////////////////////////////////////////////////////////////////////////
 
-bool GatherBlock::OurLessThan::operator()(std::pair<size_t, size_t> const& a,
-                                          std::pair<size_t, size_t> const& b) {
-  // nothing in the buffer is maximum!
-  if (_gatherBlockBuffer.at(a.first).empty()) {
+bool GatherBlock::applyLimit(size_t& atLeast, size_t& atMost) {
+  if (_limit == 0) {
+    return true;
+  }
+
+  if (_produced >= _limit) {
+    _done = true;
     return false;
   }
-  if (_gatherBlockBuffer.at(b.first).empty()) {
-    return true;
+
+  atMost = (std::min)(atMost, _limit - _produced);
+  atLeast = (std::min)(atLeast, atMost);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief let all remote dependencies fetch their next block in parallel.
+/// otherwise the shards would only be asked one after the other
+////////////////////////////////////////////////////////////////////////////////
+
+void GatherBlock::prefetchDependencies(size_t atLeast, size_t atMost) {
+  ENTER_BLOCK
+  for (size_t i = 0; i < _dependencies.size(); i++) {
+    auto dep = _dependencies.at(i);
+
+    if (dep->getPlanNode()->getType() != ExecutionNode::REMOTE) {
+      continue;
+    }
+
+    if (_isSimple) {
+      if (std::find(_activeDependencies.begin(), _activeDependencies.end(),
+                    i) == _activeDependencies.end()) {
+        continue;
+      }
+    } else if (!_gatherBlockBuffer.at(i).empty()) {
+      continue;
+    }
+
+    static_cast<RemoteBlock*>(dep)->prefetch(atLeast, atMost);
+  }
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pick the position in _activeDependencies to read from next. a
+/// dependency that has its data available already is preferred, so a slow
+/// shard does not hold up the rows of the others
+////////////////////////////////////////////////////////////////////////////////
+
+size_t GatherBlock::nextActiveDependency() {
+  ENTER_BLOCK
+  TRI_ASSERT(!_activeDependencies.empty());
+
+  for (size_t pos = 0; pos < _activeDependencies.size(); pos++) {
+    auto dep = _dependencies.at(_activeDependencies[pos]);
+
+    if (dep->getPlanNode()->getType() != ExecutionNode::REMOTE ||
+        static_cast<RemoteBlock*>(dep)->isReady()) {
+      return pos;
+    }
+  }
+
+  // no data available yet. all shards are busy, so we can wait for any of
+  // them
+  return 0;
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief put the dependencies that have rows buffered into a heap, so that
+/// the dependency with the smallest current row is at the front. returns
+/// false if there are no rows at all
+////////////////////////////////////////////////////////////////////////////////
+
+bool GatherBlock::buildHeap(
+    std::vector<size_t>& heap,
+    std::vector<TRI_document_collection_t const*>& colls) {
+  ENTER_BLOCK
+  heap.clear();
+  heap.reserve(_dependencies.size());
+
+  for (size_t i = 0; i < _dependencies.size(); i++) {
+    if (!_gatherBlockBuffer.at(i).empty()) {
+      heap.emplace_back(i);
+    }
   }
 
+  if (heap.empty()) {
+    return false;
+  }
+
+  // get collections for ourLessThan . . .
+  colls.clear();
+  for (RegisterId i = 0; i < _sortRegisters.size(); i++) {
+    colls.emplace_back(_gatherBlockBuffer.at(heap.front())
+                           .front()
+                           ->getDocumentCollection(_sortRegisters[i].first));
+  }
+
+  OurLessThan ourLessThan(_trx, _gatherBlockBuffer, _gatherBlockPos,
+                          _sortRegisters, colls);
+  std::make_heap(heap.begin(), heap.end(), OurGreaterThan(ourLessThan));
+  return true;
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief merge up to atMost rows from the dependencies in the heap, and copy
+/// them into result unless it is a nullptr. a dependency that runs out of
+/// buffered rows is refilled right away, as its next rows may be smaller
+/// than the ones of the other dependencies. returns the number of rows
+////////////////////////////////////////////////////////////////////////////////
+
+size_t GatherBlock::mergeRows(
+    std::vector<size_t>& heap,
+    std::vector<TRI_document_collection_t const*>& colls, size_t atLeast,
+    size_t atMost, AqlItemBlock* result) {
+  ENTER_BLOCK
+  OurLessThan ourLessThan(_trx, _gatherBlockBuffer, _gatherBlockPos,
+                          _sortRegisters, colls);
+  OurGreaterThan ourGreaterThan(ourLessThan);
+
+  // the following is similar to AqlItemBlock's slice method . . .
+  std::unordered_map<AqlValue, AqlValue> cache;
+  RegisterId const nrRegs = (result == nullptr ? 0 : result->getNrRegs());
+
+  size_t n = 0;
+  while (n < atMost && !heap.empty()) {
+    // move the dependency with the next smallest row to the back . . .
+    std::pop_heap(heap.begin(), heap.end(), ourGreaterThan);
+    size_t const dep = heap.back();
+    size_t const row = _gatherBlockPos.at(dep).second;
+    AqlItemBlock* cur = _gatherBlockBuffer.at(dep).front();
+
+    // copy the row in to the outgoing block . . .
+    for (RegisterId col = 0; col < nrRegs; col++) {
+      AqlValue const& x(cur->getValue(row, col));
+      if (!x.isEmpty()) {
+        auto it = cache.find(x);
+        if (it == cache.end()) {
+          AqlValue y = x.clone();
+          try {
+            result->setValue(n, col, y);
+          } catch (...) {
+            y.destroy();
+            throw;
+          }
+          cache.emplace(x, y);
+        } else {
+          result->setValue(n, col, it->second);
+        }
+      }
+    }
+    n++;
+
+    // renew the _gatherBlockPos and clean up the buffer if necessary
+    _gatherBlockPos.at(dep).second++;
+    if (_gatherBlockPos.at(dep).second == cur->size()) {
+      // the cache is keyed by the values of cur, whose memory may be
+      // reused by the blocks fetched below
+      cache.clear();
+      delete cur;
+      _gatherBlockBuffer.at(dep).pop_front();
+      _gatherBlockPos.at(dep) = std::make_pair(dep, 0);
+
+      if (_gatherBlockBuffer.at(dep).empty() &&
+          !getBlock(dep, atLeast, atMost)) {
+        // the dependency is exhausted
+        heap.pop_back();
+        continue;
+      }
+    }
+
+    // put the dependency back with its next row
+    std::push_heap(heap.begin(), heap.end(), ourGreaterThan);
+  }
+
+  return n;
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief OurLessThan: comparison method for dependencies by their current
+/// row in _gatherBlockPos
+////////////////////////////////////////////////////////////////////////////////
+
+bool GatherBlock::OurLessThan::operator()(size_t a, size_t b) {
+  TRI_ASSERT(!_gatherBlockBuffer.at(a).empty());
+  TRI_ASSERT(!_gatherBlockBuffer.at(b).empty());
+
+  AqlItemBlock const* blockA = _gatherBlockBuffer[a].front();
+  AqlItemBlock const* blockB = _gatherBlockBuffer[b].front();
+  size_t const rowA = _gatherBlockPos[a].second;
+  size_t const rowB = _gatherBlockPos[b].second;
+
   size_t i = 0;
   for (auto const& reg : _sortRegisters) {
-    int cmp = AqlValue::Compare(
-        _trx,
-        _gatherBlockBuffer.at(a.first).front()->getValue(a.second, reg.first),
-        _colls[i],
-        _gatherBlockBuffer.at(b.first).front()->getValue(b.second, reg.first),
-        _colls[i], true);
+    int cmp = AqlValue::Compare(_trx, blockA->getValueReference(rowA, reg.first),
+                                _colls[i],
+                                blockB->getValueReference(rowB, reg.first),
+                                _colls[i], true);
 
     if (cmp == -1) {
       return reg.second;
@@ -1317,6 +1445,13 @@ static bool throwExceptionAfterBadSyncRequest(ClusterCommResult* res,
 
 double const RemoteBlock::defaultTimeOut = 3600.0;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief content type for AqlItemBlocks in VelocyPack
+////////////////////////////////////////////////////////////////////////////////
+
+std::string const RemoteBlock::contentTypeVelocyPack =
+    "application/x-velocypack";
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief creates a remote block
 ////////////////////////////////////////////////////////////////////////////////
@@ -1328,7 +1463,11 @@ RemoteBlock::RemoteBlock(ExecutionEngine* engine, RemoteNode const* en,
       _server(server),
       _ownName(ownName),
       _queryId(queryId),
-      _isResponsibleForInitCursor(en->isResponsibleForInitCursor()) {
+      _isResponsibleForInitCursor(en->isResponsibleForInitCursor()),
+      _usePrefetch(ownName.empty()),
+      _useVelocyPack(engine->getQuery()->transferVelocyPack()),
+      _pendingOperation(0),
+      _exhausted(false) {
   TRI_ASSERT(!queryId.empty());
   TRI_ASSERT(
       (arangodb::ServerState::instance()->isCoordinator() && ownName.empty()) ||
@@ -1336,7 +1475,63 @@ RemoteBlock::RemoteBlock(ExecutionEngine* engine, RemoteNode const* en,
        !ownName.empty()));
 }
 
-RemoteBlock::~RemoteBlock() {}
+RemoteBlock::~RemoteBlock() {
+  if (_pendingOperation != 0) {
+    // nobody is interested in the answer anymore
+    ClusterComm::instance()->drop("", 0, _pendingOperation, "");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief local helper to create the body of a getSome or skipSome request
+////////////////////////////////////////////////////////////////////////////////
+
+static std::string buildAtLeastAtMostBody(size_t atLeast, size_t atMost) {
+  Json body(Json::Object, 2);
+  body("atLeast", Json(static_cast<double>(atLeast)))(
+      "atMost", Json(static_cast<double>(atMost)));
+  return body.toString();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief local helper to throw an exception if an asynchronous HTTP request
+/// went wrong
+////////////////////////////////////////////////////////////////////////////////
+
+static void throwExceptionAfterBadAsyncRequest(ClusterCommResult* res) {
+  ENTER_BLOCK
+  if (res->status != CL_COMM_RECEIVED) {
+    if (res->status == CL_COMM_TIMEOUT || res->status == CL_COMM_ERROR) {
+      throwExceptionAfterBadSyncRequest(res, false);
+    }
+
+    // the operation is not known anymore
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
+  }
+
+  if (res->answer_code == arangodb::rest::HttpResponse::OK) {
+    return;
+  }
+
+  std::string errorMessage =
+      std::string("Error message received from shard '") +
+      std::string(res->shardID) + std::string("' on cluster node '") +
+      std::string(res->serverID) + std::string("': ");
+
+  Json json(TRI_UNKNOWN_MEM_ZONE,
+            TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, res->answer->body()));
+  int errorNum = JsonHelper::getNumericValue<int>(json.json(), "errorNum",
+                                                  TRI_ERROR_NO_ERROR);
+  errorMessage += JsonHelper::getStringValue(json.json(), "errorMessage",
+                                             "(no valid error in response)");
+
+  if (errorNum == TRI_ERROR_NO_ERROR) {
+    errorNum = TRI_ERROR_CLUSTER_AQL_COMMUNICATION;
+  }
+
+  THROW_ARANGO_EXCEPTION_MESSAGE(errorNum, errorMessage);
+  LEAVE_BLOCK
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief local helper to send a request
@@ -1344,7 +1539,8 @@ RemoteBlock::~RemoteBlock() {}
 
 std::unique_ptr<ClusterCommResult> RemoteBlock::sendRequest(
     arangodb::rest::HttpRequest::HttpRequestType type,
-    std::string const& urlPart, std::string const& body) const {
+    std::string const& urlPart, std::string const& body,
+    bool isVelocyPack) const {
   ENTER_BLOCK
   ClusterComm* cc = ClusterComm::instance();
 
@@ -1355,6 +1551,12 @@ std::unique_ptr<ClusterCommResult> RemoteBlock::sendRequest(
   if (!_ownName.empty()) {
     headers.emplace("Shard-Id", _ownName);
   }
+  if (_useVelocyPack) {
+    headers.emplace("Accept", contentTypeVelocyPack);
+  }
+  if (isVelocyPack) {
+    headers.emplace("Content-Type", contentTypeVelocyPack);
+  }
 
   auto currentThread = arangodb::rest::DispatcherThread::current();
 
@@ -1377,6 +1579,210 @@ std::unique_ptr<ClusterCommResult> RemoteBlock::sendRequest(
   LEAVE_BLOCK
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief start fetching the next block in the background. the remote query
+/// can only serve one request at a time, so there is at most one outstanding
+/// request, and all other requests wait for it first
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::prefetch(size_t atLeast, size_t atMost) {
+  ENTER_BLOCK
+  if (!_usePrefetch || _pendingOperation != 0 || _exhausted ||
+      !_buffer.empty()) {
+    return;
+  }
+
+  ClusterComm* cc = ClusterComm::instance();
+
+  std::unique_ptr<std::map<std::string, std::string>> headers(
+      new std::map<std::string, std::string>());
+  if (_useVelocyPack) {
+    (*headers)["Accept"] = contentTypeVelocyPack;
+  }
+  auto body = std::make_shared<std::string const>(
+      buildAtLeastAtMostBody(atLeast, atMost));
+
+  auto res = cc->asyncRequest(
+      "AQL", TRI_NewTickServer(), _server,
+      rest::HttpRequest::HTTP_REQUEST_PUT,
+      std::string("/_db/") +
+          arangodb::basics::StringUtils::urlEncode(
+              _engine->getQuery()->trx()->vocbase()->_name) +
+          "/_api/aql/getSome/" + _queryId,
+      body, headers, nullptr, defaultTimeOut);
+
+  // a request that could not be submitted is reported by the next wait
+  _pendingOperation = res.operationID;
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not getSome can return without waiting
+////////////////////////////////////////////////////////////////////////////////
+
+bool RemoteBlock::isReady() {
+  ENTER_BLOCK
+  if (!_buffer.empty() || _exhausted) {
+    return true;
+  }
+
+  if (_pendingOperation == 0) {
+    return false;
+  }
+
+  auto res = ClusterComm::instance()->enquire(_pendingOperation);
+  return (res.status >= CL_COMM_TIMEOUT);
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fetch the next block from the remote side into _buffer
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::fetchBlock(size_t atLeast, size_t atMost) {
+  ENTER_BLOCK
+  if (_pendingOperation != 0) {
+    waitForPrefetch();
+    return;
+  }
+
+  std::unique_ptr<ClusterCommResult> res =
+      sendRequest(rest::HttpRequest::HTTP_REQUEST_PUT, "/_api/aql/getSome/",
+                  buildAtLeastAtMostBody(atLeast, atMost));
+  throwExceptionAfterBadSyncRequest(res.get(), false);
+
+  // If we get here, then res->result is the response which will be
+  // a serialized AqlItemBlock:
+  bool found;
+  std::string contentType =
+      res->result->getHeaderField("content-type", found);
+  StringBuffer const& responseBodyBuf(res->result->getBody());
+  processGetSomeResponse(responseBodyBuf.c_str(), responseBodyBuf.length(),
+                         found && contentType == contentTypeVelocyPack);
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait for the outstanding prefetch request
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::waitForPrefetch() {
+  ENTER_BLOCK
+  TRI_ASSERT(_pendingOperation != 0);
+
+  auto currentThread = arangodb::rest::DispatcherThread::current();
+
+  if (currentThread != nullptr) {
+    currentThread->block();
+  }
+
+  auto res = ClusterComm::instance()->wait("", 0, _pendingOperation, "",
+                                           defaultTimeOut);
+  _pendingOperation = 0;
+
+  if (currentThread != nullptr) {
+    currentThread->unblock();
+  }
+
+  throwExceptionAfterBadAsyncRequest(&res);
+
+  bool found;
+  char const* contentType = res.answer->header("content-type", found);
+  processGetSomeResponse(res.answer->body(), res.answer->bodySize(),
+                         found && contentType != nullptr &&
+                             contentTypeVelocyPack == contentType);
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add the result of a getSome request to _buffer
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::processGetSomeResponse(char const* body, size_t length,
+                                         bool isVelocyPack) {
+  ENTER_BLOCK
+  if (isVelocyPack) {
+    if (length == 0 || VPackSlice(body).byteSize() > length) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CLUSTER_AQL_COMMUNICATION,
+                                     "invalid VelocyPack in getSome response");
+    }
+
+    VPackSlice slice(body);
+
+    if (!slice.isObject()) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
+    }
+
+    ExecutionStats newStats(slice.get("stats"));
+
+    _engine->_stats.addDelta(_deltaStats, newStats);
+    _deltaStats = newStats;
+
+    if (arangodb::basics::VelocyPackHelper::getBooleanValue(slice, "exhausted",
+                                                            true)) {
+      _exhausted = true;
+      return;
+    }
+
+    auto block = std::make_unique<AqlItemBlock>(
+        _engine->getQuery()->resourceMonitor(), slice);
+    _buffer.emplace_back(block.get());
+    block.release();
+    return;
+  }
+
+  Json responseBodyJson(TRI_UNKNOWN_MEM_ZONE,
+                        TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, body));
+
+  ExecutionStats newStats(responseBodyJson.get("stats"));
+
+  _engine->_stats.addDelta(_deltaStats, newStats);
+  _deltaStats = newStats;
+
+  if (JsonHelper::getBooleanValue(responseBodyJson.json(), "exhausted", true)) {
+    _exhausted = true;
+    return;
+  }
+
+  auto block = std::make_unique<AqlItemBlock>(
+      _engine->getQuery()->resourceMonitor(), responseBodyJson);
+  _buffer.emplace_back(block.get());
+  block.release();
+  LEAVE_BLOCK
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief throw away buffered and outstanding results
+////////////////////////////////////////////////////////////////////////////////
+
+void RemoteBlock::discardPrefetched() {
+  ENTER_BLOCK
+  if (_pendingOperation != 0) {
+    // the remote query is busy until the request is answered
+    auto currentThread = arangodb::rest::DispatcherThread::current();
+
+    if (currentThread != nullptr) {
+      currentThread->block();
+    }
+
+    ClusterComm::instance()->wait("", 0, _pendingOperation, "",
+                                  defaultTimeOut);
+    _pendingOperation = 0;
+
+    if (currentThread != nullptr) {
+      currentThread->unblock();
+    }
+  }
+
+  for (auto& it : _buffer) {
+    delete it;
+  }
+  _buffer.clear();
+  _pos = 0;
+  _exhausted = false;
+  LEAVE_BLOCK
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief initialize
 ////////////////////////////////////////////////////////////////////////////////
@@ -1399,6 +1805,8 @@ int RemoteBlock::initialize() {
 
 int RemoteBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
   ENTER_BLOCK
+  discardPrefetched();
+
   // For every call we simply forward via HTTP
 
   if (!_isResponsibleForInitCursor) {
@@ -1406,21 +1814,44 @@ int RemoteBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
     return TRI_ERROR_NO_ERROR;
   }
 
-  Json body(Json::Object, 4);
-  if (items == nullptr) {
-    // first call, items is still a nullptr
-    body("exhausted", Json(true))("error", Json(false));
+  std::string bodyString;
+
+  if (_useVelocyPack) {
+    VPackBuilder body;
+    body.openObject();
+    if (items == nullptr) {
+      // first call, items is still a nullptr
+      body.add("exhausted", VPackValue(true));
+      body.add("error", VPackValue(false));
+    } else {
+      body.add("pos", VPackValue(pos));
+      body.add("items", VPackValue(VPackValueType::Object));
+      items->toVelocyPack(_engine->getQuery()->trx(), body);
+      body.close();
+      body.add("exhausted", VPackValue(false));
+      body.add("error", VPackValue(false));
+    }
+    body.close();
+
+    VPackSlice bodySlice = body.slice();
+    bodyString.assign(reinterpret_cast<char const*>(bodySlice.begin()),
+                      static_cast<size_t>(bodySlice.byteSize()));
   } else {
-    body("pos", Json(static_cast<double>(pos)))(
-        "items", items->toJson(_engine->getQuery()->trx()))(
-        "exhausted", Json(false))("error", Json(false));
+    Json body(Json::Object, 4);
+    if (items == nullptr) {
+      // first call, items is still a nullptr
+      body("exhausted", Json(true))("error", Json(false));
+    } else {
+      body("pos", Json(static_cast<double>(pos)))(
+          "items", items->toJson(_engine->getQuery()->trx()))(
+          "exhausted", Json(false))("error", Json(false));
+    }
+    bodyString = body.toString();
   }
 
-  std::string bodyString(body.toString());
-
   std::unique_ptr<ClusterCommResult> res =
       sendRequest(rest::HttpRequest::HTTP_REQUEST_PUT,
-                  "/_api/aql/initializeCursor/", bodyString);
+                  "/_api/aql/initializeCursor/", bodyString, _useVelocyPack);
   throwExceptionAfterBadSyncRequest(res.get(), false);
 
   // If we get here, then res->result is the response which will be
@@ -1440,6 +1871,7 @@ int RemoteBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
 
 int RemoteBlock::shutdown(int errorCode) {
   ENTER_BLOCK
+  discardPrefetched();
 
   if (!_isResponsibleForInitCursor) {
     // do nothing...
@@ -1492,34 +1924,43 @@ int RemoteBlock::shutdown(int errorCode) {
 
 AqlItemBlock* RemoteBlock::getSome(size_t atLeast, size_t atMost) {
   ENTER_BLOCK
-  // For every call we simply forward via HTTP
-
-  Json body(Json::Object, 2);
-  body("atLeast", Json(static_cast<double>(atLeast)))(
-      "atMost", Json(static_cast<double>(atMost)));
-  std::string bodyString(body.toString());
+  if (_buffer.empty() && !_exhausted) {
+    fetchBlock(atLeast, atMost);
+  }
 
-  std::unique_ptr<ClusterCommResult> res = sendRequest(
-      rest::HttpRequest::HTTP_REQUEST_PUT, "/_api/aql/getSome/", bodyString);
-  throwExceptionAfterBadSyncRequest(res.get(), false);
+  if (_buffer.empty()) {
+    return nullptr;
+  }
 
-  // If we get here, then res->result is the response which will be
-  // a serialized AqlItemBlock:
-  StringBuffer const& responseBodyBuf(res->result->getBody());
-  Json responseBodyJson(
-      TRI_UNKNOWN_MEM_ZONE,
-      TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, responseBodyBuf.begin()));
+  // a prefetched block may be larger than what is asked for now
+  AqlItemBlock* cur = _buffer.front();
+  AqlItemBlock* result;
 
-  ExecutionStats newStats(responseBodyJson.get("stats"));
+  if (_pos == 0 && cur->size() <= atMost) {
+    result = cur;
+    _buffer.pop_front();
+  } else {
+    size_t const to = (std::min)(cur->size(), _pos + atMost);
+    result = cur->slice(_pos, to);
+    _pos = to;
 
-  _engine->_stats.addDelta(_deltaStats, newStats);
-  _deltaStats = newStats;
+    if (_pos == cur->size()) {
+      delete cur;
+      _buffer.pop_front();
+      _pos = 0;
+    }
+  }
 
-  if (JsonHelper::getBooleanValue(responseBodyJson.json(), "exhausted", true)) {
-    return nullptr;
+  // let the remote side work on the next block while the caller is busy
+  // with this one
+  try {
+    prefetch(atLeast, atMost);
+  } catch (...) {
+    delete result;
+    throw;
   }
 
-  return new arangodb::aql::AqlItemBlock(responseBodyJson);
+  return result;
   LEAVE_BLOCK
 }
 
@@ -1529,15 +1970,33 @@ AqlItemBlock* RemoteBlock::getSome(size_t atLeast, size_t atMost) {
 
 size_t RemoteBlock::skipSome(size_t atLeast, size_t atMost) {
   ENTER_BLOCK
-  // For every call we simply forward via HTTP
+  if (_pendingOperation != 0) {
+    waitForPrefetch();
+  }
 
-  Json body(Json::Object, 2);
-  body("atLeast", Json(static_cast<double>(atLeast)))(
-      "atMost", Json(static_cast<double>(atMost)));
-  std::string bodyString(body.toString());
+  if (!_buffer.empty()) {
+    // skip prefetched rows first
+    AqlItemBlock* cur = _buffer.front();
+    size_t const skipped = (std::min)(cur->size() - _pos, atMost);
+    _pos += skipped;
 
-  std::unique_ptr<ClusterCommResult> res = sendRequest(
-      rest::HttpRequest::HTTP_REQUEST_PUT, "/_api/aql/skipSome/", bodyString);
+    if (_pos == cur->size()) {
+      delete cur;
+      _buffer.pop_front();
+      _pos = 0;
+    }
+    return skipped;
+  }
+
+  if (_exhausted) {
+    return 0;
+  }
+
+  // For every call we simply forward via HTTP
+
+  std::unique_ptr<ClusterCommResult> res =
+      sendRequest(rest::HttpRequest::HTTP_REQUEST_PUT, "/_api/aql/skipSome/",
+                  buildAtLeastAtMostBody(atLeast, atMost));
   throwExceptionAfterBadSyncRequest(res.get(), false);
 
   // If we get here, then res->result is the response which will be
@@ -1561,6 +2020,18 @@ size_t RemoteBlock::skipSome(size_t atLeast, size_t atMost) {
 
 bool RemoteBlock::hasMore() {
   ENTER_BLOCK
+  if (_pendingOperation != 0) {
+    waitForPrefetch();
+  }
+
+  if (!_buffer.empty()) {
+    return true;
+  }
+
+  if (_exhausted) {
+    return false;
+  }
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res = sendRequest(
       rest::HttpRequest::HTTP_REQUEST_GET, "/_api/aql/hasMore/", std::string());
@@ -1583,8 +2054,12 @@ bool RemoteBlock::hasMore() {
 /// @brief count
 ////////////////////////////////////////////////////////////////////////////////
 
-int64_t RemoteBlock::count() const {
+int64_t RemoteBlock::count() {
   ENTER_BLOCK
+  if (_pendingOperation != 0) {
+    waitForPrefetch();
+  }
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res = sendRequest(
       rest::HttpRequest::HTTP_REQUEST_GET, "/_api/aql/count/", std::string());
@@ -1610,6 +2085,17 @@ int64_t RemoteBlock::count() const {
 
 int64_t RemoteBlock::remaining() {
   ENTER_BLOCK
+  if (_pendingOperation != 0) {
+    waitForPrefetch();
+  }
+
+  // rows that were already fetched are not counted by the remote side
+  int64_t buffered = 0;
+  for (auto const& it : _buffer) {
+    buffered += static_cast<int64_t>(it->size());
+  }
+  buffered -= static_cast<int64_t>(_pos);
+
   // For every call we simply forward via HTTP
   std::unique_ptr<ClusterCommResult> res =
       sendRequest(rest::HttpRequest::HTTP_REQUEST_GET, "/_api/aql/remaining/",
@@ -1625,7 +2111,12 @@ int64_t RemoteBlock::remaining() {
   if (JsonHelper::getBooleanValue(responseBodyJson.json(), "error", true)) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_CLUSTER_AQL_COMMUNICATION);
   }
-  return JsonHelper::getNumericValue<int64_t>(responseBodyJson.json(),
-                                              "remaining", 0);
+  int64_t remaining = JsonHelper::getNumericValue<int64_t>(
+      responseBodyJson.json(), "remaining", 0);
+
+  if (remaining < 0) {
+    return remaining;
+  }
+  return remaining + buffered;
   LEAVE_BLOCK
 }
@@ -70,7 +70,7 @@ class GatherBlock : public ExecutionBlock {
   /// dependency has count -1
   //////////////////////////////////////////////////////////////////////////////
 
-  int64_t count() const override final;
+  int64_t count() override final;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief remaining: the sum of the remaining() of the dependencies or -1 (if
@@ -106,6 +106,45 @@ class GatherBlock : public ExecutionBlock {
 
   bool getBlock(size_t i, size_t atLeast, size_t atMost);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief reduce atLeast and atMost to the rows still allowed by the limit.
+  /// returns false if the limit has been reached
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool applyLimit(size_t& atLeast, size_t& atMost);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief let all remote dependencies fetch their next block in parallel,
+  /// either the active ones (simple case) or the ones with an empty buffer
+  //////////////////////////////////////////////////////////////////////////////
+
+  void prefetchDependencies(size_t atLeast, size_t atMost);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief pick the position in _activeDependencies to read from next,
+  /// preferring a dependency that has its data available already
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t nextActiveDependency();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief put the dependencies with buffered rows into a heap, ordered by
+  /// their current rows, and determine the collections for comparing them.
+  /// returns false if no rows are buffered. non-simple case only
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool buildHeap(std::vector<size_t>&,
+                 std::vector<TRI_document_collection_t const*>&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief merge up to atMost rows from the heap into the result block, or
+  /// skip them if the block is a nullptr. non-simple case only
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t mergeRows(std::vector<size_t>&,
+                   std::vector<TRI_document_collection_t const*>&, size_t,
+                   size_t, AqlItemBlock*);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief _gatherBlockBuffer: buffer the incoming block from each dependency
   /// separately
@@ -122,11 +161,11 @@ class GatherBlock : public ExecutionBlock {
   std::vector<std::pair<size_t, size_t>> _gatherBlockPos;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief _atDep: currently pulling blocks from _dependencies.at(_atDep),
-  /// simple case only
+  /// @brief indexes of the dependencies that are not yet exhausted, simple
+  /// case only
   //////////////////////////////////////////////////////////////////////////////
 
-  size_t _atDep = 0;
+  std::vector<size_t> _activeDependencies;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief pairs, consisting of variable and sort direction
@@ -142,29 +181,60 @@ class GatherBlock : public ExecutionBlock {
   bool const _isSimple;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief OurLessThan: comparison method for elements of _gatherBlockPos
+  /// @brief maximum number of rows to return or skip (0 = no limit)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t const _limit;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of rows returned or skipped since the last
+  /// initializeCursor
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _produced;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief OurLessThan: comparison method for dependencies, by the rows
+  /// their _gatherBlockPos entries point to. both buffers must be non-empty
   //////////////////////////////////////////////////////////////////////////////
 
   class OurLessThan {
    public:
     OurLessThan(arangodb::AqlTransaction* trx,
                 std::vector<std::deque<AqlItemBlock*>>& gatherBlockBuffer,
+                std::vector<std::pair<size_t, size_t>>& gatherBlockPos,
                 std::vector<std::pair<RegisterId, bool>>& sortRegisters,
                 std::vector<TRI_document_collection_t const*>& colls)
         : _trx(trx),
           _gatherBlockBuffer(gatherBlockBuffer),
+          _gatherBlockPos(gatherBlockPos),
           _sortRegisters(sortRegisters),
           _colls(colls) {}
 
-    bool operator()(std::pair<size_t, size_t> const& a,
-                    std::pair<size_t, size_t> const& b);
+    bool operator()(size_t a, size_t b);
 
    private:
     arangodb::AqlTransaction* _trx;
     std::vector<std::deque<AqlItemBlock*>>& _gatherBlockBuffer;
+    std::vector<std::pair<size_t, size_t>>& _gatherBlockPos;
     std::vector<std::pair<RegisterId, bool>>& _sortRegisters;
     std::vector<TRI_document_collection_t const*>& _colls;
   };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief OurGreaterThan: the reversed OurLessThan, which turns the heap
+  /// functions of the standard library into a min-heap
+  //////////////////////////////////////////////////////////////////////////////
+
+  class OurGreaterThan {
+   public:
+    explicit OurGreaterThan(OurLessThan& lessThan) : _lessThan(lessThan) {}
+
+    bool operator()(size_t a, size_t b) { return _lessThan(b, a); }
+
+   private:
+    OurLessThan& _lessThan;
+  };
 };
 
 class BlockWithClients : public ExecutionBlock {
@@ -466,6 +536,14 @@ class RemoteBlock : public ExecutionBlock {
 
   static double const defaultTimeOut;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief content type for AqlItemBlocks in VelocyPack. getSome answers
+  /// in VelocyPack if it is accepted, and initializeCursor reads VelocyPack
+  /// bodies
+  //////////////////////////////////////////////////////////////////////////////
+
+  static std::string const contentTypeVelocyPack;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief initialize
   //////////////////////////////////////////////////////////////////////////////
@@ -506,7 +584,7 @@ class RemoteBlock : public ExecutionBlock {
   /// @brief count
   //////////////////////////////////////////////////////////////////////////////
 
-  int64_t count() const override final;
+  int64_t count() override final;
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief remaining
@@ -514,6 +592,21 @@ class RemoteBlock : public ExecutionBlock {
 
   int64_t remaining() override final;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief start fetching the next block in the background. this is a no-op
+  /// if a block is already buffered or requested, or the remote side is
+  /// exhausted
+  //////////////////////////////////////////////////////////////////////////////
+
+  void prefetch(size_t atLeast, size_t atMost);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not getSome can return without waiting for the
+  /// remote side
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool isReady();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief internal method to send a request
   //////////////////////////////////////////////////////////////////////////////
@@ -521,7 +614,34 @@ class RemoteBlock : public ExecutionBlock {
  private:
   std::unique_ptr<arangodb::ClusterCommResult> sendRequest(
       rest::HttpRequest::HttpRequestType type, std::string const& urlPart,
-      std::string const& body) const;
+      std::string const& body, bool isVelocyPack = false) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fetch the next block from the remote side into _buffer. waits
+  /// for the outstanding prefetch request if there is one
+  //////////////////////////////////////////////////////////////////////////////
+
+  void fetchBlock(size_t atLeast, size_t atMost);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief wait for the outstanding prefetch request and put its result
+  /// into _buffer
+  //////////////////////////////////////////////////////////////////////////////
+
+  void waitForPrefetch();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief add the result of a getSome request to _buffer
+  //////////////////////////////////////////////////////////////////////////////
+
+  void processGetSomeResponse(char const* body, size_t length,
+                              bool isVelocyPack);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief throw away buffered and outstanding results
+  //////////////////////////////////////////////////////////////////////////////
+
+  void discardPrefetched();
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief our server, can be like "shard:S1000" or like "server:Claus"
@@ -554,6 +674,32 @@ class RemoteBlock : public ExecutionBlock {
   //////////////////////////////////////////////////////////////////////////////
 
   bool const _isResponsibleForInitCursor;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the next block is requested before it is needed.
+  /// this is only done on the coordinator
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool const _usePrefetch;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not AqlItemBlocks are sent and accepted in VelocyPack,
+  /// taken from the transferVelocyPack option of the query
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool const _useVelocyPack;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief operation id of the outstanding getSome request (0 = none)
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t _pendingOperation;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the remote side has reported that it is exhausted
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _exhausted;
 };
 
 }  // namespace arangodb::aql
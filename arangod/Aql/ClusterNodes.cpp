@@ -178,7 +178,8 @@ GatherNode::GatherNode(ExecutionPlan* plan, arangodb::basics::Json const& base,
       _elements(elements),
       _vocbase(plan->getAst()->query()->vocbase()),
       _collection(plan->getAst()->query()->collections()->get(
-          JsonHelper::checkAndGetStringValue(base.json(), "collection"))) {}
+          JsonHelper::checkAndGetStringValue(base.json(), "collection"))),
+      _limit(JsonHelper::getNumericValue<size_t>(base.json(), "limit", 0)) {}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief toVelocyPack, for GatherNode
@@ -202,6 +203,8 @@ void GatherNode::toVelocyPackHelper(VPackBuilder& nodes, bool verbose) const {
     }
   }
 
+  nodes.add("limit", VPackValue(_limit));
+
   // And close it:
   nodes.close();
 }
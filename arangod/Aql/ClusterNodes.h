@@ -426,7 +426,10 @@ class GatherNode : public ExecutionNode {
  public:
   GatherNode(ExecutionPlan* plan, size_t id, TRI_vocbase_t* vocbase,
              Collection const* collection)
-      : ExecutionNode(plan, id), _vocbase(vocbase), _collection(collection) {}
+      : ExecutionNode(plan, id),
+        _vocbase(vocbase),
+        _collection(collection),
+        _limit(0) {}
 
   GatherNode(ExecutionPlan*, arangodb::basics::Json const& base,
              SortElementVector const& elements);
@@ -451,6 +454,8 @@ class GatherNode : public ExecutionNode {
   ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
                        bool withProperties) const override final {
     auto c = new GatherNode(plan, _id, _vocbase, _collection);
+    c->_elements = _elements;
+    c->_limit = _limit;
 
     cloneHelper(c, plan, withDependencies, withProperties);
 
@@ -508,6 +513,19 @@ class GatherNode : public ExecutionNode {
 
   Collection const* collection() const { return _collection; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the maximum number of rows the node needs to produce
+  /// (0 = no limit)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t limit() const { return _limit; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the maximum number of rows the node needs to produce
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setLimit(size_t limit) { _limit = limit; }
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief pairs, consisting of variable and sort direction
@@ -527,6 +545,13 @@ class GatherNode : public ExecutionNode {
   //////////////////////////////////////////////////////////////////////////////
 
   Collection const* _collection;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of rows to produce (0 = no limit). this is set if
+  /// a LIMIT follows the node, so it can stop fetching rows from the shards
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _limit;
 };
 
 }  // namespace arangodb::aql
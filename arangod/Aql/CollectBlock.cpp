@@ -25,7 +25,9 @@
 #include "CollectBlock.h"
 #include "Aql/AqlItemBlock.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
 #include "Basics/Exceptions.h"
+#include "Basics/fasthash.h"
 #include "VocBase/vocbase.h"
 
 using namespace arangodb::aql;
@@ -40,6 +42,28 @@ using StringBuffer = arangodb::basics::StringBuffer;
 
 static AqlValue const EmptyValue;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initial number of slots in the group table of a hashed COLLECT
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const InitialSlots = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of hash bits used per partitioning level, and the resulting
+/// number of partitions a hashed COLLECT spills to in each level
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const PartitionBits = 4;
+
+static size_t const NumPartitions = static_cast<size_t>(1) << PartitionBits;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum partitioning level. partitions that still have too many
+/// groups in this level are aggregated in memory anyway
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const MaxSpillLevel = 8;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the collection for an input register
 /// for a reduce function that does not require input, this will return a
@@ -68,6 +92,35 @@ static inline AqlValue const& GetValueForRegister(AqlItemBlock const* src,
   return src->getValueReference(row, reg);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief feed an input value into an aggregator. when merging, the input
+/// values are the partial states produced by a partial COLLECT
+////////////////////////////////////////////////////////////////////////////////
+
+static inline void ReduceAggregator(Aggregator* aggregator,
+                                    CollectNode::AggregationStep step,
+                                    AqlValue const& value,
+                                    TRI_document_collection_t const* coll) {
+  if (step == CollectNode::AGGREGATION_STEP_MERGE) {
+    aggregator->merge(value, coll);
+  } else {
+    aggregator->reduce(value, coll);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the result of an aggregator. a partial COLLECT returns the
+/// partial states of its aggregators instead of their final values
+////////////////////////////////////////////////////////////////////////////////
+
+static inline AqlValue StealAggregatorValue(Aggregator* aggregator,
+                                            CollectNode::AggregationStep step) {
+  if (step == CollectNode::AGGREGATION_STEP_PARTIAL) {
+    return aggregator->stealState();
+  }
+  return aggregator->stealValue();
+}
+
 SortedCollectBlock::CollectGroup::CollectGroup(bool count)
     : firstRow(0),
       lastRow(0),
@@ -174,6 +227,7 @@ SortedCollectBlock::SortedCollectBlock(ExecutionEngine* engine,
       _currentGroup(en->_count),
       _expressionRegister(ExecutionNode::MaxRegisterId),
       _collectRegister(ExecutionNode::MaxRegisterId),
+      _aggregationStep(en->aggregationStep()),
       _variableNames() {
   for (auto const& p : en->_groupVariables) {
     // We know that planRegisters() has been run, so
@@ -305,11 +359,15 @@ int SortedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
       // done
       _done = true;
 
-      if (isTotalAggregation && _currentGroup.groupLength == 0) {
-        // total aggregation, but have not yet emitted a group
-        res.reset(new AqlItemBlock(1, getPlanNode()
-                                          ->getRegisterPlan()
-                                          ->nrRegs[getPlanNode()->getDepth()]));
+      if (isTotalAggregation && _currentGroup.groupLength == 0 &&
+          _aggregationStep != CollectNode::AGGREGATION_STEP_PARTIAL) {
+        // total aggregation, but have not yet emitted a group.
+        // a partial COLLECT does not emit anything for an empty input, so
+        // the merging COLLECT sees an empty input only if all parts were
+        // empty
+        res.reset(requestBlock(1, getPlanNode()
+                                      ->getRegisterPlan()
+                                      ->nrRegs[getPlanNode()->getDepth()]));
         emitGroup(nullptr, res.get(), skipped);
         result = res.release();
       }
@@ -323,7 +381,7 @@ int SortedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
   AqlItemBlock* cur = _buffer.front();
 
   if (!skipping) {
-    res.reset(new AqlItemBlock(
+    res.reset(requestBlock(
         atMost,
         getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
@@ -456,7 +514,8 @@ int SortedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
               GetCollectionForRegister(cur, reg);
           for (size_t r = _currentGroup.firstRow; r < _currentGroup.lastRow + 1;
                ++r) {
-            it->reduce(GetValueForRegister(cur, r, reg), collection);
+            ReduceAggregator(it, _aggregationStep,
+                             GetValueForRegister(cur, r, reg), collection);
           }
           ++j;
         }
@@ -525,9 +584,11 @@ void SortedCollectBlock::emitGroup(AqlItemBlock const* cur, AqlItemBlock* res,
           GetCollectionForRegister(cur, reg);
       for (size_t r = _currentGroup.firstRow; r < _currentGroup.lastRow + 1;
            ++r) {
-        it->reduce(GetValueForRegister(cur, r, reg), collection);
+        ReduceAggregator(it, _aggregationStep,
+                         GetValueForRegister(cur, r, reg), collection);
       }
-      res->setValue(row, _aggregateRegisters[j].first, it->stealValue());
+      res->setValue(row, _aggregateRegisters[j].first,
+                    StealAggregatorValue(it, _aggregationStep));
     } else {
       res->setValue(
           row, _aggregateRegisters[j].first,
@@ -568,7 +629,13 @@ HashedCollectBlock::HashedCollectBlock(ExecutionEngine* engine,
     : ExecutionBlock(engine, en),
       _groupRegisters(),
       _aggregateRegisters(),
-      _collectRegister(ExecutionNode::MaxRegisterId) {
+      _collectRegister(ExecutionNode::MaxRegisterId),
+      _aggregationStep(en->aggregationStep()),
+      _numAggregators(0),
+      _groupMemoryUsage(0),
+      _spillThreshold(engine->getQuery()->collectSpillThreshold()),
+      _level(0),
+      _lastInputBlock(nullptr) {
   for (auto const& p : en->_groupVariables) {
     // We know that planRegisters() has been run, so
     // getPlanNode()->_registerPlan is set up
@@ -619,9 +686,19 @@ HashedCollectBlock::HashedCollectBlock(ExecutionEngine* engine,
   }
 
   TRI_ASSERT(!_groupRegisters.empty());
+
+  if (!_aggregateRegisters.empty()) {
+    _numAggregators = _aggregateRegisters.size();
+  } else if (en->_count) {
+    // only count the number of items per group
+    _numAggregators = 1;
+  }
 }
 
-HashedCollectBlock::~HashedCollectBlock() {}
+HashedCollectBlock::~HashedCollectBlock() {
+  clearGroups();
+  clearPartitions();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief initialize
@@ -637,6 +714,39 @@ int HashedCollectBlock::initialize() {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initializeCursor
+////////////////////////////////////////////////////////////////////////////////
+
+int HashedCollectBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
+  // remove partitions left over from a previous cursor
+  clearPartitions();
+
+  return ExecutionBlock::initializeCursor(items, pos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shutdown
+////////////////////////////////////////////////////////////////////////////////
+
+int HashedCollectBlock::shutdown(int errorCode) {
+  clearGroups();
+  clearPartitions();
+
+  return ExecutionBlock::shutdown(errorCode);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hasMore
+////////////////////////////////////////////////////////////////////////////////
+
+bool HashedCollectBlock::hasMore() {
+  if (!_done && !_partitions.empty()) {
+    return true;
+  }
+  return ExecutionBlock::hasMore();
+}
+
 int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
                                       bool skipping, AqlItemBlock*& result,
                                       size_t& skipped) {
@@ -646,6 +756,18 @@ int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
     return TRI_ERROR_NO_ERROR;
   }
 
+  if (!_partitions.empty()) {
+    // the input has been consumed, but groups were spilled to disk
+    if (!skipping) {
+      throwIfKilled();
+    }
+
+    ++skipped;
+    result = processPartition();
+
+    return TRI_ERROR_NO_ERROR;
+  }
+
   if (_buffer.empty()) {
     if (!ExecutionBlock::getBlock(atLeast, atMost)) {
       // done
@@ -656,283 +778,574 @@ int HashedCollectBlock::getOrSkipSome(size_t atLeast, size_t atMost,
     _pos = 0;  // this is in the first block
   }
 
-  auto* en = static_cast<CollectNode const*>(_exeNode);
-
   // If we get here, we do have _buffer.front()
   AqlItemBlock* cur = _buffer.front();
   TRI_ASSERT(cur != nullptr);
 
-  // set up collections
-  std::vector<TRI_document_collection_t const*> groupColls;
-  for (auto const& it : _groupRegisters) {
-    groupColls.emplace_back(cur->getDocumentCollection(it.second));
-  }
-  std::vector<TRI_document_collection_t const*> aggregateColls;
-  for (auto const& it : _aggregateRegisters) {
-    aggregateColls.emplace_back(GetCollectionForRegister(cur, it.second));
-  }
+  startPass(0, cur);
 
-  TRI_ASSERT(aggregateColls.size() == en->_aggregateVariables.size());
-  TRI_ASSERT(_aggregateRegisters.size() == en->_aggregateVariables.size());
+  // prevent memory leaks by always cleaning up the groups
+  TRI_DEFER(clearGroups());
+
+  while (skipped < atMost) {
+    TRI_IF_FAILURE("HashedCollectBlock::getOrSkipSomeOuter") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+
+    throwIfKilled();  // check if we were aborted
+
+    aggregateRow(cur, _pos);
 
-  std::unordered_map<std::vector<AqlValue>, AggregateValuesType*, GroupKeyHash,
-                     GroupKeyEqual> allGroups(1024,
-                                              GroupKeyHash(_trx, groupColls),
-                                              GroupKeyEqual(_trx, groupColls));
-
-  // cleanup function for group values
-  auto cleanup = [&allGroups]() -> void {
-    for (auto& it : allGroups) {
-      if (it.second != nullptr) {
-        for (auto& it2 : *(it.second)) {
-          delete it2;
+    if (++_pos >= cur->size()) {
+      _buffer.pop_front();
+      _pos = 0;
+
+      bool hasMore = !_buffer.empty();
+
+      if (!hasMore) {
+        hasMore = ExecutionBlock::getBlock(atLeast, atMost);
+      }
+
+      if (!hasMore) {
+        // no more input. we're done
+        try {
+          // emit last buffered group
+          if (!skipping) {
+            TRI_IF_FAILURE("HashedCollectBlock::getOrSkipSome") {
+              THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+            }
+
+            throwIfKilled();
+          }
+
+          finishPass();
+
+          ++skipped;
+          result = buildResult(cur);
+
+          if (_partitions.empty()) {
+            returnBlock(cur);
+            _done = true;
+          } else {
+            // the results of the spilled partitions inherit the outer
+            // registers from this block, too
+            _lastInputBlock = cur;
+          }
+
+          return TRI_ERROR_NO_ERROR;
+        } catch (...) {
+          returnBlock(cur);
+          throw;
         }
       }
-      delete it.second;
+
+      // hasMore
+
+      returnBlock(cur);
+      cur = _buffer.front();
     }
-    allGroups.clear();
-  };
+  }
 
-  // prevent memory leaks by always cleaning up the groups
-  TRI_DEFER(cleanup());
+  if (!skipping) {
+    TRI_ASSERT(skipped > 0);
+  }
+
+  finishPass();
+  result = buildResult(nullptr);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief aggregate the groups of the next spilled partition
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* HashedCollectBlock::processPartition() {
+  TRI_ASSERT(!_partitions.empty());
 
-  auto buildResult = [&](AqlItemBlock const* src) {
-    TRI_ASSERT(groupColls.size() == _groupRegisters.size());
-    TRI_ASSERT(aggregateColls.size() == _aggregateRegisters.size());
+  std::unique_ptr<SpillPartition> partition(_partitions.front());
+  _partitions.pop_front();
 
-    auto nrRegs = en->getRegisterPlan()->nrRegs[en->getDepth()];
+  startPass(partition->level + 1, nullptr);
 
-    auto result = std::make_unique<AqlItemBlock>(allGroups.size(), nrRegs);
+  // prevent memory leaks by always cleaning up the groups
+  TRI_DEFER(clearGroups());
+
+  partition->file.rewind();
+
+  while (true) {
+    std::unique_ptr<AqlItemBlock> block(
+        partition->file.read(_engine->getQuery()->resourceMonitor()));
 
-    if (src != nullptr) {
-      inheritRegisters(src, result.get(), 0);
+    if (block == nullptr) {
+      break;
     }
 
-    // collections
-    for (size_t i = 0; i < _groupRegisters.size(); ++i) {
-      result->setDocumentCollection(_groupRegisters[i].first, groupColls[i]);
+    throwIfKilled();  // check if we were aborted
+
+    for (size_t i = 0; i < block->size(); ++i) {
+      aggregateRow(block.get(), i);
     }
-    for (size_t i = 0; i < _aggregateRegisters.size(); ++i) {
-      result->setDocumentCollection(_aggregateRegisters[i].first,
-                                    aggregateColls[i]);
+  }
+
+  // removes the partition file
+  partition.reset();
+
+  finishPass();
+
+  std::unique_ptr<AqlItemBlock> result(buildResult(_lastInputBlock));
+
+  if (_partitions.empty()) {
+    if (_lastInputBlock != nullptr) {
+      returnBlock(_lastInputBlock);
+      _lastInputBlock = nullptr;
     }
+    _done = true;
+  }
 
-    TRI_ASSERT(!en->_count || _collectRegister != ExecutionNode::MaxRegisterId);
+  return result.release();
+}
 
-    size_t row = 0;
-    for (auto const& it : allGroups) {
-      auto& keys = it.first;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepare a pass over input rows
+////////////////////////////////////////////////////////////////////////////////
 
-      TRI_ASSERT(keys.size() == _groupRegisters.size());
-      size_t i = 0;
-      for (auto& key : keys) {
-        result->setValue(row, _groupRegisters[i++].first, key);
-        const_cast<AqlValue*>(&key)
-            ->erase();  // to prevent double-freeing later
-      }
+void HashedCollectBlock::startPass(size_t level, AqlItemBlock const* src) {
+  TRI_ASSERT(numGroups() == 0);
 
-      if (it.second != nullptr && !en->_count) {
-        TRI_ASSERT(it.second->size() == _aggregateRegisters.size());
-        size_t j = 0;
-        for (auto const& r : *(it.second)) {
-          result->setValue(row, _aggregateRegisters[j++].first,
-                           r->stealValue());
-        }
-      } else if (en->_count) {
-        // set group count in result register
-        TRI_ASSERT(it.second != nullptr);
-        result->setValue(row, _collectRegister,
-                         it.second->back()->stealValue());
+  _level = level;
+
+  _inGroupRegisters.clear();
+  _inAggregateRegisters.clear();
+  _groupColls.clear();
+  _aggregateColls.clear();
+
+  if (level == 0) {
+    // read the rows of our dependency
+    TRI_ASSERT(src != nullptr);
+
+    for (auto const& it : _groupRegisters) {
+      _inGroupRegisters.emplace_back(it.second);
+      _groupColls.emplace_back(src->getDocumentCollection(it.second));
+    }
+    for (auto const& it : _aggregateRegisters) {
+      _inAggregateRegisters.emplace_back(it.second);
+      _aggregateColls.emplace_back(GetCollectionForRegister(src, it.second));
+    }
+  } else {
+    // read the rows of a spilled partition. all values in there are JSON
+    // values, so there are no collections
+    RegisterId const n = static_cast<RegisterId>(_groupRegisters.size());
+
+    for (RegisterId i = 0; i < n; ++i) {
+      _inGroupRegisters.emplace_back(i);
+      _groupColls.emplace_back(nullptr);
+    }
+    RegisterId i = n;
+    for (auto const& it : _aggregateRegisters) {
+      if (it.second == ExecutionNode::MaxRegisterId) {
+        _inAggregateRegisters.emplace_back(ExecutionNode::MaxRegisterId);
+      } else {
+        _inAggregateRegisters.emplace_back(i);
       }
+      _aggregateColls.emplace_back(nullptr);
+      ++i;
+    }
+  }
+
+  _groupSlots.assign(InitialSlots, 0);
+  _spillTargets.assign(NumPartitions, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief end a pass, makes the spilled partitions available for processing
+////////////////////////////////////////////////////////////////////////////////
 
-      ++row;
+void HashedCollectBlock::finishPass() {
+  for (auto& it : _spillTargets) {
+    if (it != nullptr) {
+      it->flush(_trx);
+      _partitions.emplace_back(it);
+      it = nullptr;
     }
+  }
+  _spillTargets.clear();
+}
 
-    return result.release();
-  };
+////////////////////////////////////////////////////////////////////////////////
+/// @brief aggregate a single input row
+////////////////////////////////////////////////////////////////////////////////
 
-  std::vector<AqlValue> groupValues;
-  size_t const n = _groupRegisters.size();
-  groupValues.reserve(n);
+void HashedCollectBlock::aggregateRow(AqlItemBlock const* src, size_t row) {
+  uint64_t const hash = hashRow(src, row);
+  size_t const slot = lookupSlot(src, row, hash);
+
+  if (_groupSlots[slot] == 0) {
+    // new group
+    if (_spillThreshold > 0 && numGroups() >= _spillThreshold &&
+        _level < MaxSpillLevel) {
+      // no more room for new groups. all rows of this group will end up in
+      // the same partition, so they can be aggregated later
+      spillRow(src, row, hash);
+      return;
+    }
 
-  std::vector<AqlValue> group;
-  group.reserve(n);
+    _groupSlots[slot] = addGroup(src, row, hash) + 1;
 
-  try {
-    while (skipped < atMost) {
-      TRI_IF_FAILURE("HashedCollectBlock::getOrSkipSomeOuter") {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-      }
+    // keep the load factor below 50 %
+    if (numGroups() * 2 > _groupSlots.size()) {
+      growTable();
+    }
+    return;
+  }
 
-      throwIfKilled();  // check if we were aborted
+  // existing group
+  size_t const group = _groupSlots[slot] - 1;
+  Aggregator** aggregators = _groupAggregators.data() + group * _numAggregators;
 
-      groupValues.clear();
+  if (_aggregateRegisters.empty()) {
+    // no aggregate registers. simply increase the counter
+    if (_numAggregators > 0) {
+      aggregators[0]->reduce(AqlValue(), nullptr);
+    }
+  } else {
+    // apply the aggregators for the group
+    for (size_t j = 0; j < _numAggregators; ++j) {
+      ReduceAggregator(aggregators[j], _aggregationStep,
+                       GetValueForRegister(src, row, _inAggregateRegisters[j]),
+                       _aggregateColls[j]);
+    }
+  }
+}
 
-      // for hashing simply re-use the aggregate registers, without cloning
-      // their contents
-      for (size_t i = 0; i < n; ++i) {
-        groupValues.emplace_back(
-            cur->getValueReference(_pos, _groupRegisters[i].second));
-      }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hash the group values of an input row
+////////////////////////////////////////////////////////////////////////////////
 
-      // now check if we already know this group
-      auto it = allGroups.find(groupValues);
+uint64_t HashedCollectBlock::hashRow(AqlItemBlock const* src,
+                                     size_t row) const {
+  uint64_t hash = 0x12345678;
 
-      if (it == allGroups.end()) {
-        // new group
-        group.clear();
+  for (size_t i = 0; i < _inGroupRegisters.size(); ++i) {
+    uint64_t const h = src->getValueReference(row, _inGroupRegisters[i])
+                           .hash(_trx, _groupColls[i]);
+    hash = fasthash64(&h, sizeof(h), hash);
+  }
 
-        // copy the group values before they get invalidated
-        for (size_t i = 0; i < n; ++i) {
-          group.emplace_back(
-              cur->getValueReference(_pos, _groupRegisters[i].second).clone());
-        }
+  return hash;
+}
 
-        auto aggregateValues = std::make_unique<AggregateValuesType>();
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the slot for the group of an input row
+////////////////////////////////////////////////////////////////////////////////
 
-        if (en->_aggregateVariables.empty()) {
-          // no aggregate registers. this means we'll only count the number of
-          // items
-          if (en->_count) {
-            aggregateValues->emplace_back(new AggregatorLength(_trx, 1));
-          }
-        } else {
-          // we do have aggregate registers. create them as empty AqlValues
-          aggregateValues->reserve(_aggregateRegisters.size());
-
-          // initialize aggregators
-          size_t j = 0;
-          for (auto const& r : en->_aggregateVariables) {
-            aggregateValues->emplace_back(
-                Aggregator::fromTypeString(_trx, r.second.second));
-            aggregateValues->back()->reduce(
-                GetValueForRegister(cur, _pos, _aggregateRegisters[j].second),
-                aggregateColls[j]);
-            ++j;
-          }
-        }
+size_t HashedCollectBlock::lookupSlot(AqlItemBlock const* src, size_t row,
+                                      uint64_t hash) const {
+  size_t const n = _inGroupRegisters.size();
+  size_t const mask = _groupSlots.size() - 1;
+  size_t slot = static_cast<size_t>(hash) & mask;
 
-        // note: aggregateValues may be a nullptr!
-        allGroups.emplace(group, aggregateValues.get());
-        aggregateValues.release();
-      } else {
-        // existing group
-        auto aggregateValues = (*it).second;
+  while (true) {
+    size_t const value = _groupSlots[slot];
 
-        if (en->_aggregateVariables.empty()) {
-          // no aggregate registers. simply increase the counter
-          if (en->_count) {
-            aggregateValues->back()->reduce(AqlValue(), nullptr);
-          }
-        } else {
-          // apply the aggregators for the group
-          size_t j = 0;
-          for (auto const& r : _aggregateRegisters) {
-            (*aggregateValues)[j]->reduce(
-                GetValueForRegister(cur, _pos, r.second), aggregateColls[j]);
-            ++j;
-          }
+    if (value == 0) {
+      return slot;
+    }
+
+    size_t const group = value - 1;
+
+    if (_groupHashes[group] == hash) {
+      AqlValue const* keys = _groupKeys.data() + group * n;
+      bool equal = true;
+
+      for (size_t i = 0; i < n; ++i) {
+        int res = AqlValue::Compare(
+            _trx, keys[i], _groupColls[i],
+            src->getValueReference(row, _inGroupRegisters[i]), _groupColls[i],
+            false);
+
+        if (res != 0) {
+          equal = false;
+          break;
         }
       }
 
-      if (++_pos >= cur->size()) {
-        _buffer.pop_front();
-        _pos = 0;
+      if (equal) {
+        return slot;
+      }
+    }
 
-        bool hasMore = !_buffer.empty();
+    slot = (slot + 1) & mask;
+  }
+}
 
-        if (!hasMore) {
-          hasMore = ExecutionBlock::getBlock(atLeast, atMost);
-        }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a new group from an input row, returns the group index
+////////////////////////////////////////////////////////////////////////////////
 
-        if (!hasMore) {
-          // no more input. we're done
-          try {
-            // emit last buffered group
-            if (!skipping) {
-              TRI_IF_FAILURE("HashedCollectBlock::getOrSkipSome") {
-                THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-              }
+size_t HashedCollectBlock::addGroup(AqlItemBlock const* src, size_t row,
+                                    uint64_t hash) {
+  auto* en = static_cast<CollectNode const*>(_exeNode);
 
-              throwIfKilled();
-            }
+  size_t const n = _inGroupRegisters.size();
+  size_t const group = numGroups();
 
-            ++skipped;
-            result = buildResult(cur);
+  // charge the group to the query first. the aggregators' own state is
+  // approximated by the size of their base class
+  size_t memory =
+      n * sizeof(AqlValue) +
+      _numAggregators * (sizeof(Aggregator*) + sizeof(Aggregator)) +
+      sizeof(uint64_t) + 2 * sizeof(size_t);
+  for (size_t i = 0; i < n; ++i) {
+    memory += src->getValueReference(row, _inGroupRegisters[i]).memoryUsage();
+  }
+  _engine->getQuery()->resourceMonitor()->increaseMemoryUsage(memory);
+  _groupMemoryUsage += memory;
 
-            returnBlock(cur);
-            _done = true;
+  // reserve memory upfront, so that none of the following insertions throws
+  // after a value was cloned or an aggregator was created
+  _groupKeys.reserve(_groupKeys.size() + n);
+  _groupAggregators.reserve(_groupAggregators.size() + _numAggregators);
+  _groupHashes.reserve(group + 1);
 
-            groupValues.clear();
+  // copy the group values before they get invalidated
+  for (size_t i = 0; i < n; ++i) {
+    _groupKeys.emplace_back(
+        src->getValueReference(row, _inGroupRegisters[i]).clone());
+  }
 
-            return TRI_ERROR_NO_ERROR;
-          } catch (...) {
-            returnBlock(cur);
-            throw;
-          }
-        }
+  if (_aggregateRegisters.empty()) {
+    // no aggregate registers. this means we'll only count the number of
+    // items
+    if (_numAggregators > 0) {
+      _groupAggregators.emplace_back(new AggregatorLength(_trx, 1));
+    }
+  } else {
+    // initialize aggregators
+    size_t j = 0;
+    for (auto const& r : en->_aggregateVariables) {
+      _groupAggregators.emplace_back(
+          Aggregator::fromTypeString(_trx, r.second.second));
+      ReduceAggregator(_groupAggregators.back(), _aggregationStep,
+                       GetValueForRegister(src, row, _inAggregateRegisters[j]),
+                       _aggregateColls[j]);
+      ++j;
+    }
+  }
 
-        // hasMore
+  _groupHashes.emplace_back(hash);
 
-        returnBlock(cur);
-        cur = _buffer.front();
-      }
+  return group;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief double the number of slots in the group table
+////////////////////////////////////////////////////////////////////////////////
+
+void HashedCollectBlock::growTable() {
+  std::vector<size_t> slots(_groupSlots.size() * 2, 0);
+  size_t const mask = slots.size() - 1;
+
+  for (size_t group = 0; group < numGroups(); ++group) {
+    size_t slot = static_cast<size_t>(_groupHashes[group]) & mask;
+
+    while (slots[slot] != 0) {
+      slot = (slot + 1) & mask;
     }
-  } catch (...) {
-    // clean up
-    for (auto& it : allGroups) {
-      for (auto& it2 : it.first) {
-        const_cast<AqlValue*>(&it2)->destroy();
+    slots[slot] = group + 1;
+  }
+
+  _groupSlots.swap(slots);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief write an input row to the partition for its hash value
+////////////////////////////////////////////////////////////////////////////////
+
+void HashedCollectBlock::spillRow(AqlItemBlock const* src, size_t row,
+                                  uint64_t hash) {
+  TRI_ASSERT(_level < MaxSpillLevel);
+
+  // each level partitions by the next few bits of the hash value, starting
+  // with the most significant ones. the group table uses the low bits
+  size_t const partition = static_cast<size_t>(
+      (hash >> (64 - PartitionBits * (_level + 1))) & (NumPartitions - 1));
+
+  auto& target = _spillTargets[partition];
+
+  if (target == nullptr) {
+    target = new SpillPartition(_level);
+  }
+
+  size_t const n = _inGroupRegisters.size();
+
+  if (target->pending == nullptr) {
+    RegisterId const nrRegs =
+        static_cast<RegisterId>(n + _inAggregateRegisters.size());
+    target->pending = requestBlock(DefaultBatchSize, nrRegs);
+    target->pendingRows = 0;
+
+    // shaped values are converted to JSON when the block is written, using
+    // the collections of their registers
+    for (size_t i = 0; i < n; ++i) {
+      target->pending->setDocumentCollection(static_cast<RegisterId>(i),
+                                             _groupColls[i]);
+    }
+    for (size_t j = 0; j < _inAggregateRegisters.size(); ++j) {
+      target->pending->setDocumentCollection(static_cast<RegisterId>(n + j),
+                                             _aggregateColls[j]);
+    }
+  }
+
+  auto copyValue = [&](RegisterId from, RegisterId to) {
+    AqlValue const& a = src->getValueReference(row, from);
+
+    if (!a.isEmpty()) {
+      AqlValue b = a.clone();
+      try {
+        target->pending->setValue(target->pendingRows, to, b);
+      } catch (...) {
+        b.destroy();
+        throw;
       }
     }
-    throw;
+  };
+
+  for (size_t i = 0; i < n; ++i) {
+    copyValue(_inGroupRegisters[i], static_cast<RegisterId>(i));
+  }
+  for (size_t j = 0; j < _inAggregateRegisters.size(); ++j) {
+    if (_inAggregateRegisters[j] != ExecutionNode::MaxRegisterId) {
+      copyValue(_inAggregateRegisters[j], static_cast<RegisterId>(n + j));
+    }
   }
 
-  groupValues.clear();
+  if (++target->pendingRows == DefaultBatchSize) {
+    target->flush(_trx);
+  }
+}
 
-  if (!skipping) {
-    TRI_ASSERT(skipped > 0);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the result block from the groups in the group table
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* HashedCollectBlock::buildResult(AqlItemBlock const* src) {
+  auto* en = static_cast<CollectNode const*>(_exeNode);
+
+  TRI_ASSERT(_groupColls.size() == _groupRegisters.size());
+  TRI_ASSERT(_aggregateColls.size() == _aggregateRegisters.size());
+
+  auto nrRegs = en->getRegisterPlan()->nrRegs[en->getDepth()];
+
+  std::unique_ptr<AqlItemBlock> result(requestBlock(numGroups(), nrRegs));
+
+  if (src != nullptr) {
+    inheritRegisters(src, result.get(), 0);
   }
 
-  result = buildResult(nullptr);
+  // collections
+  for (size_t i = 0; i < _groupRegisters.size(); ++i) {
+    result->setDocumentCollection(_groupRegisters[i].first, _groupColls[i]);
+  }
+  for (size_t i = 0; i < _aggregateRegisters.size(); ++i) {
+    result->setDocumentCollection(_aggregateRegisters[i].first,
+                                  _aggregateColls[i]);
+  }
 
-  return TRI_ERROR_NO_ERROR;
+  TRI_ASSERT(!en->_count || _collectRegister != ExecutionNode::MaxRegisterId);
+
+  size_t const n = _groupRegisters.size();
+
+  for (size_t row = 0; row < numGroups(); ++row) {
+    AqlValue* keys = _groupKeys.data() + row * n;
+
+    for (size_t i = 0; i < n; ++i) {
+      result->setValue(row, _groupRegisters[i].first, keys[i]);
+      keys[i].erase();  // to prevent double-freeing later
+    }
+
+    Aggregator** aggregators = _groupAggregators.data() + row * _numAggregators;
+
+    if (!en->_count) {
+      TRI_ASSERT(_numAggregators == _aggregateRegisters.size());
+      for (size_t j = 0; j < _numAggregators; ++j) {
+        result->setValue(row, _aggregateRegisters[j].first,
+                         StealAggregatorValue(aggregators[j], _aggregationStep));
+      }
+    } else {
+      // set group count in result register
+      TRI_ASSERT(_numAggregators > 0);
+      result->setValue(row, _collectRegister,
+                       aggregators[_numAggregators - 1]->stealValue());
+    }
+  }
+
+  return result.release();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief hasher for groups
+/// @brief free all groups in the group table
 ////////////////////////////////////////////////////////////////////////////////
 
-size_t HashedCollectBlock::GroupKeyHash::operator()(
-    std::vector<AqlValue> const& value) const {
-  uint64_t hash = 0x12345678;
-
-  TRI_ASSERT(value.size() == _num);
-  TRI_ASSERT(value.size() == _colls.size());
+void HashedCollectBlock::clearGroups() {
+  for (auto& it : _groupKeys) {
+    it.destroy();
+  }
+  _groupKeys.clear();
 
-  for (size_t i = 0; i < _num; ++i) {
-    hash ^= value[i].hash(_trx, _colls[i]);
+  for (auto& it : _groupAggregators) {
+    delete it;
   }
+  _groupAggregators.clear();
+
+  _groupHashes.clear();
+  _groupSlots.clear();
 
-  return static_cast<size_t>(hash);
+  _engine->getQuery()->resourceMonitor()->decreaseMemoryUsage(
+      _groupMemoryUsage);
+  _groupMemoryUsage = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief comparator for groups
+/// @brief close and remove all partition files
 ////////////////////////////////////////////////////////////////////////////////
 
-bool HashedCollectBlock::GroupKeyEqual::operator()(
-    std::vector<AqlValue> const& lhs, std::vector<AqlValue> const& rhs) const {
-  size_t const n = lhs.size();
+void HashedCollectBlock::clearPartitions() {
+  for (auto& it : _spillTargets) {
+    delete it;
+  }
+  _spillTargets.clear();
 
-  for (size_t i = 0; i < n; ++i) {
-    int res =
-        AqlValue::Compare(_trx, lhs[i], _colls[i], rhs[i], _colls[i], false);
+  for (auto& it : _partitions) {
+    delete it;
+  }
+  _partitions.clear();
 
-    if (res != 0) {
-      return false;
-    }
+  delete _lastInputBlock;
+  _lastInputBlock = nullptr;
+}
+
+HashedCollectBlock::SpillPartition::SpillPartition(size_t level)
+    : file("COLLECT"), level(level), pending(nullptr), pendingRows(0) {}
+
+HashedCollectBlock::SpillPartition::~SpillPartition() { delete pending; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief write the pending rows to the partition file
+////////////////////////////////////////////////////////////////////////////////
+
+void HashedCollectBlock::SpillPartition::flush(
+    arangodb::AqlTransaction* trx) {
+  if (pending == nullptr) {
+    return;
+  }
+
+  if (pendingRows > 0) {
+    pending->shrink(pendingRows);
+    file.write(pending, trx);
   }
 
-  return true;
+  delete pending;
+  pending = nullptr;
+  pendingRows = 0;
 }
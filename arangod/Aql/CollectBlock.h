@@ -29,6 +29,7 @@
 #include "Aql/CollectNode.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
+#include "Aql/SpillFile.h"
 
 namespace arangodb {
 namespace utils {
@@ -132,6 +133,12 @@ class SortedCollectBlock : public ExecutionBlock {
 
   RegisterId _collectRegister;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the part of the aggregation the block performs
+  //////////////////////////////////////////////////////////////////////////////
+
+  CollectNode::AggregationStep const _aggregationStep;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief list of variables names for the registers
   //////////////////////////////////////////////////////////////////////////////
@@ -147,10 +154,119 @@ class HashedCollectBlock : public ExecutionBlock {
 
   int initialize() override;
 
+  int initializeCursor(AqlItemBlock* items, size_t pos) override;
+
+  int shutdown(int) override;
+
+  bool hasMore() override;
+
  private:
   int getOrSkipSome(size_t atLeast, size_t atMost, bool skipping,
                     AqlItemBlock*& result, size_t& skipped) override;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief aggregate the groups of the next spilled partition
+  //////////////////////////////////////////////////////////////////////////////
+
+  AqlItemBlock* processPartition();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prepare a pass over input rows. level 0 is the pass over the
+  /// rows of the dependency, the rows of a partition spilled in level <n>
+  /// are aggregated in level <n + 1>
+  //////////////////////////////////////////////////////////////////////////////
+
+  void startPass(size_t, AqlItemBlock const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief end a pass, makes the partitions spilled during the pass
+  /// available for processing
+  //////////////////////////////////////////////////////////////////////////////
+
+  void finishPass();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief aggregate a single input row, either into its group in the group
+  /// table or by writing it to a partition
+  //////////////////////////////////////////////////////////////////////////////
+
+  void aggregateRow(AqlItemBlock const*, size_t);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief hash the group values of an input row
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t hashRow(AqlItemBlock const*, size_t) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief look up the slot for the group of an input row. returns the
+  /// position of the slot that contains the group, or of the empty slot the
+  /// group must be stored in
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t lookupSlot(AqlItemBlock const*, size_t, uint64_t) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create a new group from an input row, returns the group index
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t addGroup(AqlItemBlock const*, size_t, uint64_t);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief double the number of slots in the group table
+  //////////////////////////////////////////////////////////////////////////////
+
+  void growTable();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief write an input row to the partition for its hash value
+  //////////////////////////////////////////////////////////////////////////////
+
+  void spillRow(AqlItemBlock const*, size_t, uint64_t);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief build the result block from the groups in the group table
+  //////////////////////////////////////////////////////////////////////////////
+
+  AqlItemBlock* buildResult(AqlItemBlock const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief free all groups in the group table
+  //////////////////////////////////////////////////////////////////////////////
+
+  void clearGroups();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief close and remove all partition files
+  //////////////////////////////////////////////////////////////////////////////
+
+  void clearPartitions();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of groups in the group table
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t numGroups() const { return _groupHashes.size(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief input rows of groups that did not fit into memory, spilled to a
+  /// temporary file. the rows contain the group values in registers
+  /// 0 .. n - 1, followed by the aggregate input values
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct SpillPartition {
+    explicit SpillPartition(size_t);
+
+    ~SpillPartition();
+
+    void flush(arangodb::AqlTransaction*);
+
+    SpillFile file;
+    size_t const level;
+    AqlItemBlock* pending;
+    size_t pendingRows;
+  };
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief pairs, consisting of out register and in register
@@ -174,36 +290,87 @@ class HashedCollectBlock : public ExecutionBlock {
   RegisterId _collectRegister;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief hasher for a vector of AQL values
+  /// @brief the part of the aggregation the block performs
   //////////////////////////////////////////////////////////////////////////////
 
-  struct GroupKeyHash {
-    GroupKeyHash(arangodb::AqlTransaction* trx,
-                 std::vector<TRI_document_collection_t const*>& colls)
-        : _trx(trx), _colls(colls), _num(colls.size()) {}
+  CollectNode::AggregationStep const _aggregationStep;
 
-    size_t operator()(std::vector<AqlValue> const& value) const;
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of aggregators per group
+  //////////////////////////////////////////////////////////////////////////////
 
-    arangodb::AqlTransaction* _trx;
-    std::vector<TRI_document_collection_t const*>& _colls;
-    size_t const _num;
-  };
+  size_t _numAggregators;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief comparator for a vector of AQL values
+  /// @brief the registers the group values and aggregate input values are
+  /// read from in the current pass
   //////////////////////////////////////////////////////////////////////////////
 
-  struct GroupKeyEqual {
-    GroupKeyEqual(arangodb::AqlTransaction* trx,
-                  std::vector<TRI_document_collection_t const*>& colls)
-        : _trx(trx), _colls(colls) {}
+  std::vector<RegisterId> _inGroupRegisters;
 
-    bool operator()(std::vector<AqlValue> const&,
-                    std::vector<AqlValue> const&) const;
+  std::vector<RegisterId> _inAggregateRegisters;
 
-    arangodb::AqlTransaction* _trx;
-    std::vector<TRI_document_collection_t const*>& _colls;
-  };
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the document collections of the input values in the current pass
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<TRI_document_collection_t const*> _groupColls;
+
+  std::vector<TRI_document_collection_t const*> _aggregateColls;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the group table. group <i> consists of the group values
+  /// _groupKeys[i * n .. (i + 1) * n - 1], the aggregators
+  /// _groupAggregators[i * _numAggregators ...] and the hash value
+  /// _groupHashes[i]. _groupSlots is an open-addressing hash table with
+  /// linear probing, each slot contains a group index + 1, or 0 if empty
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<AqlValue> _groupKeys;
+
+  std::vector<Aggregator*> _groupAggregators;
+
+  std::vector<uint64_t> _groupHashes;
+
+  std::vector<size_t> _groupSlots;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief memory charged to the query for the groups in the group table
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _groupMemoryUsage;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of groups in the group table before input rows of
+  /// new groups are spilled to disk (0 = never spill)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _spillThreshold;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the current pass level
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _level;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief partitions written in the current pass, indexed by hash bits
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<SpillPartition*> _spillTargets;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief partitions waiting to be processed
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::deque<SpillPartition*> _partitions;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the last block of the dependency, kept to inherit the outer
+  /// registers into the results of the spilled partitions
+  //////////////////////////////////////////////////////////////////////////////
+
+  AqlItemBlock* _lastInputBlock;
 };
 
 }  // namespace arangodb::aql
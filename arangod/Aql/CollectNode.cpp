@@ -49,10 +49,44 @@ CollectNode::CollectNode(
       _variableMap(variableMap),
       _count(count),
       _isDistinctCommand(isDistinctCommand),
-      _specialized(false) {}
+      _specialized(false),
+      _aggregationStep(aggregationStepFromString(
+          arangodb::basics::JsonHelper::getStringValue(
+              base.json(), "aggregationStep", ""))) {}
 
 CollectNode::~CollectNode() {}
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the aggregation step from a string
+////////////////////////////////////////////////////////////////////////////////
+
+CollectNode::AggregationStep CollectNode::aggregationStepFromString(
+    std::string const& value) {
+  if (value == "partial") {
+    return AGGREGATION_STEP_PARTIAL;
+  }
+  if (value == "merge") {
+    return AGGREGATION_STEP_MERGE;
+  }
+  return AGGREGATION_STEP_COMPLETE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stringify the aggregation step
+////////////////////////////////////////////////////////////////////////////////
+
+char const* CollectNode::aggregationStepToString(AggregationStep step) {
+  switch (step) {
+    case AGGREGATION_STEP_PARTIAL:
+      return "partial";
+    case AGGREGATION_STEP_MERGE:
+      return "merge";
+    case AGGREGATION_STEP_COMPLETE:
+      break;
+  }
+  return "complete";
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief toVelocyPack, for CollectNode
 ////////////////////////////////////////////////////////////////////////////////
@@ -115,6 +149,8 @@ void CollectNode::toVelocyPackHelper(VPackBuilder& nodes, bool verbose) const {
   nodes.add("count", VPackValue(_count));
   nodes.add("isDistinctCommand", VPackValue(_isDistinctCommand));
   nodes.add("specialized", VPackValue(_specialized));
+  nodes.add("aggregationStep",
+            VPackValue(aggregationStepToString(_aggregationStep)));
   nodes.add(VPackValue("collectOptions"));
   _options.toVelocyPack(nodes);
 
@@ -171,6 +207,7 @@ ExecutionNode* CollectNode::clone(ExecutionPlan* plan, bool withDependencies,
   if (isSpecialized()) {
     c->specialized();
   }
+  c->aggregationStep(_aggregationStep);
 
   cloneHelper(c, plan, withDependencies, withProperties);
 
@@ -199,8 +236,10 @@ struct UserVarFinder final : public WalkerWorker<ExecutionNode> {
       depth = 0;
     } else if (en->getType() == ExecutionNode::ENUMERATE_COLLECTION ||
                en->getType() == ExecutionNode::INDEX ||
+               en->getType() == ExecutionNode::HASH_JOIN ||
                en->getType() == ExecutionNode::ENUMERATE_LIST ||
                en->getType() == ExecutionNode::TRAVERSAL ||
+               en->getType() == ExecutionNode::SHORTEST_PATH ||
                en->getType() == ExecutionNode::COLLECT) {
       depth += 1;
     }
@@ -52,6 +52,19 @@ class CollectNode : public ExecutionNode {
   friend class SortedCollectBlock;
 
  public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the part of the aggregation the node performs. in a cluster, a
+  /// COLLECT can be split into a partial COLLECT per shard, producing the
+  /// partial states of the aggregators, and a COLLECT on the coordinator
+  /// that merges these states
+  //////////////////////////////////////////////////////////////////////////////
+
+  enum AggregationStep {
+    AGGREGATION_STEP_COMPLETE,
+    AGGREGATION_STEP_PARTIAL,
+    AGGREGATION_STEP_MERGE
+  };
+
   CollectNode(
       ExecutionPlan* plan, size_t id, CollectOptions const& options,
       std::vector<std::pair<Variable const*, Variable const*>> const&
@@ -73,7 +86,8 @@ class CollectNode : public ExecutionNode {
         _variableMap(variableMap),
         _count(count),
         _isDistinctCommand(isDistinctCommand),
-        _specialized(false) {
+        _specialized(false),
+        _aggregationStep(AGGREGATION_STEP_COMPLETE) {
     // outVariable can be a nullptr, but only if _count is not set
     TRI_ASSERT(!_count || _outVariable != nullptr);
   }
@@ -132,6 +146,30 @@ class CollectNode : public ExecutionNode {
     _options.method = method;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the aggregation step
+  //////////////////////////////////////////////////////////////////////////////
+
+  AggregationStep aggregationStep() const { return _aggregationStep; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the aggregation step
+  //////////////////////////////////////////////////////////////////////////////
+
+  void aggregationStep(AggregationStep step) { _aggregationStep = step; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief get the aggregation step from a string
+  //////////////////////////////////////////////////////////////////////////////
+
+  static AggregationStep aggregationStepFromString(std::string const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief stringify the aggregation step
+  //////////////////////////////////////////////////////////////////////////////
+
+  static char const* aggregationStepToString(AggregationStep);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief getOptions
   //////////////////////////////////////////////////////////////////////////////
@@ -243,6 +281,15 @@ class CollectNode : public ExecutionNode {
     return _groupVariables;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set all group variables (out, in)
+  //////////////////////////////////////////////////////////////////////////////
+
+  void groupVariables(
+      std::vector<std::pair<Variable const*, Variable const*>> const& vars) {
+    _groupVariables = vars;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get all aggregate variables (out, in)
   //////////////////////////////////////////////////////////////////////////////
@@ -253,6 +300,17 @@ class CollectNode : public ExecutionNode {
     return _aggregateVariables;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set all aggregate variables (out, in)
+  //////////////////////////////////////////////////////////////////////////////
+
+  void aggregateVariables(
+      std::vector<std::pair<Variable const*,
+                            std::pair<Variable const*, std::string>>> const&
+          vars) {
+    _aggregateVariables = vars;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief getVariablesUsedHere, returning a vector
   //////////////////////////////////////////////////////////////////////////////
@@ -349,6 +407,12 @@ class CollectNode : public ExecutionNode {
   //////////////////////////////////////////////////////////////////////////////
 
   bool _specialized;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the part of the aggregation the node performs
+  //////////////////////////////////////////////////////////////////////////////
+
+  AggregationStep _aggregationStep;
 };
 
 }  // namespace arangodb::aql
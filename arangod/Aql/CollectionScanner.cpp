@@ -22,6 +22,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "CollectionScanner.h"
+#include "Basics/Exceptions.h"
+#include "Basics/ThreadPool.h"
+#include "Basics/system-functions.h"
+#include "Indexes/PrimaryIndex.h"
 
 using namespace arangodb::aql;
 
@@ -86,3 +90,370 @@ int LinearCollectionScanner::forward(size_t batchSize, size_t& skipped) {
 }
 
 void LinearCollectionScanner::reset() { position.reset(); }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of index slots per range
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t const RangeSize = 16384;
+
+ParallelCollectionScanner::ParallelCollectionScanner(
+    arangodb::AqlTransaction* trx, TRI_transaction_collection_t* trxCollection,
+    size_t numThreads, FilterFactory const& filterFactory)
+    : CollectionScanner(trx, trxCollection),
+      _numThreads((std::max)(
+          size_t(1), (std::min)(numThreads, TRI_numberProcessors()))),
+      _filterFactory(filterFactory),
+      _primaryIndex(nullptr),
+      _ranges(),
+      _nextRange(0),
+      _scanned(0),
+      _inlineFilter(),
+      _filters(),
+      _pool(),
+      _batches(),
+      _runningThreads(0),
+      _started(false),
+      _incremental(false),
+      _stopping(false),
+      _error(TRI_ERROR_NO_ERROR) {}
+
+ParallelCollectionScanner::~ParallelCollectionScanner() { stop(); }
+
+int ParallelCollectionScanner::scan(std::vector<TRI_doc_mptr_copy_t>& docs,
+                                    size_t) {
+  // only usable without a filter, as undecided documents would be returned
+  // as matches
+  TRI_ASSERT(!_filterFactory);
+
+  std::vector<uint8_t> undecided;
+  return scan(docs, undecided);
+}
+
+int ParallelCollectionScanner::scan(std::vector<TRI_doc_mptr_copy_t>& docs,
+                                    std::vector<uint8_t>& undecided) {
+  docs.clear();
+  undecided.clear();
+
+  if (!_started) {
+    int res = start();
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+  }
+
+  if (_incremental) {
+    // the transaction does not keep the collection locked. read it like the
+    // linear scanner does, which locks the collection for each batch
+    while (true) {
+      Batch batch;
+      uint64_t skip = 0;
+      int res = trx->readIncremental(trxCollection, batch.documents, position,
+                                     RangeSize, skip, UINT64_MAX, totalCount);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+
+      if (batch.documents.empty()) {
+        return TRI_ERROR_NO_ERROR;
+      }
+
+      _scanned += batch.documents.size();
+      applyFilter(_inlineFilter, batch);
+
+      if (!batch.documents.empty()) {
+        docs.swap(batch.documents);
+        undecided.swap(batch.undecided);
+        return TRI_ERROR_NO_ERROR;
+      }
+    }
+  }
+
+  if (_filters.empty()) {
+    // a single range or a single thread. scan on the calling thread
+    while (true) {
+      size_t const r = _nextRange++;
+
+      if (r >= _ranges.size()) {
+        return TRI_ERROR_NO_ERROR;
+      }
+
+      Batch batch;
+      scanRange(_ranges[r], _inlineFilter, batch);
+
+      if (!batch.documents.empty()) {
+        docs.swap(batch.documents);
+        undecided.swap(batch.undecided);
+        return TRI_ERROR_NO_ERROR;
+      }
+    }
+  }
+
+  std::unique_lock<std::mutex> guard(_mutex);
+  _condition.wait(guard, [this]() -> bool {
+    return (!_batches.empty() || _runningThreads == 0 ||
+            _error != TRI_ERROR_NO_ERROR);
+  });
+
+  if (_error != TRI_ERROR_NO_ERROR) {
+    return _error;
+  }
+
+  if (_batches.empty()) {
+    // all workers are done
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  docs.swap(_batches.front().documents);
+  undecided.swap(_batches.front().undecided);
+  _batches.pop_front();
+
+  guard.unlock();
+  // wake up workers waiting for space in the queue
+  _condition.notify_all();
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+void ParallelCollectionScanner::reset() {
+  stop();
+
+  _started = false;
+  _incremental = false;
+  _primaryIndex = nullptr;
+  _ranges.clear();
+  _nextRange = 0;
+  _scanned = 0;
+  _inlineFilter = Filter();
+  _batches.clear();
+  _stopping = false;
+  _error = TRI_ERROR_NO_ERROR;
+  position.reset();
+}
+
+int ParallelCollectionScanner::forward(size_t, size_t&) {
+  // the documents cannot be skipped without applying the filter, and the
+  // batches are determined by the index ranges. callers must skip via scan()
+  return TRI_ERROR_NOT_IMPLEMENTED;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief split the index into ranges and start the worker threads
+////////////////////////////////////////////////////////////////////////////////
+
+int ParallelCollectionScanner::start() {
+  TRI_ASSERT(!_started);
+  TRI_ASSERT(_filters.empty());
+
+  _started = true;
+
+  if (!trx->isLocked(trxCollection, TRI_TRANSACTION_READ)) {
+    _incremental = true;
+    _inlineFilter = _filterFactory ? _filterFactory() : Filter();
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  if (trx->orderDitch(trxCollection) == nullptr) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  _primaryIndex = trx->documentCollection(trxCollection->_cid)->primaryIndex();
+
+  size_t const numBuckets = _primaryIndex->numberBuckets();
+
+  for (size_t i = 0; i < numBuckets; ++i) {
+    uint64_t const size = _primaryIndex->bucketSize(i);
+
+    for (uint64_t from = 0; from < size; from += RangeSize) {
+      _ranges.emplace_back(Range{i, from, (std::min)(from + RangeSize, size)});
+    }
+  }
+
+  _nextRange = 0;
+
+  size_t const numThreads = (std::min)(_numThreads, _ranges.size());
+
+  if (numThreads <= 1) {
+    _inlineFilter = _filterFactory ? _filterFactory() : Filter();
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  if (_pool == nullptr) {
+    try {
+      _pool.reset(
+          new arangodb::basics::ThreadPool(_numThreads, "AqlCollectionScan"));
+    } catch (...) {
+      // scan on the calling thread
+      _inlineFilter = _filterFactory ? _filterFactory() : Filter();
+      return TRI_ERROR_NO_ERROR;
+    }
+  }
+
+  // the filters are created on this thread, as creating them may access
+  // query data that is not thread-safe
+  _filters.reserve(numThreads);
+
+  for (size_t i = 0; i < numThreads; ++i) {
+    _filters.emplace_back(_filterFactory ? _filterFactory() : Filter());
+  }
+
+  _runningThreads = numThreads;
+
+  for (size_t i = 0; i < numThreads; ++i) {
+    try {
+      _pool->enqueue([this, i]() -> void { work(i); });
+    } catch (...) {
+      // continue with the workers that could be handed out
+      std::lock_guard<std::mutex> guard(_mutex);
+      _runningThreads -= (numThreads - i);
+
+      if (i == 0) {
+        _filters.clear();
+        _inlineFilter = _filterFactory ? _filterFactory() : Filter();
+      }
+      break;
+    }
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stop and join the worker threads
+////////////////////////////////////////////////////////////////////////////////
+
+void ParallelCollectionScanner::stop() {
+  {
+    std::unique_lock<std::mutex> guard(_mutex);
+    _stopping = true;
+    _condition.notify_all();
+
+    // workers still queued in the pool see _stopping and return at once
+    _condition.wait(guard,
+                    [this]() -> bool { return _runningThreads == 0; });
+  }
+  _filters.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief produce the documents of a range
+////////////////////////////////////////////////////////////////////////////////
+
+void ParallelCollectionScanner::scanRange(Range const& range,
+                                          Filter const& filter, Batch& batch) {
+  uint64_t position = range.from;
+
+  while (true) {
+    TRI_doc_mptr_t const* mptr = _primaryIndex->lookupSequentialInRange(
+        trx, range.bucketId, position, range.to);
+
+    if (mptr == nullptr) {
+      break;
+    }
+
+    batch.documents.emplace_back(*mptr);
+  }
+
+  _scanned += batch.documents.size();
+  applyFilter(filter, batch);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief apply a filter to a batch and remove the rejected documents
+////////////////////////////////////////////////////////////////////////////////
+
+void ParallelCollectionScanner::applyFilter(Filter const& filter,
+                                            Batch& batch) {
+  size_t const n = batch.documents.size();
+
+  if (!filter || n == 0) {
+    batch.undecided.assign(n, 0);
+    return;
+  }
+
+  std::vector<uint8_t> results;
+  filter(batch.documents, results);
+  TRI_ASSERT(results.size() == n);
+
+  batch.undecided.clear();
+  size_t j = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    if (results[i] == FILTER_REJECT) {
+      continue;
+    }
+
+    if (i != j) {
+      batch.documents[j] = batch.documents[i];
+    }
+    batch.undecided.emplace_back(results[i] == FILTER_UNDECIDED ? 1 : 0);
+    ++j;
+  }
+
+  batch.documents.resize(j);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief main loop of a worker thread. the number of batches waiting to be
+/// picked up is bounded, so that the workers do not run away from a slow
+/// consumer
+////////////////////////////////////////////////////////////////////////////////
+
+void ParallelCollectionScanner::work(size_t index) {
+  Filter const& filter = _filters[index];
+  size_t const maxQueued = 2 * _numThreads;
+  int res = TRI_ERROR_NO_ERROR;
+
+  try {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> guard(_mutex);
+        _condition.wait(guard, [this, maxQueued]() -> bool {
+          return (_stopping || _error != TRI_ERROR_NO_ERROR ||
+                  _batches.size() < maxQueued);
+        });
+
+        if (_stopping || _error != TRI_ERROR_NO_ERROR) {
+          break;
+        }
+      }
+
+      size_t const r = _nextRange++;
+
+      if (r >= _ranges.size()) {
+        break;
+      }
+
+      Batch batch;
+      scanRange(_ranges[r], filter, batch);
+
+      if (batch.documents.empty()) {
+        continue;
+      }
+
+      {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _batches.emplace_back(std::move(batch));
+      }
+      _condition.notify_all();
+    }
+  } catch (arangodb::basics::Exception const& ex) {
+    res = ex.code();
+  } catch (std::bad_alloc const&) {
+    res = TRI_ERROR_OUT_OF_MEMORY;
+  } catch (...) {
+    res = TRI_ERROR_INTERNAL;
+  }
+
+  std::lock_guard<std::mutex> guard(_mutex);
+
+  if (res != TRI_ERROR_NO_ERROR && _error == TRI_ERROR_NO_ERROR) {
+    _error = res;
+  }
+  --_runningThreads;
+  // notify while holding the lock, as stop() may destroy the scanner as
+  // soon as it can acquire the lock
+  _condition.notify_all();
+}
@@ -30,7 +30,17 @@
 #include "VocBase/transaction.h"
 #include "VocBase/vocbase.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
 namespace arangodb {
+class PrimaryIndex;
+
+namespace basics {
+class ThreadPool;
+}
+
 namespace aql {
 
 struct CollectionScanner {
@@ -81,6 +91,191 @@ struct LinearCollectionScanner final : public CollectionScanner {
 
   int forward(size_t, size_t&) override;
 };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief scans the primary index of a collection with multiple threads.
+/// the index buckets are split into ranges of slots, which the workers of
+/// the scanner's thread pool pick one after the other. the pool is created
+/// on the first scan and reused when the scan is reset. each worker can apply a filter to the
+/// documents of its ranges, so that only the matching documents are handed
+/// out. documents are returned in no particular order
+////////////////////////////////////////////////////////////////////////////////
+
+struct ParallelCollectionScanner final : public CollectionScanner {
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief filter results for a document
+  //////////////////////////////////////////////////////////////////////////////
+
+  enum FilterResult : uint8_t {
+    FILTER_REJECT = 0,
+    FILTER_ACCEPT = 1,
+    // the filter could not decide on the worker thread. the document must
+    // be checked by the caller
+    FILTER_UNDECIDED = 2
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a filter, setting the results for a batch of documents. each
+  /// worker thread uses its own filter
+  //////////////////////////////////////////////////////////////////////////////
+
+  typedef std::function<void(std::vector<TRI_doc_mptr_copy_t> const&,
+                             std::vector<uint8_t>&)> Filter;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief creates a filter for a worker thread. called on the thread that
+  /// uses the scanner
+  //////////////////////////////////////////////////////////////////////////////
+
+  typedef std::function<Filter()> FilterFactory;
+
+  ParallelCollectionScanner(arangodb::AqlTransaction*,
+                            TRI_transaction_collection_t*, size_t,
+                            FilterFactory const&);
+
+  ~ParallelCollectionScanner();
+
+  int scan(std::vector<TRI_doc_mptr_copy_t>&, size_t) override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the next batch of documents. the documents which the
+  /// filter could not decide on are flagged in the second vector
+  //////////////////////////////////////////////////////////////////////////////
+
+  int scan(std::vector<TRI_doc_mptr_copy_t>&, std::vector<uint8_t>&);
+
+  void reset() override;
+
+  int forward(size_t, size_t&) override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of documents read from the index so far
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t scanned() const { return _scanned.load(); }
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a range of slots in a bucket of the primary index
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Range {
+    size_t bucketId;
+    uint64_t from;
+    uint64_t to;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the documents produced for a range
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Batch {
+    std::vector<TRI_doc_mptr_copy_t> documents;
+    std::vector<uint8_t> undecided;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief split the index into ranges and hand out the workers to the
+  /// thread pool
+  //////////////////////////////////////////////////////////////////////////////
+
+  int start();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief stop the workers and wait until all of them have finished
+  //////////////////////////////////////////////////////////////////////////////
+
+  void stop();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief produce the documents of a range
+  //////////////////////////////////////////////////////////////////////////////
+
+  void scanRange(Range const&, Filter const&, Batch&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief main loop of a worker, using the filter with the given index
+  //////////////////////////////////////////////////////////////////////////////
+
+  void work(size_t);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief apply a filter to a batch and remove the rejected documents
+  //////////////////////////////////////////////////////////////////////////////
+
+  static void applyFilter(Filter const&, Batch&);
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of worker threads, at most the number of
+  /// processors
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t const _numThreads;
+
+  FilterFactory const _filterFactory;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the primary index, only set while the scan is running
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::PrimaryIndex* _primaryIndex;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the ranges of the index, and the next one to be scanned
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<Range> _ranges;
+
+  std::atomic<size_t> _nextRange;
+
+  std::atomic<uint64_t> _scanned;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the filter used when scanning on the calling thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  Filter _inlineFilter;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the filters of the workers of the running scan. they are owned
+  /// by the scanner, so that they are destroyed on the calling thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<Filter> _filters;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the threads running the workers, created on first use
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unique_ptr<arangodb::basics::ThreadPool> _pool;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief protects the batches, the number of running workers and the
+  /// error state
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::mutex _mutex;
+
+  std::condition_variable _condition;
+
+  std::deque<Batch> _batches;
+
+  size_t _runningThreads;
+
+  bool _started;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the collection is read incrementally on the calling
+  /// thread, because the transaction does not keep it locked
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _incremental;
+
+  bool _stopping;
+
+  int _error;
+};
 }
 }
 
@@ -40,6 +40,7 @@ bool ConditionFinder::before(ExecutionNode* en) {
     case EN::REMOTE:
     case EN::SUBQUERY:
     case EN::INDEX:
+    case EN::HASH_JOIN:
     case EN::INSERT:
     case EN::REMOVE:
     case EN::REPLACE:
@@ -47,6 +48,7 @@ bool ConditionFinder::before(ExecutionNode* en) {
     case EN::UPSERT:
     case EN::RETURN:
     case EN::TRAVERSAL:
+    case EN::SHORTEST_PATH:
       // in these cases we simply ignore the intermediate nodes, note
       // that we have taken care of nodes that could throw exceptions
       // above.
@@ -23,9 +23,11 @@
 
 #include "EnumerateCollectionBlock.h"
 #include "Aql/AqlItemBlock.h"
+#include "Aql/BatchExpression.h"
 #include "Aql/Collection.h"
 #include "Aql/CollectionScanner.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/Functions.h"
 #include "Basics/Exceptions.h"
 #include "VocBase/vocbase.h"
 
@@ -33,11 +35,69 @@ using namespace arangodb::aql;
 
 using Json = arangodb::basics::Json;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates the filters for the threads of a parallel scan. each
+/// thread evaluates the filter condition with its own batch expression.
+/// the expression is created without a query, so documents producing
+/// warnings are left undecided and are evaluated on the query's thread.
+/// the temporary blocks of the threads are charged to the query's monitor
+////////////////////////////////////////////////////////////////////////////////
+
+static ParallelCollectionScanner::FilterFactory BuildFilterFactory(
+    arangodb::AqlTransaction* trx, ResourceMonitor* resourceMonitor,
+    TRI_document_collection_t* document, Expression const* filter,
+    Variable const* variable) {
+  AstNode const* node = filter->node();
+
+  return [trx, resourceMonitor, document, node,
+          variable]() -> ParallelCollectionScanner::Filter {
+    std::shared_ptr<BatchExpression> expression(
+        new BatchExpression(node, nullptr));
+
+    return [trx, resourceMonitor, document, variable, expression](
+        std::vector<TRI_doc_mptr_copy_t> const& documents,
+        std::vector<uint8_t>& results) -> void {
+      size_t const n = documents.size();
+
+      // the documents are put into a temporary block with a single register
+      AqlItemBlock block(resourceMonitor, n, 1);
+      block.setDocumentCollection(0, document);
+
+      for (size_t i = 0; i < n; ++i) {
+        block.setShaped(i, 0, reinterpret_cast<TRI_df_marker_t const*>(
+                                  documents[i].getDataPtr()));
+      }
+
+      std::vector<Variable const*> const vars{variable};
+      std::vector<RegisterId> const regs{0};
+      std::vector<uint8_t> const active(n, 1);
+      std::vector<uint8_t> fallback;
+      BatchColumn column;
+
+      expression->execute(trx, &block, vars, regs, active, column, fallback);
+
+      results.resize(n);
+
+      for (size_t i = 0; i < n; ++i) {
+        if (fallback[i] != 0) {
+          results[i] = ParallelCollectionScanner::FILTER_UNDECIDED;
+        } else if (column.isTrue(i)) {
+          results[i] = ParallelCollectionScanner::FILTER_ACCEPT;
+        } else {
+          results[i] = ParallelCollectionScanner::FILTER_REJECT;
+        }
+      }
+    };
+  };
+}
+
 EnumerateCollectionBlock::EnumerateCollectionBlock(
     ExecutionEngine* engine, EnumerateCollectionNode const* ep)
     : ExecutionBlock(engine, ep),
       _collection(ep->_collection),
       _scanner(nullptr),
+      _filter(ep->_filter),
+      _scannedCounted(0),
       _posInDocuments(0),
       _random(ep->_random),
       _mustStoreResult(true) {
@@ -46,7 +106,15 @@ EnumerateCollectionBlock::EnumerateCollectionBlock(
     _trx->orderDitch(trxCollection);
   }
 
-  if (_random) {
+  if (_filter != nullptr) {
+    // parallel scan, evaluating the filter on the scanning threads
+    TRI_ASSERT(!_random);
+    _scanner = new ParallelCollectionScanner(
+        _trx, trxCollection, engine->getQuery()->maxParallelism(),
+        BuildFilterFactory(_trx, engine->getQuery()->resourceMonitor(),
+                           _trx->documentCollection(_collection->cid()),
+                           _filter, ep->_outVariable));
+  } else if (_random) {
     // random scan
     _scanner = new RandomCollectionScanner(_trx, trxCollection);
   } else {
@@ -63,6 +131,7 @@ EnumerateCollectionBlock::~EnumerateCollectionBlock() { delete _scanner; }
 
 void EnumerateCollectionBlock::initializeDocuments() {
   _scanner->reset();
+  _scannedCounted = 0;
   _documents.clear();
   _posInDocuments = 0;
 }
@@ -73,6 +142,28 @@ void EnumerateCollectionBlock::initializeDocuments() {
 
 bool EnumerateCollectionBlock::skipDocuments(size_t toSkip, size_t& skipped) {
   throwIfKilled();  // check if we were aborted
+
+  if (_filter != nullptr) {
+    // the filter must be applied, so the documents are fetched and dropped
+    while (toSkip > 0) {
+      if (_posInDocuments >= _documents.size() && !moreFilteredDocuments()) {
+        return false;
+      }
+
+      size_t const n =
+          (std::min)(toSkip, _documents.size() - _posInDocuments);
+      _posInDocuments += n;
+      skipped += n;
+      toSkip -= n;
+    }
+
+    if (_posInDocuments >= _documents.size()) {
+      _documents.clear();
+      _posInDocuments = 0;
+    }
+    return true;
+  }
+
   size_t skippedHere = 0;
 
   int res = _scanner->forward(toSkip, skippedHere);
@@ -111,6 +202,10 @@ bool EnumerateCollectionBlock::moreDocuments(size_t hint) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
   }
 
+  if (_filter != nullptr) {
+    return moreFilteredDocuments();
+  }
+
   std::vector<TRI_doc_mptr_copy_t> newDocs;
   newDocs.reserve(hint);
 
@@ -132,6 +227,100 @@ bool EnumerateCollectionBlock::moreDocuments(size_t hint) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief continue fetching of documents from a parallel scan
+////////////////////////////////////////////////////////////////////////////////
+
+bool EnumerateCollectionBlock::moreFilteredDocuments() {
+  auto scanner = static_cast<ParallelCollectionScanner*>(_scanner);
+  auto ep = static_cast<EnumerateCollectionNode const*>(_exeNode);
+
+  std::vector<TRI_doc_mptr_copy_t> newDocs;
+  std::vector<uint8_t> undecided;
+
+  while (true) {
+    throwIfKilled();  // check if we were aborted
+
+    int res = scanner->scan(newDocs, undecided);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+
+    uint64_t const scanned = scanner->scanned();
+    size_t const accepted = newDocs.size();
+    _engine->_stats.scannedFull +=
+        static_cast<int64_t>(scanned - _scannedCounted);
+    _engine->_stats.filtered +=
+        static_cast<int64_t>(scanned - _scannedCounted - accepted);
+    _scannedCounted = scanned;
+
+    if (newDocs.empty()) {
+      return false;
+    }
+
+    if (std::find(undecided.begin(), undecided.end(), 1) != undecided.end()) {
+      // evaluate the filter for the undecided documents on this thread
+      size_t const n = newDocs.size();
+      AqlItemBlock* block = requestBlock(n, 1);
+
+      try {
+        block->setDocumentCollection(
+            0, _trx->documentCollection(_collection->cid()));
+
+        for (size_t i = 0; i < n; ++i) {
+          block->setShaped(i, 0, reinterpret_cast<TRI_df_marker_t const*>(
+                                     newDocs[i].getDataPtr()));
+        }
+
+        std::vector<Variable const*> const vars{ep->_outVariable};
+        std::vector<RegisterId> const regs{0};
+        size_t j = 0;
+
+        Functions::InitializeThreadContext();
+        try {
+          for (size_t i = 0; i < n; ++i) {
+            if (undecided[i] != 0) {
+              TRI_document_collection_t const* myCollection = nullptr;
+              AqlValue a =
+                  _filter->execute(_trx, block, i, vars, regs, &myCollection);
+              bool const keep = a.isTrue();
+              a.destroy();
+
+              if (!keep) {
+                _engine->_stats.filtered++;
+                continue;
+              }
+            }
+
+            if (i != j) {
+              newDocs[j] = newDocs[i];
+            }
+            ++j;
+          }
+          Functions::DestroyThreadContext();
+        } catch (...) {
+          Functions::DestroyThreadContext();
+          throw;
+        }
+
+        newDocs.resize(j);
+      } catch (...) {
+        returnBlock(block);
+        throw;
+      }
+
+      returnBlock(block);
+    }
+
+    if (!newDocs.empty()) {
+      _documents.swap(newDocs);
+      _posInDocuments = 0;
+      return true;
+    }
+  }
+}
+
 int EnumerateCollectionBlock::initialize() {
   auto ep = static_cast<EnumerateCollectionNode const*>(_exeNode);
   _mustStoreResult = ep->isVarUsedLater(ep->_outVariable);
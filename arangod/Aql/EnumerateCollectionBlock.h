@@ -35,6 +35,7 @@ class AqlItemBlock;
 struct Collection;
 struct CollectionScanner;
 class ExecutionEngine;
+class Expression;
 
 class EnumerateCollectionBlock : public ExecutionBlock {
  public:
@@ -61,6 +62,13 @@ class EnumerateCollectionBlock : public ExecutionBlock {
 
   bool moreDocuments(size_t hint);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief continue fetching of documents from a parallel scan. the
+  /// documents the scanning threads could not decide on are filtered here
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool moreFilteredDocuments();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief initialize, here we fetch all docs from the database
   //////////////////////////////////////////////////////////////////////////////
@@ -100,6 +108,19 @@ class EnumerateCollectionBlock : public ExecutionBlock {
 
   CollectionScanner* _scanner;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief filter condition of a parallel scan, may be a nullptr
+  //////////////////////////////////////////////////////////////////////////////
+
+  Expression* _filter;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of documents read by the parallel scan that have already
+  /// been counted in the statistics
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t _scannedCounted;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief document buffer
   //////////////////////////////////////////////////////////////////////////////
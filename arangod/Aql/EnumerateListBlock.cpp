@@ -146,7 +146,7 @@ AqlItemBlock* EnumerateListBlock::getSome(size_t, size_t atMost) {
       size_t toSend = (std::min)(atMost, sizeInVar - _index);
 
       // create the result
-      res.reset(new AqlItemBlock(
+      res.reset(requestBlock(
           toSend,
           getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
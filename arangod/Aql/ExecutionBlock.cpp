@@ -38,7 +38,8 @@ ExecutionBlock::ExecutionBlock(ExecutionEngine* engine, ExecutionNode const* ep)
     : _engine(engine),
       _trx(engine->getQuery()->trx()),
       _exeNode(ep),
-      _done(false) {}
+      _done(false),
+      _profile(engine->getQuery()->profiling()) {}
 
 ExecutionBlock::~ExecutionBlock() {
   for (auto& it : _buffer) {
@@ -273,6 +274,49 @@ void ExecutionBlock::inheritRegisters(AqlItemBlock const* src,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getSome for callers fetching from this block
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* ExecutionBlock::getSomeProfiled(size_t atLeast, size_t atMost) {
+  if (!_profile) {
+    return getSome(atLeast, atMost);
+  }
+
+  double const start = TRI_microtime();
+  AqlItemBlock* result = getSome(atLeast, atMost);
+  addProfile(result == nullptr ? 0 : result->size(), TRI_microtime() - start);
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skipSome for callers fetching from this block
+////////////////////////////////////////////////////////////////////////////////
+
+size_t ExecutionBlock::skipSomeProfiled(size_t atLeast, size_t atMost) {
+  if (!_profile) {
+    return skipSome(atLeast, atMost);
+  }
+
+  double const start = TRI_microtime();
+  size_t skipped = skipSome(atLeast, atMost);
+  addProfile(skipped, TRI_microtime() - start);
+
+  return skipped;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add a call to the per-node statistics of the engine
+////////////////////////////////////////////////////////////////////////////////
+
+void ExecutionBlock::addProfile(size_t items, double runtime) {
+  auto& stats = _engine->_stats.nodes[_exeNode->id()];
+  ++stats.calls;
+  stats.items += static_cast<int64_t>(items);
+  stats.runtime += runtime;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the following is internal to pull one more block and append it to
 /// our _buffer deque. Returns true if a new block was appended and false if
@@ -283,7 +327,7 @@ bool ExecutionBlock::getBlock(size_t atLeast, size_t atMost) {
   throwIfKilled();  // check if we were aborted
 
   std::unique_ptr<AqlItemBlock> docs(
-      _dependencies[0]->getSome(atLeast, atMost));
+      _dependencies[0]->getSomeProfiled(atLeast, atMost));
 
   if (docs == nullptr) {
     return false;
@@ -348,10 +392,10 @@ size_t ExecutionBlock::skipSome(size_t atLeast, size_t atMost) {
 // skip exactly <number> outputs, returns <true> if _done after
 // skipping, and <false> otherwise . . .
 bool ExecutionBlock::skip(size_t number) {
-  size_t skipped = skipSome(number, number);
+  size_t skipped = skipSomeProfiled(number, number);
   size_t nr = skipped;
   while (nr != 0 && skipped < number) {
-    nr = skipSome(number - skipped, number - skipped);
+    nr = skipSomeProfiled(number - skipped, number - skipped);
     skipped += nr;
   }
   if (nr == 0) {
@@ -156,6 +156,16 @@ class ExecutionBlock {
 
   virtual AqlItemBlock* getSome(size_t atLeast, size_t atMost);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief getSome and skipSome for callers fetching from this block. these
+  /// record the calls in the per-node statistics of the engine if the query
+  /// is profiled, and forward to the virtual methods otherwise
+  //////////////////////////////////////////////////////////////////////////////
+
+  AqlItemBlock* getSomeProfiled(size_t atLeast, size_t atMost);
+
+  size_t skipSomeProfiled(size_t atLeast, size_t atMost);
+
  protected:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief request an AqlItemBlock from the memory manager
@@ -211,6 +221,12 @@ class ExecutionBlock {
 
   void clearRegisters(AqlItemBlock* result);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief add a call to the per-node statistics of the engine
+  //////////////////////////////////////////////////////////////////////////////
+
+  void addProfile(size_t items, double runtime);
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief getSome, skips some more items, semantic is as follows: not
@@ -228,7 +244,7 @@ class ExecutionBlock {
 
   virtual bool hasMore();
 
-  virtual int64_t count() const { return _dependencies[0]->count(); }
+  virtual int64_t count() { return _dependencies[0]->count(); }
 
   virtual int64_t remaining();
 
@@ -292,6 +308,12 @@ class ExecutionBlock {
 
   bool _done;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the calls to this block are profiled
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool const _profile;
+
  public:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief batch size value
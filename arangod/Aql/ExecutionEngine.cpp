@@ -33,8 +33,10 @@
 #include "Aql/ExecutionBlock.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
+#include "Aql/HashJoinBlock.h"
 #include "Aql/IndexBlock.h"
 #include "Aql/ModificationBlocks.h"
+#include "Aql/ShortestPathBlock.h"
 #include "Aql/QueryRegistry.h"
 #include "Aql/SortBlock.h"
 #include "Aql/SubqueryBlock.h"
@@ -71,9 +73,16 @@ static ExecutionBlock* CreateBlock(
       return new EnumerateListBlock(engine,
                                     static_cast<EnumerateListNode const*>(en));
     }
+    case ExecutionNode::HASH_JOIN: {
+      return new HashJoinBlock(engine, static_cast<HashJoinNode const*>(en));
+    }
     case ExecutionNode::TRAVERSAL: {
       return new TraversalBlock(engine, static_cast<TraversalNode const*>(en));
     }
+    case ExecutionNode::SHORTEST_PATH: {
+      return new ShortestPathBlock(engine,
+                                   static_cast<ShortestPathNode const*>(en));
+    }
     case ExecutionNode::CALCULATION: {
       return new CalculationBlock(engine,
                                   static_cast<CalculationNode const*>(en));
@@ -170,6 +179,7 @@ static ExecutionBlock* CreateBlock(
 
 ExecutionEngine::ExecutionEngine(Query* query)
     : _stats(),
+      _itemBlockManager(query->resourceMonitor()),
       _blocks(),
       _root(nullptr),
       _query(query),
@@ -503,6 +513,19 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
     optimizerOptionsRules.add(Json("-all"));
     optimizerOptions.set("rules", optimizerOptionsRules);
     options.set("optimizer", optimizerOptions);
+    if (query->memoryLimit() > 0) {
+      // the limit applies to every part of the query
+      options.set("memoryLimit",
+                  Json(static_cast<double>(query->memoryLimit())));
+    }
+    if (query->profiling()) {
+      // the DB servers report the runtime statistics of their nodes
+      options.set("profile", Json(true));
+    }
+    if (!query->transferVelocyPack()) {
+      // the DB servers talk back to the coordinator in the same format
+      options.set("transferVelocyPack", Json(false));
+    }
     result.set("options", options);
     auto body = std::make_shared<std::string const>(
         arangodb::basics::JsonHelper::toString(result.json()));
@@ -121,7 +121,7 @@ class ExecutionEngine {
   //////////////////////////////////////////////////////////////////////////////
 
   AqlItemBlock* getSome(size_t atLeast, size_t atMost) {
-    return _root->getSome(atLeast, atMost);
+    return _root->getSomeProfiled(atLeast, atMost);
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -129,14 +129,14 @@ class ExecutionEngine {
   //////////////////////////////////////////////////////////////////////////////
 
   size_t skipSome(size_t atLeast, size_t atMost) {
-    return _root->skipSome(atLeast, atMost);
+    return _root->skipSomeProfiled(atLeast, atMost);
   }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief getOne
   //////////////////////////////////////////////////////////////////////////////
 
-  AqlItemBlock* getOne() { return _root->getSome(1, 1); }
+  AqlItemBlock* getOne() { return _root->getSomeProfiled(1, 1); }
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief skip
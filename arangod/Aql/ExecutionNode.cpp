@@ -28,8 +28,10 @@
 #include "Aql/Collection.h"
 #include "Aql/CollectNode.h"
 #include "Aql/ExecutionPlan.h"
+#include "Aql/HashJoinNode.h"
 #include "Aql/IndexNode.h"
 #include "Aql/ModificationNodes.h"
+#include "Aql/ShortestPathNode.h"
 #include "Aql/SortNode.h"
 #include "Aql/TraversalNode.h"
 #include "Aql/WalkerWorker.h"
@@ -91,7 +93,9 @@ std::unordered_map<int, std::string const> const ExecutionNode::TypeNames{
     {static_cast<int>(GATHER), "GatherNode"},
     {static_cast<int>(NORESULTS), "NoResultsNode"},
     {static_cast<int>(UPSERT), "UpsertNode"},
-    {static_cast<int>(TRAVERSAL), "TraversalNode"}};
+    {static_cast<int>(TRAVERSAL), "TraversalNode"},
+    {static_cast<int>(HASH_JOIN), "HashJoinNode"},
+    {static_cast<int>(SHORTEST_PATH), "ShortestPathNode"}};
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns the type name of the node
@@ -170,8 +174,10 @@ ExecutionNode* ExecutionNode::fromJsonFactory(
       SortElementVector elements;
       bool stable =
           JsonHelper::checkAndGetBooleanValue(oneNode.json(), "stable");
+      size_t limit =
+          JsonHelper::getNumericValue<size_t>(oneNode.json(), "limit", 0);
       getSortElements(elements, plan, oneNode, "SortNode");
-      return new SortNode(plan, oneNode, elements, stable);
+      return new SortNode(plan, oneNode, elements, stable, limit);
     }
     case COLLECT: {
       Variable* expressionVariable =
@@ -288,6 +294,10 @@ ExecutionNode* ExecutionNode::fromJsonFactory(
       return new DistributeNode(plan, oneNode);
     case TRAVERSAL:
       return new TraversalNode(plan, oneNode);
+    case HASH_JOIN:
+      return new HashJoinNode(plan, oneNode);
+    case SHORTEST_PATH:
+      return new ShortestPathNode(plan, oneNode);
     case ILLEGAL: {
       THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "invalid node type");
     }
@@ -623,7 +633,7 @@ ExecutionNode const* ExecutionNode::getLoop() const {
     auto type = node->getType();
 
     if (type == ENUMERATE_COLLECTION || type == INDEX || type == TRAVERSAL ||
-        type == ENUMERATE_LIST) {
+        type == ENUMERATE_LIST || type == HASH_JOIN || type == SHORTEST_PATH) {
       return node;
     }
   }
@@ -932,6 +942,22 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       break;
     }
 
+    case ExecutionNode::HASH_JOIN: {
+      depth++;
+      nrRegsHere.emplace_back(1);
+      // create a copy of the last value here
+      // this is requried because back returns a reference and emplace/push_back
+      // may invalidate all references
+      RegisterId registerId = 1 + nrRegs.back();
+      nrRegs.emplace_back(registerId);
+
+      auto ep = static_cast<HashJoinNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(ep->outVariable()->id, VarInfo(depth, totalNrRegs));
+      totalNrRegs++;
+      break;
+    }
+
     case ExecutionNode::ENUMERATE_LIST: {
       depth++;
       nrRegsHere.emplace_back(1);
@@ -1147,11 +1173,10 @@ void ExecutionNode::RegisterPlan::after(ExecutionNode* en) {
       break;
     }
 
-    case ExecutionNode::TRAVERSAL: {
+    case ExecutionNode::TRAVERSAL:
+    case ExecutionNode::SHORTEST_PATH: {
       depth++;
-      auto ep = static_cast<TraversalNode const*>(en);
-      TRI_ASSERT(ep != nullptr);
-      auto vars = ep->getVariablesSetHere();
+      auto vars = en->getVariablesSetHere();
       nrRegsHere.emplace_back(static_cast<RegisterId>(vars.size()));
       // create a copy of the last value here
       // this is requried because back returns a reference and emplace/push_back
@@ -1249,7 +1274,14 @@ EnumerateCollectionNode::EnumerateCollectionNode(
       _collection(plan->getAst()->query()->collections()->get(
           JsonHelper::checkAndGetStringValue(base.json(), "collection"))),
       _outVariable(varFromJson(plan->getAst(), base, "outVariable")),
-      _random(JsonHelper::checkAndGetBooleanValue(base.json(), "random")) {}
+      _random(JsonHelper::checkAndGetBooleanValue(base.json(), "random")),
+      _filter(nullptr) {
+  arangodb::basics::Json filter = base.get("filter");
+
+  if (filter.isObject()) {
+    _filter = new Expression(plan->getAst(), new AstNode(plan->getAst(), filter));
+  }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief toVelocyPack, for EnumerateCollectionNode
@@ -1268,6 +1300,11 @@ void EnumerateCollectionNode::toVelocyPackHelper(VPackBuilder& nodes,
   _outVariable->toVelocyPack(nodes);
   nodes.add("random", VPackValue(_random));
 
+  if (_filter != nullptr) {
+    nodes.add(VPackValue("filter"));
+    _filter->toVelocyPack(nodes, verbose);
+  }
+
   // And close it:
   nodes.close();
   LEAVE_BLOCK
@@ -1289,6 +1326,10 @@ ExecutionNode* EnumerateCollectionNode::clone(ExecutionPlan* plan,
   auto c = new EnumerateCollectionNode(plan, _id, _vocbase, _collection,
                                        outVariable, _random);
 
+  if (_filter != nullptr) {
+    c->setFilter(_filter->clone());
+  }
+
   cloneHelper(c, plan, withDependencies, withProperties);
 
   return static_cast<ExecutionNode*>(c);
@@ -1307,7 +1348,15 @@ double EnumerateCollectionNode::estimateCost(size_t& nrItems) const {
   nrItems = incoming * count;
   // We do a full collection scan for each incoming item.
   // random iteration is slightly more expensive than linear iteration
-  return depCost + nrItems * (_random ? 1.005 : 1.0);
+  double cost = depCost + nrItems * (_random ? 1.005 : 1.0);
+
+  if (_filter != nullptr) {
+    // the filter is evaluated by the scanning threads. as for a FilterNode,
+    // we are pessimistic and do not reduce the number of items
+    cost += nrItems * 0.5;
+  }
+
+  return cost;
   LEAVE_BLOCK
 }
 
@@ -92,7 +92,9 @@ class ExecutionNode {
     DISTRIBUTE = 20,
     UPSERT = 21,
     TRAVERSAL = 22,
-    INDEX = 23
+    INDEX = 23,
+    HASH_JOIN = 24,
+    SHORTEST_PATH = 25
   };
 
   ExecutionNode() = delete;
@@ -879,7 +881,8 @@ class EnumerateCollectionNode : public ExecutionNode {
         _vocbase(vocbase),
         _collection(collection),
         _outVariable(outVariable),
-        _random(random) {
+        _random(random),
+        _filter(nullptr) {
     TRI_ASSERT(_vocbase != nullptr);
     TRI_ASSERT(_collection != nullptr);
     TRI_ASSERT(_outVariable != nullptr);
@@ -888,6 +891,8 @@ class EnumerateCollectionNode : public ExecutionNode {
   EnumerateCollectionNode(ExecutionPlan* plan,
                           arangodb::basics::Json const& base);
 
+  ~EnumerateCollectionNode() { delete _filter; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief return the type of the node
   //////////////////////////////////////////////////////////////////////////////
@@ -930,6 +935,12 @@ class EnumerateCollectionNode : public ExecutionNode {
 
   void setRandom() { _random = true; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the documents are iterated in random order
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool isRandom() const { return _random; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief return the database
   //////////////////////////////////////////////////////////////////////////////
@@ -948,6 +959,22 @@ class EnumerateCollectionNode : public ExecutionNode {
 
   Variable const* outVariable() const { return _outVariable; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the filter condition evaluated during a parallel scan,
+  /// may be a nullptr
+  //////////////////////////////////////////////////////////////////////////////
+
+  Expression* filter() const { return _filter; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the filter condition, the node takes over ownership
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setFilter(Expression* filter) {
+    delete _filter;
+    _filter = filter;
+  }
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief the database
@@ -972,6 +999,13 @@ class EnumerateCollectionNode : public ExecutionNode {
   //////////////////////////////////////////////////////////////////////////////
 
   bool _random;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief filter condition on the out variable, evaluated by the threads of
+  /// a parallel scan. set by the parallel-collection-scan optimizer rule
+  //////////////////////////////////////////////////////////////////////////////
+
+  Expression* _filter;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1139,6 +1173,12 @@ class LimitNode : public ExecutionNode {
 
   void setFullCount() { _fullCount = true; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the node fully counts what it limits
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool fullCount() const { return _fullCount; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief return the offset value
   //////////////////////////////////////////////////////////////////////////////
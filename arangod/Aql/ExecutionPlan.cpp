@@ -34,6 +34,7 @@
 #include "Aql/Optimizer.h"
 #include "Aql/Query.h"
 #include "Aql/SortNode.h"
+#include "Aql/ShortestPathNode.h"
 #include "Aql/TraversalNode.h"
 #include "Aql/Variable.h"
 #include "Aql/WalkerWorker.h"
@@ -620,55 +621,39 @@ ExecutionNode* ExecutionPlan::fromNodeFor(ExecutionNode* previous,
 ExecutionNode* ExecutionPlan::fromNodeTraversal(ExecutionNode* previous,
                                                 AstNode const* node) {
   TRI_ASSERT(node != nullptr && node->type == NODE_TYPE_TRAVERSAL);
-  TRI_ASSERT(node->numMembers() >= 4);
-  TRI_ASSERT(node->numMembers() <= 6);
+  TRI_ASSERT(node->numMembers() >= 5);
+  TRI_ASSERT(node->numMembers() <= 7);
 
-  // the first 3 members are used by traversal internally.
-  // The members 4-6, where 5 and 6 are optional, are used
+  // the first 4 members are used by traversal internally.
+  // The members 5-7, where 6 and 7 are optional, are used
   // as out variables.
   AstNode const* direction = node->getMember(0);
   AstNode const* start = node->getMember(1);
   AstNode const* graph = node->getMember(2);
+  AstNode const* options = node->getMember(3);
 
-  if (start->type == NODE_TYPE_OBJECT && start->isConstant()) {
-    size_t n = start->numMembers();
-    for (size_t i = 0; i < n; ++i) {
-      auto member = start->getMember(i);
-      if (member->type == NODE_TYPE_OBJECT_ELEMENT &&
-          strncmp(member->getStringValue(), TRI_VOC_ATTRIBUTE_ID,
-                  member->getStringLength()) == 0) {
-        start = member->getMember(0);
-        break;
-      }
-    }
-  }
+  start = parseTraversalVertexNode(previous, start);
 
-  if (start->type != NODE_TYPE_REFERENCE && start->type != NODE_TYPE_VALUE) {
-    // operand is some misc expression
-    auto calc = createTemporaryCalculation(start, previous);
-    start = _ast->createNodeReference(getOutVariable(calc));
-    previous = calc;
-  }
   // First create the node
   auto travNode = new TraversalNode(this, nextId(), _ast->query()->vocbase(),
-                                    direction, start, graph);
+                                    direction, start, graph, options);
 
-  auto variable = node->getMember(3);
+  auto variable = node->getMember(4);
   TRI_ASSERT(variable->type == NODE_TYPE_VARIABLE);
   auto v = static_cast<Variable*>(variable->getData());
   TRI_ASSERT(v != nullptr);
   travNode->setVertexOutput(v);
 
-  if (node->numMembers() > 4) {
+  if (node->numMembers() > 5) {
     // return the edge as well
-    variable = node->getMember(4);
+    variable = node->getMember(5);
     TRI_ASSERT(variable->type == NODE_TYPE_VARIABLE);
     v = static_cast<Variable*>(variable->getData());
     TRI_ASSERT(v != nullptr);
     travNode->setEdgeOutput(v);
-    if (node->numMembers() > 5) {
+    if (node->numMembers() > 6) {
       // return the path as well
-      variable = node->getMember(5);
+      variable = node->getMember(6);
       TRI_ASSERT(variable->type == NODE_TYPE_VARIABLE);
       v = static_cast<Variable*>(variable->getData());
       TRI_ASSERT(v != nullptr);
@@ -681,6 +666,85 @@ ExecutionNode* ExecutionPlan::fromNodeTraversal(ExecutionNode* previous,
   return addDependency(previous, en);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an execution plan element from an AST SHORTEST_PATH or
+/// K_SHORTEST_PATHS node
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* ExecutionPlan::fromNodeShortestPath(ExecutionNode* previous,
+                                                   AstNode const* node) {
+  TRI_ASSERT(node != nullptr && (node->type == NODE_TYPE_SHORTEST_PATH ||
+                                 node->type == NODE_TYPE_K_SHORTEST_PATHS));
+  TRI_ASSERT(node->numMembers() >= 6);
+  TRI_ASSERT(node->numMembers() <= 7);
+
+  // the first 5 members are used by the shortest path internally.
+  // The members 6 and 7, where 7 is optional, are used
+  // as out variables. K_SHORTEST_PATHS only has a path variable.
+  AstNode const* direction = node->getMember(0);
+  AstNode const* start = parseTraversalVertexNode(previous, node->getMember(1));
+  AstNode const* target =
+      parseTraversalVertexNode(previous, node->getMember(2));
+  AstNode const* graph = node->getMember(3);
+  AstNode const* options = node->getMember(4);
+
+  auto spNode =
+      new ShortestPathNode(this, nextId(), _ast->query()->vocbase(),
+                           direction, start, target, graph, options);
+
+  auto variable = node->getMember(5);
+  TRI_ASSERT(variable->type == NODE_TYPE_VARIABLE);
+  auto v = static_cast<Variable*>(variable->getData());
+  TRI_ASSERT(v != nullptr);
+  if (node->type == NODE_TYPE_K_SHORTEST_PATHS) {
+    spNode->setPathOutput(v);
+  } else {
+    spNode->setVertexOutput(v);
+  }
+
+  if (node->numMembers() > 6) {
+    // return the edge as well
+    variable = node->getMember(6);
+    TRI_ASSERT(variable->type == NODE_TYPE_VARIABLE);
+    v = static_cast<Variable*>(variable->getData());
+    TRI_ASSERT(v != nullptr);
+    spNode->setEdgeOutput(v);
+  }
+
+  ExecutionNode* en = registerNode(spNode);
+  TRI_ASSERT(en != nullptr);
+  return addDependency(previous, en);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepare a start or target vertex of a traversal or shortest path
+////////////////////////////////////////////////////////////////////////////////
+
+AstNode const* ExecutionPlan::parseTraversalVertexNode(ExecutionNode*& previous,
+                                                       AstNode const* vertex) {
+  if (vertex->type == NODE_TYPE_OBJECT && vertex->isConstant()) {
+    size_t n = vertex->numMembers();
+    for (size_t i = 0; i < n; ++i) {
+      auto member = vertex->getMember(i);
+      if (member->type == NODE_TYPE_OBJECT_ELEMENT &&
+          strncmp(member->getStringValue(), TRI_VOC_ATTRIBUTE_ID,
+                  member->getStringLength()) == 0) {
+        vertex = member->getMember(0);
+        break;
+      }
+    }
+  }
+
+  if (vertex->type != NODE_TYPE_REFERENCE && vertex->type != NODE_TYPE_VALUE) {
+    // operand is some misc expression
+    auto calc = createTemporaryCalculation(vertex, previous);
+    vertex = _ast->createNodeReference(getOutVariable(calc));
+    previous = calc;
+  }
+
+  return vertex;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an execution plan element from an AST FILTER node
 ////////////////////////////////////////////////////////////////////////////////
@@ -1462,6 +1526,12 @@ ExecutionNode* ExecutionPlan::fromNode(AstNode const* node) {
         break;
       }
 
+      case NODE_TYPE_SHORTEST_PATH:
+      case NODE_TYPE_K_SHORTEST_PATHS: {
+        en = fromNodeShortestPath(en, member);
+        break;
+      }
+
       case NODE_TYPE_FILTER: {
         en = fromNodeFilter(en, member);
         break;
@@ -1902,7 +1972,9 @@ bool ExecutionPlan::isDeadSimple() const {
         nodeType == ExecutionNode::ENUMERATE_COLLECTION ||
         nodeType == ExecutionNode::ENUMERATE_LIST ||
         nodeType == ExecutionNode::TRAVERSAL ||
-        nodeType == ExecutionNode::INDEX) {
+        nodeType == ExecutionNode::SHORTEST_PATH ||
+        nodeType == ExecutionNode::INDEX ||
+        nodeType == ExecutionNode::HASH_JOIN) {
       // these node types are not simple
       return false;
     }
@@ -366,6 +366,22 @@ class ExecutionPlan {
 
   ExecutionNode* fromNodeTraversal(ExecutionNode*, AstNode const*);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create an execution plan element from an AST SHORTEST_PATH or
+  /// K_SHORTEST_PATHS node
+  //////////////////////////////////////////////////////////////////////////////
+
+  ExecutionNode* fromNodeShortestPath(ExecutionNode*, AstNode const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prepare a start or target vertex of a traversal or shortest path.
+  /// an object with an _id is reduced to the _id, and any other expression
+  /// than a reference or a value is computed by a calculation inserted after
+  /// previous
+  //////////////////////////////////////////////////////////////////////////////
+
+  AstNode const* parseTraversalVertexNode(ExecutionNode*&, AstNode const*);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief create an execution plan element from an AST FILTER node
   //////////////////////////////////////////////////////////////////////////////
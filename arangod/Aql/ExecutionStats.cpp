@@ -24,7 +24,11 @@
 #include "Aql/ExecutionStats.h"
 #include "Basics/Exceptions.h"
 
+#include "Basics/VelocyPackHelper.h"
+
 #include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
 #include <velocypack/Value.h>
 #include <velocypack/velocypack-aliases.h>
 
@@ -45,12 +49,26 @@ std::shared_ptr<VPackBuilder> ExecutionStats::toVelocyPack() const {
     result->add("scannedFull", VPackValue(scannedFull));
     result->add("scannedIndex", VPackValue(scannedIndex));
     result->add("filtered", VPackValue(filtered));
+    result->add("peakMemoryUsage", VPackValue(peakMemoryUsage));
 
     if (fullCount > -1) {
       // fullCount is exceptional. it has a default value of -1 and is
       // not reported with this value
       result->add("fullCount", VPackValue(fullCount));
     }
+
+    if (!nodes.empty()) {
+      // per-node statistics are only present for profiled queries
+      result->add(VPackValue("nodes"));
+      VPackArrayBuilder guard(result.get());
+      for (auto const& it : nodes) {
+        VPackObjectBuilder node(result.get());
+        result->add("id", VPackValue(it.first));
+        result->add("calls", VPackValue(it.second.calls));
+        result->add("items", VPackValue(it.second.items));
+        result->add("runtime", VPackValue(it.second.runtime));
+      }
+    }
   }
   return result;
 }
@@ -63,6 +81,7 @@ std::shared_ptr<VPackBuilder> ExecutionStats::toVelocyPackStatic() {
   result->add("scannedFull", VPackValue(0));
   result->add("scannedIndex", VPackValue(0));
   result->add("filtered", VPackValue(0));
+  result->add("peakMemoryUsage", VPackValue(0));
   result->add("fullCount", VPackValue(-1));
   return result;
 }
@@ -72,12 +91,13 @@ std::shared_ptr<VPackBuilder> ExecutionStats::toVelocyPackStatic() {
 ////////////////////////////////////////////////////////////////////////////////
 
 Json ExecutionStats::toJson() const {
-  Json json(Json::Object, 5);
+  Json json(Json::Object, 7);
   json.set("writesExecuted", Json(static_cast<double>(writesExecuted)));
   json.set("writesIgnored", Json(static_cast<double>(writesIgnored)));
   json.set("scannedFull", Json(static_cast<double>(scannedFull)));
   json.set("scannedIndex", Json(static_cast<double>(scannedIndex)));
   json.set("filtered", Json(static_cast<double>(filtered)));
+  json.set("peakMemoryUsage", Json(static_cast<double>(peakMemoryUsage)));
 
   if (fullCount > -1) {
     // fullCount is exceptional. it has a default value of -1 and is
@@ -85,16 +105,31 @@ Json ExecutionStats::toJson() const {
     json.set("fullCount", Json(static_cast<double>(fullCount)));
   }
 
+  if (!nodes.empty()) {
+    // per-node statistics are only present for profiled queries
+    Json list(Json::Array, nodes.size());
+    for (auto const& it : nodes) {
+      Json node(Json::Object, 4);
+      node.set("id", Json(static_cast<double>(it.first)));
+      node.set("calls", Json(static_cast<double>(it.second.calls)));
+      node.set("items", Json(static_cast<double>(it.second.items)));
+      node.set("runtime", Json(it.second.runtime));
+      list.add(node);
+    }
+    json.set("nodes", list);
+  }
+
   return json;
 }
 
 Json ExecutionStats::toJsonStatic() {
-  Json json(Json::Object, 7);
+  Json json(Json::Object, 8);
   json.set("writesExecuted", Json(0.0));
   json.set("writesIgnored", Json(0.0));
   json.set("scannedFull", Json(0.0));
   json.set("scannedIndex", Json(0.0));
   json.set("filtered", Json(0.0));
+  json.set("peakMemoryUsage", Json(0.0));
   json.set("fullCount", Json(-1.0));
   json.set("static", Json(0.0));
 
@@ -107,7 +142,8 @@ ExecutionStats::ExecutionStats()
       scannedFull(0),
       scannedIndex(0),
       filtered(0),
-      fullCount(-1) {}
+      fullCount(-1),
+      peakMemoryUsage(0) {}
 
 ExecutionStats::ExecutionStats(arangodb::basics::Json const& jsonStats) {
   if (!jsonStats.isObject()) {
@@ -129,4 +165,84 @@ ExecutionStats::ExecutionStats(arangodb::basics::Json const& jsonStats) {
   // note: fullCount is an optional attribute!
   fullCount =
       JsonHelper::getNumericValue<int64_t>(jsonStats.json(), "fullCount", -1);
+
+  // note: peakMemoryUsage is optional, as older servers do not send it
+  peakMemoryUsage = JsonHelper::getNumericValue<int64_t>(
+      jsonStats.json(), "peakMemoryUsage", 0);
+
+  // note: nodes is optional and only sent for profiled queries
+  Json list = jsonStats.get("nodes");
+  if (list.isArray()) {
+    size_t const n = list.size();
+    for (size_t i = 0; i < n; ++i) {
+      Json node = list.at(i);
+      auto& stats = nodes[JsonHelper::checkAndGetNumericValue<size_t>(
+          node.json(), "id")];
+      stats.calls =
+          JsonHelper::checkAndGetNumericValue<int64_t>(node.json(), "calls");
+      stats.items =
+          JsonHelper::checkAndGetNumericValue<int64_t>(node.json(), "items");
+      stats.runtime =
+          JsonHelper::checkAndGetNumericValue<double>(node.json(), "runtime");
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief local helper to read a mandatory statistics value
+////////////////////////////////////////////////////////////////////////////////
+
+static int64_t checkAndGetNumber(VPackSlice const& slice, char const* name) {
+  VPackSlice value = slice.get(name);
+
+  if (!value.isNumber()) {
+    std::string msg("numeric value for '" + std::string(name) +
+                    "' not found in stats");
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, msg);
+  }
+
+  return value.getNumber<int64_t>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief instantiate the statistics from VelocyPack
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionStats::ExecutionStats(VPackSlice const& slice) {
+  if (!slice.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "stats is not an object");
+  }
+
+  writesExecuted = checkAndGetNumber(slice, "writesExecuted");
+  writesIgnored = checkAndGetNumber(slice, "writesIgnored");
+  scannedFull = checkAndGetNumber(slice, "scannedFull");
+  scannedIndex = checkAndGetNumber(slice, "scannedIndex");
+  filtered = checkAndGetNumber(slice, "filtered");
+
+  // note: fullCount is an optional attribute!
+  fullCount = arangodb::basics::VelocyPackHelper::getNumericValue<int64_t>(
+      slice, "fullCount", -1);
+
+  // note: peakMemoryUsage is optional, as older servers do not send it
+  peakMemoryUsage =
+      arangodb::basics::VelocyPackHelper::getNumericValue<int64_t>(
+          slice, "peakMemoryUsage", 0);
+
+  // note: nodes is optional and only sent for profiled queries
+  VPackSlice list = slice.get("nodes");
+  if (list.isArray()) {
+    for (auto const& node : VPackArrayIterator(list)) {
+      if (!node.isObject()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "node stats is not an object");
+      }
+      auto& stats = nodes[static_cast<size_t>(checkAndGetNumber(node, "id"))];
+      stats.calls = checkAndGetNumber(node, "calls");
+      stats.items = checkAndGetNumber(node, "items");
+      stats.runtime =
+          arangodb::basics::VelocyPackHelper::getNumericValue<double>(
+              node, "runtime", 0.0);
+    }
+  }
 }
@@ -30,9 +30,52 @@
 namespace arangodb {
 namespace velocypack {
 class Builder;
+class Slice;
 }
 namespace aql {
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief runtime statistics of a single execution node, only collected
+/// when the query is profiled
+////////////////////////////////////////////////////////////////////////////////
+
+struct ExecutionNodeStats {
+  ExecutionNodeStats() : calls(0), items(0), runtime(0.0) {}
+
+  ExecutionNodeStats& operator+=(ExecutionNodeStats const& other) {
+    calls += other.calls;
+    items += other.items;
+    runtime += other.runtime;
+    return *this;
+  }
+
+  ExecutionNodeStats& operator-=(ExecutionNodeStats const& other) {
+    calls -= other.calls;
+    items -= other.items;
+    runtime -= other.runtime;
+    return *this;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of getSome/skipSome calls
+  //////////////////////////////////////////////////////////////////////////////
+
+  int64_t calls;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of rows returned or skipped
+  //////////////////////////////////////////////////////////////////////////////
+
+  int64_t items;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief wall time spent in the calls (in seconds), including the time
+  /// spent in the node's dependencies
+  //////////////////////////////////////////////////////////////////////////////
+
+  double runtime;
+};
+
 struct ExecutionStats {
   ExecutionStats();
 
@@ -42,6 +85,12 @@ struct ExecutionStats {
 
   ExecutionStats(arangodb::basics::Json const& jsonStats);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief instantiate the statistics from VelocyPack
+  //////////////////////////////////////////////////////////////////////////////
+
+  ExecutionStats(arangodb::velocypack::Slice const& slice);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief convert the statistics to VelocyPack
   //////////////////////////////////////////////////////////////////////////////
@@ -77,6 +126,11 @@ struct ExecutionStats {
     scannedIndex += summand.scannedIndex;
     fullCount += summand.fullCount;
     filtered += summand.filtered;
+    setPeakMemoryUsage(summand.peakMemoryUsage);
+
+    for (auto const& it : summand.nodes) {
+      nodes[it.first] += it.second;
+    }
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -91,6 +145,28 @@ struct ExecutionStats {
     scannedIndex += newStats.scannedIndex - lastStats.scannedIndex;
     fullCount += newStats.fullCount - lastStats.fullCount;
     filtered += newStats.filtered - lastStats.filtered;
+    setPeakMemoryUsage(newStats.peakMemoryUsage);
+
+    for (auto const& it : newStats.nodes) {
+      auto& stats = nodes[it.first];
+      stats += it.second;
+
+      auto last = lastStats.nodes.find(it.first);
+      if (last != lastStats.nodes.end()) {
+        stats -= (*last).second;
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief raise the peak memory usage. the peak of a distributed query is
+  /// the maximum of the peaks of its parts
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setPeakMemoryUsage(int64_t value) {
+    if (value > peakMemoryUsage) {
+      peakMemoryUsage = value;
+    }
   }
 
   //////////////////////////////////////////////////////////////////////////////
@@ -128,6 +204,19 @@ struct ExecutionStats {
   //////////////////////////////////////////////////////////////////////////////
 
   int64_t fullCount;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of bytes used by the query at any time
+  //////////////////////////////////////////////////////////////////////////////
+
+  int64_t peakMemoryUsage;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief runtime statistics per execution node id. this is empty unless
+  /// the query is profiled
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unordered_map<size_t, ExecutionNodeStats> nodes;
 };
 }
 }
@@ -26,6 +26,7 @@
 #include "Aql/AqlValue.h"
 #include "Aql/Ast.h"
 #include "Aql/AttributeAccessor.h"
+#include "Aql/BatchExpression.h"
 #include "Aql/Executor.h"
 #include "Aql/Quantifier.h"
 #include "Aql/V8Expression.h"
@@ -258,6 +259,37 @@ void Expression::replaceVariableReference(Variable const* variable,
   _hasDeterminedAttributes = false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace attribute accesses of a variable in the expression with
+/// other expressions
+////////////////////////////////////////////////////////////////////////////////
+
+void Expression::replaceAttributeAccess(
+    Variable const* variable,
+    std::unordered_map<std::string, AstNode const*> const& replacements) {
+  _node = _ast->clone(_node);
+  TRI_ASSERT(_node != nullptr);
+
+  _node = _ast->replaceAttributeAccess(const_cast<AstNode*>(_node), variable,
+                                       replacements);
+  invalidate();
+
+  if (_type == ATTRIBUTE) {
+    if (_built) {
+      delete _accessor;
+      _accessor = nullptr;
+      _built = false;
+    }
+    // must even set back the expression type so the expression will be analyzed
+    // again
+    _type = UNPROCESSED;
+  }
+
+  const_cast<AstNode*>(_node)->clearFlags();
+  _attributes.clear();
+  _hasDeterminedAttributes = false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief invalidates an expression
 /// this only has an effect for V8-based functions, which need to be created,
@@ -547,6 +579,18 @@ bool Expression::isAttributeAccess() const {
   return _node->isAttributeAccessForVariable();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether the expression can be evaluated for a whole
+/// AqlItemBlock at once
+////////////////////////////////////////////////////////////////////////////////
+
+bool Expression::isBatchable() {
+  if (_type == UNPROCESSED) {
+    analyzeExpression();
+  }
+  return (_type == SIMPLE && BatchExpression::IsSupported(_node));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief check whether this is a reference access
 ////////////////////////////////////////////////////////////////////////////////
@@ -192,6 +192,13 @@ class Expression {
     return _type == V8;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief check whether the expression can be evaluated for a whole
+  /// AqlItemBlock at once
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool isBatchable();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief get expression type as string
   //////////////////////////////////////////////////////////////////////////////
@@ -268,6 +275,15 @@ class Expression {
 
   void replaceVariableReference(Variable const*, AstNode const*);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief replace attribute accesses of a variable in the expression with
+  /// other expressions (e.g. inserting `doc.name` for `p.name` if p is
+  /// `{ name: doc.name }`)
+  //////////////////////////////////////////////////////////////////////////////
+
+  void replaceAttributeAccess(
+      Variable const*, std::unordered_map<std::string, AstNode const*> const&);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief invalidates an expression
   /// this only has an effect for V8-based functions, which need to be created,
@@ -23,6 +23,8 @@
 
 #include "Functions.h"
 #include "Aql/Function.h"
+#include "Aql/GraphMeasures.h"
+#include "Aql/Graphs.h"
 #include "Aql/Query.h"
 #include "Basics/Exceptions.h"
 #include "Basics/fpconv.h"
@@ -30,6 +32,7 @@
 #include "Basics/json-utilities.h"
 #include "Basics/ScopeGuard.h"
 #include "Basics/StringBuffer.h"
+#include "Basics/system-functions.h"
 #include "Basics/Utf8Helper.h"
 #include "Basics/VPackStringBufferAdapter.h"
 #include "FulltextIndex/fulltext-index.h"
@@ -48,6 +51,8 @@
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
+#include <unicode/unistr.h>
+
 using namespace arangodb::aql;
 using Json = arangodb::basics::Json;
 using CollectionNameResolver = arangodb::CollectionNameResolver;
@@ -1529,2309 +1534,2343 @@ static void FlattenList(VPackSlice const& array, size_t maxDepth,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief called before a query starts
-/// has the chance to set up any thread-local storage
-////////////////////////////////////////////////////////////////////////////////
-
-void Functions::InitializeThreadContext() {}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief called when a query ends
-/// its responsibility is to clear any thread-local storage
-////////////////////////////////////////////////////////////////////////////////
-
-void Functions::DestroyThreadContext() { ClearRegexCache(); }
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_NULL
+/// @brief build a null result value
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsNull(arangodb::aql::Query* q, arangodb::AqlTransaction* trx,
-                           FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(IsNullVPack(q, trx, tmp));
-#else
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isNull()));
-#endif
-}
-
-AqlValue$ Functions::IsNullVPack(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 VPackFunctionParameters const& parameters) {
-  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
+static AqlValue$ NullValue(arangodb::aql::Query* query) {
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(slice.isNull()));
+  b->add(VPackValue(VPackValueType::Null));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_BOOL
+/// @brief build a numeric result value
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsBool(arangodb::aql::Query* q, arangodb::AqlTransaction* trx,
-                           FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(IsBoolVPack(q, trx, tmp));
-#else
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isBoolean()));
-#endif
-}
-
-AqlValue$ Functions::IsBoolVPack(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 VPackFunctionParameters const& parameters) {
-  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
+static AqlValue$ NumberValue(arangodb::aql::Query* query, double value) {
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(slice.isBool()));
+  b->add(VPackValue(value));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_NUMBER
+/// @brief build a string result value
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsNumber(arangodb::aql::Query* q,
-                             arangodb::AqlTransaction* trx,
-                             FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(IsNumberVPack(q, trx, tmp));
-#else
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isNumber()));
-#endif
-}
-
-AqlValue$ Functions::IsNumberVPack(arangodb::aql::Query* query,
-                                   arangodb::AqlTransaction* trx,
-                                   VPackFunctionParameters const& parameters) {
-  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
+static AqlValue$ StringValue(arangodb::aql::Query* query,
+                             std::string const& value) {
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(slice.isNumber()));
+  b->add(VPackValue(value));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_STRING
+/// @brief convert a value into a string, using the same rules as TO_STRING
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsString(arangodb::aql::Query* q,
-                             arangodb::AqlTransaction* trx,
-                             FunctionParameters const& parameters) {
+static std::string ValueToString(VPackSlice const& slice) {
+  if (slice.isString()) {
+    return slice.copyString();
+  }
+  if (slice.isNone()) {
+    return "null";
+  }
 
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(IsStringVPack(q, trx, tmp));
-#else
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isString()));
-#endif
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+  AppendAsString(adapter, slice);
+  return std::string(buffer.c_str(), buffer.length());
 }
 
-AqlValue$ Functions::IsStringVPack(arangodb::aql::Query* query,
-                                   arangodb::AqlTransaction* trx,
-                                   VPackFunctionParameters const& parameters) {
-  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(slice.isString()));
-  return AqlValue$(b.get());
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert a value into a UTF-16 string. the positions and lengths
+/// used by the AQL string functions are counted in UTF-16 code units, as
+/// they always have been in the JavaScript implementations
+////////////////////////////////////////////////////////////////////////////////
+
+static icu::UnicodeString ValueToUnicodeString(VPackSlice const& slice) {
+  std::string const value = ValueToString(slice);
+  return icu::UnicodeString::fromUTF8(
+      icu::StringPiece(value.c_str(), static_cast<int32_t>(value.size())));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_ARRAY
+/// @brief build a string result value from a UTF-16 string
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsArray(arangodb::aql::Query* q,
-                            arangodb::AqlTransaction* trx,
-                            FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(IsArrayVPack(q, trx, tmp));
-#else
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isArray()));
-#endif
+static AqlValue$ UnicodeStringValue(arangodb::aql::Query* query,
+                                    icu::UnicodeString const& value) {
+  std::string result;
+  value.toUTF8String(result);
+  return StringValue(query, result);
 }
 
-AqlValue$ Functions::IsArrayVPack(arangodb::aql::Query* query,
-                                  arangodb::AqlTransaction* trx,
-                                  VPackFunctionParameters const& parameters) {
-  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(slice.isArray()));
-  return AqlValue$(b.get());
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert a number into an integer the way JavaScript's ToInteger
+/// does, and clamp it into the given range
+////////////////////////////////////////////////////////////////////////////////
+
+static int32_t ToClampedInteger(double value, int32_t min, int32_t max) {
+  if (std::isnan(value)) {
+    return 0;
+  }
+  value = std::trunc(value);
+  if (value < static_cast<double>(min)) {
+    return min;
+  }
+  if (value > static_cast<double>(max)) {
+    return max;
+  }
+  return static_cast<int32_t>(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_OBJECT
+/// @brief extract a substring, with the semantics of JavaScript's substr()
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsObject(arangodb::aql::Query* q,
-                             arangodb::AqlTransaction* trx,
-                             FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(IsObjectVPack(q, trx, tmp));
-#else
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
-  return AqlValue(new Json(value.isObject()));
-#endif
+static icu::UnicodeString Substr(icu::UnicodeString const& value, double start,
+                                 double length) {
+  int32_t const size = value.length();
+  int32_t offset = ToClampedInteger(start, -size, size);
+  if (offset < 0) {
+    offset = (std::max)(size + offset, 0);
+  }
+  int32_t const count = ToClampedInteger(length, 0, size - offset);
+  return value.tempSubString(offset, count);
 }
 
-AqlValue$ Functions::IsObjectVPack(arangodb::aql::Query* query,
-                                   arangodb::AqlTransaction* trx,
-                                   VPackFunctionParameters const& parameters) {
-  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(slice.isObject()));
-  return AqlValue$(b.get());
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find a string, with the semantics of JavaScript's indexOf()
+////////////////////////////////////////////////////////////////////////////////
+
+static int32_t IndexOf(icu::UnicodeString const& value,
+                       icu::UnicodeString const& search, double start) {
+  int32_t const offset = ToClampedInteger(start, 0, value.length());
+  if (search.isEmpty()) {
+    return offset;
+  }
+  return value.indexOf(search, offset);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function TO_NUMBER
+/// @brief find a string, with the semantics of JavaScript's lastIndexOf()
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::ToNumber(arangodb::aql::Query* q,
-                             arangodb::AqlTransaction* trx,
-                             FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(ToNumberVPack(q, trx, tmp));
-#else
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+static int32_t LastIndexOf(icu::UnicodeString const& value,
+                           icu::UnicodeString const& search) {
+  if (search.isEmpty()) {
+    return value.length();
+  }
+  return value.lastIndexOf(search);
+}
 
-  bool isValid;
-  double v = ValueToNumber(value.json(), isValid);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a UTF-16 code unit is whitespace, using the same
+/// definition as JavaScript's \s
+////////////////////////////////////////////////////////////////////////////////
 
-  if (!isValid) {
-    return AqlValue(new Json(Json::Null));
+static bool IsWhitespace(UChar c) {
+  switch (c) {
+    case 0x0009:
+    case 0x000a:
+    case 0x000b:
+    case 0x000c:
+    case 0x000d:
+    case 0x0020:
+    case 0x00a0:
+    case 0x1680:
+    case 0x2028:
+    case 0x2029:
+    case 0x202f:
+    case 0x205f:
+    case 0x3000:
+    case 0xfeff:
+      return true;
+    default:
+      return (c >= 0x2000 && c <= 0x200a);
   }
-  return AqlValue(new Json(v));
-#endif
 }
 
-AqlValue$ Functions::ToNumberVPack(arangodb::aql::Query* query,
-                                  arangodb::AqlTransaction* trx,
-                                  VPackFunctionParameters const& parameters) {
-  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief strip characters from the start and/or the end of a string.
+/// strips whitespace if no characters are given
+////////////////////////////////////////////////////////////////////////////////
 
-  bool isValid;
-  double v = ValueToNumber(slice, isValid);
+static icu::UnicodeString Trim(icu::UnicodeString const& value, bool left,
+                               bool right, icu::UnicodeString const* chars) {
+  auto strip = [&chars](UChar c) -> bool {
+    if (chars == nullptr) {
+      return IsWhitespace(c);
+    }
+    return (chars->indexOf(c) != -1);
+  };
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  int32_t start = 0;
+  int32_t end = value.length();
 
-  if (!isValid) {
-    b->add(VPackValue(VPackValueType::Null));
-  } else {
-    b->add(VPackValue(v));
+  if (left) {
+    while (start < end && strip(value.charAt(start))) {
+      ++start;
+    }
   }
-  return AqlValue$(b.get());
+  if (right) {
+    while (end > start && strip(value.charAt(end - 1))) {
+      --end;
+    }
+  }
+
+  return value.tempSubString(start, end - start);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function TO_STRING
+/// @brief find the next occurrence of any of the patterns in value, starting
+/// at position start. if multiple patterns match at the same position, the
+/// first one wins, as with a regex alternation. returns the position of the
+/// match and the index of the pattern, or -1 if nothing matches
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::ToString(arangodb::aql::Query* q,
-                             arangodb::AqlTransaction* trx,
-                             FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(ToStringVPack(q, trx, tmp));
-#else
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+static int32_t FindAnyOf(icu::UnicodeString const& value, int32_t start,
+                         std::vector<icu::UnicodeString> const& patterns,
+                         size_t& which) {
+  int32_t const size = value.length();
+  int32_t position = -1;
 
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  for (auto const& pattern : patterns) {
+    int32_t found;
+    if (pattern.isEmpty()) {
+      found = start;
+    } else {
+      found = value.indexOf(pattern, start);
+    }
+    if (found != -1 && (position == -1 || found < position)) {
+      position = found;
+    }
+  }
 
-  AppendAsString(buffer, value.json());
-  size_t length = buffer.length();
-  std::unique_ptr<TRI_json_t> j(
-      TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length));
+  if (position == -1) {
+    return -1;
+  }
 
-  if (j == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    int32_t const length = patterns[i].length();
+    if (length <= size - position &&
+        value.compare(position, length, patterns[i]) == 0) {
+      which = i;
+      break;
+    }
   }
 
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
-  j.release();
-  return AqlValue(jr);
-#endif
+  return position;
 }
 
-AqlValue$ Functions::ToStringVPack(arangodb::aql::Query* query,
-                                   arangodb::AqlTransaction* trx,
-                                   VPackFunctionParameters const& parameters) {
-  auto const value = ExtractFunctionParameter(trx, parameters, 0);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief date handling. dates are handled as milliseconds since the Unix
+/// epoch, in UTC and in the proleptic Gregorian calendar, the same way as
+/// JavaScript Date objects
+////////////////////////////////////////////////////////////////////////////////
 
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+static int64_t const MsPerSecond = 1000;
+static int64_t const MsPerMinute = 60 * MsPerSecond;
+static int64_t const MsPerHour = 60 * MsPerMinute;
+static int64_t const MsPerDay = 24 * MsPerHour;
 
-  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
-  AppendAsString(adapter, value);
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  try {
-    std::string res(buffer.begin(), buffer.length());
-    b->add(VPackValue(res));
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
-  return AqlValue$(b.get());
-}
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the largest date value supported, as in JavaScript
+////////////////////////////////////////////////////////////////////////////////
+
+static double const MaxDateValue = 8.64e15;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function TO_BOOL
+/// @brief the components of a date. months are 0-based, days are 1-based
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::ToBool(arangodb::aql::Query* q, arangodb::AqlTransaction* trx,
-                           FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(ToBoolVPack(q, trx, tmp));
-#else
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+struct DateComponents {
+  int64_t year;
+  int64_t month;
+  int64_t day;
+  int64_t hour;
+  int64_t minute;
+  int64_t second;
+  int64_t millisecond;
+  int64_t weekday;
+};
 
-  return AqlValue(new Json(ValueToBoolean(value.json())));
-#endif
-}
+////////////////////////////////////////////////////////////////////////////////
+/// @brief English month names
+////////////////////////////////////////////////////////////////////////////////
 
-AqlValue$ Functions::ToBoolVPack(arangodb::aql::Query* query,
-                                arangodb::AqlTransaction* trx,
-                                VPackFunctionParameters const& parameters) {
-  auto const value = ExtractFunctionParameter(trx, parameters, 0);
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(ValueToBoolean(value)));
-  return AqlValue$(b.get());
-}
+static char const* const MonthNames[] = {
+    "January", "February", "March",     "April",   "May",      "June",
+    "July",    "August",   "September", "October", "November", "December"};
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function TO_ARRAY
+/// @brief English weekday names
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::ToArray(arangodb::aql::Query* q,
-                            arangodb::AqlTransaction* trx,
-                            FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(ToArrayVPack(q, trx, tmp));
-#else
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+static char const* const WeekdayNames[] = {"Sunday",   "Monday", "Tuesday",
+                                           "Wednesday", "Thursday", "Friday",
+                                           "Saturday"};
 
-  if (value.isBoolean() || value.isNumber() || value.isString()) {
-    // return array with single member
-    Json array(Json::Array, 1);
-    array.add(SafeCopyJson(value.json()));
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of days before the start of each month
+////////////////////////////////////////////////////////////////////////////////
 
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
-  }
-  if (value.isArray()) {
-    // return copy of the original array
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, SafeCopyJson(value.json())));
-  }
-  if (value.isObject()) {
-    // return an array with the attribute values
-    auto const source = value.json();
-    size_t const n = TRI_LengthVector(&source->_value._objects);
+static int64_t const DayOfYearOffsets[] = {0,   31,  59,  90,  120, 151,
+                                           181, 212, 243, 273, 304, 334};
 
-    Json array(Json::Array, n);
-    for (size_t i = 1; i < n; i += 2) {
-      auto v = static_cast<TRI_json_t const*>(
-          TRI_AtVector(&source->_value._objects, i));
-      array.add(SafeCopyJson(v));
-    }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of days in each month, in non-leap years
+////////////////////////////////////////////////////////////////////////////////
 
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
-  }
+static int64_t const DaysInMonth[] = {31, 28, 31, 30, 31, 30,
+                                      31, 31, 30, 31, 30, 31};
 
-  // return empty array
-  return AqlValue(new Json(Json::Array));
-#endif
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a year is a leap year
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsLeapYear(int64_t year) {
+  return ((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0);
 }
 
-AqlValue$ Functions::ToArrayVPack(arangodb::aql::Query* query,
-                                  arangodb::AqlTransaction* trx,
-                                  VPackFunctionParameters const& parameters) {
-  auto const value = ExtractFunctionParameter(trx, parameters, 0);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief floor division
+////////////////////////////////////////////////////////////////////////////////
 
-  if (value.isArray()) {
-    // return copy of the original array
-    return AqlValue$(value);
+static int64_t FloorDiv(int64_t value, int64_t divisor) {
+  int64_t result = value / divisor;
+  if ((value % divisor) != 0 && ((value < 0) != (divisor < 0))) {
+    --result;
   }
+  return result;
+}
 
-  std::shared_ptr<VPackBuilder> result = query->getSharedBuilder();
-  {
-    VPackArrayBuilder b(result.get());
-    if (value.isBoolean() || value.isNumber() || value.isString()) {
-      // return array with single member
-      result->add(value);
-    } else if (value.isObject()) {
-      // return an array with the attribute values
-      for (auto const& it : VPackObjectIterator(value)) {
-        result->add(it.value);
-      }
-    }
-    // else return empty array
-  }
-  return AqlValue$(result.get());
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of days since 1970-01-01 of a date (month is 1-based)
+////////////////////////////////////////////////////////////////////////////////
+
+static int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day) {
+  year -= (month <= 2) ? 1 : 0;
+  int64_t const era = FloorDiv(year, 400);
+  int64_t const yoe = year - era * 400;
+  int64_t const doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int64_t const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function LENGTH
+/// @brief date of a number of days since 1970-01-01 (month is 1-based)
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Length(arangodb::aql::Query* q, arangodb::AqlTransaction* trx,
-                           FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(LengthVPack(q, trx, tmp));
-#else
-  if (!parameters.empty() && parameters[0].first.isArray()) {
-    // shortcut!
-    return AqlValue(
-        new Json(static_cast<double>(parameters[0].first.arraySize())));
-  }
+static void CivilFromDays(int64_t days, int64_t& year, int64_t& month,
+                          int64_t& day) {
+  days += 719468;
+  int64_t const era = FloorDiv(days, 146097);
+  int64_t const doe = days - era * 146097;
+  int64_t const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  int64_t const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  int64_t const mp = (5 * doy + 2) / 153;
+  day = doy - (153 * mp + 2) / 5 + 1;
+  month = mp + (mp < 10 ? 3 : -9);
+  year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+}
 
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief split a date value into its components
+////////////////////////////////////////////////////////////////////////////////
 
-  TRI_json_t const* json = value.json();
-  size_t length = 0;
+static void SplitDate(int64_t value, DateComponents& result) {
+  int64_t const days = FloorDiv(value, MsPerDay);
+  int64_t time = value - days * MsPerDay;
 
-  if (json != nullptr) {
-    switch (json->_type) {
-      case TRI_JSON_UNUSED:
-      case TRI_JSON_NULL: {
-        length = 0;
-        break;
-      }
+  CivilFromDays(days, result.year, result.month, result.day);
+  --result.month;
 
-      case TRI_JSON_BOOLEAN: {
-        length = (json->_value._boolean ? 1 : 0);
-        break;
-      }
+  result.hour = time / MsPerHour;
+  time -= result.hour * MsPerHour;
+  result.minute = time / MsPerMinute;
+  time -= result.minute * MsPerMinute;
+  result.second = time / MsPerSecond;
+  result.millisecond = time - result.second * MsPerSecond;
 
-      case TRI_JSON_NUMBER: {
-        if (std::isnan(json->_value._number) ||
-            !std::isfinite(json->_value._number)) {
-          // invalid value
-          length = strlen("null");
-        } else {
-          // convert to a string representation of the number
-          char buffer[24];
-          length =
-              static_cast<size_t>(fpconv_dtoa(json->_value._number, buffer));
-        }
-        break;
-      }
+  // 1970-01-01 was a Thursday
+  result.weekday = ((days + 4) % 7 + 7) % 7;
+}
 
-      case TRI_JSON_STRING:
-      case TRI_JSON_STRING_REFERENCE: {
-        // return number of characters (not bytes) in string
-        length = TRI_CharLengthUtf8String(json->_value._string.data);
-        break;
-      }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build a date value from its components. the components are
+/// truncated to integers and may be out of their usual range, in which case
+/// they overflow into the next larger component, as with JavaScript's
+/// Date.UTC(). returns false if the result is not a valid date
+////////////////////////////////////////////////////////////////////////////////
 
-      case TRI_JSON_OBJECT: {
-        // return number of attributes
-        length = TRI_LengthVector(&json->_value._objects) / 2;
-        break;
-      }
+static bool ComposeDate(double year, double month, double day, double hour,
+                        double minute, double second, double millisecond,
+                        int64_t& result) {
+  double* components[] = {&year,   &month,  &day,        &hour,
+                          &minute, &second, &millisecond};
 
-      case TRI_JSON_ARRAY: {
-        // return list length
-        length = TRI_LengthArrayJson(json);
-        break;
-      }
+  for (auto& it : components) {
+    if (!std::isfinite(*it)) {
+      return false;
     }
+    *it = std::trunc(*it);
   }
 
-  return AqlValue(new Json(static_cast<double>(length)));
-#endif
-}
+  double const y = year + std::floor(month / 12.0);
+  double const m = month - std::floor(month / 12.0) * 12.0;
 
-AqlValue$ Functions::LengthVPack(arangodb::aql::Query* q,
-                                 arangodb::AqlTransaction* trx,
-                                 VPackFunctionParameters const& parameters) {
-  auto const value = ExtractFunctionParameter(trx, parameters, 0);
-  std::shared_ptr<VPackBuilder> builder = q->getSharedBuilder();
-  if (value.isArray()) {
-    // shortcut!
-    builder->add(VPackValue(static_cast<double>(value.length())));
-    return AqlValue$(builder->slice());
+  // way outside of the valid range. checked here to avoid overflows below
+  if (std::abs(y) > 400000.0 || std::abs(day) > 1.0e9) {
+    return false;
   }
-  size_t length = 0;
-  if (value.isNone() || value.isNull()) {
-    length = 0;
-  } else if (value.isBoolean()) {
-    if (value.getBoolean()) {
-      length = 1;
-    } else {
-      length = 0;
-    }
-  } else if (value.isNumber()) {
-    double tmp = value.getNumericValue<double>();
-    if (std::isnan(tmp) || !std::isfinite(tmp)) {
-      length = strlen("null");
-    } else {
-      char buffer[24];
-      length = static_cast<size_t>(fpconv_dtoa(tmp, buffer));
-    }
-  } else if (value.isString()) {
-    std::string tmp = value.copyString();
-    length = TRI_CharLengthUtf8String(tmp.c_str());
-  } else if (value.isObject()) {
-    length = static_cast<size_t>(value.length());
+
+  double const days = static_cast<double>(DaysFromCivil(
+                          static_cast<int64_t>(y), static_cast<int64_t>(m) + 1,
+                          1)) +
+                      day - 1.0;
+  double const time = hour * static_cast<double>(MsPerHour) +
+                      minute * static_cast<double>(MsPerMinute) +
+                      second * static_cast<double>(MsPerSecond) + millisecond;
+  double const value = days * static_cast<double>(MsPerDay) + time;
+
+  if (!std::isfinite(value) || std::abs(value) > MaxDateValue) {
+    return false;
   }
-  builder->add(VPackValue(static_cast<double>(length)));
-  return AqlValue$(builder.get());
+
+  result = static_cast<int64_t>(value);
+  return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function FIRST
+/// @brief parse an unsigned number of at least minDigits and at most
+/// maxDigits digits
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::First(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(FirstVPack(query, trx, tmp));
-#else
-  if (parameters.size() < 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FIRST", (int)1,
-        (int)1);
+static bool ParseDateNumber(char const*& p, char const* end, int minDigits,
+                            int maxDigits, int64_t& result) {
+  int digits = 0;
+  result = 0;
+
+  while (p < end && *p >= '0' && *p <= '9' && digits < maxDigits) {
+    result = result * 10 + (*p - '0');
+    ++p;
+    ++digits;
   }
 
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
+  return (digits >= minDigits);
+}
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "FIRST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse a date string in ISO 8601 format
+///
+/// supported is [+-YY]YYYY[-MM[-DD]][(T| )HH:MM[:SS[.fff]]][Z|(+|-)HH[:MM]].
+/// month and day may have a single digit, and leading and trailing
+/// whitespace is ignored. dates without a timezone are in UTC
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ParseDateString(char const* p, size_t length, int64_t& result) {
+  char const* end = p + length;
+
+  auto skipWhitespace = [&p, &end]() {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) {
+      ++p;
+    }
+  };
+
+  skipWhitespace();
+
+  // year
+  int64_t year;
+  if (p < end && (*p == '+' || *p == '-')) {
+    bool const negative = (*p == '-');
+    ++p;
+    if (!ParseDateNumber(p, end, 6, 6, year)) {
+      return false;
+    }
+    if (negative) {
+      year = -year;
+    }
+  } else if (!ParseDateNumber(p, end, 4, 4, year)) {
+    return false;
   }
 
-  if (value.size() == 0) {
-    return AqlValue(new Json(Json::Null));
+  // month and day
+  int64_t month = 1;
+  int64_t day = 1;
+  if (p < end && *p == '-') {
+    ++p;
+    if (!ParseDateNumber(p, end, 1, 2, month)) {
+      return false;
+    }
+    if (p < end && *p == '-') {
+      ++p;
+      if (!ParseDateNumber(p, end, 1, 2, day)) {
+        return false;
+      }
+    }
   }
 
-  auto j = new Json(TRI_UNKNOWN_MEM_ZONE, value.at(0).copy().steal(),
-                    Json::AUTOFREE);
-  return AqlValue(j);
-#endif
-}
+  if (month < 1 || month > 12 || day < 1 || day > 31) {
+    return false;
+  }
 
-AqlValue$ Functions::FirstVPack(arangodb::aql::Query* query,
-                                arangodb::AqlTransaction* trx,
-                                VPackFunctionParameters const& parameters) {
-  if (parameters.size() < 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FIRST", (int)1,
-        (int)1);
+  // time
+  int64_t hour = 0;
+  int64_t minute = 0;
+  int64_t second = 0;
+  int64_t millisecond = 0;
+  int64_t offset = 0;
+  bool hasOffset = false;
+
+  if (p + 1 < end && (*p == 'T' || *p == 't' || *p == ' ') && p[1] >= '0' &&
+      p[1] <= '9') {
+    ++p;
+    if (!ParseDateNumber(p, end, 1, 2, hour) || p >= end || *p != ':') {
+      return false;
+    }
+    ++p;
+    if (!ParseDateNumber(p, end, 2, 2, minute)) {
+      return false;
+    }
+    if (p < end && *p == ':') {
+      ++p;
+      if (!ParseDateNumber(p, end, 2, 2, second)) {
+        return false;
+      }
+      if (p < end && *p == '.') {
+        ++p;
+        // only milliseconds are significant, further digits are ignored
+        int64_t factor = 100;
+        char const* start = p;
+        while (p < end && *p >= '0' && *p <= '9') {
+          millisecond += (*p - '0') * factor;
+          factor /= 10;
+          ++p;
+        }
+        if (p == start) {
+          return false;
+        }
+      }
+    }
+
+    if (hour > 23 || minute > 59 || second > 59) {
+      return false;
+    }
+
+    // timezone offset
+    if (p < end && (*p == '+' || *p == '-')) {
+      bool const negative = (*p == '-');
+      int64_t offsetHours;
+      int64_t offsetMinutes = 0;
+      ++p;
+      if (!ParseDateNumber(p, end, 2, 2, offsetHours)) {
+        return false;
+      }
+      if (p < end && *p == ':') {
+        ++p;
+      }
+      if (p < end && *p >= '0' && *p <= '9' &&
+          !ParseDateNumber(p, end, 2, 2, offsetMinutes)) {
+        return false;
+      }
+      if (offsetHours > 23 || offsetMinutes > 59) {
+        return false;
+      }
+      hasOffset = true;
+      offset = offsetHours * MsPerHour + offsetMinutes * MsPerMinute;
+      if (negative) {
+        offset = -offset;
+      }
+    }
   }
 
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
+  if (!hasOffset && p < end && (*p == 'Z' || *p == 'z')) {
+    ++p;
+  }
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "FIRST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    builder->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(builder.get());
+  skipWhitespace();
+
+  if (p != end) {
+    return false;
   }
 
-  if (value.length() == 0) {
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    builder->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(builder.get());
+  if (!ComposeDate(static_cast<double>(year), static_cast<double>(month - 1),
+                   static_cast<double>(day), static_cast<double>(hour),
+                   static_cast<double>(minute), static_cast<double>(second),
+                   static_cast<double>(millisecond), result)) {
+    return false;
   }
 
-  return AqlValue$(value.at(0));
+  result -= offset;
+  return (std::abs(static_cast<double>(result)) <= MaxDateValue);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function LAST
+/// @brief convert a single value into a date. numbers are taken as
+/// milliseconds since the Unix epoch, strings must be ISO 8601 dates
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Last(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(LastVPack(query, trx, tmp));
-#else
-  if (parameters.size() < 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LAST", (int)1,
-        (int)1);
+static bool ValueToDate(VPackSlice const& slice, int64_t& result) {
+  if (slice.isNumber()) {
+    double const value = slice.getNumericValue<double>();
+    if (!std::isfinite(value) || std::abs(value) > MaxDateValue) {
+      return false;
+    }
+    result = static_cast<int64_t>(std::trunc(value));
+    return true;
   }
 
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "LAST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+  if (slice.isString()) {
+    VPackValueLength length;
+    char const* p = slice.getString(length);
+    return ParseDateString(p, static_cast<size_t>(length), result);
   }
 
-  size_t const n = value.size();
+  return false;
+}
 
-  if (n == 0) {
-    return AqlValue(new Json(Json::Null));
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract a date from a function parameter. registers a warning if
+/// the parameter is not a valid date
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ExtractDateParameter(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 VPackFunctionParameters const& parameters,
+                                 size_t position, char const* functionName,
+                                 int64_t& result) {
+  VPackSlice const value = ExtractFunctionParameter(trx, parameters, position);
+
+  if (!ValueToDate(value, result)) {
+    RegisterWarning(query, functionName, TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+    return false;
   }
 
-  auto j = new Json(TRI_UNKNOWN_MEM_ZONE, value.at(n - 1).copy().steal(),
-                    Json::AUTOFREE);
-  return AqlValue(j);
-#endif
+  return true;
 }
 
-AqlValue$ Functions::LastVPack(arangodb::aql::Query* query,
-                               arangodb::AqlTransaction* trx,
-                               VPackFunctionParameters const& parameters) {
-  if (parameters.size() < 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LAST", (int)1,
-        (int)1);
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build a date from either a single value or from its components
+/// (year, month, day[, hour[, minute[, second[, millisecond]]]]). registers a
+/// warning if no valid date can be built
+////////////////////////////////////////////////////////////////////////////////
 
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
+static bool MakeDate(arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+                     VPackFunctionParameters const& parameters,
+                     char const* functionName, int64_t& result) {
+  size_t const n = parameters.size();
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "LAST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    builder->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(builder.get());
+  if (n == 1) {
+    return ExtractDateParameter(query, trx, parameters, 0, functionName,
+                                result);
+  }
+
+  // the default values for day, hour, minute, second and millisecond
+  double components[] = {0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0};
+  bool valid = (n >= 3 && n <= 7);
+
+  for (size_t i = 0; valid && i < n; ++i) {
+    VPackSlice const value = ExtractFunctionParameter(trx, parameters, i);
+    double number = 0.0;
+
+    if (value.isNumber()) {
+      number = value.getNumericValue<double>();
+    } else if (value.isString()) {
+      // like parseInt()
+      std::string const str = value.copyString();
+      char* endptr = nullptr;
+      number = std::strtod(str.c_str(), &endptr);
+      char const* p = str.c_str();
+      while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+        ++p;
+      }
+      if (*p == '+' || *p == '-') {
+        ++p;
+      }
+      if (*p < '0' || *p > '9') {
+        valid = false;
+      }
+      number = std::trunc(number);
+    } else if (!value.isNull()) {
+      valid = false;
+    }
+
+    if (number < 0.0) {
+      valid = false;
+    }
+
+    components[i] = number;
   }
 
-  VPackValueLength const n = value.length();
+  if (valid) {
+    // months are 1-based in AQL
+    components[1] -= 1.0;
+    // two-digit years are in the 20th century, as with Date.UTC()
+    double const year = std::trunc(components[0]);
+    if (year >= 0.0 && year <= 99.0) {
+      components[0] = 1900.0 + year;
+    }
 
-  if (n == 0) {
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    builder->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(builder.get());
+    valid = ComposeDate(components[0], components[1], components[2],
+                        components[3], components[4], components[5],
+                        components[6], result);
   }
-  return AqlValue$(value.at(n-1));
+
+  if (!valid) {
+    RegisterWarning(query, functionName, TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+  }
+
+  return valid;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function NTH
+/// @brief ISO 8601 string representation of a date, as created by
+/// JavaScript's toISOString()
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Nth(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(NthVPack(query, trx, tmp));
-#else
-  if (parameters.size() < 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LAST", (int)2,
-        (int)2);
-  }
-
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
+static std::string DateToString(int64_t value) {
+  DateComponents date;
+  SplitDate(value, date);
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "NTH", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+  char buffer[32];
+  if (date.year >= 0 && date.year <= 9999) {
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+             static_cast<int>(date.year), static_cast<int>(date.month + 1),
+             static_cast<int>(date.day), static_cast<int>(date.hour),
+             static_cast<int>(date.minute), static_cast<int>(date.second),
+             static_cast<int>(date.millisecond));
+  } else {
+    snprintf(buffer, sizeof(buffer), "%+07d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+             static_cast<int>(date.year), static_cast<int>(date.month + 1),
+             static_cast<int>(date.day), static_cast<int>(date.hour),
+             static_cast<int>(date.minute), static_cast<int>(date.second),
+             static_cast<int>(date.millisecond));
   }
 
-  size_t const n = value.size();
+  return std::string(buffer);
+}
 
-  if (n == 0) {
-    return AqlValue(new Json(Json::Null));
+////////////////////////////////////////////////////////////////////////////////
+/// @brief day of the year of a date (1..366)
+////////////////////////////////////////////////////////////////////////////////
+
+static int64_t DayOfYear(DateComponents const& date) {
+  int64_t result = DayOfYearOffsets[date.month] + date.day;
+  if (date.month > 1 && IsLeapYear(date.year)) {
+    ++result;
   }
+  return result;
+}
 
-  Json indexJson = ExtractFunctionParameter(trx, parameters, 1, false);
-  bool isValid = true;
-  double numValue = ValueToNumber(indexJson.json(), isValid);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ISO week of a date (1..53)
+////////////////////////////////////////////////////////////////////////////////
 
-  if (!isValid || numValue < 0.0) {
-    return AqlValue(new Json(Json::Null));
-  }
+static int64_t IsoWeek(int64_t value) {
+  int64_t days = FloorDiv(value, MsPerDay);
+  int64_t const weekday = ((days + 4) % 7 + 7) % 7;
 
-  size_t index = static_cast<size_t>(numValue);
+  // the Thursday of the same week determines the year
+  days += 4 - (weekday == 0 ? 7 : weekday);
 
-  if (index >= n) {
-    return AqlValue(new Json(Json::Null));
-  }
+  int64_t year, month, day;
+  CivilFromDays(days, year, month, day);
 
-  auto j = new Json(TRI_UNKNOWN_MEM_ZONE, value.at(index).copy().steal(),
-                    Json::AUTOFREE);
-  return AqlValue(j);
-#endif
+  return (days - DaysFromCivil(year, 1, 1)) / 7 + 1;
 }
 
-AqlValue$ Functions::NthVPack(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              VPackFunctionParameters const& parameters) {
-  if (parameters.size() < 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LAST", (int)2,
-        (int)2);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of days in the month of a date
+////////////////////////////////////////////////////////////////////////////////
+
+static int64_t DaysInMonthOf(DateComponents const& date) {
+  if (date.month == 1 && IsLeapYear(date.year)) {
+    return 29;
   }
+  return DaysInMonth[date.month];
+}
 
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief date units, as used by DATE_ADD, DATE_SUBTRACT and DATE_DIFF
+////////////////////////////////////////////////////////////////////////////////
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "NTH", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    builder->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(builder.get());
-  }
+enum class DateUnit {
+  INVALID,
+  YEAR,
+  MONTH,
+  WEEK,
+  DAY,
+  HOUR,
+  MINUTE,
+  SECOND,
+  MILLISECOND
+};
 
-  VPackValueLength const n = value.length();
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a date unit by name (case-insensitive)
+////////////////////////////////////////////////////////////////////////////////
 
-  if (n == 0) {
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    builder->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(builder.get());
+static DateUnit LookupDateUnit(std::string unit) {
+  std::transform(unit.begin(), unit.end(), unit.begin(), ::tolower);
+
+  if (unit == "y" || unit == "year" || unit == "years") {
+    return DateUnit::YEAR;
+  }
+  if (unit == "m" || unit == "month" || unit == "months") {
+    return DateUnit::MONTH;
+  }
+  if (unit == "w" || unit == "week" || unit == "weeks") {
+    return DateUnit::WEEK;
+  }
+  if (unit == "d" || unit == "day" || unit == "days") {
+    return DateUnit::DAY;
+  }
+  if (unit == "h" || unit == "hour" || unit == "hours") {
+    return DateUnit::HOUR;
+  }
+  if (unit == "i" || unit == "minute" || unit == "minutes") {
+    return DateUnit::MINUTE;
   }
+  if (unit == "s" || unit == "second" || unit == "seconds") {
+    return DateUnit::SECOND;
+  }
+  if (unit == "f" || unit == "ms" || unit == "millisecond" ||
+      unit == "milliseconds") {
+    return DateUnit::MILLISECOND;
+  }
+  return DateUnit::INVALID;
+}
 
-  VPackSlice indexSlice = ExtractFunctionParameter(trx, parameters, 1);
-  bool isValid = true;
-  double numValue = ValueToNumber(indexSlice, isValid);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add an amount of a unit to a date. the component of the unit is
+/// modified and the date is rebuilt, so that e.g. adding a month to the
+/// 31st of January overflows into March, as in JavaScript
+////////////////////////////////////////////////////////////////////////////////
 
-  if (!isValid || numValue < 0.0) {
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    builder->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(builder.get());
-  }
+static bool AddToDate(int64_t& value, DateUnit unit, double amount) {
+  DateComponents date;
+  SplitDate(value, date);
 
-  size_t index = static_cast<size_t>(numValue);
+  double components[] = {static_cast<double>(date.year),
+                         static_cast<double>(date.month),
+                         static_cast<double>(date.day),
+                         static_cast<double>(date.hour),
+                         static_cast<double>(date.minute),
+                         static_cast<double>(date.second),
+                         static_cast<double>(date.millisecond)};
 
-  if (index >= n) {
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    builder->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(builder.get());
+  switch (unit) {
+    case DateUnit::YEAR:
+      components[0] += amount;
+      break;
+    case DateUnit::MONTH:
+      components[1] += amount;
+      break;
+    case DateUnit::WEEK:
+      components[2] += amount * 7.0;
+      break;
+    case DateUnit::DAY:
+      components[2] += amount;
+      break;
+    case DateUnit::HOUR:
+      components[3] += amount;
+      break;
+    case DateUnit::MINUTE:
+      components[4] += amount;
+      break;
+    case DateUnit::SECOND:
+      components[5] += amount;
+      break;
+    case DateUnit::MILLISECOND:
+      components[6] += amount;
+      break;
+    case DateUnit::INVALID:
+      return false;
   }
-  return AqlValue$(value.at(index));
+
+  return ComposeDate(components[0], components[1], components[2],
+                     components[3], components[4], components[5],
+                     components[6], value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function CONCAT
+/// @brief parse an ISO 8601 duration (e.g. P1Y2M3W4DT5H6M7.890S) into its
+/// amounts, in the order year, month, week, day, hour, minute, second,
+/// millisecond. lower-case durations are accepted, too
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Concat(arangodb::aql::Query* query,
-                           arangodb::AqlTransaction* trx,
-                           FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(ConcatVPack(query, trx, tmp));
-#else
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+static bool ParseDuration(std::string const& value, double* amounts) {
+  char const* p = value.c_str();
+  char const* end = p + value.size();
 
-  size_t const n = parameters.size();
+  for (size_t i = 0; i < 8; ++i) {
+    amounts[i] = 0.0;
+  }
 
-  for (size_t i = 0; i < n; ++i) {
-    auto const member = ExtractFunctionParameter(trx, parameters, i, false);
+  if (p == end || (*p != 'P' && *p != 'p')) {
+    return false;
+  }
+  ++p;
 
-    if (member.isEmpty() || member.isNull()) {
-      continue;
+  auto parseNumber = [&p, &end](double& result) -> bool {
+    char const* start = p;
+    result = 0.0;
+    while (p < end && *p >= '0' && *p <= '9') {
+      result = result * 10.0 + (*p - '0');
+      ++p;
     }
+    return (p != start);
+  };
 
-    TRI_json_t const* json = member.json();
-
-    if (member.isArray()) {
-      // append each member individually
-      size_t const subLength = TRI_LengthArrayJson(json);
+  // designators of the date part and the time part, in the order in which
+  // they must appear, and the index of the amount they set
+  static char const dateDesignators[] = {'Y', 'M', 'W', 'D'};
+  static char const timeDesignators[] = {'H', 'M', 'S'};
 
-      for (size_t j = 0; j < subLength; ++j) {
-        auto sub = static_cast<TRI_json_t const*>(
-            TRI_AtVector(&json->_value._objects, j));
+  size_t next = 0;
+  while (p < end && *p != 'T' && *p != 't') {
+    double number;
+    if (!parseNumber(number) || p == end) {
+      return false;
+    }
+    char const designator = static_cast<char>(::toupper(*p));
+    while (next < 4 && dateDesignators[next] != designator) {
+      ++next;
+    }
+    if (next == 4) {
+      return false;
+    }
+    amounts[next++] = number;
+    ++p;
+  }
 
-        if (sub == nullptr || sub->_type == TRI_JSON_NULL) {
-          continue;
+  if (p < end) {
+    // time part
+    ++p;
+    next = 0;
+    while (p < end) {
+      double number;
+      if (!parseNumber(number) || p == end) {
+        return false;
+      }
+      if (*p == '.') {
+        // fractional seconds. only milliseconds are significant
+        ++p;
+        double millisecond = 0.0;
+        double factor = 100.0;
+        char const* start = p;
+        while (p < end && *p >= '0' && *p <= '9') {
+          millisecond += (*p - '0') * factor;
+          factor /= 10.0;
+          ++p;
         }
-
-        AppendAsString(buffer, sub);
+        if (p == start || p == end || (*p != 'S' && *p != 's') || next > 2) {
+          return false;
+        }
+        amounts[7] = std::floor(millisecond);
       }
-    } else {
-      // convert member to a string and append
-      AppendAsString(buffer, json);
+      char const designator = static_cast<char>(::toupper(*p));
+      while (next < 3 && timeDesignators[next] != designator) {
+        ++next;
+      }
+      if (next == 3) {
+        return false;
+      }
+      amounts[4 + next++] = number;
+      ++p;
     }
   }
 
-  // steal the StringBuffer's char* pointer so we can avoid copying data around
-  // multiple times
-  size_t length = buffer.length();
-  std::unique_ptr<TRI_json_t> j(
-      TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length));
-
-  if (j == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
-
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
-  j.release();
-  return AqlValue(jr);
-#endif
+  return true;
 }
 
-AqlValue$ Functions::ConcatVPack(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 VPackFunctionParameters const& parameters) {
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
-  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shared implementation of DATE_ADD and DATE_SUBTRACT
+////////////////////////////////////////////////////////////////////////////////
 
-  size_t const n = parameters.size();
+static AqlValue$ DateCalc(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          VPackFunctionParameters const& parameters,
+                          char const* functionName, double sign) {
+  int64_t date;
+  if (!ExtractDateParameter(query, trx, parameters, 0, functionName, date)) {
+    return NullValue(query);
+  }
 
-  for (size_t i = 0; i < n; ++i) {
-    auto const member = ExtractFunctionParameter(trx, parameters, i);
+  VPackSlice const amount = ExtractFunctionParameter(trx, parameters, 1);
+  VPackSlice const unit = ExtractFunctionParameter(trx, parameters, 2);
 
-    if (member.isNone() || member.isNull()) {
-      continue;
+  if (unit.isNone() || unit.isNull()) {
+    // amount must be an ISO 8601 duration
+    if (!amount.isString()) {
+      RegisterInvalidArgumentWarning(query, functionName);
+      return NullValue(query);
     }
 
-    if (member.isArray()) {
-      // append each member individually
-      for (auto const& sub : VPackArrayIterator(member)) {
-        if (sub.isNone() || sub.isNull()) {
-          continue;
-        }
+    double amounts[8];
+    if (!ParseDuration(amount.copyString(), amounts)) {
+      RegisterWarning(query, functionName, TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+      return NullValue(query);
+    }
 
-        AppendAsString(adapter, sub);
+    // components are applied from the smallest to the largest unit
+    static DateUnit const units[] = {
+        DateUnit::YEAR, DateUnit::MONTH,  DateUnit::WEEK,   DateUnit::DAY,
+        DateUnit::HOUR, DateUnit::MINUTE, DateUnit::SECOND, DateUnit::MILLISECOND};
+
+    for (size_t i = 8; i > 0; --i) {
+      if (!AddToDate(date, units[i - 1], amounts[i - 1] * sign)) {
+        RegisterWarning(query, functionName,
+                        TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+        return NullValue(query);
       }
-    } else {
-      // convert member to a string and append
-      AppendAsString(adapter, member);
     }
-  }
+  } else {
+    if (!unit.isString() || !amount.isNumber()) {
+      RegisterInvalidArgumentWarning(query, functionName);
+      return NullValue(query);
+    }
 
-  // steal the StringBuffer's char* pointer so we can avoid copying data around
-  // multiple times
-  size_t length = buffer.length();
-  try {
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    std::string res(buffer.steal(), length);
-    builder->add(VPackValue(std::move(res)));
-    return AqlValue$(builder.get());
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    DateUnit const u = LookupDateUnit(unit.copyString());
+
+    if (u == DateUnit::INVALID ||
+        !AddToDate(date, u, amount.getNumericValue<double>() * sign)) {
+      RegisterWarning(query, functionName, TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+      return NullValue(query);
+    }
   }
+
+  return StringValue(query, DateToString(date));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function LIKE
+/// @brief called before a query starts
+/// has the chance to set up any thread-local storage
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Like(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(LikeVPack(query, trx, tmp));
-#else
-  if (parameters.size() < 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LIKE", (int)2,
-        (int)3);
-  }
-
-  bool const caseInsensitive = GetBooleanParameter(trx, parameters, 2, false);
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
-
-  // build pattern from parameter #1
-  auto const regex = ExtractFunctionParameter(trx, parameters, 1, false);
-  AppendAsString(buffer, regex.json());
-  size_t const length = buffer.length();
-
-  std::string const pattern =
-      BuildRegexPattern(buffer.c_str(), length, caseInsensitive);
-  RegexMatcher* matcher = nullptr;
-
-  if (RegexCache != nullptr) {
-    auto it = RegexCache->find(pattern);
-
-    // check regex cache
-    if (it != RegexCache->end()) {
-      matcher = (*it).second;
-    }
-  }
+void Functions::InitializeThreadContext() {}
 
-  if (matcher == nullptr) {
-    matcher =
-        arangodb::basics::Utf8Helper::DefaultUtf8Helper.buildMatcher(pattern);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief called when a query ends
+/// its responsibility is to clear any thread-local storage
+////////////////////////////////////////////////////////////////////////////////
 
-    try {
-      if (RegexCache == nullptr) {
-        RegexCache = new std::unordered_map<std::string, RegexMatcher*>();
-      }
-      // insert into cache, no matter if pattern is valid or not
-      RegexCache->emplace(pattern, matcher);
-    } catch (...) {
-      delete matcher;
-      ClearRegexCache();
-      throw;
-    }
-  }
+void Functions::DestroyThreadContext() { ClearRegexCache(); }
 
-  if (matcher == nullptr) {
-    // compiling regular expression failed
-    RegisterWarning(query, "LIKE", TRI_ERROR_QUERY_INVALID_REGEX);
-    return AqlValue(new Json(Json::Null));
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_NULL
+////////////////////////////////////////////////////////////////////////////////
 
-  // extract value
-  buffer.clear();
+AqlValue Functions::IsNull(arangodb::aql::Query* q, arangodb::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(IsNullVPack(q, trx, tmp));
+#else
   auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
-  AppendAsString(buffer, value.json());
-
-  bool error = false;
-  bool const result = arangodb::basics::Utf8Helper::DefaultUtf8Helper.matches(
-      matcher, buffer.c_str(), buffer.length(), error);
-
-  if (error) {
-    // compiling regular expression failed
-    RegisterWarning(query, "LIKE", TRI_ERROR_QUERY_INVALID_REGEX);
-    return AqlValue(new Json(Json::Null));
-  }
-
-  return AqlValue(new Json(result));
+  return AqlValue(new Json(value.isNull()));
 #endif
 }
 
-AqlValue$ Functions::LikeVPack(arangodb::aql::Query* query,
-                               arangodb::AqlTransaction* trx,
-                               VPackFunctionParameters const& parameters) {
-  if (parameters.size() < 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LIKE", (int)2,
-        (int)3);
-  }
-
-  bool const caseInsensitive = GetBooleanParameter(trx, parameters, 2, false);
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
-  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
-
-  // build pattern from parameter #1
-  auto const regex = ExtractFunctionParameter(trx, parameters, 1);
-  AppendAsString(adapter, regex);
-
-  size_t const length = buffer.length();
-
-  std::string const pattern =
-      BuildRegexPattern(buffer.c_str(), length, caseInsensitive);
-  RegexMatcher* matcher = nullptr;
-
-  if (RegexCache != nullptr) {
-    auto it = RegexCache->find(pattern);
-
-    // check regex cache
-    if (it != RegexCache->end()) {
-      matcher = (*it).second;
-    }
-  }
+AqlValue$ Functions::IsNullVPack(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 VPackFunctionParameters const& parameters) {
+  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(slice.isNull()));
+  return AqlValue$(b.get());
+}
 
-  if (matcher == nullptr) {
-    matcher =
-        arangodb::basics::Utf8Helper::DefaultUtf8Helper.buildMatcher(pattern);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_BOOL
+////////////////////////////////////////////////////////////////////////////////
 
-    try {
-      if (RegexCache == nullptr) {
-        RegexCache = new std::unordered_map<std::string, RegexMatcher*>();
-      }
-      // insert into cache, no matter if pattern is valid or not
-      RegexCache->emplace(pattern, matcher);
-    } catch (...) {
-      delete matcher;
-      ClearRegexCache();
-      throw;
-    }
-  }
+AqlValue Functions::IsBool(arangodb::aql::Query* q, arangodb::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(IsBoolVPack(q, trx, tmp));
+#else
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+  return AqlValue(new Json(value.isBoolean()));
+#endif
+}
 
-  if (matcher == nullptr) {
-    // compiling regular expression failed
-    RegisterWarning(query, "LIKE", TRI_ERROR_QUERY_INVALID_REGEX);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+AqlValue$ Functions::IsBoolVPack(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 VPackFunctionParameters const& parameters) {
+  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(slice.isBool()));
+  return AqlValue$(b.get());
+}
 
-  // extract value
-  buffer.clear();
-  auto const value = ExtractFunctionParameter(trx, parameters, 0);
-  AppendAsString(adapter, value);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_NUMBER
+////////////////////////////////////////////////////////////////////////////////
 
-  bool error = false;
-  bool const result = arangodb::basics::Utf8Helper::DefaultUtf8Helper.matches(
-      matcher, buffer.c_str(), buffer.length(), error);
+AqlValue Functions::IsNumber(arangodb::aql::Query* q,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(IsNumberVPack(q, trx, tmp));
+#else
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+  return AqlValue(new Json(value.isNumber()));
+#endif
+}
 
+AqlValue$ Functions::IsNumberVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
+  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (error) {
-    // compiling regular expression failed
-    RegisterWarning(query, "LIKE", TRI_ERROR_QUERY_INVALID_REGEX);
-    b->add(VPackValue(VPackValueType::Null));
-  } else {
-    b->add(VPackValue(result));
-  }
+  b->add(VPackValue(slice.isNumber()));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function PASSTHRU
+/// @brief function IS_STRING
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Passthru(arangodb::aql::Query* query,
+AqlValue Functions::IsString(arangodb::aql::Query* q,
                              arangodb::AqlTransaction* trx,
                              FunctionParameters const& parameters) {
+
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(PassthruVPack(query, trx, tmp));
+  return AqlValue(IsStringVPack(q, trx, tmp));
 #else
-  if (parameters.empty()) {
-    return AqlValue(new Json(Json::Null));
-  }
-
-  auto json = ExtractFunctionParameter(trx, parameters, 0, true);
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, json.steal()));
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+  return AqlValue(new Json(value.isString()));
 #endif
 }
 
-AqlValue$ Functions::PassthruVPack(arangodb::aql::Query* query,
+AqlValue$ Functions::IsStringVPack(arangodb::aql::Query* query,
                                    arangodb::AqlTransaction* trx,
                                    VPackFunctionParameters const& parameters) {
-  if (parameters.empty()) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
-
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
-  return AqlValue$(value);
+  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(slice.isString()));
+  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function UNSET
+/// @brief function IS_ARRAY
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Unset(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          FunctionParameters const& parameters) {
+AqlValue Functions::IsArray(arangodb::aql::Query* q,
+                            arangodb::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(UnsetVPack(query, trx, tmp));
+  return AqlValue(IsArrayVPack(q, trx, tmp));
 #else
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  if (!value.isObject()) {
-    RegisterInvalidArgumentWarning(query, "UNSET");
-    return AqlValue(new Json(Json::Null));
-  }
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+  return AqlValue(new Json(value.isArray()));
+#endif
+}
 
-  std::unordered_set<std::string> names;
-  ExtractKeys(names, query, trx, parameters, 1, "UNSET");
+AqlValue$ Functions::IsArrayVPack(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  VPackFunctionParameters const& parameters) {
+  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(slice.isArray()));
+  return AqlValue$(b.get());
+}
 
-  // create result object
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthVector(&valueJson->_value._objects);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_OBJECT
+////////////////////////////////////////////////////////////////////////////////
 
-  size_t size;
-  if (names.size() >= n / 2) {
-    size = 4;
-  } else {
-    size = (n / 2) - names.size();
-  }
+AqlValue Functions::IsObject(arangodb::aql::Query* q,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(IsObjectVPack(q, trx, tmp));
+#else
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+  return AqlValue(new Json(value.isObject()));
+#endif
+}
 
-  std::unique_ptr<TRI_json_t> j(
-      TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, size));
+AqlValue$ Functions::IsObjectVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
+  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(slice.isObject()));
+  return AqlValue$(b.get());
+}
 
-  if (j == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TO_NUMBER
+////////////////////////////////////////////////////////////////////////////////
 
-  for (size_t i = 0; i < n; i += 2) {
-    auto key = static_cast<TRI_json_t const*>(
-        TRI_AtVector(&valueJson->_value._objects, i));
-    auto value = static_cast<TRI_json_t const*>(
-        TRI_AtVector(&valueJson->_value._objects, i + 1));
+AqlValue Functions::ToNumber(arangodb::aql::Query* q,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(ToNumberVPack(q, trx, tmp));
+#else
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-    if (TRI_IsStringJson(key) &&
-        names.find(key->_value._string.data) == names.end()) {
-      auto copy = SafeCopyJson(value);
+  bool isValid;
+  double v = ValueToNumber(value.json(), isValid);
 
-      TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, j.get(),
-                            key->_value._string.data, copy);
-    }
+  if (!isValid) {
+    return AqlValue(new Json(Json::Null));
   }
-
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
-  j.release();
-  return AqlValue(jr);
+  return AqlValue(new Json(v));
 #endif
 }
 
-AqlValue$ Functions::UnsetVPack(arangodb::aql::Query* query,
-                                arangodb::AqlTransaction* trx,
-                                VPackFunctionParameters const& parameters) {
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
+AqlValue$ Functions::ToNumberVPack(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  VPackFunctionParameters const& parameters) {
+  auto const slice = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (!value.isObject()) {
-    RegisterInvalidArgumentWarning(query, "UNSET");
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+  bool isValid;
+  double v = ValueToNumber(slice, isValid);
 
-  std::unordered_set<std::string> names;
-  ExtractKeys(names, query, trx, parameters, 1, "UNSET");
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
 
-  try {
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    UnsetOrKeep(value, names, true, false, *builder);
-    return AqlValue$(builder.get());
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  if (!isValid) {
+    b->add(VPackValue(VPackValueType::Null));
+  } else {
+    b->add(VPackValue(v));
   }
+  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function UNSET_RECURSIVE
+/// @brief function TO_STRING
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::UnsetRecursive(arangodb::aql::Query* query,
-                                   arangodb::AqlTransaction* trx,
-                                   FunctionParameters const& parameters) {
+AqlValue Functions::ToString(arangodb::aql::Query* q,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(UnsetRecursiveVPack(query, trx, tmp));
+  return AqlValue(ToStringVPack(q, trx, tmp));
 #else
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  if (!value.isObject()) {
-    RegisterInvalidArgumentWarning(query, "UNSET_RECURSIVE");
-    return AqlValue(new Json(Json::Null));
-  }
-
-  std::unordered_set<std::string> names;
-  ExtractKeys(names, query, trx, parameters, 1, "UNSET_RECURSIVE");
-
-  std::function<TRI_json_t*(TRI_json_t const*,
-                            std::unordered_set<std::string> const&)> func;
-
-  func = [&func](TRI_json_t const* value,
-                 std::unordered_set<std::string> const& names) -> TRI_json_t* {
-    TRI_ASSERT(TRI_IsObjectJson(value));
-
-    size_t const n = TRI_LengthVector(&value->_value._objects);
-    size_t size;
-    if (names.size() >= n / 2) {
-      size = 4;
-    } else {
-      size = (n / 2) - names.size();
-    }
-
-    std::unique_ptr<TRI_json_t> j(
-        TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, size));
-
-    if (j == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
-
-    for (size_t i = 0; i < n; i += 2) {
-      auto k = static_cast<TRI_json_t const*>(
-          TRI_AtVector(&value->_value._objects, i));
-      auto v = static_cast<TRI_json_t const*>(
-          TRI_AtVector(&value->_value._objects, i + 1));
-
-      if (TRI_IsStringJson(k) &&
-          names.find(k->_value._string.data) == names.end()) {
-        TRI_json_t* copy = nullptr;
-
-        if (TRI_IsObjectJson(v)) {
-          copy = func(v, names);
-        } else {
-          copy = SafeCopyJson(v);
-        }
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-        if (copy == nullptr) {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-        }
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
 
-        TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, j.get(),
-                              k->_value._string.data, copy);
-      }
-    }
+  AppendAsString(buffer, value.json());
+  size_t length = buffer.length();
+  std::unique_ptr<TRI_json_t> j(
+      TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length));
 
-    return j.release();
-  };
+  if (j == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
 
-  TRI_json_t* result = func(value.json(), names);
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result);
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
   return AqlValue(jr);
 #endif
 }
 
-AqlValue$ Functions::UnsetRecursiveVPack(
-    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
-    VPackFunctionParameters const& parameters) {
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
-
-  if (!value.isObject()) {
-    RegisterInvalidArgumentWarning(query, "UNSET_RECURSIVE");
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+AqlValue$ Functions::ToStringVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0);
 
-  std::unordered_set<std::string> names;
-  ExtractKeys(names, query, trx, parameters, 1, "UNSET_RECURSIVE");
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
 
+  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+  AppendAsString(adapter, value);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
   try {
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    UnsetOrKeep(value, names, true, true, *builder);
-    return AqlValue$(builder.get());
+    std::string res(buffer.begin(), buffer.length());
+    b->add(VPackValue(res));
   } catch (...) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
+  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function KEEP
+/// @brief function TO_BOOL
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Keep(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         FunctionParameters const& parameters) {
+AqlValue Functions::ToBool(arangodb::aql::Query* q, arangodb::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(KeepVPack(query, trx, tmp));
+  return AqlValue(ToBoolVPack(q, trx, tmp));
 #else
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  if (!value.isObject()) {
-    RegisterInvalidArgumentWarning(query, "KEEP");
-    return AqlValue(new Json(Json::Null));
-  }
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  std::unordered_set<std::string> names;
-  ExtractKeys(names, query, trx, parameters, 1, "KEEP");
+  return AqlValue(new Json(ValueToBoolean(value.json())));
+#endif
+}
 
-  // create result object
-  std::unique_ptr<TRI_json_t> j(
-      TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, names.size()));
+AqlValue$ Functions::ToBoolVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(ValueToBoolean(value)));
+  return AqlValue$(b.get());
+}
 
-  if (j == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
-
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthVector(&valueJson->_value._objects);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TO_ARRAY
+////////////////////////////////////////////////////////////////////////////////
 
-  for (size_t i = 0; i < n; i += 2) {
-    auto key = static_cast<TRI_json_t const*>(
-        TRI_AtVector(&valueJson->_value._objects, i));
-    auto value = static_cast<TRI_json_t const*>(
-        TRI_AtVector(&valueJson->_value._objects, i + 1));
+AqlValue Functions::ToArray(arangodb::aql::Query* q,
+                            arangodb::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(ToArrayVPack(q, trx, tmp));
+#else
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-    if (TRI_IsStringJson(key) &&
-        names.find(key->_value._string.data) != names.end()) {
-      auto copy = SafeCopyJson(value);
+  if (value.isBoolean() || value.isNumber() || value.isString()) {
+    // return array with single member
+    Json array(Json::Array, 1);
+    array.add(SafeCopyJson(value.json()));
 
-      if (copy == nullptr) {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-      }
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+  }
+  if (value.isArray()) {
+    // return copy of the original array
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, SafeCopyJson(value.json())));
+  }
+  if (value.isObject()) {
+    // return an array with the attribute values
+    auto const source = value.json();
+    size_t const n = TRI_LengthVector(&source->_value._objects);
 
-      TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, j.get(),
-                            key->_value._string.data, copy);
+    Json array(Json::Array, n);
+    for (size_t i = 1; i < n; i += 2) {
+      auto v = static_cast<TRI_json_t const*>(
+          TRI_AtVector(&source->_value._objects, i));
+      array.add(SafeCopyJson(v));
     }
+
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
   }
 
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
-  j.release();
-  return AqlValue(jr);
+  // return empty array
+  return AqlValue(new Json(Json::Array));
 #endif
 }
 
-AqlValue$ Functions::KeepVPack(
-    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
-    VPackFunctionParameters const& parameters) {
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
+AqlValue$ Functions::ToArrayVPack(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  VPackFunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (!value.isObject()) {
-    RegisterInvalidArgumentWarning(query, "KEEP");
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  if (value.isArray()) {
+    // return copy of the original array
+    return AqlValue$(value);
   }
 
-  std::unordered_set<std::string> names;
-  ExtractKeys(names, query, trx, parameters, 1, "KEEP");
-
-  try {
-    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
-    UnsetOrKeep(value, names, false, false, *builder);
-    return AqlValue$(builder.get());
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  std::shared_ptr<VPackBuilder> result = query->getSharedBuilder();
+  {
+    VPackArrayBuilder b(result.get());
+    if (value.isBoolean() || value.isNumber() || value.isString()) {
+      // return array with single member
+      result->add(value);
+    } else if (value.isObject()) {
+      // return an array with the attribute values
+      for (auto const& it : VPackObjectIterator(value)) {
+        result->add(it.value);
+      }
+    }
+    // else return empty array
   }
+  return AqlValue$(result.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function MERGE
+/// @brief function LENGTH
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Merge(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          FunctionParameters const& parameters) {
+AqlValue Functions::Length(arangodb::aql::Query* q, arangodb::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(MergeVPack(query, trx, tmp));
+  return AqlValue(LengthVPack(q, trx, tmp));
 #else
-  size_t const n = parameters.size();
-
-  if (n == 0) {
-    // no parameters
-    return AqlValue(new Json(Json::Object));
+  if (!parameters.empty() && parameters[0].first.isArray()) {
+    // shortcut!
+    return AqlValue(
+        new Json(static_cast<double>(parameters[0].first.arraySize())));
   }
 
-  // use the first argument as the preliminary result
-  auto initial = ExtractFunctionParameter(trx, parameters, 0, true);
-
-  if (initial.isArray() && n == 1) {
-    // special case: a single array parameter
-    std::unique_ptr<TRI_json_t> array(initial.steal());
-    std::unique_ptr<TRI_json_t> result(
-        TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE));
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-    if (result == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
+  TRI_json_t const* json = value.json();
+  size_t length = 0;
 
-    // now merge in all other arguments
-    size_t const k = TRI_LengthArrayJson(array.get());
+  if (json != nullptr) {
+    switch (json->_type) {
+      case TRI_JSON_UNUSED:
+      case TRI_JSON_NULL: {
+        length = 0;
+        break;
+      }
 
-    for (size_t i = 0; i < k; ++i) {
-      auto v =
-          static_cast<TRI_json_t const*>(TRI_LookupArrayJson(array.get(), i));
+      case TRI_JSON_BOOLEAN: {
+        length = (json->_value._boolean ? 1 : 0);
+        break;
+      }
 
-      if (!TRI_IsObjectJson(v)) {
-        RegisterInvalidArgumentWarning(query, "MERGE");
-        return AqlValue(new Json(Json::Null));
+      case TRI_JSON_NUMBER: {
+        if (std::isnan(json->_value._number) ||
+            !std::isfinite(json->_value._number)) {
+          // invalid value
+          length = strlen("null");
+        } else {
+          // convert to a string representation of the number
+          char buffer[24];
+          length =
+              static_cast<size_t>(fpconv_dtoa(json->_value._number, buffer));
+        }
+        break;
       }
 
-      auto merged =
-          TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(), v, false, false);
+      case TRI_JSON_STRING:
+      case TRI_JSON_STRING_REFERENCE: {
+        // return number of characters (not bytes) in string
+        length = TRI_CharLengthUtf8String(json->_value._string.data);
+        break;
+      }
 
-      if (merged == nullptr) {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      case TRI_JSON_OBJECT: {
+        // return number of attributes
+        length = TRI_LengthVector(&json->_value._objects) / 2;
+        break;
       }
 
-      result.reset(merged);
+      case TRI_JSON_ARRAY: {
+        // return list length
+        length = TRI_LengthArrayJson(json);
+        break;
+      }
     }
-
-    auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-    result.release();
-    return AqlValue(jr);
-  }
-
-  if (!initial.isObject()) {
-    RegisterInvalidArgumentWarning(query, "MERGE");
-    return AqlValue(new Json(Json::Null));
   }
 
-  std::unique_ptr<TRI_json_t> result(initial.steal());
-
-  // now merge in all other arguments
-  for (size_t i = 1; i < n; ++i) {
-    auto param = ExtractFunctionParameter(trx, parameters, i, false);
+  return AqlValue(new Json(static_cast<double>(length)));
+#endif
+}
 
-    if (!param.isObject()) {
-      RegisterInvalidArgumentWarning(query, "MERGE");
-      return AqlValue(new Json(Json::Null));
+AqlValue$ Functions::LengthVPack(arangodb::aql::Query* q,
+                                 arangodb::AqlTransaction* trx,
+                                 VPackFunctionParameters const& parameters) {
+  auto const value = ExtractFunctionParameter(trx, parameters, 0);
+  std::shared_ptr<VPackBuilder> builder = q->getSharedBuilder();
+  if (value.isArray()) {
+    // shortcut!
+    builder->add(VPackValue(static_cast<double>(value.length())));
+    return AqlValue$(builder->slice());
+  }
+  size_t length = 0;
+  if (value.isNone() || value.isNull()) {
+    length = 0;
+  } else if (value.isBoolean()) {
+    if (value.getBoolean()) {
+      length = 1;
+    } else {
+      length = 0;
     }
-
-    auto merged = TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(),
-                                param.json(), false, false);
-
-    if (merged == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  } else if (value.isNumber()) {
+    double tmp = value.getNumericValue<double>();
+    if (std::isnan(tmp) || !std::isfinite(tmp)) {
+      length = strlen("null");
+    } else {
+      char buffer[24];
+      length = static_cast<size_t>(fpconv_dtoa(tmp, buffer));
     }
-
-    result.reset(merged);
+  } else if (value.isString()) {
+    std::string tmp = value.copyString();
+    length = TRI_CharLengthUtf8String(tmp.c_str());
+  } else if (value.isObject()) {
+    length = static_cast<size_t>(value.length());
   }
-
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-  result.release();
-  return AqlValue(jr);
-#endif
-}
-
-AqlValue$ Functions::MergeVPack(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          VPackFunctionParameters const& parameters) {
-  return MergeParameters(query, trx, parameters, "MERGE", false);
+  builder->add(VPackValue(static_cast<double>(length)));
+  return AqlValue$(builder.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function MERGE_RECURSIVE
+/// @brief function FIRST
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::MergeRecursive(arangodb::aql::Query* query,
-                                   arangodb::AqlTransaction* trx,
-                                   FunctionParameters const& parameters) {
+AqlValue Functions::First(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(MergeRecursiveVPack(query, trx, tmp));
+  return AqlValue(FirstVPack(query, trx, tmp));
 #else
-  size_t const n = parameters.size();
-
-  if (n == 0) {
-    // no parameters
-    return AqlValue(new Json(Json::Object));
+  if (parameters.size() < 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FIRST", (int)1,
+        (int)1);
   }
 
-  // use the first argument as the preliminary result
-  auto initial = ExtractFunctionParameter(trx, parameters, 0, true);
-
-  if (initial.isArray() && n == 1) {
-    // special case: a single array parameter
-    std::unique_ptr<TRI_json_t> array(initial.steal());
-    std::unique_ptr<TRI_json_t> result(
-        TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE));
-
-    if (result == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
-
-    // now merge in all other arguments
-    size_t const k = TRI_LengthArrayJson(array.get());
-
-    for (size_t i = 0; i < k; ++i) {
-      auto v =
-          static_cast<TRI_json_t const*>(TRI_LookupArrayJson(array.get(), i));
-
-      if (!TRI_IsObjectJson(v)) {
-        RegisterInvalidArgumentWarning(query, "MERGE_RECURSIVE");
-        return AqlValue(new Json(Json::Null));
-      }
-
-      auto merged =
-          TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(), v, false, true);
-
-      if (merged == nullptr) {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-      }
-
-      result.reset(merged);
-    }
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-    auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-    result.release();
-    return AqlValue(jr);
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "FIRST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
   }
 
-  if (!initial.isObject()) {
-    RegisterInvalidArgumentWarning(query, "MERGE_RECURSIVE");
+  if (value.size() == 0) {
     return AqlValue(new Json(Json::Null));
   }
 
-  std::unique_ptr<TRI_json_t> result(initial.steal());
-
-  // now merge in all other arguments
-  for (size_t i = 1; i < n; ++i) {
-    auto param = ExtractFunctionParameter(trx, parameters, i, false);
-
-    if (!param.isObject()) {
-      RegisterInvalidArgumentWarning(query, "MERGE_RECURSIVE");
-      return AqlValue(new Json(Json::Null));
-    }
+  auto j = new Json(TRI_UNKNOWN_MEM_ZONE, value.at(0).copy().steal(),
+                    Json::AUTOFREE);
+  return AqlValue(j);
+#endif
+}
 
-    auto merged = TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(),
-                                param.json(), false, true);
+AqlValue$ Functions::FirstVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  if (parameters.size() < 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FIRST", (int)1,
+        (int)1);
+  }
 
-    if (merged == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-    result.reset(merged);
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "FIRST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    builder->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(builder.get());
   }
 
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-  result.release();
-  return AqlValue(jr);
-#endif
-}
+  if (value.length() == 0) {
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    builder->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(builder.get());
+  }
 
-AqlValue$ Functions::MergeRecursiveVPack(
-    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
-    VPackFunctionParameters const& parameters) {
-  return MergeParameters(query, trx, parameters, "MERGE_RECURSIVE", true);
+  return AqlValue$(value.at(0));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function HAS
+/// @brief function LAST
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Has(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
+AqlValue Functions::Last(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(HasVPack(query, trx, tmp));
+  return AqlValue(LastVPack(query, trx, tmp));
 #else
-  size_t const n = parameters.size();
-
-  if (n < 2) {
-    // no parameters
-    return AqlValue(new Json(false));
+  if (parameters.size() < 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LAST", (int)1,
+        (int)1);
   }
 
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (!value.isObject()) {
-    // not an object
-    return AqlValue(new Json(false));
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "LAST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
   }
 
-  // process name parameter
-  auto name = ExtractFunctionParameter(trx, parameters, 1, false);
-
-  char const* p;
+  size_t const n = value.size();
 
-  if (!name.isString()) {
-    arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
-    AppendAsString(buffer, name.json());
-    p = buffer.c_str();
-  } else {
-    p = name.json()->_value._string.data;
+  if (n == 0) {
+    return AqlValue(new Json(Json::Null));
   }
 
-  bool const hasAttribute = (TRI_LookupObjectJson(value.json(), p) != nullptr);
-  return AqlValue(new Json(hasAttribute));
+  auto j = new Json(TRI_UNKNOWN_MEM_ZONE, value.at(n - 1).copy().steal(),
+                    Json::AUTOFREE);
+  return AqlValue(j);
 #endif
 }
 
-AqlValue$ Functions::HasVPack(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n < 2) {
-    // no parameters
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(false));
-    return AqlValue$(b.get());
+AqlValue$ Functions::LastVPack(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               VPackFunctionParameters const& parameters) {
+  if (parameters.size() < 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LAST", (int)1,
+        (int)1);
   }
 
   auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (!value.isObject()) {
-    // not an object
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(false));
-    return AqlValue$(b.get());
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "LAST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    builder->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(builder.get());
   }
 
-  auto name = ExtractFunctionParameter(trx, parameters, 1);
-  std::string p;
-  if (!name.isString()) {
-    arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
-    arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
-    AppendAsString(adapter, name);
-    p = std::string(buffer.c_str(), buffer.length());
-  } else {
-    p = name.copyString();
+  VPackValueLength const n = value.length();
+
+  if (n == 0) {
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    builder->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(builder.get());
   }
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(value.hasKey(p)));
-  return AqlValue$(b.get());
+  return AqlValue$(value.at(n-1));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function ATTRIBUTES
+/// @brief function NTH
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Attributes(arangodb::aql::Query* query,
-                               arangodb::AqlTransaction* trx,
-                               FunctionParameters const& parameters) {
+AqlValue Functions::Nth(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(AttributesVPack(query, trx, tmp));
+  return AqlValue(NthVPack(query, trx, tmp));
 #else
-  size_t const n = parameters.size();
-
-  if (n < 1) {
-    // no parameters
-    return AqlValue(new Json(Json::Null));
+  if (parameters.size() < 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LAST", (int)2,
+        (int)2);
   }
 
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (!value.isObject()) {
-    // not an object
-    RegisterWarning(query, "ATTRIBUTES",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "NTH", TRI_ERROR_QUERY_ARRAY_EXPECTED);
     return AqlValue(new Json(Json::Null));
   }
 
-  bool const removeInternal = GetBooleanParameter(trx, parameters, 1, false);
-  bool const doSort = GetBooleanParameter(trx, parameters, 2, false);
+  size_t const n = value.size();
 
-  auto const valueJson = value.json();
-  TRI_ASSERT(TRI_IsObjectJson(valueJson));
+  if (n == 0) {
+    return AqlValue(new Json(Json::Null));
+  }
 
-  size_t const numValues = TRI_LengthVectorJson(valueJson);
+  Json indexJson = ExtractFunctionParameter(trx, parameters, 1, false);
+  bool isValid = true;
+  double numValue = ValueToNumber(indexJson.json(), isValid);
 
-  if (numValues == 0) {
-    // empty object
-    return AqlValue(new Json(Json::Object));
+  if (!isValid || numValue < 0.0) {
+    return AqlValue(new Json(Json::Null));
   }
 
-  std::vector<std::pair<char const*, size_t>> sortPositions;
-  sortPositions.reserve(numValues / 2);
-
-  // create a vector with positions into the object
-  for (size_t i = 0; i < numValues; i += 2) {
-    auto key = static_cast<TRI_json_t const*>(
-        TRI_AddressVector(&valueJson->_value._objects, i));
+  size_t index = static_cast<size_t>(numValue);
 
-    if (!TRI_IsStringJson(key)) {
-      // somehow invalid
-      continue;
-    }
+  if (index >= n) {
+    return AqlValue(new Json(Json::Null));
+  }
 
-    if (removeInternal && *key->_value._string.data == '_') {
-      // skip attribute
-      continue;
-    }
-
-    sortPositions.emplace_back(std::make_pair(key->_value._string.data, i));
-  }
+  auto j = new Json(TRI_UNKNOWN_MEM_ZONE, value.at(index).copy().steal(),
+                    Json::AUTOFREE);
+  return AqlValue(j);
+#endif
+}
 
-  if (doSort) {
-    // sort according to attribute name
-    std::sort(sortPositions.begin(), sortPositions.end(),
-              [](std::pair<char const*, size_t> const& lhs,
-                 std::pair<char const*, size_t> const& rhs) -> bool {
-                return TRI_compare_utf8(lhs.first, rhs.first) < 0;
-              });
+AqlValue$ Functions::NthVPack(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              VPackFunctionParameters const& parameters) {
+  if (parameters.size() < 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LAST", (int)2,
+        (int)2);
   }
 
-  // create the output
-  Json result(Json::Array, sortPositions.size());
-
-  // iterate over either sorted or unsorted object
-  for (auto const& it : sortPositions) {
-    auto key = static_cast<TRI_json_t const*>(
-        TRI_AddressVector(&valueJson->_value._objects, it.second));
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-    result.add(Json(arangodb::basics::JsonHelper::getStringValue(key, "")));
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "NTH", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    builder->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(builder.get());
   }
 
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
-#endif
-}
-
-AqlValue$ Functions::AttributesVPack(
-    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
-    VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-
-  if (n < 1) {
-    // no parameters
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+  VPackValueLength const n = value.length();
 
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
-  if (!value.isObject()) {
-    // not an object
-    RegisterWarning(query, "ATTRIBUTES",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  if (n == 0) {
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    builder->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(builder.get());
   }
 
-  bool const removeInternal = GetBooleanParameter(trx, parameters, 1, false);
-  bool const doSort = GetBooleanParameter(trx, parameters, 2, false);
+  VPackSlice indexSlice = ExtractFunctionParameter(trx, parameters, 1);
+  bool isValid = true;
+  double numValue = ValueToNumber(indexSlice, isValid);
 
-  TRI_ASSERT(value.isObject());
-  if (value.length() == 0) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    {
-      VPackObjectBuilder guard(b.get());
-    }
-    return AqlValue$(b.get());
+  if (!isValid || numValue < 0.0) {
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    builder->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(builder.get());
   }
 
-  if (doSort) {
-    std::set<std::string, arangodb::basics::VelocyPackHelper::AttributeSorter>
-        keys;
-    VPackCollection::keys(value, keys);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    {
-      VPackArrayBuilder guard(b.get());
-      for (auto const& it : keys) {
-        TRI_ASSERT(!it.empty());
-        if (removeInternal && it.at(0) == '_') {
-            continue;
-        }
-        b->add(VPackValue(it));
-      }
-    }
-    return AqlValue$(b.get());
-  } else {
-    std::set<std::string> keys;
-    VPackCollection::keys(value, keys);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    {
-      VPackArrayBuilder guard(b.get());
-      for (auto const& it : keys) {
-        TRI_ASSERT(!it.empty());
-        if (removeInternal && it.at(0) == '_') {
-            continue;
-        }
-        b->add(VPackValue(it));
-      }
-    }
-    return AqlValue$(b.get());
+  size_t index = static_cast<size_t>(numValue);
+
+  if (index >= n) {
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    builder->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(builder.get());
   }
+  return AqlValue$(value.at(index));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function VALUES
+/// @brief function CONCAT
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Values(arangodb::aql::Query* query,
+AqlValue Functions::Concat(arangodb::aql::Query* query,
                            arangodb::AqlTransaction* trx,
                            FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(ValuesVPack(query, trx, tmp));
+  return AqlValue(ConcatVPack(query, trx, tmp));
 #else
-  size_t const n = parameters.size();
-
-  if (n < 1) {
-    // no parameters
-    return AqlValue(new Json(Json::Null));
-  }
-
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
 
-  if (!value.isObject()) {
-    // not an object
-    RegisterWarning(query, "VALUES",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    return AqlValue(new Json(Json::Null));
-  }
+  size_t const n = parameters.size();
 
-  bool const removeInternal = GetBooleanParameter(trx, parameters, 1, false);
+  for (size_t i = 0; i < n; ++i) {
+    auto const member = ExtractFunctionParameter(trx, parameters, i, false);
 
-  auto const valueJson = value.json();
-  TRI_ASSERT(TRI_IsObjectJson(valueJson));
+    if (member.isEmpty() || member.isNull()) {
+      continue;
+    }
 
-  size_t const numValues = TRI_LengthVectorJson(valueJson);
+    TRI_json_t const* json = member.json();
 
-  if (numValues == 0) {
-    // empty object
-    return AqlValue(new Json(Json::Object));
-  }
+    if (member.isArray()) {
+      // append each member individually
+      size_t const subLength = TRI_LengthArrayJson(json);
 
-  // create the output
-  Json result(Json::Array, numValues);
+      for (size_t j = 0; j < subLength; ++j) {
+        auto sub = static_cast<TRI_json_t const*>(
+            TRI_AtVector(&json->_value._objects, j));
 
-  // create a vector with positions into the object
-  for (size_t i = 0; i < numValues; i += 2) {
-    auto key = static_cast<TRI_json_t const*>(
-        TRI_AddressVector(&valueJson->_value._objects, i));
+        if (sub == nullptr || sub->_type == TRI_JSON_NULL) {
+          continue;
+        }
 
-    if (!TRI_IsStringJson(key)) {
-      // somehow invalid
-      continue;
+        AppendAsString(buffer, sub);
+      }
+    } else {
+      // convert member to a string and append
+      AppendAsString(buffer, json);
     }
+  }
 
-    if (removeInternal && *key->_value._string.data == '_') {
-      // skip attribute
-      continue;
-    }
+  // steal the StringBuffer's char* pointer so we can avoid copying data around
+  // multiple times
+  size_t length = buffer.length();
+  std::unique_ptr<TRI_json_t> j(
+      TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length));
 
-    auto value = static_cast<TRI_json_t const*>(
-        TRI_AddressVector(&valueJson->_value._objects, i + 1));
-    result.add(Json(TRI_UNKNOWN_MEM_ZONE, SafeCopyJson(value)));
+  if (j == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
 
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
+  return AqlValue(jr);
 #endif
 }
 
-AqlValue$ Functions::ValuesVPack(arangodb::aql::Query* query,
+AqlValue$ Functions::ConcatVPack(arangodb::aql::Query* query,
                                  arangodb::AqlTransaction* trx,
                                  VPackFunctionParameters const& parameters) {
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+
   size_t const n = parameters.size();
 
-  if (n < 1) {
-    // no parameters
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+  for (size_t i = 0; i < n; ++i) {
+    auto const member = ExtractFunctionParameter(trx, parameters, i);
 
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
-  if (!value.isObject()) {
-    // not an object
-    RegisterWarning(query, "VALUES",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+    if (member.isNone() || member.isNull()) {
+      continue;
+    }
 
-  bool const removeInternal = GetBooleanParameter(trx, parameters, 1, false);
+    if (member.isArray()) {
+      // append each member individually
+      for (auto const& sub : VPackArrayIterator(member)) {
+        if (sub.isNone() || sub.isNull()) {
+          continue;
+        }
 
-  TRI_ASSERT(value.isObject());
-  if (value.length() == 0) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    {
-      VPackObjectBuilder guard(b.get());
+        AppendAsString(adapter, sub);
+      }
+    } else {
+      // convert member to a string and append
+      AppendAsString(adapter, member);
     }
-    return AqlValue$(b.get());
   }
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  {
-    VPackArrayBuilder guard(b.get());
-    for (auto const& entry : VPackObjectIterator(value)) {
-      if (!entry.key.isString()) {
-        // somehow invalid
-        continue;
-      }
-      if (removeInternal && entry.key.copyString().at(0) == '_') {
-        // skip attribute
-        continue;
-      }
-      b->add(entry.value);
-    }
+  // steal the StringBuffer's char* pointer so we can avoid copying data around
+  // multiple times
+  size_t length = buffer.length();
+  try {
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    std::string res(buffer.steal(), length);
+    builder->add(VPackValue(std::move(res)));
+    return AqlValue$(builder.get());
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
-  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function MIN
+/// @brief function LIKE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Min(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
+AqlValue Functions::Like(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(MinVPack(query, trx, tmp));
+  return AqlValue(LikeVPack(query, trx, tmp));
 #else
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "MIN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+  if (parameters.size() < 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LIKE", (int)2,
+        (int)3);
   }
 
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
-  TRI_json_t const* minValue = nullptr;
+  bool const caseInsensitive = GetBooleanParameter(trx, parameters, 2, false);
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(
-        TRI_AtVector(&valueJson->_value._objects, i));
+  // build pattern from parameter #1
+  auto const regex = ExtractFunctionParameter(trx, parameters, 1, false);
+  AppendAsString(buffer, regex.json());
+  size_t const length = buffer.length();
 
-    if (TRI_IsNullJson(value)) {
-      continue;
-    }
+  std::string const pattern =
+      BuildRegexPattern(buffer.c_str(), length, caseInsensitive);
+  RegexMatcher* matcher = nullptr;
 
-    if (minValue == nullptr || TRI_CompareValuesJson(value, minValue) < 0) {
-      minValue = value;
+  if (RegexCache != nullptr) {
+    auto it = RegexCache->find(pattern);
+
+    // check regex cache
+    if (it != RegexCache->end()) {
+      matcher = (*it).second;
     }
   }
 
-  if (minValue != nullptr) {
-    std::unique_ptr<TRI_json_t> result(SafeCopyJson(minValue));
+  if (matcher == nullptr) {
+    matcher =
+        arangodb::basics::Utf8Helper::DefaultUtf8Helper.buildMatcher(pattern);
 
-    if (result != nullptr) {
-      auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-      result.release();
-      return AqlValue(jr);
+    try {
+      if (RegexCache == nullptr) {
+        RegexCache = new std::unordered_map<std::string, RegexMatcher*>();
+      }
+      // insert into cache, no matter if pattern is valid or not
+      RegexCache->emplace(pattern, matcher);
+    } catch (...) {
+      delete matcher;
+      ClearRegexCache();
+      throw;
     }
   }
 
-  return AqlValue(new Json(Json::Null));
-#endif
-}
+  if (matcher == nullptr) {
+    // compiling regular expression failed
+    RegisterWarning(query, "LIKE", TRI_ERROR_QUERY_INVALID_REGEX);
+    return AqlValue(new Json(Json::Null));
+  }
 
-AqlValue$ Functions::MinVPack(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              VPackFunctionParameters const& parameters) {
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
+  // extract value
+  buffer.clear();
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+  AppendAsString(buffer, value.json());
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "MIN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+  bool error = false;
+  bool const result = arangodb::basics::Utf8Helper::DefaultUtf8Helper.matches(
+      matcher, buffer.c_str(), buffer.length(), error);
 
-  VPackSlice minValue;
-  for (auto const& it : VPackArrayIterator(value)) {
-    if (it.isNull()) {
-      continue;
-    }
-    if (minValue.isNone() || arangodb::basics::VelocyPackHelper::compare(it, minValue, true) < 0) {
-      minValue = it;
-    }
-  }
-  if (minValue.isNone()) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  if (error) {
+    // compiling regular expression failed
+    RegisterWarning(query, "LIKE", TRI_ERROR_QUERY_INVALID_REGEX);
+    return AqlValue(new Json(Json::Null));
   }
-  return AqlValue$(minValue);
+
+  return AqlValue(new Json(result));
+#endif
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function MAX
-////////////////////////////////////////////////////////////////////////////////
+AqlValue$ Functions::LikeVPack(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               VPackFunctionParameters const& parameters) {
+  if (parameters.size() < 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "LIKE", (int)2,
+        (int)3);
+  }
 
-AqlValue Functions::Max(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(MaxVPack(query, trx, tmp));
-#else
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
+  bool const caseInsensitive = GetBooleanParameter(trx, parameters, 2, false);
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "MAX", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
-  }
+  // build pattern from parameter #1
+  auto const regex = ExtractFunctionParameter(trx, parameters, 1);
+  AppendAsString(adapter, regex);
 
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
-  TRI_json_t const* maxValue = nullptr;
-  ;
+  size_t const length = buffer.length();
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(
-        TRI_AtVector(&valueJson->_value._objects, i));
+  std::string const pattern =
+      BuildRegexPattern(buffer.c_str(), length, caseInsensitive);
+  RegexMatcher* matcher = nullptr;
 
-    if (TRI_IsNullJson(value)) {
-      continue;
-    }
+  if (RegexCache != nullptr) {
+    auto it = RegexCache->find(pattern);
 
-    if (maxValue == nullptr || TRI_CompareValuesJson(value, maxValue) > 0) {
-      maxValue = value;
+    // check regex cache
+    if (it != RegexCache->end()) {
+      matcher = (*it).second;
     }
   }
 
-  if (maxValue != nullptr) {
-    std::unique_ptr<TRI_json_t> result(SafeCopyJson(maxValue));
+  if (matcher == nullptr) {
+    matcher =
+        arangodb::basics::Utf8Helper::DefaultUtf8Helper.buildMatcher(pattern);
 
-    if (result != nullptr) {
-      auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-      result.release();
-      return AqlValue(jr);
+    try {
+      if (RegexCache == nullptr) {
+        RegexCache = new std::unordered_map<std::string, RegexMatcher*>();
+      }
+      // insert into cache, no matter if pattern is valid or not
+      RegexCache->emplace(pattern, matcher);
+    } catch (...) {
+      delete matcher;
+      ClearRegexCache();
+      throw;
     }
   }
 
-  return AqlValue(new Json(Json::Null));
-#endif
-}
-
-AqlValue$ Functions::MaxVPack(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              VPackFunctionParameters const& parameters) {
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
-
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "MAX", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+  if (matcher == nullptr) {
+    // compiling regular expression failed
+    RegisterWarning(query, "LIKE", TRI_ERROR_QUERY_INVALID_REGEX);
     std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
     b->add(VPackValue(VPackValueType::Null));
     return AqlValue$(b.get());
   }
-  VPackSlice maxValue;
-  for (auto const& it : VPackArrayIterator(value)) {
-    if (maxValue.isNone() || arangodb::basics::VelocyPackHelper::compare(it, maxValue, true) > 0) {
-      maxValue = it;
-    }
-  }
-  if (maxValue.isNone()) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+
+  // extract value
+  buffer.clear();
+  auto const value = ExtractFunctionParameter(trx, parameters, 0);
+  AppendAsString(adapter, value);
+
+  bool error = false;
+  bool const result = arangodb::basics::Utf8Helper::DefaultUtf8Helper.matches(
+      matcher, buffer.c_str(), buffer.length(), error);
+
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  if (error) {
+    // compiling regular expression failed
+    RegisterWarning(query, "LIKE", TRI_ERROR_QUERY_INVALID_REGEX);
     b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  } else {
+    b->add(VPackValue(result));
   }
-  return AqlValue$(maxValue);
+  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function SUM
+/// @brief function PASSTHRU
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Sum(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
+AqlValue Functions::Passthru(arangodb::aql::Query* query,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(SumVPack(query, trx, tmp));
+  return AqlValue(PassthruVPack(query, trx, tmp));
 #else
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "SUM", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+  if (parameters.empty()) {
     return AqlValue(new Json(Json::Null));
   }
 
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
-
-  double sum = 0.0;
+  auto json = ExtractFunctionParameter(trx, parameters, 0, true);
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, json.steal()));
+#endif
+}
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(
-        TRI_AtVector(&valueJson->_value._objects, i));
+AqlValue$ Functions::PassthruVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
+  if (parameters.empty()) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
 
-    if (TRI_IsNullJson(value)) {
-      continue;
-    }
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
+  return AqlValue$(value);
+}
 
-    if (!TRI_IsNumberJson(value)) {
-      RegisterInvalidArgumentWarning(query, "SUM");
-      return AqlValue(new Json(Json::Null));
-    }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNSET
+////////////////////////////////////////////////////////////////////////////////
 
-    // got a numeric value
-    double const number = value->_value._number;
+AqlValue Functions::Unset(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(UnsetVPack(query, trx, tmp));
+#else
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-    if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
-      sum += number;
-    }
+  if (!value.isObject()) {
+    RegisterInvalidArgumentWarning(query, "UNSET");
+    return AqlValue(new Json(Json::Null));
   }
 
-  if (!std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
-    return AqlValue(new Json(sum));
+  std::unordered_set<std::string> names;
+  ExtractKeys(names, query, trx, parameters, 1, "UNSET");
+
+  // create result object
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthVector(&valueJson->_value._objects);
+
+  size_t size;
+  if (names.size() >= n / 2) {
+    size = 4;
+  } else {
+    size = (n / 2) - names.size();
   }
 
-  return AqlValue(new Json(Json::Null));
+  std::unique_ptr<TRI_json_t> j(
+      TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, size));
+
+  if (j == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(
+        TRI_AtVector(&valueJson->_value._objects, i));
+    auto value = static_cast<TRI_json_t const*>(
+        TRI_AtVector(&valueJson->_value._objects, i + 1));
+
+    if (TRI_IsStringJson(key) &&
+        names.find(key->_value._string.data) == names.end()) {
+      auto copy = SafeCopyJson(value);
+
+      TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, j.get(),
+                            key->_value._string.data, copy);
+    }
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
+  return AqlValue(jr);
 #endif
 }
 
-AqlValue$ Functions::SumVPack(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::UnsetVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
   auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "SUM", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+  if (!value.isObject()) {
+    RegisterInvalidArgumentWarning(query, "UNSET");
     std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
     b->add(VPackValue(VPackValueType::Null));
     return AqlValue$(b.get());
   }
 
-  double sum = 0.0;
-  for (auto const& it : VPackArrayIterator(value)) {
-    if (it.isNull()) {
-      continue;
-    }
-    if (!it.isNumber()) {
-      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-      b->add(VPackValue(VPackValueType::Null));
-      return AqlValue$(b.get());
-    }
-    double const number = it.getNumericValue<double>();
+  std::unordered_set<std::string> names;
+  ExtractKeys(names, query, trx, parameters, 1, "UNSET");
 
-    if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
-      sum += number;
-    }
-  }
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (!std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
-    b->add(VPackValue(sum));
-  } else {
-    b->add(VPackValue(VPackValueType::Null));
+  try {
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    UnsetOrKeep(value, names, true, false, *builder);
+    return AqlValue$(builder.get());
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
-  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function AVERAGE
+/// @brief function UNSET_RECURSIVE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Average(arangodb::aql::Query* query,
-                            arangodb::AqlTransaction* trx,
-                            FunctionParameters const& parameters) {
+AqlValue Functions::UnsetRecursive(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(AverageVPack(query, trx, tmp));
+  return AqlValue(UnsetRecursiveVPack(query, trx, tmp));
 #else
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+  if (!value.isObject()) {
+    RegisterInvalidArgumentWarning(query, "UNSET_RECURSIVE");
     return AqlValue(new Json(Json::Null));
   }
 
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
-  double sum = 0.0;
-  size_t count = 0;
+  std::unordered_set<std::string> names;
+  ExtractKeys(names, query, trx, parameters, 1, "UNSET_RECURSIVE");
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(
-        TRI_AtVector(&valueJson->_value._objects, i));
+  std::function<TRI_json_t*(TRI_json_t const*,
+                            std::unordered_set<std::string> const&)> func;
 
-    if (TRI_IsNullJson(value)) {
-      continue;
+  func = [&func](TRI_json_t const* value,
+                 std::unordered_set<std::string> const& names) -> TRI_json_t* {
+    TRI_ASSERT(TRI_IsObjectJson(value));
+
+    size_t const n = TRI_LengthVector(&value->_value._objects);
+    size_t size;
+    if (names.size() >= n / 2) {
+      size = 4;
+    } else {
+      size = (n / 2) - names.size();
     }
 
-    if (!TRI_IsNumberJson(value)) {
-      RegisterInvalidArgumentWarning(query, "AVERAGE");
-      return AqlValue(new Json(Json::Null));
+    std::unique_ptr<TRI_json_t> j(
+        TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, size));
+
+    if (j == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
     }
 
-    // got a numeric value
-    double const number = value->_value._number;
+    for (size_t i = 0; i < n; i += 2) {
+      auto k = static_cast<TRI_json_t const*>(
+          TRI_AtVector(&value->_value._objects, i));
+      auto v = static_cast<TRI_json_t const*>(
+          TRI_AtVector(&value->_value._objects, i + 1));
 
-    if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
-      sum += number;
-      ++count;
+      if (TRI_IsStringJson(k) &&
+          names.find(k->_value._string.data) == names.end()) {
+        TRI_json_t* copy = nullptr;
+
+        if (TRI_IsObjectJson(v)) {
+          copy = func(v, names);
+        } else {
+          copy = SafeCopyJson(v);
+        }
+
+        if (copy == nullptr) {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+        }
+
+        TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, j.get(),
+                              k->_value._string.data, copy);
+      }
     }
-  }
 
-  if (count > 0 && !std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
-    return AqlValue(new Json(sum / static_cast<size_t>(count)));
-  }
+    return j.release();
+  };
 
-  return AqlValue(new Json(Json::Null));
+  TRI_json_t* result = func(value.json(), names);
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result);
+  return AqlValue(jr);
 #endif
 }
 
-AqlValue$ Functions::AverageVPack(arangodb::aql::Query* query,
-                                  arangodb::AqlTransaction* trx,
-                                  VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::UnsetRecursiveVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
   auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+  if (!value.isObject()) {
+    RegisterInvalidArgumentWarning(query, "UNSET_RECURSIVE");
     std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
     b->add(VPackValue(VPackValueType::Null));
     return AqlValue$(b.get());
   }
 
-  double sum = 0.0;
-  size_t count = 0;
-  for (auto const& v : VPackArrayIterator(value)) {
-    if (v.isNull()) {
-      continue;
-    }
-    if (!v.isNumber()) {
-      RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-      b->add(VPackValue(VPackValueType::Null));
-      return AqlValue$(b.get());
-    }
-
-    // got a numeric value
-    double const number = v.getNumericValue<double>();
-
-    if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
-      sum += number;
-      ++count;
-    }
-  }
+  std::unordered_set<std::string> names;
+  ExtractKeys(names, query, trx, parameters, 1, "UNSET_RECURSIVE");
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (count > 0 && !std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
-    b->add(VPackValue(sum / static_cast<size_t>(count)));
-  } else {
-    b->add(VPackValue(VPackValueType::Null));
+  try {
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    UnsetOrKeep(value, names, true, true, *builder);
+    return AqlValue$(builder.get());
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
-  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function MD5
+/// @brief function KEEP
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Md5(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
+AqlValue Functions::Keep(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(KeepVPack(query, trx, tmp));
+#else
   auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
-  AppendAsString(buffer, value.json());
+  if (!value.isObject()) {
+    RegisterInvalidArgumentWarning(query, "KEEP");
+    return AqlValue(new Json(Json::Null));
+  }
 
-  // create md5
-  char hash[17];
-  char* p = &hash[0];
-  size_t length;
+  std::unordered_set<std::string> names;
+  ExtractKeys(names, query, trx, parameters, 1, "KEEP");
 
-  arangodb::rest::SslInterface::sslMD5(buffer.c_str(), buffer.length(), p,
-                                       length);
+  // create result object
+  std::unique_ptr<TRI_json_t> j(
+      TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, names.size()));
 
-  // as hex
-  char hex[33];
-  p = &hex[0];
+  if (j == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
 
-  arangodb::rest::SslInterface::sslHEX(hash, 16, p, length);
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthVector(&valueJson->_value._objects);
 
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, hex, 32));
-}
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(
+        TRI_AtVector(&valueJson->_value._objects, i));
+    auto value = static_cast<TRI_json_t const*>(
+        TRI_AtVector(&valueJson->_value._objects, i + 1));
 
-AqlValue$ Functions::Md5VPack(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              VPackFunctionParameters const& parameters) {
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
-  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+    if (TRI_IsStringJson(key) &&
+        names.find(key->_value._string.data) != names.end()) {
+      auto copy = SafeCopyJson(value);
 
-  AppendAsString(adapter, value);
+      if (copy == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
 
-  // create md5
-  char hash[17];
-  char* p = &hash[0];
-  size_t length;
+      TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, j.get(),
+                            key->_value._string.data, copy);
+    }
+  }
 
-  arangodb::rest::SslInterface::sslMD5(buffer.c_str(), buffer.length(), p,
-                                       length);
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, j.get());
+  j.release();
+  return AqlValue(jr);
+#endif
+}
 
-  // as hex
-  char hex[33];
-  p = &hex[0];
+AqlValue$ Functions::KeepVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-  arangodb::rest::SslInterface::sslHEX(hash, 16, p, length);
+  if (!value.isObject()) {
+    RegisterInvalidArgumentWarning(query, "KEEP");
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(std::string(hex, 32)));
-  return AqlValue$(b.get());
+  std::unordered_set<std::string> names;
+  ExtractKeys(names, query, trx, parameters, 1, "KEEP");
+
+  try {
+    std::shared_ptr<VPackBuilder> builder = query->getSharedBuilder();
+    UnsetOrKeep(value, names, false, false, *builder);
+    return AqlValue$(builder.get());
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function SHA1
+/// @brief function MERGE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Sha1(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         FunctionParameters const& parameters) {
+AqlValue Functions::Merge(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(Sha1VPack(query, trx, tmp));
+  return AqlValue(MergeVPack(query, trx, tmp));
 #else
-  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
-  AppendAsString(buffer, value.json());
-
-  // create sha1
-  char hash[21];
-  char* p = &hash[0];
-  size_t length;
-
-  arangodb::rest::SslInterface::sslSHA1(buffer.c_str(), buffer.length(), p,
-                                        length);
-
-  // as hex
-  char hex[41];
-  p = &hex[0];
-
-  arangodb::rest::SslInterface::sslHEX(hash, 20, p, length);
+  size_t const n = parameters.size();
 
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, hex, 40));
-#endif
-}
+  if (n == 0) {
+    // no parameters
+    return AqlValue(new Json(Json::Object));
+  }
 
-AqlValue$ Functions::Sha1VPack(arangodb::aql::Query* query,
-                               arangodb::AqlTransaction* trx,
-                               VPackFunctionParameters const& parameters) {
-  auto value = ExtractFunctionParameter(trx, parameters, 0);
+  // use the first argument as the preliminary result
+  auto initial = ExtractFunctionParameter(trx, parameters, 0, true);
 
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
-  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+  if (initial.isArray() && n == 1) {
+    // special case: a single array parameter
+    std::unique_ptr<TRI_json_t> array(initial.steal());
+    std::unique_ptr<TRI_json_t> result(
+        TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE));
 
-  AppendAsString(adapter, value);
+    if (result == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
 
-  // create sha1
-  char hash[21];
-  char* p = &hash[0];
-  size_t length;
+    // now merge in all other arguments
+    size_t const k = TRI_LengthArrayJson(array.get());
 
-  arangodb::rest::SslInterface::sslSHA1(buffer.c_str(), buffer.length(), p,
-                                        length);
+    for (size_t i = 0; i < k; ++i) {
+      auto v =
+          static_cast<TRI_json_t const*>(TRI_LookupArrayJson(array.get(), i));
 
-  // as hex
-  char hex[41];
-  p = &hex[0];
+      if (!TRI_IsObjectJson(v)) {
+        RegisterInvalidArgumentWarning(query, "MERGE");
+        return AqlValue(new Json(Json::Null));
+      }
 
-  arangodb::rest::SslInterface::sslHEX(hash, 20, p, length);
+      auto merged =
+          TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(), v, false, false);
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(std::string(hex, 40)));
-  return AqlValue$(b.get());
-}
+      if (merged == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function UNIQUE
-////////////////////////////////////////////////////////////////////////////////
+      result.reset(merged);
+    }
 
-AqlValue Functions::Unique(arangodb::aql::Query* query,
-                           arangodb::AqlTransaction* trx,
-                           FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(UniqueVPack(query, trx, tmp));
-#else
-  if (parameters.size() != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNIQUE", (int)1,
-        (int)1);
+    auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+    result.release();
+    return AqlValue(jr);
   }
 
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "UNIQUE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+  if (!initial.isObject()) {
+    RegisterInvalidArgumentWarning(query, "MERGE");
     return AqlValue(new Json(Json::Null));
   }
 
-  std::unordered_set<TRI_json_t const*, arangodb::basics::JsonHash,
-                     arangodb::basics::JsonEqual>
-      values(512, arangodb::basics::JsonHash(), arangodb::basics::JsonEqual());
-
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
+  std::unique_ptr<TRI_json_t> result(initial.steal());
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(
-        TRI_AddressVector(&valueJson->_value._objects, i));
+  // now merge in all other arguments
+  for (size_t i = 1; i < n; ++i) {
+    auto param = ExtractFunctionParameter(trx, parameters, i, false);
 
-    if (value == nullptr) {
-      continue;
+    if (!param.isObject()) {
+      RegisterInvalidArgumentWarning(query, "MERGE");
+      return AqlValue(new Json(Json::Null));
     }
 
-    values.emplace(value);
-  }
-
-  std::unique_ptr<TRI_json_t> result(
-      TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, values.size()));
+    auto merged = TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(),
+                                param.json(), false, false);
 
-  if (result == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+    if (merged == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
 
-  for (auto const& it : values) {
-    auto copy = SafeCopyJson(it);
-    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+    result.reset(merged);
   }
 
   auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
@@ -3840,105 +3879,94 @@ AqlValue Functions::Unique(arangodb::aql::Query* query,
 #endif
 }
 
-AqlValue$ Functions::UniqueVPack(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 VPackFunctionParameters const& parameters) {
-  if (parameters.size() != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNIQUE", (int)1,
-        (int)1);
-  }
+AqlValue$ Functions::MergeVPack(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          VPackFunctionParameters const& parameters) {
+  return MergeParameters(query, trx, parameters, "MERGE", false);
+}
 
-  auto const value = ExtractFunctionParameter(trx, parameters, 0);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MERGE_RECURSIVE
+////////////////////////////////////////////////////////////////////////////////
 
-  if (!value.isArray()) {
-    // not an array
-    RegisterWarning(query, "UNIQUE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
-
-  std::unordered_set<VPackSlice,
-                     arangodb::basics::VelocyPackHelper::VPackHash,
-                     arangodb::basics::VelocyPackHelper::VPackEqual>
-      values(512, arangodb::basics::VelocyPackHelper::VPackHash(),
-             arangodb::basics::VelocyPackHelper::VPackEqual());
+AqlValue Functions::MergeRecursive(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(MergeRecursiveVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
 
-  for (auto const& s : VPackArrayIterator(value)) {
-    if (!s.isNone()) {
-      values.emplace(s);
-    }
+  if (n == 0) {
+    // no parameters
+    return AqlValue(new Json(Json::Object));
   }
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  try {
-    VPackArrayBuilder guard(b.get());
-    for (auto const& it : values) {
-      b->add(it);
-    }
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
-  return AqlValue$(b.get());
-}
+  // use the first argument as the preliminary result
+  auto initial = ExtractFunctionParameter(trx, parameters, 0, true);
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function SORTED_UNIQUE
-////////////////////////////////////////////////////////////////////////////////
+  if (initial.isArray() && n == 1) {
+    // special case: a single array parameter
+    std::unique_ptr<TRI_json_t> array(initial.steal());
+    std::unique_ptr<TRI_json_t> result(
+        TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE));
 
-AqlValue Functions::SortedUnique(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(SortedUniqueVPack(query, trx, tmp));
-#else
-  if (parameters.size() != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SORTED_UNIQUE",
-        (int)1, (int)1);
-  }
+    if (result == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
 
-  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
+    // now merge in all other arguments
+    size_t const k = TRI_LengthArrayJson(array.get());
 
-  if (!value.isArray()) {
-    // not an array
-    // this is an internal function - do NOT issue a warning here
-    return AqlValue(new Json(Json::Null));
-  }
+    for (size_t i = 0; i < k; ++i) {
+      auto v =
+          static_cast<TRI_json_t const*>(TRI_LookupArrayJson(array.get(), i));
 
-  std::set<TRI_json_t const*, arangodb::basics::JsonLess<true>> values;
+      if (!TRI_IsObjectJson(v)) {
+        RegisterInvalidArgumentWarning(query, "MERGE_RECURSIVE");
+        return AqlValue(new Json(Json::Null));
+      }
 
-  TRI_json_t const* valueJson = value.json();
-  size_t const n = TRI_LengthArrayJson(valueJson);
+      auto merged =
+          TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(), v, false, true);
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = static_cast<TRI_json_t const*>(
-        TRI_AddressVector(&valueJson->_value._objects, i));
+      if (merged == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
 
-    if (value == nullptr) {
-      continue;
+      result.reset(merged);
     }
 
-    values.insert(value);
+    auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+    result.release();
+    return AqlValue(jr);
   }
 
-  std::unique_ptr<TRI_json_t> result(
-      TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, values.size()));
-
-  if (result == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  if (!initial.isObject()) {
+    RegisterInvalidArgumentWarning(query, "MERGE_RECURSIVE");
+    return AqlValue(new Json(Json::Null));
   }
 
-  for (auto const& it : values) {
-    auto copy = SafeCopyJson(it);
+  std::unique_ptr<TRI_json_t> result(initial.steal());
 
-    if (copy == nullptr) {
+  // now merge in all other arguments
+  for (size_t i = 1; i < n; ++i) {
+    auto param = ExtractFunctionParameter(trx, parameters, i, false);
+
+    if (!param.isObject()) {
+      RegisterInvalidArgumentWarning(query, "MERGE_RECURSIVE");
+      return AqlValue(new Json(Json::Null));
+    }
+
+    auto merged = TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.get(),
+                                param.json(), false, true);
+
+    if (merged == nullptr) {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
     }
 
-    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+    result.reset(merged);
   }
 
   auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
@@ -3947,5117 +3975,7857 @@ AqlValue Functions::SortedUnique(arangodb::aql::Query* query,
 #endif
 }
 
-AqlValue$ Functions::SortedUniqueVPack(
+AqlValue$ Functions::MergeRecursiveVPack(
     arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
     VPackFunctionParameters const& parameters) {
-  if (parameters.size() != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SORTED_UNIQUE",
-        (int)1, (int)1);
-  }
-
-  auto const value = ExtractFunctionParameter(trx, parameters, 0);
-
-  if (!value.isArray()) {
-    // not an array
-    // this is an internal function - do NOT issue a warning here
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
-
-  std::set<VPackSlice, arangodb::basics::VelocyPackHelper::VPackLess<true>> values;
-  for (auto const& it : VPackArrayIterator(value)) {
-    if (!it.isNone()) {
-      values.insert(it);
-    }
-  }
-
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  try {
-    VPackArrayBuilder guard(b.get());
-    for (auto const& it : values) {
-      b->add(it);
-    }
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
-  return AqlValue$(b.get());
+  return MergeParameters(query, trx, parameters, "MERGE_RECURSIVE", true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function UNION
+/// @brief function HAS
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Union(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          FunctionParameters const& parameters) {
+AqlValue Functions::Has(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(UnionVPack(query, trx, tmp));
+  return AqlValue(HasVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
 
   if (n < 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNION", (int)2,
-        (int)Function::MaxArguments);
+    // no parameters
+    return AqlValue(new Json(false));
   }
 
-  std::unique_ptr<TRI_json_t> result(
-      TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, 16));
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (result == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  if (!value.isObject()) {
+    // not an object
+    return AqlValue(new Json(false));
   }
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = ExtractFunctionParameter(trx, parameters, i, false);
-
-    if (!value.isArray()) {
-      // not an array
-      RegisterInvalidArgumentWarning(query, "UNION");
-      return AqlValue(new Json(Json::Null));
-    }
-
-    TRI_json_t const* valueJson = value.json();
-    size_t const nrValues = TRI_LengthArrayJson(valueJson);
-
-    if (TRI_ReserveVector(&(result.get()->_value._objects), nrValues) !=
-        TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
-
-    TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-    }
-
-    // this passes ownership for the JSON contens into result
-    for (size_t j = 0; j < nrValues; ++j) {
-      TRI_json_t* copy = SafeCopyJson(TRI_LookupArrayJson(valueJson, j));
-
-      TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+  // process name parameter
+  auto name = ExtractFunctionParameter(trx, parameters, 1, false);
 
-      TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-      }
-    }
-  }
+  char const* p;
 
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  if (!name.isString()) {
+    arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+    AppendAsString(buffer, name.json());
+    p = buffer.c_str();
+  } else {
+    p = name.json()->_value._string.data;
   }
 
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-  result.release();
-  return AqlValue(jr);
+  bool const hasAttribute = (TRI_LookupObjectJson(value.json(), p) != nullptr);
+  return AqlValue(new Json(hasAttribute));
 #endif
 }
 
-AqlValue$ Functions::UnionVPack(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::HasVPack(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-
   if (n < 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNION", (int)2,
-        (int)Function::MaxArguments);
+    // no parameters
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(false));
+    return AqlValue$(b.get());
   }
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  try {
-    VPackArrayBuilder guard(b.get());
-    for (size_t i = 0; i < n; ++i) {
-      auto value = ExtractFunctionParameter(trx, parameters, i);
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-      if (!value.isArray()) {
-        // not an array
-        RegisterInvalidArgumentWarning(query, "UNION");
-        b->clear();
-        b->add(VPackValue(VPackValueType::Null));
-        return AqlValue$(b.get());
-      }
-
-      TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-      }
-
-      // this passes ownership for the JSON contens into result
-      for (auto const& it : VPackArrayIterator(value)) {
-        b->add(it);
-        TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-        }
-      }
-    }
-  } catch (arangodb::basics::Exception const& e) {
-    // Rethrow arangodb Errors
-    throw e;
-  } catch (std::exception const& e) {
-    // All other exceptions are OUT_OF_MEMORY
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  if (!value.isObject()) {
+    // not an object
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(false));
+    return AqlValue$(b.get());
   }
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+
+  auto name = ExtractFunctionParameter(trx, parameters, 1);
+  std::string p;
+  if (!name.isString()) {
+    arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+    arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+    AppendAsString(adapter, name);
+    p = std::string(buffer.c_str(), buffer.length());
+  } else {
+    p = name.copyString();
   }
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(value.hasKey(p)));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function UNION_DISTINCT
+/// @brief function ATTRIBUTES
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::UnionDistinct(arangodb::aql::Query* query,
-                                  arangodb::AqlTransaction* trx,
-                                  FunctionParameters const& parameters) {
+AqlValue Functions::Attributes(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(UnionDistinctVPack(query, trx, tmp));
+  return AqlValue(AttributesVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
 
-  if (n < 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNION_DISTINCT",
-        (int)2, (int)Function::MaxArguments);
+  if (n < 1) {
+    // no parameters
+    return AqlValue(new Json(Json::Null));
   }
 
-  std::unordered_set<TRI_json_t*, arangodb::basics::JsonHash,
-                     arangodb::basics::JsonEqual>
-      values(512, arangodb::basics::JsonHash(), arangodb::basics::JsonEqual());
-
-  auto freeValues = [&values]() -> void {
-    for (auto& it : values) {
-      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it);
-    }
-  };
-
-  std::unique_ptr<TRI_json_t> result;
-
-  try {
-    for (size_t i = 0; i < n; ++i) {
-      auto value = ExtractFunctionParameter(trx, parameters, i, false);
-
-      if (!value.isArray()) {
-        // not an array
-        freeValues();
-        RegisterInvalidArgumentWarning(query, "UNION_DISTINCT");
-        return AqlValue(new Json(Json::Null));
-      }
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-      TRI_json_t const* valueJson = value.json();
-      size_t const nrValues = TRI_LengthArrayJson(valueJson);
+  if (!value.isObject()) {
+    // not an object
+    RegisterWarning(query, "ATTRIBUTES",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(new Json(Json::Null));
+  }
 
-      for (size_t j = 0; j < nrValues; ++j) {
-        auto value = static_cast<TRI_json_t*>(
-            TRI_AddressVector(&valueJson->_value._objects, j));
+  bool const removeInternal = GetBooleanParameter(trx, parameters, 1, false);
+  bool const doSort = GetBooleanParameter(trx, parameters, 2, false);
 
-        if (values.find(value) == values.end()) {
-          std::unique_ptr<TRI_json_t> copy(SafeCopyJson(value));
+  auto const valueJson = value.json();
+  TRI_ASSERT(TRI_IsObjectJson(valueJson));
 
-          if (copy == nullptr) {
-            THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-          }
+  size_t const numValues = TRI_LengthVectorJson(valueJson);
 
-          TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
-            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-          }
+  if (numValues == 0) {
+    // empty object
+    return AqlValue(new Json(Json::Object));
+  }
 
-          values.emplace(copy.get());
-          copy.release();
-        }
-      }
-    }
+  std::vector<std::pair<char const*, size_t>> sortPositions;
+  sortPositions.reserve(numValues / 2);
 
-    result.reset(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, values.size()));
+  // create a vector with positions into the object
+  for (size_t i = 0; i < numValues; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(
+        TRI_AddressVector(&valueJson->_value._objects, i));
 
-    if (result == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    if (!TRI_IsStringJson(key)) {
+      // somehow invalid
+      continue;
     }
 
-    TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    if (removeInternal && *key->_value._string.data == '_') {
+      // skip attribute
+      continue;
     }
 
-    for (auto const& it : values) {
-      TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), it);
-    }
+    sortPositions.emplace_back(std::make_pair(key->_value._string.data, i));
+  }
 
-  } catch (...) {
-    freeValues();
-    throw;
+  if (doSort) {
+    // sort according to attribute name
+    std::sort(sortPositions.begin(), sortPositions.end(),
+              [](std::pair<char const*, size_t> const& lhs,
+                 std::pair<char const*, size_t> const& rhs) -> bool {
+                return TRI_compare_utf8(lhs.first, rhs.first) < 0;
+              });
   }
 
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  // create the output
+  Json result(Json::Array, sortPositions.size());
+
+  // iterate over either sorted or unsorted object
+  for (auto const& it : sortPositions) {
+    auto key = static_cast<TRI_json_t const*>(
+        TRI_AddressVector(&valueJson->_value._objects, it.second));
+
+    result.add(Json(arangodb::basics::JsonHelper::getStringValue(key, "")));
   }
 
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-  result.release();
-  return AqlValue(jr);
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
 #endif
 }
 
-AqlValue$ Functions::UnionDistinctVPack(arangodb::aql::Query* query,
-                                        arangodb::AqlTransaction* trx,
-                                        VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::AttributesVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
 
-  if (n < 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNION_DISTINCT",
-        (int)2, (int)Function::MaxArguments);
+  if (n < 1) {
+    // no parameters
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
 
-  std::unordered_set<VPackSlice,
-                     arangodb::basics::VelocyPackHelper::VPackHash,
-                     arangodb::basics::VelocyPackHelper::VPackEqual>
-      values(512, arangodb::basics::VelocyPackHelper::VPackHash(),
-             arangodb::basics::VelocyPackHelper::VPackEqual());
-
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
+  if (!value.isObject()) {
+    // not an object
+    RegisterWarning(query, "ATTRIBUTES",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
 
-  for (size_t i = 0; i < n; ++i) {
-    auto value = ExtractFunctionParameter(trx, parameters, i);
+  bool const removeInternal = GetBooleanParameter(trx, parameters, 1, false);
+  bool const doSort = GetBooleanParameter(trx, parameters, 2, false);
 
-    if (!value.isArray()) {
-      // not an array
-      RegisterInvalidArgumentWarning(query, "UNION_DISTINCT");
-      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-      b->add(VPackValue(VPackValueType::Null));
-      return AqlValue$(b.get());
+  TRI_ASSERT(value.isObject());
+  if (value.length() == 0) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    {
+      VPackObjectBuilder guard(b.get());
     }
+    return AqlValue$(b.get());
+  }
 
-    for (auto const& v : VPackArrayIterator(value)) {
-      if (values.find(v) == values.end()) {
-        TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  if (doSort) {
+    std::set<std::string, arangodb::basics::VelocyPackHelper::AttributeSorter>
+        keys;
+    VPackCollection::keys(value, keys);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    {
+      VPackArrayBuilder guard(b.get());
+      for (auto const& it : keys) {
+        TRI_ASSERT(!it.empty());
+        if (removeInternal && it.at(0) == '_') {
+            continue;
         }
-
-        values.emplace(v);
+        b->add(VPackValue(it));
       }
     }
-  }
-
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-  }
-  try {
-    VPackArrayBuilder guard(b.get());
-    for (auto const& it : values) {
-      b->add(it);
+    return AqlValue$(b.get());
+  } else {
+    std::set<std::string> keys;
+    VPackCollection::keys(value, keys);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    {
+      VPackArrayBuilder guard(b.get());
+      for (auto const& it : keys) {
+        TRI_ASSERT(!it.empty());
+        if (removeInternal && it.at(0) == '_') {
+            continue;
+        }
+        b->add(VPackValue(it));
+      }
     }
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    return AqlValue$(b.get());
   }
-
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-  }
-
-  return AqlValue$(b.get());
-}
+}
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function INTERSECTION
+/// @brief function VALUES
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Intersection(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 FunctionParameters const& parameters) {
+AqlValue Functions::Values(arangodb::aql::Query* query,
+                           arangodb::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(IntersectionVPack(query, trx, tmp));
+  return AqlValue(ValuesVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
 
-  if (n < 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "INTERSECTION",
-        (int)2, (int)Function::MaxArguments);
+  if (n < 1) {
+    // no parameters
+    return AqlValue(new Json(Json::Null));
   }
 
-  std::unordered_map<TRI_json_t*, size_t, arangodb::basics::JsonHash,
-                     arangodb::basics::JsonEqual>
-      values(512, arangodb::basics::JsonHash(), arangodb::basics::JsonEqual());
-
-  auto freeValues = [&values]() -> void {
-    for (auto& it : values) {
-      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.first);
-    }
-    values.clear();
-  };
-
-  std::unique_ptr<TRI_json_t> result;
-
-  try {
-    for (size_t i = 0; i < n; ++i) {
-      auto value = ExtractFunctionParameter(trx, parameters, i, false);
-
-      if (!value.isArray()) {
-        // not an array
-        freeValues();
-        RegisterWarning(query, "INTERSECTION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-        return AqlValue(new Json(Json::Null));
-      }
-
-      TRI_json_t const* valueJson = value.json();
-      size_t const nrValues = TRI_LengthArrayJson(valueJson);
-
-      for (size_t j = 0; j < nrValues; ++j) {
-        auto value = static_cast<TRI_json_t const*>(
-            TRI_AddressVector(&valueJson->_value._objects, j));
-
-        if (i == 0) {
-          // round one
-          std::unique_ptr<TRI_json_t> copy(SafeCopyJson(value));
-
-          TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
-            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-          }
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-          auto r = values.emplace(copy.get(), 1);
+  if (!value.isObject()) {
+    // not an object
+    RegisterWarning(query, "VALUES",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(new Json(Json::Null));
+  }
 
-          if (r.second) {
-            // successfully inserted
-            copy.release();
-          }
-        } else {
-          // check if we have seen the same element before
-          auto it = values.find(const_cast<TRI_json_t*>(value));
+  bool const removeInternal = GetBooleanParameter(trx, parameters, 1, false);
 
-          if (it != values.end()) {
-            // already seen
-            TRI_ASSERT((*it).second > 0);
-            ++((*it).second);
-          }
-        }
-      }
-    }
+  auto const valueJson = value.json();
+  TRI_ASSERT(TRI_IsObjectJson(valueJson));
 
-    // count how many valid we have
-    size_t total = 0;
+  size_t const numValues = TRI_LengthVectorJson(valueJson);
 
-    for (auto const& it : values) {
-      if (it.second == n) {
-        ++total;
-      }
-    }
+  if (numValues == 0) {
+    // empty object
+    return AqlValue(new Json(Json::Object));
+  }
 
-    result.reset(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, total));
+  // create the output
+  Json result(Json::Array, numValues);
 
-    if (result == nullptr) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
+  // create a vector with positions into the object
+  for (size_t i = 0; i < numValues; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(
+        TRI_AddressVector(&valueJson->_value._objects, i));
 
-    TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    if (!TRI_IsStringJson(key)) {
+      // somehow invalid
+      continue;
     }
 
-    for (auto& it : values) {
-      if (it.second == n) {
-        TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), it.first);
-      } else {
-        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.first);
-      }
+    if (removeInternal && *key->_value._string.data == '_') {
+      // skip attribute
+      continue;
     }
-    values.clear();
-
-  } catch (...) {
-    freeValues();
-    throw;
-  }
 
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    auto value = static_cast<TRI_json_t const*>(
+        TRI_AddressVector(&valueJson->_value._objects, i + 1));
+    result.add(Json(TRI_UNKNOWN_MEM_ZONE, SafeCopyJson(value)));
   }
 
-  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
-  result.release();
-  return AqlValue(jr);
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
 #endif
 }
 
-
-AqlValue$ Functions::IntersectionVPack(arangodb::aql::Query* query,
-                                       arangodb::AqlTransaction* trx,
-                                       VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::ValuesVPack(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
 
-  if (n < 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "INTERSECTION",
-        (int)2, (int)Function::MaxArguments);
+  if (n < 1) {
+    // no parameters
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
 
-  std::unordered_map<VPackSlice, size_t,
-                     arangodb::basics::VelocyPackHelper::VPackHash,
-                     arangodb::basics::VelocyPackHelper::VPackEqual>
-      values(512, arangodb::basics::VelocyPackHelper::VPackHash(),
-             arangodb::basics::VelocyPackHelper::VPackEqual());
-
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-
-  for (size_t i = 0; i < n; ++i) {
-    auto value = ExtractFunctionParameter(trx, parameters, i);
-
-    if (!value.isArray()) {
-      // not an array
-      RegisterWarning(query, "INTERSECTION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-      b->clear();
-      b->add(VPackValue(VPackValueType::Null));
-      return AqlValue$(b.get());
-    }
-    
-    for (auto const& it : VPackArrayIterator(value)) {
-      if (i == 0) {
-        // round one
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
+  if (!value.isObject()) {
+    // not an object
+    RegisterWarning(query, "VALUES",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
 
-        TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-        }
+  bool const removeInternal = GetBooleanParameter(trx, parameters, 1, false);
 
-        values.emplace(it, 1);
-      } else {
-        // check if we have seen the same element before
-        auto found = values.find(it);
-        if (found != values.end()) {
-          // already seen
-          TRI_ASSERT((*found).second > 0);
-          ++(found->second);
-        }
-      }
+  TRI_ASSERT(value.isObject());
+  if (value.length() == 0) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    {
+      VPackObjectBuilder guard(b.get());
     }
+    return AqlValue$(b.get());
   }
 
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-  }
-
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
   {
     VPackArrayBuilder guard(b.get());
-    for (auto const& it : values) {
-      if (it.second == n) {
-        b->add(it.first);
+    for (auto const& entry : VPackObjectIterator(value)) {
+      if (!entry.key.isString()) {
+        // somehow invalid
+        continue;
+      }
+      if (removeInternal && entry.key.copyString().at(0) == '_') {
+        // skip attribute
+        continue;
       }
+      b->add(entry.value);
     }
   }
-  values.clear();
-
-  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-  }
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function NEIGHBORS
+/// @brief function MIN
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Neighbors(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              FunctionParameters const& parameters) {
+AqlValue Functions::Min(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(NeighborsVPack(query, trx, tmp));
+  return AqlValue(MinVPack(query, trx, tmp));
 #else
-  size_t const n = parameters.size();
-  arangodb::traverser::NeighborsOptions opts;
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (n < 4 || n > 6) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "NEIGHBORS", (int)4,
-        (int)6);
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "MIN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
   }
 
-  auto resolver = trx->resolver();
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
+  TRI_json_t const* minValue = nullptr;
 
-  Json vertexCol = ExtractFunctionParameter(trx, parameters, 0, false);
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(
+        TRI_AtVector(&valueJson->_value._objects, i));
 
-  if (!vertexCol.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    if (TRI_IsNullJson(value)) {
+      continue;
+    }
+
+    if (minValue == nullptr || TRI_CompareValuesJson(value, minValue) < 0) {
+      minValue = value;
+    }
   }
-  std::string vColName =
-      basics::JsonHelper::getStringValue(vertexCol.json(), "");
 
-  Json edgeCol = ExtractFunctionParameter(trx, parameters, 1, false);
+  if (minValue != nullptr) {
+    std::unique_ptr<TRI_json_t> result(SafeCopyJson(minValue));
 
-  if (!edgeCol.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    if (result != nullptr) {
+      auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+      result.release();
+      return AqlValue(jr);
+    }
   }
-  std::string eColName = basics::JsonHelper::getStringValue(edgeCol.json(), "");
-
-  Json vertexInfo = ExtractFunctionParameter(trx, parameters, 2, false);
-  std::string vertexId;
-  if (vertexInfo.isString()) {
-    vertexId = basics::JsonHelper::getStringValue(vertexInfo.json(), "");
-    if (vertexId.find("/") != std::string::npos) {
-      size_t split;
-      char const* str = vertexId.c_str();
 
-      if (!TRI_ValidateDocumentIdKeyGenerator(str, &split)) {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD);
-      }
+  return AqlValue(new Json(Json::Null));
+#endif
+}
 
-      std::string const collectionName = vertexId.substr(0, split);
-      if (collectionName.compare(vColName) != 0) {
-        THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_GRAPH_INVALID_PARAMETER,
-                                      "specified vertex collection '%s' does "
-                                      "not match start vertex collection '%s'",
-                                      vColName.c_str(), collectionName.c_str());
-      }
-      auto coli = resolver->getCollectionStruct(collectionName);
+AqlValue$ Functions::MinVPack(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              VPackFunctionParameters const& parameters) {
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-      if (coli == nullptr) {
-        THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
-                                      "'%s'", collectionName.c_str());
-      }
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "MIN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
 
-      VertexId v(coli->_cid, const_cast<char*>(str + split + 1));
-      opts.start = v;
-    } else {
-      VertexId v(resolver->getCollectionId(vColName), vertexId.c_str());
-      opts.start = v;
-    }
-  } else if (vertexInfo.isObject()) {
-    if (!vertexInfo.has("_id")) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  VPackSlice minValue;
+  for (auto const& it : VPackArrayIterator(value)) {
+    if (it.isNull()) {
+      continue;
     }
-    vertexId =
-        basics::JsonHelper::getStringValue(vertexInfo.get("_id").json(), "");
-    size_t split;
-    char const* str = vertexId.c_str();
-
-    if (!TRI_ValidateDocumentIdKeyGenerator(str, &split)) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD);
+    if (minValue.isNone() || arangodb::basics::VelocyPackHelper::compare(it, minValue, true) < 0) {
+      minValue = it;
     }
+  }
+  if (minValue.isNone()) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+  return AqlValue$(minValue);
+}
 
-    std::string const collectionName = vertexId.substr(0, split);
-    if (collectionName.compare(vColName) != 0) {
-      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_GRAPH_INVALID_PARAMETER,
-                                    "specified vertex collection '%s' does not "
-                                    "match start vertex collection '%s'",
-                                    vColName.c_str(), collectionName.c_str());
-    }
-    auto coli = resolver->getCollectionStruct(collectionName);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MAX
+////////////////////////////////////////////////////////////////////////////////
 
-    if (coli == nullptr) {
-      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
-                                    "'%s'", collectionName.c_str());
-    }
+AqlValue Functions::Max(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(MaxVPack(query, trx, tmp));
+#else
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-    VertexId v(coli->_cid, const_cast<char*>(str + split + 1));
-    opts.start = v;
-  } else {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "MAX", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
   }
 
-  Json direction = ExtractFunctionParameter(trx, parameters, 3, false);
-  if (direction.isString()) {
-    std::string const dir =
-        basics::JsonHelper::getStringValue(direction.json(), "");
-    if (dir.compare("outbound") == 0) {
-      opts.direction = TRI_EDGE_OUT;
-    } else if (dir.compare("inbound") == 0) {
-      opts.direction = TRI_EDGE_IN;
-    } else if (dir.compare("any") == 0) {
-      opts.direction = TRI_EDGE_ANY;
-    } else {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
-    }
-  } else {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
-  }
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
+  TRI_json_t const* maxValue = nullptr;
+  ;
 
-  bool includeData = false;
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(
+        TRI_AtVector(&valueJson->_value._objects, i));
 
-  if (n > 5) {
-    auto options = ExtractFunctionParameter(trx, parameters, 5, false);
-    if (!options.isObject()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    if (TRI_IsNullJson(value)) {
+      continue;
     }
-    includeData = basics::JsonHelper::getBooleanValue(options.json(),
-                                                      "includeData", false);
-    opts.minDepth = basics::JsonHelper::getNumericValue<uint64_t>(
-        options.json(), "minDepth", 1);
-    if (opts.minDepth == 0) {
-      opts.maxDepth = basics::JsonHelper::getNumericValue<uint64_t>(
-          options.json(), "maxDepth", 1);
-    } else {
-      opts.maxDepth = basics::JsonHelper::getNumericValue<uint64_t>(
-          options.json(), "maxDepth", opts.minDepth);
+
+    if (maxValue == nullptr || TRI_CompareValuesJson(value, maxValue) > 0) {
+      maxValue = value;
     }
   }
 
-  TRI_voc_cid_t eCid = resolver->getCollectionId(eColName);
-
-  {
-    // ensure the collection is loaded
-    auto collection = trx->trxCollection(eCid);
-
-    if (collection == nullptr) {
-      int res = TRI_AddCollectionTransaction(trx->getInternals(), eCid,
-                                             TRI_TRANSACTION_READ,
-                                             trx->nestingLevel(), true, true);
-      if (res != TRI_ERROR_NO_ERROR) {
-        THROW_ARANGO_EXCEPTION(res);
-      }
-
-      TRI_EnsureCollectionsTransaction(trx->getInternals());
-      collection = trx->trxCollection(eCid);
+  if (maxValue != nullptr) {
+    std::unique_ptr<TRI_json_t> result(SafeCopyJson(maxValue));
 
-      if (collection == nullptr) {
-        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
-                                       "collection is a nullptr");
-      }
+    if (result != nullptr) {
+      auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+      result.release();
+      return AqlValue(jr);
     }
   }
 
-  // Function to return constant distance
-  auto wc = [](TRI_doc_mptr_copy_t&) -> double { return 1; };
+  return AqlValue(new Json(Json::Null));
+#endif
+}
 
-  auto eci = std::make_unique<EdgeCollectionInfo>(
-      trx, eCid, trx->documentCollection(eCid), wc);
-  TRI_IF_FAILURE("EdgeCollectionInfoOOM1") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-  }
+AqlValue$ Functions::MaxVPack(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              VPackFunctionParameters const& parameters) {
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (n > 4) {
-    auto edgeExamples = ExtractFunctionParameter(trx, parameters, 4, false);
-    if (!(edgeExamples.isArray() && edgeExamples.size() == 0)) {
-      opts.addEdgeFilter(edgeExamples, eci->getShaper(), eCid, resolver);
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "MAX", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+  VPackSlice maxValue;
+  for (auto const& it : VPackArrayIterator(value)) {
+    if (maxValue.isNone() || arangodb::basics::VelocyPackHelper::compare(it, maxValue, true) > 0) {
+      maxValue = it;
     }
   }
-
-  std::vector<EdgeCollectionInfo*> edgeCollectionInfos;
-  arangodb::basics::ScopeGuard guard{[]() -> void {},
-                                     [&edgeCollectionInfos]() -> void {
-                                       for (auto& p : edgeCollectionInfos) {
-                                         delete p;
-                                       }
-                                     }};
-  edgeCollectionInfos.emplace_back(eci.get());
-  eci.release();
-  TRI_IF_FAILURE("EdgeCollectionInfoOOM2") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  if (maxValue.isNone()) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
-
-  std::unordered_set<VertexId> neighbors;
-  TRI_RunNeighborsSearch(edgeCollectionInfos, opts, neighbors);
-
-  return VertexIdsToAqlValue(trx, resolver, neighbors, includeData);
-#endif
+  return AqlValue$(maxValue);
 }
 
-AqlValue$ Functions::NeighborsVPack(arangodb::aql::Query* query,
-                                    arangodb::AqlTransaction* trx,
-                                    VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  arangodb::traverser::NeighborsOptions opts;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SUM
+////////////////////////////////////////////////////////////////////////////////
 
-  if (n < 4 || n > 6) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "NEIGHBORS", (int)4,
-        (int)6);
-  }
-
-  auto resolver = trx->resolver();
-
-  VPackSlice vertexCol = ExtractFunctionParameter(trx, parameters, 0);
-
-  if (!vertexCol.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
-  }
-  std::string vColName = vertexCol.copyString();
+AqlValue Functions::Sum(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(SumVPack(query, trx, tmp));
+#else
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  VPackSlice edgeCol = ExtractFunctionParameter(trx, parameters, 1);
-  if (!edgeCol.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "SUM", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
   }
-  std::string eColName = edgeCol.copyString();
 
-  VPackSlice vertexInfo = ExtractFunctionParameter(trx, parameters, 2);
-  std::string vertexId;
-  bool splitCollection = false;
-  if (vertexInfo.isString()) {
-    vertexId = vertexInfo.copyString();
-    if (vertexId.find("/") != std::string::npos) {
-      splitCollection = true;
-    }
-  } else if (vertexInfo.isObject()) {
-    if (!vertexInfo.hasKey("_id")) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
-    }
-    VPackSlice idSlice = vertexInfo.get("_id");
-    if (!idSlice.isString()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
-    }
-    vertexId = idSlice.copyString();
-    splitCollection = true;
-  } else {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
-  }
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
 
-  if (splitCollection) {
-    size_t split;
-    char const* str = vertexId.c_str();
+  double sum = 0.0;
 
-    if (!TRI_ValidateDocumentIdKeyGenerator(str, &split)) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD);
-    }
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(
+        TRI_AtVector(&valueJson->_value._objects, i));
 
-    std::string const collectionName = vertexId.substr(0, split);
-    if (collectionName.compare(vColName) != 0) {
-      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_GRAPH_INVALID_PARAMETER,
-                                    "specified vertex collection '%s' does "
-                                    "not match start vertex collection '%s'",
-                                    vColName.c_str(), collectionName.c_str());
+    if (TRI_IsNullJson(value)) {
+      continue;
     }
-    auto coli = resolver->getCollectionStruct(collectionName);
 
-    if (coli == nullptr) {
-      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
-                                    "'%s'", collectionName.c_str());
+    if (!TRI_IsNumberJson(value)) {
+      RegisterInvalidArgumentWarning(query, "SUM");
+      return AqlValue(new Json(Json::Null));
     }
 
-    VertexId v(coli->_cid, const_cast<char*>(str + split + 1));
-    opts.start = v;
-  } else {
-    VertexId v(resolver->getCollectionId(vColName), vertexId.c_str());
-    opts.start = v;
-  }
+    // got a numeric value
+    double const number = value->_value._number;
 
-  VPackSlice direction = ExtractFunctionParameter(trx, parameters, 3);
-  if (!direction.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
-  }
-  {
-    std::string const dir = direction.copyString();
-    if (dir.compare("outbound") == 0) {
-      opts.direction = TRI_EDGE_OUT;
-    } else if (dir.compare("inbound") == 0) {
-      opts.direction = TRI_EDGE_IN;
-    } else if (dir.compare("any") == 0) {
-      opts.direction = TRI_EDGE_ANY;
-    } else {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
+      sum += number;
     }
   }
 
-  bool includeData = false;
-
-  if (n > 5) {
-    auto options = ExtractFunctionParameter(trx, parameters, 5);
-    if (!options.isObject()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
-    }
-    includeData = arangodb::basics::VelocyPackHelper::getBooleanValue(
-        options, "includeData", false);
-    opts.minDepth =
-        arangodb::basics::VelocyPackHelper::getNumericValue<uint64_t>(
-            options, "minDepth", 1);
-    if (opts.minDepth == 0) {
-      opts.maxDepth =
-          arangodb::basics::VelocyPackHelper::getNumericValue<uint64_t>(
-              options, "maxDepth", 1);
-    } else {
-      opts.maxDepth =
-          arangodb::basics::VelocyPackHelper::getNumericValue<uint64_t>(
-              options, "maxDepth", opts.minDepth);
-    }
+  if (!std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
+    return AqlValue(new Json(sum));
   }
 
-  TRI_voc_cid_t eCid = resolver->getCollectionId(eColName);
-
-  {
-    // ensure the collection is loaded
-    auto collection = trx->trxCollection(eCid);
-
-    if (collection == nullptr) {
-      int res = TRI_AddCollectionTransaction(trx->getInternals(), eCid,
-                                             TRI_TRANSACTION_READ,
-                                             trx->nestingLevel(), true, true);
-      if (res != TRI_ERROR_NO_ERROR) {
-        THROW_ARANGO_EXCEPTION(res);
-      }
+  return AqlValue(new Json(Json::Null));
+#endif
+}
 
-      TRI_EnsureCollectionsTransaction(trx->getInternals());
-      collection = trx->trxCollection(eCid);
+AqlValue$ Functions::SumVPack(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              VPackFunctionParameters const& parameters) {
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-      if (collection == nullptr) {
-        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
-                                       "collection is a nullptr");
-      }
-    }
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "SUM", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
 
-  // Function to return constant distance
-  auto wc = [](TRI_doc_mptr_copy_t&) -> double { return 1; };
-
-  auto eci = std::make_unique<EdgeCollectionInfo>(
-      trx, eCid, trx->documentCollection(eCid), wc);
-  TRI_IF_FAILURE("EdgeCollectionInfoOOM1") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-  }
+  double sum = 0.0;
+  for (auto const& it : VPackArrayIterator(value)) {
+    if (it.isNull()) {
+      continue;
+    }
+    if (!it.isNumber()) {
+      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+      b->add(VPackValue(VPackValueType::Null));
+      return AqlValue$(b.get());
+    }
+    double const number = it.getNumericValue<double>();
 
-  if (n > 4) {
-    auto edgeExamples = ExtractFunctionParameter(trx, parameters, 4);
-    if (!(edgeExamples.isArray() && edgeExamples.length() == 0)) {
-      opts.addEdgeFilter(edgeExamples, eci->getShaper(), eCid, resolver);
+    if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
+      sum += number;
     }
   }
-
-  std::vector<EdgeCollectionInfo*> edgeCollectionInfos;
-  arangodb::basics::ScopeGuard guard{[]() -> void {},
-                                     [&edgeCollectionInfos]() -> void {
-                                       for (auto& p : edgeCollectionInfos) {
-                                         delete p;
-                                       }
-                                     }};
-  edgeCollectionInfos.emplace_back(eci.get());
-  eci.release();
-  TRI_IF_FAILURE("EdgeCollectionInfoOOM2") {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  if (!std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
+    b->add(VPackValue(sum));
+  } else {
+    b->add(VPackValue(VPackValueType::Null));
   }
-
-  std::unordered_set<VertexId> neighbors;
-  TRI_RunNeighborsSearch(edgeCollectionInfos, opts, neighbors);
-
-  return VertexIdsToAqlValueVPack(query, trx, resolver, neighbors, includeData);
+  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function NEAR
+/// @brief function AVERAGE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Near(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         FunctionParameters const& parameters) {
+AqlValue Functions::Average(arangodb::aql::Query* query,
+                            arangodb::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(NearVPack(query, trx, tmp));
+  return AqlValue(AverageVPack(query, trx, tmp));
 #else
-  size_t const n = parameters.size();
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (n < 3 || n > 5) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "NEAR", (int)3,
-        (int)5);
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
   }
 
-  auto resolver = trx->resolver();
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
+  double sum = 0.0;
+  size_t count = 0;
 
-  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(
+        TRI_AtVector(&valueJson->_value._objects, i));
 
-  if (!collectionJson.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
-  }
+    if (TRI_IsNullJson(value)) {
+      continue;
+    }
 
-  std::string colName =
-      basics::JsonHelper::getStringValue(collectionJson.json(), "");
+    if (!TRI_IsNumberJson(value)) {
+      RegisterInvalidArgumentWarning(query, "AVERAGE");
+      return AqlValue(new Json(Json::Null));
+    }
 
-  Json latitude = ExtractFunctionParameter(trx, parameters, 1, false);
-  Json longitude = ExtractFunctionParameter(trx, parameters, 2, false);
+    // got a numeric value
+    double const number = value->_value._number;
 
-  if (!latitude.isNumber() || !longitude.isNumber()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
+    if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
+      sum += number;
+      ++count;
+    }
   }
 
-  // extract limit
-  int64_t limitValue = 100;
-
-  if (n > 3) {
-    Json limit = ExtractFunctionParameter(trx, parameters, 3, false);
-
-    if (limit.isNumber()) {
-      limitValue = static_cast<int64_t>(limit.json()->_value._number);
-    } else if (!limit.isNull()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
-    }
+  if (count > 0 && !std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
+    return AqlValue(new Json(sum / static_cast<size_t>(count)));
   }
 
-  std::string attributeName;
-  if (n > 4) {
-    // have a distance attribute
-    Json distanceAttribute =
-        ExtractFunctionParameter(trx, parameters, 4, false);
+  return AqlValue(new Json(Json::Null));
+#endif
+}
 
-    if (!distanceAttribute.isNull() && !distanceAttribute.isString()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
-    }
+AqlValue$ Functions::AverageVPack(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  VPackFunctionParameters const& parameters) {
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-    if (distanceAttribute.isString()) {
-      attributeName =
-          std::string(distanceAttribute.json()->_value._string.data);
-    }
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
 
-  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
-  auto collection = trx->trxCollection(cid);
-
-  // ensure the collection is loaded
-  if (collection == nullptr) {
-    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
-                                           TRI_TRANSACTION_READ,
-                                           trx->nestingLevel(), true, true);
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
+  double sum = 0.0;
+  size_t count = 0;
+  for (auto const& v : VPackArrayIterator(value)) {
+    if (v.isNull()) {
+      continue;
+    }
+    if (!v.isNumber()) {
+      RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+      b->add(VPackValue(VPackValueType::Null));
+      return AqlValue$(b.get());
     }
 
-    TRI_EnsureCollectionsTransaction(trx->getInternals());
-    collection = trx->trxCollection(cid);
+    // got a numeric value
+    double const number = v.getNumericValue<double>();
 
-    if (collection == nullptr) {
-      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
-                                    "'%s'", colName.c_str());
+    if (!std::isnan(number) && number != HUGE_VAL && number != -HUGE_VAL) {
+      sum += number;
+      ++count;
     }
   }
 
-  auto document = trx->documentCollection(cid);
-
-  if (document == nullptr) {
-    THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND, "'%s'",
-                                  colName.c_str());
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  if (count > 0 && !std::isnan(sum) && sum != HUGE_VAL && sum != -HUGE_VAL) {
+    b->add(VPackValue(sum / static_cast<size_t>(count)));
+  } else {
+    b->add(VPackValue(VPackValueType::Null));
   }
+  return AqlValue$(b.get());
+}
 
-  arangodb::Index* index = nullptr;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MD5
+////////////////////////////////////////////////////////////////////////////////
 
-  for (auto const& idx : document->allIndexes()) {
-    if (idx->type() == arangodb::Index::TRI_IDX_TYPE_GEO1_INDEX ||
-        idx->type() == arangodb::Index::TRI_IDX_TYPE_GEO2_INDEX) {
-      index = idx;
-      break;
-    }
-  }
+AqlValue Functions::Md5(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (index == nullptr) {
-    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_GEO_INDEX_MISSING,
-                                  colName.c_str());
-  }
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  AppendAsString(buffer, value.json());
 
-  if (trx->orderDitch(collection) == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+  // create md5
+  char hash[17];
+  char* p = &hash[0];
+  size_t length;
 
-  GeoCoordinates* cors = static_cast<arangodb::GeoIndex2*>(index)->nearQuery(
-      trx, latitude.json()->_value._number, longitude.json()->_value._number,
-      limitValue);
+  arangodb::rest::SslInterface::sslMD5(buffer.c_str(), buffer.length(), p,
+                                       length);
 
-  if (cors == nullptr) {
-    Json array(Json::Array, 0);
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
-  }
+  // as hex
+  char hex[33];
+  p = &hex[0];
 
-  size_t const nCoords = cors->length;
+  arangodb::rest::SslInterface::sslHEX(hash, 16, p, length);
 
-  if (nCoords == 0) {
-    GeoIndex_CoordinatesFree(cors);
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, hex, 32));
+}
 
-    Json array(Json::Array, 0);
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
-  }
+AqlValue$ Functions::Md5VPack(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              VPackFunctionParameters const& parameters) {
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
 
-  struct geo_coordinate_distance_t {
-    geo_coordinate_distance_t(double distance, TRI_doc_mptr_t const* mptr)
-        : _distance(distance), _mptr(mptr) {}
+  AppendAsString(adapter, value);
 
-    double _distance;
-    TRI_doc_mptr_t const* _mptr;
-  };
+  // create md5
+  char hash[17];
+  char* p = &hash[0];
+  size_t length;
 
-  std::vector<geo_coordinate_distance_t> distances;
-  try {
-    distances.reserve(nCoords);
+  arangodb::rest::SslInterface::sslMD5(buffer.c_str(), buffer.length(), p,
+                                       length);
 
-    for (size_t i = 0; i < nCoords; ++i) {
-      distances.emplace_back(geo_coordinate_distance_t(
-          cors->distances[i],
-          static_cast<TRI_doc_mptr_t const*>(cors->coordinates[i].data)));
-    }
-  } catch (...) {
-    GeoIndex_CoordinatesFree(cors);
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+  // as hex
+  char hex[33];
+  p = &hex[0];
 
-  GeoIndex_CoordinatesFree(cors);
+  arangodb::rest::SslInterface::sslHEX(hash, 16, p, length);
 
-  // sort result by distance
-  std::sort(distances.begin(), distances.end(),
-            [](geo_coordinate_distance_t const& left,
-               geo_coordinate_distance_t const& right) {
-              return left._distance < right._distance;
-            });
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(std::string(hex, 32)));
+  return AqlValue$(b.get());
+}
 
-  auto shaper = collection->_collection->_collection->getShaper();
-  Json array(Json::Array, nCoords);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SHA1
+////////////////////////////////////////////////////////////////////////////////
 
-  for (auto& it : distances) {
-    auto j = ExpandShapedJson(shaper, resolver, cid, it._mptr);
+AqlValue Functions::Sha1(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(Sha1VPack(query, trx, tmp));
+#else
+  auto value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-    if (!attributeName.empty()) {
-      j.unset(attributeName);
-      j.set(attributeName, Json(it._distance));
-    }
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  AppendAsString(buffer, value.json());
 
-    array.add(j);
-  }
+  // create sha1
+  char hash[21];
+  char* p = &hash[0];
+  size_t length;
 
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+  arangodb::rest::SslInterface::sslSHA1(buffer.c_str(), buffer.length(), p,
+                                        length);
+
+  // as hex
+  char hex[41];
+  p = &hex[0];
+
+  arangodb::rest::SslInterface::sslHEX(hash, 20, p, length);
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, hex, 40));
 #endif
 }
 
-AqlValue$ Functions::NearVPack(arangodb::aql::Query* query,
+AqlValue$ Functions::Sha1VPack(arangodb::aql::Query* query,
                                arangodb::AqlTransaction* trx,
                                VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
+  auto value = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (n < 3 || n > 5) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "NEAR", (int)3,
-        (int)5);
-  }
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
 
-  auto resolver = trx->resolver();
+  AppendAsString(adapter, value);
 
-  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
-  if (!collectionSlice.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
-  }
+  // create sha1
+  char hash[21];
+  char* p = &hash[0];
+  size_t length;
 
-  std::string colName = collectionSlice.copyString();
+  arangodb::rest::SslInterface::sslSHA1(buffer.c_str(), buffer.length(), p,
+                                        length);
 
-  VPackSlice latitude = ExtractFunctionParameter(trx, parameters, 1);
-  VPackSlice longitude = ExtractFunctionParameter(trx, parameters, 2);
+  // as hex
+  char hex[41];
+  p = &hex[0];
 
-  if (!latitude.isNumber() || !longitude.isNumber()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
-  }
-
-  // extract limit
-  int64_t limitValue = 100;
-
-  if (n > 3) {
-    VPackSlice limit = ExtractFunctionParameter(trx, parameters, 3);
-
-    if (limit.isNumber()) {
-      limitValue = limit.getNumericValue<int64_t>();
-    } else if (!limit.isNull()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
-    }
-  }
-
-  std::string attributeName;
-  if (n > 4) {
-    // have a distance attribute
-    VPackSlice distanceAttribute = ExtractFunctionParameter(trx, parameters, 4);
-
-    if (!distanceAttribute.isNull() && !distanceAttribute.isString()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
-    }
-
-    if (distanceAttribute.isString()) {
-      attributeName = distanceAttribute.copyString();
-    }
-  }
-
-  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
-  VocShaper* shaper = nullptr;
-  arangodb::Index* index = getGeoIndex(trx, cid, colName, shaper);
-
-  TRI_ASSERT(index != nullptr);
-  TRI_ASSERT(shaper != nullptr);
-
-  GeoCoordinates* cors = static_cast<arangodb::GeoIndex2*>(index)->nearQuery(
-      trx, latitude.getNumericValue<double>(),
-      longitude.getNumericValue<double>(), limitValue);
+  arangodb::rest::SslInterface::sslHEX(hash, 20, p, length);
 
-  return buildGeoResult(query, cors, shaper, resolver, cid, attributeName);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(std::string(hex, 40)));
+  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function WITHIN
+/// @brief function UNIQUE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Within(arangodb::aql::Query* query,
+AqlValue Functions::Unique(arangodb::aql::Query* query,
                            arangodb::AqlTransaction* trx,
                            FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(WithinVPack(query, trx, tmp));
+  return AqlValue(UniqueVPack(query, trx, tmp));
 #else
-  size_t const n = parameters.size();
-
-  if (n < 4 || n > 5) {
+  if (parameters.size() != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "WITHIN", (int)4,
-        (int)5);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNIQUE", (int)1,
+        (int)1);
   }
 
-  auto resolver = trx->resolver();
-
-  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (!collectionJson.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "UNIQUE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
   }
 
-  std::string colName =
-      basics::JsonHelper::getStringValue(collectionJson.json(), "");
-
-  Json latitude = ExtractFunctionParameter(trx, parameters, 1, false);
-  Json longitude = ExtractFunctionParameter(trx, parameters, 2, false);
-  Json radius = ExtractFunctionParameter(trx, parameters, 3, false);
+  std::unordered_set<TRI_json_t const*, arangodb::basics::JsonHash,
+                     arangodb::basics::JsonEqual>
+      values(512, arangodb::basics::JsonHash(), arangodb::basics::JsonEqual());
 
-  if (!latitude.isNumber() || !longitude.isNumber() || !radius.isNumber()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
-  }
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
 
-  std::string attributeName;
-  if (n > 4) {
-    // have a distance attribute
-    Json distanceAttribute =
-        ExtractFunctionParameter(trx, parameters, 4, false);
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(
+        TRI_AddressVector(&valueJson->_value._objects, i));
 
-    if (!distanceAttribute.isNull() && !distanceAttribute.isString()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
+    if (value == nullptr) {
+      continue;
     }
 
-    if (distanceAttribute.isString()) {
-      attributeName =
-          std::string(distanceAttribute.json()->_value._string.data);
-    }
+    values.emplace(value);
   }
 
-  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
-  auto collection = trx->trxCollection(cid);
-
-  // ensure the collection is loaded
-  if (collection == nullptr) {
-    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
-                                           TRI_TRANSACTION_READ,
-                                           trx->nestingLevel(), true, true);
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
-    }
+  std::unique_ptr<TRI_json_t> result(
+      TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, values.size()));
 
-    TRI_EnsureCollectionsTransaction(trx->getInternals());
-    collection = trx->trxCollection(cid);
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
 
-    if (collection == nullptr) {
-      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
-                                    "'%s'", colName.c_str());
-    }
+  for (auto const& it : values) {
+    auto copy = SafeCopyJson(it);
+    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
   }
 
-  auto document = trx->documentCollection(cid);
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+#endif
+}
 
-  if (document == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
+AqlValue$ Functions::UniqueVPack(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 VPackFunctionParameters const& parameters) {
+  if (parameters.size() != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNIQUE", (int)1,
+        (int)1);
   }
 
-  arangodb::Index* index = nullptr;
+  auto const value = ExtractFunctionParameter(trx, parameters, 0);
 
-  for (auto const& idx : document->allIndexes()) {
-    if (idx->type() == arangodb::Index::TRI_IDX_TYPE_GEO1_INDEX ||
-        idx->type() == arangodb::Index::TRI_IDX_TYPE_GEO2_INDEX) {
-      index = idx;
-      break;
-    }
+  if (!value.isArray()) {
+    // not an array
+    RegisterWarning(query, "UNIQUE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
 
-  if (index == nullptr) {
-    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_GEO_INDEX_MISSING,
-                                  colName.c_str());
+  std::unordered_set<VPackSlice,
+                     arangodb::basics::VelocyPackHelper::VPackHash,
+                     arangodb::basics::VelocyPackHelper::VPackEqual>
+      values(512, arangodb::basics::VelocyPackHelper::VPackHash(),
+             arangodb::basics::VelocyPackHelper::VPackEqual());
+
+  for (auto const& s : VPackArrayIterator(value)) {
+    if (!s.isNone()) {
+      values.emplace(s);
+    }
   }
 
-  if (trx->orderDitch(collection) == nullptr) {
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  try {
+    VPackArrayBuilder guard(b.get());
+    for (auto const& it : values) {
+      b->add(it);
+    }
+  } catch (...) {
     THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
+  return AqlValue$(b.get());
+}
 
-  GeoCoordinates* cors = static_cast<arangodb::GeoIndex2*>(index)->withinQuery(
-      trx, latitude.json()->_value._number, longitude.json()->_value._number,
-      radius.json()->_value._number);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SORTED_UNIQUE
+////////////////////////////////////////////////////////////////////////////////
 
-  if (cors == nullptr) {
-    Json array(Json::Array, 0);
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+AqlValue Functions::SortedUnique(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(SortedUniqueVPack(query, trx, tmp));
+#else
+  if (parameters.size() != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SORTED_UNIQUE",
+        (int)1, (int)1);
   }
 
-  size_t const nCoords = cors->length;
-
-  if (nCoords == 0) {
-    GeoIndex_CoordinatesFree(cors);
+  auto const value = ExtractFunctionParameter(trx, parameters, 0, false);
 
-    Json array(Json::Array, 0);
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+  if (!value.isArray()) {
+    // not an array
+    // this is an internal function - do NOT issue a warning here
+    return AqlValue(new Json(Json::Null));
   }
 
-  struct geo_coordinate_distance_t {
-    geo_coordinate_distance_t(double distance, TRI_doc_mptr_t const* mptr)
-        : _distance(distance), _mptr(mptr) {}
+  std::set<TRI_json_t const*, arangodb::basics::JsonLess<true>> values;
 
-    double _distance;
-    TRI_doc_mptr_t const* _mptr;
-  };
+  TRI_json_t const* valueJson = value.json();
+  size_t const n = TRI_LengthArrayJson(valueJson);
 
-  std::vector<geo_coordinate_distance_t> distances;
-  try {
-    distances.reserve(nCoords);
+  for (size_t i = 0; i < n; ++i) {
+    auto value = static_cast<TRI_json_t const*>(
+        TRI_AddressVector(&valueJson->_value._objects, i));
 
-    for (size_t i = 0; i < nCoords; ++i) {
-      distances.emplace_back(geo_coordinate_distance_t(
-          cors->distances[i],
-          static_cast<TRI_doc_mptr_t const*>(cors->coordinates[i].data)));
+    if (value == nullptr) {
+      continue;
     }
-  } catch (...) {
-    GeoIndex_CoordinatesFree(cors);
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+
+    values.insert(value);
   }
 
-  GeoIndex_CoordinatesFree(cors);
+  std::unique_ptr<TRI_json_t> result(
+      TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, values.size()));
 
-  // sort result by distance
-  std::sort(distances.begin(), distances.end(),
-            [](geo_coordinate_distance_t const& left,
-               geo_coordinate_distance_t const& right) {
-              return left._distance < right._distance;
-            });
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
 
-  auto shaper = collection->_collection->_collection->getShaper();
-  Json array(Json::Array, nCoords);
+  for (auto const& it : values) {
+    auto copy = SafeCopyJson(it);
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+#endif
+}
+
+AqlValue$ Functions::SortedUniqueVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  if (parameters.size() != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SORTED_UNIQUE",
+        (int)1, (int)1);
+  }
+
+  auto const value = ExtractFunctionParameter(trx, parameters, 0);
+
+  if (!value.isArray()) {
+    // not an array
+    // this is an internal function - do NOT issue a warning here
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  std::set<VPackSlice, arangodb::basics::VelocyPackHelper::VPackLess<true>> values;
+  for (auto const& it : VPackArrayIterator(value)) {
+    if (!it.isNone()) {
+      values.insert(it);
+    }
+  }
+
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  try {
+    VPackArrayBuilder guard(b.get());
+    for (auto const& it : values) {
+      b->add(it);
+    }
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+  return AqlValue$(b.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNION
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Union(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(UnionVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+
+  if (n < 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNION", (int)2,
+        (int)Function::MaxArguments);
+  }
+
+  std::unique_ptr<TRI_json_t> result(
+      TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, 16));
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    auto value = ExtractFunctionParameter(trx, parameters, i, false);
+
+    if (!value.isArray()) {
+      // not an array
+      RegisterInvalidArgumentWarning(query, "UNION");
+      return AqlValue(new Json(Json::Null));
+    }
+
+    TRI_json_t const* valueJson = value.json();
+    size_t const nrValues = TRI_LengthArrayJson(valueJson);
+
+    if (TRI_ReserveVector(&(result.get()->_value._objects), nrValues) !=
+        TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+
+    // this passes ownership for the JSON contens into result
+    for (size_t j = 0; j < nrValues; ++j) {
+      TRI_json_t* copy = SafeCopyJson(TRI_LookupArrayJson(valueJson, j));
+
+      TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), copy);
+
+      TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+    }
+  }
+
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+#endif
+}
+
+AqlValue$ Functions::UnionVPack(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNION", (int)2,
+        (int)Function::MaxArguments);
+  }
+
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  try {
+    VPackArrayBuilder guard(b.get());
+    for (size_t i = 0; i < n; ++i) {
+      auto value = ExtractFunctionParameter(trx, parameters, i);
+
+      if (!value.isArray()) {
+        // not an array
+        RegisterInvalidArgumentWarning(query, "UNION");
+        b->clear();
+        b->add(VPackValue(VPackValueType::Null));
+        return AqlValue$(b.get());
+      }
+
+      TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+      }
+
+      // this passes ownership for the JSON contens into result
+      for (auto const& it : VPackArrayIterator(value)) {
+        b->add(it);
+        TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+        }
+      }
+    }
+  } catch (arangodb::basics::Exception const& e) {
+    // Rethrow arangodb Errors
+    throw e;
+  } catch (std::exception const& e) {
+    // All other exceptions are OUT_OF_MEMORY
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  return AqlValue$(b.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNION_DISTINCT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::UnionDistinct(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(UnionDistinctVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+
+  if (n < 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNION_DISTINCT",
+        (int)2, (int)Function::MaxArguments);
+  }
+
+  std::unordered_set<TRI_json_t*, arangodb::basics::JsonHash,
+                     arangodb::basics::JsonEqual>
+      values(512, arangodb::basics::JsonHash(), arangodb::basics::JsonEqual());
+
+  auto freeValues = [&values]() -> void {
+    for (auto& it : values) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it);
+    }
+  };
+
+  std::unique_ptr<TRI_json_t> result;
+
+  try {
+    for (size_t i = 0; i < n; ++i) {
+      auto value = ExtractFunctionParameter(trx, parameters, i, false);
+
+      if (!value.isArray()) {
+        // not an array
+        freeValues();
+        RegisterInvalidArgumentWarning(query, "UNION_DISTINCT");
+        return AqlValue(new Json(Json::Null));
+      }
+
+      TRI_json_t const* valueJson = value.json();
+      size_t const nrValues = TRI_LengthArrayJson(valueJson);
+
+      for (size_t j = 0; j < nrValues; ++j) {
+        auto value = static_cast<TRI_json_t*>(
+            TRI_AddressVector(&valueJson->_value._objects, j));
+
+        if (values.find(value) == values.end()) {
+          std::unique_ptr<TRI_json_t> copy(SafeCopyJson(value));
+
+          if (copy == nullptr) {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+          }
+
+          TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+          }
+
+          values.emplace(copy.get());
+          copy.release();
+        }
+      }
+    }
+
+    result.reset(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, values.size()));
+
+    if (result == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+
+    for (auto const& it : values) {
+      TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), it);
+    }
+
+  } catch (...) {
+    freeValues();
+    throw;
+  }
+
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+#endif
+}
+
+AqlValue$ Functions::UnionDistinctVPack(arangodb::aql::Query* query,
+                                        arangodb::AqlTransaction* trx,
+                                        VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNION_DISTINCT",
+        (int)2, (int)Function::MaxArguments);
+  }
+
+  std::unordered_set<VPackSlice,
+                     arangodb::basics::VelocyPackHelper::VPackHash,
+                     arangodb::basics::VelocyPackHelper::VPackEqual>
+      values(512, arangodb::basics::VelocyPackHelper::VPackHash(),
+             arangodb::basics::VelocyPackHelper::VPackEqual());
+
+
+  for (size_t i = 0; i < n; ++i) {
+    auto value = ExtractFunctionParameter(trx, parameters, i);
+
+    if (!value.isArray()) {
+      // not an array
+      RegisterInvalidArgumentWarning(query, "UNION_DISTINCT");
+      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+      b->add(VPackValue(VPackValueType::Null));
+      return AqlValue$(b.get());
+    }
+
+    for (auto const& v : VPackArrayIterator(value)) {
+      if (values.find(v) == values.end()) {
+        TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+        }
+
+        values.emplace(v);
+      }
+    }
+  }
+
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  try {
+    VPackArrayBuilder guard(b.get());
+    for (auto const& it : values) {
+      b->add(it);
+    }
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  return AqlValue$(b.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function INTERSECTION
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Intersection(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(IntersectionVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+
+  if (n < 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "INTERSECTION",
+        (int)2, (int)Function::MaxArguments);
+  }
+
+  std::unordered_map<TRI_json_t*, size_t, arangodb::basics::JsonHash,
+                     arangodb::basics::JsonEqual>
+      values(512, arangodb::basics::JsonHash(), arangodb::basics::JsonEqual());
+
+  auto freeValues = [&values]() -> void {
+    for (auto& it : values) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.first);
+    }
+    values.clear();
+  };
+
+  std::unique_ptr<TRI_json_t> result;
+
+  try {
+    for (size_t i = 0; i < n; ++i) {
+      auto value = ExtractFunctionParameter(trx, parameters, i, false);
+
+      if (!value.isArray()) {
+        // not an array
+        freeValues();
+        RegisterWarning(query, "INTERSECTION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+        return AqlValue(new Json(Json::Null));
+      }
+
+      TRI_json_t const* valueJson = value.json();
+      size_t const nrValues = TRI_LengthArrayJson(valueJson);
+
+      for (size_t j = 0; j < nrValues; ++j) {
+        auto value = static_cast<TRI_json_t const*>(
+            TRI_AddressVector(&valueJson->_value._objects, j));
+
+        if (i == 0) {
+          // round one
+          std::unique_ptr<TRI_json_t> copy(SafeCopyJson(value));
+
+          TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+          }
+
+          auto r = values.emplace(copy.get(), 1);
+
+          if (r.second) {
+            // successfully inserted
+            copy.release();
+          }
+        } else {
+          // check if we have seen the same element before
+          auto it = values.find(const_cast<TRI_json_t*>(value));
+
+          if (it != values.end()) {
+            // already seen
+            TRI_ASSERT((*it).second > 0);
+            ++((*it).second);
+          }
+        }
+      }
+    }
+
+    // count how many valid we have
+    size_t total = 0;
+
+    for (auto const& it : values) {
+      if (it.second == n) {
+        ++total;
+      }
+    }
+
+    result.reset(TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE, total));
+
+    if (result == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+
+    for (auto& it : values) {
+      if (it.second == n) {
+        TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, result.get(), it.first);
+      } else {
+        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.first);
+      }
+    }
+    values.clear();
+
+  } catch (...) {
+    freeValues();
+    throw;
+  }
+
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  auto jr = new Json(TRI_UNKNOWN_MEM_ZONE, result.get());
+  result.release();
+  return AqlValue(jr);
+#endif
+}
+
+
+AqlValue$ Functions::IntersectionVPack(arangodb::aql::Query* query,
+                                       arangodb::AqlTransaction* trx,
+                                       VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "INTERSECTION",
+        (int)2, (int)Function::MaxArguments);
+  }
+
+  std::unordered_map<VPackSlice, size_t,
+                     arangodb::basics::VelocyPackHelper::VPackHash,
+                     arangodb::basics::VelocyPackHelper::VPackEqual>
+      values(512, arangodb::basics::VelocyPackHelper::VPackHash(),
+             arangodb::basics::VelocyPackHelper::VPackEqual());
+
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+
+  for (size_t i = 0; i < n; ++i) {
+    auto value = ExtractFunctionParameter(trx, parameters, i);
+
+    if (!value.isArray()) {
+      // not an array
+      RegisterWarning(query, "INTERSECTION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+      b->clear();
+      b->add(VPackValue(VPackValueType::Null));
+      return AqlValue$(b.get());
+    }
+    
+    for (auto const& it : VPackArrayIterator(value)) {
+      if (i == 0) {
+        // round one
+
+        TRI_IF_FAILURE("AqlFunctions::OutOfMemory1") {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+        }
+
+        values.emplace(it, 1);
+      } else {
+        // check if we have seen the same element before
+        auto found = values.find(it);
+        if (found != values.end()) {
+          // already seen
+          TRI_ASSERT((*found).second > 0);
+          ++(found->second);
+        }
+      }
+    }
+  }
+
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory2") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  {
+    VPackArrayBuilder guard(b.get());
+    for (auto const& it : values) {
+      if (it.second == n) {
+        b->add(it.first);
+      }
+    }
+  }
+  values.clear();
+
+  TRI_IF_FAILURE("AqlFunctions::OutOfMemory3") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+  return AqlValue$(b.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function NEIGHBORS
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Neighbors(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(NeighborsVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+  arangodb::traverser::NeighborsOptions opts;
+
+  if (n < 4 || n > 6) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "NEIGHBORS", (int)4,
+        (int)6);
+  }
+
+  auto resolver = trx->resolver();
+
+  Json vertexCol = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (!vertexCol.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  }
+  std::string vColName =
+      basics::JsonHelper::getStringValue(vertexCol.json(), "");
+
+  Json edgeCol = ExtractFunctionParameter(trx, parameters, 1, false);
+
+  if (!edgeCol.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  }
+  std::string eColName = basics::JsonHelper::getStringValue(edgeCol.json(), "");
+
+  Json vertexInfo = ExtractFunctionParameter(trx, parameters, 2, false);
+  std::string vertexId;
+  if (vertexInfo.isString()) {
+    vertexId = basics::JsonHelper::getStringValue(vertexInfo.json(), "");
+    if (vertexId.find("/") != std::string::npos) {
+      size_t split;
+      char const* str = vertexId.c_str();
+
+      if (!TRI_ValidateDocumentIdKeyGenerator(str, &split)) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD);
+      }
+
+      std::string const collectionName = vertexId.substr(0, split);
+      if (collectionName.compare(vColName) != 0) {
+        THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_GRAPH_INVALID_PARAMETER,
+                                      "specified vertex collection '%s' does "
+                                      "not match start vertex collection '%s'",
+                                      vColName.c_str(), collectionName.c_str());
+      }
+      auto coli = resolver->getCollectionStruct(collectionName);
+
+      if (coli == nullptr) {
+        THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                      "'%s'", collectionName.c_str());
+      }
+
+      VertexId v(coli->_cid, const_cast<char*>(str + split + 1));
+      opts.start = v;
+    } else {
+      VertexId v(resolver->getCollectionId(vColName), vertexId.c_str());
+      opts.start = v;
+    }
+  } else if (vertexInfo.isObject()) {
+    if (!vertexInfo.has("_id")) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    }
+    vertexId =
+        basics::JsonHelper::getStringValue(vertexInfo.get("_id").json(), "");
+    size_t split;
+    char const* str = vertexId.c_str();
+
+    if (!TRI_ValidateDocumentIdKeyGenerator(str, &split)) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD);
+    }
+
+    std::string const collectionName = vertexId.substr(0, split);
+    if (collectionName.compare(vColName) != 0) {
+      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_GRAPH_INVALID_PARAMETER,
+                                    "specified vertex collection '%s' does not "
+                                    "match start vertex collection '%s'",
+                                    vColName.c_str(), collectionName.c_str());
+    }
+    auto coli = resolver->getCollectionStruct(collectionName);
+
+    if (coli == nullptr) {
+      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                    "'%s'", collectionName.c_str());
+    }
+
+    VertexId v(coli->_cid, const_cast<char*>(str + split + 1));
+    opts.start = v;
+  } else {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  }
+
+  Json direction = ExtractFunctionParameter(trx, parameters, 3, false);
+  if (direction.isString()) {
+    std::string const dir =
+        basics::JsonHelper::getStringValue(direction.json(), "");
+    if (dir.compare("outbound") == 0) {
+      opts.direction = TRI_EDGE_OUT;
+    } else if (dir.compare("inbound") == 0) {
+      opts.direction = TRI_EDGE_IN;
+    } else if (dir.compare("any") == 0) {
+      opts.direction = TRI_EDGE_ANY;
+    } else {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    }
+  } else {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  }
+
+  bool includeData = false;
+
+  if (n > 5) {
+    auto options = ExtractFunctionParameter(trx, parameters, 5, false);
+    if (!options.isObject()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    }
+    includeData = basics::JsonHelper::getBooleanValue(options.json(),
+                                                      "includeData", false);
+    opts.minDepth = basics::JsonHelper::getNumericValue<uint64_t>(
+        options.json(), "minDepth", 1);
+    if (opts.minDepth == 0) {
+      opts.maxDepth = basics::JsonHelper::getNumericValue<uint64_t>(
+          options.json(), "maxDepth", 1);
+    } else {
+      opts.maxDepth = basics::JsonHelper::getNumericValue<uint64_t>(
+          options.json(), "maxDepth", opts.minDepth);
+    }
+  }
+
+  TRI_voc_cid_t eCid = resolver->getCollectionId(eColName);
+
+  {
+    // ensure the collection is loaded
+    auto collection = trx->trxCollection(eCid);
+
+    if (collection == nullptr) {
+      int res = TRI_AddCollectionTransaction(trx->getInternals(), eCid,
+                                             TRI_TRANSACTION_READ,
+                                             trx->nestingLevel(), true, true);
+      if (res != TRI_ERROR_NO_ERROR) {
+        THROW_ARANGO_EXCEPTION(res);
+      }
+
+      TRI_EnsureCollectionsTransaction(trx->getInternals());
+      collection = trx->trxCollection(eCid);
+
+      if (collection == nullptr) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "collection is a nullptr");
+      }
+    }
+  }
+
+  // Function to return constant distance
+  auto wc = [](TRI_doc_mptr_copy_t&) -> double { return 1; };
+
+  auto eci = std::make_unique<EdgeCollectionInfo>(
+      trx, eCid, trx->documentCollection(eCid), wc);
+  TRI_IF_FAILURE("EdgeCollectionInfoOOM1") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  if (n > 4) {
+    auto edgeExamples = ExtractFunctionParameter(trx, parameters, 4, false);
+    if (!(edgeExamples.isArray() && edgeExamples.size() == 0)) {
+      opts.addEdgeFilter(edgeExamples, eci->getShaper(), eCid, resolver);
+    }
+  }
+
+  std::vector<EdgeCollectionInfo*> edgeCollectionInfos;
+  arangodb::basics::ScopeGuard guard{[]() -> void {},
+                                     [&edgeCollectionInfos]() -> void {
+                                       for (auto& p : edgeCollectionInfos) {
+                                         delete p;
+                                       }
+                                     }};
+  edgeCollectionInfos.emplace_back(eci.get());
+  eci.release();
+  TRI_IF_FAILURE("EdgeCollectionInfoOOM2") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  std::unordered_set<VertexId> neighbors;
+  TRI_RunNeighborsSearch(edgeCollectionInfos, opts, neighbors);
+
+  return VertexIdsToAqlValue(trx, resolver, neighbors, includeData);
+#endif
+}
+
+AqlValue$ Functions::NeighborsVPack(arangodb::aql::Query* query,
+                                    arangodb::AqlTransaction* trx,
+                                    VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+  arangodb::traverser::NeighborsOptions opts;
+
+  if (n < 4 || n > 6) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "NEIGHBORS", (int)4,
+        (int)6);
+  }
+
+  auto resolver = trx->resolver();
+
+  VPackSlice vertexCol = ExtractFunctionParameter(trx, parameters, 0);
+
+  if (!vertexCol.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  }
+  std::string vColName = vertexCol.copyString();
+
+  VPackSlice edgeCol = ExtractFunctionParameter(trx, parameters, 1);
+  if (!edgeCol.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  }
+  std::string eColName = edgeCol.copyString();
+
+  VPackSlice vertexInfo = ExtractFunctionParameter(trx, parameters, 2);
+  std::string vertexId;
+  bool splitCollection = false;
+  if (vertexInfo.isString()) {
+    vertexId = vertexInfo.copyString();
+    if (vertexId.find("/") != std::string::npos) {
+      splitCollection = true;
+    }
+  } else if (vertexInfo.isObject()) {
+    if (!vertexInfo.hasKey("_id")) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    }
+    VPackSlice idSlice = vertexInfo.get("_id");
+    if (!idSlice.isString()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    }
+    vertexId = idSlice.copyString();
+    splitCollection = true;
+  } else {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  }
+
+  if (splitCollection) {
+    size_t split;
+    char const* str = vertexId.c_str();
+
+    if (!TRI_ValidateDocumentIdKeyGenerator(str, &split)) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_DOCUMENT_KEY_BAD);
+    }
+
+    std::string const collectionName = vertexId.substr(0, split);
+    if (collectionName.compare(vColName) != 0) {
+      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_GRAPH_INVALID_PARAMETER,
+                                    "specified vertex collection '%s' does "
+                                    "not match start vertex collection '%s'",
+                                    vColName.c_str(), collectionName.c_str());
+    }
+    auto coli = resolver->getCollectionStruct(collectionName);
+
+    if (coli == nullptr) {
+      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                    "'%s'", collectionName.c_str());
+    }
+
+    VertexId v(coli->_cid, const_cast<char*>(str + split + 1));
+    opts.start = v;
+  } else {
+    VertexId v(resolver->getCollectionId(vColName), vertexId.c_str());
+    opts.start = v;
+  }
+
+  VPackSlice direction = ExtractFunctionParameter(trx, parameters, 3);
+  if (!direction.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  }
+  {
+    std::string const dir = direction.copyString();
+    if (dir.compare("outbound") == 0) {
+      opts.direction = TRI_EDGE_OUT;
+    } else if (dir.compare("inbound") == 0) {
+      opts.direction = TRI_EDGE_IN;
+    } else if (dir.compare("any") == 0) {
+      opts.direction = TRI_EDGE_ANY;
+    } else {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    }
+  }
+
+  bool includeData = false;
+
+  if (n > 5) {
+    auto options = ExtractFunctionParameter(trx, parameters, 5);
+    if (!options.isObject()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+    }
+    includeData = arangodb::basics::VelocyPackHelper::getBooleanValue(
+        options, "includeData", false);
+    opts.minDepth =
+        arangodb::basics::VelocyPackHelper::getNumericValue<uint64_t>(
+            options, "minDepth", 1);
+    if (opts.minDepth == 0) {
+      opts.maxDepth =
+          arangodb::basics::VelocyPackHelper::getNumericValue<uint64_t>(
+              options, "maxDepth", 1);
+    } else {
+      opts.maxDepth =
+          arangodb::basics::VelocyPackHelper::getNumericValue<uint64_t>(
+              options, "maxDepth", opts.minDepth);
+    }
+  }
+
+  TRI_voc_cid_t eCid = resolver->getCollectionId(eColName);
+
+  {
+    // ensure the collection is loaded
+    auto collection = trx->trxCollection(eCid);
+
+    if (collection == nullptr) {
+      int res = TRI_AddCollectionTransaction(trx->getInternals(), eCid,
+                                             TRI_TRANSACTION_READ,
+                                             trx->nestingLevel(), true, true);
+      if (res != TRI_ERROR_NO_ERROR) {
+        THROW_ARANGO_EXCEPTION(res);
+      }
+
+      TRI_EnsureCollectionsTransaction(trx->getInternals());
+      collection = trx->trxCollection(eCid);
+
+      if (collection == nullptr) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "collection is a nullptr");
+      }
+    }
+  }
+
+  // Function to return constant distance
+  auto wc = [](TRI_doc_mptr_copy_t&) -> double { return 1; };
+
+  auto eci = std::make_unique<EdgeCollectionInfo>(
+      trx, eCid, trx->documentCollection(eCid), wc);
+  TRI_IF_FAILURE("EdgeCollectionInfoOOM1") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  if (n > 4) {
+    auto edgeExamples = ExtractFunctionParameter(trx, parameters, 4);
+    if (!(edgeExamples.isArray() && edgeExamples.length() == 0)) {
+      opts.addEdgeFilter(edgeExamples, eci->getShaper(), eCid, resolver);
+    }
+  }
+
+  std::vector<EdgeCollectionInfo*> edgeCollectionInfos;
+  arangodb::basics::ScopeGuard guard{[]() -> void {},
+                                     [&edgeCollectionInfos]() -> void {
+                                       for (auto& p : edgeCollectionInfos) {
+                                         delete p;
+                                       }
+                                     }};
+  edgeCollectionInfos.emplace_back(eci.get());
+  eci.release();
+  TRI_IF_FAILURE("EdgeCollectionInfoOOM2") {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+  }
+
+  std::unordered_set<VertexId> neighbors;
+  TRI_RunNeighborsSearch(edgeCollectionInfos, opts, neighbors);
+
+  return VertexIdsToAqlValueVPack(query, trx, resolver, neighbors, includeData);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function NEAR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Near(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(NearVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+
+  if (n < 3 || n > 5) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "NEAR", (int)3,
+        (int)5);
+  }
+
+  auto resolver = trx->resolver();
+
+  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (!collectionJson.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
+  }
+
+  std::string colName =
+      basics::JsonHelper::getStringValue(collectionJson.json(), "");
+
+  Json latitude = ExtractFunctionParameter(trx, parameters, 1, false);
+  Json longitude = ExtractFunctionParameter(trx, parameters, 2, false);
+
+  if (!latitude.isNumber() || !longitude.isNumber()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
+  }
+
+  // extract limit
+  int64_t limitValue = 100;
+
+  if (n > 3) {
+    Json limit = ExtractFunctionParameter(trx, parameters, 3, false);
+
+    if (limit.isNumber()) {
+      limitValue = static_cast<int64_t>(limit.json()->_value._number);
+    } else if (!limit.isNull()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
+    }
+  }
+
+  std::string attributeName;
+  if (n > 4) {
+    // have a distance attribute
+    Json distanceAttribute =
+        ExtractFunctionParameter(trx, parameters, 4, false);
+
+    if (!distanceAttribute.isNull() && !distanceAttribute.isString()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
+    }
+
+    if (distanceAttribute.isString()) {
+      attributeName =
+          std::string(distanceAttribute.json()->_value._string.data);
+    }
+  }
+
+  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
+  auto collection = trx->trxCollection(cid);
+
+  // ensure the collection is loaded
+  if (collection == nullptr) {
+    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
+                                           TRI_TRANSACTION_READ,
+                                           trx->nestingLevel(), true, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
+    }
+
+    TRI_EnsureCollectionsTransaction(trx->getInternals());
+    collection = trx->trxCollection(cid);
+
+    if (collection == nullptr) {
+      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                    "'%s'", colName.c_str());
+    }
+  }
+
+  auto document = trx->documentCollection(cid);
+
+  if (document == nullptr) {
+    THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND, "'%s'",
+                                  colName.c_str());
+  }
+
+  arangodb::Index* index = nullptr;
+
+  for (auto const& idx : document->allIndexes()) {
+    if (idx->type() == arangodb::Index::TRI_IDX_TYPE_GEO1_INDEX ||
+        idx->type() == arangodb::Index::TRI_IDX_TYPE_GEO2_INDEX) {
+      index = idx;
+      break;
+    }
+  }
+
+  if (index == nullptr) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_GEO_INDEX_MISSING,
+                                  colName.c_str());
+  }
+
+  if (trx->orderDitch(collection) == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  GeoCoordinates* cors = static_cast<arangodb::GeoIndex2*>(index)->nearQuery(
+      trx, latitude.json()->_value._number, longitude.json()->_value._number,
+      limitValue);
+
+  if (cors == nullptr) {
+    Json array(Json::Array, 0);
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+  }
+
+  size_t const nCoords = cors->length;
+
+  if (nCoords == 0) {
+    GeoIndex_CoordinatesFree(cors);
+
+    Json array(Json::Array, 0);
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+  }
+
+  struct geo_coordinate_distance_t {
+    geo_coordinate_distance_t(double distance, TRI_doc_mptr_t const* mptr)
+        : _distance(distance), _mptr(mptr) {}
+
+    double _distance;
+    TRI_doc_mptr_t const* _mptr;
+  };
+
+  std::vector<geo_coordinate_distance_t> distances;
+  try {
+    distances.reserve(nCoords);
+
+    for (size_t i = 0; i < nCoords; ++i) {
+      distances.emplace_back(geo_coordinate_distance_t(
+          cors->distances[i],
+          static_cast<TRI_doc_mptr_t const*>(cors->coordinates[i].data)));
+    }
+  } catch (...) {
+    GeoIndex_CoordinatesFree(cors);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  GeoIndex_CoordinatesFree(cors);
+
+  // sort result by distance
+  std::sort(distances.begin(), distances.end(),
+            [](geo_coordinate_distance_t const& left,
+               geo_coordinate_distance_t const& right) {
+              return left._distance < right._distance;
+            });
+
+  auto shaper = collection->_collection->_collection->getShaper();
+  Json array(Json::Array, nCoords);
+
+  for (auto& it : distances) {
+    auto j = ExpandShapedJson(shaper, resolver, cid, it._mptr);
+
+    if (!attributeName.empty()) {
+      j.unset(attributeName);
+      j.set(attributeName, Json(it._distance));
+    }
+
+    array.add(j);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+#endif
+}
+
+AqlValue$ Functions::NearVPack(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 3 || n > 5) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "NEAR", (int)3,
+        (int)5);
+  }
+
+  auto resolver = trx->resolver();
+
+  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
+  if (!collectionSlice.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
+  }
+
+  std::string colName = collectionSlice.copyString();
+
+  VPackSlice latitude = ExtractFunctionParameter(trx, parameters, 1);
+  VPackSlice longitude = ExtractFunctionParameter(trx, parameters, 2);
+
+  if (!latitude.isNumber() || !longitude.isNumber()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
+  }
+
+  // extract limit
+  int64_t limitValue = 100;
+
+  if (n > 3) {
+    VPackSlice limit = ExtractFunctionParameter(trx, parameters, 3);
+
+    if (limit.isNumber()) {
+      limitValue = limit.getNumericValue<int64_t>();
+    } else if (!limit.isNull()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
+    }
+  }
+
+  std::string attributeName;
+  if (n > 4) {
+    // have a distance attribute
+    VPackSlice distanceAttribute = ExtractFunctionParameter(trx, parameters, 4);
+
+    if (!distanceAttribute.isNull() && !distanceAttribute.isString()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEAR");
+    }
+
+    if (distanceAttribute.isString()) {
+      attributeName = distanceAttribute.copyString();
+    }
+  }
+
+  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
+  VocShaper* shaper = nullptr;
+  arangodb::Index* index = getGeoIndex(trx, cid, colName, shaper);
+
+  TRI_ASSERT(index != nullptr);
+  TRI_ASSERT(shaper != nullptr);
+
+  GeoCoordinates* cors = static_cast<arangodb::GeoIndex2*>(index)->nearQuery(
+      trx, latitude.getNumericValue<double>(),
+      longitude.getNumericValue<double>(), limitValue);
+
+  return buildGeoResult(query, cors, shaper, resolver, cid, attributeName);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function WITHIN
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Within(arangodb::aql::Query* query,
+                           arangodb::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(WithinVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+
+  if (n < 4 || n > 5) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "WITHIN", (int)4,
+        (int)5);
+  }
+
+  auto resolver = trx->resolver();
+
+  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (!collectionJson.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
+  }
+
+  std::string colName =
+      basics::JsonHelper::getStringValue(collectionJson.json(), "");
+
+  Json latitude = ExtractFunctionParameter(trx, parameters, 1, false);
+  Json longitude = ExtractFunctionParameter(trx, parameters, 2, false);
+  Json radius = ExtractFunctionParameter(trx, parameters, 3, false);
+
+  if (!latitude.isNumber() || !longitude.isNumber() || !radius.isNumber()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
+  }
+
+  std::string attributeName;
+  if (n > 4) {
+    // have a distance attribute
+    Json distanceAttribute =
+        ExtractFunctionParameter(trx, parameters, 4, false);
+
+    if (!distanceAttribute.isNull() && !distanceAttribute.isString()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
+    }
+
+    if (distanceAttribute.isString()) {
+      attributeName =
+          std::string(distanceAttribute.json()->_value._string.data);
+    }
+  }
+
+  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
+  auto collection = trx->trxCollection(cid);
+
+  // ensure the collection is loaded
+  if (collection == nullptr) {
+    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
+                                           TRI_TRANSACTION_READ,
+                                           trx->nestingLevel(), true, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
+    }
+
+    TRI_EnsureCollectionsTransaction(trx->getInternals());
+    collection = trx->trxCollection(cid);
+
+    if (collection == nullptr) {
+      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                    "'%s'", colName.c_str());
+    }
+  }
+
+  auto document = trx->documentCollection(cid);
+
+  if (document == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
+  }
+
+  arangodb::Index* index = nullptr;
+
+  for (auto const& idx : document->allIndexes()) {
+    if (idx->type() == arangodb::Index::TRI_IDX_TYPE_GEO1_INDEX ||
+        idx->type() == arangodb::Index::TRI_IDX_TYPE_GEO2_INDEX) {
+      index = idx;
+      break;
+    }
+  }
+
+  if (index == nullptr) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_GEO_INDEX_MISSING,
+                                  colName.c_str());
+  }
+
+  if (trx->orderDitch(collection) == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  GeoCoordinates* cors = static_cast<arangodb::GeoIndex2*>(index)->withinQuery(
+      trx, latitude.json()->_value._number, longitude.json()->_value._number,
+      radius.json()->_value._number);
+
+  if (cors == nullptr) {
+    Json array(Json::Array, 0);
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+  }
+
+  size_t const nCoords = cors->length;
+
+  if (nCoords == 0) {
+    GeoIndex_CoordinatesFree(cors);
+
+    Json array(Json::Array, 0);
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+  }
+
+  struct geo_coordinate_distance_t {
+    geo_coordinate_distance_t(double distance, TRI_doc_mptr_t const* mptr)
+        : _distance(distance), _mptr(mptr) {}
+
+    double _distance;
+    TRI_doc_mptr_t const* _mptr;
+  };
+
+  std::vector<geo_coordinate_distance_t> distances;
+  try {
+    distances.reserve(nCoords);
+
+    for (size_t i = 0; i < nCoords; ++i) {
+      distances.emplace_back(geo_coordinate_distance_t(
+          cors->distances[i],
+          static_cast<TRI_doc_mptr_t const*>(cors->coordinates[i].data)));
+    }
+  } catch (...) {
+    GeoIndex_CoordinatesFree(cors);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  GeoIndex_CoordinatesFree(cors);
+
+  // sort result by distance
+  std::sort(distances.begin(), distances.end(),
+            [](geo_coordinate_distance_t const& left,
+               geo_coordinate_distance_t const& right) {
+              return left._distance < right._distance;
+            });
+
+  auto shaper = collection->_collection->_collection->getShaper();
+  Json array(Json::Array, nCoords);
 
   for (auto& it : distances) {
     auto j = ExpandShapedJson(shaper, resolver, cid, it._mptr);
 
-    if (!attributeName.empty()) {
-      j.unset(attributeName);
-      j.set(attributeName, Json(it._distance));
+    if (!attributeName.empty()) {
+      j.unset(attributeName);
+      j.set(attributeName, Json(it._distance));
+    }
+
+    array.add(j);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+#endif
+}
+
+AqlValue$ Functions::WithinVPack(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 4 || n > 5) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "WITHIN", (int)4,
+        (int)5);
+  }
+
+  auto resolver = trx->resolver();
+
+  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
+
+  if (!collectionSlice.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
+  }
+
+  std::string colName = collectionSlice.copyString();
+
+  VPackSlice latitude = ExtractFunctionParameter(trx, parameters, 1);
+  VPackSlice longitude = ExtractFunctionParameter(trx, parameters, 2);
+  VPackSlice radius = ExtractFunctionParameter(trx, parameters, 3);
+
+  if (!latitude.isNumber() || !longitude.isNumber() || !radius.isNumber()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
+  }
+
+  std::string attributeName;
+  if (n > 4) {
+    // have a distance attribute
+    VPackSlice distanceAttribute = ExtractFunctionParameter(trx, parameters, 4);
+
+    if (!distanceAttribute.isNull() && !distanceAttribute.isString()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
+    }
+
+    if (distanceAttribute.isString()) {
+      attributeName = distanceAttribute.copyString();
+    }
+  }
+
+  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
+  VocShaper* shaper = nullptr;
+  arangodb::Index* index = getGeoIndex(trx, cid, colName, shaper);
+
+  TRI_ASSERT(index != nullptr);
+  TRI_ASSERT(shaper != nullptr);
+
+  GeoCoordinates* cors = static_cast<arangodb::GeoIndex2*>(index)->withinQuery(
+      trx, latitude.getNumericValue<double>(),
+      longitude.getNumericValue<double>(), radius.getNumericValue<double>());
+
+  return buildGeoResult(query, cors, shaper, resolver, cid, attributeName);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FLATTEN
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Flatten(arangodb::aql::Query* query,
+                            arangodb::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(FlattenVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+  if (n == 0 || n > 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FLATTEN", (int)1,
+        (int)2);
+  }
+
+  Json listJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  if (!listJson.isArray()) {
+    RegisterWarning(query, "FLATTEN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  size_t maxDepth = 1;
+  if (n == 2) {
+    Json maxDepthJson = ExtractFunctionParameter(trx, parameters, 1, false);
+    bool isValid = true;
+    double tmpMaxDepth = ValueToNumber(maxDepthJson.json(), isValid);
+    if (!isValid || tmpMaxDepth < 1) {
+      maxDepth = 1;
+    } else {
+      maxDepth = static_cast<size_t>(tmpMaxDepth);
+    }
+  }
+
+  Json result(Json::Array);
+  FlattenList(listJson.copy(), maxDepth, 0, result);
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+#endif
+}
+
+AqlValue$ Functions::FlattenVPack(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+  if (n == 0 || n > 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FLATTEN", (int)1,
+        (int)2);
+  }
+
+  VPackSlice listSlice = ExtractFunctionParameter(trx, parameters, 0);
+  if (!listSlice.isArray()) {
+    RegisterWarning(query, "FLATTEN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  size_t maxDepth = 1;
+  if (n == 2) {
+    VPackSlice maxDepthSlice = ExtractFunctionParameter(trx, parameters, 1);
+    bool isValid = true;
+    double tmpMaxDepth = ValueToNumber(maxDepthSlice, isValid);
+    if (!isValid || tmpMaxDepth < 1) {
+      maxDepth = 1;
+    } else {
+      maxDepth = static_cast<size_t>(tmpMaxDepth);
+    }
+  }
+
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  try {
+    VPackArrayBuilder guard(b.get());
+    FlattenList(listSlice, maxDepth, 0, *b);
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+  
+  return AqlValue$(b.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ZIP
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Zip(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(ZipVPack(query, trx, tmp));
+#else
+  if (parameters.size() != 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ZIP", (int)2,
+        (int)2);
+  }
+
+  Json keysJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  Json valuesJson = ExtractFunctionParameter(trx, parameters, 1, false);
+  if (!keysJson.isArray() || !valuesJson.isArray() ||
+      keysJson.size() != valuesJson.size()) {
+    RegisterWarning(query, "ZIP",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(new Json(Json::Null));
+  }
+  size_t const n = keysJson.size();
+
+  Json result(Json::Object, n);
+
+  // Buffer will temporarily hold the keys
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  for (size_t i = 0; i < n; ++i) {
+    buffer.reset();
+    AppendAsString(buffer, keysJson.at(i).json());
+    result.set(buffer.c_str(), valuesJson.at(i).copy().steal());
+  }
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+#endif
+}
+
+AqlValue$ Functions::ZipVPack(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              VPackFunctionParameters const& parameters) {
+  if (parameters.size() != 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ZIP", (int)2,
+        (int)2);
+  }
+
+  VPackSlice keysSlice = ExtractFunctionParameter(trx, parameters, 0);
+  VPackSlice valuesSlice = ExtractFunctionParameter(trx, parameters, 1);
+
+  if (!keysSlice.isArray() || !valuesSlice.isArray() ||
+      keysSlice.length() != valuesSlice.length()) {
+    RegisterWarning(query, "ZIP",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  VPackValueLength n = keysSlice.length();
+
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  try {
+    VPackObjectBuilder guard(b.get());
+
+    // Buffer will temporarily hold the keys
+    arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+    arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
+    for (VPackValueLength i = 0; i < n; ++i) {
+      buffer.reset();
+      AppendAsString(adapter, keysSlice.at(i));
+      b->add(std::string(buffer.c_str(), buffer.length()), valuesSlice.at(i));
+    }
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+  return AqlValue$(b.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function PARSE_IDENTIFIER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ParseIdentifier(arangodb::aql::Query* query,
+                                    arangodb::AqlTransaction* trx,
+                                    FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(ParseIdentifierVPack(query, trx, tmp));
+#else
+  if (parameters.size() != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PARSE_IDENTIFIER",
+        (int)1, (int)1);
+  }
+
+  Json value = ExtractFunctionParameter(trx, parameters, 0, false);
+  std::string identifier;
+
+  if (value.isObject() && value.has(TRI_VOC_ATTRIBUTE_ID)) {
+    identifier = arangodb::basics::JsonHelper::getStringValue(value.get(TRI_VOC_ATTRIBUTE_ID).json(), "");
+  }
+  else if (value.isString()) {
+    identifier = arangodb::basics::JsonHelper::getStringValue(value.json(), "");
+  }
+
+  if (!identifier.empty()) {
+    std::vector<std::string> parts =
+        arangodb::basics::StringUtils::split(identifier, "/");
+    if (parts.size() == 2) {
+      Json result(Json::Object, 2);
+      result.set("collection", Json(parts[0]));
+      result.set("key", Json(parts[1]));
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+    }
+  }
+
+  RegisterWarning(query, "PARSE_IDENTIFIER",
+                  TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+  return AqlValue(new Json(Json::Null));
+#endif
+}
+
+AqlValue$ Functions::ParseIdentifierVPack(arangodb::aql::Query* query,
+                                          arangodb::AqlTransaction* trx,
+                                          VPackFunctionParameters const& parameters) {
+  if (parameters.size() != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PARSE_IDENTIFIER",
+        (int)1, (int)1);
+  }
+
+  VPackSlice value = ExtractFunctionParameter(trx, parameters, 0);
+  std::string identifier;
+  if (value.isObject() && value.hasKey(TRI_VOC_ATTRIBUTE_ID)) {
+    identifier = arangodb::basics::VelocyPackHelper::getStringValue(
+        value, TRI_VOC_ATTRIBUTE_ID, "");
+  } else if (value.isString()) {
+    identifier = value.copyString();
+  }
+
+  if (!identifier.empty()) {
+    std::vector<std::string> parts =
+        arangodb::basics::StringUtils::split(identifier, "/");
+    if (parts.size() == 2) {
+      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+      try {
+        VPackObjectBuilder guard(b.get());
+        b->add("collection", VPackValue(parts[0]));
+        b->add("key", VPackValue(parts[1]));
+      } catch (...) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+      return AqlValue$(b.get());
+    }
+  }
+
+  RegisterWarning(query, "PARSE_IDENTIFIER",
+                  TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(VPackValueType::Null));
+  return AqlValue$(b.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function Minus
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Minus(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(MinusVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+
+  if (n < 2) {
+    // The max number is arbitrary
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "MINUS", (int)2,
+        (int)99999);
+  }
+
+  Json baseArray = ExtractFunctionParameter(trx, parameters, 0, false);
+  std::unordered_map<std::string, size_t> contains;
+  contains.reserve(n);
+
+  if (!baseArray.isArray()) {
+    RegisterWarning(query, "MINUS",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  // Fill the original map
+  for (size_t i = 0; i < baseArray.size(); ++i) {
+    contains.emplace(baseArray.at(i).toString(), i);
+  }
+
+  // Iterate through all following parameters and delete found elements from the
+  // map
+  for (size_t k = 1; k < n; ++k) {
+    Json nextArray = ExtractFunctionParameter(trx, parameters, k, false);
+    if (!nextArray.isArray()) {
+      RegisterWarning(query, "MINUS",
+                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      return AqlValue(new Json(Json::Null));
+    }
+
+    for (size_t j = 0; j < nextArray.size(); ++j) {
+      std::string search = nextArray.at(j).toString();
+      auto find = contains.find(search);
+      if (find != contains.end()) {
+        contains.erase(find);
+      }
+    }
+  }
+
+  // We ommit the normalize part from js, cannot occur here
+  Json result(Json::Array, contains.size());
+  for (auto& it : contains) {
+    result.transfer(baseArray.at(it.second).json());
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+#endif
+}
+
+AqlValue$ Functions::MinusVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 2) {
+    // The max number is arbitrary
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "MINUS", (int)2,
+        (int)99999);
+  }
+  VPackSlice baseArray = ExtractFunctionParameter(trx, parameters, 0);
+
+  if (!baseArray.isArray()) {
+    RegisterWarning(query, "MINUS",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  std::unordered_map<std::string, size_t> contains;
+  contains.reserve(n);
+
+  // Fill the original map
+  for (size_t i = 0; i < baseArray.length(); ++i) {
+    contains.emplace(baseArray.at(i).toJson(), i);
+  }
+
+  // Iterate through all following parameters and delete found elements from the
+  // map
+  for (size_t k = 1; k < n; ++k) {
+    VPackSlice nextArray = ExtractFunctionParameter(trx, parameters, k);
+    if (!nextArray.isArray()) {
+      RegisterWarning(query, "MINUS",
+                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+      b->add(VPackValue(VPackValueType::Null));
+      return AqlValue$(b.get());
+    }
+
+    for (auto const& searchSlice : VPackArrayIterator(nextArray)) {
+      std::string search = searchSlice.toJson();
+      auto find = contains.find(search);
+      if (find != contains.end()) {
+        contains.erase(find);
+      }
+    }
+  }
+
+  // We ommit the normalize part from js, cannot occur here
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  try {
+    VPackArrayBuilder guard(b.get());
+    for (auto const& it : contains) {
+      b->add(baseArray.at(it.second));
+    }
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+  return AqlValue$(b.get());
+}
+
+static void RegisterCollectionInTransaction(
+    arangodb::AqlTransaction* trx, std::string const& collectionName,
+    TRI_voc_cid_t& cid, TRI_transaction_collection_t*& collection) {
+  TRI_ASSERT(collection == nullptr);
+  cid = trx->resolver()->getCollectionId(collectionName);
+  if (cid == 0) {
+    THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND, "'%s'",
+                                  collectionName.c_str());
+  }
+  // ensure the collection is loaded
+  collection = trx->trxCollection(cid);
+
+  if (collection == nullptr) {
+    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
+                                           TRI_TRANSACTION_READ,
+                                           trx->nestingLevel(), true, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", collectionName.c_str());
+    }
+    TRI_EnsureCollectionsTransaction(trx->getInternals());
+    collection = trx->trxCollection(cid);
+
+    if (collection == nullptr) {
+      // This case should never occur
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "could not load collection");
+    }
+  }
+  TRI_ASSERT(collection != nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Helper function to get a document by it's identifier
+///        The collection has to be locked by the transaction before
+////////////////////////////////////////////////////////////////////////////////
+
+static Json getDocumentByIdentifier(arangodb::AqlTransaction* trx,
+                                    CollectionNameResolver const* resolver,
+                                    TRI_transaction_collection_t* collection,
+                                    TRI_voc_cid_t const& cid,
+                                    std::string const& collectionName,
+                                    std::string const& identifier) {
+  std::vector<std::string> parts =
+      arangodb::basics::StringUtils::split(identifier, "/");
+
+  TRI_doc_mptr_copy_t mptr;
+  if (parts.size() == 1) {
+    int res = trx->readSingle(collection, &mptr, parts[0]);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return Json(Json::Null);
+    }
+  } else if (parts.size() == 2) {
+    if (parts[0] != collectionName) {
+      // Reqesting an _id that cannot be stored in this collection
+      return Json(Json::Null);
+    }
+    int res = trx->readSingle(collection, &mptr, parts[1]);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return Json(Json::Null);
+    }
+  } else {
+    return Json(Json::Null);
+  }
+
+  return ExpandShapedJson(collection->_collection->_collection->getShaper(),
+                          resolver, cid, &mptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Helper function to get a document by its _id
+///        This function will lazy read-lock the collection.
+/// this function will not throw if the document or the collection cannot be
+/// found
+////////////////////////////////////////////////////////////////////////////////
+
+static Json getDocumentByIdentifier(arangodb::AqlTransaction* trx,
+                                    CollectionNameResolver const* resolver,
+                                    std::string const& identifier) {
+  std::vector<std::string> parts =
+      arangodb::basics::StringUtils::split(identifier, "/");
+
+  if (parts.size() != 2) {
+    return Json(Json::Null);
+  }
+  std::string collectionName = parts[0];
+  TRI_transaction_collection_t* collection = nullptr;
+  TRI_voc_cid_t cid = 0;
+  try {
+    RegisterCollectionInTransaction(trx, collectionName, cid, collection);
+  } catch (arangodb::basics::Exception const& ex) {
+    // don't throw if collection is not found
+    if (ex.code() == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+      return Json(Json::Null);
+    }
+    throw;
+  }
+
+  TRI_doc_mptr_copy_t mptr;
+  int res = trx->readSingle(collection, &mptr, parts[1]);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return Json(Json::Null);
+  }
+
+  return ExpandShapedJson(collection->_collection->_collection->getShaper(),
+                          resolver, cid, &mptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Helper function to get a document by it's identifier
+///        The collection has to be locked by the transaction before
+////////////////////////////////////////////////////////////////////////////////
+
+static void getDocumentByIdentifier(arangodb::AqlTransaction* trx,
+                                    CollectionNameResolver const* resolver,
+                                    TRI_transaction_collection_t* collection,
+                                    TRI_voc_cid_t const& cid,
+                                    std::string const& collectionName,
+                                    std::string const& identifier,
+                                    VPackBuilder& result) {
+  std::vector<std::string> parts =
+      arangodb::basics::StringUtils::split(identifier, "/");
+
+  TRI_doc_mptr_copy_t mptr;
+  if (parts.size() == 1) {
+    int res = trx->readSingle(collection, &mptr, parts[0]);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return;
+    }
+  } else if (parts.size() == 2) {
+    if (parts[0] != collectionName) {
+      // Reqesting an _id that cannot be stored in this collection
+      return;
+    }
+    int res = trx->readSingle(collection, &mptr, parts[1]);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return;
+    }
+  } else {
+    return;
+  }
+
+  std::unordered_set<std::string> unused;
+  ExpandShapedJson(collection->_collection->_collection->getShaper(), resolver,
+                   cid, &mptr, result, false, unused);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Helper function to get a document by its _id
+///        This function will lazy read-lock the collection.
+/// this function will not throw if the document or the collection cannot be
+/// found
+////////////////////////////////////////////////////////////////////////////////
+
+static void getDocumentByIdentifier(arangodb::AqlTransaction* trx,
+                                    CollectionNameResolver const* resolver,
+                                    std::string const& identifier,
+                                    VPackBuilder& result) {
+  std::vector<std::string> parts =
+      arangodb::basics::StringUtils::split(identifier, "/");
+
+  if (parts.size() != 2) {
+    return;
+  }
+  std::string collectionName = parts[0];
+  TRI_transaction_collection_t* collection = nullptr;
+  TRI_voc_cid_t cid = 0;
+  try {
+    RegisterCollectionInTransaction(trx, collectionName, cid, collection);
+  } catch (arangodb::basics::Exception const& ex) {
+    // don't throw if collection is not found
+    if (ex.code() == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+      return;
+    }
+    throw;
+  }
+
+  TRI_doc_mptr_copy_t mptr;
+  int res = trx->readSingle(collection, &mptr, parts[1]);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return;
+  }
+
+  std::unordered_set<std::string> unused;
+  ExpandShapedJson(collection->_collection->_collection->getShaper(), resolver,
+                   cid, &mptr, result, false, unused);
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function Document
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Document(arangodb::aql::Query* query,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DocumentVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+
+  if (n < 1 || 2 < n) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "DOCUMENT", (int)1,
+        (int)2);
+  }
+
+  auto resolver = trx->resolver();
+
+  if (n == 1) {
+    Json id = ExtractFunctionParameter(trx, parameters, 0, false);
+
+    if (id.isString()) {
+      std::string identifier =
+          arangodb::basics::JsonHelper::getStringValue(id.json(), "");
+      Json result = getDocumentByIdentifier(trx, resolver, identifier);
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+    } else if (id.isArray()) {
+      size_t const n = id.size();
+      Json result(Json::Array, n);
+      for (size_t i = 0; i < n; ++i) {
+        Json next = id.at(i);
+        try {
+          if (next.isString()) {
+            std::string identifier =
+                arangodb::basics::JsonHelper::getStringValue(next.json(), "");
+            Json tmp = getDocumentByIdentifier(trx, resolver, identifier);
+            if (!tmp.isNull()) {
+              result.add(tmp);
+            }
+          }
+        } catch (arangodb::basics::Exception const&) {
+          // Ignore all ArangoDB exceptions here
+        }
+      }
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+    }
+    return AqlValue(new Json(Json::Null));
+  }
+
+  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  if (!collectionJson.isString()) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+  }
+  std::string collectionName =
+      arangodb::basics::JsonHelper::getStringValue(collectionJson.json(), "");
+
+  TRI_transaction_collection_t* collection = nullptr;
+  TRI_voc_cid_t cid;
+  bool notFound = false;
+
+  try {
+    RegisterCollectionInTransaction(trx, collectionName, cid, collection);
+  } catch (arangodb::basics::Exception const& ex) {
+    // don't throw if collection is not found
+    if (ex.code() != TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+      throw;
+    }
+    notFound = true;
+  }
+
+  Json id = ExtractFunctionParameter(trx, parameters, 1, false);
+  if (id.isString()) {
+    if (notFound) {
+      return AqlValue(new Json(Json::Null));
+    }
+    std::string identifier =
+        arangodb::basics::JsonHelper::getStringValue(id.json(), "");
+    Json result = getDocumentByIdentifier(trx, resolver, collection, cid,
+                                          collectionName, identifier);
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  } else if (id.isArray()) {
+    if (notFound) {
+      return AqlValue(new Json(Json::Array));
+    }
+    size_t const n = id.size();
+    Json result(Json::Array, n);
+    for (size_t i = 0; i < n; ++i) {
+      Json next = id.at(i);
+      try {
+        if (next.isString()) {
+          std::string identifier =
+              arangodb::basics::JsonHelper::getStringValue(next.json(), "");
+          Json tmp = getDocumentByIdentifier(trx, resolver, collection, cid,
+                                             collectionName, identifier);
+          if (!tmp.isNull()) {
+            result.add(tmp);
+          }
+        }
+      } catch (arangodb::basics::Exception const&) {
+        // Ignore all ArangoDB exceptions here
+      }
+    }
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  }
+  // Id has invalid format
+  return AqlValue(new Json(Json::Null));
+#endif
+}
+
+AqlValue$ Functions::DocumentVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 1 || 2 < n) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "DOCUMENT", (int)1,
+        (int)2);
+  }
+
+  auto resolver = trx->resolver();
+  if (n == 1) {
+    VPackSlice id = ExtractFunctionParameter(trx, parameters, 0);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    if (id.isString()) {
+      std::string identifier = id.copyString();
+      getDocumentByIdentifier(trx, resolver, identifier, *b);
+      if (b->isEmpty()) {
+        // not found
+        b->add(VPackValue(VPackValueType::Null));
+      }
+    } else if (id.isArray()) {
+      VPackArrayBuilder guard(b.get());
+      for (auto const& next : VPackArrayIterator(id)) {
+        try {
+          if (next.isString()) {
+            std::string identifier = next.copyString();
+            getDocumentByIdentifier(trx, resolver, identifier, *b);
+          }
+        } catch (arangodb::basics::Exception const&) {
+          // Ignore all ArangoDB exceptions here
+        }
+      }
+    } else {
+      b->add(VPackValue(VPackValueType::Null));
+    }
+    return AqlValue$(b.get());
+  }
+
+  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
+  if (!collectionSlice.isString()) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+  }
+  std::string collectionName = collectionSlice.copyString();
+
+  TRI_transaction_collection_t* collection = nullptr;
+  TRI_voc_cid_t cid;
+  bool notFound = false;
+
+  try {
+    RegisterCollectionInTransaction(trx, collectionName, cid, collection);
+  } catch (arangodb::basics::Exception const& ex) {
+    // don't throw if collection is not found
+    if (ex.code() != TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+      throw;
+    }
+    notFound = true;
+  }
+
+  VPackSlice id = ExtractFunctionParameter(trx, parameters, 1);
+  if (id.isString()) {
+    if (notFound) {
+      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+      b->add(VPackValue(VPackValueType::Null));
+      return AqlValue$(b.get());
+    }
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    std::string identifier = id.copyString();
+    getDocumentByIdentifier(trx, resolver, collection, cid, collectionName, identifier, *b);
+    if (b->isEmpty()) {
+      b->add(VPackValue(VPackValueType::Null));
+    }
+    return AqlValue$(b.get());
+  } else if (id.isArray()) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    {
+      VPackArrayBuilder guard(b.get());
+      if (!notFound) {
+        for (auto const& next : VPackArrayIterator(id)) {
+          try {
+            if (next.isString()) {
+              std::string identifier = next.copyString();
+              getDocumentByIdentifier(trx, resolver, collection, cid, collectionName, identifier, *b);
+            }
+          } catch (arangodb::basics::Exception const&) {
+            // Ignore all ArangoDB exceptions here
+          }
+        }
+      }
+    }
+    return AqlValue$(b.get());
+  }
+  // Id has invalid format
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(VPackValueType::Null));
+  return AqlValue$(b.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function Edges
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Edges(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(EdgesVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+
+  if (n < 3 || 5 < n) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "EDGES", (int)3,
+        (int)5);
+  }
+
+  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  if (!collectionJson.isString()) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+  }
+  std::string collectionName =
+      arangodb::basics::JsonHelper::getStringValue(collectionJson.json(), "");
+
+  TRI_transaction_collection_t* collection = nullptr;
+  TRI_voc_cid_t cid;
+  RegisterCollectionInTransaction(trx, collectionName, cid, collection);
+  if (collection->_collection->_type != TRI_COL_TYPE_EDGE) {
+    RegisterWarning(query, "EDGES", TRI_ERROR_ARANGO_COLLECTION_TYPE_INVALID);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  Json vertexJson = ExtractFunctionParameter(trx, parameters, 1, false);
+  if (!vertexJson.isArray() && !vertexJson.isString() &&
+      !vertexJson.isObject()) {
+    // Invalid Start vertex
+    // Early Abort before parsing other parameters
+    return AqlValue(new Json(Json::Null));
+  }
+
+  Json directionJson = ExtractFunctionParameter(trx, parameters, 2, false);
+  if (!directionJson.isString()) {
+    RegisterWarning(query, "EDGES",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(new Json(Json::Null));
+  }
+  std::string dirString =
+      basics::JsonHelper::getStringValue(directionJson.json(), "");
+  // transform String to lower case
+  std::transform(dirString.begin(), dirString.end(), dirString.begin(),
+                 ::tolower);
+
+  TRI_edge_direction_e direction;
+
+  if (dirString == "inbound") {
+    direction = TRI_EDGE_IN;
+  } else if (dirString == "outbound") {
+    direction = TRI_EDGE_OUT;
+  } else if (dirString == "any") {
+    direction = TRI_EDGE_ANY;
+  } else {
+    RegisterWarning(query, "EDGES",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(new Json(Json::Null));
+  }
+  auto resolver = trx->resolver();
+
+  auto shaper = collection->_collection->_collection->getShaper();
+  std::unique_ptr<arangodb::ExampleMatcher> matcher;
+  if (n > 3) {
+    // We might have examples
+    Json exampleJson = ExtractFunctionParameter(trx, parameters, 3, false);
+    if (!exampleJson.isNull()) {
+      bool buildMatcher = false;
+      if (exampleJson.isArray()) {
+        size_t exampleCount = exampleJson.size();
+        // We only support objects here so validate
+        for (size_t k = 0; k < exampleCount; /* nothing */) {
+          if (exampleJson.at(k).isObject()) {
+            ++k;
+            continue;
+          }
+
+          RegisterWarning(query, "EDGES",
+                          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+          if (TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, exampleJson.json(),
+                                  k)) {
+            // don't modify count
+            --exampleCount;
+          } else {
+            // Should never occur.
+            // If it occurs in production it will simply fall through
+            // it can only return more results than expected and not do any
+            // harm.
+            TRI_ASSERT(false);
+            ++k;
+          }
+        }
+        if (exampleCount > 0) {
+          buildMatcher = true;
+        }
+        // else we do not filter at all
+      } else if (exampleJson.isObject()) {
+        buildMatcher = true;
+      } else {
+        RegisterWarning(query, "EDGES",
+                        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      }
+      if (buildMatcher) {
+        try {
+          matcher.reset(new arangodb::ExampleMatcher(exampleJson.json(), shaper,
+                                                     resolver));
+        } catch (arangodb::basics::Exception const& e) {
+          if (e.code() != TRI_RESULT_ELEMENT_NOT_FOUND) {
+            throw;
+          }
+          // We can never fulfill this filter!
+          // RETURN empty Array
+          Json result(Json::Array, 0);
+          return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+        }
+      }
+    }
+  }
+
+  bool includeVertices = false;
+  if (n == 5) {
+    // We have options
+    Json options = ExtractFunctionParameter(trx, parameters, 4, false);
+    if (options.isObject() && options.has("includeVertices")) {
+      includeVertices = arangodb::basics::JsonHelper::getBooleanValue(
+          options.json(), "includeVertices", false);
+    }
+  }
+
+  Json result(Json::Array, 0);
+  if (vertexJson.isArray()) {
+    size_t length = vertexJson.size();
+    for (size_t i = 0; i < length; ++i) {
+      try {
+        RequestEdges(vertexJson.at(i), trx, resolver, shaper, cid,
+                     collection->_collection->_collection, direction,
+                     matcher.get(), includeVertices, result);
+      } catch (...) {
+        // Errors in Array are simply ignored
+      }
+    }
+  } else {
+    RequestEdges(vertexJson, trx, resolver, shaper, cid,
+                 collection->_collection->_collection, direction, matcher.get(),
+                 includeVertices, result);
+  }
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+#endif
+}
+
+AqlValue$ Functions::EdgesVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+
+  if (n < 3 || 5 < n) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "EDGES", (int)3,
+        (int)5);
+  }
+
+  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
+  if (!collectionSlice.isString()) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+  }
+  std::string collectionName = collectionSlice.copyString();
+
+  TRI_transaction_collection_t* collection = nullptr;
+  TRI_voc_cid_t cid;
+  RegisterCollectionInTransaction(trx, collectionName, cid, collection);
+  if (collection->_collection->_type != TRI_COL_TYPE_EDGE) {
+    RegisterWarning(query, "EDGES", TRI_ERROR_ARANGO_COLLECTION_TYPE_INVALID);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  VPackSlice vertexSlice = ExtractFunctionParameter(trx, parameters, 1);
+  if (!vertexSlice.isArray() && !vertexSlice.isString() && !vertexSlice.isObject()) {
+    // Invalid Start vertex
+    // Early Abort before parsing other parameters
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  VPackSlice directionSlice = ExtractFunctionParameter(trx, parameters, 2);
+  if (!directionSlice.isString()) {
+    RegisterWarning(query, "EDGES",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+  std::string dirString = directionSlice.copyString();
+  // transform String to lower case
+  std::transform(dirString.begin(), dirString.end(), dirString.begin(),
+                 ::tolower);
+
+  TRI_edge_direction_e direction;
+
+  if (dirString == "inbound") {
+    direction = TRI_EDGE_IN;
+  } else if (dirString == "outbound") {
+    direction = TRI_EDGE_OUT;
+  } else if (dirString == "any") {
+    direction = TRI_EDGE_ANY;
+  } else {
+    RegisterWarning(query, "EDGES",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  auto resolver = trx->resolver();
+
+  auto shaper = collection->_collection->_collection->getShaper();
+  std::unique_ptr<arangodb::ExampleMatcher> matcher;
+
+  if (n > 3) {
+    // We might have examples
+    VPackSlice exampleSlice = ExtractFunctionParameter(trx, parameters, 3);
+    if ((exampleSlice.isArray() && exampleSlice.length() != 0)|| exampleSlice.isObject()) {
+      try {
+        matcher.reset(
+            new arangodb::ExampleMatcher(exampleSlice, shaper, resolver, false));
+      } catch (arangodb::basics::Exception const& e) {
+        if (e.code() != TRI_RESULT_ELEMENT_NOT_FOUND) {
+          throw;
+        }
+        // We can never fulfill this filter!
+        // RETURN empty Array
+        std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+        {
+          VPackArrayBuilder guard(b.get());
+        }
+        return AqlValue$(b.get());
+      }
+    }
+  }
+
+  bool includeVertices = false;
+
+  if (n == 5) {
+    // We have options
+    VPackSlice options = ExtractFunctionParameter(trx, parameters, 4);
+    if (options.isObject()) {
+      includeVertices = arangodb::basics::VelocyPackHelper::getBooleanValue(
+          options, "includeVertices", false);
+    }
+  }
+
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  {
+    VPackArrayBuilder guard(b.get());
+    if (vertexSlice.isArray()) {
+      for (auto const& v : VPackArrayIterator(vertexSlice)) {
+        try {
+          RequestEdges(v, trx, resolver, shaper, cid,
+                       collection->_collection->_collection, direction,
+                       matcher.get(), includeVertices, *b);
+        } catch (...) {
+          // Errors in Array are simply ignored
+        }
+      }
+    } else {
+      RequestEdges(vertexSlice, trx, resolver, shaper, cid,
+                   collection->_collection->_collection, direction,
+                   matcher.get(), includeVertices, *b);
     }
+  }
+  return AqlValue$(b.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ROUND
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Round(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(RoundVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
 
-    array.add(j);
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ROUND", (int)1,
+        (int)1);
   }
 
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
+  Json inputJson = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  bool unused = false;
+  double input = TRI_ToDoubleJson(inputJson.json(), unused);
+  input = floor(input + 0.5);  // Rounds down for < x.4999 and up for > x.50000
+  return AqlValue(new Json(input));
 #endif
 }
 
-AqlValue$ Functions::WithinVPack(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::RoundVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
 
-  if (n < 4 || n > 5) {
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "WITHIN", (int)4,
-        (int)5);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ROUND", (int)1,
+        (int)1);
   }
 
-  auto resolver = trx->resolver();
+  VPackSlice inputSlice = ExtractFunctionParameter(trx, parameters, 0);
 
-  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
+  bool unused = false;
+  double input = arangodb::basics::VelocyPackHelper::toDouble(inputSlice, unused);
 
-  if (!collectionSlice.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
-  }
+  input = floor(input + 0.5);  // Rounds down for < x.4999 and up for > x.50000
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(input));
+  return AqlValue$(b.get());
+}
 
-  std::string colName = collectionSlice.copyString();
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ABS
+////////////////////////////////////////////////////////////////////////////////
 
-  VPackSlice latitude = ExtractFunctionParameter(trx, parameters, 1);
-  VPackSlice longitude = ExtractFunctionParameter(trx, parameters, 2);
-  VPackSlice radius = ExtractFunctionParameter(trx, parameters, 3);
+AqlValue Functions::Abs(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(AbsVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
 
-  if (!latitude.isNumber() || !longitude.isNumber() || !radius.isNumber()) {
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ABS", (int)1,
+        (int)1);
   }
 
-  std::string attributeName;
-  if (n > 4) {
-    // have a distance attribute
-    VPackSlice distanceAttribute = ExtractFunctionParameter(trx, parameters, 4);
+  Json inputJson = ExtractFunctionParameter(trx, parameters, 0, false);
 
-    if (!distanceAttribute.isNull() && !distanceAttribute.isString()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "WITHIN");
-    }
+  bool unused = false;
+  double input = TRI_ToDoubleJson(inputJson.json(), unused);
+  input = std::abs(input);
+  return AqlValue(new Json(input));
+#endif
+}
 
-    if (distanceAttribute.isString()) {
-      attributeName = distanceAttribute.copyString();
-    }
-  }
+AqlValue$ Functions::AbsVPack(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
 
-  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
-  VocShaper* shaper = nullptr;
-  arangodb::Index* index = getGeoIndex(trx, cid, colName, shaper);
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ABS", (int)1,
+        (int)1);
+  }
 
-  TRI_ASSERT(index != nullptr);
-  TRI_ASSERT(shaper != nullptr);
+  VPackSlice inputSlice = ExtractFunctionParameter(trx, parameters, 0);
 
-  GeoCoordinates* cors = static_cast<arangodb::GeoIndex2*>(index)->withinQuery(
-      trx, latitude.getNumericValue<double>(),
-      longitude.getNumericValue<double>(), radius.getNumericValue<double>());
+  bool unused = false;
+  double input = arangodb::basics::VelocyPackHelper::toDouble(inputSlice, unused);
 
-  return buildGeoResult(query, cors, shaper, resolver, cid, attributeName);
+  input = std::abs(input);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(input));
+  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function FLATTEN
+/// @brief function CEIL
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Flatten(arangodb::aql::Query* query,
-                            arangodb::AqlTransaction* trx,
-                            FunctionParameters const& parameters) {
+AqlValue Functions::Ceil(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(FlattenVPack(query, trx, tmp));
+  return AqlValue(CeilVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-  if (n == 0 || n > 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FLATTEN", (int)1,
-        (int)2);
-  }
 
-  Json listJson = ExtractFunctionParameter(trx, parameters, 0, false);
-  if (!listJson.isArray()) {
-    RegisterWarning(query, "FLATTEN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
-  }
-
-  size_t maxDepth = 1;
-  if (n == 2) {
-    Json maxDepthJson = ExtractFunctionParameter(trx, parameters, 1, false);
-    bool isValid = true;
-    double tmpMaxDepth = ValueToNumber(maxDepthJson.json(), isValid);
-    if (!isValid || tmpMaxDepth < 1) {
-      maxDepth = 1;
-    } else {
-      maxDepth = static_cast<size_t>(tmpMaxDepth);
-    }
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "CEIL", (int)1,
+        (int)1);
   }
 
-  Json result(Json::Array);
-  FlattenList(listJson.copy(), maxDepth, 0, result);
+  Json inputJson = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  bool unused = false;
+  double input = TRI_ToDoubleJson(inputJson.json(), unused);
+  input = ceil(input);
+  return AqlValue(new Json(input));
 #endif
 }
 
-AqlValue$ Functions::FlattenVPack(arangodb::aql::Query* query,
-                                  arangodb::AqlTransaction* trx,
-                                  VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::CeilVPack(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-  if (n == 0 || n > 2) {
+
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FLATTEN", (int)1,
-        (int)2);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "CEIL", (int)1,
+        (int)1);
   }
 
-  VPackSlice listSlice = ExtractFunctionParameter(trx, parameters, 0);
-  if (!listSlice.isArray()) {
-    RegisterWarning(query, "FLATTEN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+  VPackSlice inputSlice = ExtractFunctionParameter(trx, parameters, 0);
 
-  size_t maxDepth = 1;
-  if (n == 2) {
-    VPackSlice maxDepthSlice = ExtractFunctionParameter(trx, parameters, 1);
-    bool isValid = true;
-    double tmpMaxDepth = ValueToNumber(maxDepthSlice, isValid);
-    if (!isValid || tmpMaxDepth < 1) {
-      maxDepth = 1;
-    } else {
-      maxDepth = static_cast<size_t>(tmpMaxDepth);
-    }
-  }
+  bool unused = false;
+  double input = arangodb::basics::VelocyPackHelper::toDouble(inputSlice, unused);
 
+  input = ceil(input);
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  try {
-    VPackArrayBuilder guard(b.get());
-    FlattenList(listSlice, maxDepth, 0, *b);
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
-  
+  b->add(VPackValue(input));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function ZIP
+/// @brief function FLOOR
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Zip(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
+AqlValue Functions::Floor(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(ZipVPack(query, trx, tmp));
+  return AqlValue(FloorVPack(query, trx, tmp));
 #else
-  if (parameters.size() != 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ZIP", (int)2,
-        (int)2);
-  }
+  size_t const n = parameters.size();
 
-  Json keysJson = ExtractFunctionParameter(trx, parameters, 0, false);
-  Json valuesJson = ExtractFunctionParameter(trx, parameters, 1, false);
-  if (!keysJson.isArray() || !valuesJson.isArray() ||
-      keysJson.size() != valuesJson.size()) {
-    RegisterWarning(query, "ZIP",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    return AqlValue(new Json(Json::Null));
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FLOOR", (int)1,
+        (int)1);
   }
-  size_t const n = keysJson.size();
 
-  Json result(Json::Object, n);
+  Json inputJson = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  // Buffer will temporarily hold the keys
-  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
-  for (size_t i = 0; i < n; ++i) {
-    buffer.reset();
-    AppendAsString(buffer, keysJson.at(i).json());
-    result.set(buffer.c_str(), valuesJson.at(i).copy().steal());
-  }
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  bool unused = false;
+  double input = TRI_ToDoubleJson(inputJson.json(), unused);
+  input = floor(input);
+  return AqlValue(new Json(input));
 #endif
 }
 
-AqlValue$ Functions::ZipVPack(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              VPackFunctionParameters const& parameters) {
-  if (parameters.size() != 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ZIP", (int)2,
-        (int)2);
-  }
-
-  VPackSlice keysSlice = ExtractFunctionParameter(trx, parameters, 0);
-  VPackSlice valuesSlice = ExtractFunctionParameter(trx, parameters, 1);
+AqlValue$ Functions::FloorVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
 
-  if (!keysSlice.isArray() || !valuesSlice.isArray() ||
-      keysSlice.length() != valuesSlice.length()) {
-    RegisterWarning(query, "ZIP",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FLOOR", (int)1,
+        (int)1);
   }
 
-  VPackValueLength n = keysSlice.length();
+  VPackSlice inputSlice = ExtractFunctionParameter(trx, parameters, 0);
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  try {
-    VPackObjectBuilder guard(b.get());
+  bool unused = false;
+  double input = arangodb::basics::VelocyPackHelper::toDouble(inputSlice, unused);
 
-    // Buffer will temporarily hold the keys
-    arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
-    arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
-    for (VPackValueLength i = 0; i < n; ++i) {
-      buffer.reset();
-      AppendAsString(adapter, keysSlice.at(i));
-      b->add(std::string(buffer.c_str(), buffer.length()), valuesSlice.at(i));
-    }
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+  input = floor(input);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(input));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function PARSE_IDENTIFIER
+/// @brief function SQRT
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::ParseIdentifier(arangodb::aql::Query* query,
-                                    arangodb::AqlTransaction* trx,
-                                    FunctionParameters const& parameters) {
+AqlValue Functions::Sqrt(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(ParseIdentifierVPack(query, trx, tmp));
+  return AqlValue(SqrtVPack(query, trx, tmp));
 #else
-  if (parameters.size() != 1) {
+  size_t const n = parameters.size();
+
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PARSE_IDENTIFIER",
-        (int)1, (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SQRT", (int)1,
+        (int)1);
   }
 
-  Json value = ExtractFunctionParameter(trx, parameters, 0, false);
-  std::string identifier;
-
-  if (value.isObject() && value.has(TRI_VOC_ATTRIBUTE_ID)) {
-    identifier = arangodb::basics::JsonHelper::getStringValue(value.get(TRI_VOC_ATTRIBUTE_ID).json(), "");
-  }
-  else if (value.isString()) {
-    identifier = arangodb::basics::JsonHelper::getStringValue(value.json(), "");
-  }
+  Json inputJson = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (!identifier.empty()) {
-    std::vector<std::string> parts =
-        arangodb::basics::StringUtils::split(identifier, "/");
-    if (parts.size() == 2) {
-      Json result(Json::Object, 2);
-      result.set("collection", Json(parts[0]));
-      result.set("key", Json(parts[1]));
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
-    }
+  bool unused = false;
+  double input = TRI_ToDoubleJson(inputJson.json(), unused);
+  input = sqrt(input);
+  if (std::isnan(input)) {
+    return AqlValue(new Json(Json::Null));
   }
-
-  RegisterWarning(query, "PARSE_IDENTIFIER",
-                  TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-  return AqlValue(new Json(Json::Null));
+  return AqlValue(new Json(input));
 #endif
 }
 
-AqlValue$ Functions::ParseIdentifierVPack(arangodb::aql::Query* query,
-                                          arangodb::AqlTransaction* trx,
-                                          VPackFunctionParameters const& parameters) {
-  if (parameters.size() != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PARSE_IDENTIFIER",
-        (int)1, (int)1);
-  }
+AqlValue$ Functions::SqrtVPack(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
 
-  VPackSlice value = ExtractFunctionParameter(trx, parameters, 0);
-  std::string identifier;
-  if (value.isObject() && value.hasKey(TRI_VOC_ATTRIBUTE_ID)) {
-    identifier = arangodb::basics::VelocyPackHelper::getStringValue(
-        value, TRI_VOC_ATTRIBUTE_ID, "");
-  } else if (value.isString()) {
-    identifier = value.copyString();
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SQRT", (int)1,
+        (int)1);
   }
 
-  if (!identifier.empty()) {
-    std::vector<std::string> parts =
-        arangodb::basics::StringUtils::split(identifier, "/");
-    if (parts.size() == 2) {
-      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-      try {
-        VPackObjectBuilder guard(b.get());
-        b->add("collection", VPackValue(parts[0]));
-        b->add("key", VPackValue(parts[1]));
-      } catch (...) {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-      }
-      return AqlValue$(b.get());
-    }
-  }
+  VPackSlice inputSlice = ExtractFunctionParameter(trx, parameters, 0);
 
-  RegisterWarning(query, "PARSE_IDENTIFIER",
-                  TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+  bool unused = false;
+  double input = arangodb::basics::VelocyPackHelper::toDouble(inputSlice, unused);
+  input = sqrt(input);
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(VPackValueType::Null));
+  if (std::isnan(input)) {
+    b->add(VPackValue(VPackValueType::Null));
+  } else {
+    b->add(VPackValue(input));
+  }
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function Minus
+/// @brief function POW
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Minus(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          FunctionParameters const& parameters) {
+AqlValue Functions::Pow(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(MinusVPack(query, trx, tmp));
+  return AqlValue(PowVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
 
-  if (n < 2) {
-    // The max number is arbitrary
+  if (n != 2) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "MINUS", (int)2,
-        (int)99999);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POW", (int)2,
+        (int)2);
   }
 
-  Json baseArray = ExtractFunctionParameter(trx, parameters, 0, false);
-  std::unordered_map<std::string, size_t> contains;
-  contains.reserve(n);
+  Json baseJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  Json expJson = ExtractFunctionParameter(trx, parameters, 1, false);
 
-  if (!baseArray.isArray()) {
-    RegisterWarning(query, "MINUS",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+  bool unused = false;
+  double base = TRI_ToDoubleJson(baseJson.json(), unused);
+  double exp = TRI_ToDoubleJson(expJson.json(), unused);
+  base = pow(base, exp);
+  if (std::isnan(base) || !std::isfinite(base)) {
     return AqlValue(new Json(Json::Null));
   }
-
-  // Fill the original map
-  for (size_t i = 0; i < baseArray.size(); ++i) {
-    contains.emplace(baseArray.at(i).toString(), i);
-  }
-
-  // Iterate through all following parameters and delete found elements from the
-  // map
-  for (size_t k = 1; k < n; ++k) {
-    Json nextArray = ExtractFunctionParameter(trx, parameters, k, false);
-    if (!nextArray.isArray()) {
-      RegisterWarning(query, "MINUS",
-                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-      return AqlValue(new Json(Json::Null));
-    }
-
-    for (size_t j = 0; j < nextArray.size(); ++j) {
-      std::string search = nextArray.at(j).toString();
-      auto find = contains.find(search);
-      if (find != contains.end()) {
-        contains.erase(find);
-      }
-    }
-  }
-
-  // We ommit the normalize part from js, cannot occur here
-  Json result(Json::Array, contains.size());
-  for (auto& it : contains) {
-    result.transfer(baseArray.at(it.second).json());
-  }
-
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  return AqlValue(new Json(base));
 #endif
 }
 
-AqlValue$ Functions::MinusVPack(arangodb::aql::Query* query,
-                                arangodb::AqlTransaction* trx,
-                                VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::PowVPack(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
 
-  if (n < 2) {
-    // The max number is arbitrary
+  if (n != 2) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "MINUS", (int)2,
-        (int)99999);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POW", (int)2,
+        (int)2);
   }
-  VPackSlice baseArray = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (!baseArray.isArray()) {
-    RegisterWarning(query, "MINUS",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  VPackSlice baseSlice = ExtractFunctionParameter(trx, parameters, 0);
+  VPackSlice expSlice = ExtractFunctionParameter(trx, parameters, 1);
+
+  bool unused = false;
+  double base = arangodb::basics::VelocyPackHelper::toDouble(baseSlice, unused);
+  double exp = arangodb::basics::VelocyPackHelper::toDouble(expSlice, unused);
+  base = pow(base, exp);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  if (std::isnan(base) || !std::isfinite(base)) {
     b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  } else {
+    b->add(VPackValue(base));
   }
+  return AqlValue$(b.get());
+}
 
-  std::unordered_map<std::string, size_t> contains;
-  contains.reserve(n);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function RAND
+////////////////////////////////////////////////////////////////////////////////
 
-  // Fill the original map
-  for (size_t i = 0; i < baseArray.length(); ++i) {
-    contains.emplace(baseArray.at(i).toJson(), i);
+AqlValue Functions::Rand(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(RandVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+
+  if (n != 0) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "RAND", (int)0,
+        (int)0);
   }
 
-  // Iterate through all following parameters and delete found elements from the
-  // map
-  for (size_t k = 1; k < n; ++k) {
-    VPackSlice nextArray = ExtractFunctionParameter(trx, parameters, k);
-    if (!nextArray.isArray()) {
-      RegisterWarning(query, "MINUS",
-                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-      b->add(VPackValue(VPackValueType::Null));
-      return AqlValue$(b.get());
-    }
+  // This Random functionality is not too good yet...
+  double output = static_cast<double>(std::rand()) / RAND_MAX;
+  return AqlValue(new Json(output));
+#endif
+}
+
+AqlValue$ Functions::RandVPack(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
 
-    for (auto const& searchSlice : VPackArrayIterator(nextArray)) {
-      std::string search = searchSlice.toJson();
-      auto find = contains.find(search);
-      if (find != contains.end()) {
-        contains.erase(find);
-      }
-    }
+  if (n != 0) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "RAND", (int)0,
+        (int)0);
   }
 
-  // We ommit the normalize part from js, cannot occur here
+  // This Random functionality is not too good yet...
+  double output = static_cast<double>(std::rand()) / RAND_MAX;
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  try {
-    VPackArrayBuilder guard(b.get());
-    for (auto const& it : contains) {
-      b->add(baseArray.at(it.second));
-    }
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+  b->add(VPackValue(output));
   return AqlValue$(b.get());
 }
 
-static void RegisterCollectionInTransaction(
-    arangodb::AqlTransaction* trx, std::string const& collectionName,
-    TRI_voc_cid_t& cid, TRI_transaction_collection_t*& collection) {
-  TRI_ASSERT(collection == nullptr);
-  cid = trx->resolver()->getCollectionId(collectionName);
-  if (cid == 0) {
-    THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND, "'%s'",
-                                  collectionName.c_str());
-  }
-  // ensure the collection is loaded
-  collection = trx->trxCollection(cid);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIRST_DOCUMENT
+////////////////////////////////////////////////////////////////////////////////
 
-  if (collection == nullptr) {
-    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
-                                           TRI_TRANSACTION_READ,
-                                           trx->nestingLevel(), true, true);
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", collectionName.c_str());
+AqlValue Functions::FirstDocument(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(FirstDocumentVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+  for (size_t i = 0; i < n; ++i) {
+    Json element = ExtractFunctionParameter(trx, parameters, i, false);
+    if (element.isObject()) {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, element.copy().steal(),
+                               Json::AUTOFREE));
     }
-    TRI_EnsureCollectionsTransaction(trx->getInternals());
-    collection = trx->trxCollection(cid);
+  }
+  return AqlValue(new Json(Json::Null));
+#endif
+}
 
-    if (collection == nullptr) {
-      // This case should never occur
-      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
-                                     "could not load collection");
+AqlValue$ Functions::FirstDocumentVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+  for (size_t i = 0; i < n; ++i) {
+    VPackSlice element = ExtractFunctionParameter(trx, parameters, i);
+    if (element.isObject()) {
+      return AqlValue$(element);
     }
   }
-  TRI_ASSERT(collection != nullptr);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(VPackValueType::Null));
+  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief Helper function to get a document by it's identifier
-///        The collection has to be locked by the transaction before
+/// @brief function FIRST_LIST
 ////////////////////////////////////////////////////////////////////////////////
 
-static Json getDocumentByIdentifier(arangodb::AqlTransaction* trx,
-                                    CollectionNameResolver const* resolver,
-                                    TRI_transaction_collection_t* collection,
-                                    TRI_voc_cid_t const& cid,
-                                    std::string const& collectionName,
-                                    std::string const& identifier) {
-  std::vector<std::string> parts =
-      arangodb::basics::StringUtils::split(identifier, "/");
-
-  TRI_doc_mptr_copy_t mptr;
-  if (parts.size() == 1) {
-    int res = trx->readSingle(collection, &mptr, parts[0]);
-    if (res != TRI_ERROR_NO_ERROR) {
-      return Json(Json::Null);
-    }
-  } else if (parts.size() == 2) {
-    if (parts[0] != collectionName) {
-      // Reqesting an _id that cannot be stored in this collection
-      return Json(Json::Null);
-    }
-    int res = trx->readSingle(collection, &mptr, parts[1]);
-    if (res != TRI_ERROR_NO_ERROR) {
-      return Json(Json::Null);
+AqlValue Functions::FirstList(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(FirstListVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+  for (size_t i = 0; i < n; ++i) {
+    Json element = ExtractFunctionParameter(trx, parameters, i, false);
+    if (element.isArray()) {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, element.copy().steal(),
+                               Json::AUTOFREE));
     }
-  } else {
-    return Json(Json::Null);
   }
+  return AqlValue(new Json(Json::Null));
+#endif
+}
 
-  return ExpandShapedJson(collection->_collection->_collection->getShaper(),
-                          resolver, cid, &mptr);
+AqlValue$ Functions::FirstListVPack(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+  for (size_t i = 0; i < n; ++i) {
+    VPackSlice element = ExtractFunctionParameter(trx, parameters, i);
+    if (element.isArray()) {
+      return AqlValue$(element);
+    }
+  }
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(VPackValueType::Null));
+  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief Helper function to get a document by its _id
-///        This function will lazy read-lock the collection.
-/// this function will not throw if the document or the collection cannot be
-/// found
+/// @brief function PUSH
 ////////////////////////////////////////////////////////////////////////////////
 
-static Json getDocumentByIdentifier(arangodb::AqlTransaction* trx,
-                                    CollectionNameResolver const* resolver,
-                                    std::string const& identifier) {
-  std::vector<std::string> parts =
-      arangodb::basics::StringUtils::split(identifier, "/");
+AqlValue Functions::Push(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(PushVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+  if (n != 2 && n != 3) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PUSH", (int)2,
+        (int)3);
+  }
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+  Json toPush = ExtractFunctionParameter(trx, parameters, 1, false);
 
-  if (parts.size() != 2) {
-    return Json(Json::Null);
+  if (list.isNull()) {
+    Json array(Json::Array, 1);
+    array.add(toPush.copy());
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.copy().steal()));
   }
-  std::string collectionName = parts[0];
-  TRI_transaction_collection_t* collection = nullptr;
-  TRI_voc_cid_t cid = 0;
-  try {
-    RegisterCollectionInTransaction(trx, collectionName, cid, collection);
-  } catch (arangodb::basics::Exception const& ex) {
-    // don't throw if collection is not found
-    if (ex.code() == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
-      return Json(Json::Null);
+  if (list.isArray()) {
+    if (n == 3) {
+      Json unique = ExtractFunctionParameter(trx, parameters, 2, false);
+      if (ValueToBoolean(unique.json()) && ListContainsElement(list, toPush)) {
+        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+      }
     }
-    throw;
-  }
-
-  TRI_doc_mptr_copy_t mptr;
-  int res = trx->readSingle(collection, &mptr, parts[1]);
-
-  if (res != TRI_ERROR_NO_ERROR) {
-    return Json(Json::Null);
+    list.add(toPush.copy());
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
   }
 
-  return ExpandShapedJson(collection->_collection->_collection->getShaper(),
-                          resolver, cid, &mptr);
+  RegisterWarning(query, "PUSH",
+                  TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+  return AqlValue(new Json(Json::Null));
+#endif
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief Helper function to get a document by it's identifier
-///        The collection has to be locked by the transaction before
-////////////////////////////////////////////////////////////////////////////////
-
-static void getDocumentByIdentifier(arangodb::AqlTransaction* trx,
-                                    CollectionNameResolver const* resolver,
-                                    TRI_transaction_collection_t* collection,
-                                    TRI_voc_cid_t const& cid,
-                                    std::string const& collectionName,
-                                    std::string const& identifier,
-                                    VPackBuilder& result) {
-  std::vector<std::string> parts =
-      arangodb::basics::StringUtils::split(identifier, "/");
+AqlValue$ Functions::PushVPack(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+  if (n != 2 && n != 3) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PUSH", (int)2,
+        (int)3);
+  }
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+  VPackSlice toPush = ExtractFunctionParameter(trx, parameters, 1);
 
-  TRI_doc_mptr_copy_t mptr;
-  if (parts.size() == 1) {
-    int res = trx->readSingle(collection, &mptr, parts[0]);
-    if (res != TRI_ERROR_NO_ERROR) {
-      return;
-    }
-  } else if (parts.size() == 2) {
-    if (parts[0] != collectionName) {
-      // Reqesting an _id that cannot be stored in this collection
-      return;
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  if (list.isNull()) {
+    VPackArrayBuilder guard(b.get());
+    b->add(toPush);
+  } else if (list.isArray()) {
+    VPackArrayBuilder guard(b.get());
+    for (auto const& it : VPackArrayIterator(list)) {
+      b->add(it);
     }
-    int res = trx->readSingle(collection, &mptr, parts[1]);
-    if (res != TRI_ERROR_NO_ERROR) {
-      return;
+    if (n == 3) {
+      VPackSlice unique = ExtractFunctionParameter(trx, parameters, 2);
+      if (!ValueToBoolean(unique) || !ListContainsElement(list, toPush)) {
+        b->add(toPush);
+      }
+    } else {
+      b->add(toPush);
     }
   } else {
-    return;
+    RegisterWarning(query, "PUSH",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    b->add(VPackValue(VPackValueType::Null));
   }
-
-  std::unordered_set<std::string> unused;
-  ExpandShapedJson(collection->_collection->_collection->getShaper(), resolver,
-                   cid, &mptr, result, false, unused);
+  return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief Helper function to get a document by its _id
-///        This function will lazy read-lock the collection.
-/// this function will not throw if the document or the collection cannot be
-/// found
+/// @brief function POP
 ////////////////////////////////////////////////////////////////////////////////
 
-static void getDocumentByIdentifier(arangodb::AqlTransaction* trx,
-                                    CollectionNameResolver const* resolver,
-                                    std::string const& identifier,
-                                    VPackBuilder& result) {
-  std::vector<std::string> parts =
-      arangodb::basics::StringUtils::split(identifier, "/");
+AqlValue Functions::Pop(arangodb::aql::Query* query,
+                        arangodb::AqlTransaction* trx,
+                        FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(PopVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POP", (int)1,
+        (int)1);
+  }
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (parts.size() != 2) {
-    return;
+  if (list.isNull()) {
+    return AqlValue(new Json(Json::Null));
   }
-  std::string collectionName = parts[0];
-  TRI_transaction_collection_t* collection = nullptr;
-  TRI_voc_cid_t cid = 0;
-  try {
-    RegisterCollectionInTransaction(trx, collectionName, cid, collection);
-  } catch (arangodb::basics::Exception const& ex) {
-    // don't throw if collection is not found
-    if (ex.code() == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
-      return;
+  if (list.isArray()) {
+    if (list.size() > 0) {
+      if (!TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, list.json(),
+                               list.size() - 1)) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
     }
-    throw;
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
   }
 
-  TRI_doc_mptr_copy_t mptr;
-  int res = trx->readSingle(collection, &mptr, parts[1]);
+  RegisterWarning(query, "POP",
+                  TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+  return AqlValue(new Json(Json::Null));
+#endif
+}
 
-  if (res != TRI_ERROR_NO_ERROR) {
-    return;
+AqlValue$ Functions::PopVPack(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POP", (int)1,
+        (int)1);
   }
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
 
-  std::unordered_set<std::string> unused;
-  ExpandShapedJson(collection->_collection->_collection->getShaper(), resolver,
-                   cid, &mptr, result, false, unused);
+  if (list.isNull()) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  if (list.isArray()) {
+    try {
+      VPackArrayBuilder guard(b.get());
+      auto iterator = VPackArrayIterator(list);
+      while (!iterator.isLast()) {
+        b->add(iterator.value());
+        iterator.next();
+      }
+    } catch (...) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+  } else {
+    RegisterWarning(query, "POP",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    b->add(VPackValue(VPackValueType::Null));
+  }
+  return AqlValue$(b.get());
 }
 
-
-
-
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function Document
+/// @brief function APPEND
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Document(arangodb::aql::Query* query,
-                             arangodb::AqlTransaction* trx,
-                             FunctionParameters const& parameters) {
+AqlValue Functions::Append(arangodb::aql::Query* query,
+                           arangodb::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(DocumentVPack(query, trx, tmp));
+  return AqlValue(AppendVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-
-  if (n < 1 || 2 < n) {
+  if (n != 2 && n != 3) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "DOCUMENT", (int)1,
-        (int)2);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "APPEND", (int)2,
+        (int)3);
   }
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+  Json toAppend = ExtractFunctionParameter(trx, parameters, 1, false);
 
-  auto resolver = trx->resolver();
-
-  if (n == 1) {
-    Json id = ExtractFunctionParameter(trx, parameters, 0, false);
-
-    if (id.isString()) {
-      std::string identifier =
-          arangodb::basics::JsonHelper::getStringValue(id.json(), "");
-      Json result = getDocumentByIdentifier(trx, resolver, identifier);
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
-    } else if (id.isArray()) {
-      size_t const n = id.size();
-      Json result(Json::Array, n);
-      for (size_t i = 0; i < n; ++i) {
-        Json next = id.at(i);
-        try {
-          if (next.isString()) {
-            std::string identifier =
-                arangodb::basics::JsonHelper::getStringValue(next.json(), "");
-            Json tmp = getDocumentByIdentifier(trx, resolver, identifier);
-            if (!tmp.isNull()) {
-              result.add(tmp);
-            }
-          }
-        } catch (arangodb::basics::Exception const&) {
-          // Ignore all ArangoDB exceptions here
-        }
-      }
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
-    }
-    return AqlValue(new Json(Json::Null));
+  if (toAppend.isNull()) {
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
   }
-
-  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
-  if (!collectionJson.isString()) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+  bool unique = false;
+  if (n == 3) {
+    Json uniqueJson = ExtractFunctionParameter(trx, parameters, 2, false);
+    unique = ValueToBoolean(uniqueJson.json());
   }
-  std::string collectionName =
-      arangodb::basics::JsonHelper::getStringValue(collectionJson.json(), "");
-
-  TRI_transaction_collection_t* collection = nullptr;
-  TRI_voc_cid_t cid;
-  bool notFound = false;
-
-  try {
-    RegisterCollectionInTransaction(trx, collectionName, cid, collection);
-  } catch (arangodb::basics::Exception const& ex) {
-    // don't throw if collection is not found
-    if (ex.code() != TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
-      throw;
-    }
-    notFound = true;
+  if (list.isNull()) {
+    // Create a JSON array instead.
+    list = Json(Json::Array, 0);
   }
 
-  Json id = ExtractFunctionParameter(trx, parameters, 1, false);
-  if (id.isString()) {
-    if (notFound) {
-      return AqlValue(new Json(Json::Null));
-    }
-    std::string identifier =
-        arangodb::basics::JsonHelper::getStringValue(id.json(), "");
-    Json result = getDocumentByIdentifier(trx, resolver, collection, cid,
-                                          collectionName, identifier);
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
-  } else if (id.isArray()) {
-    if (notFound) {
-      return AqlValue(new Json(Json::Array));
-    }
-    size_t const n = id.size();
-    Json result(Json::Array, n);
-    for (size_t i = 0; i < n; ++i) {
-      Json next = id.at(i);
-      try {
-        if (next.isString()) {
-          std::string identifier =
-              arangodb::basics::JsonHelper::getStringValue(next.json(), "");
-          Json tmp = getDocumentByIdentifier(trx, resolver, collection, cid,
-                                             collectionName, identifier);
-          if (!tmp.isNull()) {
-            result.add(tmp);
-          }
-        }
-      } catch (arangodb::basics::Exception const&) {
-        // Ignore all ArangoDB exceptions here
-      }
+  if (!toAppend.isArray()) {
+    if (unique && ListContainsElement(list, toAppend)) {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
     }
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+    list.reserve(1);
+    list.add(toAppend.copy());
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
   }
-  // Id has invalid format
-  return AqlValue(new Json(Json::Null));
-#endif
-}
-
-AqlValue$ Functions::DocumentVPack(arangodb::aql::Query* query,
-                                   arangodb::AqlTransaction* trx,
-                                   VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
 
-  if (n < 1 || 2 < n) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "DOCUMENT", (int)1,
-        (int)2);
-  }
+  size_t const expectedInserts = toAppend.size();
 
-  auto resolver = trx->resolver();
-  if (n == 1) {
-    VPackSlice id = ExtractFunctionParameter(trx, parameters, 0);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    if (id.isString()) {
-      std::string identifier = id.copyString();
-      getDocumentByIdentifier(trx, resolver, identifier, *b);
-      if (b->isEmpty()) {
-        // not found
-        b->add(VPackValue(VPackValueType::Null));
-      }
-    } else if (id.isArray()) {
-      VPackArrayBuilder guard(b.get());
-      for (auto const& next : VPackArrayIterator(id)) {
-        try {
-          if (next.isString()) {
-            std::string identifier = next.copyString();
-            getDocumentByIdentifier(trx, resolver, identifier, *b);
-          }
-        } catch (arangodb::basics::Exception const&) {
-          // Ignore all ArangoDB exceptions here
-        }
-      }
-    } else {
-      b->add(VPackValue(VPackValueType::Null));
+  list.reserve(expectedInserts);
+
+  for (size_t i = 0; i < expectedInserts; ++i) {
+    auto toPush = toAppend.at(i);
+    if (unique && ListContainsElement(list, toPush)) {
+      continue;
     }
-    return AqlValue$(b.get());
+    list.add(toPush.copy());
   }
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+#endif
+}
 
-  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
-  if (!collectionSlice.isString()) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+AqlValue$ Functions::AppendVPack(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+  if (n != 2 && n != 3) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "APPEND", (int)2,
+        (int)3);
   }
-  std::string collectionName = collectionSlice.copyString();
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+  VPackSlice toAppend = ExtractFunctionParameter(trx, parameters, 1);
 
-  TRI_transaction_collection_t* collection = nullptr;
-  TRI_voc_cid_t cid;
-  bool notFound = false;
+  if (toAppend.isNull()) {
+    return AqlValue$(list);
+  }
 
-  try {
-    RegisterCollectionInTransaction(trx, collectionName, cid, collection);
-  } catch (arangodb::basics::Exception const& ex) {
-    // don't throw if collection is not found
-    if (ex.code() != TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
-      throw;
-    }
-    notFound = true;
+  bool unique = false;
+  if (n == 3) {
+    VPackSlice uniqueSlice = ExtractFunctionParameter(trx, parameters, 2);
+    unique = ValueToBoolean(uniqueSlice);
   }
 
-  VPackSlice id = ExtractFunctionParameter(trx, parameters, 1);
-  if (id.isString()) {
-    if (notFound) {
-      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-      b->add(VPackValue(VPackValueType::Null));
-      return AqlValue$(b.get());
-    }
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    std::string identifier = id.copyString();
-    getDocumentByIdentifier(trx, resolver, collection, cid, collectionName, identifier, *b);
-    if (b->isEmpty()) {
-      b->add(VPackValue(VPackValueType::Null));
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  {
+    VPackArrayBuilder guard(b.get());
+    if (!list.isNull()) {
+      TRI_ASSERT(list.isArray());
+      for (auto const& it : VPackArrayIterator(list)) {
+        b->add(it);
+      }
     }
-    return AqlValue$(b.get());
-  } else if (id.isArray()) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    {
-      VPackArrayBuilder guard(b.get());
-      if (!notFound) {
-        for (auto const& next : VPackArrayIterator(id)) {
-          try {
-            if (next.isString()) {
-              std::string identifier = next.copyString();
-              getDocumentByIdentifier(trx, resolver, collection, cid, collectionName, identifier, *b);
-            }
-          } catch (arangodb::basics::Exception const&) {
-            // Ignore all ArangoDB exceptions here
-          }
+    if (!toAppend.isArray()) {
+      if (!unique || !ListContainsElement(list, toAppend)) {
+        b->add(toAppend);
+      }
+    } else {
+      for (auto const& it : VPackArrayIterator(toAppend)) {
+        if (!unique || !ListContainsElement(list, it)) {
+          b->add(it);
         }
       }
     }
-    return AqlValue$(b.get());
   }
-  // Id has invalid format
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(VPackValueType::Null));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function Edges
+/// @brief function UNSHIFT
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Edges(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          FunctionParameters const& parameters) {
+AqlValue Functions::Unshift(arangodb::aql::Query* query,
+                            arangodb::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(EdgesVPack(query, trx, tmp));
+  return AqlValue(UnshiftVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-
-  if (n < 3 || 5 < n) {
+  if (n != 2 && n != 3) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "EDGES", (int)3,
-        (int)5);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNSHIFT", (int)2,
+        (int)3);
   }
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+  Json toAppend = ExtractFunctionParameter(trx, parameters, 1, false);
 
-  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
-  if (!collectionJson.isString()) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+  if (list.isNull()) {
+    Json result(Json::Array, 1);
+    result.add(toAppend.copy());
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
   }
-  std::string collectionName =
-      arangodb::basics::JsonHelper::getStringValue(collectionJson.json(), "");
 
-  TRI_transaction_collection_t* collection = nullptr;
-  TRI_voc_cid_t cid;
-  RegisterCollectionInTransaction(trx, collectionName, cid, collection);
-  if (collection->_collection->_type != TRI_COL_TYPE_EDGE) {
-    RegisterWarning(query, "EDGES", TRI_ERROR_ARANGO_COLLECTION_TYPE_INVALID);
-    return AqlValue(new Json(Json::Null));
-  }
+  if (list.isArray()) {
+    bool unique = false;
+    if (n == 3) {
+      Json uniqueJson = ExtractFunctionParameter(trx, parameters, 2, false);
+      unique = ValueToBoolean(uniqueJson.json());
+    }
+    if (unique && ListContainsElement(list, toAppend)) {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+    }
+    Json copy = list.copy();
+    TRI_json_t* toAppendCopy = toAppend.copy().steal();
 
-  Json vertexJson = ExtractFunctionParameter(trx, parameters, 1, false);
-  if (!vertexJson.isArray() && !vertexJson.isString() &&
-      !vertexJson.isObject()) {
-    // Invalid Start vertex
-    // Early Abort before parsing other parameters
-    return AqlValue(new Json(Json::Null));
+    int res =
+        TRI_InsertVector(&(copy.json()->_value._objects), toAppendCopy, 0);
+    // free the pointer, but not the contents
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, toAppendCopy);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, copy.steal()));
   }
 
-  Json directionJson = ExtractFunctionParameter(trx, parameters, 2, false);
-  if (!directionJson.isString()) {
-    RegisterWarning(query, "EDGES",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    return AqlValue(new Json(Json::Null));
+  RegisterInvalidArgumentWarning(query, "UNSHIFT");
+  return AqlValue(new Json(Json::Null));
+#endif
+}
+
+AqlValue$ Functions::UnshiftVPack(arangodb::aql::Query* query,
+                            arangodb::AqlTransaction* trx,
+                            VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+  if (n != 2 && n != 3) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNSHIFT", (int)2,
+        (int)3);
   }
-  std::string dirString =
-      basics::JsonHelper::getStringValue(directionJson.json(), "");
-  // transform String to lower case
-  std::transform(dirString.begin(), dirString.end(), dirString.begin(),
-                 ::tolower);
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
 
-  TRI_edge_direction_e direction;
+  if (!list.isNull() && !list.isArray()) {
+    RegisterInvalidArgumentWarning(query, "UNSHIFT");
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
 
-  if (dirString == "inbound") {
-    direction = TRI_EDGE_IN;
-  } else if (dirString == "outbound") {
-    direction = TRI_EDGE_OUT;
-  } else if (dirString == "any") {
-    direction = TRI_EDGE_ANY;
-  } else {
-    RegisterWarning(query, "EDGES",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    return AqlValue(new Json(Json::Null));
+  VPackSlice toAppend = ExtractFunctionParameter(trx, parameters, 1);
+  bool unique = false;
+  if (n == 3) {
+    VPackSlice uniqueSlice = ExtractFunctionParameter(trx, parameters, 2);
+    unique = ValueToBoolean(uniqueSlice);
   }
-  auto resolver = trx->resolver();
 
-  auto shaper = collection->_collection->_collection->getShaper();
-  std::unique_ptr<arangodb::ExampleMatcher> matcher;
-  if (n > 3) {
-    // We might have examples
-    Json exampleJson = ExtractFunctionParameter(trx, parameters, 3, false);
-    if (!exampleJson.isNull()) {
-      bool buildMatcher = false;
-      if (exampleJson.isArray()) {
-        size_t exampleCount = exampleJson.size();
-        // We only support objects here so validate
-        for (size_t k = 0; k < exampleCount; /* nothing */) {
-          if (exampleJson.at(k).isObject()) {
-            ++k;
-            continue;
-          }
+  if (unique && list.isArray() && ListContainsElement(list, toAppend)) {
+    // Short circuit, nothing to do return list
+    return AqlValue$(list);
+  }
 
-          RegisterWarning(query, "EDGES",
-                          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-          if (TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, exampleJson.json(),
-                                  k)) {
-            // don't modify count
-            --exampleCount;
-          } else {
-            // Should never occur.
-            // If it occurs in production it will simply fall through
-            // it can only return more results than expected and not do any
-            // harm.
-            TRI_ASSERT(false);
-            ++k;
-          }
-        }
-        if (exampleCount > 0) {
-          buildMatcher = true;
-        }
-        // else we do not filter at all
-      } else if (exampleJson.isObject()) {
-        buildMatcher = true;
-      } else {
-        RegisterWarning(query, "EDGES",
-                        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-      }
-      if (buildMatcher) {
-        try {
-          matcher.reset(new arangodb::ExampleMatcher(exampleJson.json(), shaper,
-                                                     resolver));
-        } catch (arangodb::basics::Exception const& e) {
-          if (e.code() != TRI_RESULT_ELEMENT_NOT_FOUND) {
-            throw;
-          }
-          // We can never fulfill this filter!
-          // RETURN empty Array
-          Json result(Json::Array, 0);
-          return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
-        }
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  {
+    VPackArrayBuilder guard(b.get());
+    b->add(toAppend);
+    if (list.isArray()) {
+      for (auto const& it : VPackArrayIterator(list)) {
+        b->add(it);
       }
     }
   }
+  return AqlValue$(b.get());
+}
 
-  bool includeVertices = false;
-  if (n == 5) {
-    // We have options
-    Json options = ExtractFunctionParameter(trx, parameters, 4, false);
-    if (options.isObject() && options.has("includeVertices")) {
-      includeVertices = arangodb::basics::JsonHelper::getBooleanValue(
-          options.json(), "includeVertices", false);
-    }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SHIFT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Shift(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(ShiftVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SHIFT", (int)1,
+        (int)1);
   }
 
-  Json result(Json::Array, 0);
-  if (vertexJson.isArray()) {
-    size_t length = vertexJson.size();
-    for (size_t i = 0; i < length; ++i) {
-      try {
-        RequestEdges(vertexJson.at(i), trx, resolver, shaper, cid,
-                     collection->_collection->_collection, direction,
-                     matcher.get(), includeVertices, result);
-      } catch (...) {
-        // Errors in Array are simply ignored
-      }
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+  if (list.isNull()) {
+    return AqlValue(new Json(Json::Null));
+  }
+  if (list.isArray()) {
+    if (list.size() == 0) {
+      return AqlValue(new Json(Json::Array, 0));
     }
-  } else {
-    RequestEdges(vertexJson, trx, resolver, shaper, cid,
-                 collection->_collection->_collection, direction, matcher.get(),
-                 includeVertices, result);
+    if (!TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, list.json(), 0)) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
   }
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+
+  RegisterInvalidArgumentWarning(query, "SHIFT");
+  return AqlValue(new Json(Json::Null));
 #endif
 }
 
-AqlValue$ Functions::EdgesVPack(arangodb::aql::Query* query,
+AqlValue$ Functions::ShiftVPack(arangodb::aql::Query* query,
                                 arangodb::AqlTransaction* trx,
                                 VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
 
-  if (n < 3 || 5 < n) {
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "EDGES", (int)3,
-        (int)5);
-  }
-
-  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
-  if (!collectionSlice.isString()) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SHIFT", (int)1,
+        (int)1);
   }
-  std::string collectionName = collectionSlice.copyString();
 
-  TRI_transaction_collection_t* collection = nullptr;
-  TRI_voc_cid_t cid;
-  RegisterCollectionInTransaction(trx, collectionName, cid, collection);
-  if (collection->_collection->_type != TRI_COL_TYPE_EDGE) {
-    RegisterWarning(query, "EDGES", TRI_ERROR_ARANGO_COLLECTION_TYPE_INVALID);
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+  if (list.isNull()) {
     std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
     b->add(VPackValue(VPackValueType::Null));
     return AqlValue$(b.get());
   }
-
-  VPackSlice vertexSlice = ExtractFunctionParameter(trx, parameters, 1);
-  if (!vertexSlice.isArray() && !vertexSlice.isString() && !vertexSlice.isObject()) {
-    // Invalid Start vertex
-    // Early Abort before parsing other parameters
+  if (!list.isArray()) {
+    RegisterInvalidArgumentWarning(query, "SHIFT");
     std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
     b->add(VPackValue(VPackValueType::Null));
     return AqlValue$(b.get());
   }
 
-  VPackSlice directionSlice = ExtractFunctionParameter(trx, parameters, 2);
-  if (!directionSlice.isString()) {
-    RegisterWarning(query, "EDGES",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  {
+    VPackArrayBuilder guard(b.get());
+    if (list.length() > 0) {
+      auto iterator = VPackArrayIterator(list);
+      // This jumps over the first element
+      while(iterator.next()) {
+        b->add(iterator.value());
+      }
+    }
   }
-  std::string dirString = directionSlice.copyString();
-  // transform String to lower case
-  std::transform(dirString.begin(), dirString.end(), dirString.begin(),
-                 ::tolower);
+  return AqlValue$(b.get());
+}
 
-  TRI_edge_direction_e direction;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function REMOVE_VALUE
+////////////////////////////////////////////////////////////////////////////////
 
-  if (dirString == "inbound") {
-    direction = TRI_EDGE_IN;
-  } else if (dirString == "outbound") {
-    direction = TRI_EDGE_OUT;
-  } else if (dirString == "any") {
-    direction = TRI_EDGE_ANY;
-  } else {
-    RegisterWarning(query, "EDGES",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+AqlValue Functions::RemoveValue(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                FunctionParameters const& parameters) {
+#ifdef TMPUSEVPACK
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(RemoveValueVPack(query, trx, tmp));
+#else
+  size_t const n = parameters.size();
+  if (n != 2 && n != 3) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_VALUE",
+        (int)2, (int)3);
   }
 
-  auto resolver = trx->resolver();
-
-  auto shaper = collection->_collection->_collection->getShaper();
-  std::unique_ptr<arangodb::ExampleMatcher> matcher;
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (n > 3) {
-    // We might have examples
-    VPackSlice exampleSlice = ExtractFunctionParameter(trx, parameters, 3);
-    if ((exampleSlice.isArray() && exampleSlice.length() != 0)|| exampleSlice.isObject()) {
-      try {
-        matcher.reset(
-            new arangodb::ExampleMatcher(exampleSlice, shaper, resolver, false));
-      } catch (arangodb::basics::Exception const& e) {
-        if (e.code() != TRI_RESULT_ELEMENT_NOT_FOUND) {
-          throw;
-        }
-        // We can never fulfill this filter!
-        // RETURN empty Array
-        std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-        {
-          VPackArrayBuilder guard(b.get());
+  if (list.isNull()) {
+    return AqlValue(new Json(Json::Array, 0));
+  }
+  if (list.isArray()) {
+    bool useLimit = false;
+    Json result = list.copy();
+    size_t limit = result.size();
+    Json toRemove = ExtractFunctionParameter(trx, parameters, 1, false);
+    if (n == 3) {
+      Json limitJson = ExtractFunctionParameter(trx, parameters, 2, false);
+      if (!limitJson.isNull()) {
+        bool unused = false;
+        limit = static_cast<size_t>(ValueToNumber(limitJson.json(), unused));
+        useLimit = true;
+      }
+    }
+    for (size_t i = 0; i < result.size(); /* No increase */) {
+      if (useLimit && limit == 0) {
+        break;
+      }
+      if (TRI_CheckSameValueJson(toRemove.json(), result.at(i).json())) {
+        if (!TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, result.json(), i)) {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
         }
-        return AqlValue$(b.get());
+        --limit;
+      } else {
+        ++i;
       }
     }
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
   }
 
-  bool includeVertices = false;
+  RegisterInvalidArgumentWarning(query, "REMOVE_VALUE");
+  return AqlValue(new Json(Json::Null));
+#endif
+}
 
-  if (n == 5) {
-    // We have options
-    VPackSlice options = ExtractFunctionParameter(trx, parameters, 4);
-    if (options.isObject()) {
-      includeVertices = arangodb::basics::VelocyPackHelper::getBooleanValue(
-          options, "includeVertices", false);
+AqlValue$ Functions::RemoveValueVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  size_t const n = parameters.size();
+  if (n != 2 && n != 3) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_VALUE",
+        (int)2, (int)3);
+  }
+
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+
+  if (list.isNull()) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    {
+      VPackArrayBuilder guard(b.get());
     }
+    return AqlValue$(b.get());
   }
 
+  if (!list.isArray()) {
+    RegisterInvalidArgumentWarning(query, "REMOVE_VALUE");
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  {
+  try {
     VPackArrayBuilder guard(b.get());
-    if (vertexSlice.isArray()) {
-      for (auto const& v : VPackArrayIterator(vertexSlice)) {
-        try {
-          RequestEdges(v, trx, resolver, shaper, cid,
-                       collection->_collection->_collection, direction,
-                       matcher.get(), includeVertices, *b);
-        } catch (...) {
-          // Errors in Array are simply ignored
-        }
+    bool useLimit = false;
+    size_t limit = static_cast<size_t>(list.length());
+
+    VPackSlice toRemove = ExtractFunctionParameter(trx, parameters, 1);
+    if (n == 3) {
+      VPackSlice limitSlice = ExtractFunctionParameter(trx, parameters, 2);
+      bool unused = false;
+      if (!limitSlice.isNull()) {
+        limit = static_cast<size_t>(ValueToNumber(limitSlice, unused));
+        useLimit = true;
+      }
+    }
+    for (auto const& it : VPackArrayIterator(list)) {
+      if (useLimit && limit == 0) {
+        // Just copy
+        b->add(it);
+        continue;
+      }
+      if (arangodb::basics::VelocyPackHelper::compare(toRemove, it, false) ==
+          0) {
+        --limit;
+        continue;
       }
-    } else {
-      RequestEdges(vertexSlice, trx, resolver, shaper, cid,
-                   collection->_collection->_collection, direction,
-                   matcher.get(), includeVertices, *b);
+      b->add(it);
     }
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function ROUND
+/// @brief function REMOVE_VALUES
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Round(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
+AqlValue Functions::RemoveValues(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(RoundVPack(query, trx, tmp));
+  return AqlValue(RemoveValuesVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-
-  if (n != 1) {
+  if (n != 2) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ROUND", (int)1,
-        (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_VALUES",
+        (int)2, (int)2);
   }
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+  Json values = ExtractFunctionParameter(trx, parameters, 1, false);
 
-  Json inputJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  if (values.isNull()) {
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+  }
 
-  bool unused = false;
-  double input = TRI_ToDoubleJson(inputJson.json(), unused);
-  input = floor(input + 0.5);  // Rounds down for < x.4999 and up for > x.50000
-  return AqlValue(new Json(input));
+  if (list.isNull()) {
+    return AqlValue(new Json(Json::Array, 0));
+  }
+
+  if (list.isArray() && values.isArray()) {
+    Json result = list.copy();
+    for (size_t i = 0; i < result.size(); /* No advance */) {
+      if (ListContainsElement(values, result.at(i))) {
+        if (!TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, result.json(), i)) {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+        }
+      } else {
+        ++i;
+      }
+    }
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  }
+
+  RegisterInvalidArgumentWarning(query, "REMOVE_VALUES");
+  return AqlValue(new Json(Json::Null));
 #endif
 }
 
-AqlValue$ Functions::RoundVPack(arangodb::aql::Query* query,
-                                arangodb::AqlTransaction* trx,
-                                VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::RemoveValuesVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-
-  if (n != 1) {
+  if (n != 2) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ROUND", (int)1,
-        (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_VALUES",
+        (int)2, (int)2);
   }
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+  VPackSlice values = ExtractFunctionParameter(trx, parameters, 1);
 
-  VPackSlice inputSlice = ExtractFunctionParameter(trx, parameters, 0);
-
-  bool unused = false;
-  double input = arangodb::basics::VelocyPackHelper::toDouble(inputSlice, unused);
+  if (values.isNull()) {
+    return AqlValue$(list);
+  }
 
-  input = floor(input + 0.5);  // Rounds down for < x.4999 and up for > x.50000
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(input));
+  if (list.isNull()) {
+    {
+      VPackArrayBuilder guard(b.get());
+    }
+    return AqlValue$(b.get());
+  }
+
+  if (list.isArray() && values.isArray()) {
+    try {
+      VPackArrayBuilder guard(b.get());
+      for (auto const& it : VPackArrayIterator(list)) {
+        if (!ListContainsElement(values, it)) {
+          b->add(it);
+        }
+      }
+    } catch (...) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+    return AqlValue$(b.get());
+  }
+
+  RegisterInvalidArgumentWarning(query, "REMOVE_VALUES");
+  b->add(VPackValue(VPackValueType::Null));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function ABS
+/// @brief function REMOVE_NTH
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Abs(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
+AqlValue Functions::RemoveNth(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(AbsVPack(query, trx, tmp));
+  return AqlValue(RemoveNthVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-
-  if (n != 1) {
+  if (n != 2) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ABS", (int)1,
-        (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_NTH", (int)2,
+        (int)2);
   }
 
-  Json inputJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  bool unused = false;
-  double input = TRI_ToDoubleJson(inputJson.json(), unused);
-  input = std::abs(input);
-  return AqlValue(new Json(input));
+  if (list.isNull()) {
+    return AqlValue(new Json(Json::Array, 0));
+  }
+
+  if (list.isArray()) {
+    double const count = static_cast<double>(list.size());
+    Json position = ExtractFunctionParameter(trx, parameters, 1, false);
+    bool unused = false;
+    double p = TRI_ToDoubleJson(position.json(), unused);
+    if (p >= count || p < -count) {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+    }
+    if (p < 0) {
+      p += count;
+    }
+    Json result = list.copy();
+    if (!TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, result.json(),
+                             static_cast<size_t>(p))) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  }
+
+  RegisterInvalidArgumentWarning(query, "REMOVE_NTH");
+  return AqlValue(new Json(Json::Null));
 #endif
 }
 
-AqlValue$ Functions::AbsVPack(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::RemoveNthVPack(arangodb::aql::Query* query,
+                                    arangodb::AqlTransaction* trx,
+                                    VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-
-  if (n != 1) {
+  if (n != 2) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "ABS", (int)1,
-        (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_NTH", (int)2,
+        (int)2);
   }
 
-  VPackSlice inputSlice = ExtractFunctionParameter(trx, parameters, 0);
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
 
-  bool unused = false;
-  double input = arangodb::basics::VelocyPackHelper::toDouble(inputSlice, unused);
+  if (list.isNull()) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    {
+      VPackArrayBuilder guard(b.get());
+    }
+    return AqlValue$(b.get());
+  }
 
-  input = std::abs(input);
+  if (list.isArray()) {
+    double const count = static_cast<double>(list.length());
+    VPackSlice position = ExtractFunctionParameter(trx, parameters, 1);
+    bool unused = false;
+    double p = arangodb::basics::VelocyPackHelper::toDouble(position, unused);
+    if (p >= count || p < -count) {
+      return AqlValue$(list);
+    }
+    if (p < 0) {
+      p += count;
+    }
+    size_t cur = 0;
+    size_t target = static_cast<size_t>(p);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    try {
+      VPackArrayBuilder guard(b.get());
+      for (auto const& it : VPackArrayIterator(list)) {
+        if (cur != target) {
+          b->add(it);
+        }
+        cur++;
+      }
+    } catch (...) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+    return AqlValue$(b.get());
+  }
+
+  RegisterInvalidArgumentWarning(query, "REMOVE_NTH");
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(input));
+  b->add(VPackValue(VPackValueType::Null));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function CEIL
+/// @brief function NOT_NULL
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Ceil(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         FunctionParameters const& parameters) {
+AqlValue Functions::NotNull(arangodb::aql::Query* query,
+                            arangodb::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(CeilVPack(query, trx, tmp));
+  return AqlValue(NotNullVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "CEIL", (int)1,
-        (int)1);
+  for (size_t i = 0; i < n; ++i) {
+    Json element = ExtractFunctionParameter(trx, parameters, i, false);
+    if (!element.isNull()) {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, element.copy().steal()));
+    }
   }
-
-  Json inputJson = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  bool unused = false;
-  double input = TRI_ToDoubleJson(inputJson.json(), unused);
-  input = ceil(input);
-  return AqlValue(new Json(input));
+  return AqlValue(new Json(Json::Null));
 #endif
 }
 
-AqlValue$ Functions::CeilVPack(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::NotNullVPack(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "CEIL", (int)1,
-        (int)1);
-  }
-
-  VPackSlice inputSlice = ExtractFunctionParameter(trx, parameters, 0);
-
-  bool unused = false;
-  double input = arangodb::basics::VelocyPackHelper::toDouble(inputSlice, unused);
-
-  input = ceil(input);
+  for (size_t i = 0; i < n; ++i) {
+    VPackSlice element = ExtractFunctionParameter(trx, parameters, i);
+    if (!element.isNull()) {
+      return AqlValue$(element);
+    }
+  }
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(input));
+  b->add(VPackValue(VPackValueType::Null));
   return AqlValue$(b.get());
 }
 
+
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function FLOOR
+/// @brief function CURRENT_DATABASE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Floor(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          FunctionParameters const& parameters) {
+AqlValue Functions::CurrentDatabase(arangodb::aql::Query* query,
+                                    arangodb::AqlTransaction* trx,
+                                    FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(FloorVPack(query, trx, tmp));
+  return AqlValue(CurrentDatabaseVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-
-  if (n != 1) {
+  if (n != 0) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FLOOR", (int)1,
-        (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "CURRENT_DATABASE",
+        (int)0, (int)0);
   }
-
-  Json inputJson = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  bool unused = false;
-  double input = TRI_ToDoubleJson(inputJson.json(), unused);
-  input = floor(input);
-  return AqlValue(new Json(input));
+  return AqlValue(new Json(query->vocbase()->_name));
 #endif
 }
 
-AqlValue$ Functions::FloorVPack(arangodb::aql::Query* query,
-                                arangodb::AqlTransaction* trx,
-                                VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::CurrentDatabaseVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-
-  if (n != 1) {
+  if (n != 0) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FLOOR", (int)1,
-        (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "CURRENT_DATABASE",
+        (int)0, (int)0);
   }
-
-  VPackSlice inputSlice = ExtractFunctionParameter(trx, parameters, 0);
-
-  bool unused = false;
-  double input = arangodb::basics::VelocyPackHelper::toDouble(inputSlice, unused);
-
-  input = floor(input);
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(input));
+  b->add(VPackValue(query->vocbase()->_name));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function SQRT
+/// @brief function COLLECTION_COUNT
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Sqrt(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         FunctionParameters const& parameters) {
+AqlValue Functions::CollectionCount(arangodb::aql::Query* query,
+                                    arangodb::AqlTransaction* trx,
+                                    FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(SqrtVPack(query, trx, tmp));
+  return AqlValue(CollectionCountVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-
   if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SQRT", (int)1,
-        (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "COLLECTION_COUNT",
+        (int)1, (int)1);
   }
 
-  Json inputJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  Json element = ExtractFunctionParameter(trx, parameters, 0, false);
+  if (!element.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "COLLECTION_COUNT");
+  }
 
-  bool unused = false;
-  double input = TRI_ToDoubleJson(inputJson.json(), unused);
-  input = sqrt(input);
-  if (std::isnan(input)) {
-    return AqlValue(new Json(Json::Null));
+  std::string const colName =
+      basics::JsonHelper::getStringValue(element.json(), "");
+
+  auto resolver = trx->resolver();
+  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
+  if (cid == 0) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
   }
-  return AqlValue(new Json(input));
+
+  auto collection = trx->trxCollection(cid);
+
+  // ensure the collection is loaded
+  if (collection == nullptr) {
+    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
+                                           TRI_TRANSACTION_READ,
+                                           trx->nestingLevel(), true, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
+    }
+
+    TRI_EnsureCollectionsTransaction(trx->getInternals());
+    collection = trx->trxCollection(cid);
+
+    if (collection == nullptr) {
+      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                    "'%s'", colName.c_str());
+    }
+  }
+
+  auto document = trx->documentCollection(cid);
+
+  if (document == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
+  }
+
+  return AqlValue(new Json(static_cast<double>(document->size())));
 #endif
 }
 
-AqlValue$ Functions::SqrtVPack(arangodb::aql::Query* query,
-                               arangodb::AqlTransaction* trx,
-                               VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::CollectionCountVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-
   if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SQRT", (int)1,
-        (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "COLLECTION_COUNT",
+        (int)1, (int)1);
   }
 
-  VPackSlice inputSlice = ExtractFunctionParameter(trx, parameters, 0);
+  VPackSlice element = ExtractFunctionParameter(trx, parameters, 0);
+  if (!element.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "COLLECTION_COUNT");
+  }
 
-  bool unused = false;
-  double input = arangodb::basics::VelocyPackHelper::toDouble(inputSlice, unused);
-  input = sqrt(input);
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (std::isnan(input)) {
-    b->add(VPackValue(VPackValueType::Null));
-  } else {
-    b->add(VPackValue(input));
+  std::string const colName =
+      basics::VelocyPackHelper::getStringValue(element, "");
+
+  auto resolver = trx->resolver();
+  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
+  if (cid == 0) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
+  }
+
+  auto collection = trx->trxCollection(cid);
+
+  // ensure the collection is loaded
+  if (collection == nullptr) {
+    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
+                                           TRI_TRANSACTION_READ,
+                                           trx->nestingLevel(), true, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
+    }
+
+    TRI_EnsureCollectionsTransaction(trx->getInternals());
+    collection = trx->trxCollection(cid);
+
+    if (collection == nullptr) {
+      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                    "'%s'", colName.c_str());
+    }
+  }
+
+  auto document = trx->documentCollection(cid);
+
+  if (document == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
   }
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(document->size()));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function POW
+/// @brief function VARIANCE_SAMPLE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Pow(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
+AqlValue Functions::VarianceSample(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(PowVPack(query, trx, tmp));
+  return AqlValue(VarianceSampleVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-
-  if (n != 2) {
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POW", (int)2,
-        (int)2);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "VARIANCE_SAMPLE",
+        (int)1, (int)1);
   }
 
-  Json baseJson = ExtractFunctionParameter(trx, parameters, 0, false);
-  Json expJson = ExtractFunctionParameter(trx, parameters, 1, false);
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  bool unused = false;
-  double base = TRI_ToDoubleJson(baseJson.json(), unused);
-  double exp = TRI_ToDoubleJson(expJson.json(), unused);
-  base = pow(base, exp);
-  if (std::isnan(base) || !std::isfinite(base)) {
+  if (!list.isArray()) {
+    RegisterWarning(query, "VARIANCE_SAMPLE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
     return AqlValue(new Json(Json::Null));
   }
-  return AqlValue(new Json(base));
+
+  double value = 0.0;
+  size_t count = 0;
+
+  if (!Variance(list, value, count)) {
+    RegisterWarning(query, "VARIANCE_SAMPLE",
+                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  if (count < 2) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return AqlValue(new Json(value / (count - 1)));
 #endif
 }
 
-AqlValue$ Functions::PowVPack(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::VarianceSampleVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-
-  if (n != 2) {
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POW", (int)2,
-        (int)2);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "VARIANCE_SAMPLE",
+        (int)1, (int)1);
   }
 
-  VPackSlice baseSlice = ExtractFunctionParameter(trx, parameters, 0);
-  VPackSlice expSlice = ExtractFunctionParameter(trx, parameters, 1);
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
 
-  bool unused = false;
-  double base = arangodb::basics::VelocyPackHelper::toDouble(baseSlice, unused);
-  double exp = arangodb::basics::VelocyPackHelper::toDouble(expSlice, unused);
-  base = pow(base, exp);
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (std::isnan(base) || !std::isfinite(base)) {
+  if (!list.isArray()) {
+    RegisterWarning(query, "VARIANCE_SAMPLE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  double value = 0.0;
+  size_t count = 0;
+
+  if (!Variance(list, value, count)) {
+    RegisterWarning(query, "VARIANCE_SAMPLE",
+                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
     b->add(VPackValue(VPackValueType::Null));
-  } else {
-    b->add(VPackValue(base));
+    return AqlValue$(b.get());
+  }
+
+  if (count < 2) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
+
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(value / (count - 1)));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function RAND
+/// @brief function VARIANCE_POPULATION
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Rand(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         FunctionParameters const& parameters) {
+AqlValue Functions::VariancePopulation(arangodb::aql::Query* query,
+                                       arangodb::AqlTransaction* trx,
+                                       FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(RandVPack(query, trx, tmp));
+  return AqlValue(VariancePopulationVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-
-  if (n != 0) {
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "RAND", (int)0,
-        (int)0);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH,
+        "VARIANCE_POPULATION", (int)1, (int)1);
   }
 
-  // This Random functionality is not too good yet...
-  double output = static_cast<double>(std::rand()) / RAND_MAX;
-  return AqlValue(new Json(output));
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (!list.isArray()) {
+    RegisterWarning(query, "VARIANCE_POPULATION",
+                    TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  double value = 0.0;
+  size_t count = 0;
+
+  if (!Variance(list, value, count)) {
+    RegisterWarning(query, "VARIANCE_POPULATION",
+                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  if (count < 1) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return AqlValue(new Json(value / count));
 #endif
 }
 
-AqlValue$ Functions::RandVPack(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::VariancePopulationVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-
-  if (n != 0) {
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "RAND", (int)0,
-        (int)0);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH,
+        "VARIANCE_POPULATION", (int)1, (int)1);
+  }
+
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+
+  if (!list.isArray()) {
+    RegisterWarning(query, "VARIANCE_POPULATION",
+                    TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  double value = 0.0;
+  size_t count = 0;
+
+  if (!Variance(list, value, count)) {
+    RegisterWarning(query, "VARIANCE_POPULATION",
+                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  if (count < 1) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
 
-  // This Random functionality is not too good yet...
-  double output = static_cast<double>(std::rand()) / RAND_MAX;
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(output));
+  b->add(VPackValue(value / count));
   return AqlValue$(b.get());
 }
 
+
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function FIRST_DOCUMENT
+/// @brief function STDDEV_SAMPLE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::FirstDocument(arangodb::aql::Query* query,
-                                  arangodb::AqlTransaction* trx,
-                                  FunctionParameters const& parameters) {
+AqlValue Functions::StdDevSample(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(FirstDocumentVPack(query, trx, tmp));
+  return AqlValue(StdDevSampleVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-  for (size_t i = 0; i < n; ++i) {
-    Json element = ExtractFunctionParameter(trx, parameters, i, false);
-    if (element.isObject()) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, element.copy().steal(),
-                               Json::AUTOFREE));
-    }
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "STDDEV_SAMPLE",
+        (int)1, (int)1);
   }
-  return AqlValue(new Json(Json::Null));
+
+  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (!list.isArray()) {
+    RegisterWarning(query, "STDDEV_SAMPLE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  double value = 0.0;
+  size_t count = 0;
+
+  if (!Variance(list, value, count)) {
+    RegisterWarning(query, "STDDEV_SAMPLE",
+                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  if (count < 2) {
+    return AqlValue(new Json(Json::Null));
+  }
+
+  return AqlValue(new Json(sqrt(value / (count - 1))));
 #endif
 }
 
-AqlValue$ Functions::FirstDocumentVPack(
+AqlValue$ Functions::StdDevSampleVPack(
     arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
     VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-  for (size_t i = 0; i < n; ++i) {
-    VPackSlice element = ExtractFunctionParameter(trx, parameters, i);
-    if (element.isObject()) {
-      return AqlValue$(element);
-    }
+  if (n != 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "STDDEV_SAMPLE",
+        (int)1, (int)1);
   }
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(VPackValueType::Null));
-  return AqlValue$(b.get());
-}
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function FIRST_LIST
-////////////////////////////////////////////////////////////////////////////////
+  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
 
-AqlValue Functions::FirstList(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(FirstListVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  for (size_t i = 0; i < n; ++i) {
-    Json element = ExtractFunctionParameter(trx, parameters, i, false);
-    if (element.isArray()) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, element.copy().steal(),
-                               Json::AUTOFREE));
-    }
+  if (!list.isArray()) {
+    RegisterWarning(query, "STDDEV_SAMPLE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
-  return AqlValue(new Json(Json::Null));
-#endif
-}
 
-AqlValue$ Functions::FirstListVPack(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  for (size_t i = 0; i < n; ++i) {
-    VPackSlice element = ExtractFunctionParameter(trx, parameters, i);
-    if (element.isArray()) {
-      return AqlValue$(element);
-    }
+  double value = 0.0;
+  size_t count = 0;
+
+  if (!Variance(list, value, count)) {
+    RegisterWarning(query, "STDDEV_SAMPLE",
+                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  if (count < 2) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
+
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(VPackValueType::Null));
+  b->add(VPackValue(sqrt(value / (count - 1) )));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function PUSH
+/// @brief function STDDEV_POPULATION
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Push(arangodb::aql::Query* query,
-                         arangodb::AqlTransaction* trx,
-                         FunctionParameters const& parameters) {
+AqlValue Functions::StdDevPopulation(arangodb::aql::Query* query,
+                                     arangodb::AqlTransaction* trx,
+                                     FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(PushVPack(query, trx, tmp));
+  return AqlValue(StdDevPopulationVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-  if (n != 2 && n != 3) {
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PUSH", (int)2,
-        (int)3);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "STDDEV_POPULATION",
+        (int)1, (int)1);
   }
+
   Json list = ExtractFunctionParameter(trx, parameters, 0, false);
-  Json toPush = ExtractFunctionParameter(trx, parameters, 1, false);
 
-  if (list.isNull()) {
-    Json array(Json::Array, 1);
-    array.add(toPush.copy());
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.copy().steal()));
+  if (!list.isArray()) {
+    RegisterWarning(query, "STDDEV_POPULATION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
   }
-  if (list.isArray()) {
-    if (n == 3) {
-      Json unique = ExtractFunctionParameter(trx, parameters, 2, false);
-      if (ValueToBoolean(unique.json()) && ListContainsElement(list, toPush)) {
-        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
-      }
-    }
-    list.add(toPush.copy());
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+
+  double value = 0.0;
+  size_t count = 0;
+
+  if (!Variance(list, value, count)) {
+    RegisterWarning(query, "STDDEV_POPULATION",
+                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    return AqlValue(new Json(Json::Null));
+  }
+
+  if (count < 1) {
+    return AqlValue(new Json(Json::Null));
   }
 
-  RegisterWarning(query, "PUSH",
-                  TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-  return AqlValue(new Json(Json::Null));
+  return AqlValue(new Json(sqrt(value / count)));
 #endif
 }
 
-AqlValue$ Functions::PushVPack(arangodb::aql::Query* query,
-                               arangodb::AqlTransaction* trx,
-                               VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::StdDevPopulationVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-  if (n != 2 && n != 3) {
+  if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PUSH", (int)2,
-        (int)3);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "STDDEV_POPULATION",
+        (int)1, (int)1);
   }
+
   VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
-  VPackSlice toPush = ExtractFunctionParameter(trx, parameters, 1);
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (list.isNull()) {
-    VPackArrayBuilder guard(b.get());
-    b->add(toPush);
-  } else if (list.isArray()) {
-    VPackArrayBuilder guard(b.get());
-    for (auto const& it : VPackArrayIterator(list)) {
-      b->add(it);
-    }
-    if (n == 3) {
-      VPackSlice unique = ExtractFunctionParameter(trx, parameters, 2);
-      if (!ValueToBoolean(unique) || !ListContainsElement(list, toPush)) {
-        b->add(toPush);
-      }
-    } else {
-      b->add(toPush);
-    }
-  } else {
-    RegisterWarning(query, "PUSH",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+  if (!list.isArray()) {
+    RegisterWarning(query, "STDDEV_POPULATION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  double value = 0.0;
+  size_t count = 0;
+
+  if (!Variance(list, value, count)) {
+    RegisterWarning(query, "STDDEV_POPULATION",
+                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  if (count < 1) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
     b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
+
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(sqrt(value / count)));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function POP
+/// @brief function MEDIAN
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Pop(arangodb::aql::Query* query,
-                        arangodb::AqlTransaction* trx,
-                        FunctionParameters const& parameters) {
+AqlValue Functions::Median(arangodb::aql::Query* query,
+                           arangodb::AqlTransaction* trx,
+                           FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(PopVPack(query, trx, tmp));
+  return AqlValue(MedianVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
   if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POP", (int)1,
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "MEDIAN", (int)1,
         (int)1);
   }
+
   Json list = ExtractFunctionParameter(trx, parameters, 0, false);
 
-  if (list.isNull()) {
+  if (!list.isArray()) {
+    RegisterWarning(query, "MEDIAN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
     return AqlValue(new Json(Json::Null));
   }
-  if (list.isArray()) {
-    if (list.size() > 0) {
-      if (!TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, list.json(),
-                               list.size() - 1)) {
-        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-      }
-    }
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+
+  std::vector<double> values;
+  if (!SortNumberList(list, values)) {
+    RegisterWarning(query, "MEDIAN", TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    return AqlValue(new Json(Json::Null));
   }
 
-  RegisterWarning(query, "POP",
-                  TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-  return AqlValue(new Json(Json::Null));
+  if (values.empty()) {
+    return AqlValue(new Json(Json::Null));
+  }
+  size_t const l = values.size();
+  size_t midpoint = l / 2;
+
+  if (l % 2 == 0) {
+    return AqlValue(new Json((values[midpoint - 1] + values[midpoint]) / 2));
+  }
+  return AqlValue(new Json(values[midpoint]));
 #endif
 }
 
-AqlValue$ Functions::PopVPack(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::MedianVPack(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
   if (n != 1) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POP", (int)1,
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "MEDIAN", (int)1,
         (int)1);
   }
+
   VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (list.isNull()) {
+  if (!list.isArray()) {
+    RegisterWarning(query, "MEDIAN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  std::vector<double> values;
+  if (!SortNumberList(list, values)) {
+    RegisterWarning(query, "MEDIAN", TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  if (values.empty()) {
     std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
     b->add(VPackValue(VPackValueType::Null));
     return AqlValue$(b.get());
   }
+  size_t const l = values.size();
+  size_t midpoint = l / 2;
+
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (list.isArray()) {
-    try {
-      VPackArrayBuilder guard(b.get());
-      auto iterator = VPackArrayIterator(list);
-      while (!iterator.isLast()) {
-        b->add(iterator.value());
-        iterator.next();
-      }
-    } catch (...) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
+  if (l % 2 == 0) {
+    b->add(VPackValue((values[midpoint - 1] + values[midpoint]) / 2));
   } else {
-    RegisterWarning(query, "POP",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    b->add(VPackValue(VPackValueType::Null));
+    b->add(VPackValue(values[midpoint]));
   }
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function APPEND
+/// @brief function PERCENTILE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Append(arangodb::aql::Query* query,
-                           arangodb::AqlTransaction* trx,
-                           FunctionParameters const& parameters) {
+AqlValue Functions::Percentile(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(AppendVPack(query, trx, tmp));
+  return AqlValue(PercentileVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
   if (n != 2 && n != 3) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "APPEND", (int)2,
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PERCENTILE", (int)2,
         (int)3);
   }
+
   Json list = ExtractFunctionParameter(trx, parameters, 0, false);
-  Json toAppend = ExtractFunctionParameter(trx, parameters, 1, false);
 
-  if (toAppend.isNull()) {
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+  if (!list.isArray()) {
+    RegisterWarning(query, "PERCENTILE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return AqlValue(new Json(Json::Null));
   }
-  bool unique = false;
-  if (n == 3) {
-    Json uniqueJson = ExtractFunctionParameter(trx, parameters, 2, false);
-    unique = ValueToBoolean(uniqueJson.json());
+
+  Json border = ExtractFunctionParameter(trx, parameters, 1, false);
+
+  if (!border.isNumber()) {
+    RegisterWarning(query, "PERCENTILE",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(new Json(Json::Null));
   }
-  if (list.isNull()) {
-    // Create a JSON array instead.
-    list = Json(Json::Array, 0);
+
+  bool unused = false;
+  double p = ValueToNumber(border.json(), unused);
+  if (p <= 0 || p > 100) {
+    RegisterWarning(query, "PERCENTILE",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(new Json(Json::Null));
   }
 
-  if (!toAppend.isArray()) {
-    if (unique && ListContainsElement(list, toAppend)) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+  bool useInterpolation = false;
+
+  if (n == 3) {
+    Json methodJson = ExtractFunctionParameter(trx, parameters, 2, false);
+    if (!methodJson.isString()) {
+      RegisterWarning(query, "PERCENTILE",
+                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      return AqlValue(new Json(Json::Null));
+    }
+    std::string method =
+        arangodb::basics::JsonHelper::getStringValue(methodJson.json(), "");
+    if (method == "interpolation") {
+      useInterpolation = true;
+    } else if (method == "rank") {
+      useInterpolation = false;
+    } else {
+      RegisterWarning(query, "PERCENTILE",
+                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      return AqlValue(new Json(Json::Null));
     }
-    list.reserve(1);
-    list.add(toAppend.copy());
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
   }
 
-  size_t const expectedInserts = toAppend.size();
+  std::vector<double> values;
+  if (!SortNumberList(list, values)) {
+    RegisterWarning(query, "PERCENTILE",
+                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    return AqlValue(new Json(Json::Null));
+  }
 
-  list.reserve(expectedInserts);
+  if (values.empty()) {
+    return AqlValue(new Json(Json::Null));
+  }
+  size_t l = values.size();
+  if (l == 1) {
+    return AqlValue(new Json(values[0]));
+  }
 
-  for (size_t i = 0; i < expectedInserts; ++i) {
-    auto toPush = toAppend.at(i);
-    if (unique && ListContainsElement(list, toPush)) {
-      continue;
+  TRI_ASSERT(l > 1);
+
+  if (useInterpolation) {
+    double idx = p * (l + 1) / 100;
+    double pos = floor(idx);
+
+    if (pos >= l) {
+      return AqlValue(new Json(values[l - 1]));
     }
-    list.add(toPush.copy());
+
+    if (pos <= 0) {
+      return AqlValue(new Json(Json::Null));
+    }
+
+    double delta = idx - pos;
+    return AqlValue(new Json(delta * (values[static_cast<size_t>(pos)] -
+                                      values[static_cast<size_t>(pos) - 1]) +
+                             values[static_cast<size_t>(pos) - 1]));
+  }
+  double idx = p * l / 100;
+  double pos = ceil(idx);
+  if (pos >= l) {
+    return AqlValue(new Json(values[l - 1]));
   }
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+  if (pos <= 0) {
+    return AqlValue(new Json(Json::Null));
+  }
+  return AqlValue(new Json(values[static_cast<size_t>(pos) - 1]));
 #endif
 }
 
-AqlValue$ Functions::AppendVPack(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::PercentileVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
   if (n != 2 && n != 3) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "APPEND", (int)2,
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PERCENTILE", (int)2,
         (int)3);
   }
+
   VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
-  VPackSlice toAppend = ExtractFunctionParameter(trx, parameters, 1);
 
-  if (toAppend.isNull()) {
-    return AqlValue$(list);
+  if (!list.isArray()) {
+    RegisterWarning(query, "PERCENTILE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
 
-  bool unique = false;
-  if (n == 3) {
-    VPackSlice uniqueSlice = ExtractFunctionParameter(trx, parameters, 2);
-    unique = ValueToBoolean(uniqueSlice);
+  VPackSlice border = ExtractFunctionParameter(trx, parameters, 1);
+
+  if (!border.isNumber()) {
+    RegisterWarning(query, "PERCENTILE",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
   }
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  {
-    VPackArrayBuilder guard(b.get());
-    if (!list.isNull()) {
-      TRI_ASSERT(list.isArray());
-      for (auto const& it : VPackArrayIterator(list)) {
-        b->add(it);
-      }
+  bool unused = false;
+  double p = ValueToNumber(border, unused);
+  if (p <= 0 || p > 100) {
+    RegisterWarning(query, "PERCENTILE",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  bool useInterpolation = false;
+
+  if (n == 3) {
+    VPackSlice methodSlice = ExtractFunctionParameter(trx, parameters, 2);
+    if (!methodSlice.isString()) {
+      RegisterWarning(query, "PERCENTILE",
+                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+      b->add(VPackValue(VPackValueType::Null));
+      return AqlValue$(b.get());
     }
-    if (!toAppend.isArray()) {
-      if (!unique || !ListContainsElement(list, toAppend)) {
-        b->add(toAppend);
-      }
+    std::string method = methodSlice.copyString();
+    if (method == "interpolation") {
+      useInterpolation = true;
+    } else if (method == "rank") {
+      useInterpolation = false;
     } else {
-      for (auto const& it : VPackArrayIterator(toAppend)) {
-        if (!unique || !ListContainsElement(list, it)) {
-          b->add(it);
-        }
-      }
+      RegisterWarning(query, "PERCENTILE",
+                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+      b->add(VPackValue(VPackValueType::Null));
+      return AqlValue$(b.get());
+    }
+  }
+
+  std::vector<double> values;
+  if (!SortNumberList(list, values)) {
+    RegisterWarning(query, "PERCENTILE",
+                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+
+  if (values.empty()) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(VPackValueType::Null));
+    return AqlValue$(b.get());
+  }
+  size_t l = values.size();
+  if (l == 1) {
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    b->add(VPackValue(values[0]));
+    return AqlValue$(b.get());
+  }
+
+  TRI_ASSERT(l > 1);
+
+  if (useInterpolation) {
+    double idx = p * (l + 1) / 100;
+    double pos = floor(idx);
+
+    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+    if (pos >= l) {
+      b->add(VPackValue(values[l - 1]));
+    } else if (pos <= 0) {
+      b->add(VPackValue(VPackValueType::Null));
+    } else {
+      double delta = idx - pos;
+      b->add(VPackValue(delta * (values[static_cast<size_t>(pos)] -
+                                 values[static_cast<size_t>(pos) - 1]) +
+                        values[static_cast<size_t>(pos) - 1]));
     }
+    return AqlValue$(b.get());
+  }
+  double idx = p * l / 100;
+  double pos = ceil(idx);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  if (pos >= l) {
+    b->add(VPackValue(values[l - 1]));
+  } else if (pos <= 0) {
+    b->add(VPackValue(VPackValueType::Null));
+  } else {
+    b->add(VPackValue(values[static_cast<size_t>(pos) - 1]));
   }
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function UNSHIFT
+/// @brief function RANGE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Unshift(arangodb::aql::Query* query,
-                            arangodb::AqlTransaction* trx,
-                            FunctionParameters const& parameters) {
+AqlValue Functions::Range(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(UnshiftVPack(query, trx, tmp));
+  return AqlValue(RangeVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
+
   if (n != 2 && n != 3) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNSHIFT", (int)2,
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "RANGE", (int)2,
         (int)3);
   }
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
-  Json toAppend = ExtractFunctionParameter(trx, parameters, 1, false);
 
-  if (list.isNull()) {
-    Json result(Json::Array, 1);
-    result.add(toAppend.copy());
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
-  }
+  auto const leftJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  auto const rightJson = ExtractFunctionParameter(trx, parameters, 1, false);
 
-  if (list.isArray()) {
-    bool unique = false;
-    if (n == 3) {
-      Json uniqueJson = ExtractFunctionParameter(trx, parameters, 2, false);
-      unique = ValueToBoolean(uniqueJson.json());
+  bool unused = true;
+  double from = ValueToNumber(leftJson.json(), unused);
+  double to = ValueToNumber(rightJson.json(), unused);
+
+  double step = 0.0;
+  if (n == 3) {
+    auto const stepJson = ExtractFunctionParameter(trx, parameters, 2, false);
+    if (!TRI_IsNullJson(stepJson.json())) {
+      step = ValueToNumber(stepJson.json(), unused);
+    } else {
+      // no step specified
+      if (from <= to) {
+        step = 1.0;
+      } else {
+        step = -1.0;
+      }
     }
-    if (unique && ListContainsElement(list, toAppend)) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
+  } else {
+    // no step specified
+    if (from <= to) {
+      step = 1.0;
+    } else {
+      step = -1.0;
     }
-    Json copy = list.copy();
-    TRI_json_t* toAppendCopy = toAppend.copy().steal();
+  }
 
-    int res =
-        TRI_InsertVector(&(copy.json()->_value._objects), toAppendCopy, 0);
-    // free the pointer, but not the contents
-    TRI_Free(TRI_UNKNOWN_MEM_ZONE, toAppendCopy);
+  if (step == 0.0 || (from < to && step < 0.0) || (from > to && step > 0.0)) {
+    RegisterWarning(query, "RANGE",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return AqlValue(new Json(Json::Null));
+  }
 
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  Json result(Json::Array);
+  if (step < 0.0 && to <= from) {
+    for (; from >= to; from += step) {
+      result.add(Json(from));
+    }
+  } else {
+    for (; from <= to; from += step) {
+      result.add(Json(from));
     }
-
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, copy.steal()));
   }
-
-  RegisterInvalidArgumentWarning(query, "UNSHIFT");
-  return AqlValue(new Json(Json::Null));
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
 #endif
 }
 
-AqlValue$ Functions::UnshiftVPack(arangodb::aql::Query* query,
-                            arangodb::AqlTransaction* trx,
-                            VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::RangeVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
+
   if (n != 2 && n != 3) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "UNSHIFT", (int)2,
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "RANGE", (int)2,
         (int)3);
   }
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (!list.isNull() && !list.isArray()) {
-    RegisterInvalidArgumentWarning(query, "UNSHIFT");
+  VPackSlice const leftSlice = ExtractFunctionParameter(trx, parameters, 0);
+  VPackSlice const rightSlice = ExtractFunctionParameter(trx, parameters, 1);
+
+  bool unused = true;
+  double from = ValueToNumber(leftSlice, unused);
+  double to = ValueToNumber(rightSlice, unused);
+
+  double step = 0.0;
+  if (n == 3) {
+    VPackSlice const stepSlice = ExtractFunctionParameter(trx, parameters, 2);
+    if (!stepSlice.isNull()) {
+      step = ValueToNumber(stepSlice, unused);
+    } else {
+      // no step specified
+      if (from <= to) {
+        step = 1.0;
+      } else {
+        step = -1.0;
+      }
+    }
+  } else {
+    // no step specified
+    if (from <= to) {
+      step = 1.0;
+    } else {
+      step = -1.0;
+    }
+  }
+
+  if (step == 0.0 || (from < to && step < 0.0) || (from > to && step > 0.0)) {
+    RegisterWarning(query, "RANGE",
+                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
     std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
     b->add(VPackValue(VPackValueType::Null));
     return AqlValue$(b.get());
   }
 
-  VPackSlice toAppend = ExtractFunctionParameter(trx, parameters, 1);
-  bool unique = false;
-  if (n == 3) {
-    VPackSlice uniqueSlice = ExtractFunctionParameter(trx, parameters, 2);
-    unique = ValueToBoolean(uniqueSlice);
-  }
-
-  if (unique && list.isArray() && ListContainsElement(list, toAppend)) {
-    // Short circuit, nothing to do return list
-    return AqlValue$(list);
-  }
-
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  {
+  try {
     VPackArrayBuilder guard(b.get());
-    b->add(toAppend);
-    if (list.isArray()) {
-      for (auto const& it : VPackArrayIterator(list)) {
-        b->add(it);
+    if (step < 0.0 && to <= from) {
+      for (; from >= to; from += step) {
+        b->add(VPackValue(from));
+      }
+    } else {
+      for (; from <= to; from += step) {
+        b->add(VPackValue(from));
       }
     }
+  } catch (...) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function SHIFT
+/// @brief function POSITION
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Shift(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          FunctionParameters const& parameters) {
+AqlValue Functions::Position(arangodb::aql::Query* query,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(ShiftVPack(query, trx, tmp));
+  return AqlValue(PositionVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-
-  if (n != 1) {
+  if (n != 2 && n != 3) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SHIFT", (int)1,
-        (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POSITION", (int)2,
+        (int)3);
   }
 
   Json list = ExtractFunctionParameter(trx, parameters, 0, false);
-  if (list.isNull()) {
+
+  if (!list.isArray()) {
+    RegisterWarning(query, "POSITION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
     return AqlValue(new Json(Json::Null));
   }
-  if (list.isArray()) {
-    if (list.size() == 0) {
-      return AqlValue(new Json(Json::Array, 0));
-    }
-    if (!TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, list.json(), 0)) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+
+  bool returnIndex = false;
+  if (n == 3) {
+    Json returnIndexJson = ExtractFunctionParameter(trx, parameters, 2, false);
+    returnIndex = ValueToBoolean(returnIndexJson.json());
+  }
+
+  if (list.size() > 0) {
+    Json searchValue = ExtractFunctionParameter(trx, parameters, 1, false);
+
+    size_t index;
+    if (ListContainsElement(list, searchValue, index)) {
+      if (returnIndex) {
+        return AqlValue(new Json(static_cast<double>(index)));
+      }
+      return AqlValue(new Json(true));
     }
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
   }
 
-  RegisterInvalidArgumentWarning(query, "SHIFT");
-  return AqlValue(new Json(Json::Null));
+  if (returnIndex) {
+    return AqlValue(new Json(-1));
+  }
+  return AqlValue(new Json(false));
 #endif
 }
 
-AqlValue$ Functions::ShiftVPack(arangodb::aql::Query* query,
-                                arangodb::AqlTransaction* trx,
-                                VPackFunctionParameters const& parameters) {
+AqlValue$ Functions::PositionVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-
-  if (n != 1) {
+  if (n != 2 && n != 3) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "SHIFT", (int)1,
-        (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POSITION", (int)2,
+        (int)3);
   }
 
   VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
-  if (list.isNull()) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+
   if (!list.isArray()) {
-    RegisterInvalidArgumentWarning(query, "SHIFT");
+    RegisterWarning(query, "POSITION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
     std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
     b->add(VPackValue(VPackValueType::Null));
     return AqlValue$(b.get());
   }
 
+  bool returnIndex = false;
+  if (n == 3) {
+    VPackSlice returnIndexSlice = ExtractFunctionParameter(trx, parameters, 2);
+    returnIndex = ValueToBoolean(returnIndexSlice);
+  }
+
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  {
-    VPackArrayBuilder guard(b.get());
-    if (list.length() > 0) {
-      auto iterator = VPackArrayIterator(list);
-      // This jumps over the first element
-      while(iterator.next()) {
-        b->add(iterator.value());
+  if (list.length() > 0) {
+    VPackSlice searchValue = ExtractFunctionParameter(trx, parameters, 1);
+
+    size_t index;
+    if (ListContainsElement(list, searchValue, index)) {
+      if (returnIndex) {
+        b->add(VPackValue(index));
+      } else {
+        b->add(VPackValue(true));
       }
+    } else {
+      if (returnIndex) {
+        b->add(VPackValue(-1));
+      } else {
+        b->add(VPackValue(false));
+      }
+    }
+  } else {
+    if (returnIndex) {
+      b->add(VPackValue(-1));
+    } else {
+      b->add(VPackValue(false));
     }
   }
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function REMOVE_VALUE
+/// @brief function FULLTEXT
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::RemoveValue(arangodb::aql::Query* query,
-                                arangodb::AqlTransaction* trx,
-                                FunctionParameters const& parameters) {
+AqlValue Functions::Fulltext(arangodb::aql::Query* query,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(RemoveValueVPack(query, trx, tmp));
+  return AqlValue(FulltextVPack(query, trx, tmp));
 #else
   size_t const n = parameters.size();
-  if (n != 2 && n != 3) {
+
+  if (n < 3 || n > 4) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_VALUE",
-        (int)2, (int)3);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FULLTEXT", (int)3,
+        (int)4);
   }
 
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+  auto resolver = trx->resolver();
 
-  if (list.isNull()) {
-    return AqlValue(new Json(Json::Array, 0));
+  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
+
+  if (!collectionJson.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
   }
-  if (list.isArray()) {
-    bool useLimit = false;
-    Json result = list.copy();
-    size_t limit = result.size();
-    Json toRemove = ExtractFunctionParameter(trx, parameters, 1, false);
-    if (n == 3) {
-      Json limitJson = ExtractFunctionParameter(trx, parameters, 2, false);
-      if (!limitJson.isNull()) {
-        bool unused = false;
-        limit = static_cast<size_t>(ValueToNumber(limitJson.json(), unused));
-        useLimit = true;
+
+  std::string colName =
+      basics::JsonHelper::getStringValue(collectionJson.json(), "");
+
+  Json attribute = ExtractFunctionParameter(trx, parameters, 1, false);
+
+  if (!attribute.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+  }
+
+  std::string attributeName =
+      basics::JsonHelper::getStringValue(attribute.json(), "");
+
+  Json queryString = ExtractFunctionParameter(trx, parameters, 2, false);
+
+  if (!queryString.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+  }
+
+  std::string queryValue =
+      basics::JsonHelper::getStringValue(queryString.json(), "");
+
+  size_t maxResults = 0;  // 0 means "all results"
+  if (n >= 4) {
+    Json limit = ExtractFunctionParameter(trx, parameters, 3, false);
+    if (!limit.isNull() && !limit.isNumber()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+    } else if (limit.isNumber()) {
+      int64_t value =
+          basics::JsonHelper::getNumericValue<int64_t>(limit.json(), 0);
+      if (value > 0) {
+        maxResults = static_cast<size_t>(value);
       }
     }
-    for (size_t i = 0; i < result.size(); /* No increase */) {
-      if (useLimit && limit == 0) {
+  }
+
+  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
+  auto collection = trx->trxCollection(cid);
+
+  // ensure the collection is loaded
+  if (collection == nullptr) {
+    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
+                                           TRI_TRANSACTION_READ,
+                                           trx->nestingLevel(), true, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
+    }
+
+    TRI_EnsureCollectionsTransaction(trx->getInternals());
+    collection = trx->trxCollection(cid);
+
+    if (collection == nullptr) {
+      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                    "'%s'", colName.c_str());
+    }
+  }
+
+  auto document = trx->documentCollection(cid);
+
+  if (document == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
+  }
+
+  arangodb::Index* index = nullptr;
+
+  std::vector<std::vector<arangodb::basics::AttributeName>> const search(
+      {{arangodb::basics::AttributeName(attributeName, false)}});
+
+  for (auto const& idx : document->allIndexes()) {
+    if (idx->type() == arangodb::Index::TRI_IDX_TYPE_FULLTEXT_INDEX) {
+      // test if index is on the correct field
+      if (arangodb::basics::AttributeName::isIdentical(idx->fields(), search,
+                                                       false)) {
+        // match!
+        index = idx;
         break;
       }
-      if (TRI_CheckSameValueJson(toRemove.json(), result.at(i).json())) {
-        if (!TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, result.json(), i)) {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-        }
-        --limit;
-      } else {
-        ++i;
-      }
     }
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
   }
 
-  RegisterInvalidArgumentWarning(query, "REMOVE_VALUE");
-  return AqlValue(new Json(Json::Null));
-#endif
-}
+  if (index == nullptr) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FULLTEXT_INDEX_MISSING,
+                                  colName.c_str());
+  }
 
-AqlValue$ Functions::RemoveValueVPack(
-    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
-    VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 2 && n != 3) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_VALUE",
-        (int)2, (int)3);
+  if (trx->orderDitch(collection) == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
 
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+  TRI_fulltext_query_t* ft =
+      TRI_CreateQueryFulltextIndex(TRI_FULLTEXT_SEARCH_MAX_WORDS, maxResults);
 
-  if (list.isNull()) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    {
-      VPackArrayBuilder guard(b.get());
-    }
-    return AqlValue$(b.get());
+  if (ft == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
 
-  if (!list.isArray()) {
-    RegisterInvalidArgumentWarning(query, "REMOVE_VALUE");
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  bool isSubstringQuery = false;
+  int res =
+      TRI_ParseQueryFulltextIndex(ft, queryValue.c_str(), &isSubstringQuery);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    TRI_FreeQueryFulltextIndex(ft);
+    THROW_ARANGO_EXCEPTION(res);
   }
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+
+  auto fulltextIndex = static_cast<arangodb::FulltextIndex*>(index);
+  // note: the following call will free "ft"!
+  TRI_fulltext_result_t* queryResult =
+      TRI_QueryFulltextIndex(fulltextIndex->internals(), ft);
+
+  if (queryResult == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+  }
+
+  auto shaper = collection->_collection->_collection->getShaper();
+  size_t const numResults = queryResult->_numDocuments;
+
   try {
-    VPackArrayBuilder guard(b.get());
-    bool useLimit = false;
-    size_t limit = static_cast<size_t>(list.length());
+    Json array(Json::Array, numResults);
 
-    VPackSlice toRemove = ExtractFunctionParameter(trx, parameters, 1);
-    if (n == 3) {
-      VPackSlice limitSlice = ExtractFunctionParameter(trx, parameters, 2);
-      bool unused = false;
-      if (!limitSlice.isNull()) {
-        limit = static_cast<size_t>(ValueToNumber(limitSlice, unused));
-        useLimit = true;
-      }
-    }
-    for (auto const& it : VPackArrayIterator(list)) {
-      if (useLimit && limit == 0) {
-        // Just copy
-        b->add(it);
-        continue;
-      }
-      if (arangodb::basics::VelocyPackHelper::compare(toRemove, it, false) ==
-          0) {
-        --limit;
-        continue;
-      }
-      b->add(it);
+    for (size_t i = 0; i < numResults; ++i) {
+      auto j =
+          ExpandShapedJson(shaper, resolver, cid,
+                           (TRI_doc_mptr_t const*)queryResult->_documents[i]);
+      array.add(j);
     }
+    TRI_FreeResultFulltextIndex(queryResult);
+
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
   } catch (...) {
+    TRI_FreeResultFulltextIndex(queryResult);
     THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
-  return AqlValue$(b.get());
+#endif
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function REMOVE_VALUES
-////////////////////////////////////////////////////////////////////////////////
-
-AqlValue Functions::RemoveValues(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(RemoveValuesVPack(query, trx, tmp));
-#else
+AqlValue$ Functions::FulltextVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
   size_t const n = parameters.size();
-  if (n != 2) {
+
+  if (n < 3 || n > 4) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_VALUES",
-        (int)2, (int)2);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FULLTEXT", (int)3,
+        (int)4);
   }
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
-  Json values = ExtractFunctionParameter(trx, parameters, 1, false);
 
-  if (values.isNull()) {
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
-  }
+  auto resolver = trx->resolver();
 
-  if (list.isNull()) {
-    return AqlValue(new Json(Json::Array, 0));
+  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
+
+  if (!collectionSlice.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
   }
 
-  if (list.isArray() && values.isArray()) {
-    Json result = list.copy();
-    for (size_t i = 0; i < result.size(); /* No advance */) {
-      if (ListContainsElement(values, result.at(i))) {
-        if (!TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, result.json(), i)) {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-        }
-      } else {
-        ++i;
-      }
-    }
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  std::string colName = collectionSlice.copyString();
+
+  VPackSlice attribute = ExtractFunctionParameter(trx, parameters, 1);
+
+  if (!attribute.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
   }
 
-  RegisterInvalidArgumentWarning(query, "REMOVE_VALUES");
-  return AqlValue(new Json(Json::Null));
-#endif
-}
+  std::string attributeName = attribute.copyString();
 
-AqlValue$ Functions::RemoveValuesVPack(
-    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
-    VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 2) {
+  VPackSlice queryString = ExtractFunctionParameter(trx, parameters, 2);
+
+  if (!queryString.isString()) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_VALUES",
-        (int)2, (int)2);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
   }
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
-  VPackSlice values = ExtractFunctionParameter(trx, parameters, 1);
 
-  if (values.isNull()) {
-    return AqlValue$(list);
+  std::string queryValue = queryString.copyString();
+
+  size_t maxResults = 0;  // 0 means "all results"
+  if (n >= 4) {
+    VPackSlice limit = ExtractFunctionParameter(trx, parameters, 3);
+    if (!limit.isNull() && !limit.isNumber()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+    } else if (limit.isNumber()) {
+      int64_t value = limit.getNumericValue<int64_t>();
+      if (value > 0) {
+        maxResults = static_cast<size_t>(value);
+      }
+    }
   }
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (list.isNull()) {
-    {
-      VPackArrayBuilder guard(b.get());
+  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
+  auto collection = trx->trxCollection(cid);
+
+  // ensure the collection is loaded
+  if (collection == nullptr) {
+    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
+                                           TRI_TRANSACTION_READ,
+                                           trx->nestingLevel(), true, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
+    }
+
+    TRI_EnsureCollectionsTransaction(trx->getInternals());
+    collection = trx->trxCollection(cid);
+
+    if (collection == nullptr) {
+      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
+                                    "'%s'", colName.c_str());
     }
-    return AqlValue$(b.get());
   }
 
-  if (list.isArray() && values.isArray()) {
-    try {
-      VPackArrayBuilder guard(b.get());
-      for (auto const& it : VPackArrayIterator(list)) {
-        if (!ListContainsElement(values, it)) {
-          b->add(it);
-        }
+  auto document = trx->documentCollection(cid);
+
+  if (document == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
+  }
+
+  arangodb::Index* index = nullptr;
+
+  std::vector<std::vector<arangodb::basics::AttributeName>> const search(
+      {{arangodb::basics::AttributeName(attributeName, false)}});
+
+  for (auto const& idx : document->allIndexes()) {
+    if (idx->type() == arangodb::Index::TRI_IDX_TYPE_FULLTEXT_INDEX) {
+      // test if index is on the correct field
+      if (arangodb::basics::AttributeName::isIdentical(idx->fields(), search,
+                                                       false)) {
+        // match!
+        index = idx;
+        break;
       }
-    } catch (...) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
     }
-    return AqlValue$(b.get());
   }
 
-  RegisterInvalidArgumentWarning(query, "REMOVE_VALUES");
-  b->add(VPackValue(VPackValueType::Null));
-  return AqlValue$(b.get());
-}
-
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function REMOVE_NTH
-////////////////////////////////////////////////////////////////////////////////
+  if (index == nullptr) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FULLTEXT_INDEX_MISSING,
+                                  colName.c_str());
+  }
 
-AqlValue Functions::RemoveNth(arangodb::aql::Query* query,
-                              arangodb::AqlTransaction* trx,
-                              FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(RemoveNthVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  if (n != 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_NTH", (int)2,
-        (int)2);
+  if (trx->orderDitch(collection) == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
 
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+  TRI_fulltext_query_t* ft =
+      TRI_CreateQueryFulltextIndex(TRI_FULLTEXT_SEARCH_MAX_WORDS, maxResults);
 
-  if (list.isNull()) {
-    return AqlValue(new Json(Json::Array, 0));
+  if (ft == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
 
-  if (list.isArray()) {
-    double const count = static_cast<double>(list.size());
-    Json position = ExtractFunctionParameter(trx, parameters, 1, false);
-    bool unused = false;
-    double p = TRI_ToDoubleJson(position.json(), unused);
-    if (p >= count || p < -count) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, list.copy().steal()));
-    }
-    if (p < 0) {
-      p += count;
-    }
-    Json result = list.copy();
-    if (!TRI_DeleteArrayJson(TRI_UNKNOWN_MEM_ZONE, result.json(),
-                             static_cast<size_t>(p))) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-    }
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  bool isSubstringQuery = false;
+  int res =
+      TRI_ParseQueryFulltextIndex(ft, queryValue.c_str(), &isSubstringQuery);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    TRI_FreeQueryFulltextIndex(ft);
+    THROW_ARANGO_EXCEPTION(res);
   }
 
-  RegisterInvalidArgumentWarning(query, "REMOVE_NTH");
-  return AqlValue(new Json(Json::Null));
-#endif
-}
+  auto fulltextIndex = static_cast<arangodb::FulltextIndex*>(index);
+  // note: the following call will free "ft"!
+  TRI_fulltext_result_t* queryResult =
+      TRI_QueryFulltextIndex(fulltextIndex->internals(), ft);
 
-AqlValue$ Functions::RemoveNthVPack(arangodb::aql::Query* query,
-                                    arangodb::AqlTransaction* trx,
-                                    VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "REMOVE_NTH", (int)2,
-        (int)2);
+  if (queryResult == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
   }
 
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+  auto shaper = collection->_collection->_collection->getShaper();
+  size_t const numResults = queryResult->_numDocuments;
 
-  if (list.isNull()) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    {
-      VPackArrayBuilder guard(b.get());
-    }
-    return AqlValue$(b.get());
-  }
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  try {
+    VPackArrayBuilder guard(b.get());
 
-  if (list.isArray()) {
-    double const count = static_cast<double>(list.length());
-    VPackSlice position = ExtractFunctionParameter(trx, parameters, 1);
-    bool unused = false;
-    double p = arangodb::basics::VelocyPackHelper::toDouble(position, unused);
-    if (p >= count || p < -count) {
-      return AqlValue$(list);
-    }
-    if (p < 0) {
-      p += count;
-    }
-    size_t cur = 0;
-    size_t target = static_cast<size_t>(p);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    try {
-      VPackArrayBuilder guard(b.get());
-      for (auto const& it : VPackArrayIterator(list)) {
-        if (cur != target) {
-          b->add(it);
-        }
-        cur++;
-      }
-    } catch (...) {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    for (size_t i = 0; i < numResults; ++i) {
+      std::unordered_set<std::string> unused;
+      ExpandShapedJson(shaper, resolver, cid,
+                       (TRI_doc_mptr_t const*)queryResult->_documents[i], *b,
+                       false, unused);
     }
-    return AqlValue$(b.get());
+  } catch (...) {
+    TRI_FreeResultFulltextIndex(queryResult);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
   }
-
-  RegisterInvalidArgumentWarning(query, "REMOVE_NTH");
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(VPackValueType::Null));
+  TRI_FreeResultFulltextIndex(queryResult);
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function NOT_NULL
+/// @brief function IS_SAME_COLLECTION
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::NotNull(arangodb::aql::Query* query,
-                            arangodb::AqlTransaction* trx,
-                            FunctionParameters const& parameters) {
+AqlValue Functions::IsSameCollection(arangodb::aql::Query* query,
+                                     arangodb::AqlTransaction* trx,
+                                     FunctionParameters const& parameters) {
 #ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(NotNullVPack(query, trx, tmp));
+  return AqlValue(IsSameCollectionVPack(query, trx, tmp));
 #else
-  size_t const n = parameters.size();
-  for (size_t i = 0; i < n; ++i) {
-    Json element = ExtractFunctionParameter(trx, parameters, i, false);
-    if (!element.isNull()) {
-      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, element.copy().steal()));
-    }
+  if (parameters.size() != 2) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "IS_SAME_COLLECTION", (int) 2, (int) 2);
   }
-  return AqlValue(new Json(Json::Null));
-#endif
-}
+  
+  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
 
-AqlValue$ Functions::NotNullVPack(arangodb::aql::Query* query,
-                                  arangodb::AqlTransaction* trx,
-                                  VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  for (size_t i = 0; i < n; ++i) {
-    VPackSlice element = ExtractFunctionParameter(trx, parameters, i);
-    if (!element.isNull()) {
-      return AqlValue$(element);
-    }
+  if (! collectionJson.isString()) {
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "IS_SAME_COLLECTION");
   }
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(VPackValueType::Null));
-  return AqlValue$(b.get());
-}
 
+  std::string colName = basics::JsonHelper::getStringValue(collectionJson.json(), "");
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function CURRENT_DATABASE
-////////////////////////////////////////////////////////////////////////////////
+  Json value = ExtractFunctionParameter(trx, parameters, 1, false);
+  std::string identifier;
 
-AqlValue Functions::CurrentDatabase(arangodb::aql::Query* query,
-                                    arangodb::AqlTransaction* trx,
-                                    FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(CurrentDatabaseVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  if (n != 0) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "CURRENT_DATABASE",
-        (int)0, (int)0);
+  if (value.isObject() && value.has(TRI_VOC_ATTRIBUTE_ID)) {
+    identifier = arangodb::basics::JsonHelper::getStringValue(value.get(TRI_VOC_ATTRIBUTE_ID).json(), "");
   }
-  return AqlValue(new Json(query->vocbase()->_name));
+  else if (value.isString()) {
+    identifier = arangodb::basics::JsonHelper::getStringValue(value.json(), "");
+  }
+
+  if (! identifier.empty()) {
+    size_t pos = identifier.find('/');
+
+    if (pos != std::string::npos) {
+      bool const same = (colName == identifier.substr(0, pos));
+
+      return AqlValue(new Json(same));
+    }
+
+    // fallthrough intentional
+ }
+
+  RegisterWarning(query, "IS_SAME_COLLECTION", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+  return AqlValue(new Json(Json::Null));
 #endif
 }
 
-AqlValue$ Functions::CurrentDatabaseVPack(
+AqlValue$ Functions::IsSameCollectionVPack(
     arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
     VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 0) {
+  if (parameters.size() != 2) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "CURRENT_DATABASE",
-        (int)0, (int)0);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "IS_SAME_COLLECTION",
+        (int)2, (int)2);
   }
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(query->vocbase()->_name));
-  return AqlValue$(b.get());
-}
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function COLLECTION_COUNT
-////////////////////////////////////////////////////////////////////////////////
+  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
 
-AqlValue Functions::CollectionCount(arangodb::aql::Query* query,
-                                    arangodb::AqlTransaction* trx,
-                                    FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
-  auto tmp = transformParameters(parameters, trx);
-  return AqlValue(CollectionCountVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  if (n != 1) {
+  if (!collectionSlice.isString()) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "COLLECTION_COUNT",
-        (int)1, (int)1);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "IS_SAME_COLLECTION");
   }
 
-  Json element = ExtractFunctionParameter(trx, parameters, 0, false);
-  if (!element.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "COLLECTION_COUNT");
-  }
+  std::string colName = collectionSlice.copyString();
 
-  std::string const colName =
-      basics::JsonHelper::getStringValue(element.json(), "");
+  VPackSlice value = ExtractFunctionParameter(trx, parameters, 1);
+  std::string identifier;
 
-  auto resolver = trx->resolver();
-  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
-  if (cid == 0) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
+  if (value.isObject() && value.hasKey(TRI_VOC_ATTRIBUTE_ID)) {
+    identifier = arangodb::basics::VelocyPackHelper::getStringValue(
+        value, TRI_VOC_ATTRIBUTE_ID, "");
+  } else if (value.isString()) {
+    identifier = value.copyString();
   }
 
-  auto collection = trx->trxCollection(cid);
-
-  // ensure the collection is loaded
-  if (collection == nullptr) {
-    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
-                                           TRI_TRANSACTION_READ,
-                                           trx->nestingLevel(), true, true);
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
-    }
+  if (!identifier.empty()) {
+    size_t pos = identifier.find('/');
 
-    TRI_EnsureCollectionsTransaction(trx->getInternals());
-    collection = trx->trxCollection(cid);
+    if (pos != std::string::npos) {
+      bool const same = (colName == identifier.substr(0, pos));
 
-    if (collection == nullptr) {
-      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
-                                    "'%s'", colName.c_str());
+      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+      b->add(VPackValue(same));
+      return AqlValue$(b.get());
     }
+
+    // fallthrough intentional
   }
 
-  auto document = trx->documentCollection(cid);
+  RegisterWarning(query, "IS_SAME_COLLECTION",
+                  TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(VPackValueType::Null));
+  return AqlValue$(b.get());
+}
 
-  if (document == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CONCAT_SEPARATOR
+////////////////////////////////////////////////////////////////////////////////
 
-  return AqlValue(new Json(static_cast<double>(document->size())));
-#endif
+AqlValue Functions::ConcatSeparator(arangodb::aql::Query* query,
+                                    arangodb::AqlTransaction* trx,
+                                    FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(ConcatSeparatorVPack(query, trx, tmp));
 }
 
-AqlValue$ Functions::CollectionCountVPack(
+AqlValue$ Functions::ConcatSeparatorVPack(
     arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
     VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "COLLECTION_COUNT",
-        (int)1, (int)1);
-  }
-
-  VPackSlice element = ExtractFunctionParameter(trx, parameters, 0);
-  if (!element.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "COLLECTION_COUNT");
-  }
-
-  std::string const colName =
-      basics::VelocyPackHelper::getStringValue(element, "");
+  arangodb::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  arangodb::basics::VPackStringBufferAdapter adapter(buffer.stringBuffer());
 
-  auto resolver = trx->resolver();
-  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
-  if (cid == 0) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
-  }
+  std::string const separator =
+      ValueToString(ExtractFunctionParameter(trx, parameters, 0));
+  bool found = false;
 
-  auto collection = trx->trxCollection(cid);
+  size_t const n = parameters.size();
+  for (size_t i = 1; i < n; ++i) {
+    VPackSlice const member = ExtractFunctionParameter(trx, parameters, i);
 
-  // ensure the collection is loaded
-  if (collection == nullptr) {
-    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
-                                           TRI_TRANSACTION_READ,
-                                           trx->nestingLevel(), true, true);
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
+    if (member.isNone() || member.isNull()) {
+      continue;
     }
 
-    TRI_EnsureCollectionsTransaction(trx->getInternals());
-    collection = trx->trxCollection(cid);
+    if (found) {
+      buffer.appendText(separator);
+    }
 
-    if (collection == nullptr) {
-      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
-                                    "'%s'", colName.c_str());
+    if (member.isArray()) {
+      // the members of arrays are joined using the separator, too
+      found = false;
+      for (auto const& sub : VPackArrayIterator(member)) {
+        if (sub.isNone() || sub.isNull()) {
+          continue;
+        }
+        if (found) {
+          buffer.appendText(separator);
+        }
+        AppendAsString(adapter, sub);
+        found = true;
+      }
+    } else {
+      AppendAsString(adapter, member);
     }
+    found = true;
   }
 
-  auto document = trx->documentCollection(cid);
-
-  if (document == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
-  }
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(document->size()));
+  b->add(VPackValuePair(buffer.c_str(), buffer.length(), VPackValueType::String));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function VARIANCE_SAMPLE
+/// @brief function CHAR_LENGTH
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::VarianceSample(arangodb::aql::Query* query,
-                                   arangodb::AqlTransaction* trx,
-                                   FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
+AqlValue Functions::CharLength(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               FunctionParameters const& parameters) {
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(VarianceSampleVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "VARIANCE_SAMPLE",
-        (int)1, (int)1);
-  }
+  return AqlValue(CharLengthVPack(query, trx, tmp));
+}
 
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+AqlValue$ Functions::CharLengthVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  icu::UnicodeString const value =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 0));
+  return NumberValue(query, static_cast<double>(value.length()));
+}
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "VARIANCE_SAMPLE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LOWER
+////////////////////////////////////////////////////////////////////////////////
 
-  double value = 0.0;
-  size_t count = 0;
+AqlValue Functions::Lower(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(LowerVPack(query, trx, tmp));
+}
 
-  if (!Variance(list, value, count)) {
-    RegisterWarning(query, "VARIANCE_SAMPLE",
-                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    return AqlValue(new Json(Json::Null));
-  }
+AqlValue$ Functions::LowerVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  std::string const value =
+      ValueToString(ExtractFunctionParameter(trx, parameters, 0));
+  return StringValue(
+      query, arangodb::basics::Utf8Helper::DefaultUtf8Helper.toLowerCase(value));
+}
 
-  if (count < 2) {
-    return AqlValue(new Json(Json::Null));
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UPPER
+////////////////////////////////////////////////////////////////////////////////
 
-  return AqlValue(new Json(value / (count - 1)));
-#endif
+AqlValue Functions::Upper(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(UpperVPack(query, trx, tmp));
 }
 
-AqlValue$ Functions::VarianceSampleVPack(
+AqlValue$ Functions::UpperVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  std::string const value =
+      ValueToString(ExtractFunctionParameter(trx, parameters, 0));
+  return StringValue(
+      query, arangodb::basics::Utf8Helper::DefaultUtf8Helper.toUpperCase(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SUBSTRING
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Substring(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(SubstringVPack(query, trx, tmp));
+}
+
+AqlValue$ Functions::SubstringVPack(
     arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
     VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "VARIANCE_SAMPLE",
-        (int)1, (int)1);
-  }
+  icu::UnicodeString const value =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 0));
 
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+  bool unused;
+  double const offset =
+      ValueToNumber(ExtractFunctionParameter(trx, parameters, 1), unused);
+  double length = static_cast<double>(value.length());
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "VARIANCE_SAMPLE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  if (parameters.size() > 2) {
+    length = ValueToNumber(ExtractFunctionParameter(trx, parameters, 2), unused);
   }
 
-  double value = 0.0;
-  size_t count = 0;
+  return UnicodeStringValue(query, Substr(value, offset, length));
+}
 
-  if (!Variance(list, value, count)) {
-    RegisterWarning(query, "VARIANCE_SAMPLE",
-                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CONTAINS
+////////////////////////////////////////////////////////////////////////////////
 
-  if (count < 2) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+AqlValue Functions::Contains(arangodb::aql::Query* query,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(ContainsVPack(query, trx, tmp));
+}
+
+AqlValue$ Functions::ContainsVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
+  icu::UnicodeString const value =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 0));
+  icu::UnicodeString const search =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 1));
+  bool const returnIndex =
+      ValueToBoolean(ExtractFunctionParameter(trx, parameters, 2));
+
+  int32_t result = -1;
+  if (!search.isEmpty()) {
+    result = IndexOf(value, search, 0.0);
   }
 
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(value / (count - 1)));
+  if (returnIndex) {
+    b->add(VPackValue(static_cast<double>(result)));
+  } else {
+    b->add(VPackValue(result != -1));
+  }
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function VARIANCE_POPULATION
+/// @brief function LEFT
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::VariancePopulation(arangodb::aql::Query* query,
-                                       arangodb::AqlTransaction* trx,
-                                       FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
+AqlValue Functions::Left(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(VariancePopulationVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH,
-        "VARIANCE_POPULATION", (int)1, (int)1);
-  }
+  return AqlValue(LeftVPack(query, trx, tmp));
+}
 
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+AqlValue$ Functions::LeftVPack(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               VPackFunctionParameters const& parameters) {
+  icu::UnicodeString const value =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 0));
+  bool unused;
+  double const length =
+      ValueToNumber(ExtractFunctionParameter(trx, parameters, 1), unused);
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "VARIANCE_POPULATION",
-                    TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
-  }
+  return UnicodeStringValue(query, Substr(value, 0.0, length));
+}
 
-  double value = 0.0;
-  size_t count = 0;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function RIGHT
+////////////////////////////////////////////////////////////////////////////////
 
-  if (!Variance(list, value, count)) {
-    RegisterWarning(query, "VARIANCE_POPULATION",
-                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    return AqlValue(new Json(Json::Null));
-  }
+AqlValue Functions::Right(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(RightVPack(query, trx, tmp));
+}
 
-  if (count < 1) {
-    return AqlValue(new Json(Json::Null));
-  }
+AqlValue$ Functions::RightVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  icu::UnicodeString const value =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 0));
+  bool unused;
+  double const length =
+      ValueToNumber(ExtractFunctionParameter(trx, parameters, 1), unused);
+  double const left =
+      (std::max)(static_cast<double>(value.length()) - length, 0.0);
 
-  return AqlValue(new Json(value / count));
-#endif
+  return UnicodeStringValue(query, Substr(value, left, length));
 }
 
-AqlValue$ Functions::VariancePopulationVPack(
-    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
-    VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH,
-        "VARIANCE_POPULATION", (int)1, (int)1);
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TRIM
+////////////////////////////////////////////////////////////////////////////////
 
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+AqlValue Functions::Trim(arangodb::aql::Query* query,
+                         arangodb::AqlTransaction* trx,
+                         FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(TrimVPack(query, trx, tmp));
+}
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "VARIANCE_POPULATION",
-                    TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+AqlValue$ Functions::TrimVPack(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               VPackFunctionParameters const& parameters) {
+  icu::UnicodeString const value =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 0));
+  VPackSlice const chars = ExtractFunctionParameter(trx, parameters, 1);
 
-  double value = 0.0;
-  size_t count = 0;
+  if (chars.isNone() || chars.isNull()) {
+    return UnicodeStringValue(query, ::Trim(value, true, true, nullptr));
+  }
 
-  if (!Variance(list, value, count)) {
-    RegisterWarning(query, "VARIANCE_POPULATION",
-                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  if (chars.isNumber()) {
+    // 0 = both sides, 1 = left, 2 = right, all trimming whitespace
+    double const type = chars.getNumericValue<double>();
+    if (type == 0.0) {
+      return UnicodeStringValue(query, ::Trim(value, true, true, nullptr));
+    }
+    if (type == 1.0) {
+      return UnicodeStringValue(query, ::Trim(value, true, false, nullptr));
+    }
+    if (type == 2.0) {
+      return UnicodeStringValue(query, ::Trim(value, false, true, nullptr));
+    }
   }
 
-  if (count < 1) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  icu::UnicodeString const set = ValueToUnicodeString(chars);
+  return UnicodeStringValue(query, ::Trim(value, true, true, &set));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shared implementation of LTRIM and RTRIM
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue$ TrimSide(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          VPackFunctionParameters const& parameters, bool left,
+                          bool right) {
+  icu::UnicodeString const value =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 0));
+  VPackSlice const chars = ExtractFunctionParameter(trx, parameters, 1);
+
+  if (chars.isNone() || chars.isNull()) {
+    return UnicodeStringValue(query, Trim(value, left, right, nullptr));
   }
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(value / count));
-  return AqlValue$(b.get());
+  icu::UnicodeString const set = ValueToUnicodeString(chars);
+  return UnicodeStringValue(query, Trim(value, left, right, &set));
 }
 
-
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function STDDEV_SAMPLE
+/// @brief function LTRIM
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::StdDevSample(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
+AqlValue Functions::LTrim(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(StdDevSampleVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "STDDEV_SAMPLE",
-        (int)1, (int)1);
-  }
+  return AqlValue(LTrimVPack(query, trx, tmp));
+}
 
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+AqlValue$ Functions::LTrimVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  return TrimSide(query, trx, parameters, true, false);
+}
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "STDDEV_SAMPLE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function RTRIM
+////////////////////////////////////////////////////////////////////////////////
 
-  double value = 0.0;
-  size_t count = 0;
+AqlValue Functions::RTrim(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(RTrimVPack(query, trx, tmp));
+}
 
-  if (!Variance(list, value, count)) {
-    RegisterWarning(query, "STDDEV_SAMPLE",
-                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    return AqlValue(new Json(Json::Null));
-  }
+AqlValue$ Functions::RTrimVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  return TrimSide(query, trx, parameters, false, true);
+}
 
-  if (count < 2) {
-    return AqlValue(new Json(Json::Null));
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIND_FIRST
+////////////////////////////////////////////////////////////////////////////////
 
-  return AqlValue(new Json(sqrt(value / (count - 1))));
-#endif
+AqlValue Functions::FindFirst(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(FindFirstVPack(query, trx, tmp));
 }
 
-AqlValue$ Functions::StdDevSampleVPack(
+AqlValue$ Functions::FindFirstVPack(
     arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
     VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "STDDEV_SAMPLE",
-        (int)1, (int)1);
-  }
+  icu::UnicodeString const value =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 0));
+  icu::UnicodeString const search =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 1));
+  VPackSlice const startParam = ExtractFunctionParameter(trx, parameters, 2);
+  VPackSlice const endParam = ExtractFunctionParameter(trx, parameters, 3);
 
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+  bool unused;
+  double start = 0.0;
+  if (!startParam.isNone() && !startParam.isNull()) {
+    start = ValueToNumber(startParam, unused);
+    if (start < 0.0) {
+      return NumberValue(query, -1.0);
+    }
+  }
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "STDDEV_SAMPLE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  if (!endParam.isNone() && !endParam.isNull()) {
+    double const end = ValueToNumber(endParam, unused);
+    if (end < start || end < 0.0) {
+      return NumberValue(query, -1.0);
+    }
+    return NumberValue(
+        query, static_cast<double>(
+                   IndexOf(Substr(value, 0.0, end + 1.0), search, start)));
   }
 
-  double value = 0.0;
-  size_t count = 0;
+  return NumberValue(query, static_cast<double>(IndexOf(value, search, start)));
+}
 
-  if (!Variance(list, value, count)) {
-    RegisterWarning(query, "STDDEV_SAMPLE",
-                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIND_LAST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::FindLast(arangodb::aql::Query* query,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(FindLastVPack(query, trx, tmp));
+}
+
+AqlValue$ Functions::FindLastVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
+  icu::UnicodeString const value =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 0));
+  icu::UnicodeString const search =
+      ValueToUnicodeString(ExtractFunctionParameter(trx, parameters, 1));
+  VPackSlice const startParam = ExtractFunctionParameter(trx, parameters, 2);
+  VPackSlice const endParam = ExtractFunctionParameter(trx, parameters, 3);
+
+  bool unused;
+  bool const hasStart = (!startParam.isNone() && !startParam.isNull());
+  bool const hasEnd = (!endParam.isNone() && !endParam.isNull());
+  double const start = hasStart ? ValueToNumber(startParam, unused) : 0.0;
+  double end = 0.0;
+
+  if (hasEnd) {
+    end = ValueToNumber(endParam, unused);
+    if ((hasStart && end < start) || end < 0.0) {
+      return NumberValue(query, -1.0);
+    }
   }
 
-  if (count < 2) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  if ((hasStart && start > 0.0) || hasEnd) {
+    double length = static_cast<double>(value.length());
+    if (hasEnd) {
+      length = end - start + 1.0;
+    }
+    int32_t result = LastIndexOf(Substr(value, start, length), search);
+    if (result != -1) {
+      result += static_cast<int32_t>(std::trunc(start));
+    }
+    return NumberValue(query, static_cast<double>(result));
   }
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(sqrt(value / (count - 1) )));
-  return AqlValue$(b.get());
+  return NumberValue(query, static_cast<double>(LastIndexOf(value, search)));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function STDDEV_POPULATION
+/// @brief function SPLIT
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::StdDevPopulation(arangodb::aql::Query* query,
-                                     arangodb::AqlTransaction* trx,
-                                     FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
+AqlValue Functions::Split(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          FunctionParameters const& parameters) {
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(StdDevPopulationVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "STDDEV_POPULATION",
-        (int)1, (int)1);
-  }
-
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+  return AqlValue(SplitVPack(query, trx, tmp));
+}
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "STDDEV_POPULATION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
-  }
+AqlValue$ Functions::SplitVPack(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                VPackFunctionParameters const& parameters) {
+  VPackSlice const valueParam = ExtractFunctionParameter(trx, parameters, 0);
+  VPackSlice const separatorParam =
+      ExtractFunctionParameter(trx, parameters, 1);
+  VPackSlice const limitParam = ExtractFunctionParameter(trx, parameters, 2);
 
-  double value = 0.0;
-  size_t count = 0;
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
 
-  if (!Variance(list, value, count)) {
-    RegisterWarning(query, "STDDEV_POPULATION",
-                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    return AqlValue(new Json(Json::Null));
+  if (separatorParam.isNone() || separatorParam.isNull()) {
+    b->openArray();
+    b->add(VPackValue(ValueToString(valueParam)));
+    b->close();
+    return AqlValue$(b.get());
   }
 
-  if (count < 1) {
-    return AqlValue(new Json(Json::Null));
+  double limit = 4294967295.0;
+  if (!limitParam.isNone() && !limitParam.isNull()) {
+    bool unused;
+    limit = ValueToNumber(limitParam, unused);
+    if (limit < 0.0) {
+      RegisterInvalidArgumentWarning(query, "SPLIT");
+      return NullValue(query);
+    }
+    limit = std::trunc(limit);
   }
 
-  return AqlValue(new Json(sqrt(value / count)));
-#endif
-}
+  icu::UnicodeString const value = ValueToUnicodeString(valueParam);
+  std::vector<icu::UnicodeString> separators;
 
-AqlValue$ Functions::StdDevPopulationVPack(
-    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
-    VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "STDDEV_POPULATION",
-        (int)1, (int)1);
+  if (separatorParam.isArray()) {
+    for (auto const& it : VPackArrayIterator(separatorParam)) {
+      separators.emplace_back(ValueToUnicodeString(it));
+    }
+  } else {
+    separators.emplace_back(ValueToUnicodeString(separatorParam));
   }
 
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+  auto addPart = [&b](icu::UnicodeString const& part) {
+    std::string utf8;
+    part.toUTF8String(utf8);
+    b->add(VPackValue(utf8));
+  };
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "STDDEV_POPULATION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
+  b->openArray();
+
+  if (limit == 0.0) {
+    b->close();
     return AqlValue$(b.get());
   }
 
-  double value = 0.0;
-  size_t count = 0;
+  int32_t const size = value.length();
 
-  if (!Variance(list, value, count)) {
-    RegisterWarning(query, "STDDEV_POPULATION",
-                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
+  if (size == 0) {
+    bool matchesEmpty = separators.empty();
+    for (auto const& it : separators) {
+      if (it.isEmpty()) {
+        matchesEmpty = true;
+        break;
+      }
+    }
+    if (!matchesEmpty) {
+      addPart(value);
+    }
+    b->close();
     return AqlValue$(b.get());
   }
 
-  if (count < 1) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  // the splitting algorithm of String.prototype.split()
+  double parts = 0.0;
+  int32_t p = 0;
+  int32_t q = 0;
+
+  while (q < size) {
+    size_t which = 0;
+    int32_t const match = FindAnyOf(value, q, separators, which);
+    if (match == -1 || match >= size) {
+      break;
+    }
+
+    int32_t const e = match + separators[which].length();
+    if (e == p) {
+      q = match + 1;
+      continue;
+    }
+
+    addPart(value.tempSubString(p, match - p));
+    if (++parts == limit) {
+      b->close();
+      return AqlValue$(b.get());
+    }
+    p = e;
+    q = p;
   }
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(sqrt(value / count)));
+  addPart(value.tempSubString(p));
+  b->close();
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function MEDIAN
+/// @brief function SUBSTITUTE
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Median(arangodb::aql::Query* query,
-                           arangodb::AqlTransaction* trx,
-                           FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
+AqlValue Functions::Substitute(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               FunctionParameters const& parameters) {
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(MedianVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "MEDIAN", (int)1,
-        (int)1);
-  }
+  return AqlValue(SubstituteVPack(query, trx, tmp));
+}
 
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+AqlValue$ Functions::SubstituteVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  VPackSlice const valueParam = ExtractFunctionParameter(trx, parameters, 0);
+  VPackSlice const search = ExtractFunctionParameter(trx, parameters, 1);
+  VPackSlice const replace = ExtractFunctionParameter(trx, parameters, 2);
+
+  icu::UnicodeString const value = ValueToUnicodeString(valueParam);
+  std::vector<icu::UnicodeString> patterns;
+  std::vector<icu::UnicodeString> replacements;
+  VPackSlice limitParam;
+
+  if (search.isObject()) {
+    // mapping of search strings to replacements
+    for (auto const& it : VPackObjectIterator(search)) {
+      patterns.emplace_back(ValueToUnicodeString(it.key));
+      replacements.emplace_back(ValueToUnicodeString(it.value));
+    }
+    limitParam = replace;
+  } else if (search.isString()) {
+    patterns.emplace_back(ValueToUnicodeString(search));
+    if (replace.isNone() || replace.isNull()) {
+      replacements.emplace_back();
+    } else {
+      replacements.emplace_back(ValueToUnicodeString(replace));
+    }
+    limitParam = ExtractFunctionParameter(trx, parameters, 3);
+  } else if (search.isArray()) {
+    if (search.length() == 0) {
+      RegisterInvalidArgumentWarning(query, "SUBSTITUTE");
+      return UnicodeStringValue(query, value);
+    }
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "MEDIAN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
+    VPackValueLength i = 0;
+    for (auto const& it : VPackArrayIterator(search)) {
+      patterns.emplace_back(ValueToUnicodeString(it));
+      if (replace.isArray()) {
+        if (i < replace.length()) {
+          replacements.emplace_back(ValueToUnicodeString(replace.at(i)));
+        } else {
+          replacements.emplace_back();
+        }
+      } else if (replace.isNone() || replace.isNull()) {
+        replacements.emplace_back();
+      } else {
+        replacements.emplace_back(ValueToUnicodeString(replace));
+      }
+      ++i;
+    }
+    limitParam = ExtractFunctionParameter(trx, parameters, 3);
+  } else {
+    return UnicodeStringValue(query, value);
   }
 
-  std::vector<double> values;
-  if (!SortNumberList(list, values)) {
-    RegisterWarning(query, "MEDIAN", TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    return AqlValue(new Json(Json::Null));
+  if (patterns.empty() || (patterns.size() == 1 && patterns[0].isEmpty())) {
+    return UnicodeStringValue(query, value);
   }
 
-  if (values.empty()) {
-    return AqlValue(new Json(Json::Null));
+  // if the same search string is given multiple times, the last replacement
+  // for it wins
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    for (size_t j = patterns.size(); j > i + 1; --j) {
+      if (patterns[i] == patterns[j - 1]) {
+        replacements[i] = replacements[j - 1];
+        break;
+      }
+    }
   }
-  size_t const l = values.size();
-  size_t midpoint = l / 2;
 
-  if (l % 2 == 0) {
-    return AqlValue(new Json((values[midpoint - 1] + values[midpoint]) / 2));
+  bool const hasLimit = !limitParam.isNone() && !limitParam.isNull();
+  double limit = 0.0;
+  if (hasLimit) {
+    bool unused;
+    limit = ValueToNumber(limitParam, unused);
+    if (limit < 0.0) {
+      RegisterInvalidArgumentWarning(query, "SUBSTITUTE");
+      return NullValue(query);
+    }
+    limit = std::trunc(limit);
   }
-  return AqlValue(new Json(values[midpoint]));
-#endif
-}
 
-AqlValue$ Functions::MedianVPack(arangodb::aql::Query* query,
-                                 arangodb::AqlTransaction* trx,
-                                 VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 1) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "MEDIAN", (int)1,
-        (int)1);
-  }
+  icu::UnicodeString result;
+  int32_t const size = value.length();
+  int32_t position = 0;
+
+  while (position <= size) {
+    size_t which = 0;
+    int32_t const match = FindAnyOf(value, position, patterns, which);
+    if (match == -1) {
+      break;
+    }
 
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+    int32_t const length = patterns[which].length();
+    result.append(value, position, match - position);
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "MEDIAN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+    if (!hasLimit || limit-- > 0.0) {
+      result.append(replacements[which]);
+    } else {
+      result.append(value, match, length);
+    }
 
-  std::vector<double> values;
-  if (!SortNumberList(list, values)) {
-    RegisterWarning(query, "MEDIAN", TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+    position = match + length;
+    if (length == 0) {
+      // an empty search string matches between all characters
+      if (match < size) {
+        result.append(value.charAt(match));
+      }
+      ++position;
+    }
   }
 
-  if (values.empty()) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
+  if (position < size) {
+    result.append(value, position, size - position);
   }
-  size_t const l = values.size();
-  size_t midpoint = l / 2;
+
+  return UnicodeStringValue(query, result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_DATESTRING
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsDatestring(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(IsDatestringVPack(query, trx, tmp));
+}
+
+AqlValue$ Functions::IsDatestringVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  VPackSlice const value = ExtractFunctionParameter(trx, parameters, 0);
+  int64_t unused;
 
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (l % 2 == 0) {
-    b->add(VPackValue((values[midpoint - 1] + values[midpoint]) / 2));
-  } else {
-    b->add(VPackValue(values[midpoint]));
-  }
+  b->add(VPackValue(value.isString() && ValueToDate(value, unused)));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function PERCENTILE
+/// @brief function DATE_NOW
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Percentile(arangodb::aql::Query* query,
-                               arangodb::AqlTransaction* trx,
-                               FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
+AqlValue Functions::DateNow(arangodb::aql::Query* query,
+                            arangodb::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(PercentileVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  if (n != 2 && n != 3) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PERCENTILE", (int)2,
-        (int)3);
-  }
+  return AqlValue(DateNowVPack(query, trx, tmp));
+}
 
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
+AqlValue$ Functions::DateNowVPack(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  VPackFunctionParameters const& parameters) {
+  return NumberValue(query, std::floor(TRI_microtime() * 1000.0));
+}
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "PERCENTILE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_TIMESTAMP
+////////////////////////////////////////////////////////////////////////////////
 
-  Json border = ExtractFunctionParameter(trx, parameters, 1, false);
+AqlValue Functions::DateTimestamp(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateTimestampVPack(query, trx, tmp));
+}
 
-  if (!border.isNumber()) {
-    RegisterWarning(query, "PERCENTILE",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    return AqlValue(new Json(Json::Null));
+AqlValue$ Functions::DateTimestampVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  int64_t date;
+  if (!MakeDate(query, trx, parameters, "DATE_TIMESTAMP", date)) {
+    return NullValue(query);
   }
+  return NumberValue(query, static_cast<double>(date));
+}
 
-  bool unused = false;
-  double p = ValueToNumber(border.json(), unused);
-  if (p <= 0 || p > 100) {
-    RegisterWarning(query, "PERCENTILE",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    return AqlValue(new Json(Json::Null));
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_ISO8601
+////////////////////////////////////////////////////////////////////////////////
 
-  bool useInterpolation = false;
+AqlValue Functions::DateIso8601(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateIso8601VPack(query, trx, tmp));
+}
 
-  if (n == 3) {
-    Json methodJson = ExtractFunctionParameter(trx, parameters, 2, false);
-    if (!methodJson.isString()) {
-      RegisterWarning(query, "PERCENTILE",
-                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-      return AqlValue(new Json(Json::Null));
-    }
-    std::string method =
-        arangodb::basics::JsonHelper::getStringValue(methodJson.json(), "");
-    if (method == "interpolation") {
-      useInterpolation = true;
-    } else if (method == "rank") {
-      useInterpolation = false;
-    } else {
-      RegisterWarning(query, "PERCENTILE",
-                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-      return AqlValue(new Json(Json::Null));
-    }
+AqlValue$ Functions::DateIso8601VPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  int64_t date;
+  if (!MakeDate(query, trx, parameters, "DATE_ISO8601", date)) {
+    return NullValue(query);
   }
+  return StringValue(query, DateToString(date));
+}
 
-  std::vector<double> values;
-  if (!SortNumberList(list, values)) {
-    RegisterWarning(query, "PERCENTILE",
-                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    return AqlValue(new Json(Json::Null));
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shared implementation of the functions that extract a single
+/// numeric property of a date
+////////////////////////////////////////////////////////////////////////////////
 
-  if (values.empty()) {
-    return AqlValue(new Json(Json::Null));
-  }
-  size_t l = values.size();
-  if (l == 1) {
-    return AqlValue(new Json(values[0]));
+template <typename F>
+static AqlValue$ DatePart(arangodb::aql::Query* query,
+                          arangodb::AqlTransaction* trx,
+                          VPackFunctionParameters const& parameters,
+                          char const* functionName, F const& extract) {
+  int64_t date;
+  if (!ExtractDateParameter(query, trx, parameters, 0, functionName, date)) {
+    return NullValue(query);
   }
 
-  TRI_ASSERT(l > 1);
-
-  if (useInterpolation) {
-    double idx = p * (l + 1) / 100;
-    double pos = floor(idx);
+  DateComponents components;
+  SplitDate(date, components);
 
-    if (pos >= l) {
-      return AqlValue(new Json(values[l - 1]));
-    }
+  return NumberValue(query,
+                     static_cast<double>(extract(date, components)));
+}
 
-    if (pos <= 0) {
-      return AqlValue(new Json(Json::Null));
-    }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_DAYOFWEEK
+////////////////////////////////////////////////////////////////////////////////
 
-    double delta = idx - pos;
-    return AqlValue(new Json(delta * (values[static_cast<size_t>(pos)] -
-                                      values[static_cast<size_t>(pos) - 1]) +
-                             values[static_cast<size_t>(pos) - 1]));
-  }
-  double idx = p * l / 100;
-  double pos = ceil(idx);
-  if (pos >= l) {
-    return AqlValue(new Json(values[l - 1]));
-  }
-  if (pos <= 0) {
-    return AqlValue(new Json(Json::Null));
-  }
-  return AqlValue(new Json(values[static_cast<size_t>(pos) - 1]));
-#endif
+AqlValue Functions::DateDayOfWeek(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateDayOfWeekVPack(query, trx, tmp));
 }
 
-AqlValue$ Functions::PercentileVPack(
+AqlValue$ Functions::DateDayOfWeekVPack(
     arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
     VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 2 && n != 3) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "PERCENTILE", (int)2,
-        (int)3);
-  }
+  return DatePart(query, trx, parameters, "DATE_DAYOFWEEK",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return date.weekday;
+                  });
+}
 
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_YEAR
+////////////////////////////////////////////////////////////////////////////////
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "PERCENTILE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+AqlValue Functions::DateYear(arangodb::aql::Query* query,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateYearVPack(query, trx, tmp));
+}
 
-  VPackSlice border = ExtractFunctionParameter(trx, parameters, 1);
+AqlValue$ Functions::DateYearVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_YEAR",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return date.year;
+                  });
+}
 
-  if (!border.isNumber()) {
-    RegisterWarning(query, "PERCENTILE",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_MONTH
+////////////////////////////////////////////////////////////////////////////////
 
-  bool unused = false;
-  double p = ValueToNumber(border, unused);
-  if (p <= 0 || p > 100) {
-    RegisterWarning(query, "PERCENTILE",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+AqlValue Functions::DateMonth(arangodb::aql::Query* query,
+                              arangodb::AqlTransaction* trx,
+                              FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateMonthVPack(query, trx, tmp));
+}
 
-  bool useInterpolation = false;
+AqlValue$ Functions::DateMonthVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_MONTH",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return date.month + 1;
+                  });
+}
 
-  if (n == 3) {
-    VPackSlice methodSlice = ExtractFunctionParameter(trx, parameters, 2);
-    if (!methodSlice.isString()) {
-      RegisterWarning(query, "PERCENTILE",
-                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-      b->add(VPackValue(VPackValueType::Null));
-      return AqlValue$(b.get());
-    }
-    std::string method = methodSlice.copyString();
-    if (method == "interpolation") {
-      useInterpolation = true;
-    } else if (method == "rank") {
-      useInterpolation = false;
-    } else {
-      RegisterWarning(query, "PERCENTILE",
-                      TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-      b->add(VPackValue(VPackValueType::Null));
-      return AqlValue$(b.get());
-    }
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_DAY
+////////////////////////////////////////////////////////////////////////////////
 
-  std::vector<double> values;
-  if (!SortNumberList(list, values)) {
-    RegisterWarning(query, "PERCENTILE",
-                    TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+AqlValue Functions::DateDay(arangodb::aql::Query* query,
+                            arangodb::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateDayVPack(query, trx, tmp));
+}
+
+AqlValue$ Functions::DateDayVPack(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_DAY",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return date.day;
+                  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_HOUR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateHour(arangodb::aql::Query* query,
+                             arangodb::AqlTransaction* trx,
+                             FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateHourVPack(query, trx, tmp));
+}
 
-  if (values.empty()) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
-  size_t l = values.size();
-  if (l == 1) {
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(values[0]));
-    return AqlValue$(b.get());
-  }
+AqlValue$ Functions::DateHourVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_HOUR",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return date.hour;
+                  });
+}
 
-  TRI_ASSERT(l > 1);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_MINUTE
+////////////////////////////////////////////////////////////////////////////////
 
-  if (useInterpolation) {
-    double idx = p * (l + 1) / 100;
-    double pos = floor(idx);
+AqlValue Functions::DateMinute(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateMinuteVPack(query, trx, tmp));
+}
 
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    if (pos >= l) {
-      b->add(VPackValue(values[l - 1]));
-    } else if (pos <= 0) {
-      b->add(VPackValue(VPackValueType::Null));
-    } else {
-      double delta = idx - pos;
-      b->add(VPackValue(delta * (values[static_cast<size_t>(pos)] -
-                                 values[static_cast<size_t>(pos) - 1]) +
-                        values[static_cast<size_t>(pos) - 1]));
-    }
-    return AqlValue$(b.get());
-  }
-  double idx = p * l / 100;
-  double pos = ceil(idx);
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (pos >= l) {
-    b->add(VPackValue(values[l - 1]));
-  } else if (pos <= 0) {
-    b->add(VPackValue(VPackValueType::Null));
-  } else {
-    b->add(VPackValue(values[static_cast<size_t>(pos) - 1]));
-  }
-  return AqlValue$(b.get());
+AqlValue$ Functions::DateMinuteVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_MINUTE",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return date.minute;
+                  });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function RANGE
+/// @brief function DATE_SECOND
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Range(arangodb::aql::Query* query,
-                          arangodb::AqlTransaction* trx,
-                          FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
+AqlValue Functions::DateSecond(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               FunctionParameters const& parameters) {
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(RangeVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
+  return AqlValue(DateSecondVPack(query, trx, tmp));
+}
 
-  if (n != 2 && n != 3) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "RANGE", (int)2,
-        (int)3);
-  }
+AqlValue$ Functions::DateSecondVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_SECOND",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return date.second;
+                  });
+}
 
-  auto const leftJson = ExtractFunctionParameter(trx, parameters, 0, false);
-  auto const rightJson = ExtractFunctionParameter(trx, parameters, 1, false);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_MILLISECOND
+////////////////////////////////////////////////////////////////////////////////
 
-  bool unused = true;
-  double from = ValueToNumber(leftJson.json(), unused);
-  double to = ValueToNumber(rightJson.json(), unused);
+AqlValue Functions::DateMillisecond(arangodb::aql::Query* query,
+                                    arangodb::AqlTransaction* trx,
+                                    FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateMillisecondVPack(query, trx, tmp));
+}
 
-  double step = 0.0;
-  if (n == 3) {
-    auto const stepJson = ExtractFunctionParameter(trx, parameters, 2, false);
-    if (!TRI_IsNullJson(stepJson.json())) {
-      step = ValueToNumber(stepJson.json(), unused);
-    } else {
-      // no step specified
-      if (from <= to) {
-        step = 1.0;
-      } else {
-        step = -1.0;
-      }
-    }
-  } else {
-    // no step specified
-    if (from <= to) {
-      step = 1.0;
-    } else {
-      step = -1.0;
-    }
-  }
+AqlValue$ Functions::DateMillisecondVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_MILLISECOND",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return date.millisecond;
+                  });
+}
 
-  if (step == 0.0 || (from < to && step < 0.0) || (from > to && step > 0.0)) {
-    RegisterWarning(query, "RANGE",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    return AqlValue(new Json(Json::Null));
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_DAYOFYEAR
+////////////////////////////////////////////////////////////////////////////////
 
-  Json result(Json::Array);
-  if (step < 0.0 && to <= from) {
-    for (; from >= to; from += step) {
-      result.add(Json(from));
-    }
-  } else {
-    for (; from <= to; from += step) {
-      result.add(Json(from));
-    }
-  }
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
-#endif
+AqlValue Functions::DateDayOfYear(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateDayOfYearVPack(query, trx, tmp));
 }
 
-AqlValue$ Functions::RangeVPack(arangodb::aql::Query* query,
+AqlValue$ Functions::DateDayOfYearVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_DAYOFYEAR",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return DayOfYear(date);
+                  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_ISOWEEK
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateIsoWeek(arangodb::aql::Query* query,
                                 arangodb::AqlTransaction* trx,
-                                VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
+                                FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateIsoWeekVPack(query, trx, tmp));
+}
 
-  if (n != 2 && n != 3) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "RANGE", (int)2,
-        (int)3);
-  }
+AqlValue$ Functions::DateIsoWeekVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_ISOWEEK",
+                  [](int64_t value, DateComponents const&) -> int64_t {
+                    return IsoWeek(value);
+                  });
+}
 
-  VPackSlice const leftSlice = ExtractFunctionParameter(trx, parameters, 0);
-  VPackSlice const rightSlice = ExtractFunctionParameter(trx, parameters, 1);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_LEAPYEAR
+////////////////////////////////////////////////////////////////////////////////
 
-  bool unused = true;
-  double from = ValueToNumber(leftSlice, unused);
-  double to = ValueToNumber(rightSlice, unused);
+AqlValue Functions::DateLeapYear(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateLeapYearVPack(query, trx, tmp));
+}
 
-  double step = 0.0;
-  if (n == 3) {
-    VPackSlice const stepSlice = ExtractFunctionParameter(trx, parameters, 2);
-    if (!stepSlice.isNull()) {
-      step = ValueToNumber(stepSlice, unused);
-    } else {
-      // no step specified
-      if (from <= to) {
-        step = 1.0;
-      } else {
-        step = -1.0;
-      }
-    }
-  } else {
-    // no step specified
-    if (from <= to) {
-      step = 1.0;
-    } else {
-      step = -1.0;
-    }
+AqlValue$ Functions::DateLeapYearVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  int64_t date;
+  if (!ExtractDateParameter(query, trx, parameters, 0, "DATE_LEAPYEAR",
+                            date)) {
+    return NullValue(query);
   }
 
-  if (step == 0.0 || (from < to && step < 0.0) || (from > to && step > 0.0)) {
-    RegisterWarning(query, "RANGE",
-                    TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+  DateComponents components;
+  SplitDate(date, components);
 
   std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  try {
-    VPackArrayBuilder guard(b.get());
-    if (step < 0.0 && to <= from) {
-      for (; from >= to; from += step) {
-        b->add(VPackValue(from));
-      }
-    } else {
-      for (; from <= to; from += step) {
-        b->add(VPackValue(from));
-      }
-    }
-  } catch (...) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+  b->add(VPackValue(IsLeapYear(components.year)));
   return AqlValue$(b.get());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function POSITION
+/// @brief function DATE_QUARTER
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Position(arangodb::aql::Query* query,
-                             arangodb::AqlTransaction* trx,
-                             FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
+AqlValue Functions::DateQuarter(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                FunctionParameters const& parameters) {
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(PositionVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
-  if (n != 2 && n != 3) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POSITION", (int)2,
-        (int)3);
-  }
-
-  Json list = ExtractFunctionParameter(trx, parameters, 0, false);
-
-  if (!list.isArray()) {
-    RegisterWarning(query, "POSITION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    return AqlValue(new Json(Json::Null));
-  }
-
-  bool returnIndex = false;
-  if (n == 3) {
-    Json returnIndexJson = ExtractFunctionParameter(trx, parameters, 2, false);
-    returnIndex = ValueToBoolean(returnIndexJson.json());
-  }
+  return AqlValue(DateQuarterVPack(query, trx, tmp));
+}
 
-  if (list.size() > 0) {
-    Json searchValue = ExtractFunctionParameter(trx, parameters, 1, false);
+AqlValue$ Functions::DateQuarterVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_QUARTER",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return date.month / 3 + 1;
+                  });
+}
 
-    size_t index;
-    if (ListContainsElement(list, searchValue, index)) {
-      if (returnIndex) {
-        return AqlValue(new Json(static_cast<double>(index)));
-      }
-      return AqlValue(new Json(true));
-    }
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_DAYS_IN_MONTH
+////////////////////////////////////////////////////////////////////////////////
 
-  if (returnIndex) {
-    return AqlValue(new Json(-1));
-  }
-  return AqlValue(new Json(false));
-#endif
+AqlValue Functions::DateDaysInMonth(arangodb::aql::Query* query,
+                                    arangodb::AqlTransaction* trx,
+                                    FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateDaysInMonthVPack(query, trx, tmp));
 }
 
-AqlValue$ Functions::PositionVPack(arangodb::aql::Query* query,
-                                   arangodb::AqlTransaction* trx,
-                                   VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
-  if (n != 2 && n != 3) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "POSITION", (int)2,
-        (int)3);
-  }
+AqlValue$ Functions::DateDaysInMonthVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  return DatePart(query, trx, parameters, "DATE_DAYS_IN_MONTH",
+                  [](int64_t, DateComponents const& date) -> int64_t {
+                    return DaysInMonthOf(date);
+                  });
+}
 
-  VPackSlice list = ExtractFunctionParameter(trx, parameters, 0);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_ADD
+////////////////////////////////////////////////////////////////////////////////
 
-  if (!list.isArray()) {
-    RegisterWarning(query, "POSITION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
-    std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-    b->add(VPackValue(VPackValueType::Null));
-    return AqlValue$(b.get());
-  }
+AqlValue Functions::DateAdd(arangodb::aql::Query* query,
+                            arangodb::AqlTransaction* trx,
+                            FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateAddVPack(query, trx, tmp));
+}
 
-  bool returnIndex = false;
-  if (n == 3) {
-    VPackSlice returnIndexSlice = ExtractFunctionParameter(trx, parameters, 2);
-    returnIndex = ValueToBoolean(returnIndexSlice);
-  }
+AqlValue$ Functions::DateAddVPack(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  VPackFunctionParameters const& parameters) {
+  return DateCalc(query, trx, parameters, "DATE_ADD", 1.0);
+}
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  if (list.length() > 0) {
-    VPackSlice searchValue = ExtractFunctionParameter(trx, parameters, 1);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_SUBTRACT
+////////////////////////////////////////////////////////////////////////////////
 
-    size_t index;
-    if (ListContainsElement(list, searchValue, index)) {
-      if (returnIndex) {
-        b->add(VPackValue(index));
-      } else {
-        b->add(VPackValue(true));
-      }
-    } else {
-      if (returnIndex) {
-        b->add(VPackValue(-1));
-      } else {
-        b->add(VPackValue(false));
-      }
-    }
-  } else {
-    if (returnIndex) {
-      b->add(VPackValue(-1));
-    } else {
-      b->add(VPackValue(false));
-    }
-  }
-  return AqlValue$(b.get());
+AqlValue Functions::DateSubtract(arangodb::aql::Query* query,
+                                 arangodb::AqlTransaction* trx,
+                                 FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateSubtractVPack(query, trx, tmp));
+}
+
+AqlValue$ Functions::DateSubtractVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  return DateCalc(query, trx, parameters, "DATE_SUBTRACT", -1.0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function FULLTEXT
+/// @brief function DATE_DIFF
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Fulltext(arangodb::aql::Query* query,
+AqlValue Functions::DateDiff(arangodb::aql::Query* query,
                              arangodb::AqlTransaction* trx,
                              FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(FulltextVPack(query, trx, tmp));
-#else
-  size_t const n = parameters.size();
+  return AqlValue(DateDiffVPack(query, trx, tmp));
+}
 
-  if (n < 3 || n > 4) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FULLTEXT", (int)3,
-        (int)4);
+AqlValue$ Functions::DateDiffVPack(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   VPackFunctionParameters const& parameters) {
+  int64_t date1;
+  int64_t date2;
+  if (!ExtractDateParameter(query, trx, parameters, 0, "DATE_DIFF", date1) ||
+      !ExtractDateParameter(query, trx, parameters, 1, "DATE_DIFF", date2)) {
+    return NullValue(query);
   }
 
-  auto resolver = trx->resolver();
+  VPackSlice const unitParam = ExtractFunctionParameter(trx, parameters, 2);
+  bool const asFloat =
+      ValueToBoolean(ExtractFunctionParameter(trx, parameters, 3));
 
-  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  DateUnit unit = DateUnit::INVALID;
+  if (unitParam.isString()) {
+    unit = LookupDateUnit(unitParam.copyString());
+  }
 
-  if (!collectionJson.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+  double divisor = 0.0;
+  switch (unit) {
+    case DateUnit::MILLISECOND:
+      divisor = 1.0;
+      break;
+    case DateUnit::SECOND:
+      divisor = static_cast<double>(MsPerSecond);
+      break;
+    case DateUnit::MINUTE:
+      divisor = static_cast<double>(MsPerMinute);
+      break;
+    case DateUnit::HOUR:
+      divisor = static_cast<double>(MsPerHour);
+      break;
+    case DateUnit::DAY:
+      divisor = static_cast<double>(MsPerDay);
+      break;
+    case DateUnit::WEEK:
+      divisor = static_cast<double>(7 * MsPerDay);
+      break;
+    case DateUnit::MONTH:
+    case DateUnit::YEAR:
+      break;
+    case DateUnit::INVALID:
+      RegisterWarning(query, "DATE_DIFF", TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+      return NullValue(query);
   }
 
-  std::string colName =
-      basics::JsonHelper::getStringValue(collectionJson.json(), "");
+  double result;
 
-  Json attribute = ExtractFunctionParameter(trx, parameters, 1, false);
+  if (divisor > 0.0) {
+    result = static_cast<double>(date2 - date1) / divisor;
+  } else {
+    // months have different lengths, so the fractional part is computed
+    // using the average length of the months of both dates
+    DateComponents d1;
+    DateComponents d2;
+    SplitDate(date1, d1);
+    SplitDate(date2, d2);
 
-  if (!attribute.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
-  }
+    auto monthStart = [](DateComponents const& date) -> int64_t {
+      return DaysFromCivil(date.year, date.month + 1, 1) * MsPerDay;
+    };
 
-  std::string attributeName =
-      basics::JsonHelper::getStringValue(attribute.json(), "");
+    double const msPerMonth1 =
+        static_cast<double>(DaysInMonthOf(d1) * MsPerDay);
+    double const msPerMonth2 =
+        static_cast<double>(DaysInMonthOf(d2) * MsPerDay);
+    double const offset1 = static_cast<double>(date1 - monthStart(d1));
+    double const offset2 = static_cast<double>(date2 - monthStart(d2));
 
-  Json queryString = ExtractFunctionParameter(trx, parameters, 2, false);
+    result = static_cast<double>((d2.year * 12 + d2.month) -
+                                 (d1.year * 12 + d1.month)) +
+             (offset2 - offset1) / ((msPerMonth1 + msPerMonth2) / 2.0);
 
-  if (!queryString.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+    if (unit == DateUnit::YEAR) {
+      result /= 12.0;
+    }
   }
 
-  std::string queryValue =
-      basics::JsonHelper::getStringValue(queryString.json(), "");
-
-  size_t maxResults = 0;  // 0 means "all results"
-  if (n >= 4) {
-    Json limit = ExtractFunctionParameter(trx, parameters, 3, false);
-    if (!limit.isNull() && !limit.isNumber()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
-    } else if (limit.isNumber()) {
-      int64_t value =
-          basics::JsonHelper::getNumericValue<int64_t>(limit.json(), 0);
-      if (value > 0) {
-        maxResults = static_cast<size_t>(value);
-      }
-    }
+  if (!asFloat) {
+    result = std::trunc(result);
   }
 
-  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
-  auto collection = trx->trxCollection(cid);
+  return NumberValue(query, result);
+}
 
-  // ensure the collection is loaded
-  if (collection == nullptr) {
-    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
-                                           TRI_TRANSACTION_READ,
-                                           trx->nestingLevel(), true, true);
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
-    }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_COMPARE
+////////////////////////////////////////////////////////////////////////////////
 
-    TRI_EnsureCollectionsTransaction(trx->getInternals());
-    collection = trx->trxCollection(cid);
+AqlValue Functions::DateCompare(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateCompareVPack(query, trx, tmp));
+}
 
-    if (collection == nullptr) {
-      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
-                                    "'%s'", colName.c_str());
-    }
-  }
+AqlValue$ Functions::DateCompareVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  int64_t date1;
+  int64_t date2;
+  if (!ExtractDateParameter(query, trx, parameters, 0, "DATE_COMPARE",
+                            date1) ||
+      !ExtractDateParameter(query, trx, parameters, 1, "DATE_COMPARE",
+                            date2)) {
+    return NullValue(query);
+  }
+
+  // positions of the units in an ISO 8601 date string
+  static std::unordered_map<std::string, std::pair<size_t, size_t>> const
+      ranges = {{"y", {0, 4}},           {"year", {0, 4}},
+                {"years", {0, 4}},       {"m", {5, 7}},
+                {"month", {5, 7}},       {"months", {5, 7}},
+                {"d", {8, 10}},          {"day", {8, 10}},
+                {"days", {8, 10}},       {"h", {11, 13}},
+                {"hour", {11, 13}},      {"hours", {11, 13}},
+                {"i", {14, 16}},         {"minute", {14, 16}},
+                {"minutes", {14, 16}},   {"s", {17, 19}},
+                {"second", {17, 19}},    {"seconds", {17, 19}},
+                {"f", {20, 23}},         {"millisecond", {20, 23}},
+                {"milliseconds", {20, 23}}};
+
+  VPackSlice const startParam = ExtractFunctionParameter(trx, parameters, 2);
+  VPackSlice const endParam = ExtractFunctionParameter(trx, parameters, 3);
+
+  auto lookup = [](VPackSlice const& unit,
+                   std::pair<size_t, size_t>& range) -> bool {
+    if (!unit.isString()) {
+      return false;
+    }
+    auto it = ranges.find(unit.copyString());
+    if (it == ranges.end()) {
+      return false;
+    }
+    range = (*it).second;
+    return true;
+  };
 
-  auto document = trx->documentCollection(cid);
+  std::pair<size_t, size_t> start;
+  std::pair<size_t, size_t> end;
 
-  if (document == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
+  if (!lookup(startParam, start)) {
+    RegisterWarning(query, "DATE_COMPARE", TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+    return NullValue(query);
   }
 
-  arangodb::Index* index = nullptr;
+  if (endParam.isNone()) {
+    end = start;
+  } else if (!lookup(endParam, end)) {
+    RegisterWarning(query, "DATE_COMPARE", TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+    return NullValue(query);
+  }
 
-  std::vector<std::vector<arangodb::basics::AttributeName>> const search(
-      {{arangodb::basics::AttributeName(attributeName, false)}});
+  std::string const iso1 = DateToString(date1);
+  std::string const iso2 = DateToString(date2);
 
-  for (auto const& idx : document->allIndexes()) {
-    if (idx->type() == arangodb::Index::TRI_IDX_TYPE_FULLTEXT_INDEX) {
-      // test if index is on the correct field
-      if (arangodb::basics::AttributeName::isIdentical(idx->fields(), search,
-                                                       false)) {
-        // match!
-        index = idx;
-        break;
-      }
-    }
+  // extended years have a sign and two more digits
+  size_t start1 = start.first;
+  size_t start2 = start.first;
+  size_t const end1 = end.second + (iso1[0] == '+' || iso1[0] == '-' ? 3 : 0);
+  size_t const end2 = end.second + (iso2[0] == '+' || iso2[0] == '-' ? 3 : 0);
+  if (start1 != 0 && (iso1[0] == '+' || iso1[0] == '-')) {
+    start1 += 3;
   }
-
-  if (index == nullptr) {
-    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FULLTEXT_INDEX_MISSING,
-                                  colName.c_str());
+  if (start2 != 0 && (iso2[0] == '+' || iso2[0] == '-')) {
+    start2 += 3;
   }
 
-  if (trx->orderDitch(collection) == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  if (end1 <= start1 || end2 <= start2) {
+    RegisterWarning(query, "DATE_COMPARE", TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+    return NullValue(query);
   }
 
-  TRI_fulltext_query_t* ft =
-      TRI_CreateQueryFulltextIndex(TRI_FULLTEXT_SEARCH_MAX_WORDS, maxResults);
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  b->add(VPackValue(iso1.substr(start1, end1 - start1) ==
+                    iso2.substr(start2, end2 - start2)));
+  return AqlValue$(b.get());
+}
 
-  if (ft == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_FORMAT
+////////////////////////////////////////////////////////////////////////////////
 
-  bool isSubstringQuery = false;
-  int res =
-      TRI_ParseQueryFulltextIndex(ft, queryValue.c_str(), &isSubstringQuery);
+AqlValue Functions::DateFormat(arangodb::aql::Query* query,
+                               arangodb::AqlTransaction* trx,
+                               FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(DateFormatVPack(query, trx, tmp));
+}
 
-  if (res != TRI_ERROR_NO_ERROR) {
-    TRI_FreeQueryFulltextIndex(ft);
-    THROW_ARANGO_EXCEPTION(res);
-  }
+AqlValue$ Functions::DateFormatVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  int64_t date;
+  if (!ExtractDateParameter(query, trx, parameters, 0, "DATE_FORMAT", date)) {
+    return NullValue(query);
+  }
+
+  VPackSlice const formatParam = ExtractFunctionParameter(trx, parameters, 1);
+  if (!formatParam.isString()) {
+    RegisterWarning(query, "DATE_FORMAT", TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+    return NullValue(query);
+  }
+
+  // placeholders, longest first so that e.g. %yyyy is not taken as %yy
+  static char const* const placeholders[] = {
+      "&",  "yyyyyy", "yyyy", "mmmm", "wwww", "mmm", "www", "fff", "xxx",
+      "yy", "mm",     "dd",   "hh",   "ii",   "ss",  "kk",  "t",   "z",
+      "w",  "y",      "m",    "d",    "h",    "i",   "s",   "f",   "x",
+      "k",  "l",      "q",    "a",    "%"};
+
+  DateComponents d;
+  SplitDate(date, d);
+  std::string const iso = DateToString(date);
+  bool const extended = (d.year < 0 || d.year > 9999);
+  size_t const yearOffset = extended ? 3 : 0;
+
+  auto pad = [](int64_t value, int width) -> std::string {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%0*lld", width,
+             static_cast<long long>(value));
+    return std::string(buffer);
+  };
 
-  auto fulltextIndex = static_cast<arangodb::FulltextIndex*>(index);
-  // note: the following call will free "ft"!
-  TRI_fulltext_result_t* queryResult =
-      TRI_QueryFulltextIndex(fulltextIndex->internals(), ft);
+  std::string const format = formatParam.copyString();
+  std::string result;
+  size_t i = 0;
 
-  if (queryResult == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
-  }
+  while (i < format.size()) {
+    if (format[i] != '%') {
+      result.push_back(format[i]);
+      ++i;
+      continue;
+    }
 
-  auto shaper = collection->_collection->_collection->getShaper();
-  size_t const numResults = queryResult->_numDocuments;
+    ++i;
+    std::string placeholder;
+    for (auto const& it : placeholders) {
+      size_t const length = strlen(it);
+      if (i + length <= format.size() &&
+          strncasecmp(format.c_str() + i, it, length) == 0) {
+        placeholder = it;
+        break;
+      }
+    }
 
-  try {
-    Json array(Json::Array, numResults);
+    i += placeholder.size();
 
-    for (size_t i = 0; i < numResults; ++i) {
-      auto j =
-          ExpandShapedJson(shaper, resolver, cid,
-                           (TRI_doc_mptr_t const*)queryResult->_documents[i]);
-      array.add(j);
+    if (placeholder.empty() || placeholder == "&") {
+      // a lone % or %& produces nothing
+      continue;
     }
-    TRI_FreeResultFulltextIndex(queryResult);
+    if (placeholder == "%") {
+      result.push_back('%');
+    } else if (placeholder == "t") {
+      result.append(std::to_string(date));
+    } else if (placeholder == "z") {
+      result.append(iso);
+    } else if (placeholder == "w") {
+      result.append(std::to_string(d.weekday));
+    } else if (placeholder == "y") {
+      result.append(std::to_string(d.year));
+    } else if (placeholder == "yy") {
+      if (d.year < 0) {
+        result.push_back('-');
+      }
+      result.append(iso.substr(2 + yearOffset, 2));
+    } else if (placeholder == "yyyy") {
+      result.append(iso.substr(0, 4 + yearOffset));
+    } else if (placeholder == "yyyyyy") {
+      if (extended) {
+        result.append(iso.substr(0, 7));
+      } else {
+        result.append("+" + pad(d.year, 6));
+      }
+    } else if (placeholder == "m") {
+      result.append(std::to_string(d.month + 1));
+    } else if (placeholder == "mm") {
+      result.append(pad(d.month + 1, 2));
+    } else if (placeholder == "mmm") {
+      result.append(std::string(MonthNames[d.month]).substr(0, 3));
+    } else if (placeholder == "mmmm") {
+      result.append(MonthNames[d.month]);
+    } else if (placeholder == "www") {
+      result.append(std::string(WeekdayNames[d.weekday]).substr(0, 3));
+    } else if (placeholder == "wwww") {
+      result.append(WeekdayNames[d.weekday]);
+    } else if (placeholder == "d") {
+      result.append(std::to_string(d.day));
+    } else if (placeholder == "dd") {
+      result.append(pad(d.day, 2));
+    } else if (placeholder == "h") {
+      result.append(std::to_string(d.hour));
+    } else if (placeholder == "hh") {
+      result.append(pad(d.hour, 2));
+    } else if (placeholder == "i") {
+      result.append(std::to_string(d.minute));
+    } else if (placeholder == "ii") {
+      result.append(pad(d.minute, 2));
+    } else if (placeholder == "s") {
+      result.append(std::to_string(d.second));
+    } else if (placeholder == "ss") {
+      result.append(pad(d.second, 2));
+    } else if (placeholder == "f") {
+      result.append(std::to_string(d.millisecond));
+    } else if (placeholder == "fff") {
+      result.append(pad(d.millisecond, 3));
+    } else if (placeholder == "x") {
+      result.append(std::to_string(DayOfYear(d)));
+    } else if (placeholder == "xxx") {
+      result.append(pad(DayOfYear(d), 3));
+    } else if (placeholder == "k") {
+      result.append(std::to_string(IsoWeek(date)));
+    } else if (placeholder == "kk") {
+      result.append(pad(IsoWeek(date), 2));
+    } else if (placeholder == "l") {
+      result.append(IsLeapYear(d.year) ? "1" : "0");
+    } else if (placeholder == "q") {
+      result.append(std::to_string(d.month / 3 + 1));
+    } else if (placeholder == "a") {
+      result.append(std::to_string(DaysInMonthOf(d)));
+    }
+  }
+
+  return StringValue(query, result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the graph and the options of a graph measure function and
+/// load the graph. the options follow the graph name and the vertex example
+/// if there is one
+////////////////////////////////////////////////////////////////////////////////
+
+static std::unique_ptr<GraphMeasures> LoadGraphMeasures(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters, char const* funcName,
+    bool withVertexExample) {
+  size_t const n = parameters.size();
+  size_t const optionsPosition = withVertexExample ? 2 : 1;
 
-    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, array.steal()));
-  } catch (...) {
-    TRI_FreeResultFulltextIndex(queryResult);
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  if (n < optionsPosition || n > optionsPosition + 1) {
+    THROW_ARANGO_EXCEPTION_PARAMS(
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, funcName,
+        (int)optionsPosition, (int)optionsPosition + 1);
   }
-#endif
-}
 
-AqlValue$ Functions::FulltextVPack(arangodb::aql::Query* query,
-                                   arangodb::AqlTransaction* trx,
-                                   VPackFunctionParameters const& parameters) {
-  size_t const n = parameters.size();
+  VPackSlice graphName = ExtractFunctionParameter(trx, parameters, 0);
 
-  if (n < 3 || n > 4) {
+  if (!graphName.isString()) {
     THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "FULLTEXT", (int)3,
-        (int)4);
+        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, funcName);
   }
 
-  auto resolver = trx->resolver();
+  Graph const* graph = query->lookupGraphByName(graphName.copyString());
 
-  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
+  if (graph == nullptr) {
+    THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_GRAPH_INVALID_GRAPH, "%s",
+                                  funcName);
+  }
+
+  VPackSlice vertexExample;
+
+  if (withVertexExample) {
+    vertexExample = ExtractFunctionParameter(trx, parameters, 1);
+  }
+
+  GraphMeasures::Options opts;
+  VPackSlice edgeExamples;
+
+  if (n > optionsPosition) {
+    VPackSlice options =
+        ExtractFunctionParameter(trx, parameters, optionsPosition);
+
+    if (options.isObject()) {
+      VPackSlice value = options.get("direction");
+      if (value.isString()) {
+        std::string const direction = value.copyString();
+        if (direction == "outbound") {
+          opts.direction = TRI_EDGE_OUT;
+        } else if (direction == "inbound") {
+          opts.direction = TRI_EDGE_IN;
+        } else if (direction == "any") {
+          opts.direction = TRI_EDGE_ANY;
+        } else {
+          THROW_ARANGO_EXCEPTION_PARAMS(
+              TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, funcName);
+        }
+      }
 
-  if (!collectionSlice.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
-  }
+      value = options.get("weight");
+      if (value.isString()) {
+        opts.weightAttribute = value.copyString();
+        opts.defaultWeight =
+            arangodb::basics::VelocyPackHelper::getNumericValue<double>(
+                options, "defaultWeight",
+                std::numeric_limits<double>::infinity());
+      }
 
-  std::string colName = collectionSlice.copyString();
+      value = options.get("edgeCollectionRestriction");
+      if (value.isString()) {
+        opts.edgeCollectionRestriction.emplace(value.copyString());
+      } else if (value.isArray()) {
+        for (auto const& it : VPackArrayIterator(value)) {
+          if (it.isString()) {
+            opts.edgeCollectionRestriction.emplace(it.copyString());
+          }
+        }
+      }
 
-  VPackSlice attribute = ExtractFunctionParameter(trx, parameters, 1);
+      opts.samples =
+          arangodb::basics::VelocyPackHelper::getNumericValue<size_t>(
+              options, "samples", 0);
 
-  if (!attribute.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
+      edgeExamples = options.get("edgeExamples");
+    } else if (!options.isNull()) {
+      THROW_ARANGO_EXCEPTION_PARAMS(
+          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, funcName);
+    }
   }
 
-  std::string attributeName = attribute.copyString();
+  auto measures = std::make_unique<GraphMeasures>(query, trx, graph, opts);
+  measures->load(vertexExample, edgeExamples);
 
-  VPackSlice queryString = ExtractFunctionParameter(trx, parameters, 2);
+  return measures;
+}
 
-  if (!queryString.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build an object mapping the _ids of the selected vertices to their
+/// values, optionally divided by the largest of the values
+////////////////////////////////////////////////////////////////////////////////
 
-  std::string queryValue = queryString.copyString();
+static AqlValue$ VertexValues(arangodb::aql::Query* query,
+                              GraphMeasures const& measures,
+                              std::vector<double> const& values,
+                              bool normalize) {
+  double divisor = 1.0;
 
-  size_t maxResults = 0;  // 0 means "all results"
-  if (n >= 4) {
-    VPackSlice limit = ExtractFunctionParameter(trx, parameters, 3);
-    if (!limit.isNull() && !limit.isNumber()) {
-      THROW_ARANGO_EXCEPTION_PARAMS(
-          TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "FULLTEXT");
-    } else if (limit.isNumber()) {
-      int64_t value = limit.getNumericValue<int64_t>();
-      if (value > 0) {
-        maxResults = static_cast<size_t>(value);
+  if (normalize) {
+    double maximum = 0.0;
+    for (size_t v = 0; v < values.size(); ++v) {
+      if (measures.isSelected(v)) {
+        maximum = (std::max)(maximum, values[v]);
       }
     }
+    if (maximum > 0.0) {
+      divisor = maximum;
+    }
   }
 
-  TRI_voc_cid_t cid = resolver->getCollectionId(colName);
-  auto collection = trx->trxCollection(cid);
-
-  // ensure the collection is loaded
-  if (collection == nullptr) {
-    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
-                                           TRI_TRANSACTION_READ,
-                                           trx->nestingLevel(), true, true);
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION_FORMAT(res, "'%s'", colName.c_str());
+  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
+  {
+    VPackObjectBuilder guard(b.get());
+    for (size_t v = 0; v < values.size(); ++v) {
+      if (measures.isSelected(v)) {
+        b->add(measures.vertexId(v), VPackValue(values[v] / divisor));
+      }
     }
+  }
+  return AqlValue$(b.get());
+}
 
-    TRI_EnsureCollectionsTransaction(trx->getInternals());
-    collection = trx->trxCollection(cid);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace the values by their inverses, keeping zeros
+////////////////////////////////////////////////////////////////////////////////
 
-    if (collection == nullptr) {
-      THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND,
-                                    "'%s'", colName.c_str());
+static void InvertValues(std::vector<double>& values) {
+  for (auto& value : values) {
+    if (value > 0.0) {
+      value = 1.0 / value;
     }
   }
+}
 
-  auto document = trx->documentCollection(cid);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function GRAPH_ECCENTRICITY
+////////////////////////////////////////////////////////////////////////////////
 
-  if (document == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
-  }
+AqlValue Functions::GraphEccentricity(arangodb::aql::Query* query,
+                                      arangodb::AqlTransaction* trx,
+                                      FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(GraphEccentricityVPack(query, trx, tmp));
+}
 
-  arangodb::Index* index = nullptr;
+AqlValue$ Functions::GraphEccentricityVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  auto measures =
+      LoadGraphMeasures(query, trx, parameters, "GRAPH_ECCENTRICITY", false);
 
-  std::vector<std::vector<arangodb::basics::AttributeName>> const search(
-      {{arangodb::basics::AttributeName(attributeName, false)}});
+  std::vector<double> eccentricity;
+  std::vector<double> closeness;
+  measures->distances(eccentricity, closeness);
+  InvertValues(eccentricity);
 
-  for (auto const& idx : document->allIndexes()) {
-    if (idx->type() == arangodb::Index::TRI_IDX_TYPE_FULLTEXT_INDEX) {
-      // test if index is on the correct field
-      if (arangodb::basics::AttributeName::isIdentical(idx->fields(), search,
-                                                       false)) {
-        // match!
-        index = idx;
-        break;
-      }
-    }
-  }
+  return VertexValues(query, *measures, eccentricity, true);
+}
 
-  if (index == nullptr) {
-    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FULLTEXT_INDEX_MISSING,
-                                  colName.c_str());
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function GRAPH_BETWEENNESS
+////////////////////////////////////////////////////////////////////////////////
 
-  if (trx->orderDitch(collection) == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+AqlValue Functions::GraphBetweenness(arangodb::aql::Query* query,
+                                     arangodb::AqlTransaction* trx,
+                                     FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(GraphBetweennessVPack(query, trx, tmp));
+}
 
-  TRI_fulltext_query_t* ft =
-      TRI_CreateQueryFulltextIndex(TRI_FULLTEXT_SEARCH_MAX_WORDS, maxResults);
+AqlValue$ Functions::GraphBetweennessVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  auto measures =
+      LoadGraphMeasures(query, trx, parameters, "GRAPH_BETWEENNESS", false);
 
-  if (ft == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
+  std::vector<double> betweenness;
+  measures->betweenness(betweenness);
 
-  bool isSubstringQuery = false;
-  int res =
-      TRI_ParseQueryFulltextIndex(ft, queryValue.c_str(), &isSubstringQuery);
+  return VertexValues(query, *measures, betweenness, true);
+}
 
-  if (res != TRI_ERROR_NO_ERROR) {
-    TRI_FreeQueryFulltextIndex(ft);
-    THROW_ARANGO_EXCEPTION(res);
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function GRAPH_CLOSENESS
+////////////////////////////////////////////////////////////////////////////////
 
-  auto fulltextIndex = static_cast<arangodb::FulltextIndex*>(index);
-  // note: the following call will free "ft"!
-  TRI_fulltext_result_t* queryResult =
-      TRI_QueryFulltextIndex(fulltextIndex->internals(), ft);
+AqlValue Functions::GraphCloseness(arangodb::aql::Query* query,
+                                   arangodb::AqlTransaction* trx,
+                                   FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(GraphClosenessVPack(query, trx, tmp));
+}
 
-  if (queryResult == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
-  }
+AqlValue$ Functions::GraphClosenessVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  auto measures =
+      LoadGraphMeasures(query, trx, parameters, "GRAPH_CLOSENESS", false);
 
-  auto shaper = collection->_collection->_collection->getShaper();
-  size_t const numResults = queryResult->_numDocuments;
+  std::vector<double> eccentricity;
+  std::vector<double> closeness;
+  measures->distances(eccentricity, closeness);
+  InvertValues(closeness);
 
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  try {
-    VPackArrayBuilder guard(b.get());
+  return VertexValues(query, *measures, closeness, true);
+}
 
-    for (size_t i = 0; i < numResults; ++i) {
-      std::unordered_set<std::string> unused;
-      ExpandShapedJson(shaper, resolver, cid,
-                       (TRI_doc_mptr_t const*)queryResult->_documents[i], *b,
-                       false, unused);
-    }
-  } catch (...) {
-    TRI_FreeResultFulltextIndex(queryResult);
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
-  }
-  TRI_FreeResultFulltextIndex(queryResult);
-  return AqlValue$(b.get());
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function GRAPH_ABSOLUTE_ECCENTRICITY
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::GraphAbsoluteEccentricity(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(GraphAbsoluteEccentricityVPack(query, trx, tmp));
+}
+
+AqlValue$ Functions::GraphAbsoluteEccentricityVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  auto measures = LoadGraphMeasures(query, trx, parameters,
+                                    "GRAPH_ABSOLUTE_ECCENTRICITY", true);
+
+  std::vector<double> eccentricity;
+  std::vector<double> closeness;
+  measures->distances(eccentricity, closeness);
+
+  return VertexValues(query, *measures, eccentricity, false);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_SAME_COLLECTION
+/// @brief function GRAPH_ABSOLUTE_BETWEENNESS
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsSameCollection(arangodb::aql::Query* query,
-                                     arangodb::AqlTransaction* trx,
-                                     FunctionParameters const& parameters) {
-#ifdef TMPUSEVPACK
+AqlValue Functions::GraphAbsoluteBetweenness(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    FunctionParameters const& parameters) {
   auto tmp = transformParameters(parameters, trx);
-  return AqlValue(IsSameCollectionVPack(query, trx, tmp));
-#else
-  if (parameters.size() != 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "IS_SAME_COLLECTION", (int) 2, (int) 2);
-  }
-  
-  Json collectionJson = ExtractFunctionParameter(trx, parameters, 0, false);
+  return AqlValue(GraphAbsoluteBetweennessVPack(query, trx, tmp));
+}
 
-  if (! collectionJson.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "IS_SAME_COLLECTION");
-  }
+AqlValue$ Functions::GraphAbsoluteBetweennessVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  auto measures = LoadGraphMeasures(query, trx, parameters,
+                                    "GRAPH_ABSOLUTE_BETWEENNESS", false);
 
-  std::string colName = basics::JsonHelper::getStringValue(collectionJson.json(), "");
+  std::vector<double> betweenness;
+  measures->betweenness(betweenness);
 
-  Json value = ExtractFunctionParameter(trx, parameters, 1, false);
-  std::string identifier;
+  return VertexValues(query, *measures, betweenness, false);
+}
 
-  if (value.isObject() && value.has(TRI_VOC_ATTRIBUTE_ID)) {
-    identifier = arangodb::basics::JsonHelper::getStringValue(value.get(TRI_VOC_ATTRIBUTE_ID).json(), "");
-  }
-  else if (value.isString()) {
-    identifier = arangodb::basics::JsonHelper::getStringValue(value.json(), "");
-  }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function GRAPH_ABSOLUTE_CLOSENESS
+////////////////////////////////////////////////////////////////////////////////
 
-  if (! identifier.empty()) {
-    size_t pos = identifier.find('/');
+AqlValue Functions::GraphAbsoluteCloseness(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(GraphAbsoluteClosenessVPack(query, trx, tmp));
+}
 
-    if (pos != std::string::npos) {
-      bool const same = (colName == identifier.substr(0, pos));
+AqlValue$ Functions::GraphAbsoluteClosenessVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  auto measures = LoadGraphMeasures(query, trx, parameters,
+                                    "GRAPH_ABSOLUTE_CLOSENESS", true);
 
-      return AqlValue(new Json(same));
-    }
+  std::vector<double> eccentricity;
+  std::vector<double> closeness;
+  measures->distances(eccentricity, closeness);
 
-    // fallthrough intentional
- }
+  return VertexValues(query, *measures, closeness, false);
+}
 
-  RegisterWarning(query, "IS_SAME_COLLECTION", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-  return AqlValue(new Json(Json::Null));
-#endif
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function GRAPH_DIAMETER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::GraphDiameter(arangodb::aql::Query* query,
+                                  arangodb::AqlTransaction* trx,
+                                  FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(GraphDiameterVPack(query, trx, tmp));
 }
 
-AqlValue$ Functions::IsSameCollectionVPack(
+AqlValue$ Functions::GraphDiameterVPack(
     arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
     VPackFunctionParameters const& parameters) {
-  if (parameters.size() != 2) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH, "IS_SAME_COLLECTION",
-        (int)2, (int)2);
-  }
+  auto measures =
+      LoadGraphMeasures(query, trx, parameters, "GRAPH_DIAMETER", false);
 
-  VPackSlice collectionSlice = ExtractFunctionParameter(trx, parameters, 0);
+  std::vector<double> eccentricity;
+  std::vector<double> closeness;
+  measures->distances(eccentricity, closeness);
 
-  if (!collectionSlice.isString()) {
-    THROW_ARANGO_EXCEPTION_PARAMS(
-        TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "IS_SAME_COLLECTION");
+  double diameter = 0.0;
+  for (auto const& value : eccentricity) {
+    diameter = (std::max)(diameter, value);
   }
 
-  std::string colName = collectionSlice.copyString();
+  return NumberValue(query, diameter);
+}
 
-  VPackSlice value = ExtractFunctionParameter(trx, parameters, 1);
-  std::string identifier;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function GRAPH_RADIUS
+////////////////////////////////////////////////////////////////////////////////
 
-  if (value.isObject() && value.hasKey(TRI_VOC_ATTRIBUTE_ID)) {
-    identifier = arangodb::basics::VelocyPackHelper::getStringValue(
-        value, TRI_VOC_ATTRIBUTE_ID, "");
-  } else if (value.isString()) {
-    identifier = value.copyString();
-  }
+AqlValue Functions::GraphRadius(arangodb::aql::Query* query,
+                                arangodb::AqlTransaction* trx,
+                                FunctionParameters const& parameters) {
+  auto tmp = transformParameters(parameters, trx);
+  return AqlValue(GraphRadiusVPack(query, trx, tmp));
+}
 
-  if (!identifier.empty()) {
-    size_t pos = identifier.find('/');
+AqlValue$ Functions::GraphRadiusVPack(
+    arangodb::aql::Query* query, arangodb::AqlTransaction* trx,
+    VPackFunctionParameters const& parameters) {
+  auto measures =
+      LoadGraphMeasures(query, trx, parameters, "GRAPH_RADIUS", false);
 
-    if (pos != std::string::npos) {
-      bool const same = (colName == identifier.substr(0, pos));
+  std::vector<double> eccentricity;
+  std::vector<double> closeness;
+  measures->distances(eccentricity, closeness);
 
-      std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-      b->add(VPackValue(same));
-      return AqlValue$(b.get());
+  // vertices without any reachable vertex are not considered
+  double radius = 0.0;
+  for (auto const& value : eccentricity) {
+    if (value > 0.0 && (radius == 0.0 || value < radius)) {
+      radius = value;
     }
-
-    // fallthrough intentional
   }
 
-  RegisterWarning(query, "IS_SAME_COLLECTION",
-                  TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
-  std::shared_ptr<VPackBuilder> b = query->getSharedBuilder();
-  b->add(VPackValue(VPackValueType::Null));
-  return AqlValue$(b.get());
+  if (radius == 0.0) {
+    return NullValue(query);
+  }
+  return NumberValue(query, radius);
 }
-
@@ -223,6 +223,109 @@ struct Functions {
                            FunctionParameters const&);
   static AqlValue IsSameCollection(arangodb::aql::Query*, arangodb::AqlTransaction*, 
                                    FunctionParameters const&);
+  static AqlValue ConcatSeparator(arangodb::aql::Query*,
+                                  arangodb::AqlTransaction*,
+                                  FunctionParameters const&);
+  static AqlValue CharLength(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                             FunctionParameters const&);
+  static AqlValue Lower(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                        FunctionParameters const&);
+  static AqlValue Upper(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                        FunctionParameters const&);
+  static AqlValue Substring(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                            FunctionParameters const&);
+  static AqlValue Contains(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                           FunctionParameters const&);
+  static AqlValue Left(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                       FunctionParameters const&);
+  static AqlValue Right(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                        FunctionParameters const&);
+  static AqlValue Trim(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                       FunctionParameters const&);
+  static AqlValue LTrim(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                        FunctionParameters const&);
+  static AqlValue RTrim(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                        FunctionParameters const&);
+  static AqlValue FindFirst(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                            FunctionParameters const&);
+  static AqlValue FindLast(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                           FunctionParameters const&);
+  static AqlValue Split(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                        FunctionParameters const&);
+  static AqlValue Substitute(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                             FunctionParameters const&);
+  static AqlValue IsDatestring(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                               FunctionParameters const&);
+  static AqlValue DateNow(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                          FunctionParameters const&);
+  static AqlValue DateTimestamp(arangodb::aql::Query*,
+                                arangodb::AqlTransaction*,
+                                FunctionParameters const&);
+  static AqlValue DateIso8601(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              FunctionParameters const&);
+  static AqlValue DateDayOfWeek(arangodb::aql::Query*,
+                                arangodb::AqlTransaction*,
+                                FunctionParameters const&);
+  static AqlValue DateYear(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                           FunctionParameters const&);
+  static AqlValue DateMonth(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                            FunctionParameters const&);
+  static AqlValue DateDay(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                          FunctionParameters const&);
+  static AqlValue DateHour(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                           FunctionParameters const&);
+  static AqlValue DateMinute(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                             FunctionParameters const&);
+  static AqlValue DateSecond(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                             FunctionParameters const&);
+  static AqlValue DateMillisecond(arangodb::aql::Query*,
+                                  arangodb::AqlTransaction*,
+                                  FunctionParameters const&);
+  static AqlValue DateDayOfYear(arangodb::aql::Query*,
+                                arangodb::AqlTransaction*,
+                                FunctionParameters const&);
+  static AqlValue DateIsoWeek(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              FunctionParameters const&);
+  static AqlValue DateLeapYear(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                               FunctionParameters const&);
+  static AqlValue DateQuarter(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              FunctionParameters const&);
+  static AqlValue DateDaysInMonth(arangodb::aql::Query*,
+                                  arangodb::AqlTransaction*,
+                                  FunctionParameters const&);
+  static AqlValue DateAdd(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                          FunctionParameters const&);
+  static AqlValue DateSubtract(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                               FunctionParameters const&);
+  static AqlValue DateDiff(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                           FunctionParameters const&);
+  static AqlValue DateCompare(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              FunctionParameters const&);
+  static AqlValue DateFormat(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                             FunctionParameters const&);
+  static AqlValue GraphEccentricity(arangodb::aql::Query*,
+                                    arangodb::AqlTransaction*,
+                                    FunctionParameters const&);
+  static AqlValue GraphBetweenness(arangodb::aql::Query*,
+                                   arangodb::AqlTransaction*,
+                                   FunctionParameters const&);
+  static AqlValue GraphCloseness(arangodb::aql::Query*,
+                                 arangodb::AqlTransaction*,
+                                 FunctionParameters const&);
+  static AqlValue GraphAbsoluteEccentricity(arangodb::aql::Query*,
+                                            arangodb::AqlTransaction*,
+                                            FunctionParameters const&);
+  static AqlValue GraphAbsoluteBetweenness(arangodb::aql::Query*,
+                                           arangodb::AqlTransaction*,
+                                           FunctionParameters const&);
+  static AqlValue GraphAbsoluteCloseness(arangodb::aql::Query*,
+                                         arangodb::AqlTransaction*,
+                                         FunctionParameters const&);
+  static AqlValue GraphDiameter(arangodb::aql::Query*,
+                                arangodb::AqlTransaction*,
+                                FunctionParameters const&);
+  static AqlValue GraphRadius(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              FunctionParameters const&);
 
 
   static AqlValue$ IsNullVPack(arangodb::aql::Query*, arangodb::AqlTransaction*,
@@ -411,6 +514,133 @@ struct Functions {
   static AqlValue$ IsSameCollectionVPack(arangodb::aql::Query*,
                                          arangodb::AqlTransaction*,
                                          VPackFunctionParameters const&);
+  static AqlValue$ ConcatSeparatorVPack(arangodb::aql::Query*,
+                                        arangodb::AqlTransaction*,
+                                        VPackFunctionParameters const&);
+  static AqlValue$ CharLengthVPack(arangodb::aql::Query*,
+                                   arangodb::AqlTransaction*,
+                                   VPackFunctionParameters const&);
+  static AqlValue$ LowerVPack(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              VPackFunctionParameters const&);
+  static AqlValue$ UpperVPack(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              VPackFunctionParameters const&);
+  static AqlValue$ SubstringVPack(arangodb::aql::Query*,
+                                  arangodb::AqlTransaction*,
+                                  VPackFunctionParameters const&);
+  static AqlValue$ ContainsVPack(arangodb::aql::Query*,
+                                 arangodb::AqlTransaction*,
+                                 VPackFunctionParameters const&);
+  static AqlValue$ LeftVPack(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                             VPackFunctionParameters const&);
+  static AqlValue$ RightVPack(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              VPackFunctionParameters const&);
+  static AqlValue$ TrimVPack(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                             VPackFunctionParameters const&);
+  static AqlValue$ LTrimVPack(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              VPackFunctionParameters const&);
+  static AqlValue$ RTrimVPack(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              VPackFunctionParameters const&);
+  static AqlValue$ FindFirstVPack(arangodb::aql::Query*,
+                                  arangodb::AqlTransaction*,
+                                  VPackFunctionParameters const&);
+  static AqlValue$ FindLastVPack(arangodb::aql::Query*,
+                                 arangodb::AqlTransaction*,
+                                 VPackFunctionParameters const&);
+  static AqlValue$ SplitVPack(arangodb::aql::Query*, arangodb::AqlTransaction*,
+                              VPackFunctionParameters const&);
+  static AqlValue$ SubstituteVPack(arangodb::aql::Query*,
+                                   arangodb::AqlTransaction*,
+                                   VPackFunctionParameters const&);
+  static AqlValue$ IsDatestringVPack(arangodb::aql::Query*,
+                                     arangodb::AqlTransaction*,
+                                     VPackFunctionParameters const&);
+  static AqlValue$ DateNowVPack(arangodb::aql::Query*,
+                                arangodb::AqlTransaction*,
+                                VPackFunctionParameters const&);
+  static AqlValue$ DateTimestampVPack(arangodb::aql::Query*,
+                                      arangodb::AqlTransaction*,
+                                      VPackFunctionParameters const&);
+  static AqlValue$ DateIso8601VPack(arangodb::aql::Query*,
+                                    arangodb::AqlTransaction*,
+                                    VPackFunctionParameters const&);
+  static AqlValue$ DateDayOfWeekVPack(arangodb::aql::Query*,
+                                      arangodb::AqlTransaction*,
+                                      VPackFunctionParameters const&);
+  static AqlValue$ DateYearVPack(arangodb::aql::Query*,
+                                 arangodb::AqlTransaction*,
+                                 VPackFunctionParameters const&);
+  static AqlValue$ DateMonthVPack(arangodb::aql::Query*,
+                                  arangodb::AqlTransaction*,
+                                  VPackFunctionParameters const&);
+  static AqlValue$ DateDayVPack(arangodb::aql::Query*,
+                                arangodb::AqlTransaction*,
+                                VPackFunctionParameters const&);
+  static AqlValue$ DateHourVPack(arangodb::aql::Query*,
+                                 arangodb::AqlTransaction*,
+                                 VPackFunctionParameters const&);
+  static AqlValue$ DateMinuteVPack(arangodb::aql::Query*,
+                                   arangodb::AqlTransaction*,
+                                   VPackFunctionParameters const&);
+  static AqlValue$ DateSecondVPack(arangodb::aql::Query*,
+                                   arangodb::AqlTransaction*,
+                                   VPackFunctionParameters const&);
+  static AqlValue$ DateMillisecondVPack(arangodb::aql::Query*,
+                                        arangodb::AqlTransaction*,
+                                        VPackFunctionParameters const&);
+  static AqlValue$ DateDayOfYearVPack(arangodb::aql::Query*,
+                                      arangodb::AqlTransaction*,
+                                      VPackFunctionParameters const&);
+  static AqlValue$ DateIsoWeekVPack(arangodb::aql::Query*,
+                                    arangodb::AqlTransaction*,
+                                    VPackFunctionParameters const&);
+  static AqlValue$ DateLeapYearVPack(arangodb::aql::Query*,
+                                     arangodb::AqlTransaction*,
+                                     VPackFunctionParameters const&);
+  static AqlValue$ DateQuarterVPack(arangodb::aql::Query*,
+                                    arangodb::AqlTransaction*,
+                                    VPackFunctionParameters const&);
+  static AqlValue$ DateDaysInMonthVPack(arangodb::aql::Query*,
+                                        arangodb::AqlTransaction*,
+                                        VPackFunctionParameters const&);
+  static AqlValue$ DateAddVPack(arangodb::aql::Query*,
+                                arangodb::AqlTransaction*,
+                                VPackFunctionParameters const&);
+  static AqlValue$ DateSubtractVPack(arangodb::aql::Query*,
+                                     arangodb::AqlTransaction*,
+                                     VPackFunctionParameters const&);
+  static AqlValue$ DateDiffVPack(arangodb::aql::Query*,
+                                 arangodb::AqlTransaction*,
+                                 VPackFunctionParameters const&);
+  static AqlValue$ DateCompareVPack(arangodb::aql::Query*,
+                                    arangodb::AqlTransaction*,
+                                    VPackFunctionParameters const&);
+  static AqlValue$ DateFormatVPack(arangodb::aql::Query*,
+                                   arangodb::AqlTransaction*,
+                                   VPackFunctionParameters const&);
+  static AqlValue$ GraphEccentricityVPack(arangodb::aql::Query*,
+                                          arangodb::AqlTransaction*,
+                                          VPackFunctionParameters const&);
+  static AqlValue$ GraphBetweennessVPack(arangodb::aql::Query*,
+                                         arangodb::AqlTransaction*,
+                                         VPackFunctionParameters const&);
+  static AqlValue$ GraphClosenessVPack(arangodb::aql::Query*,
+                                       arangodb::AqlTransaction*,
+                                       VPackFunctionParameters const&);
+  static AqlValue$ GraphAbsoluteEccentricityVPack(arangodb::aql::Query*,
+                                                  arangodb::AqlTransaction*,
+                                                  VPackFunctionParameters const&);
+  static AqlValue$ GraphAbsoluteBetweennessVPack(arangodb::aql::Query*,
+                                                 arangodb::AqlTransaction*,
+                                                 VPackFunctionParameters const&);
+  static AqlValue$ GraphAbsoluteClosenessVPack(arangodb::aql::Query*,
+                                               arangodb::AqlTransaction*,
+                                               VPackFunctionParameters const&);
+  static AqlValue$ GraphDiameterVPack(arangodb::aql::Query*,
+                                      arangodb::AqlTransaction*,
+                                      VPackFunctionParameters const&);
+  static AqlValue$ GraphRadiusVPack(arangodb::aql::Query*,
+                                    arangodb::AqlTransaction*,
+                                    VPackFunctionParameters const&);
 };
 }
 }
@@ -0,0 +1,585 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "GraphMeasures.h"
+#include "Aql/CollectionScanner.h"
+#include "Aql/Graphs.h"
+#include "Aql/Query.h"
+#include "Basics/Barrier.h"
+#include "Basics/Exceptions.h"
+#include "Basics/RandomGenerator.h"
+#include "Basics/ThreadPool.h"
+#include "Basics/system-functions.h"
+#include "Utils/AqlTransaction.h"
+#include "V8Server/V8Traverser.h"
+#include "VocBase/ExampleMatcher.h"
+#include "VocBase/document-collection.h"
+
+#include <numeric>
+
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+using VertexId = arangodb::traverser::VertexId;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief approximate memory used per vertex for its entry, its hash table
+/// node and its offset in the adjacency array
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const VertexMemoryUsage =
+    2 * sizeof(VertexId) + 4 * sizeof(size_t) + 2 * sizeof(void*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of documents fetched per scan of a vertex collection
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const ScanBatchSize = 1000;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief add a collection to the transaction if it is not yet part of it,
+/// and make sure its documents stay valid until the transaction ends
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_transaction_collection_t* EnsureCollection(
+    arangodb::AqlTransaction* trx, std::string const& name) {
+  TRI_voc_cid_t const cid = trx->resolver()->getCollectionId(name);
+
+  if (cid == 0) {
+    THROW_ARANGO_EXCEPTION_FORMAT(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND, "'%s'",
+                                  name.c_str());
+  }
+
+  auto collection = trx->trxCollection(cid);
+
+  if (collection == nullptr) {
+    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
+                                           TRI_TRANSACTION_READ,
+                                           trx->nestingLevel(), true, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+
+    TRI_EnsureCollectionsTransaction(trx->getInternals());
+    collection = trx->trxCollection(cid);
+
+    if (collection == nullptr) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "collection is a nullptr");
+    }
+  }
+
+  if (trx->orderDitch(collection) == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return collection;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a matcher for an example. returns a nullptr if the example
+/// matches all documents, and throws TRI_RESULT_ELEMENT_NOT_FOUND if it
+/// cannot match any document of the collection
+////////////////////////////////////////////////////////////////////////////////
+
+static std::unique_ptr<arangodb::ExampleMatcher> CreateMatcher(
+    VPackSlice const& example, TRI_document_collection_t* document,
+    arangodb::CollectionNameResolver const* resolver) {
+  if (example.isNone() || example.isNull() ||
+      ((example.isObject() || example.isArray()) && example.length() == 0)) {
+    return nullptr;
+  }
+
+  return std::make_unique<arangodb::ExampleMatcher>(
+      example, document->getShaper(), resolver, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief names of the collections in a stable order
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<std::string> SortedNames(
+    std::unordered_set<std::string> const& names) {
+  std::vector<std::string> result(names.begin(), names.end());
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+GraphMeasures::GraphMeasures(Query* query, arangodb::AqlTransaction* trx,
+                             Graph const* graph, Options const& options)
+    : _query(query),
+      _trx(trx),
+      _graph(graph),
+      _options(options),
+      _memoryUsage(0) {}
+
+GraphMeasures::~GraphMeasures() {
+  _query->resourceMonitor()->decreaseMemoryUsage(_memoryUsage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the vertices and edges of the graph
+////////////////////////////////////////////////////////////////////////////////
+
+void GraphMeasures::load(VPackSlice const& vertexExample,
+                         VPackSlice const& edgeExamples) {
+  TRI_ASSERT(_vertices.empty());
+  auto resolver = _trx->resolver();
+
+  for (auto const& name : SortedNames(_graph->vertexCollections())) {
+    auto trxCollection = EnsureCollection(_trx, name);
+    TRI_voc_cid_t const cid = trxCollection->_cid;
+
+    std::unique_ptr<arangodb::ExampleMatcher> matcher;
+    bool matchesNone = false;
+
+    try {
+      matcher = CreateMatcher(vertexExample, _trx->documentCollection(cid),
+                              resolver);
+    } catch (arangodb::basics::Exception const& ex) {
+      if (ex.code() != TRI_RESULT_ELEMENT_NOT_FOUND) {
+        throw;
+      }
+      matchesNone = true;
+    }
+
+    LinearCollectionScanner scanner(_trx, trxCollection);
+    std::vector<TRI_doc_mptr_copy_t> documents;
+
+    while (true) {
+      documents.clear();
+      int res = scanner.scan(documents, ScanBatchSize);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        THROW_ARANGO_EXCEPTION(res);
+      }
+
+      if (documents.empty()) {
+        break;
+      }
+
+      for (auto const& document : documents) {
+        size_t const v =
+            lookupVertex(VertexId(cid, TRI_EXTRACT_MARKER_KEY(&document)));
+        _selected[v] = !matchesNone && (matcher == nullptr ||
+                                        matcher->matches(cid, &document));
+      }
+    }
+  }
+
+  struct EdgeCollection {
+    std::unique_ptr<EdgeCollectionInfo> info;
+    std::unique_ptr<arangodb::ExampleMatcher> matcher;
+  };
+
+  std::vector<EdgeCollection> edgeCollections;
+
+  for (auto const& name : SortedNames(_graph->edgeCollections())) {
+    if (!_options.edgeCollectionRestriction.empty() &&
+        _options.edgeCollectionRestriction.find(name) ==
+            _options.edgeCollectionRestriction.end()) {
+      continue;
+    }
+
+    TRI_voc_cid_t cid = EnsureCollection(_trx, name)->_cid;
+    auto document = _trx->documentCollection(cid);
+
+    EdgeCollection collection;
+
+    try {
+      collection.matcher = CreateMatcher(edgeExamples, document, resolver);
+    } catch (arangodb::basics::Exception const& ex) {
+      if (ex.code() != TRI_RESULT_ELEMENT_NOT_FOUND) {
+        throw;
+      }
+      // no edge of this collection can match
+      continue;
+    }
+
+    WeightCalculatorFunction weighter;
+
+    if (_options.weightAttribute.empty()) {
+      weighter = [](TRI_doc_mptr_copy_t&) -> double { return 1; };
+    } else {
+      weighter = AttributeWeightCalculator(_options.weightAttribute,
+                                           _options.defaultWeight,
+                                           document->getShaper());
+    }
+
+    collection.info.reset(
+        new EdgeCollectionInfo(_trx, cid, document, weighter));
+    edgeCollections.emplace_back(std::move(collection));
+  }
+
+  bool const outbound = (_options.direction != TRI_EDGE_IN);
+  bool const inbound = (_options.direction != TRI_EDGE_OUT);
+
+  _offsets.reserve(_vertices.size() + 1);
+  _offsets.emplace_back(0);
+
+  // vertices only referenced by edges are appended while the loop runs,
+  // so that their edges are read, too
+  for (size_t v = 0; v < _vertices.size(); ++v) {
+    if (_query->killed()) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_KILLED);
+    }
+
+    // copy the id, adding vertices may reallocate _vertices
+    VertexId const id = _vertices[v];
+    size_t const first = _neighbors.size();
+
+    auto addNeighbors = [&](EdgeCollection& collection,
+                            TRI_edge_direction_e direction) -> void {
+      auto edges = collection.info->getEdges(direction, id);
+
+      for (auto& edge : edges) {
+        if (collection.matcher != nullptr &&
+            !collection.matcher->matches(collection.info->getCid(), &edge)) {
+          continue;
+        }
+
+        VertexId const neighbor =
+            (direction == TRI_EDGE_OUT)
+                ? VertexId(TRI_EXTRACT_MARKER_TO_CID(&edge),
+                           TRI_EXTRACT_MARKER_TO_KEY(&edge))
+                : VertexId(TRI_EXTRACT_MARKER_FROM_CID(&edge),
+                           TRI_EXTRACT_MARKER_FROM_KEY(&edge));
+
+        if (neighbor == id) {
+          // self-loops never lie on a shortest path
+          continue;
+        }
+
+        double const weight = collection.info->weightEdge(edge);
+
+        if (weight == std::numeric_limits<double>::infinity()) {
+          // the edge has no weight and there is no default
+          continue;
+        }
+
+        if (weight < 0.0) {
+          THROW_ARANGO_EXCEPTION_MESSAGE(
+              TRI_ERROR_GRAPH_INVALID_PARAMETER,
+              "negative edge weights are not supported");
+        }
+
+        _neighbors.emplace_back(lookupVertex(neighbor), weight);
+      }
+    };
+
+    for (auto& collection : edgeCollections) {
+      if (outbound) {
+        addNeighbors(collection, TRI_EDGE_OUT);
+      }
+      if (inbound) {
+        addNeighbors(collection, TRI_EDGE_IN);
+      }
+    }
+
+    // parallel edges are merged into the lightest one
+    auto begin = _neighbors.begin() + first;
+    std::sort(begin, _neighbors.end(),
+              [](Tree::Neighbor const& lhs, Tree::Neighbor const& rhs) {
+                return (lhs.vertex < rhs.vertex ||
+                        (lhs.vertex == rhs.vertex && lhs.weight < rhs.weight));
+              });
+    auto end = std::unique(
+        begin, _neighbors.end(),
+        [](Tree::Neighbor const& lhs, Tree::Neighbor const& rhs) {
+          return lhs.vertex == rhs.vertex;
+        });
+    _neighbors.erase(end, _neighbors.end());
+
+    increaseMemoryUsage((_neighbors.size() - first) * sizeof(Tree::Neighbor));
+    _offsets.emplace_back(_neighbors.size());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the _id of a vertex
+////////////////////////////////////////////////////////////////////////////////
+
+std::string GraphMeasures::vertexId(size_t vertex) const {
+  return _vertices[vertex].toString(_trx->resolver());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compute the absolute eccentricity and closeness of the selected
+/// vertices
+////////////////////////////////////////////////////////////////////////////////
+
+void GraphMeasures::distances(std::vector<double>& eccentricity,
+                              std::vector<double>& closeness) {
+  size_t const n = _vertices.size();
+  eccentricity.assign(n, 0.0);
+  closeness.assign(n, 0.0);
+
+  std::vector<size_t> sources;
+  for (size_t v = 0; v < n; ++v) {
+    if (_selected[v]) {
+      sources.emplace_back(v);
+    }
+  }
+
+  // every source is handled by exactly one worker, so the workers can
+  // write their results directly
+  forEachSource(sources, numberWorkers(sources.size()),
+                [&](size_t, Tree const& tree) -> void {
+                  double maximum = 0.0;
+                  double sum = 0.0;
+
+                  for (auto const& v : tree.order()) {
+                    double const distance = tree.distance(v);
+                    maximum = (std::max)(maximum, distance);
+                    sum += distance;
+                  }
+
+                  size_t const source = tree.order()[0];
+                  eccentricity[source] = maximum;
+                  closeness[source] = sum;
+                });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compute the absolute betweenness of all vertices
+////////////////////////////////////////////////////////////////////////////////
+
+void GraphMeasures::betweenness(std::vector<double>& result) {
+  size_t const n = _vertices.size();
+  result.assign(n, 0.0);
+
+  std::vector<size_t> sources(n);
+  std::iota(sources.begin(), sources.end(), 0);
+
+  if (_options.samples > 0 && _options.samples < n) {
+    // pick the sources randomly and extrapolate their contributions
+    for (size_t i = 0; i < _options.samples; ++i) {
+      size_t j = arangodb::basics::Random::interval(
+          static_cast<uint32_t>(i), static_cast<uint32_t>(n - 1));
+      std::swap(sources[i], sources[j]);
+    }
+    sources.resize(_options.samples);
+  }
+
+  size_t const numWorkers = numberWorkers(sources.size());
+
+  // each worker accumulates into its own vectors, which are summed up
+  // when all sources are done
+  size_t const accumulatorMemory = 2 * numWorkers * n * sizeof(double);
+  _query->resourceMonitor()->increaseMemoryUsage(accumulatorMemory);
+
+  try {
+    std::vector<std::vector<double>> centralities(numWorkers,
+                                                  std::vector<double>(n, 0.0));
+    std::vector<std::vector<double>> dependencies(numWorkers,
+                                                  std::vector<double>(n, 0.0));
+
+    forEachSource(
+        sources, numWorkers, [&](size_t worker, Tree const& tree) -> void {
+          auto& centrality = centralities[worker];
+          auto& dependency = dependencies[worker];
+          auto const& order = tree.order();
+
+          for (auto const& v : order) {
+            dependency[v] = 0.0;
+          }
+
+          // walk the vertices by descending distance, so that the
+          // dependency of a vertex is final before it is propagated
+          for (size_t i = order.size(); i > 1; --i) {
+            size_t const w = order[i - 1];
+            double const factor = (1.0 + dependency[w]) / tree.paths(w);
+
+            for (auto const& v : tree.predecessors(w)) {
+              dependency[v] += tree.paths(v) * factor;
+            }
+            centrality[w] += dependency[w];
+          }
+        });
+
+    for (auto const& centrality : centralities) {
+      for (size_t v = 0; v < n; ++v) {
+        result[v] += centrality[v];
+      }
+    }
+  } catch (...) {
+    _query->resourceMonitor()->decreaseMemoryUsage(accumulatorMemory);
+    throw;
+  }
+
+  _query->resourceMonitor()->decreaseMemoryUsage(accumulatorMemory);
+
+  if (sources.size() < n && !sources.empty()) {
+    double const scale = static_cast<double>(n) / sources.size();
+    for (auto& value : result) {
+      value *= scale;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dense number of a vertex, adds the vertex if it is unknown
+////////////////////////////////////////////////////////////////////////////////
+
+size_t GraphMeasures::lookupVertex(VertexId const& id) {
+  auto it = _numbers.find(id);
+
+  if (it != _numbers.end()) {
+    return it->second;
+  }
+
+  increaseMemoryUsage(VertexMemoryUsage);
+
+  size_t const number = _vertices.size();
+  _vertices.emplace_back(id);
+  _selected.emplace_back(false);
+  _numbers.emplace(id, number);
+
+  return number;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief expander handing out the adjacency array of a vertex
+////////////////////////////////////////////////////////////////////////////////
+
+void GraphMeasures::expand(size_t vertex, Tree::Neighbor const*& begin,
+                           Tree::Neighbor const*& end) const {
+  Tree::Neighbor const* base = _neighbors.data();
+  begin = base + _offsets[vertex];
+  end = base + _offsets[vertex + 1];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run a shortest path search from each of the sources. the workers
+/// claim the sources one by one, so that uneven search costs are balanced.
+/// the calling thread is worker 0
+////////////////////////////////////////////////////////////////////////////////
+
+void GraphMeasures::forEachSource(
+    std::vector<size_t> const& sources, size_t numWorkers,
+    std::function<void(size_t, Tree const&)> const& callback) {
+  if (sources.empty()) {
+    return;
+  }
+
+  size_t const n = _vertices.size();
+  bool const weighted = !_options.weightAttribute.empty();
+
+  // the memory of the trees is charged up front, as the resource monitor
+  // must only be modified by the thread executing the query
+  size_t const treeMemory =
+      numWorkers *
+      (n * (2 * sizeof(double) + sizeof(size_t) + sizeof(std::vector<size_t>)) +
+       _neighbors.size() * sizeof(size_t));
+  _query->resourceMonitor()->increaseMemoryUsage(treeMemory);
+
+  std::atomic<size_t> next(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr error;
+  std::mutex mutex;
+
+  auto work = [&](size_t worker) -> void {
+    try {
+      Tree tree(n, weighted, [this](size_t vertex, Tree::Neighbor const*& begin,
+                                    Tree::Neighbor const*& end) -> void {
+        expand(vertex, begin, end);
+      });
+
+      while (!failed.load()) {
+        size_t const i = next++;
+
+        if (i >= sources.size()) {
+          break;
+        }
+
+        if (_query->killed()) {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_KILLED);
+        }
+
+        tree.compute(sources[i]);
+        callback(worker, tree);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(mutex);
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+      failed = true;
+    }
+  };
+
+  if (numWorkers > 1 && _pool == nullptr) {
+    try {
+      _pool.reset(new arangodb::basics::ThreadPool(numWorkers - 1,
+                                                   "AqlGraphMeasures"));
+    } catch (...) {
+      // run the searches on the calling thread
+    }
+  }
+
+  if (numWorkers > 1 && _pool != nullptr) {
+    arangodb::basics::Barrier barrier(numWorkers - 1);
+
+    for (size_t worker = 1; worker < numWorkers; ++worker) {
+      try {
+        _pool->enqueue([&work, &barrier, worker]() -> void {
+          arangodb::basics::BarrierTask task(&barrier);
+          work(worker);
+        });
+      } catch (...) {
+        // the running workers will process the remaining sources
+        barrier.join();
+      }
+    }
+
+    work(0);
+    // barrier waits here until all workers are done
+  } else {
+    work(0);
+  }
+
+  _query->resourceMonitor()->decreaseMemoryUsage(treeMemory);
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of workers used for a number of sources, at most one per
+/// processor
+////////////////////////////////////////////////////////////////////////////////
+
+size_t GraphMeasures::numberWorkers(size_t numSources) const {
+  size_t result = (std::min)(
+      (std::min)(_query->maxParallelism(), TRI_numberProcessors()),
+      numSources);
+  return (std::max)(result, static_cast<size_t>(1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief charge memory to the query and remember it for the destructor
+////////////////////////////////////////////////////////////////////////////////
+
+void GraphMeasures::increaseMemoryUsage(size_t value) {
+  _query->resourceMonitor()->increaseMemoryUsage(value);
+  _memoryUsage += value;
+}
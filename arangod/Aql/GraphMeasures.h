@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_GRAPH_MEASURES_H
+#define ARANGOD_AQL_GRAPH_MEASURES_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Traverser.h"
+#include "VocBase/edge-collection.h"
+#include "VocBase/Traverser.h"
+
+namespace arangodb {
+class AqlTransaction;
+
+namespace basics {
+class ThreadPool;
+}
+
+namespace velocypack {
+class Slice;
+}
+
+namespace aql {
+class Graph;
+class Query;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes centrality measures of a named graph, i.e. the values
+/// of the GRAPH_ECCENTRICITY, GRAPH_CLOSENESS and GRAPH_BETWEENNESS
+/// function families. the graph is read once into a compact adjacency
+/// array with edge index lookups, and the single source shortest path
+/// searches then run on that array with up to maxParallelism threads, but
+/// at most one per processor. all accesses to the transaction happen on the
+/// calling thread
+////////////////////////////////////////////////////////////////////////////////
+
+class GraphMeasures {
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief options of the graph measure functions
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Options {
+    TRI_edge_direction_e direction;
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief edge attribute holding the weight, hops are counted if empty
+    //////////////////////////////////////////////////////////////////////////
+
+    std::string weightAttribute;
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief weight of edges without a numeric weight attribute. such edges
+    /// are not followed if it is infinite
+    //////////////////////////////////////////////////////////////////////////
+
+    double defaultWeight;
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief edge collections to follow, all of the graph if empty
+    //////////////////////////////////////////////////////////////////////////
+
+    std::unordered_set<std::string> edgeCollectionRestriction;
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief number of randomly chosen sources for approximating the
+    /// betweenness, 0 computes it exactly from all vertices
+    //////////////////////////////////////////////////////////////////////////
+
+    size_t samples;
+
+    Options()
+        : direction(TRI_EDGE_ANY),
+          defaultWeight(std::numeric_limits<double>::infinity()),
+          samples(0) {}
+  };
+
+ private:
+  typedef arangodb::basics::ShortestPathTree<double> Tree;
+
+ public:
+  GraphMeasures(GraphMeasures const&) = delete;
+  GraphMeasures& operator=(GraphMeasures const&) = delete;
+
+  GraphMeasures(Query*, arangodb::AqlTransaction*, Graph const*,
+                Options const&);
+
+  ~GraphMeasures();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief read the vertices and edges of the graph. the vertices matching
+  /// vertexExample are used as sources by distances(), edges not matching
+  /// edgeExamples are ignored. either example may be null to match all
+  //////////////////////////////////////////////////////////////////////////////
+
+  void load(arangodb::velocypack::Slice const& vertexExample,
+            arangodb::velocypack::Slice const& edgeExamples);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of vertices, including the vertices only referenced by
+  /// edges
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t numberVertices() const { return _vertices.size(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the vertex matched the vertex example
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool isSelected(size_t vertex) const { return _selected[vertex]; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the _id of a vertex
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::string vertexId(size_t vertex) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compute the largest distance (absolute eccentricity) and the sum
+  /// of the distances (absolute closeness) from each selected vertex to the
+  /// vertices reachable from it. both are 0 for unselected vertices
+  //////////////////////////////////////////////////////////////////////////////
+
+  void distances(std::vector<double>& eccentricity,
+                 std::vector<double>& closeness);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compute the absolute betweenness of all vertices with Brandes'
+  /// algorithm, over the ordered pairs of vertices
+  //////////////////////////////////////////////////////////////////////////////
+
+  void betweenness(std::vector<double>& result);
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief dense number of a vertex, adds the vertex if it is unknown
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t lookupVertex(arangodb::traverser::VertexId const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief expander handing out the adjacency array of a vertex
+  //////////////////////////////////////////////////////////////////////////////
+
+  void expand(size_t, Tree::Neighbor const*&, Tree::Neighbor const*&) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief run a shortest path search from each of the sources with the
+  /// given number of workers. the callback is invoked with the number of
+  /// the worker and the worker's finished tree
+  //////////////////////////////////////////////////////////////////////////////
+
+  void forEachSource(std::vector<size_t> const&, size_t,
+                     std::function<void(size_t, Tree const&)> const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of workers used for a number of sources
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t numberWorkers(size_t) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief charge memory to the query and remember it for the destructor
+  //////////////////////////////////////////////////////////////////////////////
+
+  void increaseMemoryUsage(size_t);
+
+ private:
+  Query* _query;
+
+  arangodb::AqlTransaction* _trx;
+
+  Graph const* _graph;
+
+  Options const _options;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the vertices and their dense numbers
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<arangodb::traverser::VertexId> _vertices;
+
+  std::unordered_map<arangodb::traverser::VertexId, size_t> _numbers;
+
+  std::vector<bool> _selected;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief adjacency array. the neighbors of vertex v are at positions
+  /// _offsets[v] to _offsets[v + 1] of _neighbors
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<size_t> _offsets;
+
+  std::vector<Tree::Neighbor> _neighbors;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the threads of the searches, except for the calling thread.
+  /// created on first use
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unique_ptr<arangodb::basics::ThreadPool> _pool;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief memory charged to the query, released by the destructor
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _memoryUsage;
+};
+}
+}
+
+#endif
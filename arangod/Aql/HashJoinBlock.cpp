@@ -0,0 +1,422 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinBlock.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/Collection.h"
+#include "Aql/CollectionScanner.h"
+#include "Aql/ExecutionEngine.h"
+#include "Basics/Exceptions.h"
+#include "Basics/Utf8Helper.h"
+#include "Basics/fasthash.h"
+#include "VocBase/vocbase.h"
+
+using namespace arangodb::aql;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hash a key of the hash table. strings compare equal under the
+/// collation if they are canonically equivalent, so they are hashed in NFC.
+/// arrays and objects compare equal even if one of them has additional null
+/// members, so only their type is hashed
+////////////////////////////////////////////////////////////////////////////////
+
+size_t HashJoinBlock::KeyHash::operator()(TRI_json_t const* value) const {
+  uint64_t const seed = 0x012345678;
+
+  if (value == nullptr) {
+    return fasthash64(static_cast<void const*>("null"), 4, seed);
+  }
+
+  switch (value->_type) {
+    case TRI_JSON_UNUSED:
+    case TRI_JSON_NULL:
+      return fasthash64(static_cast<void const*>("null"), 4, seed);
+
+    case TRI_JSON_BOOLEAN:
+      if (value->_value._boolean) {
+        return fasthash64(static_cast<void const*>("true"), 4, seed);
+      }
+      return fasthash64(static_cast<void const*>("false"), 5, seed);
+
+    case TRI_JSON_NUMBER: {
+      // -0.0 and 0.0 are equal, but differ in their bytes
+      double const number =
+          (value->_value._number == 0.0) ? 0.0 : value->_value._number;
+      return fasthash64(static_cast<void const*>(&number), sizeof(number),
+                        seed);
+    }
+
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE: {
+      char const* data = value->_value._string.data;
+      size_t const length = value->_value._string.length - 1;
+
+      bool ascii = true;
+      for (size_t i = 0; i < length; ++i) {
+        if (static_cast<unsigned char>(data[i]) >= 0x80) {
+          ascii = false;
+          break;
+        }
+      }
+
+      if (ascii) {
+        // NFC does not change pure ASCII strings
+        return fasthash64(static_cast<void const*>(data), length, seed);
+      }
+
+      size_t outLength;
+      char* normalized = TRI_normalize_utf8_to_NFC(TRI_UNKNOWN_MEM_ZONE, data,
+                                                   length, &outLength);
+
+      if (normalized == nullptr) {
+        THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+      }
+
+      uint64_t const hash =
+          fasthash64(static_cast<void const*>(normalized), outLength, seed);
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, normalized);
+      return hash;
+    }
+
+    case TRI_JSON_ARRAY:
+      return fasthash64(static_cast<void const*>("array"), 5, seed);
+
+    case TRI_JSON_OBJECT:
+      return fasthash64(static_cast<void const*>("object"), 6, seed);
+  }
+
+  return seed;  // never reached
+}
+
+HashJoinBlock::HashJoinBlock(ExecutionEngine* engine, HashJoinNode const* en)
+    : ExecutionBlock(engine, en),
+      _collection(en->collection()),
+      _buildAccessor(),
+      _probeAccessor(),
+      _buildParts(),
+      _probeParts(),
+      _buildVars(),
+      _buildRegs(),
+      _probeVars(),
+      _probeRegs(),
+      _table(),
+      _keys(),
+      _tableBuilt(false),
+      _matches(nullptr),
+      _posInMatches(0),
+      _mustStoreResult(true) {
+  auto trxCollection = _trx->trxCollection(_collection->cid());
+  if (trxCollection != nullptr) {
+    _trx->orderDitch(trxCollection);
+  }
+
+  for (auto const& it : en->buildAttribute()) {
+    _buildParts.emplace_back(it.c_str());
+  }
+  for (auto const& it : en->probeAttribute()) {
+    _probeParts.emplace_back(it.c_str());
+  }
+
+  // the documents of the collection are put into a temporary block with
+  // a single register when the hash table is built
+  _buildVars.emplace_back(en->outVariable());
+  _buildRegs.emplace_back(0);
+
+  auto it = en->getRegisterPlan()->varInfo.find(en->probeVariable()->id);
+  TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
+  _probeVars.emplace_back(en->probeVariable());
+  _probeRegs.emplace_back(it->second.registerId);
+
+  _buildAccessor.reset(new AttributeAccessor(_buildParts, en->outVariable()));
+  _probeAccessor.reset(
+      new AttributeAccessor(_probeParts, en->probeVariable()));
+}
+
+HashJoinBlock::~HashJoinBlock() { freeTable(); }
+
+int HashJoinBlock::initialize() {
+  auto en = static_cast<HashJoinNode const*>(_exeNode);
+  _mustStoreResult = en->isVarUsedLater(en->outVariable());
+
+  return ExecutionBlock::initialize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initializeCursor. the hash table is kept, as the collection's
+/// documents do not depend on the input
+////////////////////////////////////////////////////////////////////////////////
+
+int HashJoinBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
+  int res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  _matches = nullptr;
+  _posInMatches = 0;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read all documents of the collection into the hash table
+////////////////////////////////////////////////////////////////////////////////
+
+void HashJoinBlock::buildTable() {
+  TRI_ASSERT(!_tableBuilt);
+
+  auto trxCollection = _trx->trxCollection(_collection->cid());
+  auto document = _trx->documentCollection(_collection->cid());
+
+  LinearCollectionScanner scanner(_trx, trxCollection);
+  std::vector<TRI_doc_mptr_copy_t> documents;
+  documents.reserve(DefaultBatchSize);
+
+  while (true) {
+    throwIfKilled();  // check if we were aborted
+
+    documents.clear();
+    int res = scanner.scan(documents, DefaultBatchSize);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+
+    if (documents.empty()) {
+      break;
+    }
+
+    _engine->_stats.scannedFull += static_cast<int64_t>(documents.size());
+
+    size_t const n = documents.size();
+    AqlItemBlock* block = requestBlock(n, 1);
+
+    try {
+      block->setDocumentCollection(0, document);
+
+      for (size_t i = 0; i < n; ++i) {
+        block->setShaped(i, 0, reinterpret_cast<TRI_df_marker_t const*>(
+                                   documents[i].getDataPtr()));
+      }
+
+      for (size_t i = 0; i < n; ++i) {
+        auto marker = reinterpret_cast<TRI_df_marker_t const*>(
+            documents[i].getDataPtr());
+
+        AqlValue key =
+            _buildAccessor->get(_trx, block, i, _buildVars, _buildRegs);
+        TRI_ASSERT(key.isJson());
+
+        auto it = _table.find(key._json->json());
+
+        if (it != _table.end()) {
+          key.destroy();
+          (*it).second.emplace_back(marker);
+          continue;
+        }
+
+        try {
+          _keys.emplace_back(key);
+        } catch (...) {
+          key.destroy();
+          throw;
+        }
+
+        _table.emplace(key._json->json(), DocumentsType{marker});
+      }
+    } catch (...) {
+      returnBlock(block);
+      throw;
+    }
+
+    returnBlock(block);
+  }
+
+  _tableBuilt = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free the hash table
+////////////////////////////////////////////////////////////////////////////////
+
+void HashJoinBlock::freeTable() {
+  _table.clear();
+
+  for (auto& it : _keys) {
+    it.destroy();
+  }
+  _keys.clear();
+
+  _tableBuilt = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the documents for the current input row. returns false
+/// if there is no more input
+////////////////////////////////////////////////////////////////////////////////
+
+bool HashJoinBlock::findMatches(size_t atMost) {
+  while (true) {
+    if (_buffer.empty()) {
+      size_t toFetch = (std::min)(DefaultBatchSize, atMost);
+      if (!ExecutionBlock::getBlock(toFetch, toFetch)) {
+        _done = true;
+        return false;
+      }
+      _pos = 0;  // this is in the first block
+    }
+
+    // if we get here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
+
+    AqlValue key = _probeAccessor->get(_trx, cur, _pos, _probeVars, _probeRegs);
+    TRI_ASSERT(key.isJson());
+
+    auto it = _table.find(key._json->json());
+    key.destroy();
+
+    if (it != _table.end()) {
+      _matches = &((*it).second);
+      _posInMatches = 0;
+      return true;
+    }
+
+    // no matching documents for this row
+    nextRow();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief advance to the next input row
+////////////////////////////////////////////////////////////////////////////////
+
+void HashJoinBlock::nextRow() {
+  _matches = nullptr;
+  _posInMatches = 0;
+
+  AqlItemBlock* cur = _buffer.front();
+
+  if (++_pos >= cur->size()) {
+    _buffer.pop_front();  // does not throw
+    returnBlock(cur);
+    _pos = 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getSome
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* HashJoinBlock::getSome(size_t,  // atLeast,
+                                     size_t atMost) {
+  if (_done) {
+    return nullptr;
+  }
+
+  if (!_tableBuilt) {
+    buildTable();
+  }
+
+  if (_matches == nullptr && !findMatches(atMost)) {
+    return nullptr;
+  }
+
+  // If we get here, we do have _buffer.front() and matching documents
+  AqlItemBlock* cur = _buffer.front();
+  size_t const curRegs = cur->getNrRegs();
+
+  size_t const toSend = (std::min)(atMost, _matches->size() - _posInMatches);
+  RegisterId nrRegs =
+      getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()];
+
+  std::unique_ptr<AqlItemBlock> res(requestBlock(toSend, nrRegs));
+  // automatically freed if we throw
+  TRI_ASSERT(curRegs <= res->getNrRegs());
+
+  // only copy 1st row of registers inherited from previous frame(s)
+  inheritRegisters(cur, res.get(), _pos);
+
+  // set our collection for our output register
+  res->setDocumentCollection(static_cast<arangodb::aql::RegisterId>(curRegs),
+                             _trx->documentCollection(_collection->cid()));
+
+  for (size_t j = 0; j < toSend; j++) {
+    if (j > 0) {
+      // re-use already copied aqlvalues
+      for (RegisterId i = 0; i < curRegs; i++) {
+        res->setValue(j, i, res->getValueReference(0, i));
+        // Note: if this throws, then all values will be deleted
+        // properly since the first one is.
+      }
+    }
+
+    if (_mustStoreResult) {
+      // the result is in the first variable of this depth
+      res->setShaped(j, static_cast<arangodb::aql::RegisterId>(curRegs),
+                     (*_matches)[_posInMatches]);
+    }
+
+    ++_posInMatches;
+  }
+
+  if (_posInMatches >= _matches->size()) {
+    // all matches of the current row have been returned
+    nextRow();
+  }
+
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+
+  return res.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skipSome
+////////////////////////////////////////////////////////////////////////////////
+
+size_t HashJoinBlock::skipSome(size_t atLeast, size_t atMost) {
+  size_t skipped = 0;
+
+  if (_done) {
+    return skipped;
+  }
+
+  if (!_tableBuilt) {
+    buildTable();
+  }
+
+  while (skipped < atLeast) {
+    if (_matches == nullptr && !findMatches(atMost - skipped)) {
+      break;
+    }
+
+    size_t const n =
+        (std::min)(atMost - skipped, _matches->size() - _posInMatches);
+    skipped += n;
+    _posInMatches += n;
+
+    if (_posInMatches >= _matches->size()) {
+      nextRow();
+    }
+  }
+
+  return skipped;
+}
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_JOIN_BLOCK_H
+#define ARANGOD_AQL_HASH_JOIN_BLOCK_H 1
+
+#include "Aql/AttributeAccessor.h"
+#include "Aql/ExecutionBlock.h"
+#include "Aql/HashJoinNode.h"
+#include "Basics/json-utilities.h"
+
+namespace arangodb {
+namespace aql {
+class AqlItemBlock;
+struct Collection;
+class ExecutionEngine;
+
+class HashJoinBlock : public ExecutionBlock {
+ public:
+  HashJoinBlock(ExecutionEngine*, HashJoinNode const*);
+
+  ~HashJoinBlock();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief initialize
+  //////////////////////////////////////////////////////////////////////////////
+
+  int initialize() override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief initializeCursor
+  //////////////////////////////////////////////////////////////////////////////
+
+  int initializeCursor(AqlItemBlock* items, size_t pos) override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief getSome
+  //////////////////////////////////////////////////////////////////////////////
+
+  AqlItemBlock* getSome(size_t atLeast, size_t atMost) override final;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // skip between atLeast and atMost, returns the number actually skipped . . .
+  // will only return less than atLeast if there aren't atLeast many
+  // things to skip overall.
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t skipSome(size_t atLeast, size_t atMost) override final;
+
+ private:
+  typedef std::vector<TRI_df_marker_t const*> DocumentsType;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief hash function for the keys of the hash table. keys that are
+  /// equal for AQL's == operator produce the same hash value
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct KeyHash {
+    size_t operator()(TRI_json_t const*) const;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief equality for the keys of the hash table, same as AQL's ==
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct KeyEqual {
+    bool operator()(TRI_json_t const* lhs, TRI_json_t const* rhs) const {
+      return (TRI_CompareValuesJson(lhs, rhs, true) == 0);
+    }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief read all documents of the collection into the hash table
+  //////////////////////////////////////////////////////////////////////////////
+
+  void buildTable();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief free the hash table
+  //////////////////////////////////////////////////////////////////////////////
+
+  void freeTable();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief look up the documents for the current input row. returns false
+  /// if there is no more input
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool findMatches(size_t atMost);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief advance to the next input row
+  //////////////////////////////////////////////////////////////////////////////
+
+  void nextRow();
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collection
+  //////////////////////////////////////////////////////////////////////////////
+
+  Collection const* _collection;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief accessors for the build and probe attributes
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unique_ptr<AttributeAccessor> _buildAccessor;
+
+  std::unique_ptr<AttributeAccessor> _probeAccessor;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief attribute names used by the accessors
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<char const*> _buildParts;
+
+  std::vector<char const*> _probeParts;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief variables and registers used by the accessors
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<Variable const*> _buildVars;
+
+  std::vector<RegisterId> _buildRegs;
+
+  std::vector<Variable const*> _probeVars;
+
+  std::vector<RegisterId> _probeRegs;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the hash table, mapping build attribute values to documents
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unordered_map<TRI_json_t const*, DocumentsType, KeyHash, KeyEqual>
+      _table;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the keys of the hash table, owned by the block
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<AqlValue> _keys;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the hash table has been built
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _tableBuilt;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the documents matching the current input row
+  //////////////////////////////////////////////////////////////////////////////
+
+  DocumentsType const* _matches;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief current position in _matches
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _posInMatches;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the enumerated documents need to be stored
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _mustStoreResult;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
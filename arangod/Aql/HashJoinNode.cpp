@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "HashJoinNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionPlan.h"
+
+using namespace arangodb::aql;
+
+using JsonHelper = arangodb::basics::JsonHelper;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read an attribute path from JSON
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<std::string> AttributeFromJson(
+    arangodb::basics::Json const& json, char const* name) {
+  TRI_json_t const* parts =
+      JsonHelper::checkAndGetArrayValue(json.json(), name);
+
+  std::vector<std::string> result;
+  size_t const n = TRI_LengthArrayJson(parts);
+  result.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    TRI_json_t const* part = TRI_LookupArrayJson(parts, i);
+
+    if (!TRI_IsStringJson(part)) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "invalid attribute in HashJoinNode");
+    }
+
+    result.emplace_back(part->_value._string.data,
+                        part->_value._string.length - 1);
+  }
+
+  if (result.empty()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "invalid attribute in HashJoinNode");
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor for HashJoinNode from Json
+////////////////////////////////////////////////////////////////////////////////
+
+HashJoinNode::HashJoinNode(ExecutionPlan* plan,
+                           arangodb::basics::Json const& base)
+    : ExecutionNode(plan, base),
+      _vocbase(plan->getAst()->query()->vocbase()),
+      _collection(plan->getAst()->query()->collections()->get(
+          JsonHelper::checkAndGetStringValue(base.json(), "collection"))),
+      _outVariable(varFromJson(plan->getAst(), base, "outVariable")),
+      _buildAttribute(AttributeFromJson(base, "buildAttribute")),
+      _probeVariable(varFromJson(plan->getAst(), base, "probeVariable")),
+      _probeAttribute(AttributeFromJson(base, "probeAttribute")) {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toVelocyPack, for HashJoinNode
+////////////////////////////////////////////////////////////////////////////////
+
+void HashJoinNode::toVelocyPackHelper(VPackBuilder& nodes,
+                                      bool verbose) const {
+  ExecutionNode::toVelocyPackHelperGeneric(nodes,
+                                           verbose);  // call base class method
+
+  nodes.add("database", VPackValue(_vocbase->_name));
+  nodes.add("collection", VPackValue(_collection->getName()));
+  nodes.add(VPackValue("outVariable"));
+  _outVariable->toVelocyPack(nodes);
+
+  nodes.add(VPackValue("buildAttribute"));
+  {
+    VPackArrayBuilder guard(&nodes);
+    for (auto const& it : _buildAttribute) {
+      nodes.add(VPackValue(it));
+    }
+  }
+
+  nodes.add(VPackValue("probeVariable"));
+  _probeVariable->toVelocyPack(nodes);
+
+  nodes.add(VPackValue("probeAttribute"));
+  {
+    VPackArrayBuilder guard(&nodes);
+    for (auto const& it : _probeAttribute) {
+      nodes.add(VPackValue(it));
+    }
+  }
+
+  // And close it:
+  nodes.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* HashJoinNode::clone(ExecutionPlan* plan, bool withDependencies,
+                                   bool withProperties) const {
+  auto outVariable = _outVariable;
+  auto probeVariable = _probeVariable;
+
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+    probeVariable = plan->getAst()->variables()->createVariable(probeVariable);
+  }
+
+  auto c = new HashJoinNode(plan, _id, _vocbase, _collection, outVariable,
+                            _buildAttribute, probeVariable, _probeAttribute);
+
+  cloneHelper(c, plan, withDependencies, withProperties);
+
+  return static_cast<ExecutionNode*>(c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the collection is read once to build the hash table. we assume
+/// that each incoming row finds one matching document, which is the case for
+/// the typical join on a unique attribute
+////////////////////////////////////////////////////////////////////////////////
+
+double HashJoinNode::estimateCost(size_t& nrItems) const {
+  size_t incoming = 0;
+  double const dependencyCost = _dependencies.at(0)->getCost(incoming);
+  size_t const count = _collection->count();
+
+  nrItems = incoming;
+  // building the hash table is slightly more expensive than a plain scan
+  return dependencyCost + count * 1.5 + incoming;
+}
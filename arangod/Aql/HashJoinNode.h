@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_HASH_JOIN_NODE_H
+#define ARANGOD_AQL_HASH_JOIN_NODE_H 1
+
+#include "Basics/Common.h"
+#include "Aql/ExecutionNode.h"
+#include "Aql/types.h"
+#include "Aql/Variable.h"
+#include "Basics/JsonHelper.h"
+#include "VocBase/vocbase.h"
+
+namespace arangodb {
+namespace aql {
+struct Collection;
+class ExecutionBlock;
+class ExecutionPlan;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief class HashJoinNode. enumerates the documents of a collection whose
+/// build attribute is equal to the probe attribute of the incoming row. the
+/// documents are put into a hash table on their build attribute once, so
+/// that each incoming row only needs a hash lookup instead of a full
+/// collection scan
+////////////////////////////////////////////////////////////////////////////////
+
+class HashJoinNode : public ExecutionNode {
+  friend class ExecutionBlock;
+  friend class HashJoinBlock;
+
+ public:
+  HashJoinNode(ExecutionPlan* plan, size_t id, TRI_vocbase_t* vocbase,
+               Collection const* collection, Variable const* outVariable,
+               std::vector<std::string> const& buildAttribute,
+               Variable const* probeVariable,
+               std::vector<std::string> const& probeAttribute)
+      : ExecutionNode(plan, id),
+        _vocbase(vocbase),
+        _collection(collection),
+        _outVariable(outVariable),
+        _buildAttribute(buildAttribute),
+        _probeVariable(probeVariable),
+        _probeAttribute(probeAttribute) {
+    TRI_ASSERT(_vocbase != nullptr);
+    TRI_ASSERT(_collection != nullptr);
+    TRI_ASSERT(_outVariable != nullptr);
+    TRI_ASSERT(_probeVariable != nullptr);
+    TRI_ASSERT(!_buildAttribute.empty());
+    TRI_ASSERT(!_probeAttribute.empty());
+  }
+
+  HashJoinNode(ExecutionPlan*, arangodb::basics::Json const& base);
+
+  ~HashJoinNode() {}
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the type of the node
+  //////////////////////////////////////////////////////////////////////////////
+
+  NodeType getType() const override final { return HASH_JOIN; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the database
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_vocbase_t* vocbase() const { return _vocbase; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the collection
+  //////////////////////////////////////////////////////////////////////////////
+
+  Collection const* collection() const { return _collection; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return out variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* outVariable() const { return _outVariable; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the attribute of the collection's documents that is put
+  /// into the hash table
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::string> const& buildAttribute() const {
+    return _buildAttribute;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the variable that is looked up in the hash table
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* probeVariable() const { return _probeVariable; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the attribute of the probe variable that is looked up
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::string> const& probeAttribute() const {
+    return _probeAttribute;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief export to VelocyPack
+  //////////////////////////////////////////////////////////////////////////////
+
+  void toVelocyPackHelper(arangodb::velocypack::Builder&,
+                          bool) const override final;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief clone ExecutionNode recursively
+  //////////////////////////////////////////////////////////////////////////////
+
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief getVariablesSetHere
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    return std::vector<Variable const*>{_outVariable};
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief getVariablesUsedHere, returning a vector
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<Variable const*> getVariablesUsedHere() const override final {
+    return std::vector<Variable const*>{_probeVariable};
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief getVariablesUsedHere, modifying the set in-place
+  //////////////////////////////////////////////////////////////////////////////
+
+  void getVariablesUsedHere(
+      std::unordered_set<Variable const*>& vars) const override final {
+    vars.emplace(_probeVariable);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief estimateCost
+  //////////////////////////////////////////////////////////////////////////////
+
+  double estimateCost(size_t&) const override final;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the database
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_vocbase_t* _vocbase;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collection
+  //////////////////////////////////////////////////////////////////////////////
+
+  Collection const* _collection;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief output variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* _outVariable;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief attribute path of the collection's documents, e.g. [ "a", "b" ]
+  /// for doc.a.b
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::string> const _buildAttribute;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the variable of the incoming rows that is looked up
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* _probeVariable;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief attribute path of the probe variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::string> const _probeAttribute;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -65,6 +65,16 @@ void Index::toVelocyPack(VPackBuilder& builder) const {
       builder.add(VPackValue(tmp));
     }
   }
+
+  if (!storedValues.empty()) {
+    builder.add(VPackValue("storedValues"));
+    VPackArrayBuilder arrayGuard(&builder);
+    for (auto const& value : storedValues) {
+      std::string tmp;
+      TRI_AttributeNamesToString(value, tmp);
+      builder.add(VPackValue(tmp));
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -134,6 +144,19 @@ arangodb::IndexIterator* Index::getIterator(
                                               reference, reverse);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the documents for many equality values at once
+////////////////////////////////////////////////////////////////////////////////
+
+int Index::batchLookup(
+    arangodb::Transaction* trx, arangodb::IndexIteratorContext* context,
+    arangodb::aql::AstNode const* attrNode,
+    std::vector<arangodb::aql::AstNode const*> const& valNodes,
+    std::vector<std::vector<TRI_doc_mptr_t*>>& result) const {
+  TRI_ASSERT(hasInternals());
+  return getInternals()->batchLookup(trx, context, attrNode, valNodes, result);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief specialize the condition for the index
 /// this will remove all nodes from the condition that the index cannot
@@ -147,6 +170,41 @@ arangodb::aql::AstNode* Index::specializeCondition(
   return getInternals()->specializeCondition(node, reference);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the position of the top-level attribute in the index
+/// elements, or -1 if the index does not contain the attribute's value
+////////////////////////////////////////////////////////////////////////////////
+
+int Index::storedPosition(std::string const& attribute) const {
+  if (type != arangodb::Index::TRI_IDX_TYPE_HASH_INDEX &&
+      type != arangodb::Index::TRI_IDX_TYPE_SKIPLIST_INDEX) {
+    return -1;
+  }
+
+  for (auto const& field : fields) {
+    if (field.size() != 1 || field[0].shouldExpand) {
+      // an index on an expanded or a nested attribute produces elements that
+      // cannot be used to restore the top-level attribute
+      return -1;
+    }
+  }
+
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (fields[i][0].name == attribute) {
+      return static_cast<int>(i);
+    }
+  }
+
+  for (size_t i = 0; i < storedValues.size(); ++i) {
+    if (storedValues[i].size() == 1 && !storedValues[i][0].shouldExpand &&
+        storedValues[i][0].name == attribute) {
+      return static_cast<int>(fields.size() + i);
+    }
+  }
+
+  return -1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief append the index to an output stream
 ////////////////////////////////////////////////////////////////////////////////
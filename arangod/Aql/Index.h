@@ -54,6 +54,7 @@ struct Index {
         sparse(false),
         ownsInternals(false),
         fields(idx->fields()),
+        storedValues(idx->storedValues()),
         internals(idx) {
     TRI_ASSERT(internals != nullptr);
 
@@ -79,6 +80,7 @@ struct Index {
             slice, "sparse", false)),
         ownsInternals(false),
         fields(),
+        storedValues(),
         internals(nullptr) {
     VPackSlice const f = slice.get("fields");
 
@@ -95,6 +97,18 @@ struct Index {
       }
     }
 
+    VPackSlice const s = slice.get("storedValues");
+
+    if (s.isArray()) {
+      for (auto const& name : VPackArrayIterator(s)) {
+        if (name.isString()) {
+          std::vector<arangodb::basics::AttributeName> parsedAttributes;
+          TRI_ParseAttributeString(name.copyString(), parsedAttributes);
+          storedValues.emplace_back(parsedAttributes);
+        }
+      }
+    }
+
     // it is the caller's responsibility to fill the internals attribute with
     // something sensible later!
   }
@@ -122,6 +136,17 @@ struct Index {
     }
 
     json("fields", f);
+
+    if (!storedValues.empty()) {
+      arangodb::basics::Json v(arangodb::basics::Json::Array);
+      for (auto const& value : storedValues) {
+        std::string tmp;
+        TRI_AttributeNamesToString(value, tmp);
+        v.add(arangodb::basics::Json(tmp));
+      }
+      json("storedValues", v);
+    }
+
     return json;
   }
 
@@ -190,6 +215,27 @@ struct Index {
                                        arangodb::aql::Variable const*,
                                        bool) const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the index can look up many values at once
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool hasBatchLookup() const {
+    if (!hasInternals()) {
+      return false;
+    }
+
+    return getInternals()->hasBatchLookup();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief look up the documents for many equality values at once
+  //////////////////////////////////////////////////////////////////////////////
+
+  int batchLookup(arangodb::Transaction*, arangodb::IndexIteratorContext*,
+                  arangodb::aql::AstNode const*,
+                  std::vector<arangodb::aql::AstNode const*> const&,
+                  std::vector<std::vector<TRI_doc_mptr_t*>>&) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief specialize the condition for the index
   /// this will remove all nodes from the condition that the index cannot
@@ -199,6 +245,14 @@ struct Index {
   arangodb::aql::AstNode* specializeCondition(
       arangodb::aql::AstNode*, arangodb::aql::Variable const*) const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the position of the top-level attribute in the index
+  /// elements, or -1 if the index does not contain the attribute's value.
+  /// indexed fields come first, followed by the stored values
+  //////////////////////////////////////////////////////////////////////////////
+
+  int storedPosition(std::string const&) const;
+
  public:
   TRI_idx_iid_t const id;
   arangodb::Index::IndexType type;
@@ -206,6 +260,7 @@ struct Index {
   bool sparse;
   bool ownsInternals;
   std::vector<std::vector<arangodb::basics::AttributeName>> fields;
+  std::vector<std::vector<arangodb::basics::AttributeName>> storedValues;
 
  private:
   arangodb::Index* internals;
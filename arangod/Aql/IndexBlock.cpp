@@ -33,7 +33,9 @@
 #include "Basics/Exceptions.h"
 #include "Indexes/IndexIterator.h"
 #include "V8/v8-globals.h"
+#include "VocBase/document-collection.h"
 #include "VocBase/vocbase.h"
+#include "VocBase/VocShaper.h"
 
 using namespace arangodb::aql;
 
@@ -65,7 +67,14 @@ IndexBlock::IndexBlock(ExecutionEngine* engine, IndexNode const* en)
       _context(nullptr),
       _iterator(nullptr),
       _condition(en->_condition->root()),
-      _hasV8Expression(false) {
+      _hasV8Expression(false),
+      _useBatchLookup(false),
+      _batchAttribute(nullptr),
+      _batchResults(),
+      _batchRows(),
+      _posInBatchResult(0),
+      _projectionPositions(),
+      _projectionSubs() {
   _context = new IndexIteratorContext(en->_vocbase);
 
   auto trxCollection = _trx->trxCollection(_collection->cid());
@@ -134,6 +143,67 @@ void IndexBlock::executeExpressions() {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evaluate the lookup value for all rows of the current input block
+/// and look up the distinct values in the index in one go. this turns one
+/// random index probe per row into a single pass over the index, and rows
+/// with the same lookup value share the result
+////////////////////////////////////////////////////////////////////////////////
+
+void IndexBlock::executeBatchLookup() {
+  TRI_ASSERT(_useBatchLookup);
+  TRI_ASSERT(_nonConstExpressions.size() == 1);
+
+  AqlItemBlock* cur = _buffer.front();
+  size_t const n = cur->size();
+
+  auto en = static_cast<IndexNode const*>(getPlanNode());
+  auto ast = en->_plan->getAst();
+  auto exp = _nonConstExpressions[0]->expression;
+
+  std::unordered_map<TRI_json_t const*, size_t, arangodb::basics::JsonHash,
+                     arangodb::basics::JsonEqual>
+      positions;
+  // owns the distinct values. reserved upfront so the values do not move
+  std::vector<Json> values;
+  values.reserve(n);
+  std::vector<AstNode const*> valNodes;
+  valNodes.reserve(n);
+
+  _batchRows.clear();
+  _batchRows.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    TRI_document_collection_t const* myCollection = nullptr;
+    AqlValue a =
+        exp->execute(_trx, cur, i, _inVars[0], _inRegs[0], &myCollection);
+    Json jsonified = a.toJson(_trx, myCollection, true);
+    a.destroy();
+
+    auto it = positions.find(jsonified.json());
+
+    if (it != positions.end()) {
+      _batchRows.emplace_back((*it).second);
+      continue;
+    }
+
+    size_t const position = valNodes.size();
+    valNodes.emplace_back(ast->nodeFromJson(jsonified.json(), true));
+    values.emplace_back(std::move(jsonified));
+    positions.emplace(values.back().json(), position);
+    _batchRows.emplace_back(position);
+  }
+
+  int res = _indexes[0]->batchLookup(_trx, _context, _batchAttribute,
+                                     valNodes, _batchResults);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  TRI_ASSERT(_batchResults.size() == valNodes.size());
+}
+
 int IndexBlock::initialize() {
   ENTER_BLOCK
   int res = ExecutionBlock::initialize();
@@ -179,6 +249,23 @@ int IndexBlock::initialize() {
         }
       };
 
+  _projectionPositions.clear();
+
+  if (!en->projections().empty()) {
+    // the optimizer has made sure that all indexes contain the values
+    // of all projected attributes
+    for (auto const& index : _indexes) {
+      _projectionPositions.emplace_back();
+
+      for (auto const& attribute : en->projections()) {
+        int position = index->storedPosition(attribute);
+        TRI_ASSERT(position >= 0);
+        _projectionPositions.back().emplace_back(
+            static_cast<size_t>(position));
+      }
+    }
+  }
+
   if (_condition == nullptr) {
     // This Node has no condition. Iterate over the complete index.
     return TRI_ERROR_NO_ERROR;
@@ -221,6 +308,28 @@ int IndexBlock::initialize() {
     }
   }
 
+  // a single equality lookup with a dynamic value, e.g. in a correlated
+  // inner loop, can be done for a whole input block at once
+  _useBatchLookup = false;
+  _batchAttribute = nullptr;
+
+  if (_indexes.size() == 1 && _condition->numMembers() == 1 &&
+      _condition->getMemberUnchecked(0)->numMembers() == 1 &&
+      _nonConstExpressions.size() == 1 && !_hasV8Expression &&
+      _projectionPositions.empty() && _indexes[0]->hasBatchLookup()) {
+    auto leaf = _condition->getMemberUnchecked(0)->getMemberUnchecked(0);
+
+    if (leaf->type == NODE_TYPE_OPERATOR_BINARY_EQ) {
+      auto attribute =
+          leaf->getMember(1 - _nonConstExpressions[0]->operatorMember);
+
+      if (attribute->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+        _batchAttribute = attribute;
+        _useBatchLookup = true;
+      }
+    }
+  }
+
   return res;
   LEAVE_BLOCK;
 }
@@ -247,6 +356,25 @@ bool IndexBlock::initIndexes() {
   // We start with a different context. Return documents found in the previous
   // context again.
   _alreadyReturned.clear();
+
+  if (_useBatchLookup) {
+    if (_pos == 0) {
+      // first row of a new input block: look up all rows of it at once
+      Functions::InitializeThreadContext();
+      try {
+        executeBatchLookup();
+        Functions::DestroyThreadContext();
+      } catch (...) {
+        Functions::DestroyThreadContext();
+        throw;
+      }
+    }
+
+    TRI_ASSERT(_pos < _batchRows.size());
+    _posInBatchResult = 0;
+    return true;
+  }
+
   // Find out about the actual values for the bounds in the variable bound case:
 
   if (!_nonConstExpressions.empty()) {
@@ -387,6 +515,22 @@ bool IndexBlock::readIndex(size_t atMost) {
   } else {
     _documents.clear();
   }
+  _projectionSubs.clear();
+
+  if (_useBatchLookup) {
+    // the documents for the current row were already looked up
+    auto const& found = _batchResults[_batchRows[_pos]];
+    size_t nrSent = 0;
+
+    while (nrSent < atMost && _posInBatchResult < found.size()) {
+      _documents.emplace_back(*found[_posInBatchResult++]);
+      ++nrSent;
+      ++_engine->_stats.scannedIndex;
+    }
+
+    _posInDocs = 0;
+    return (!_documents.empty());
+  }
 
   if (_iterator == nullptr) {
     // All indexes exhausted
@@ -400,7 +544,20 @@ bool IndexBlock::readIndex(size_t atMost) {
   try {
     size_t nrSent = 0;
     while (nrSent < atMost && _iterator != nullptr) {
-      TRI_doc_mptr_t* indexElement = _iterator->next();
+      TRI_doc_mptr_t* indexElement = nullptr;
+      TRI_index_element_t* element = nullptr;
+
+      if (_projectionPositions.empty()) {
+        indexElement = _iterator->next();
+      } else {
+        TRI_ASSERT(_iterator->hasElements());
+        element = _iterator->nextElement();
+
+        if (element != nullptr) {
+          indexElement = element->document();
+        }
+      }
+
       if (indexElement == nullptr) {
         startNextIterator();
       } else {
@@ -412,6 +569,13 @@ bool IndexBlock::readIndex(size_t atMost) {
             _alreadyReturned.emplace(indexElement);
           }
 
+          if (element != nullptr) {
+            auto subs = element->subObjects();
+            for (auto const& position : _projectionPositions[_currentIndex]) {
+              _projectionSubs.emplace_back(subs[position]);
+            }
+          }
+
           _documents.emplace_back(*indexElement);
           ++nrSent;
         }
@@ -438,6 +602,9 @@ int IndexBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
   }
   _pos = 0;
   _posInDocs = 0;
+  _batchResults.clear();
+  _batchRows.clear();
+  _posInBatchResult = 0;
 
   return TRI_ERROR_NO_ERROR;
   LEAVE_BLOCK;
@@ -507,7 +674,7 @@ AqlItemBlock* IndexBlock::getSome(size_t atLeast, size_t atMost) {
     size_t toSend = (std::min)(atMost, available);
 
     if (toSend > 0) {
-      res.reset(new AqlItemBlock(
+      res.reset(requestBlock(
           toSend,
           getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
@@ -536,10 +703,19 @@ AqlItemBlock* IndexBlock::getSome(size_t atLeast, size_t atMost) {
         // we do not need to do a lookup in
         // getPlanNode()->_registerPlan->varInfo,
         // but can just take cur->getNrRegs() as registerId:
-        res->setValue(j, static_cast<arangodb::aql::RegisterId>(curRegs),
-                      AqlValue(reinterpret_cast<TRI_df_marker_t const*>(
-                          _documents[_posInDocs++].getDataPtr())));
-        // No harm done, if the setValue throws!
+        if (_projectionPositions.empty()) {
+          res->setValue(j, static_cast<arangodb::aql::RegisterId>(curRegs),
+                        AqlValue(reinterpret_cast<TRI_df_marker_t const*>(
+                            _documents[_posInDocs].getDataPtr())));
+          // No harm done, if the setValue throws!
+        } else {
+          auto json = std::make_unique<Json>(TRI_UNKNOWN_MEM_ZONE,
+                                             buildProjection(_posInDocs));
+          res->setValue(j, static_cast<arangodb::aql::RegisterId>(curRegs),
+                        AqlValue(json.get()));
+          json.release();
+        }
+        ++_posInDocs;
       }
     }
 
@@ -622,3 +798,48 @@ void IndexBlock::cleanupNonConstExpressions() {
   }
   _nonConstExpressions.clear();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the projected attributes of a document from its index data.
+/// values of short types are stored in the index element itself, so they can
+/// be restored without accessing the document
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* IndexBlock::buildProjection(size_t position) const {
+  auto en = static_cast<IndexNode const*>(getPlanNode());
+  auto const& projections = en->projections();
+  size_t const n = projections.size();
+
+  auto shaper = _trx->documentCollection(_collection->cid())->getShaper();
+  auto const& document = _documents[position];
+
+  TRI_json_t* result = TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE, n);
+
+  if (result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    TRI_shaped_sub_t const* sub = &_projectionSubs[position * n + i];
+
+    TRI_shaped_json_t shaped;
+    shaped._sid = sub->_sid;
+    char const* ptr;
+    size_t length;
+    TRI_InspectShapedSub(sub, &document, ptr, length);
+    shaped._data.data = const_cast<char*>(ptr);
+    shaped._data.length = static_cast<uint32_t>(length);
+
+    TRI_json_t* value = TRI_JsonShapedJson(shaper, &shaped);
+
+    if (value == nullptr) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, result);
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, result, projections[i].c_str(),
+                          value);
+  }
+
+  return result;
+}
@@ -109,6 +109,13 @@ class IndexBlock : public ExecutionBlock {
 
   void executeExpressions();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief evaluate the lookup value for all rows of the current input
+  /// block and look up the distinct values in the index in one go
+  //////////////////////////////////////////////////////////////////////////////
+
+  void executeBatchLookup();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief continue fetching of documents
   //////////////////////////////////////////////////////////////////////////////
@@ -121,6 +128,12 @@ class IndexBlock : public ExecutionBlock {
 
   void cleanupNonConstExpressions();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief build the projected attributes of a document from its index data
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_json_t* buildProjection(size_t) const;
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief collection
@@ -204,6 +217,55 @@ class IndexBlock : public ExecutionBlock {
   //////////////////////////////////////////////////////////////////////////////
 
   bool _hasV8Expression;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the lookups for a whole input block are done at
+  /// once. this is the case for a single equality lookup with a dynamic value
+  /// in an index that supports batch lookups
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _useBatchLookup;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the indexed attribute access of the batched lookup
+  //////////////////////////////////////////////////////////////////////////////
+
+  AstNode const* _batchAttribute;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief documents found for each distinct lookup value of the current
+  /// input block
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::vector<TRI_doc_mptr_t*>> _batchResults;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief position in _batchResults for each row of the current input block
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<size_t> _batchRows;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief current position in the documents of the current row
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _posInBatchResult;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the positions of the projected attributes in the elements of
+  /// each index. empty if the block produces full documents
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::vector<size_t>> _projectionPositions;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the index data of the projected attributes, one entry per
+  /// projected attribute for each document in _documents. the data is
+  /// copied out of the index elements, which may go away while the
+  /// documents are buffered
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<TRI_shaped_sub_t> _projectionSubs;
 };
 
 }  // namespace arangodb::aql
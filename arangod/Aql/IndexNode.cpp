@@ -57,6 +57,14 @@ void IndexNode::toVelocyPackHelper(VPackBuilder& nodes, bool verbose) const {
   _condition->toVelocyPack(nodes, verbose);
   nodes.add("reverse", VPackValue(_reverse));
 
+  if (!_projections.empty()) {
+    nodes.add(VPackValue("projections"));
+    VPackArrayBuilder guard(&nodes);
+    for (auto const& it : _projections) {
+      nodes.add(VPackValue(it));
+    }
+  }
+
   // And close it:
   nodes.close();
 }
@@ -71,6 +79,7 @@ ExecutionNode* IndexNode::clone(ExecutionPlan* plan, bool withDependencies,
 
   auto c = new IndexNode(plan, _id, _vocbase, _collection, outVariable,
                          _indexes, _condition->clone(), _reverse);
+  c->projections(_projections);
 
   cloneHelper(c, plan, withDependencies, withProperties);
 
@@ -89,7 +98,8 @@ IndexNode::IndexNode(ExecutionPlan* plan, arangodb::basics::Json const& json)
       _outVariable(varFromJson(plan->getAst(), json, "outVariable")),
       _indexes(),
       _condition(nullptr),
-      _reverse(JsonHelper::checkAndGetBooleanValue(json.json(), "reverse")) {
+      _reverse(JsonHelper::checkAndGetBooleanValue(json.json(), "reverse")),
+      _projections() {
   auto indexes = JsonHelper::checkAndGetArrayValue(json.json(), "indexes");
 
   TRI_ASSERT(TRI_IsArrayJson(indexes));
@@ -116,6 +126,23 @@ IndexNode::IndexNode(ExecutionPlan* plan, arangodb::basics::Json const& json)
   _condition = Condition::fromJson(plan, conditionJson);
 
   TRI_ASSERT(_condition != nullptr);
+
+  TRI_json_t const* projections =
+      TRI_LookupObjectJson(json.json(), "projections");
+
+  if (TRI_IsArrayJson(projections)) {
+    size_t const n = TRI_LengthArrayJson(projections);
+    _projections.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      TRI_json_t const* name = TRI_LookupArrayJson(projections, i);
+
+      if (TRI_IsStringJson(name)) {
+        _projections.emplace_back(name->_value._string.data,
+                                  name->_value._string.length - 1);
+      }
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -60,7 +60,8 @@ class IndexNode : public ExecutionNode {
         _outVariable(outVariable),
         _indexes(indexes),
         _condition(condition),
-        _reverse(reverse) {
+        _reverse(reverse),
+        _projections() {
     TRI_ASSERT(_vocbase != nullptr);
     TRI_ASSERT(_collection != nullptr);
     TRI_ASSERT(_outVariable != nullptr);
@@ -107,6 +108,21 @@ class IndexNode : public ExecutionNode {
 
   bool reverse() const { return _reverse; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the attributes the node produces from the index data.
+  /// if empty, the node produces the full documents
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::string> const& projections() const { return _projections; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the attributes the node produces from the index data
+  //////////////////////////////////////////////////////////////////////////////
+
+  void projections(std::vector<std::string> const& projections) {
+    _projections = projections;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief export to VelocyPack
   //////////////////////////////////////////////////////////////////////////////
@@ -190,6 +206,12 @@ class IndexNode : public ExecutionNode {
   //////////////////////////////////////////////////////////////////////////////
 
   bool _reverse;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the attributes produced from the index data
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::string> _projections;
 };
 
 }  // namespace arangodb::aql
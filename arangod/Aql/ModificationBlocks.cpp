@@ -277,7 +277,7 @@ AqlItemBlock* RemoveBlock::work(std::vector<AqlItemBlock*>& blocks) {
   bool const ignoreDocumentNotFound = ep->getOptions().ignoreDocumentNotFound;
   bool const producesOutput = (ep->_outVariableOld != nullptr);
 
-  result.reset(new AqlItemBlock(
+  result.reset(requestBlock(
       count,
       getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
@@ -396,7 +396,7 @@ AqlItemBlock* InsertBlock::work(std::vector<AqlItemBlock*>& blocks) {
   std::string from;
   std::string to;
 
-  result.reset(new AqlItemBlock(
+  result.reset(requestBlock(
       count,
       getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
@@ -530,7 +530,7 @@ AqlItemBlock* UpdateBlock::work(std::vector<AqlItemBlock*>& blocks) {
 
   auto trxCollection = _trx->trxCollection(_collection->cid());
 
-  result.reset(new AqlItemBlock(
+  result.reset(requestBlock(
       count,
       getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
@@ -724,7 +724,7 @@ AqlItemBlock* UpsertBlock::work(std::vector<AqlItemBlock*>& blocks) {
   auto trxCollection = _trx->trxCollection(_collection->cid());
   bool const isEdgeCollection = _collection->isEdgeCollection();
 
-  result.reset(new AqlItemBlock(
+  result.reset(requestBlock(
       count,
       getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
@@ -962,7 +962,7 @@ AqlItemBlock* ReplaceBlock::work(std::vector<AqlItemBlock*>& blocks) {
 
   auto trxCollection = _trx->trxCollection(_collection->cid());
 
-  result.reset(new AqlItemBlock(
+  result.reset(requestBlock(
       count,
       getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
 
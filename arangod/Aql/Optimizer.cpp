@@ -489,6 +489,11 @@ void Optimizer::setupRules() {
                removeDataModificationOutVariablesRule,
                removeDataModificationOutVariablesRule_pass5, true);
 
+  // access projected attributes directly instead of via the projection
+  registerRule("late-document-materialization",
+               lateDocumentMaterializationRule,
+               lateDocumentMaterializationRule_pass5, true);
+
   // propagate constant attributes in FILTERs
   registerRule("propagate-constant-attributes", propagateConstantAttributesRule,
                propagateConstantAttributesRule_pass5, true);
@@ -522,6 +527,13 @@ void Optimizer::setupRules() {
   registerRule("sort-in-values", sortInValuesRule, sortInValuesRule_pass6,
                true);
 
+  if (!arangodb::ServerState::instance()->isCoordinator()) {
+    // replace full collection scans in inner loops with hash joins (note:
+    // must come after use-indexes, so that indexes are still preferred)
+    registerRule("use-hash-join", useHashJoinRule, useHashJoinRule_pass6,
+                 true);
+  }
+
   // remove calculations that are never necessary
   registerRule("remove-unnecessary-calculations-2",
                removeUnnecessaryCalculationsRule,
@@ -543,6 +555,17 @@ void Optimizer::setupRules() {
   registerRule("patch-update-statements", patchUpdateStatementsRule,
                patchUpdateStatementsRule_pass9, true);
 
+  // make SORT keep only the rows needed by a following LIMIT
+  registerRule("sort-limit", sortLimitRule, sortLimitRule_pass9, true);
+
+  // read accessed attributes from the index instead of the documents
+  registerRule("use-index-projections", useIndexProjectionsRule,
+               useIndexProjectionsRule_pass9, true);
+
+  // scan collections with multiple threads on single servers
+  registerRule("parallel-collection-scan", parallelCollectionScanRule,
+               parallelCollectionScanRule_pass9, true);
+
   if (arangodb::ServerState::instance()->isCoordinator()) {
     // distribute operations in cluster
     registerRule("scatter-in-cluster", scatterInClusterRule,
@@ -559,6 +582,13 @@ void Optimizer::setupRules() {
     registerRule("distribute-sort-to-cluster", distributeSortToClusterRule,
                  distributeSortToClusterRule_pass10, true);
 
+    registerRule("distribute-collect-to-cluster",
+                 distributeCollectToClusterRule,
+                 distributeCollectToClusterRule_pass10, true);
+
+    registerRule("distribute-limit-to-cluster", distributeLimitToClusterRule,
+                 distributeLimitToClusterRule_pass10, true);
+
     registerRule("remove-unnecessary-remote-scatter",
                  removeUnnecessaryRemoteScatterRule,
                  removeUnnecessaryRemoteScatterRule_pass10, true);
@@ -168,6 +168,9 @@ class Optimizer {
     // remove INTO for COLLECT if appropriate
     removeCollectVariablesRule_pass5 = 740,
 
+    // access projected attributes directly instead of via the projection
+    lateDocumentMaterializationRule_pass5 = 745,
+
     // propagate constant attributes in FILTERs
     propagateConstantAttributesRule_pass5 = 750,
 
@@ -199,6 +202,9 @@ class Optimizer {
     // sort values used in IN comparisons of remaining filters
     sortInValuesRule_pass6 = 865,
 
+    // join inner loops that could not use an index with a hash table
+    useHashJoinRule_pass6 = 867,
+
     // remove calculations that are never necessary
     removeUnnecessaryCalculationsRule_pass6 = 870,
 
@@ -223,6 +229,24 @@ class Optimizer {
 
     patchUpdateStatementsRule_pass9 = 902,
 
+    //////////////////////////////////////////////////////////////////////////////
+    /// Pass 9: restrict SORT to the number of rows a following LIMIT needs
+    //////////////////////////////////////////////////////////////////////////////
+
+    sortLimitRule_pass9 = 903,
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// Pass 9: produce the accessed attributes directly from index data
+    //////////////////////////////////////////////////////////////////////////////
+
+    useIndexProjectionsRule_pass9 = 904,
+
+    //////////////////////////////////////////////////////////////////////////////
+    /// Pass 9: scan collections with multiple threads, filtering in parallel
+    //////////////////////////////////////////////////////////////////////////////
+
+    parallelCollectionScanRule_pass9 = 905,
+
     //////////////////////////////////////////////////////////////////////////////
     /// "Pass 10": final transformations for the cluster
     //////////////////////////////////////////////////////////////////////////////
@@ -242,6 +266,13 @@ class Optimizer {
     // adjust gathernode to also contain the sort criteria.
     distributeSortToClusterRule_pass10 = 1030,
 
+    // split COLLECTs behind a GatherNode into a partial COLLECT on the
+    // DB servers and a merging COLLECT on the coordinator
+    distributeCollectToClusterRule_pass10 = 1035,
+
+    // copy LIMITs behind a GatherNode into the DB server parts of the plan
+    distributeLimitToClusterRule_pass10 = 1037,
+
     // try to get rid of a RemoteNode->ScatterNode combination which has
     // only a SingletonNode and possibly some CalculationNodes as dependencies
     removeUnnecessaryRemoteScatterRule_pass10 = 1040,
@@ -30,6 +30,7 @@
 #include "Aql/ExecutionEngine.h"
 #include "Aql/ExecutionNode.h"
 #include "Aql/Function.h"
+#include "Aql/HashJoinNode.h"
 #include "Aql/Index.h"
 #include "Aql/IndexNode.h"
 #include "Aql/ModificationNodes.h"
@@ -45,6 +46,22 @@ using namespace arangodb::aql;
 using Json = arangodb::basics::Json;
 using EN = arangodb::aql::ExecutionNode;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the first dependency of a node that is not a calculation.
+/// calculations produce exactly one output row per input row, so a LIMIT
+/// restricts the rows of the node returned as much as its own input
+////////////////////////////////////////////////////////////////////////////////
+
+static ExecutionNode* SkipCalculations(ExecutionNode* node) {
+  auto current = node->getFirstDependency();
+
+  while (current != nullptr && current->getType() == EN::CALCULATION) {
+    current = current->getFirstDependency();
+  }
+
+  return current;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief adds a SORT operation for IN right-hand side operands
 ////////////////////////////////////////////////////////////////////////////////
@@ -324,7 +341,8 @@ void arangodb::aql::removeRedundantSortsRule(Optimizer* opt,
           }
         } else if (current->getType() == EN::ENUMERATE_LIST ||
                    current->getType() == EN::ENUMERATE_COLLECTION ||
-                   current->getType() == EN::TRAVERSAL) {
+                   current->getType() == EN::TRAVERSAL ||
+                   current->getType() == EN::SHORTEST_PATH) {
           // ok, but we cannot remove two different sorts if one of these node
           // types is between them
           // example: in the following query, the one sort will be optimized
@@ -717,6 +735,159 @@ void arangodb::aql::propagateConstantAttributesRule(
   opt->addPlan(plan, rule, helper.modified());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collects the names of the attributes of a variable that are
+/// accessed in an expression (e.g. `name` for `p.name`). returns false if
+/// the variable is used in any other way than accessing a top-level attribute
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CollectAttributeAccesses(AstNode const* node,
+                                     Variable const* variable,
+                                     std::unordered_set<std::string>& result) {
+  if (node == nullptr) {
+    return true;
+  }
+
+  if (node->type == NODE_TYPE_REFERENCE) {
+    // a use of the variable other than an attribute access
+    return (static_cast<Variable const*>(node->getData()) != variable);
+  }
+
+  if (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    auto sub = node->getMemberUnchecked(0);
+
+    if (sub->type == NODE_TYPE_REFERENCE &&
+        static_cast<Variable const*>(sub->getData()) == variable) {
+      result.emplace(node->getStringValue(), node->getStringLength());
+      return true;
+    }
+  }
+
+  size_t const n = node->numMembers();
+  for (size_t i = 0; i < n; ++i) {
+    if (!CollectAttributeAccesses(node->getMemberUnchecked(i), variable,
+                                  result)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace attribute accesses on object projections with the
+/// projected expressions, so the object is only built where it is needed
+/// as a whole. for example, in
+///   LET p = { name: doc.name, age: doc.age } FILTER p.age > 30
+///   SORT p.name LIMIT 10 RETURN p
+/// the FILTER and SORT will access doc.age and doc.name directly. the
+/// projection itself can then be moved below the LIMIT by
+/// move-calculations-down, or be removed if it is not used at all
+////////////////////////////////////////////////////////////////////////////////
+
+void arangodb::aql::lateDocumentMaterializationRule(
+    Optimizer* opt, ExecutionPlan* plan, Optimizer::Rule const* rule) {
+  std::vector<ExecutionNode*> nodes(
+      plan->findNodesOfType(EN::CALCULATION, true));
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    auto nn = static_cast<CalculationNode*>(n);
+    auto node = nn->expression()->node();
+
+    if (node->type != NODE_TYPE_OBJECT || node->numMembers() == 0) {
+      continue;
+    }
+
+    // collect the projected attributes. we only handle objects with static
+    // attribute names and values that are cheap to evaluate more than once
+    std::unordered_map<std::string, AstNode const*> attributes;
+    bool eligible = true;
+
+    size_t const numMembers = node->numMembers();
+    for (size_t i = 0; i < numMembers; ++i) {
+      auto member = node->getMemberUnchecked(i);
+
+      if (member->type != NODE_TYPE_OBJECT_ELEMENT) {
+        eligible = false;
+        break;
+      }
+
+      auto value = member->getMember(0);
+
+      if (!value->isConstant() && value->type != NODE_TYPE_REFERENCE &&
+          !value->isAttributeAccessForVariable()) {
+        eligible = false;
+        break;
+      }
+
+      if (!attributes.emplace(std::string(member->getStringValue(),
+                                          member->getStringLength()),
+                              value).second) {
+        // duplicate attribute name
+        eligible = false;
+        break;
+      }
+    }
+
+    if (!eligible) {
+      continue;
+    }
+
+    // this is the variable that the calculation will set
+    auto variable = nn->outVariable();
+
+    std::vector<ExecutionNode*> stack;
+    n->addParents(stack);
+
+    while (!stack.empty()) {
+      auto current = stack.back();
+      stack.pop_back();
+
+      auto const currentType = current->getType();
+
+      if (currentType == EN::CALCULATION) {
+        auto calc = static_cast<CalculationNode*>(current);
+        auto expression = calc->expression();
+
+        std::unordered_set<std::string> accessed;
+
+        if (CollectAttributeAccesses(expression->node(), variable,
+                                     accessed) &&
+            !accessed.empty() &&
+            std::all_of(accessed.begin(), accessed.end(),
+                        [&attributes](std::string const& name) {
+                          return attributes.find(name) != attributes.end();
+                        })) {
+          expression->replaceAttributeAccess(variable, attributes);
+          modified = true;
+        }
+      } else if (currentType != EN::FILTER && currentType != EN::SORT &&
+                 currentType != EN::LIMIT &&
+                 currentType != EN::ENUMERATE_COLLECTION &&
+                 currentType != EN::ENUMERATE_LIST &&
+                 currentType != EN::INDEX &&
+                 currentType != EN::HASH_JOIN &&
+                 currentType != EN::SUBQUERY &&
+                 currentType != EN::TRAVERSAL &&
+                 currentType != EN::SHORTEST_PATH) {
+        // the variables used in the projection may not be available anymore
+        // after a COLLECT, and we do not touch data-modification or
+        // cluster nodes
+        break;
+      }
+
+      if (!current->hasParent()) {
+        break;
+      }
+
+      current->addParents(stack);
+    }
+  }
+
+  opt->addPlan(plan, rule, modified);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief remove SORT RAND() if appropriate
 ////////////////////////////////////////////////////////////////////////////////
@@ -788,7 +959,9 @@ void arangodb::aql::removeSortRandRule(Optimizer* opt, ExecutionPlan* plan,
         case EN::SUBQUERY:
         case EN::ENUMERATE_LIST:
         case EN::TRAVERSAL:
-        case EN::INDEX: {
+        case EN::SHORTEST_PATH:
+        case EN::INDEX:
+        case EN::HASH_JOIN: {
           // if we found another SortNode, an CollectNode, FilterNode, a
           // SubqueryNode,
           // an EnumerateListNode, a TraversalNode or an IndexNode
@@ -973,9 +1146,11 @@ void arangodb::aql::moveCalculationsDownRule(Optimizer* opt,
         // we found something interesting that justifies moving our node down
         shouldMove = true;
       } else if (currentType == EN::INDEX ||
+                 currentType == EN::HASH_JOIN ||
                  currentType == EN::ENUMERATE_COLLECTION ||
                  currentType == EN::ENUMERATE_LIST ||
-                 currentType == EN::TRAVERSAL || currentType == EN::COLLECT ||
+                 currentType == EN::TRAVERSAL ||
+                 currentType == EN::SHORTEST_PATH || currentType == EN::COLLECT ||
                  currentType == EN::NORESULTS) {
         // we will not push further down than such nodes
         shouldMove = false;
@@ -1892,6 +2067,7 @@ struct SortToIndexNode final : public WalkerWorker<ExecutionNode> {
   bool before(ExecutionNode* en) override final {
     switch (en->getType()) {
       case EN::TRAVERSAL:
+      case EN::SHORTEST_PATH:
       case EN::ENUMERATE_LIST:
       case EN::SUBQUERY:
       case EN::FILTER:
@@ -1921,6 +2097,7 @@ struct SortToIndexNode final : public WalkerWorker<ExecutionNode> {
       case EN::GATHER:
       case EN::REMOTE:
       case EN::ILLEGAL:
+      case EN::HASH_JOIN:
       case EN::LIMIT:  // LIMIT is criterion to stop
         return true;   // abort.
 
@@ -2597,8 +2774,10 @@ void arangodb::aql::distributeFilternCalcToClusterRule(
         case EN::LIMIT:
         case EN::SORT:
         case EN::INDEX:
+        case EN::HASH_JOIN:
         case EN::ENUMERATE_COLLECTION:
         case EN::TRAVERSAL:
+        case EN::SHORTEST_PATH:
           // do break
           stopSearching = true;
           break;
@@ -2698,7 +2877,9 @@ void arangodb::aql::distributeSortToClusterRule(Optimizer* opt,
         case EN::REMOTE:
         case EN::LIMIT:
         case EN::INDEX:
+        case EN::HASH_JOIN:
         case EN::TRAVERSAL:
+        case EN::SHORTEST_PATH:
         case EN::ENUMERATE_COLLECTION:
           // For all these, we do not want to pull a SortNode further down
           // out to the DBservers, note that potential FilterNodes and
@@ -2730,6 +2911,207 @@ void arangodb::aql::distributeSortToClusterRule(Optimizer* opt,
   opt->addPlan(plan, rule, modified);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief split a COLLECT directly behind a GatherNode into a partial COLLECT
+/// that runs on the DB servers and a COLLECT on the coordinator that merges
+/// the partial aggregation states. this way each shard only sends one row per
+/// group to the coordinator
+////////////////////////////////////////////////////////////////////////////////
+
+void arangodb::aql::distributeCollectToClusterRule(
+    Optimizer* opt, ExecutionPlan* plan, Optimizer::Rule const* rule) {
+  bool modified = false;
+
+  std::vector<ExecutionNode*> nodes(plan->findNodesOfType(EN::GATHER, true));
+
+  for (auto& n : nodes) {
+    auto gatherNode = static_cast<GatherNode*>(n);
+
+    if (!gatherNode->hasParent()) {
+      continue;
+    }
+
+    auto parents = gatherNode->getParents();
+
+    if (parents.size() != 1 || parents[0]->getType() != EN::COLLECT) {
+      continue;
+    }
+
+    auto collectNode = static_cast<CollectNode*>(parents[0]);
+
+    if (collectNode->hasOutVariable() || collectNode->hasExpressionVariable() ||
+        collectNode->aggregationStep() !=
+            CollectNode::AGGREGATION_STEP_COMPLETE) {
+      // COLLECT ... INTO and WITH COUNT INTO need all input rows
+      continue;
+    }
+
+    auto const& groupVariables = collectNode->groupVariables();
+    auto const& aggregateVariables = collectNode->aggregateVariables();
+    auto ast = plan->getAst();
+
+    // the partial COLLECT produces new variables for the groups and the
+    // partial states, which are then used as input by the merging COLLECT
+    std::vector<std::pair<Variable const*, Variable const*>> partialGroups;
+    std::vector<std::pair<Variable const*, Variable const*>> mergeGroups;
+    std::unordered_map<Variable const*, Variable const*> replacements;
+
+    for (auto const& it : groupVariables) {
+      auto out = ast->variables()->createTemporaryVariable();
+      partialGroups.emplace_back(std::make_pair(out, it.second));
+      mergeGroups.emplace_back(std::make_pair(it.first, out));
+      replacements.emplace(it.second, out);
+    }
+
+    std::vector<
+        std::pair<Variable const*, std::pair<Variable const*, std::string>>>
+        partialAggregates;
+    std::vector<
+        std::pair<Variable const*, std::pair<Variable const*, std::string>>>
+        mergeAggregates;
+
+    for (auto const& it : aggregateVariables) {
+      auto out = ast->variables()->createTemporaryVariable();
+      partialAggregates.emplace_back(std::make_pair(out, it.second));
+      mergeAggregates.emplace_back(std::make_pair(
+          it.first,
+          std::make_pair(out, Aggregator::mergeType(it.second.second))));
+    }
+
+    SortElementVector elements;
+
+    if (collectNode->aggregationMethod() ==
+            CollectOptions::CollectMethod::COLLECT_METHOD_SORTED &&
+        !groupVariables.empty()) {
+      // the merging COLLECT needs the partial groups in sort order. they
+      // are sorted on each shard, so the GatherNode can merge them if it
+      // sorts by the group values
+      bool canMerge = !gatherNode->getElements().empty();
+
+      for (auto const& it : gatherNode->getElements()) {
+        auto it2 = replacements.find(it.first);
+
+        if (it2 == replacements.end()) {
+          canMerge = false;
+          break;
+        }
+        elements.emplace_back(std::make_pair((*it2).second, it.second));
+      }
+
+      if (!canMerge) {
+        continue;
+      }
+    }
+
+    auto partialCollectNode = new CollectNode(
+        plan, plan->nextId(), collectNode->getOptions(), partialGroups,
+        partialAggregates, nullptr, nullptr, std::vector<Variable const*>(),
+        collectNode->variableMap(), false, collectNode->isDistinctCommand());
+
+    plan->registerNode(partialCollectNode);
+    partialCollectNode->specialized();
+    partialCollectNode->aggregationStep(CollectNode::AGGREGATION_STEP_PARTIAL);
+
+    // run the partial COLLECT on the DB servers
+    auto const& remoteNodeList = gatherNode->getDependencies();
+    TRI_ASSERT(remoteNodeList.size() > 0);
+    plan->insertDependency(remoteNodeList[0], partialCollectNode);
+
+    // the GatherNode must not refer to the variables the partial COLLECT
+    // consumes
+    gatherNode->setElements(elements);
+
+    collectNode->groupVariables(mergeGroups);
+    collectNode->aggregateVariables(mergeAggregates);
+    collectNode->aggregationStep(CollectNode::AGGREGATION_STEP_MERGE);
+
+    modified = true;
+  }
+
+  opt->addPlan(plan, rule, modified);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief push a LIMIT that follows a GatherNode into the DB server parts of
+/// the plan. each shard then produces at most offset + limit rows, and the
+/// GatherNode stops fetching rows once it has produced that many
+////////////////////////////////////////////////////////////////////////////////
+
+void arangodb::aql::distributeLimitToClusterRule(Optimizer* opt,
+                                                 ExecutionPlan* plan,
+                                                 Optimizer::Rule const* rule) {
+  bool modified = false;
+
+  std::vector<ExecutionNode*> nodes(plan->findNodesOfType(EN::LIMIT, true));
+
+  for (auto& n : nodes) {
+    auto limitNode = static_cast<LimitNode*>(n);
+
+    if (limitNode->fullCount()) {
+      // with fullCount, all rows need to be counted
+      continue;
+    }
+
+    auto current = SkipCalculations(limitNode);
+
+    if (current == nullptr || current->getType() != EN::GATHER) {
+      continue;
+    }
+
+    auto gatherNode = static_cast<GatherNode*>(current);
+
+    size_t const limit = limitNode->offset() + limitNode->limit();
+
+    if (limit == 0) {
+      continue;
+    }
+
+    auto const& remoteNodeList = gatherNode->getDependencies();
+    TRI_ASSERT(remoteNodeList.size() > 0);
+    auto rn = remoteNodeList[0];
+
+    // do not limit the number of documents a data-modification operation on
+    // the DB servers processes
+    bool isModification = false;
+    for (auto dep = rn->getFirstDependency(); dep != nullptr;
+         dep = dep->getFirstDependency()) {
+      auto type = dep->getType();
+
+      if (type == EN::REMOTE || type == EN::SCATTER ||
+          type == EN::DISTRIBUTE) {
+        break;
+      }
+      if (type == EN::INSERT || type == EN::UPDATE || type == EN::REPLACE ||
+          type == EN::REMOVE || type == EN::UPSERT) {
+        isModification = true;
+        break;
+      }
+    }
+
+    if (isModification) {
+      continue;
+    }
+
+    auto dep = rn->getFirstDependency();
+    if (dep != nullptr && dep->getType() == EN::LIMIT &&
+        static_cast<LimitNode const*>(dep)->offset() == 0 &&
+        static_cast<LimitNode const*>(dep)->limit() <= limit) {
+      // already limited
+      continue;
+    }
+
+    auto shardLimitNode = new LimitNode(plan, plan->nextId(), 0, limit);
+    plan->registerNode(shardLimitNode);
+    plan->insertDependency(rn, shardLimitNode);
+
+    gatherNode->setLimit(limit);
+
+    modified = true;
+  }
+
+  opt->addPlan(plan, rule, modified);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief try to get rid of a RemoteNode->ScatterNode combination which has
 /// only a SingletonNode and possibly some CalculationNodes as dependencies
@@ -2965,7 +3347,9 @@ class RemoveToEnumCollFinder final : public WalkerWorker<ExecutionNode> {
       case EN::LIMIT:
       case EN::SORT:
       case EN::TRAVERSAL:
-      case EN::INDEX: {
+      case EN::SHORTEST_PATH:
+      case EN::INDEX:
+      case EN::HASH_JOIN: {
         // if we meet any of the above, then we abort . . .
       }
     }
@@ -3567,7 +3951,7 @@ void arangodb::aql::patchUpdateStatementsRule(Optimizer* opt,
       auto const type = dep->getType();
 
       if (type == EN::ENUMERATE_LIST || type == EN::INDEX ||
-          type == EN::SUBQUERY) {
+          type == EN::HASH_JOIN || type == EN::SUBQUERY) {
         // not suitable
         modified = false;
         break;
@@ -3585,7 +3969,7 @@ void arangodb::aql::patchUpdateStatementsRule(Optimizer* opt,
         }
       }
 
-      if (type == EN::TRAVERSAL) {
+      if (type == EN::TRAVERSAL || type == EN::SHORTEST_PATH) {
         // unclear what will be read by the traversal
         modified = false;
         break;
@@ -3604,6 +3988,320 @@ void arangodb::aql::patchUpdateStatementsRule(Optimizer* opt,
   opt->addPlan(plan, rule, modified);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restrict a SORT that is followed by a LIMIT to the offset + count
+/// rows the LIMIT will let pass, so the sort can use a bounded heap instead
+/// of sorting its complete input
+////////////////////////////////////////////////////////////////////////////////
+
+void arangodb::aql::sortLimitRule(Optimizer* opt, ExecutionPlan* plan,
+                                  Optimizer::Rule const* rule) {
+  bool modified = false;
+
+  std::vector<ExecutionNode*> nodes(plan->findNodesOfType(EN::LIMIT, true));
+
+  for (auto const& n : nodes) {
+    auto limitNode = static_cast<LimitNode const*>(n);
+
+    if (limitNode->fullCount() || limitNode->limit() == 0) {
+      // fullCount needs to see all sorted rows, and LIMIT 0 will not
+      // request any rows from the sort anyway
+      continue;
+    }
+
+    auto current = SkipCalculations(n);
+
+    if (current == nullptr || current->getType() != EN::SORT) {
+      continue;
+    }
+
+    auto sortNode = static_cast<SortNode*>(current);
+    size_t const limit = limitNode->offset() + limitNode->limit();
+
+    if (sortNode->limit() == 0 || limit < sortNode->limit()) {
+      sortNode->setLimit(limit);
+      modified = true;
+    }
+  }
+
+  opt->addPlan(plan, rule, modified);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief make index nodes produce the accessed attributes directly from the
+/// index data if all of them are indexed or stored in the index
+////////////////////////////////////////////////////////////////////////////////
+
+void arangodb::aql::useIndexProjectionsRule(Optimizer* opt,
+                                            ExecutionPlan* plan,
+                                            Optimizer::Rule const* rule) {
+  bool modified = false;
+
+  std::vector<ExecutionNode*> nodes(plan->findNodesOfType(EN::INDEX, true));
+
+  for (auto const& n : nodes) {
+    auto indexNode = static_cast<IndexNode*>(n);
+
+    if (!indexNode->projections().empty()) {
+      continue;
+    }
+
+    auto variable = indexNode->outVariable();
+    std::unordered_set<std::string> attributes;
+    bool eligible = true;
+
+    auto current = n->getFirstParent();
+
+    while (current != nullptr && eligible) {
+      if (current->getType() == EN::CALCULATION) {
+        auto expression = static_cast<CalculationNode*>(current)->expression();
+        eligible = CollectAttributeAccesses(expression->node(), variable,
+                                            attributes);
+      } else {
+        std::unordered_set<Variable const*> used;
+        current->getVariablesUsedHere(used);
+        // any other use of the variable needs the full document
+        eligible = (used.find(variable) == used.end());
+      }
+
+      current = current->getFirstParent();
+    }
+
+    if (!eligible || attributes.empty()) {
+      continue;
+    }
+
+    for (auto const& index : indexNode->getIndexes()) {
+      for (auto const& attribute : attributes) {
+        if (index->storedPosition(attribute) < 0) {
+          eligible = false;
+          break;
+        }
+      }
+
+      if (!eligible) {
+        break;
+      }
+    }
+
+    if (!eligible) {
+      continue;
+    }
+
+    std::vector<std::string> projections(attributes.begin(), attributes.end());
+    std::sort(projections.begin(), projections.end());
+
+    indexNode->projections(projections);
+    modified = true;
+  }
+
+  opt->addPlan(plan, rule, modified);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the variable and the attribute path of an attribute access
+/// such as doc.a.b
+////////////////////////////////////////////////////////////////////////////////
+
+static bool GetAttributePath(AstNode const* node, Variable const*& variable,
+                             std::vector<std::string>& attribute) {
+  attribute.clear();
+
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    attribute.insert(attribute.begin(), std::string(node->getStringValue(),
+                                                    node->getStringLength()));
+    node = node->getMember(0);
+  }
+
+  if (node->type != NODE_TYPE_REFERENCE || attribute.empty()) {
+    return false;
+  }
+
+  variable = static_cast<Variable const*>(node->getData());
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace full collection scans in inner loops that are filtered by
+/// an equality with an attribute of an outer loop variable with a hash join
+///
+/// FOR a IN A FOR b IN B FILTER a.x == b.y ... then reads B once into a hash
+/// table on b.y and looks up a.x in it for each a. if B is larger than A and
+/// both loops are adjacent, the loops are swapped so that the hash table is
+/// built on the smaller collection. the FILTER is kept. the hash table is
+/// built only once, so no hash join is built on a collection the query
+/// modifies
+////////////////////////////////////////////////////////////////////////////////
+
+void arangodb::aql::useHashJoinRule(Optimizer* opt, ExecutionPlan* plan,
+                                    Optimizer::Rule const* rule) {
+  std::vector<ExecutionNode*> nodes(
+      plan->findNodesOfType(EN::ENUMERATE_COLLECTION, true));
+
+  std::unordered_set<Collection const*> modifiedCollections;
+
+  {
+    std::vector<ExecutionNode::NodeType> const types = {
+        EN::REMOVE, EN::INSERT, EN::UPDATE, EN::REPLACE, EN::UPSERT};
+
+    for (auto const& n : plan->findNodesOfType(types, true)) {
+      modifiedCollections.emplace(
+          static_cast<ModificationNode const*>(n)->collection());
+    }
+  }
+
+  std::unordered_set<ExecutionNode const*> replaced;
+  bool modified = false;
+
+  for (auto const& n : nodes) {
+    if (replaced.find(n) != replaced.end()) {
+      continue;
+    }
+
+    auto node = static_cast<EnumerateCollectionNode*>(n);
+
+    if (node->isRandom() || !node->isInInnerLoop()) {
+      // a single scan of the collection cannot be improved by hashing
+      continue;
+    }
+
+    // collect the filter conditions directly following the node
+    std::unordered_map<VariableId, AstNode const*> variableDefinitions;
+    std::unordered_set<VariableId> filters;
+
+    auto current = n->getFirstParent();
+
+    while (current != nullptr) {
+      auto const type = current->getType();
+
+      if (type == EN::CALCULATION) {
+        auto outvars = current->getVariablesSetHere();
+        TRI_ASSERT(outvars.size() == 1);
+        variableDefinitions.emplace(
+            outvars[0]->id,
+            static_cast<CalculationNode const*>(current)->expression()->node());
+      } else if (type == EN::FILTER) {
+        auto invars = current->getVariablesUsedHere();
+        TRI_ASSERT(invars.size() == 1);
+        filters.emplace(invars[0]->id);
+      } else {
+        break;
+      }
+
+      current = current->getFirstParent();
+    }
+
+    Condition condition(plan->getAst());
+    bool foundCondition = false;
+
+    for (auto const& it : variableDefinitions) {
+      if (filters.find(it.first) != filters.end()) {
+        condition.andCombine(it.second);
+        foundCondition = true;
+      }
+    }
+
+    if (!foundCondition) {
+      continue;
+    }
+
+    condition.normalize(plan);
+    auto root = condition.root();
+
+    if (root == nullptr || root->numMembers() != 1) {
+      // no condition or a disjunction
+      continue;
+    }
+
+    auto const& varsValid = n->getVarsValid();
+    Variable const* outVariable = node->outVariable();
+    Variable const* probeVariable = nullptr;
+    std::vector<std::string> buildAttribute;
+    std::vector<std::string> probeAttribute;
+
+    auto andNode = root->getMember(0);
+    size_t const numMembers = andNode->numMembers();
+
+    for (size_t i = 0; i < numMembers; ++i) {
+      auto op = andNode->getMember(i);
+
+      if (op->type != NODE_TYPE_OPERATOR_BINARY_EQ) {
+        continue;
+      }
+
+      for (size_t j = 0; j < 2; ++j) {
+        Variable const* buildVariable = nullptr;
+        probeVariable = nullptr;
+
+        if (GetAttributePath(op->getMember(j), buildVariable, buildAttribute) &&
+            buildVariable == outVariable &&
+            GetAttributePath(op->getMember(1 - j), probeVariable,
+                             probeAttribute) &&
+            probeVariable != outVariable &&
+            varsValid.find(probeVariable) != varsValid.end()) {
+          break;
+        }
+        probeVariable = nullptr;
+      }
+
+      if (probeVariable != nullptr) {
+        break;
+      }
+    }
+
+    if (probeVariable == nullptr) {
+      continue;
+    }
+
+    auto dep = n->getFirstDependency();
+
+    if (dep != nullptr && dep->getType() == EN::ENUMERATE_COLLECTION) {
+      auto outer = static_cast<EnumerateCollectionNode*>(dep);
+
+      if (outer->outVariable() == probeVariable && !outer->isRandom() &&
+          modifiedCollections.find(outer->collection()) ==
+              modifiedCollections.end() &&
+          outer->collection()->count() < node->collection()->count()) {
+        // build the hash table on the outer collection, which is smaller,
+        // and enumerate the inner collection in the outer loop instead
+        auto enumerateNode = new EnumerateCollectionNode(
+            plan, plan->nextId(), node->vocbase(),
+            const_cast<Collection*>(node->collection()), outVariable, false);
+        plan->registerNode(enumerateNode);
+        plan->replaceNode(outer, enumerateNode);
+
+        auto hashJoinNode = new HashJoinNode(
+            plan, plan->nextId(), outer->vocbase(), outer->collection(),
+            probeVariable, probeAttribute, outVariable, buildAttribute);
+        plan->registerNode(hashJoinNode);
+        plan->replaceNode(n, hashJoinNode);
+
+        replaced.emplace(outer);
+        replaced.emplace(n);
+        modified = true;
+        continue;
+      }
+    }
+
+    if (modifiedCollections.find(node->collection()) !=
+        modifiedCollections.end()) {
+      // the hash table would not see the modifications
+      continue;
+    }
+
+    auto hashJoinNode = new HashJoinNode(
+        plan, plan->nextId(), node->vocbase(), node->collection(), outVariable,
+        buildAttribute, probeVariable, probeAttribute);
+    plan->registerNode(hashJoinNode);
+    plan->replaceNode(n, hashJoinNode);
+
+    replaced.emplace(n);
+    modified = true;
+  }
+
+  opt->addPlan(plan, rule, modified);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief merges filter nodes into graph traversal nodes
 ////////////////////////////////////////////////////////////////////////////////
@@ -3755,3 +4453,96 @@ void arangodb::aql::inlineSubqueriesRule(Optimizer* opt,
   opt->addPlan(plan, rule, modified);
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief make outermost full collection scans use multiple threads. the
+/// scan is split into ranges of the primary index, which are read by up to
+/// maxParallelism threads. the rule applies to scans followed by filters
+/// that only access the current document and can be evaluated in batches.
+/// these are moved into the scan and are evaluated by the scanning threads:
+///
+/// FOR doc IN coll LET a = doc.value > 5 FILTER a ...
+///
+/// the documents are then produced in no particular order. the rule is only
+/// applied on single servers
+////////////////////////////////////////////////////////////////////////////////
+
+void arangodb::aql::parallelCollectionScanRule(Optimizer* opt,
+                                               ExecutionPlan* plan,
+                                               Optimizer::Rule const* rule) {
+  bool modified = false;
+
+  if (arangodb::ServerState::instance()->isRunningInCluster() ||
+      plan->getAst()->query()->maxParallelism() <= 1) {
+    opt->addPlan(plan, rule, modified);
+    return;
+  }
+
+  std::vector<ExecutionNode*> nodes(
+      plan->findNodesOfType(EN::ENUMERATE_COLLECTION, true));
+
+  for (auto const& n : nodes) {
+    auto collectionNode = static_cast<EnumerateCollectionNode*>(n);
+
+    if (collectionNode->isRandom() || collectionNode->filter() != nullptr) {
+      continue;
+    }
+
+    auto dependency = n->getFirstDependency();
+
+    if (dependency == nullptr || dependency->getType() != EN::SINGLETON) {
+      // the scan would be restarted for each input row. starting the
+      // threads again and again is not worth it
+      continue;
+    }
+
+    auto variable = collectionNode->outVariable();
+    AstNode* condition = nullptr;
+
+    while (true) {
+      auto current = n->getFirstParent();
+
+      if (current == nullptr || current->getType() != EN::CALCULATION) {
+        break;
+      }
+
+      auto calculationNode = static_cast<CalculationNode*>(current);
+      auto filterNode = current->getFirstParent();
+
+      if (filterNode == nullptr || filterNode->getType() != EN::FILTER ||
+          filterNode->getVariablesUsedHere()[0] !=
+              calculationNode->outVariable() ||
+          filterNode->isVarUsedLater(calculationNode->outVariable())) {
+        break;
+      }
+
+      auto used = calculationNode->getVariablesUsedHere();
+
+      if (used.size() != 1 || used[0] != variable ||
+          !calculationNode->expression()->isBatchable()) {
+        // the filter must only access the current document
+        break;
+      }
+
+      AstNode* node =
+          const_cast<AstNode*>(calculationNode->expression()->node());
+
+      if (condition == nullptr) {
+        condition = node;
+      } else {
+        condition = plan->getAst()->createNodeBinaryOperator(
+            NODE_TYPE_OPERATOR_BINARY_AND, condition, node);
+      }
+
+      plan->unlinkNode(filterNode);
+      plan->unlinkNode(calculationNode);
+    }
+
+    if (condition != nullptr) {
+      collectionNode->setFilter(new Expression(plan->getAst(), condition));
+      modified = true;
+    }
+  }
+
+  opt->addPlan(plan, rule, modified);
+}
@@ -70,6 +70,14 @@ void removeCollectVariablesRule(Optimizer*, ExecutionPlan*,
 void propagateConstantAttributesRule(Optimizer*, ExecutionPlan*,
                                      Optimizer::Rule const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace attribute accesses on object projections with the
+/// projected expressions
+////////////////////////////////////////////////////////////////////////////////
+
+void lateDocumentMaterializationRule(Optimizer*, ExecutionPlan*,
+                                     Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief remove SORT RAND() if appropriate
 ////////////////////////////////////////////////////////////////////////////////
@@ -192,6 +200,12 @@ void distributeFilternCalcToClusterRule(Optimizer*, ExecutionPlan*,
 void distributeSortToClusterRule(Optimizer*, ExecutionPlan*,
                                  Optimizer::Rule const*);
 
+void distributeCollectToClusterRule(Optimizer*, ExecutionPlan*,
+                                    Optimizer::Rule const*);
+
+void distributeLimitToClusterRule(Optimizer*, ExecutionPlan*,
+                                  Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief try to get rid of a RemoteNode->ScatterNode combination which has
 /// only a SingletonNode and possibly some CalculationNodes as dependencies
@@ -260,6 +274,38 @@ void removeDataModificationOutVariablesRule(Optimizer*, ExecutionPlan*,
 void patchUpdateStatementsRule(Optimizer*, ExecutionPlan*,
                                Optimizer::Rule const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief restrict a SORT that is followed by a LIMIT to the offset + count
+/// rows the LIMIT will let pass, so the sort can use a bounded heap instead
+/// of sorting its complete input
+////////////////////////////////////////////////////////////////////////////////
+
+void sortLimitRule(Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief make index nodes produce the accessed attributes directly from the
+/// index data, so the documents need not be read
+////////////////////////////////////////////////////////////////////////////////
+
+void useIndexProjectionsRule(Optimizer*, ExecutionPlan*,
+                             Optimizer::Rule const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief make outermost full collection scans that are followed by simple
+/// filters on the documents use multiple threads, moving the filters into
+/// the scan
+////////////////////////////////////////////////////////////////////////////////
+
+void parallelCollectionScanRule(Optimizer*, ExecutionPlan*,
+                                Optimizer::Rule const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief replace full collection scans in inner loops that are joined by
+/// an equality condition with a hash join
+////////////////////////////////////////////////////////////////////////////////
+
+void useHashJoinRule(Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief merges filter nodes into graph traversal nodes
 ////////////////////////////////////////////////////////////////////////////////
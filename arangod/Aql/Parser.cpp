@@ -69,6 +69,16 @@ bool Parser::configureWriteQuery(AstNode const* collectionNode,
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief validate the options of a traversal
+////////////////////////////////////////////////////////////////////////////////
+
+void Parser::configureTraversal(AstNode const* optionNode) {
+  if (optionNode != nullptr && !optionNode->isConstant()) {
+    _query->registerError(TRI_ERROR_QUERY_COMPILE_TIME_OPTIONS);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief parse the query
 ////////////////////////////////////////////////////////////////////////////////
@@ -162,6 +162,12 @@ class Parser {
 
   bool configureWriteQuery(AstNode const*, AstNode* optionNode);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief validate the options of a traversal
+  //////////////////////////////////////////////////////////////////////////////
+
+  void configureTraversal(AstNode const* optionNode);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief whether or not the query is a data-modification query
   //////////////////////////////////////////////////////////////////////////////
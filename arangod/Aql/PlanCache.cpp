@@ -0,0 +1,404 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/PlanCache.h"
+#include "Basics/Exceptions.h"
+#include "Basics/json.h"
+#include "Basics/json-utilities.h"
+#include "Basics/ReadLocker.h"
+#include "Basics/WriteLocker.h"
+#include "VocBase/vocbase.h"
+
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
+using namespace arangodb::aql;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief singleton instance of the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+static arangodb::aql::PlanCache Instance;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief copy an optional JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_json_t* CopyOptionalJson(TRI_json_t const* json) {
+  if (json == nullptr) {
+    return nullptr;
+  }
+
+  TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return copy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a cache entry
+////////////////////////////////////////////////////////////////////////////////
+
+PlanCacheEntry::PlanCacheEntry(char const* queryString,
+                               size_t queryStringLength,
+                               TRI_json_t const* bindParameters,
+                               TRI_json_t const* options, TRI_json_t* plan,
+                               std::vector<std::string> const& collections,
+                               bool isModificationQuery, bool isCacheable)
+    : _queryString(queryString, queryStringLength),
+      _bindParameters(nullptr),
+      _options(nullptr),
+      _plan(nullptr),
+      _collections(collections),
+      _isModificationQuery(isModificationQuery),
+      _isCacheable(isCacheable) {
+  TRI_ASSERT(plan != nullptr);
+
+  try {
+    _bindParameters = CopyOptionalJson(bindParameters);
+    _options = CopyOptionalJson(options);
+  } catch (...) {
+    if (_bindParameters != nullptr) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _bindParameters);
+    }
+    throw;
+  }
+
+  // only take over the plan when nothing can throw anymore
+  _plan = plan;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a cache entry
+////////////////////////////////////////////////////////////////////////////////
+
+PlanCacheEntry::~PlanCacheEntry() {
+  if (_bindParameters != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _bindParameters);
+  }
+  if (_options != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _options);
+  }
+  if (_plan != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _plan);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the entry was created for the query string, bind
+/// parameters and options
+////////////////////////////////////////////////////////////////////////////////
+
+bool PlanCacheEntry::matches(char const* queryString, size_t queryStringLength,
+                             TRI_json_t const* bindParameters,
+                             TRI_json_t const* options) const {
+  if (_queryString.size() != queryStringLength ||
+      memcmp(_queryString.c_str(), queryString, queryStringLength) != 0) {
+    return false;
+  }
+
+  return (TRI_CheckSameValueJson(_bindParameters, bindParameters) &&
+          TRI_CheckSameValueJson(_options, options));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove a plan
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::DatabaseEntry::remove(uint64_t hash) {
+  auto it = entriesByHash.find(hash);
+
+  if (it == entriesByHash.end()) {
+    return;
+  }
+
+  for (auto const& collection : (*it).second.first->_collections) {
+    auto it2 = entriesByCollection.find(collection);
+
+    if (it2 != entriesByCollection.end()) {
+      (*it2).second.erase(hash);
+
+      if ((*it2).second.empty()) {
+        entriesByCollection.erase(it2);
+      }
+    }
+  }
+
+  order.erase((*it).second.second);
+  entriesByHash.erase(it);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans for a collection
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::DatabaseEntry::invalidate(std::string const& collection) {
+  auto it = entriesByCollection.find(collection);
+
+  if (it == entriesByCollection.end()) {
+    return;
+  }
+
+  // copy the hashes, as remove() modifies the set
+  std::vector<uint64_t> hashes((*it).second.begin(), (*it).second.end());
+
+  for (auto const& hash : hashes) {
+    remove(hash);
+    ++invalidations;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove the oldest plans until there are at most n plans
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::DatabaseEntry::enforceMaxEntries(size_t n) {
+  while (entriesByHash.size() > n) {
+    TRI_ASSERT(!order.empty());
+    remove(order.front());
+  }
+}
+
+PlanCache::PlanCache() : _lock(), _entries(), _maxEntries(128), _version(0) {}
+
+PlanCache::~PlanCache() {}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the pointer to the global plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+PlanCache* PlanCache::instance() { return &Instance; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum number of plans per database
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::maxEntries(size_t value) {
+  WRITE_LOCKER(writeLocker, _lock);
+
+  _maxEntries = value;
+
+  for (auto& it : _entries) {
+    it.second->enforceMaxEntries(value);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the properties and statistics of the cache for a database
+////////////////////////////////////////////////////////////////////////////////
+
+VPackBuilder PlanCache::properties(TRI_vocbase_t* vocbase) {
+  VPackBuilder builder;
+  builder.openObject();
+  builder.add("maxEntries", VPackValue(_maxEntries.load()));
+
+  {
+    READ_LOCKER(readLocker, _lock);
+
+    auto it = _entries.find(vocbase);
+
+    if (it == _entries.end()) {
+      builder.add("entries", VPackValue(0));
+      builder.add("hits", VPackValue(0));
+      builder.add("misses", VPackValue(0));
+      builder.add("invalidations", VPackValue(0));
+    } else {
+      DatabaseEntry const* db = (*it).second.get();
+      builder.add("entries", VPackValue(db->entriesByHash.size()));
+      builder.add("hits", VPackValue(db->hits.load()));
+      builder.add("misses", VPackValue(db->misses.load()));
+      builder.add("invalidations", VPackValue(db->invalidations.load()));
+    }
+  }
+
+  builder.close();
+  return builder;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a plan. counts a hit or a miss for the database
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<PlanCacheEntry const> PlanCache::lookup(
+    TRI_vocbase_t* vocbase, uint64_t hash, char const* queryString,
+    size_t queryStringLength, TRI_json_t const* bindParameters,
+    TRI_json_t const* options) {
+  {
+    READ_LOCKER(readLocker, _lock);
+
+    auto it = _entries.find(vocbase);
+
+    if (it != _entries.end()) {
+      DatabaseEntry* db = (*it).second.get();
+      auto it2 = db->entriesByHash.find(hash);
+
+      if (it2 != db->entriesByHash.end() &&
+          (*it2).second.first->matches(queryString, queryStringLength,
+                                       bindParameters, options)) {
+        ++db->hits;
+        return (*it2).second.first;
+      }
+
+      ++db->misses;
+      return nullptr;
+    }
+  }
+
+  // first lookup for this database. create its entry for the statistics
+  WRITE_LOCKER(writeLocker, _lock);
+
+  auto it = _entries.find(vocbase);
+
+  if (it == _entries.end()) {
+    it = _entries.emplace(vocbase, std::make_unique<DatabaseEntry>()).first;
+  }
+
+  ++(*it).second->misses;
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store a plan, replacing an existing plan with the same hash.
+/// the plan is not stored if there was an invalidation since the given
+/// version was fetched, as the plan may use a dropped index then
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::store(TRI_vocbase_t* vocbase, uint64_t hash,
+                      std::shared_ptr<PlanCacheEntry const> entry,
+                      uint64_t version) {
+  TRI_ASSERT(entry != nullptr);
+
+  WRITE_LOCKER(writeLocker, _lock);
+
+  size_t const maxEntries = _maxEntries.load();
+
+  if (maxEntries == 0 || _version.load() != version) {
+    return;
+  }
+
+  auto it = _entries.find(vocbase);
+
+  if (it == _entries.end()) {
+    it = _entries.emplace(vocbase, std::make_unique<DatabaseEntry>()).first;
+  }
+
+  DatabaseEntry* db = (*it).second.get();
+
+  // make room for the new plan
+  db->remove(hash);
+  db->enforceMaxEntries(maxEntries - 1);
+
+  db->order.emplace_back(hash);
+
+  try {
+    db->entriesByHash.emplace(hash,
+                              std::make_pair(entry, std::prev(db->order.end())));
+
+    for (auto const& collection : entry->_collections) {
+      db->entriesByCollection[collection].emplace(hash);
+    }
+  } catch (...) {
+    db->remove(hash);
+    if (!db->order.empty() && db->order.back() == hash) {
+      db->order.pop_back();
+    }
+    throw;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans for the given collections
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::invalidate(TRI_vocbase_t* vocbase,
+                           std::vector<std::string> const& collections) {
+  WRITE_LOCKER(writeLocker, _lock);
+  ++_version;
+
+  auto it = _entries.find(vocbase);
+
+  if (it == _entries.end()) {
+    return;
+  }
+
+  for (auto const& collection : collections) {
+    (*it).second->invalidate(collection);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans for a particular collection
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::invalidate(TRI_vocbase_t* vocbase, char const* collection) {
+  WRITE_LOCKER(writeLocker, _lock);
+  ++_version;
+
+  auto it = _entries.find(vocbase);
+
+  if (it == _entries.end()) {
+    return;
+  }
+
+  (*it).second->invalidate(std::string(collection));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans and statistics for a particular database
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::invalidate(TRI_vocbase_t* vocbase) {
+  std::unique_ptr<DatabaseEntry> db;
+
+  {
+    WRITE_LOCKER(writeLocker, _lock);
+    ++_version;
+
+    auto it = _entries.find(vocbase);
+
+    if (it == _entries.end()) {
+      return;
+    }
+
+    db = std::move((*it).second);
+    _entries.erase(it);
+  }
+
+  // the plans are freed without holding the lock
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidate all plans
+////////////////////////////////////////////////////////////////////////////////
+
+void PlanCache::invalidate() {
+  std::unordered_map<TRI_vocbase_t*, std::unique_ptr<DatabaseEntry>> entries;
+
+  {
+    WRITE_LOCKER(writeLocker, _lock);
+    ++_version;
+    entries.swap(_entries);
+  }
+
+  // the plans are freed without holding the lock
+}
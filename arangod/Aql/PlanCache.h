@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_PLAN_CACHE_H
+#define ARANGOD_AQL_PLAN_CACHE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/ReadWriteLock.h"
+
+#include <list>
+
+struct TRI_json_t;
+struct TRI_vocbase_t;
+
+namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+namespace aql {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief an optimized execution plan, stored in JSON format together with
+/// the query string, bind parameters and options it was created for
+////////////////////////////////////////////////////////////////////////////////
+
+struct PlanCacheEntry {
+  PlanCacheEntry(PlanCacheEntry const&) = delete;
+  PlanCacheEntry& operator=(PlanCacheEntry const&) = delete;
+  PlanCacheEntry() = delete;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create an entry. the entry takes over ownership of the plan,
+  /// the bind parameters and the options are copied
+  //////////////////////////////////////////////////////////////////////////////
+
+  PlanCacheEntry(char const*, size_t, TRI_json_t const*, TRI_json_t const*,
+                 TRI_json_t*, std::vector<std::string> const&, bool, bool);
+
+  ~PlanCacheEntry();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the entry was created for the query string, bind
+  /// parameters and options
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool matches(char const*, size_t, TRI_json_t const*,
+               TRI_json_t const*) const;
+
+  std::string const _queryString;
+  TRI_json_t* _bindParameters;
+  TRI_json_t* _options;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the plan, including its collections and variables
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_json_t* _plan;
+
+  std::vector<std::string> const _collections;
+  bool const _isModificationQuery;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the results of the query may be stored in the query
+  /// result cache
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool const _isCacheable;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cache for optimized execution plans. the plans are kept per
+/// database and are invalidated when a collection they use is dropped or
+/// renamed, or an index of such a collection is created or dropped
+////////////////////////////////////////////////////////////////////////////////
+
+class PlanCache {
+ public:
+  PlanCache(PlanCache const&) = delete;
+  PlanCache& operator=(PlanCache const&) = delete;
+
+  PlanCache();
+
+  ~PlanCache();
+
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief get the pointer to the global plan cache
+  //////////////////////////////////////////////////////////////////////////////
+
+  static PlanCache* instance();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of plans per database (0 = cache disabled)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t maxEntries() const { return _maxEntries.load(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the maximum number of plans per database
+  //////////////////////////////////////////////////////////////////////////////
+
+  void maxEntries(size_t);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the properties and statistics of the cache for a database
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::velocypack::Builder properties(TRI_vocbase_t*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief current version of the cache. the version is increased by every
+  /// invalidation
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t version() const { return _version.load(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief look up a plan. counts a hit or a miss for the database
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::shared_ptr<PlanCacheEntry const> lookup(TRI_vocbase_t*, uint64_t,
+                                               char const*, size_t,
+                                               TRI_json_t const*,
+                                               TRI_json_t const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief store a plan, replacing an existing plan with the same hash.
+  /// the plan is not stored if there was an invalidation since the given
+  /// version was fetched, as the plan may use a dropped index then
+  //////////////////////////////////////////////////////////////////////////////
+
+  void store(TRI_vocbase_t*, uint64_t, std::shared_ptr<PlanCacheEntry const>,
+             uint64_t);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief invalidate all plans for the given collections
+  //////////////////////////////////////////////////////////////////////////////
+
+  void invalidate(TRI_vocbase_t*, std::vector<std::string> const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief invalidate all plans for a particular collection
+  //////////////////////////////////////////////////////////////////////////////
+
+  void invalidate(TRI_vocbase_t*, char const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief invalidate all plans and statistics for a particular database
+  //////////////////////////////////////////////////////////////////////////////
+
+  void invalidate(TRI_vocbase_t*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief invalidate all plans
+  //////////////////////////////////////////////////////////////////////////////
+
+  void invalidate();
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the plans of a database
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct DatabaseEntry {
+    DatabaseEntry() : hits(0), misses(0), invalidations(0) {}
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief remove a plan
+    //////////////////////////////////////////////////////////////////////////
+
+    void remove(uint64_t);
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief remove all plans for a collection
+    //////////////////////////////////////////////////////////////////////////
+
+    void invalidate(std::string const&);
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief remove the oldest plans until there are at most n plans
+    //////////////////////////////////////////////////////////////////////////
+
+    void enforceMaxEntries(size_t);
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief plans by hash, with their position in the insertion order
+    //////////////////////////////////////////////////////////////////////////
+
+    std::unordered_map<uint64_t,
+                       std::pair<std::shared_ptr<PlanCacheEntry const>,
+                                 std::list<uint64_t>::iterator>>
+        entriesByHash;
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief hashes of the plans that use a collection
+    //////////////////////////////////////////////////////////////////////////
+
+    std::unordered_map<std::string, std::unordered_set<uint64_t>>
+        entriesByCollection;
+
+    //////////////////////////////////////////////////////////////////////////
+    /// @brief hashes of the plans in insertion order, oldest first
+    //////////////////////////////////////////////////////////////////////////
+
+    std::list<uint64_t> order;
+
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> invalidations;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief protects the database entries
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::basics::ReadWriteLock _lock;
+
+  std::unordered_map<TRI_vocbase_t*, std::unique_ptr<DatabaseEntry>> _entries;
+
+  std::atomic<size_t> _maxEntries;
+
+  std::atomic<uint64_t> _version;
+};
+}
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include "Aql/Executor.h"
 #include "Aql/Optimizer.h"
 #include "Aql/Parser.h"
+#include "Aql/PlanCache.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryList.h"
 #include "Aql/ShortStringStorage.h"
@@ -36,6 +37,7 @@
 #include "Basics/WorkMonitor.h"
 #include "Basics/fasthash.h"
 #include "Basics/json.h"
+#include "Basics/json-utilities.h"
 #include "Basics/tri-strings.h"
 #include "Cluster/ServerState.h"
 #include "Utils/AqlTransaction.h"
@@ -49,6 +51,7 @@
 using namespace arangodb;
 using namespace arangodb::aql;
 using Json = arangodb::basics::Json;
+using JsonHelper = arangodb::basics::JsonHelper;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief empty string singleton
@@ -162,6 +165,30 @@ TRI_json_t* Profile::toJson(TRI_memory_zone_t*) {
 
 bool Query::DoDisableQueryTracking = false;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief global default for the sortSpillThreshold option
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t Query::DefaultSortSpillThreshold = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief global default for the collectSpillThreshold option
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t Query::DefaultCollectSpillThreshold = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief global default for the maxParallelism option
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t Query::DefaultMaxParallelism = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief global default for the memoryLimit option
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t Query::DefaultMemoryLimit = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief creates a query
 ////////////////////////////////////////////////////////////////////////////////
@@ -192,14 +219,19 @@ Query::Query(arangodb::ApplicationV8* applicationV8,
       _engine(nullptr),
       _maxWarningCount(10),
       _warnings(),
+      _resourceMonitor(),
       _part(part),
       _contextOwnedByExterior(contextOwnedByExterior),
       _killed(false),
-      _isModificationQuery(false) {
+      _isModificationQuery(false),
+      _isCacheable(false),
+      _cachedPlan() {
   // std::cout << TRI_CurrentThreadId() << ", QUERY " << this << " CTOR: " <<
   // queryString << "\n";
 
   TRI_ASSERT(_vocbase != nullptr);
+
+  _resourceMonitor.setMemoryLimit(memoryLimit());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -232,14 +264,19 @@ Query::Query(arangodb::ApplicationV8* applicationV8,
       _engine(nullptr),
       _maxWarningCount(10),
       _warnings(),
+      _resourceMonitor(),
       _part(part),
       _contextOwnedByExterior(contextOwnedByExterior),
       _killed(false),
-      _isModificationQuery(false) {
+      _isModificationQuery(false),
+      _isCacheable(false),
+      _cachedPlan() {
   // std::cout << TRI_CurrentThreadId() << ", QUERY " << this << " CTOR (JSON):
   // " << _queryJson.toString() << "\n";
 
   TRI_ASSERT(_vocbase != nullptr);
+
+  _resourceMonitor.setMemoryLimit(memoryLimit());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -479,13 +516,34 @@ QueryResult Query::prepare(QueryRegistry* registry) {
     auto parser = std::make_unique<Parser>(this);
     std::unique_ptr<ExecutionPlan> plan;
 
-    if (_queryString != nullptr) {
-      parser->parse(false);
-      // put in bind parameters
-      parser->ast()->injectBindParameters(_bindParameters);
+    bool const usePlanCache = canUsePlanCache();
+    uint64_t planCacheHash = 0;
+    uint64_t planCacheVersion = 0;
+
+    if (usePlanCache) {
+      // must be fetched before the collections and indexes are inspected
+      planCacheVersion = PlanCache::instance()->version();
+      // the options are part of the key, as they influence the optimizer
+      planCacheHash = hash() ^ TRI_FastHashJson(_options);
+      _cachedPlan = PlanCache::instance()->lookup(
+          _vocbase, planCacheHash, _queryString, _queryLength,
+          _bindParameters.json(), _options);
     }
 
-    _isModificationQuery = parser->isModificationQuery();
+    if (_cachedPlan != nullptr) {
+      // the query will be instantiated from the cached plan
+      _isModificationQuery = _cachedPlan->_isModificationQuery;
+      _isCacheable = _cachedPlan->_isCacheable;
+    } else {
+      if (_queryString != nullptr) {
+        parser->parse(false);
+        // put in bind parameters
+        parser->ast()->injectBindParameters(_bindParameters);
+      }
+
+      _isModificationQuery = parser->isModificationQuery();
+      _isCacheable = parser->ast()->root()->isCacheable();
+    }
 
     // create the transaction object, but do not start it yet
     _trx = new arangodb::AqlTransaction(createTransactionContext(), _vocbase,
@@ -494,7 +552,7 @@ QueryResult Query::prepare(QueryRegistry* registry) {
 
     bool planRegisters;
 
-    if (_queryString != nullptr) {
+    if (_queryString != nullptr && _cachedPlan == nullptr) {
       // we have an AST
       int res = _trx->begin();
 
@@ -528,11 +586,45 @@ QueryResult Query::prepare(QueryRegistry* registry) {
       // Now plan and all derived plans belong to the optimizer
       plan.reset(opt.stealBest());  // Now we own the best one again
       planRegisters = true;
-    } else {  // no queryString, we are instantiating from _queryJson
+
+      if (usePlanCache && _warnings.empty()) {
+        // store the plan with its registers planned, so later queries can
+        // be instantiated from it without parsing and optimizing
+        plan->findVarUsage();
+        plan->planRegisters();
+        planRegisters = false;
+
+        std::vector<std::string> collections;
+        for (auto const& it : *_collections.collections()) {
+          collections.emplace_back(it.first);
+        }
+
+        auto planJson = plan->toJson(parser->ast(), TRI_UNKNOWN_MEM_ZONE, true);
+        auto entry = std::make_shared<PlanCacheEntry const>(
+            _queryString, _queryLength, _bindParameters.json(), _options,
+            planJson.json(), collections, _isModificationQuery, _isCacheable);
+        // the entry now owns the plan
+        planJson.steal();
+
+        PlanCache::instance()->store(_vocbase, planCacheHash, entry,
+                                     planCacheVersion);
+      }
+    } else {
+      // no AST, we are instantiating from a cached plan or from _queryJson
+      arangodb::basics::Json const* planJson = &_queryJson;
+      arangodb::basics::Json cachedPlanJson;
+
+      if (_cachedPlan != nullptr) {
+        cachedPlanJson = arangodb::basics::Json(
+            TRI_UNKNOWN_MEM_ZONE, _cachedPlan->_plan,
+            arangodb::basics::Json::NOFREE);
+        planJson = &cachedPlanJson;
+      }
+
       enterState(PLAN_INSTANTIATION);
-      ExecutionPlan::getCollectionsFromJson(parser->ast(), _queryJson);
+      ExecutionPlan::getCollectionsFromJson(parser->ast(), *planJson);
 
-      parser->ast()->variables()->fromJson(_queryJson);
+      parser->ast()->variables()->fromJson(*planJson);
       // creating the plan may have produced some collections
       // we need to add them to the transaction now (otherwise the query will
       // fail)
@@ -548,7 +640,7 @@ QueryResult Query::prepare(QueryRegistry* registry) {
       }
 
       // we have an execution plan in JSON format
-      plan.reset(ExecutionPlan::instantiateFromJson(parser->ast(), _queryJson));
+      plan.reset(ExecutionPlan::instantiateFromJson(parser->ast(), *planJson));
       if (plan.get() == nullptr) {
         // oops
         return QueryResult(TRI_ERROR_INTERNAL);
@@ -662,7 +754,7 @@ QueryResult Query::execute(QueryRegistry* registry) {
     log();
 
     if (useQueryCache && (_isModificationQuery || !_warnings.empty() ||
-                          !_ast->root()->isCacheable())) {
+                          !_isCacheable)) {
       useQueryCache = false;
     }
 
@@ -739,8 +831,14 @@ QueryResult Query::execute(QueryRegistry* registry) {
       throw;
     }
 
+    _engine->_stats.setPeakMemoryUsage(
+        static_cast<int64_t>(_resourceMonitor.peakMemoryUsage()));
     std::shared_ptr<VPackBuilder> stats = _engine->_stats.toVelocyPack();
 
+    if (profiling()) {
+      buildProfiledPlan();
+    }
+
     _trx->commit();
 
     cleanupPlanAndEngine(TRI_ERROR_NO_ERROR);
@@ -754,6 +852,7 @@ QueryResult Query::execute(QueryRegistry* registry) {
 
     if (_profile != nullptr && profiling()) {
       result.profile = _profile->toJson(TRI_UNKNOWN_MEM_ZONE);
+      result.plan = _profiledPlan;
     }
 
     return result;
@@ -817,7 +916,7 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
     log();
 
     if (useQueryCache && (_isModificationQuery || !_warnings.empty() ||
-                          !_ast->root()->isCacheable())) {
+                          !_isCacheable)) {
       useQueryCache = false;
     }
 
@@ -892,8 +991,14 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
       throw;
     }
 
+    _engine->_stats.setPeakMemoryUsage(
+        static_cast<int64_t>(_resourceMonitor.peakMemoryUsage()));
     std::shared_ptr<VPackBuilder> stats = _engine->_stats.toVelocyPack();
 
+    if (profiling()) {
+      buildProfiledPlan();
+    }
+
     _trx->commit();
 
     cleanupPlanAndEngine(TRI_ERROR_NO_ERROR);
@@ -905,6 +1010,7 @@ QueryResultV8 Query::executeV8(v8::Isolate* isolate, QueryRegistry* registry) {
 
     if (_profile != nullptr && profiling()) {
       result.profile = _profile->toJson(TRI_UNKNOWN_MEM_ZONE);
+      result.plan = _profiledPlan;
     }
 
     return result;
@@ -1205,6 +1311,8 @@ void Query::exitContext() {
 
 arangodb::basics::Json Query::getStats() {
   if (_engine) {
+    _engine->_stats.setPeakMemoryUsage(
+        static_cast<int64_t>(_resourceMonitor.peakMemoryUsage()));
     return _engine->_stats.toJson();
   }
   return ExecutionStats::toJsonStatic();
@@ -1360,6 +1468,25 @@ bool Query::canUseQueryCache() const {
   return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the plan cache can be used for the query
+////////////////////////////////////////////////////////////////////////////////
+
+bool Query::canUsePlanCache() const {
+  if (_queryString == nullptr || _part != PART_MAIN) {
+    return false;
+  }
+
+  if (PlanCache::instance()->maxEntries() == 0 ||
+      !getBooleanOption("planCache", true)) {
+    return false;
+  }
+
+  // plans on a coordinator are distributed to the DB servers and cannot
+  // be reused
+  return !arangodb::ServerState::instance()->isRunningInCluster();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief fetch a numeric value from the options
 ////////////////////////////////////////////////////////////////////////////////
@@ -1488,6 +1615,72 @@ std::shared_ptr<VPackBuilder> Query::getSharedBuilder() {
   return std::make_shared<VPackBuilder>();
 };
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief annotate the execution plan with the runtime statistics of its
+/// nodes, must be called before the plan and engine are cleaned up
+////////////////////////////////////////////////////////////////////////////////
+
+void Query::buildProfiledPlan() {
+  TRI_ASSERT(_plan != nullptr);
+  TRI_ASSERT(_engine != nullptr);
+
+  auto const& nodeStats = _engine->_stats.nodes;
+
+  auto lookup = [&nodeStats](size_t id) -> ExecutionNodeStats {
+    auto it = nodeStats.find(id);
+    if (it == nodeStats.end()) {
+      // node was never called
+      return ExecutionNodeStats();
+    }
+    return (*it).second;
+  };
+
+  // annotates the nodes of a plan or subquery, recursing into subqueries
+  std::function<void(Json const&)> annotate = [&](Json const& nodes) {
+    size_t const n = nodes.size();
+
+    for (size_t i = 0; i < n; ++i) {
+      Json node = nodes.at(i);
+      auto const stats = lookup(
+          JsonHelper::checkAndGetNumericValue<size_t>(node.json(), "id"));
+
+      // the rows a node reads are the rows its dependencies produce
+      int64_t itemsIn = 0;
+      Json dependencies = node.get("dependencies");
+      for (size_t j = 0; j < dependencies.size(); ++j) {
+        itemsIn += lookup(static_cast<size_t>(
+                              JsonHelper::getNumericValue<double>(
+                                  dependencies.at(j).json(), 0.0)))
+                       .items;
+      }
+
+      Json profile(Json::Object, 4);
+      profile.set("calls", Json(static_cast<double>(stats.calls)));
+      profile.set("itemsIn", Json(static_cast<double>(itemsIn)));
+      profile.set("itemsOut", Json(static_cast<double>(stats.items)));
+      profile.set("runtime", Json(stats.runtime));
+      node.set("profile", profile);
+
+      Json subquery = node.get("subquery");
+      if (subquery.isObject()) {
+        annotate(subquery.get("nodes"));
+      }
+    }
+  };
+
+  Json plan = _plan->toJson(_ast, TRI_UNKNOWN_MEM_ZONE, false);
+  annotate(plan.get("nodes"));
+
+  auto result = std::make_shared<VPackBuilder>();
+  int res = JsonHelper::toVelocyPack(plan.json(), *result);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  _profiledPlan = result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief cleanup plan and engine for current query
 ////////////////////////////////////////////////////////////////////////////////
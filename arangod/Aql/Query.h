@@ -29,6 +29,7 @@
 #include "Aql/BindParameters.h"
 #include "Aql/Collections.h"
 #include "Aql/QueryResultV8.h"
+#include "Aql/ResourceUsage.h"
 #include "Aql/ShortStringStorage.h"
 #include "Aql/Graphs.h"
 #include "Aql/types.h"
@@ -54,6 +55,7 @@ class ExecutionEngine;
 class ExecutionPlan;
 class Executor;
 class Parser;
+struct PlanCacheEntry;
 class Query;
 class QueryRegistry;
 
@@ -216,6 +218,15 @@ class Query {
 
   bool profiling() const { return getBooleanOption("profile", false); }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief should AqlItemBlocks be transferred between cluster nodes in
+  /// VelocyPack? if not, they are transferred in JSON
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool transferVelocyPack() const {
+    return getBooleanOption("transferVelocyPack", true);
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief maximum number of plans to produce
   //////////////////////////////////////////////////////////////////////////////
@@ -240,6 +251,97 @@ class Query {
     return -1;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of rows a SORT may buffer in memory before it writes
+  /// sorted runs to temporary files (0 = never spill)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t sortSpillThreshold() const {
+    double value = getNumericOption(
+        "sortSpillThreshold", static_cast<double>(DefaultSortSpillThreshold));
+    if (value > 0) {
+      return static_cast<size_t>(value);
+    }
+    return 0;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of sorted runs a SORT merges at once. more runs
+  /// are merged in several passes
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t sortMergeFanIn() const {
+    double value = getNumericOption("sortMergeFanIn", 64.0);
+    if (value >= 2) {
+      return static_cast<size_t>(value);
+    }
+    return 2;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of groups a hashed COLLECT may keep in memory before it
+  /// writes the input rows of further groups to temporary files
+  /// (0 = never spill)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t collectSpillThreshold() const {
+    double value =
+        getNumericOption("collectSpillThreshold",
+                         static_cast<double>(DefaultCollectSpillThreshold));
+    if (value > 0) {
+      return static_cast<size_t>(value);
+    }
+    return 0;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of threads a single collection scan or traversal
+  /// may use (1 = no parallelism)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t maxParallelism() const {
+    double value = getNumericOption(
+        "maxParallelism", static_cast<double>(DefaultMaxParallelism));
+    if (value > 1) {
+      return static_cast<size_t>(value);
+    }
+    return 1;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of bytes the query may use (0 = unlimited)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t memoryLimit() const {
+    double value = getNumericOption("memoryLimit",
+                                    static_cast<double>(DefaultMemoryLimit));
+    if (value > 0) {
+      return static_cast<size_t>(value);
+    }
+    return 0;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the resource monitor the execution blocks charge their memory to
+  //////////////////////////////////////////////////////////////////////////////
+
+  ResourceMonitor* resourceMonitor() { return &_resourceMonitor; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of bytes the query has used so far
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t peakMemoryUsage() const { return _resourceMonitor.peakMemoryUsage(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the execution plan annotated with the runtime statistics of its
+  /// nodes. this is only set for profiled queries after their execution
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::shared_ptr<arangodb::velocypack::Builder> profiledPlan() const {
+    return _profiledPlan;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief extract a region from the query
   //////////////////////////////////////////////////////////////////////////////
@@ -409,6 +511,34 @@ class Query {
     DoDisableQueryTracking = value;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the global default for the sortSpillThreshold option
+  //////////////////////////////////////////////////////////////////////////////
+
+  static void SortSpillThreshold(uint64_t value) {
+    DefaultSortSpillThreshold = value;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the global default for the collectSpillThreshold option
+  //////////////////////////////////////////////////////////////////////////////
+
+  static void CollectSpillThreshold(uint64_t value) {
+    DefaultCollectSpillThreshold = value;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the global default for the maxParallelism option
+  //////////////////////////////////////////////////////////////////////////////
+
+  static void MaxParallelism(uint64_t value) { DefaultMaxParallelism = value; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the global default for the memoryLimit option
+  //////////////////////////////////////////////////////////////////////////////
+
+  static void MemoryLimit(uint64_t value) { DefaultMemoryLimit = value; }
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief get a description of the query's current state
   ////////////////////////////////////////////////////////////////////////////////
@@ -457,6 +587,12 @@ class Query {
 
   bool canUseQueryCache() const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the plan cache can be used for the query
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool canUsePlanCache() const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief fetch a numeric value from the options
   //////////////////////////////////////////////////////////////////////////////
@@ -493,6 +629,13 @@ class Query {
 
   void cleanupPlanAndEngine(int);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief annotate the execution plan with the runtime statistics of its
+  /// nodes, must be called before the plan and engine are cleaned up
+  //////////////////////////////////////////////////////////////////////////////
+
+  void buildProfiledPlan();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief create a TransactionContext
   //////////////////////////////////////////////////////////////////////////////
@@ -650,6 +793,18 @@ class Query {
 
   std::vector<std::pair<int, std::string>> _warnings;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief memory used by the query
+  //////////////////////////////////////////////////////////////////////////////
+
+  ResourceMonitor _resourceMonitor;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the execution plan annotated with runtime statistics
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::shared_ptr<arangodb::velocypack::Builder> _profiledPlan;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief the query part
   //////////////////////////////////////////////////////////////////////////////
@@ -674,11 +829,48 @@ class Query {
 
   bool _isModificationQuery;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the query results may be stored in the query
+  /// result cache. determined when the query is prepared
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _isCacheable;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the cached plan the query was instantiated from, if any
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::shared_ptr<PlanCacheEntry const> _cachedPlan;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief whether or not query tracking is disabled globally
   //////////////////////////////////////////////////////////////////////////////
 
   static bool DoDisableQueryTracking;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief global default for the sortSpillThreshold option
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t DefaultSortSpillThreshold;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief global default for the collectSpillThreshold option
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t DefaultCollectSpillThreshold;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief global default for the maxParallelism option
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t DefaultMaxParallelism;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief global default for the memoryLimit option
+  //////////////////////////////////////////////////////////////////////////////
+
+  static uint64_t DefaultMemoryLimit;
 };
 }
 }
@@ -29,6 +29,9 @@
 #include "Basics/Exceptions.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb::aql;
 
 QueryEntry::QueryEntry(arangodb::aql::Query const* query, double started)
@@ -36,9 +39,12 @@ QueryEntry::QueryEntry(arangodb::aql::Query const* query, double started)
 
 QueryEntryCopy::QueryEntryCopy(TRI_voc_tick_t id,
                                std::string const& queryString, double started,
-                               double runTime, std::string const& queryState)
+                               double runTime, std::string const& queryState,
+                               size_t peakMemoryUsage,
+                               std::shared_ptr<VPackBuilder> plan)
     : id(id), queryString(queryString), started(started), runTime(runTime),
-      queryState(queryState) {}
+      queryState(queryState), peakMemoryUsage(peakMemoryUsage),
+      plan(plan) {}
 
 double const QueryList::DefaultSlowQueryThreshold = 10.0;
 size_t const QueryList::DefaultMaxSlowQueries = 64;
@@ -180,7 +186,9 @@ void QueryList::remove(Query const* query, double now) {
               entry->query->id(),
               std::move(q),
               entry->started, now - entry->started,
-              std::string(" (while finished)")));
+              std::string(" (while finished)"),
+              entry->query->peakMemoryUsage(),
+              entry->query->profiledPlan()));
 
           if (++_slowCount > _maxSlowQueries) {
             // free first element
@@ -278,7 +286,8 @@ std::vector<QueryEntryCopy> QueryList::listCurrent() {
                          std::string(queryString, length)
                              .append(originalLength > maxLength ? "..." : ""),
                          entry->started, now - entry->started,
-                         entry->query->getStateString()));
+                         entry->query->getStateString(),
+                         entry->query->peakMemoryUsage(), nullptr));
     }
   }
 
@@ -33,6 +33,10 @@
 struct TRI_vocbase_t;
 
 namespace arangodb {
+namespace velocypack {
+class Builder;
+}
+
 namespace aql {
 
 class Query;
@@ -53,13 +57,17 @@ struct QueryEntryCopy {
                   std::string const&,
                   double,
                   double,
-                  std::string const&);
+                  std::string const&,
+                  size_t,
+                  std::shared_ptr<arangodb::velocypack::Builder>);
 
   TRI_voc_tick_t  id;
   std::string     queryString;
   double          started;
   double          runTime;
   std::string     queryState;
+  size_t          peakMemoryUsage;
+  std::shared_ptr<arangodb::velocypack::Builder> plan;
 };
 
 class QueryList {
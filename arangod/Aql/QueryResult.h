@@ -44,6 +44,7 @@ struct QueryResult {
     json = other.json;
     stats = other.stats;
     profile = other.profile;
+    plan = other.plan;
     zone = other.zone;
     clusterplan = other.clusterplan;
     bindParameters = other.bindParameters;
@@ -92,6 +93,7 @@ struct QueryResult {
   TRI_json_t* json;
   std::shared_ptr<arangodb::velocypack::Builder> stats;
   TRI_json_t* profile;
+  std::shared_ptr<arangodb::velocypack::Builder> plan;
   TRI_json_t* clusterplan;
 };
 }
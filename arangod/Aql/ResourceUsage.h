@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_RESOURCE_USAGE_H
+#define ARANGOD_AQL_RESOURCE_USAGE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Exceptions.h"
+
+namespace arangodb {
+namespace aql {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tracks the memory used by a query. the execution blocks charge
+/// their allocations to the monitor of their query, and the monitor throws
+/// when the query's memory limit would be exceeded. the counters are
+/// atomic, as the worker threads of parallel scans charge their temporary
+/// blocks to the monitor, too
+////////////////////////////////////////////////////////////////////////////////
+
+class ResourceMonitor {
+ public:
+  ResourceMonitor(ResourceMonitor const&) = delete;
+  ResourceMonitor& operator=(ResourceMonitor const&) = delete;
+
+  ResourceMonitor()
+      : _memoryLimit(0), _currentMemoryUsage(0), _peakMemoryUsage(0) {}
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the memory limit in bytes (0 = unlimited)
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setMemoryLimit(size_t value) { _memoryLimit = value; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the memory limit in bytes (0 = unlimited)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t memoryLimit() const { return _memoryLimit; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief charge memory to the query. throws if the limit would be
+  /// exceeded, in which case nothing is charged
+  //////////////////////////////////////////////////////////////////////////////
+
+  void increaseMemoryUsage(size_t value) {
+    size_t current =
+        _currentMemoryUsage.fetch_add(value, std::memory_order_relaxed) +
+        value;
+
+    if (_memoryLimit > 0 && current > _memoryLimit) {
+      _currentMemoryUsage.fetch_sub(value, std::memory_order_relaxed);
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_RESOURCE_LIMIT,
+          "query would use more memory than allowed (limit: " +
+              std::to_string(_memoryLimit) + " bytes)");
+    }
+
+    size_t peak = _peakMemoryUsage.load(std::memory_order_relaxed);
+    while (current > peak &&
+           !_peakMemoryUsage.compare_exchange_weak(
+               peak, current, std::memory_order_relaxed)) {
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief release memory previously charged to the query
+  //////////////////////////////////////////////////////////////////////////////
+
+  void decreaseMemoryUsage(size_t value) noexcept {
+    size_t previous =
+        _currentMemoryUsage.fetch_sub(value, std::memory_order_relaxed);
+    TRI_ASSERT(previous >= value);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief memory currently charged to the query, in bytes
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t currentMemoryUsage() const {
+    return _currentMemoryUsage.load(std::memory_order_relaxed);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum memory charged to the query at any time, in bytes
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t peakMemoryUsage() const {
+    return _peakMemoryUsage.load(std::memory_order_relaxed);
+  }
+
+ private:
+  size_t _memoryLimit;
+
+  std::atomic<size_t> _currentMemoryUsage;
+
+  std::atomic<size_t> _peakMemoryUsage;
+};
+}
+}
+
+#endif
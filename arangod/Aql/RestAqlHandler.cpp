@@ -27,12 +27,18 @@
 #include "Aql/ExecutionBlock.h"
 #include "Basics/Logger.h"
 #include "Basics/StringUtils.h"
+#include "Basics/VelocyPackHelper.h"
 #include "Dispatcher/Dispatcher.h"
 #include "Dispatcher/DispatcherThread.h"
 #include "Rest/HttpRequest.h"
 #include "Rest/HttpResponse.h"
 #include "VocBase/server.h"
 
+#include <velocypack/Builder.h>
+#include <velocypack/Iterator.h>
+#include <velocypack/Slice.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 using namespace arangodb::rest;
 using namespace arangodb::aql;
@@ -385,15 +391,24 @@ void RestAqlHandler::useQuery(std::string const& operation,
   TRI_ASSERT(_qId > 0);
   TRI_ASSERT(query->engine() != nullptr);
 
+  // the coordinator sends AqlItemBlocks in VelocyPack, see RemoteBlock
+  VPackSlice querySlice;
+  TRI_json_t* body;
+  if (hasVelocyPackHeader("content-type")) {
+    body = parseVelocyPackQueryBody(querySlice);
+  } else {
+    body = parseJsonBody();
+  }
+
   arangodb::basics::Json queryJson =
-      arangodb::basics::Json(TRI_UNKNOWN_MEM_ZONE, parseJsonBody());
+      arangodb::basics::Json(TRI_UNKNOWN_MEM_ZONE, body);
   if (queryJson.isEmpty()) {
     _queryRegistry->close(_vocbase, _qId);
     return;
   }
 
   try {
-    handleUseQuery(operation, query, queryJson);
+    handleUseQuery(operation, query, queryJson, querySlice);
     if (_qId != 0) {
       try {
         _queryRegistry->close(_vocbase, _qId);
@@ -650,7 +665,8 @@ bool RestAqlHandler::findQuery(std::string const& idString, Query*& query) {
 ////////////////////////////////////////////////////////////////////////////////
 
 void RestAqlHandler::handleUseQuery(std::string const& operation, Query* query,
-                                    arangodb::basics::Json const& queryJson) {
+                                    arangodb::basics::Json const& queryJson,
+                                    VPackSlice const& querySlice) {
   bool found;
   std::string shardId;
   char const* shardIdCharP = _request->header("shard-id", found);
@@ -702,6 +718,37 @@ void RestAqlHandler::handleUseQuery(std::string const& operation, Query* query,
       }
       items.reset(block->getSomeForShard(atLeast, atMost, shardId));
     }
+    if (hasVelocyPackHeader("accept")) {
+      // the caller understands VelocyPack, which is much cheaper to
+      // produce and to parse than JSON for large blocks
+      VPackBuilder builder;
+      try {
+        builder.openObject();
+        if (items.get() == nullptr) {
+          builder.add("exhausted", VPackValue(true));
+          builder.add("error", VPackValue(false));
+        } else {
+          items->toVelocyPack(query->trx(), builder);
+        }
+        query->engine()->_stats.setPeakMemoryUsage(static_cast<int64_t>(
+            query->resourceMonitor()->peakMemoryUsage()));
+        builder.add("stats", query->engine()->_stats.toVelocyPack()->slice());
+        builder.close();
+      } catch (...) {
+        LOG(ERR) << "cannot transform AqlItemBlock to VelocyPack";
+        generateError(HttpResponse::SERVER_ERROR, TRI_ERROR_HTTP_SERVER_ERROR,
+                      "cannot transform AqlItemBlock to VelocyPack");
+        return;
+      }
+
+      VPackSlice answer = builder.slice();
+      createResponse(arangodb::rest::HttpResponse::OK);
+      _response->setContentType(RemoteBlock::contentTypeVelocyPack);
+      _response->body().appendText(reinterpret_cast<char const*>(answer.begin()),
+                                   static_cast<size_t>(answer.byteSize()));
+      return;
+    }
+
     if (items.get() == nullptr) {
       answerBody("exhausted", arangodb::basics::Json(true))(
           "error", arangodb::basics::Json(false))("stats", query->getStats());
@@ -777,7 +824,13 @@ void RestAqlHandler::handleUseQuery(std::string const& operation, Query* query,
       if (JsonHelper::getBooleanValue(queryJson.json(), "exhausted", true)) {
         res = query->engine()->initializeCursor(nullptr, 0);
       } else {
-        items.reset(new AqlItemBlock(queryJson.get("items")));
+        if (querySlice.isObject()) {
+          items.reset(new AqlItemBlock(query->resourceMonitor(),
+                                       querySlice.get("items")));
+        } else {
+          items.reset(new AqlItemBlock(query->resourceMonitor(),
+                                       queryJson.get("items")));
+        }
         res = query->engine()->initializeCursor(items.get(), pos);
       }
     } catch (...) {
@@ -866,3 +919,61 @@ TRI_json_t* RestAqlHandler::parseJsonBody() {
 
   return json;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse a VelocyPack request body
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* RestAqlHandler::parseVelocyPackQueryBody(VPackSlice& slice) {
+  char const* body = _request->body();
+  size_t const length = _request->bodySize();
+
+  try {
+    if (length == 0 ||
+        VPackSlice(body).byteSize() > static_cast<VPackValueLength>(length)) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_HTTP_CORRUPTED_JSON);
+    }
+
+    slice = VPackSlice(body);
+
+    if (!slice.isObject()) {
+      LOG(ERR) << "body of request must be a VelocyPack object";
+      generateError(HttpResponse::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
+                    "body of request must be a VelocyPack object");
+      slice = VPackSlice();
+      return nullptr;
+    }
+
+    // the AqlItemBlock is read directly from the slice
+    Json json(Json::Object);
+    for (auto const& it : VPackObjectIterator(slice)) {
+      std::string key = it.key.copyString();
+      if (key != "items") {
+        json(key.c_str(), Json(TRI_UNKNOWN_MEM_ZONE,
+                       arangodb::basics::VelocyPackHelper::velocyPackToJson(
+                           it.value)));
+      }
+    }
+    return json.steal();
+  } catch (...) {
+    LOG(ERR) << "cannot parse VelocyPack object";
+    generateError(HttpResponse::BAD, TRI_ERROR_HTTP_CORRUPTED_JSON,
+                  "cannot parse VelocyPack object");
+    slice = VPackSlice();
+    return nullptr;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a request header contains the VelocyPack content
+/// type
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestAqlHandler::hasVelocyPackHeader(char const* name) const {
+  bool found;
+  char const* value = _request->header(name, found);
+
+  return (found && value != nullptr &&
+          strstr(value, RemoteBlock::contentTypeVelocyPack.c_str()) !=
+              nullptr);
+}
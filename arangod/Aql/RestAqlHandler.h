@@ -132,7 +132,8 @@ class RestAqlHandler : public RestVocbaseBaseHandler {
   //////////////////////////////////////////////////////////////////////////////
 
   void handleUseQuery(std::string const&, Query*,
-                      arangodb::basics::Json const&);
+                      arangodb::basics::Json const&,
+                      arangodb::velocypack::Slice const&);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief parseJsonBody, returns a nullptr and produces an error response if
@@ -141,6 +142,21 @@ class RestAqlHandler : public RestVocbaseBaseHandler {
 
   TRI_json_t* parseJsonBody();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief parse a VelocyPack request body. the attributes apart from
+  /// "items" are returned as JSON, the body itself is returned in the slice.
+  /// returns a nullptr and produces an error response if the body is invalid
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_json_t* parseVelocyPackQueryBody(arangodb::velocypack::Slice&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not a request header contains the VelocyPack content
+  /// type
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool hasVelocyPackHeader(char const*) const;
+
  private:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief dig out vocbase from context and query from ID, handle errors
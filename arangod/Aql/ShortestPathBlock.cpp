@@ -0,0 +1,597 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ShortestPathBlock.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/ExecutionPlan.h"
+#include "Cluster/ServerState.h"
+#include "Utils/CollectionNameResolver.h"
+#include "Utils/ShapedJsonTransformer.h"
+#include "VocBase/document-collection.h"
+#include "VocBase/VocShaper.h"
+
+using namespace arangodb::aql;
+
+using Json = arangodb::basics::Json;
+using VertexId = arangodb::traverser::VertexId;
+using EdgeId = arangodb::traverser::EdgeId;
+
+ShortestPathBlock::ShortestPathBlock(ExecutionEngine* engine,
+                                     ShortestPathNode const* ep)
+    : ExecutionBlock(engine, ep),
+      _directions(ep->directions()),
+      _useWeight(ep->usesWeight()),
+      _posInPath(0),
+      _pathComputed(false),
+      _startReg(0),
+      _useStartRegister(false),
+      _targetReg(0),
+      _useTargetRegister(false),
+      _vertexVar(nullptr),
+      _vertexReg(0),
+      _edgeVar(nullptr),
+      _edgeReg(0),
+      _pathVar(nullptr),
+      _pathReg(0),
+      _resolver(nullptr) {
+  if (arangodb::ServerState::instance()->isCoordinator()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_NOT_IMPLEMENTED,
+        "SHORTEST_PATH is not supported in a cluster");
+  }
+
+  _resolver = new CollectionNameResolver(_trx->vocbase());
+
+  try {
+    for (auto const& coll : ep->edgeColls()) {
+      TRI_voc_cid_t cid = _resolver->getCollectionId(coll);
+      TRI_document_collection_t* document = _trx->documentCollection(cid);
+
+      auto trxCollection = _trx->trxCollection(cid);
+      if (trxCollection != nullptr) {
+        _trx->orderDitch(trxCollection);
+      }
+
+      WeightCalculatorFunction weighter;
+      if (_useWeight) {
+        weighter = AttributeWeightCalculator(
+            ep->weightAttribute(), ep->defaultWeight(), document->getShaper());
+      } else {
+        weighter = [](TRI_doc_mptr_copy_t&) -> double { return 1.0; };
+      }
+      _collectionInfos.emplace_back(
+          new EdgeCollectionInfo(_trx, cid, document, weighter));
+    }
+  } catch (...) {
+    for (auto& info : _collectionInfos) {
+      delete info;
+    }
+    delete _resolver;
+    throw;
+  }
+
+  if (!ep->usesStartInVariable()) {
+    _startVertexId = ep->getStartVertex();
+  } else {
+    auto it = ep->getRegisterPlan()->varInfo.find(ep->startInVariable()->id);
+    TRI_ASSERT(it != ep->getRegisterPlan()->varInfo.end());
+    _startReg = it->second.registerId;
+    _useStartRegister = true;
+  }
+
+  if (!ep->usesTargetInVariable()) {
+    _targetVertexId = ep->getTargetVertex();
+  } else {
+    auto it = ep->getRegisterPlan()->varInfo.find(ep->targetInVariable()->id);
+    TRI_ASSERT(it != ep->getRegisterPlan()->varInfo.end());
+    _targetReg = it->second.registerId;
+    _useTargetRegister = true;
+  }
+
+  if (ep->usesVertexOutVariable()) {
+    _vertexVar = ep->vertexOutVariable();
+  }
+
+  if (ep->usesEdgeOutVariable()) {
+    _edgeVar = ep->edgeOutVariable();
+  }
+
+  if (ep->usesPathOutVariable()) {
+    _pathVar = ep->pathOutVariable();
+  }
+}
+
+ShortestPathBlock::~ShortestPathBlock() {
+  for (auto& info : _collectionInfos) {
+    delete info;
+  }
+  delete _resolver;
+  freeCaches();
+}
+
+void ShortestPathBlock::freeCaches() {
+  for (auto& v : _vertices) {
+    v.destroy();
+  }
+  _vertices.clear();
+  for (auto& e : _edges) {
+    e.destroy();
+  }
+  _edges.clear();
+  for (auto& p : _paths) {
+    p.destroy();
+  }
+  _paths.clear();
+  _posInPath = 0;
+}
+
+int ShortestPathBlock::initialize() {
+  int res = ExecutionBlock::initialize();
+  auto varInfo = getPlanNode()->getRegisterPlan()->varInfo;
+
+  if (_vertexVar != nullptr) {
+    auto it = varInfo.find(_vertexVar->id);
+    TRI_ASSERT(it != varInfo.end());
+    TRI_ASSERT(it->second.registerId < ExecutionNode::MaxRegisterId);
+    _vertexReg = it->second.registerId;
+  }
+  if (_edgeVar != nullptr) {
+    auto it = varInfo.find(_edgeVar->id);
+    TRI_ASSERT(it != varInfo.end());
+    TRI_ASSERT(it->second.registerId < ExecutionNode::MaxRegisterId);
+    _edgeReg = it->second.registerId;
+  }
+  if (_pathVar != nullptr) {
+    auto it = varInfo.find(_pathVar->id);
+    TRI_ASSERT(it != varInfo.end());
+    TRI_ASSERT(it->second.registerId < ExecutionNode::MaxRegisterId);
+    _pathReg = it->second.registerId;
+  }
+
+  return res;
+}
+
+int ShortestPathBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
+  freeCaches();
+  _kPaths.reset();
+  _pathComputed = false;
+  return ExecutionBlock::initializeCursor(items, pos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the start or target vertex of the current input row
+////////////////////////////////////////////////////////////////////////////////
+
+bool ShortestPathBlock::getVertexId(AqlItemBlock const* items,
+                                    bool useRegister, RegisterId reg,
+                                    std::string& idString, VertexId& result) {
+  if (useRegister) {
+    auto in = items->getValueReference(_pos, reg);
+    if (in.isShaped()) {
+      auto col = items->getDocumentCollection(reg);
+      result = VertexId(col->_info.id(), TRI_EXTRACT_MARKER_KEY(in.getMarker()));
+      return true;
+    }
+    if (in.isObject()) {
+      Json input = in.toJson(_trx, nullptr, false);
+      Json idJson = input.get(TRI_VOC_ATTRIBUTE_ID);
+      if (!idJson.isString()) {
+        idString.clear();
+      } else {
+        idString =
+            arangodb::basics::JsonHelper::getStringValue(idJson.json(), "");
+      }
+    } else if (in.isString()) {
+      idString = in.toString();
+    } else {
+      idString.clear();
+    }
+  }
+
+  if (idString.find('/') == std::string::npos) {
+    _engine->getQuery()->registerWarning(TRI_ERROR_BAD_PARAMETER,
+                                         "Invalid input for shortest path: "
+                                         "Only id strings or objects with "
+                                         "_id are allowed");
+    return false;
+  }
+
+  result = arangodb::traverser::IdStringToVertexId(_resolver, idString);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the edges of a vertex in all edge collections
+////////////////////////////////////////////////////////////////////////////////
+
+void ShortestPathBlock::expand(
+    VertexId const& source, bool backward,
+    std::function<void(EdgeCollectionInfo*, TRI_doc_mptr_copy_t&,
+                       VertexId&)> const& callback) {
+  std::equal_to<VertexId> eq;
+
+  for (size_t i = 0; i < _collectionInfos.size(); ++i) {
+    TRI_edge_direction_e direction = _directions[i];
+    if (backward) {
+      // the search from the target follows the edges in reverse
+      if (direction == TRI_EDGE_OUT) {
+        direction = TRI_EDGE_IN;
+      } else if (direction == TRI_EDGE_IN) {
+        direction = TRI_EDGE_OUT;
+      }
+    }
+
+    auto edges = _collectionInfos[i]->getEdges(direction, source);
+    _engine->_stats.scannedIndex += edges.size();
+
+    for (auto& edge : edges) {
+      VertexId from(TRI_EXTRACT_MARKER_FROM_CID(&edge),
+                    TRI_EXTRACT_MARKER_FROM_KEY(&edge));
+      VertexId to(TRI_EXTRACT_MARKER_TO_CID(&edge),
+                  TRI_EXTRACT_MARKER_TO_KEY(&edge));
+      // self-loops never shorten a path
+      if (!eq(from, source)) {
+        callback(_collectionInfos[i], edge, from);
+      } else if (!eq(to, source)) {
+        callback(_collectionInfos[i], edge, to);
+      }
+    }
+  }
+
+  throwIfKilled();  // check if we were aborted
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief expander for the weighted search
+////////////////////////////////////////////////////////////////////////////////
+
+ArangoDBPathFinder::ExpanderFunction ShortestPathBlock::weightedExpander(
+    bool backward, bool lightest) {
+  return [this, backward, lightest](
+      VertexId& v, std::vector<ArangoDBPathFinder::Step*>& result) {
+    std::unordered_map<VertexId, size_t> candidates;
+    expand(v, backward, [&](EdgeCollectionInfo* info,
+                            TRI_doc_mptr_copy_t& edge, VertexId& neighbor) {
+      double weight = info->weightEdge(edge);
+      if (lightest) {
+        auto cand = candidates.find(neighbor);
+        if (cand != candidates.end()) {
+          if (weight < result[cand->second]->weight()) {
+            result[cand->second]->setWeight(weight);
+            result[cand->second]->_edge = info->extractEdgeId(edge);
+          }
+          return;
+        }
+        candidates.emplace(neighbor, result.size());
+      }
+      result.emplace_back(new ArangoDBPathFinder::Step(
+          neighbor, v, weight, info->extractEdgeId(edge)));
+    });
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compute the shortest path for the current input row
+////////////////////////////////////////////////////////////////////////////////
+
+void ShortestPathBlock::computePath(AqlItemBlock const* items) {
+  freeCaches();
+  _kPaths.reset();
+  _pathComputed = true;
+
+  VertexId start;
+  VertexId target;
+  if (!getVertexId(items, _useStartRegister, _startReg, _startVertexId,
+                   start) ||
+      !getVertexId(items, _useTargetRegister, _targetReg, _targetVertexId,
+                   target)) {
+    return;
+  }
+
+  if (_pathVar != nullptr) {
+    // the k shortest paths are computed on demand. they keep parallel edges
+    // apart, so the expanders report all of them
+    _kPaths.reset(new ArangoDBKShortestPathsFinder(
+        weightedExpander(false, false), weightedExpander(true, false), start,
+        target));
+    return;
+  }
+
+  if (_useWeight) {
+    // the search runs bidirectional, but on this thread only, as the
+    // transaction must not be used concurrently
+    ArangoDBPathFinder finder(weightedExpander(false, true),
+                              weightedExpander(true, true), true);
+    std::unique_ptr<ArangoDBPathFinder::Path> path(
+        finder.shortestPath(start, target));
+    if (path != nullptr) {
+      addPath(path->vertices, path->edges);
+    }
+  } else {
+    auto expander = [this](bool backward) {
+      return [this, backward](VertexId& v, std::vector<EdgeId>& edges,
+                              std::vector<VertexId>& neighbors) {
+        // the finder only looks at the neighbors of v
+        edges.clear();
+        neighbors.clear();
+        expand(v, backward, [&](EdgeCollectionInfo* info,
+                                TRI_doc_mptr_copy_t& edge, VertexId& neighbor) {
+          edges.emplace_back(info->extractEdgeId(edge));
+          neighbors.emplace_back(neighbor);
+        });
+      };
+    };
+
+    ArangoDBConstDistancePathFinder finder(expander(false), expander(true));
+    std::unique_ptr<ArangoDBConstDistancePathFinder::Path> path(
+        finder.search(start, target));
+    if (path != nullptr) {
+      addPath(path->vertices, path->edges);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compute further paths for K_SHORTEST_PATHS
+////////////////////////////////////////////////////////////////////////////////
+
+bool ShortestPathBlock::morePaths(size_t hint) {
+  freeCaches();
+  if (_kPaths == nullptr) {
+    return false;
+  }
+
+  for (size_t j = 0; j < hint; ++j) {
+    auto path = _kPaths->next();
+    if (path == nullptr) {
+      // There are no further paths available.
+      _kPaths.reset();
+      break;
+    }
+    _paths.emplace_back(pathToJson(path));
+
+    throwIfKilled();  // check if we were aborted
+  }
+
+  return !_paths.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief turn the vertices and edges of a path into output values
+////////////////////////////////////////////////////////////////////////////////
+
+void ShortestPathBlock::addPath(std::deque<VertexId> const& vertices,
+                                std::deque<EdgeId> const& edges) {
+  TRI_ASSERT(vertices.size() == edges.size() + 1);
+
+  _vertices.reserve(vertices.size());
+  _edges.reserve(vertices.size());
+
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    _vertices.emplace_back(documentToJson(vertices[i]));
+
+    if (_edgeVar != nullptr) {
+      if (i == 0) {
+        _edges.emplace_back(new Json(Json::Null));
+      } else {
+        _edges.emplace_back(documentToJson(edges[i - 1]));
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief turn a path into an object with its vertices, edges and weight
+////////////////////////////////////////////////////////////////////////////////
+
+Json* ShortestPathBlock::pathToJson(
+    ArangoDBKShortestPathsFinder::Path const* path) {
+  auto result = std::make_unique<Json>(Json::Object, 3);
+  Json vertices(Json::Array, path->vertices.size());
+  for (auto const& vertex : path->vertices) {
+    std::unique_ptr<Json> v(documentToJson(vertex));
+    vertices(*v);
+  }
+  Json edges(Json::Array, path->edges.size());
+  for (auto const& edge : path->edges) {
+    std::unique_ptr<Json> e(documentToJson(edge));
+    edges(*e);
+  }
+  (*result)("vertices", vertices)("edges", edges)("weight", Json(path->weight));
+
+  return result.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read a vertex or an edge document
+////////////////////////////////////////////////////////////////////////////////
+
+Json* ShortestPathBlock::documentToJson(VertexId const& v) {
+  auto collection = _trx->trxCollection(v.cid);
+  if (collection == nullptr) {
+    int res = TRI_AddCollectionTransaction(_trx->getInternals(), v.cid,
+                                           TRI_TRANSACTION_READ,
+                                           _trx->nestingLevel(), true, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+
+    TRI_EnsureCollectionsTransaction(_trx->getInternals());
+    collection = _trx->trxCollection(v.cid);
+
+    if (collection == nullptr) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "collection is a nullptr");
+    }
+
+    _trx->orderDitch(collection);
+  }
+
+  TRI_doc_mptr_copy_t mptr;
+  int res = _trx->readSingle(collection, &mptr, v.key);
+  ++_engine->_stats.scannedIndex;
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    if (res == TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
+      return new Json(Json::Null);
+    }
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  return new Json(
+      TRI_ExpandShapedJson(collection->_collection->_collection->getShaper(),
+                           _resolver, v.cid, &mptr));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief move on to the next input row
+////////////////////////////////////////////////////////////////////////////////
+
+void ShortestPathBlock::nextRow() {
+  freeCaches();
+  _kPaths.reset();
+  _pathComputed = false;
+
+  AqlItemBlock* cur = _buffer.front();
+  if (++_pos >= cur->size()) {
+    _buffer.pop_front();  // does not throw
+    delete cur;
+    _pos = 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief make sure there is a path with rows left for the current input row
+////////////////////////////////////////////////////////////////////////////////
+
+bool ShortestPathBlock::preparePath(size_t hint) {
+  while (true) {
+    if (_buffer.empty()) {
+      size_t toFetch = DefaultBatchSize;
+      if (!ExecutionBlock::getBlock(toFetch, toFetch)) {
+        _done = true;
+        return false;
+      }
+      _pos = 0;  // this is in the first block
+    }
+
+    if (!_pathComputed) {
+      computePath(_buffer.front());
+    }
+
+    if (_posInPath < rows()) {
+      return true;
+    }
+
+    if (_pathVar != nullptr && morePaths(hint)) {
+      return true;
+    }
+
+    // no (more) path for this input row. maybe the next one has one.
+    nextRow();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getSome
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* ShortestPathBlock::getSome(size_t,  // atLeast,
+                                         size_t atMost) {
+  if (_done) {
+    return nullptr;
+  }
+
+  if (!preparePath(atMost)) {
+    return nullptr;
+  }
+
+  // If we get here, we do have _buffer.front()
+  AqlItemBlock* cur = _buffer.front();
+  size_t const curRegs = cur->getNrRegs();
+
+  size_t available = rows() - _posInPath;
+  size_t toSend = (std::min)(atMost, available);
+
+  RegisterId nrRegs =
+      getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()];
+
+  std::unique_ptr<AqlItemBlock> res(requestBlock(toSend, nrRegs));
+  // automatically freed if we throw
+  TRI_ASSERT(curRegs <= res->getNrRegs());
+
+  // only copy 1st row of registers inherited from previous frame(s)
+  inheritRegisters(cur, res.get(), _pos);
+
+  for (size_t j = 0; j < toSend; j++) {
+    if (j > 0) {
+      // re-use already copied aqlvalues
+      for (RegisterId i = 0; i < curRegs; i++) {
+        res->setValue(j, i, res->getValueReference(0, i));
+        // Note: if this throws, then all values will be deleted
+        // properly since the first one is.
+      }
+    }
+    if (_vertexVar != nullptr) {
+      res->setValue(j, _vertexReg, _vertices[_posInPath].clone());
+    }
+    if (_edgeVar != nullptr) {
+      res->setValue(j, _edgeReg, _edges[_posInPath].clone());
+    }
+    if (_pathVar != nullptr) {
+      res->setValue(j, _pathReg, _paths[_posInPath].clone());
+    }
+    ++_posInPath;
+  }
+
+  if (_pathVar == nullptr && _posInPath >= _vertices.size()) {
+    // the path of this input row is exhausted
+    nextRow();
+  }
+
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+  return res.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skipSome
+////////////////////////////////////////////////////////////////////////////////
+
+size_t ShortestPathBlock::skipSome(size_t atLeast, size_t atMost) {
+  size_t skipped = 0;
+
+  while (skipped < atLeast && !_done) {
+    if (!preparePath(atMost - skipped)) {
+      break;
+    }
+
+    size_t available = rows() - _posInPath;
+    size_t toSkip = (std::min)(atMost - skipped, available);
+    _posInPath += toSkip;
+    skipped += toSkip;
+
+    if (_pathVar == nullptr && _posInPath >= _vertices.size()) {
+      nextRow();
+    }
+  }
+
+  return skipped;
+}
@@ -0,0 +1,288 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_SHORTEST_PATH_BLOCK_H
+#define ARANGOD_AQL_SHORTEST_PATH_BLOCK_H 1
+
+#include "Aql/ExecutionBlock.h"
+#include "Aql/ShortestPathNode.h"
+#include "V8Server/V8Traverser.h"
+
+namespace arangodb {
+namespace aql {
+
+class ShortestPathBlock : public ExecutionBlock {
+ public:
+  ShortestPathBlock(ExecutionEngine* engine, ShortestPathNode const* ep);
+
+  ~ShortestPathBlock();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief initialize, here we fetch the output registers
+  //////////////////////////////////////////////////////////////////////////////
+
+  int initialize() override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief initializeCursor
+  //////////////////////////////////////////////////////////////////////////////
+
+  int initializeCursor(AqlItemBlock* items, size_t pos) override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief getSome
+  //////////////////////////////////////////////////////////////////////////////
+
+  AqlItemBlock* getSome(size_t atLeast, size_t atMost) override final;
+
+  //////////////////////////////////////////////////////////////////////////////
+  // skip between atLeast and atMost, returns the number actually skipped . . .
+  // will only return less than atLeast if there aren't atLeast many
+  // things to skip overall.
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t skipSome(size_t atLeast, size_t atMost) override final;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief free the vertices and edges of the current path
+  //////////////////////////////////////////////////////////////////////////////
+
+  void freeCaches();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief make sure the path of the current input row is computed and has
+  /// rows left. moves on to the next input row as long as this is not the
+  /// case. returns false if there is no more input. hint is the number of
+  /// paths to compute at once for K_SHORTEST_PATHS
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool preparePath(size_t hint);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of rows computed for the current input row
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t rows() const {
+    return _pathVar != nullptr ? _paths.size() : _vertices.size();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compute up to hint further paths of the current input row, for
+  /// K_SHORTEST_PATHS. returns false if there are none
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool morePaths(size_t hint);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief move on to the next input row
+  //////////////////////////////////////////////////////////////////////////////
+
+  void nextRow();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compute the shortest path for the current input row, or set up
+  /// the enumeration of its k shortest paths
+  //////////////////////////////////////////////////////////////////////////////
+
+  void computePath(AqlItemBlock const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief read the start or target vertex from a register or the constant
+  /// of the node. returns false and registers a warning for invalid input
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool getVertexId(AqlItemBlock const*, bool useRegister, RegisterId,
+                   std::string&, arangodb::traverser::VertexId&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief look up the edges of a vertex in all edge collections and invoke
+  /// the callback with the collection, the edge and the neighbor. backward
+  /// follows the edges in reverse direction, for the search from the target
+  //////////////////////////////////////////////////////////////////////////////
+
+  void expand(arangodb::traverser::VertexId const&, bool backward,
+              std::function<void(EdgeCollectionInfo*,
+                                 TRI_doc_mptr_copy_t&,
+                                 arangodb::traverser::VertexId&)> const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief expander for the weighted search. if lightest is set, only the
+  /// lightest edge to every neighbor is reported
+  //////////////////////////////////////////////////////////////////////////////
+
+  ArangoDBPathFinder::ExpanderFunction weightedExpander(bool backward,
+                                                        bool lightest);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief turn the vertices and edges of a path into output values
+  //////////////////////////////////////////////////////////////////////////////
+
+  void addPath(std::deque<arangodb::traverser::VertexId> const&,
+               std::deque<arangodb::traverser::EdgeId> const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief turn a path into an object with its vertices, edges and weight
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::basics::Json* pathToJson(ArangoDBKShortestPathsFinder::Path const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief read a vertex or an edge document, null if it does not exist
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::basics::Json* documentToJson(
+      arangodb::traverser::VertexId const&);
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the edge collections, in the order of the node
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<EdgeCollectionInfo*> _collectionInfos;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the direction edges are followed from the start vertex, one per
+  /// edge collection
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<TRI_edge_direction_e> _directions;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not edges are weighted. unweighted searches count the
+  /// edges with a breadth-first search instead of Dijkstra's algorithm
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _useWeight;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief vertices of the current path
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<arangodb::aql::AqlValue> _vertices;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief edges of the current path, the edge leading to each vertex. null
+  /// for the start vertex
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<arangodb::aql::AqlValue> _edges;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief paths computed for K_SHORTEST_PATHS
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<arangodb::aql::AqlValue> _paths;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief enumerates the paths of the current input row for
+  /// K_SHORTEST_PATHS. only computes as many paths as are requested
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unique_ptr<ArangoDBKShortestPathsFinder> _kPaths;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief current position in _vertices and _edges, or in _paths
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _posInPath;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the path of the current input row was computed
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _pathComputed;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief start vertex register, only used if _useStartRegister is set
+  //////////////////////////////////////////////////////////////////////////////
+
+  RegisterId _startReg;
+
+  bool _useStartRegister;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the _id of the start vertex. the key of the start vertex points
+  /// into this string
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::string _startVertexId;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief target vertex register, only used if _useTargetRegister is set
+  //////////////////////////////////////////////////////////////////////////////
+
+  RegisterId _targetReg;
+
+  bool _useTargetRegister;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the _id of the target vertex. the key of the target vertex
+  /// points into this string
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::string _targetVertexId;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Variable for the vertex output
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* _vertexVar;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Register for the vertex output
+  //////////////////////////////////////////////////////////////////////////////
+
+  RegisterId _vertexReg;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Variable for the edge output
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* _edgeVar;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Register for the edge output
+  //////////////////////////////////////////////////////////////////////////////
+
+  RegisterId _edgeReg;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Variable for the path output, only set for K_SHORTEST_PATHS
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* _pathVar;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Register for the path output
+  //////////////////////////////////////////////////////////////////////////////
+
+  RegisterId _pathReg;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief A collection name resolver required to identify vertex collections
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::CollectionNameResolver* _resolver;
+};
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -0,0 +1,507 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ShortestPathNode.h"
+#include "Aql/Ast.h"
+#include "Aql/Collection.h"
+#include "Aql/ExecutionPlan.h"
+#include "Aql/Index.h"
+#include "Utils/CollectionNameResolver.h"
+
+#include <cmath>
+
+using namespace arangodb::basics;
+using namespace arangodb::aql;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of edges a shortest path is assumed to have when estimating
+/// the costs
+////////////////////////////////////////////////////////////////////////////////
+
+static double const ExpectedPathLength = 6.0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of paths K_SHORTEST_PATHS is assumed to produce when
+/// estimating the costs
+////////////////////////////////////////////////////////////////////////////////
+
+static double const ExpectedNumberOfPaths = 10.0;
+
+static TRI_edge_direction_e parseDirection(uint64_t dirNum) {
+  switch (dirNum) {
+    case 0:
+      return TRI_EDGE_ANY;
+    case 1:
+      return TRI_EDGE_IN;
+    case 2:
+      return TRI_EDGE_OUT;
+    default:
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_QUERY_PARSE,
+          "direction can only be INBOUND, OUTBOUND or ANY");
+  }
+}
+
+static TRI_edge_direction_e parseDirection(AstNode const* node) {
+  TRI_ASSERT(node->isIntValue());
+  return parseDirection(static_cast<uint64_t>(node->getIntValue()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse a start or target vertex, which is either a variable or an
+/// _id string
+////////////////////////////////////////////////////////////////////////////////
+
+static void parseVertex(AstNode const* node, Variable const*& variable,
+                        std::string& vertexId, char const* name) {
+  switch (node->type) {
+    case NODE_TYPE_REFERENCE:
+      variable = static_cast<Variable*>(node->getData());
+      vertexId = "";
+      break;
+    case NODE_TYPE_VALUE:
+      if (node->value.type == VALUE_TYPE_STRING) {
+        variable = nullptr;
+        vertexId = std::string(node->getStringValue(), node->getStringLength());
+        break;
+      }
+    // fall-through intentional
+    default:
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_PARSE,
+                                     std::string("invalid ") + name +
+                                         " vertex. Must either be an _id "
+                                         "string or an object with _id.");
+  }
+}
+
+ShortestPathNode::ShortestPathNode(ExecutionPlan* plan, size_t id,
+                                   TRI_vocbase_t* vocbase,
+                                   AstNode const* direction,
+                                   AstNode const* start, AstNode const* target,
+                                   AstNode const* graph,
+                                   AstNode const* options)
+    : ExecutionNode(plan, id),
+      _vocbase(vocbase),
+      _vertexOutVariable(nullptr),
+      _edgeOutVariable(nullptr),
+      _pathOutVariable(nullptr),
+      _inStartVariable(nullptr),
+      _inTargetVariable(nullptr),
+      _graphObj(nullptr),
+      _defaultWeight(1.0) {
+  TRI_ASSERT(_vocbase != nullptr);
+  TRI_ASSERT(direction != nullptr);
+  TRI_ASSERT(start != nullptr);
+  TRI_ASSERT(target != nullptr);
+  TRI_ASSERT(graph != nullptr);
+  auto resolver = std::make_unique<CollectionNameResolver>(vocbase);
+
+  TRI_edge_direction_e baseDirection = parseDirection(direction);
+
+  if (graph->type == NODE_TYPE_COLLECTION_LIST) {
+    size_t edgeCollectionCount = graph->numMembers();
+    _graphJson = arangodb::basics::Json(arangodb::basics::Json::Array,
+                                        edgeCollectionCount);
+    _edgeColls.reserve(edgeCollectionCount);
+    _directions.reserve(edgeCollectionCount);
+    // List of edge collection names
+    for (size_t i = 0; i < edgeCollectionCount; ++i) {
+      auto col = graph->getMember(i);
+      if (col->type == NODE_TYPE_DIRECTION) {
+        // We have a collection with special direction.
+        _directions.emplace_back(parseDirection(col->getMember(0)));
+        col = col->getMember(1);
+      } else {
+        _directions.emplace_back(baseDirection);
+      }
+
+      std::string eColName = col->getStringValue();
+      auto eColType = resolver->getCollectionTypeCluster(eColName);
+      if (eColType != TRI_COL_TYPE_EDGE) {
+        std::string msg("collection type invalid for collection '" +
+                        std::string(eColName) +
+                        ": expecting collection type 'edge'");
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_ARANGO_COLLECTION_TYPE_INVALID,
+                                       msg);
+      }
+      _graphJson.add(arangodb::basics::Json(eColName));
+      _edgeColls.push_back(eColName);
+    }
+  } else if (graph->isStringValue()) {
+    std::string graphName = graph->getStringValue();
+    _graphJson = arangodb::basics::Json(graphName);
+    _graphObj = plan->getAst()->query()->lookupGraphByName(graphName);
+
+    if (_graphObj == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_GRAPH_NOT_FOUND);
+    }
+
+    auto eColls = _graphObj->edgeCollections();
+    if (eColls.empty()) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_GRAPH_EMPTY);
+    }
+    _edgeColls.reserve(eColls.size());
+    _directions.reserve(eColls.size());
+
+    for (auto const& n : eColls) {
+      _edgeColls.push_back(n);
+      _directions.emplace_back(baseDirection);
+    }
+  }
+
+  parseVertex(start, _inStartVariable, _startVertexId, "start");
+  parseVertex(target, _inTargetVariable, _targetVertexId, "target");
+
+  // Parse options
+  if (options != nullptr && options->type == NODE_TYPE_OBJECT) {
+    size_t n = options->numMembers();
+
+    for (size_t i = 0; i < n; ++i) {
+      auto member = options->getMember(i);
+
+      if (member != nullptr && member->type == NODE_TYPE_OBJECT_ELEMENT) {
+        auto name = member->getStringValue();
+        auto value = member->getMember(0);
+
+        TRI_ASSERT(value->isConstant());
+
+        if (strcmp(name, "weightAttribute") == 0 && value->isStringValue()) {
+          _weightAttribute =
+              std::string(value->getStringValue(), value->getStringLength());
+        } else if (strcmp(name, "defaultWeight") == 0 &&
+                   value->isNumericValue()) {
+          _defaultWeight = value->getDoubleValue();
+        }
+      }
+    }
+  }
+
+  if (usesWeight() && _defaultWeight < 0.0) {
+    // Dijkstra's algorithm cannot handle negative weights
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_PARSE,
+                                   "shortest path option 'defaultWeight' must "
+                                   "not be negative");
+  }
+}
+
+ShortestPathNode::ShortestPathNode(
+    ExecutionPlan* plan, size_t id, TRI_vocbase_t* vocbase,
+    std::vector<std::string> const& edgeColls,
+    std::vector<TRI_edge_direction_e> const& directions,
+    Variable const* inStartVariable, std::string const& startVertexId,
+    Variable const* inTargetVariable, std::string const& targetVertexId,
+    arangodb::basics::Json const& graphJson, Graph const* graphObj)
+    : ExecutionNode(plan, id),
+      _vocbase(vocbase),
+      _vertexOutVariable(nullptr),
+      _edgeOutVariable(nullptr),
+      _pathOutVariable(nullptr),
+      _inStartVariable(inStartVariable),
+      _startVertexId(startVertexId),
+      _inTargetVariable(inTargetVariable),
+      _targetVertexId(targetVertexId),
+      _graphJson(graphJson.copy()),
+      _directions(directions),
+      _edgeColls(edgeColls),
+      _graphObj(graphObj),
+      _defaultWeight(1.0) {}
+
+ShortestPathNode::ShortestPathNode(ExecutionPlan* plan,
+                                   arangodb::basics::Json const& base)
+    : ExecutionNode(plan, base),
+      _vocbase(plan->getAst()->query()->vocbase()),
+      _vertexOutVariable(nullptr),
+      _edgeOutVariable(nullptr),
+      _pathOutVariable(nullptr),
+      _inStartVariable(nullptr),
+      _inTargetVariable(nullptr),
+      _graphObj(nullptr),
+      _defaultWeight(1.0) {
+  auto dirList = base.get("directions");
+  TRI_ASSERT(dirList.json() != nullptr);
+  for (size_t i = 0; i < dirList.size(); ++i) {
+    auto dirJson = dirList.at(i);
+    _directions.emplace_back(
+        parseDirection(JsonHelper::stringUInt64(dirJson.json())));
+  }
+
+  // Start and target vertex
+  if (base.has("startInVariable")) {
+    _inStartVariable = varFromJson(plan->getAst(), base, "startInVariable");
+  } else {
+    _startVertexId =
+        JsonHelper::getStringValue(base.json(), "startVertexId", "");
+    if (_startVertexId.empty()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_BAD_JSON_PLAN,
+                                     "start vertex mustn't be empty.");
+    }
+  }
+
+  if (base.has("targetInVariable")) {
+    _inTargetVariable = varFromJson(plan->getAst(), base, "targetInVariable");
+  } else {
+    _targetVertexId =
+        JsonHelper::getStringValue(base.json(), "targetVertexId", "");
+    if (_targetVertexId.empty()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_BAD_JSON_PLAN,
+                                     "target vertex mustn't be empty.");
+    }
+  }
+
+  if (base.has("graph") && base.get("graph").isString()) {
+    std::string graphName =
+        JsonHelper::checkAndGetStringValue(base.json(), "graph");
+    _graphJson = arangodb::basics::Json(graphName);
+    if (!base.has("graphDefinition")) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_BAD_JSON_PLAN,
+                                     "missing graphDefinition.");
+    }
+    _graphObj = plan->getAst()->query()->lookupGraphByName(graphName);
+
+    if (_graphObj == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_GRAPH_NOT_FOUND);
+    }
+
+    for (auto const& n : _graphObj->edgeCollections()) {
+      _edgeColls.push_back(n);
+    }
+  } else {
+    _graphJson = base.get("graph").copy();
+    if (!_graphJson.isArray()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_BAD_JSON_PLAN,
+                                     "graph has to be an array.");
+    }
+    size_t edgeCollectionCount = _graphJson.size();
+    // List of edge collection names
+    for (size_t i = 0; i < edgeCollectionCount; ++i) {
+      auto at = _graphJson.at(i);
+      if (!at.isString()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_BAD_JSON_PLAN,
+                                       "graph has to be an array of strings.");
+      }
+      _edgeColls.push_back(at.json()->_value._string.data);
+    }
+    if (_edgeColls.empty()) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_QUERY_BAD_JSON_PLAN,
+          "graph has to be a non empty array of strings.");
+    }
+  }
+
+  if (_directions.size() != _edgeColls.size()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_BAD_JSON_PLAN,
+                                   "expecting one direction per edge "
+                                   "collection.");
+  }
+
+  if (base.has("options")) {
+    auto options = base.get("options");
+    _weightAttribute =
+        JsonHelper::getStringValue(options.json(), "weightAttribute", "");
+    _defaultWeight =
+        JsonHelper::getNumericValue<double>(options.json(), "defaultWeight", 1.0);
+  }
+
+  // Out variables
+  if (base.has("vertexOutVariable")) {
+    _vertexOutVariable = varFromJson(plan->getAst(), base, "vertexOutVariable");
+  }
+  if (base.has("edgeOutVariable")) {
+    _edgeOutVariable = varFromJson(plan->getAst(), base, "edgeOutVariable");
+  }
+  if (base.has("pathOutVariable")) {
+    _pathOutVariable = varFromJson(plan->getAst(), base, "pathOutVariable");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toVelocyPack, for ShortestPathNode
+////////////////////////////////////////////////////////////////////////////////
+
+void ShortestPathNode::toVelocyPackHelper(arangodb::velocypack::Builder& nodes,
+                                          bool verbose) const {
+  ExecutionNode::toVelocyPackHelperGeneric(nodes,
+                                           verbose);  // call base class method
+
+  nodes.add("database", VPackValue(_vocbase->_name));
+
+  {
+    auto tmp = arangodb::basics::JsonHelper::toVelocyPack(_graphJson.json());
+    nodes.add("graph", tmp->slice());
+  }
+  nodes.add(VPackValue("directions"));
+  {
+    VPackArrayBuilder guard(&nodes);
+    for (auto const& d : _directions) {
+      nodes.add(VPackValue(d));
+    }
+  }
+
+  if (_graphObj != nullptr) {
+    nodes.add(VPackValue("graphDefinition"));
+    _graphObj->toVelocyPack(nodes, verbose);
+  }
+
+  // In variables
+  if (usesStartInVariable()) {
+    nodes.add(VPackValue("startInVariable"));
+    startInVariable()->toVelocyPack(nodes);
+  } else {
+    nodes.add("startVertexId", VPackValue(_startVertexId));
+  }
+
+  if (usesTargetInVariable()) {
+    nodes.add(VPackValue("targetInVariable"));
+    targetInVariable()->toVelocyPack(nodes);
+  } else {
+    nodes.add("targetVertexId", VPackValue(_targetVertexId));
+  }
+
+  nodes.add(VPackValue("options"));
+  {
+    VPackObjectBuilder guard(&nodes);
+    nodes.add("weightAttribute", VPackValue(_weightAttribute));
+    nodes.add("defaultWeight", VPackValue(_defaultWeight));
+  }
+
+  // Out variables
+  if (usesVertexOutVariable()) {
+    nodes.add(VPackValue("vertexOutVariable"));
+    vertexOutVariable()->toVelocyPack(nodes);
+  }
+  if (usesEdgeOutVariable()) {
+    nodes.add(VPackValue("edgeOutVariable"));
+    edgeOutVariable()->toVelocyPack(nodes);
+  }
+  if (usesPathOutVariable()) {
+    nodes.add(VPackValue("pathOutVariable"));
+    pathOutVariable()->toVelocyPack(nodes);
+  }
+
+  // And close it:
+  nodes.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* ShortestPathNode::clone(ExecutionPlan* plan,
+                                       bool withDependencies,
+                                       bool withProperties) const {
+  auto c = new ShortestPathNode(plan, _id, _vocbase, _edgeColls, _directions,
+                                _inStartVariable, _startVertexId,
+                                _inTargetVariable, _targetVertexId,
+                                _graphJson, _graphObj);
+  c->_weightAttribute = _weightAttribute;
+  c->_defaultWeight = _defaultWeight;
+
+  if (usesVertexOutVariable()) {
+    auto vertexOutVariable = _vertexOutVariable;
+    if (withProperties) {
+      vertexOutVariable =
+          plan->getAst()->variables()->createVariable(vertexOutVariable);
+    }
+    TRI_ASSERT(vertexOutVariable != nullptr);
+    c->setVertexOutput(vertexOutVariable);
+  }
+
+  if (usesEdgeOutVariable()) {
+    auto edgeOutVariable = _edgeOutVariable;
+    if (withProperties) {
+      edgeOutVariable =
+          plan->getAst()->variables()->createVariable(edgeOutVariable);
+    }
+    TRI_ASSERT(edgeOutVariable != nullptr);
+    c->setEdgeOutput(edgeOutVariable);
+  }
+
+  if (usesPathOutVariable()) {
+    auto pathOutVariable = _pathOutVariable;
+    if (withProperties) {
+      pathOutVariable =
+          plan->getAst()->variables()->createVariable(pathOutVariable);
+    }
+    TRI_ASSERT(pathOutVariable != nullptr);
+    c->setPathOutput(pathOutVariable);
+  }
+
+  cloneHelper(c, plan, withDependencies, withProperties);
+
+  return static_cast<ExecutionNode*>(c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a shortest path node
+////////////////////////////////////////////////////////////////////////////////
+
+double ShortestPathNode::estimateCost(size_t& nrItems) const {
+  size_t incoming = 0;
+  double depCost = _dependencies.at(0)->getCost(incoming);
+  double expectedEdgesPerDepth = 0.0;
+  double numberEdges = 0.0;
+  auto collections = _plan->getAst()->query()->collections();
+
+  TRI_ASSERT(collections != nullptr);
+
+  for (auto const& it : _edgeColls) {
+    auto collection = collections->get(it);
+
+    if (collection == nullptr) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "unexpected pointer for collection");
+    }
+
+    numberEdges += static_cast<double>(collection->count());
+
+    for (auto const& index : collection->getIndexes()) {
+      if (index->type == arangodb::Index::IndexType::TRI_IDX_TYPE_EDGE_INDEX) {
+        // We can only use Edge Index
+        if (index->hasSelectivityEstimate()) {
+          expectedEdgesPerDepth += 1 / index->selectivityEstimate();
+        } else {
+          expectedEdgesPerDepth += 1000;  // Hard-coded
+        }
+        break;
+      }
+    }
+  }
+
+  // the bidirectional search expands around the start and the target vertex
+  // until both searches meet in the middle of the path. it does not read an
+  // edge more than once per direction
+  double expectedEdges =
+      2.0 * std::pow(expectedEdgesPerDepth, ExpectedPathLength / 2.0);
+  expectedEdges = (std::min)(expectedEdges, 2.0 * numberEdges);
+
+  double searches = 1.0;
+  if (usesPathOutVariable()) {
+    // one row per path. every path after the first one needs a search from
+    // every vertex of the path before
+    nrItems = static_cast<size_t>(incoming * ExpectedNumberOfPaths);
+    searches += (ExpectedNumberOfPaths - 1.0) * ExpectedPathLength;
+  } else {
+    nrItems = static_cast<size_t>(incoming * (ExpectedPathLength + 1.0));
+  }
+  if (nrItems == 0 && incoming > 0) {
+    nrItems = 1;  // min value
+  }
+  return depCost + incoming * searches * expectedEdges + nrItems;
+}
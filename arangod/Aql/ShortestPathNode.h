@@ -0,0 +1,341 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_SHORTEST_PATH_NODE_H
+#define ARANGOD_AQL_SHORTEST_PATH_NODE_H 1
+
+#include "Aql/ExecutionNode.h"
+#include "Aql/Graphs.h"
+#include "VocBase/edge-collection.h"
+
+namespace arangodb {
+namespace aql {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief class ShortestPathNode, computes the shortest path between a start
+/// and a target vertex and produces one row per vertex on that path. With a
+/// path out variable (K_SHORTEST_PATHS), it produces one row per loopless
+/// path instead, in the order of increasing weight
+////////////////////////////////////////////////////////////////////////////////
+
+class ShortestPathNode : public ExecutionNode {
+  friend class ExecutionBlock;
+  friend class ShortestPathBlock;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief constructor with a vocbase and a collection name
+  //////////////////////////////////////////////////////////////////////////////
+
+ public:
+  ShortestPathNode(ExecutionPlan* plan, size_t id, TRI_vocbase_t* vocbase,
+                   AstNode const* direction, AstNode const* start,
+                   AstNode const* target, AstNode const* graph,
+                   AstNode const* options);
+
+  ShortestPathNode(ExecutionPlan* plan, arangodb::basics::Json const& base);
+
+  ~ShortestPathNode() {}
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Internal constructor to clone the node.
+  //////////////////////////////////////////////////////////////////////////////
+
+ private:
+  ShortestPathNode(ExecutionPlan* plan, size_t id, TRI_vocbase_t* vocbase,
+                   std::vector<std::string> const& edgeColls,
+                   std::vector<TRI_edge_direction_e> const& directions,
+                   Variable const* inStartVariable,
+                   std::string const& startVertexId,
+                   Variable const* inTargetVariable,
+                   std::string const& targetVertexId,
+                   arangodb::basics::Json const& graphJson,
+                   Graph const* graphObj);
+
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the type of the node
+  //////////////////////////////////////////////////////////////////////////////
+
+  NodeType getType() const override final { return SHORTEST_PATH; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief export to VelocyPack
+  //////////////////////////////////////////////////////////////////////////////
+
+  void toVelocyPackHelper(arangodb::velocypack::Builder&,
+                          bool) const override final;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief clone ExecutionNode recursively
+  //////////////////////////////////////////////////////////////////////////////
+
+  ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
+                       bool withProperties) const override final;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the cost of a shortest path node
+  //////////////////////////////////////////////////////////////////////////////
+
+  double estimateCost(size_t&) const override final;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Test if this node uses an in variable or constant for start
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool usesStartInVariable() const { return _inStartVariable != nullptr; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Test if this node uses an in variable or constant for target
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool usesTargetInVariable() const { return _inTargetVariable != nullptr; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief getVariablesUsedHere
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<Variable const*> getVariablesUsedHere() const override final {
+    std::vector<Variable const*> vars;
+    if (usesStartInVariable()) {
+      vars.emplace_back(_inStartVariable);
+    }
+    if (usesTargetInVariable()) {
+      vars.emplace_back(_inTargetVariable);
+    }
+    return vars;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief getVariablesUsedHere
+  //////////////////////////////////////////////////////////////////////////////
+
+  void getVariablesUsedHere(
+      std::unordered_set<Variable const*>& result) const override final {
+    if (usesStartInVariable()) {
+      result.emplace(_inStartVariable);
+    }
+    if (usesTargetInVariable()) {
+      result.emplace(_inTargetVariable);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief getVariablesSetHere
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<Variable const*> getVariablesSetHere() const override final {
+    std::vector<Variable const*> vars;
+    if (_vertexOutVariable != nullptr) {
+      vars.emplace_back(_vertexOutVariable);
+    }
+    if (_edgeOutVariable != nullptr) {
+      vars.emplace_back(_edgeOutVariable);
+    }
+    if (_pathOutVariable != nullptr) {
+      vars.emplace_back(_pathOutVariable);
+    }
+    return vars;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the database
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_vocbase_t* vocbase() const { return _vocbase; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the vertex out variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* vertexOutVariable() const { return _vertexOutVariable; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief checks if the vertex out variable is used
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool usesVertexOutVariable() const { return _vertexOutVariable != nullptr; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the vertex out variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setVertexOutput(Variable const* outVar) { _vertexOutVariable = outVar; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the edge out variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* edgeOutVariable() const { return _edgeOutVariable; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief checks if the edge out variable is used
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool usesEdgeOutVariable() const { return _edgeOutVariable != nullptr; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the edge out variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setEdgeOutput(Variable const* outVar) { _edgeOutVariable = outVar; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the path out variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* pathOutVariable() const { return _pathOutVariable; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief checks if the path out variable is used, i.e. whether this node
+  /// enumerates the k shortest paths
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool usesPathOutVariable() const { return _pathOutVariable != nullptr; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set the path out variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setPathOutput(Variable const* outVar) { _pathOutVariable = outVar; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the start in variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* startInVariable() const { return _inStartVariable; }
+
+  std::string const getStartVertex() const { return _startVertexId; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the target in variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* targetInVariable() const { return _inTargetVariable; }
+
+  std::string const getTargetVertex() const { return _targetVertexId; }
+
+  std::vector<std::string> const& edgeColls() const { return _edgeColls; }
+
+  std::vector<TRI_edge_direction_e> const& directions() const {
+    return _directions;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the edges are weighted by an attribute
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool usesWeight() const { return !_weightAttribute.empty(); }
+
+  std::string const& weightAttribute() const { return _weightAttribute; }
+
+  double defaultWeight() const { return _defaultWeight; }
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the database
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_vocbase_t* _vocbase;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief vertex output variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* _vertexOutVariable;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief edge output variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* _edgeOutVariable;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief path output variable
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* _pathOutVariable;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief input variable only used if _startVertexId is unused
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* _inStartVariable;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief input vertexId only used if _inStartVariable is unused
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::string _startVertexId;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief input variable only used if _targetVertexId is unused
+  //////////////////////////////////////////////////////////////////////////////
+
+  Variable const* _inTargetVariable;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief input vertexId only used if _inTargetVariable is unused
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::string _targetVertexId;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief input graphJson only used for serialisation & info
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::basics::Json _graphJson;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief The directions edges are followed, one per edge collection
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<TRI_edge_direction_e> _directions;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the edge collection names
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::string> _edgeColls;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief our graph
+  //////////////////////////////////////////////////////////////////////////////
+
+  Graph const* _graphObj;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief edge attribute holding the weight (OPTIONS weightAttribute).
+  /// every edge counts 1 if empty
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::string _weightAttribute;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief weight of edges without a numeric weight attribute (OPTIONS
+  /// defaultWeight)
+  //////////////////////////////////////////////////////////////////////////////
+
+  double _defaultWeight;
+};
+
+}  // namespace arangodb::aql
+}  // namespace arangodb
+
+#endif
@@ -23,6 +23,7 @@
 
 #include "SortBlock.h"
 #include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
 #include "Basics/Exceptions.h"
 #include "VocBase/vocbase.h"
 
@@ -32,7 +33,12 @@ using Json = arangodb::basics::Json;
 using JsonHelper = arangodb::basics::JsonHelper;
 
 SortBlock::SortBlock(ExecutionEngine* engine, SortNode const* en)
-    : ExecutionBlock(engine, en), _sortRegisters(), _stable(en->_stable) {
+    : ExecutionBlock(engine, en),
+      _sortRegisters(),
+      _stable(en->_stable),
+      _limit(en->_limit),
+      _spillThreshold(engine->getQuery()->sortSpillThreshold()),
+      _mergeFanIn(engine->getQuery()->sortMergeFanIn()) {
   for (auto const& p : en->_elements) {
     auto it = en->getRegisterPlan()->varInfo.find(p.first->id);
     TRI_ASSERT(it != en->getRegisterPlan()->varInfo.end());
@@ -42,7 +48,7 @@ SortBlock::SortBlock(ExecutionEngine* engine, SortNode const* en)
   }
 }
 
-SortBlock::~SortBlock() {}
+SortBlock::~SortBlock() { clearRuns(); }
 
 int SortBlock::initialize() { return ExecutionBlock::initialize(); }
 
@@ -51,8 +57,43 @@ int SortBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
   if (res != TRI_ERROR_NO_ERROR) {
     return res;
   }
+
+  // remove runs left over from a previous cursor
+  clearRuns();
+
   // suck all blocks into _buffer
+  size_t rows = 0;
   while (getBlock(DefaultBatchSize, DefaultBatchSize)) {
+    rows += _buffer.back()->size();
+
+    // we only need to produce the top <_limit> rows. whenever the buffer
+    // has grown sufficiently beyond that, throw away all rows that cannot
+    // make it into the result anymore. growing the buffer to at least
+    // twice the limit before compacting keeps the amortized cost per row
+    // logarithmic in the limit
+    if (_limit > 0 && rows >= _limit + (std::max)(_limit, DefaultBatchSize)) {
+      doSorting();
+      rows = _limit;
+    }
+
+    // too many rows to keep them in memory: write them to disk as a
+    // sorted run, the runs will be merged at the end
+    if (_spillThreshold > 0 && rows >= _spillThreshold) {
+      spillRun();
+      rows = 0;
+    }
+  }
+
+  if (!_runs.empty()) {
+    if (!_buffer.empty()) {
+      spillRun();
+    }
+    startMerge();
+
+    _done = _mergeHeap.empty();
+    _pos = 0;
+
+    return TRI_ERROR_NO_ERROR;
   }
 
   if (_buffer.empty()) {
@@ -68,6 +109,54 @@ int SortBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
   return TRI_ERROR_NO_ERROR;
 }
 
+int SortBlock::shutdown(int errorCode) {
+  clearRuns();
+  return ExecutionBlock::shutdown(errorCode);
+}
+
+bool SortBlock::hasMore() {
+  if (_done) {
+    return false;
+  }
+  if (_buffer.empty() && !_runs.empty()) {
+    if (mergeNextBlock()) {
+      _pos = 0;
+      return true;
+    }
+    _done = true;
+    return false;
+  }
+  return ExecutionBlock::hasMore();
+}
+
+int64_t SortBlock::remaining() {
+  int64_t sum = ExecutionBlock::remaining();
+  for (auto const& run : _runs) {
+    sum += static_cast<int64_t>(run->rowsLeft);
+  }
+  return sum;
+}
+
+int SortBlock::getOrSkipSome(size_t atLeast, size_t atMost, bool skipping,
+                             AqlItemBlock*& result, size_t& skipped) {
+  if (!_done && !_runs.empty()) {
+    // when merging, make sure the base class finds all rows it may need
+    // in _buffer, so that it never turns to our (exhausted) dependency
+    size_t available = 0;
+    for (auto const& block : _buffer) {
+      available += block->size();
+    }
+    available -= _pos;
+
+    while (available < atMost && mergeNextBlock()) {
+      available += _buffer.back()->size();
+    }
+  }
+
+  return ExecutionBlock::getOrSkipSome(atLeast, atMost, skipping, result,
+                                       skipped);
+}
+
 void SortBlock::doSorting() {
   // coords[i][j] is the <j>th row of the <i>th block
   std::vector<std::pair<size_t, size_t>> coords;
@@ -102,7 +191,32 @@ void SortBlock::doSorting() {
   OurLessThan ourLessThan(_trx, _buffer, _sortRegisters, colls);
 
   // sort coords
-  if (_stable) {
+  if (_limit > 0 && _limit < sum) {
+    // we only need the first <_limit> rows: select them using a heap.
+    // note that the buffer contains the rows in input order (rows kept
+    // from a previous run come first), so falling back to the coordinates
+    // for equal rows makes the selection stable
+    if (_stable) {
+      std::partial_sort(
+          coords.begin(), coords.begin() + _limit, coords.end(),
+          [&ourLessThan](std::pair<size_t, size_t> const& a,
+                         std::pair<size_t, size_t> const& b) {
+            if (ourLessThan(a, b)) {
+              return true;
+            }
+            if (ourLessThan(b, a)) {
+              return false;
+            }
+            return a < b;
+          });
+    } else {
+      std::partial_sort(coords.begin(), coords.begin() + _limit, coords.end(),
+                        ourLessThan);
+    }
+    // the remaining rows are freed together with their original blocks
+    coords.resize(_limit);
+    sum = _limit;
+  } else if (_stable) {
     std::stable_sort(coords.begin(), coords.end(), ourLessThan);
   } else {
     std::sort(coords.begin(), coords.end(), ourLessThan);
@@ -121,7 +235,7 @@ void SortBlock::doSorting() {
 
     while (count < sum) {
       size_t sizeNext = (std::min)(sum - count, DefaultBatchSize);
-      AqlItemBlock* next = new AqlItemBlock(sizeNext, nrregs);
+      AqlItemBlock* next = requestBlock(sizeNext, nrregs);
 
       try {
         TRI_IF_FAILURE("SortBlock::doSortingInner") {
@@ -252,3 +366,267 @@ bool SortBlock::OurLessThan::operator()(std::pair<size_t, size_t> const& a,
 
   return false;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sort the rows in _buffer and write them to a new run file
+////////////////////////////////////////////////////////////////////////////////
+
+void SortBlock::spillRun() {
+  doSorting();
+
+  auto run = std::make_unique<SortedRun>();
+
+  for (auto const& block : _buffer) {
+    run->file.write(block, _trx);
+  }
+
+  _runs.emplace_back(run.get());
+  run.release();
+
+  for (auto& block : _buffer) {
+    delete block;
+  }
+  _buffer.clear();
+  _pos = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepare the k-way merge of all spilled runs. if there are more
+/// than _mergeFanIn runs, they are first merged into fewer runs
+////////////////////////////////////////////////////////////////////////////////
+
+void SortBlock::startMerge() {
+  while (_runs.size() > _mergeFanIn) {
+    // merge groups of consecutive runs, so that the runs stay in input order
+    // and the merge stays stable
+    std::vector<SortedRun*> merged;
+    merged.reserve(_runs.size() / _mergeFanIn + 1);
+
+    try {
+      for (size_t first = 0; first < _runs.size(); first += _mergeFanIn) {
+        size_t const last = (std::min)(first + _mergeFanIn, _runs.size());
+
+        if (last - first == 1) {
+          merged.emplace_back(_runs[first]);
+          _runs[first] = nullptr;
+          continue;
+        }
+
+        std::unique_ptr<SortedRun> run(mergeRuns(first, last));
+
+        for (size_t i = first; i < last; ++i) {
+          // removes the run's file
+          delete _runs[i];
+          _runs[i] = nullptr;
+        }
+        merged.emplace_back(run.get());
+        run.release();
+      }
+    } catch (...) {
+      for (auto& run : merged) {
+        delete run;
+      }
+      throw;
+    }
+
+    clearRuns();
+    _runs.swap(merged);
+  }
+
+  initMergeHeap(0, _runs.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up the merge heap for the runs [first, last)
+////////////////////////////////////////////////////////////////////////////////
+
+void SortBlock::initMergeHeap(size_t first, size_t last) {
+  _mergeHeap.clear();
+  _mergeHeap.reserve(last - first);
+
+  for (size_t i = first; i < last; ++i) {
+    auto run = _runs[i];
+    run->rewind();
+
+    if (run->next(_engine->getQuery()->resourceMonitor())) {
+      _mergeHeap.emplace_back(i);
+    }
+  }
+
+  std::make_heap(_mergeHeap.begin(), _mergeHeap.end(),
+                 [this](size_t a, size_t b) { return runComesAfter(a, b); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief merge the runs [first, last) into a new run
+////////////////////////////////////////////////////////////////////////////////
+
+SortBlock::SortedRun* SortBlock::mergeRuns(size_t first, size_t last) {
+  initMergeHeap(first, last);
+
+  size_t available = 0;
+  for (size_t i = first; i < last; ++i) {
+    available += _runs[i]->rowsLeft;
+  }
+
+  auto run = std::make_unique<SortedRun>();
+
+  while (!_mergeHeap.empty()) {
+    size_t const toSend = (std::min)(available, DefaultBatchSize);
+    RegisterId const nrRegs = _runs[_mergeHeap.front()]->current->getNrRegs();
+
+    std::unique_ptr<AqlItemBlock> res(requestBlock(toSend, nrRegs));
+    mergeRows(res.get(), toSend);
+    run->file.write(res.get(), _trx);
+    available -= toSend;
+
+    throwIfKilled();  // check if we were aborted
+  }
+
+  TRI_ASSERT(available == 0);
+  return run.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief merge the next batch of rows from the runs into _buffer, returns
+/// false if all runs are exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+bool SortBlock::mergeNextBlock() {
+  if (_mergeHeap.empty()) {
+    return false;
+  }
+
+  size_t available = 0;
+  for (auto const& run : _runs) {
+    available += run->rowsLeft;
+  }
+  TRI_ASSERT(available > 0);
+
+  size_t const toSend = (std::min)(available, DefaultBatchSize);
+  RegisterId const nrRegs = _runs[_mergeHeap.front()]->current->getNrRegs();
+
+  // note: all values read back from a run are JSON values, so the output
+  // block does not need any document collections
+  std::unique_ptr<AqlItemBlock> res(requestBlock(toSend, nrRegs));
+  mergeRows(res.get(), toSend);
+
+  _buffer.emplace_back(res.get());
+  res.release();
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief move the next <n> rows of the merge heap into <res>
+////////////////////////////////////////////////////////////////////////////////
+
+void SortBlock::mergeRows(AqlItemBlock* res, size_t n) {
+  RegisterId const nrRegs = res->getNrRegs();
+  auto comparator = [this](size_t a, size_t b) { return runComesAfter(a, b); };
+
+  for (size_t i = 0; i < n; ++i) {
+    TRI_ASSERT(!_mergeHeap.empty());
+
+    // move the run with the smallest current row to the back
+    std::pop_heap(_mergeHeap.begin(), _mergeHeap.end(), comparator);
+    auto run = _runs[_mergeHeap.back()];
+
+    for (RegisterId j = 0; j < nrRegs; j++) {
+      AqlValue const& a = run->current->getValueReference(run->pos, j);
+
+      if (!a.isEmpty()) {
+        AqlValue b = a.clone();
+        try {
+          res->setValue(i, j, b);
+        } catch (...) {
+          b.destroy();
+          throw;
+        }
+      }
+    }
+
+    --run->rowsLeft;
+
+    if (run->next(_engine->getQuery()->resourceMonitor())) {
+      std::push_heap(_mergeHeap.begin(), _mergeHeap.end(), comparator);
+    } else {
+      _mergeHeap.pop_back();
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief close and remove all run files
+////////////////////////////////////////////////////////////////////////////////
+
+void SortBlock::clearRuns() {
+  for (auto& run : _runs) {
+    delete run;
+  }
+  _runs.clear();
+  _mergeHeap.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether the current row of run <a> must be produced after the
+/// current row of run <b>, used for the merge heap
+////////////////////////////////////////////////////////////////////////////////
+
+bool SortBlock::runComesAfter(size_t a, size_t b) const {
+  auto const& runA = _runs[a];
+  auto const& runB = _runs[b];
+
+  for (auto const& reg : _sortRegisters) {
+    int cmp = AqlValue::Compare(
+        _trx, runA->current->getValueReference(runA->pos, reg.first), nullptr,
+        runB->current->getValueReference(runB->pos, reg.first), nullptr, true);
+
+    if (cmp < 0) {
+      return !reg.second;
+    } else if (cmp > 0) {
+      return reg.second;
+    }
+  }
+
+  // runs were written in input order, so producing equal rows from the
+  // earlier run first keeps the sort stable
+  return a > b;
+}
+
+SortBlock::SortedRun::SortedRun()
+    : file("SORT"), rowsLeft(0), current(nullptr), pos(0) {}
+
+SortBlock::SortedRun::~SortedRun() { delete current; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief position the run before its first row
+////////////////////////////////////////////////////////////////////////////////
+
+void SortBlock::SortedRun::rewind() {
+  file.rewind();
+
+  delete current;
+  current = nullptr;
+  pos = 0;
+  rowsLeft = file.numRows();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief advance to the next row of the run, reading the next block from
+/// disk if required. returns false if the run is exhausted
+////////////////////////////////////////////////////////////////////////////////
+
+bool SortBlock::SortedRun::next(ResourceMonitor* resourceMonitor) {
+  if (current != nullptr && ++pos < current->size()) {
+    return true;
+  }
+
+  delete current;
+  current = nullptr;
+  pos = 0;
+
+  current = file.read(resourceMonitor);
+
+  return current != nullptr;
+}
@@ -27,6 +27,7 @@
 #include "Basics/Common.h"
 #include "Aql/ExecutionBlock.h"
 #include "Aql/SortNode.h"
+#include "Aql/SpillFile.h"
 
 namespace arangodb {
 class AqlTransaction;
@@ -47,13 +48,95 @@ class SortBlock : public ExecutionBlock {
 
   int initializeCursor(AqlItemBlock* items, size_t pos) override final;
 
+  int shutdown(int) override final;
+
+  bool hasMore() override final;
+
+  int64_t remaining() override final;
+
+ protected:
+  int getOrSkipSome(size_t atLeast, size_t atMost, bool skipping,
+                    AqlItemBlock*& result, size_t& skipped) override final;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief dosorting
   //////////////////////////////////////////////////////////////////////////////
 
  private:
+  struct SortedRun;
+
   void doSorting();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief sort the rows in _buffer and write them to a new run file
+  //////////////////////////////////////////////////////////////////////////////
+
+  void spillRun();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief prepare the k-way merge of all spilled runs. if there are more
+  /// than _mergeFanIn runs, they are first merged into fewer runs
+  //////////////////////////////////////////////////////////////////////////////
+
+  void startMerge();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set up the merge heap for the runs [first, last)
+  //////////////////////////////////////////////////////////////////////////////
+
+  void initMergeHeap(size_t first, size_t last);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief merge the runs [first, last) into a new run
+  //////////////////////////////////////////////////////////////////////////////
+
+  SortedRun* mergeRuns(size_t first, size_t last);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief move the next <n> rows of the merge heap into <res>
+  //////////////////////////////////////////////////////////////////////////////
+
+  void mergeRows(AqlItemBlock* res, size_t n);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief merge the next batch of rows from the runs into _buffer, returns
+  /// false if all runs are exhausted
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool mergeNextBlock();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief close and remove all run files
+  //////////////////////////////////////////////////////////////////////////////
+
+  void clearRuns();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether the current row of run <a> must be produced after the
+  /// current row of run <b>, used for the merge heap
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool runComesAfter(size_t a, size_t b) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a sorted run of rows, spilled to a temporary file
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct SortedRun {
+    SortedRun();
+
+    ~SortedRun();
+
+    void rewind();
+
+    bool next(ResourceMonitor*);
+
+    SpillFile file;
+    size_t rowsLeft;
+    AqlItemBlock* current;
+    size_t pos;
+  };
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief OurLessThan
   //////////////////////////////////////////////////////////////////////////////
@@ -91,6 +174,38 @@ class SortBlock : public ExecutionBlock {
   //////////////////////////////////////////////////////////////////////////////
 
   bool _stable;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of rows to produce (0 = unlimited). if set, only
+  /// the best <_limit> rows are kept while the input is read
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _limit;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of rows to buffer before spilling a sorted run to disk
+  /// (0 = never spill)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _spillThreshold;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of runs merged at once
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _mergeFanIn;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the spilled runs, in input order
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<SortedRun*> _runs;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief heap of indexes of the non-exhausted runs during the merge
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<size_t> _mergeHeap;
 };
 
 }  // namespace arangodb::aql
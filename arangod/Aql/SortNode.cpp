@@ -31,8 +31,12 @@ using namespace arangodb::basics;
 using namespace arangodb::aql;
 
 SortNode::SortNode(ExecutionPlan* plan, arangodb::basics::Json const& base,
-                   SortElementVector const& elements, bool stable)
-    : ExecutionNode(plan, base), _elements(elements), _stable(stable) {}
+                   SortElementVector const& elements, bool stable,
+                   size_t limit)
+    : ExecutionNode(plan, base),
+      _elements(elements),
+      _stable(stable),
+      _limit(limit) {}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief toVelocyPack, for SortNode
@@ -53,6 +57,7 @@ void SortNode::toVelocyPackHelper(VPackBuilder& nodes, bool verbose) const {
     }
   }
   nodes.add("stable", VPackValue(_stable));
+  nodes.add("limit", VPackValue(static_cast<double>(_limit)));
 
   // And close it:
   nodes.close();
@@ -190,5 +195,11 @@ double SortNode::estimateCost(size_t& nrItems) const {
   if (nrItems <= 3.0) {
     return depCost + nrItems;
   }
+  if (_limit > 0 && _limit < nrItems) {
+    // only the top <limit> rows are kept in a heap
+    double cost = depCost + nrItems * log(static_cast<double>(_limit) + 1.0);
+    nrItems = _limit;
+    return cost;
+  }
   return depCost + nrItems * log(static_cast<double>(nrItems));
 }
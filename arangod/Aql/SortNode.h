@@ -55,10 +55,13 @@ class SortNode : public ExecutionNode {
  public:
   SortNode(ExecutionPlan* plan, size_t id, SortElementVector const& elements,
            bool stable)
-      : ExecutionNode(plan, id), _elements(elements), _stable(stable) {}
+      : ExecutionNode(plan, id),
+        _elements(elements),
+        _stable(stable),
+        _limit(0) {}
 
   SortNode(ExecutionPlan* plan, arangodb::basics::Json const& base,
-           SortElementVector const& elements, bool stable);
+           SortElementVector const& elements, bool stable, size_t limit);
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief return the type of the node
@@ -72,6 +75,19 @@ class SortNode : public ExecutionNode {
 
   inline bool isStable() const { return _stable; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the maximum number of rows the sort needs to produce
+  /// (0 = unlimited)
+  //////////////////////////////////////////////////////////////////////////////
+
+  inline size_t limit() const { return _limit; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief restrict the sort to produce only its first <limit> rows
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setLimit(size_t limit) { _limit = limit; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief export to VelocyPack
   //////////////////////////////////////////////////////////////////////////////
@@ -86,6 +102,7 @@ class SortNode : public ExecutionNode {
   ExecutionNode* clone(ExecutionPlan* plan, bool withDependencies,
                        bool withProperties) const override final {
     auto c = new SortNode(plan, _id, _elements, _stable);
+    c->setLimit(_limit);
 
     cloneHelper(c, plan, withDependencies, withProperties);
 
@@ -160,6 +177,13 @@ class SortNode : public ExecutionNode {
   //////////////////////////////////////////////////////////////////////////////
 
   bool _stable;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of rows to produce, set by the sort-limit rule
+  /// if the sort is followed by a LIMIT (0 = unlimited)
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _limit;
 };
 
 }  // namespace arangodb::aql
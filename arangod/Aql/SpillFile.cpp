@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SpillFile.h"
+#include "Aql/AqlItemBlock.h"
+#include "Basics/Exceptions.h"
+#include "Basics/JsonHelper.h"
+#include "Basics/files.h"
+
+using namespace arangodb::aql;
+
+using Json = arangodb::basics::Json;
+using JsonHelper = arangodb::basics::JsonHelper;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a new temporary file
+////////////////////////////////////////////////////////////////////////////////
+
+SpillFile::SpillFile(char const* operation)
+    : _operation(operation),
+      _filename(),
+      _fd(-1),
+      _numBlocks(0),
+      _numRows(0),
+      _blocksRead(0) {
+  char* filename = nullptr;
+  long systemError;
+  std::string message;
+
+  if (TRI_GetTempName("aql", &filename, false, systemError, message) !=
+      TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(
+        TRI_ERROR_CANNOT_CREATE_TEMP_FILE,
+        std::string("could not create temporary file for ") + _operation +
+            ": " + message);
+  }
+
+  _filename = filename;
+  TRI_Free(TRI_CORE_MEM_ZONE, filename);
+
+  _fd = TRI_CREATE(_filename.c_str(),
+                   O_CREAT | O_EXCL | O_RDWR | TRI_O_CLOEXEC,
+                   S_IRUSR | S_IWUSR);
+
+  if (_fd < 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_CREATE_TEMP_FILE,
+                                   errorMessage("could not create"));
+  }
+}
+
+SpillFile::~SpillFile() {
+  if (_fd >= 0) {
+    TRI_CLOSE(_fd);
+  }
+  TRI_UnlinkFile(_filename.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append a block to the file
+////////////////////////////////////////////////////////////////////////////////
+
+void SpillFile::write(AqlItemBlock const* block,
+                      arangodb::AqlTransaction* trx) {
+  std::string const data(block->toJson(trx).toString());
+  uint64_t const length = static_cast<uint64_t>(data.size());
+
+  if (!TRI_WritePointer(_fd, &length, sizeof(length)) ||
+      !TRI_WritePointer(_fd, data.c_str(), data.size())) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CANNOT_WRITE_FILE,
+                                   errorMessage("could not write to"));
+  }
+
+  ++_numBlocks;
+  _numRows += block->size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief position the file before its first block
+////////////////////////////////////////////////////////////////////////////////
+
+void SpillFile::rewind() {
+  if (TRI_LSEEK(_fd, 0, SEEK_SET) != 0) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   errorMessage("could not rewind"));
+  }
+
+  _blocksRead = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the next block, returns a nullptr if all blocks have been read
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* SpillFile::read(ResourceMonitor* resourceMonitor) {
+  if (_blocksRead == _numBlocks) {
+    return nullptr;
+  }
+
+  uint64_t length = 0;
+  if (!TRI_ReadPointer(_fd, &length, sizeof(length))) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   errorMessage("could not read"));
+  }
+
+  std::string data;
+  data.resize(static_cast<size_t>(length));
+
+  if (!TRI_ReadPointer(_fd, &data[0], data.size())) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   errorMessage("could not read"));
+  }
+
+  Json json(TRI_UNKNOWN_MEM_ZONE, JsonHelper::fromString(data));
+
+  if (!json.isObject()) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   errorMessage("invalid data in"));
+  }
+
+  auto block = new AqlItemBlock(resourceMonitor, json);
+  ++_blocksRead;
+
+  return block;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build an error message for the file
+////////////////////////////////////////////////////////////////////////////////
+
+std::string SpillFile::errorMessage(char const* what) const {
+  return std::string(what) + " temporary file '" + _filename + "' for " +
+         _operation;
+}
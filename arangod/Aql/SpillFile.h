@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGOD_AQL_SPILL_FILE_H
+#define ARANGOD_AQL_SPILL_FILE_H 1
+
+#include "Basics/Common.h"
+
+namespace arangodb {
+class AqlTransaction;
+
+namespace aql {
+
+class AqlItemBlock;
+class ResourceMonitor;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a temporary file that execution blocks can write AqlItemBlocks to
+/// when they must not keep all their rows in memory. the blocks are stored
+/// as a sequence of length-prefixed JSON documents and can be read back in
+/// the order in which they were written. the file is removed when the
+/// object is destroyed
+////////////////////////////////////////////////////////////////////////////////
+
+class SpillFile {
+ public:
+  SpillFile(SpillFile const&) = delete;
+  SpillFile& operator=(SpillFile const&) = delete;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create a new temporary file. the operation name is only used
+  /// in error messages
+  //////////////////////////////////////////////////////////////////////////////
+
+  explicit SpillFile(char const*);
+
+  ~SpillFile();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief append a block to the file
+  //////////////////////////////////////////////////////////////////////////////
+
+  void write(AqlItemBlock const*, arangodb::AqlTransaction*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief position the file before its first block
+  //////////////////////////////////////////////////////////////////////////////
+
+  void rewind();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief read the next block, returns a nullptr if all blocks have been
+  /// read. the caller takes ownership of the block, which charges its memory
+  /// to the resource monitor
+  //////////////////////////////////////////////////////////////////////////////
+
+  AqlItemBlock* read(ResourceMonitor*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of blocks written to the file
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t numBlocks() const { return _numBlocks; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of rows written to the file
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t numRows() const { return _numRows; }
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief build an error message for the file
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::string errorMessage(char const*) const;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief name of the operation that uses the file
+  //////////////////////////////////////////////////////////////////////////////
+
+  char const* _operation;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief name of the temporary file
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::string _filename;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief file descriptor
+  //////////////////////////////////////////////////////////////////////////////
+
+  int _fd;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of blocks and rows written
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _numBlocks;
+
+  size_t _numRows;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of blocks read since the last rewind
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _blocksRead;
+};
+}
+}
+
+#endif
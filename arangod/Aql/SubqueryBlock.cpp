@@ -148,7 +148,7 @@ std::vector<AqlItemBlock*>* SubqueryBlock::executeSubquery() {
   try {
     do {
       std::unique_ptr<AqlItemBlock> tmp(
-          _subquery->getSome(DefaultBatchSize, DefaultBatchSize));
+          _subquery->getSomeProfiled(DefaultBatchSize, DefaultBatchSize));
 
       if (tmp.get() == nullptr) {
         break;
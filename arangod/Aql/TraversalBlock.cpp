@@ -27,7 +27,10 @@
 #include "Aql/ExecutionNode.h"
 #include "Aql/ExecutionPlan.h"
 #include "Aql/Functions.h"
+#include "Basics/Barrier.h"
 #include "Basics/ScopeGuard.h"
+#include "Basics/ThreadPool.h"
+#include "Basics/system-functions.h"
 #include "Cluster/ClusterTraverser.h"
 #include "V8/v8-globals.h"
 #include "V8Server/V8Traverser.h"
@@ -37,6 +40,18 @@ using namespace arangodb::aql;
 using Json = arangodb::basics::Json;
 using VertexId = arangodb::traverser::VertexId;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of input rows traversed at once per thread in parallel mode
+////////////////////////////////////////////////////////////////////////////////
+
+size_t const TraversalBlock::ParallelRowsPerThread = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of paths buffered per input row in parallel mode
+////////////////////////////////////////////////////////////////////////////////
+
+size_t const TraversalBlock::ParallelMaxPathsPerRow = 1000;
+
 TraversalBlock::TraversalBlock(ExecutionEngine* engine, TraversalNode const* ep)
     : ExecutionBlock(engine, ep),
       _posInPaths(0),
@@ -47,9 +62,14 @@ TraversalBlock::TraversalBlock(ExecutionEngine* engine, TraversalNode const* ep)
       _pathReg(0),
       _resolver(nullptr),
       _expressions(ep->expressions()),
-      _hasV8Expression(false) {
-  arangodb::traverser::TraverserOptions opts;
-  ep->fillTraversalOptions(opts);
+      _hasV8Expression(false),
+      _parallelism(1),
+      _firstParallelRow(0),
+      _parallelRows(0),
+      _rowPathsMemory(0),
+      _rowPending(false),
+      _serialRow(false) {
+  ep->fillTraversalOptions(_opts);
   auto ast = ep->_plan->getAst();
 
   for (auto& map : *_expressions) {
@@ -85,23 +105,38 @@ TraversalBlock::TraversalBlock(ExecutionEngine* engine, TraversalNode const* ep)
   _resolver = new CollectionNameResolver(_trx->vocbase());
 
   if (arangodb::ServerState::instance()->isCoordinator()) {
+    if (_opts.useBreadthFirst ||
+        _opts.uniqueVertices != arangodb::traverser::TraverserOptions::NONE ||
+        _opts.uniqueEdges != arangodb::traverser::TraverserOptions::PATH) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(
+          TRI_ERROR_NOT_IMPLEMENTED,
+          "traversal options bfs, uniqueVertices and uniqueEdges are not "
+          "supported in a cluster");
+    }
     _traverser.reset(new arangodb::traverser::ClusterTraverser(
-        ep->edgeColls(), opts,
+        ep->edgeColls(), _opts,
         std::string(_trx->vocbase()->_name, strlen(_trx->vocbase()->_name)),
         _resolver, _expressions));
   } else {
-    std::vector<TRI_document_collection_t*> edgeCollections;
     for (auto const& coll : ep->edgeColls()) {
       TRI_voc_cid_t cid = _resolver->getCollectionId(coll);
-      edgeCollections.push_back(_trx->documentCollection(cid));
+      _edgeCollections.push_back(_trx->documentCollection(cid));
 
       auto trxCollection = _trx->trxCollection(cid);
       if (trxCollection != nullptr) {
         _trx->orderDitch(trxCollection);
       }
     }
-    _traverser.reset(new arangodb::traverser::DepthFirstTraverser(
-        edgeCollections, opts, _resolver, _trx, _expressions));
+    if (ep->usesInVariable()) {
+      // start vertices from different input rows can be traversed in
+      // parallel, by at most one thread per processor
+      _parallelism = (std::max)(
+          size_t(1), (std::min)(engine->getQuery()->maxParallelism(),
+                                TRI_numberProcessors()));
+    }
+    _traverser.reset(
+        createTraverser(_resolver, _parallelism > 1 ? &_trxLock : nullptr));
+    _parallelRows = _parallelism;
   }
   if (!ep->usesInVariable()) {
     _vertexId = ep->getStartVertex();
@@ -128,8 +163,28 @@ TraversalBlock::TraversalBlock(ExecutionEngine* engine, TraversalNode const* ep)
 }
 
 TraversalBlock::~TraversalBlock() {
-  delete _resolver;
+  freeRowPaths();
   freeCaches();
+  _workers.clear();
+  delete _resolver;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a traverser for the edge collections of the block
+////////////////////////////////////////////////////////////////////////////////
+
+arangodb::traverser::Traverser* TraversalBlock::createTraverser(
+    arangodb::CollectionNameResolver* resolver, arangodb::Mutex* trxLock) {
+  std::unique_ptr<arangodb::traverser::SingleServerTraverser> traverser;
+  if (_opts.useBreadthFirst) {
+    traverser.reset(new arangodb::traverser::BreadthFirstTraverser(
+        _edgeCollections, _opts, resolver, _trx, _expressions));
+  } else {
+    traverser.reset(new arangodb::traverser::DepthFirstTraverser(
+        _edgeCollections, _opts, resolver, _trx, _expressions));
+  }
+  traverser->setTransactionLock(trxLock);
+  return traverser.release();
 }
 
 void TraversalBlock::freeCaches() {
@@ -246,6 +301,8 @@ void TraversalBlock::executeFilterExpressions() {
 }
 
 int TraversalBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
+  freeRowPaths();
+  _parallelRows = _parallelism;
   return ExecutionBlock::initializeCursor(items, pos);
 }
 
@@ -256,6 +313,25 @@ int TraversalBlock::initializeCursor(AqlItemBlock* items, size_t pos) {
 bool TraversalBlock::morePaths(size_t hint) {
   freeCaches();
   _posInPaths = 0;
+  if (_parallelism > 1 && !_serialRow) {
+    // the paths of the row were computed by traverseParallel
+    if (!_rowPending) {
+      return false;
+    }
+    _rowPending = false;
+    RowPaths& row = _rowPaths[_pos - _firstParallelRow];
+    if (row.complete) {
+      _vertices.swap(row.vertices);
+      _edges.swap(row.edges);
+      _paths.swap(row.paths);
+      return !_vertices.empty();
+    }
+    // too many paths to buffer them, read them like in serial mode
+    _serialRow = true;
+    VertexId v =
+        arangodb::traverser::IdStringToVertexId(_resolver, row.startVertex);
+    _traverser->setStartVertex(v);
+  }
   if (!_traverser->hasMore()) {
     _engine->_stats.scannedIndex += _traverser->getAndResetReadDocuments();
     _engine->_stats.filtered += _traverser->getAndResetFilteredPaths();
@@ -302,6 +378,18 @@ bool TraversalBlock::morePaths(size_t hint) {
 ////////////////////////////////////////////////////////////////////////////////
 
 size_t TraversalBlock::skipPaths(size_t hint) {
+  if (_parallelism > 1) {
+    if (!morePaths(hint)) {
+      return 0;
+    }
+    size_t skipped = (std::min)(hint, _vertices.size());
+    _posInPaths = skipped;
+    if (_posInPaths >= _vertices.size()) {
+      freeCaches();
+      _posInPaths = 0;
+    }
+    return skipped;
+  }
   freeCaches();
   _posInPaths = 0;
   if (!_traverser->hasMore()) {
@@ -336,38 +424,274 @@ void TraversalBlock::initializePaths(AqlItemBlock const* items) {
         _traverser->setStartVertex(v);
       }
     }
+  } else if (_parallelism > 1) {
+    if (_pos < _firstParallelRow ||
+        _pos >= _firstParallelRow + _rowPaths.size()) {
+      traverseParallel(items);
+    }
+    _rowPending = true;
+    _serialRow = false;
   } else {
     auto in = items->getValueReference(_pos, _reg);
     if (in.isShaped()) {
       auto col = items->getDocumentCollection(_reg);
       VertexId v(col->_info.id(), TRI_EXTRACT_MARKER_KEY(in.getMarker()));
       _traverser->setStartVertex(v);
-    } else if (in.isObject()) {
-      Json input = in.toJson(_trx, nullptr, false);
-      if (input.has(TRI_VOC_ATTRIBUTE_ID)) {
-        Json _idJson = input.get(TRI_VOC_ATTRIBUTE_ID);
-        if (_idJson.isString()) {
-          _vertexId =
-              arangodb::basics::JsonHelper::getStringValue(_idJson.json(), "");
-          VertexId v =
-              arangodb::traverser::IdStringToVertexId(_resolver, _vertexId);
-          _traverser->setStartVertex(v);
-        }
-      }
-    } else if (in.isString()) {
-      _vertexId = in.toString();
+    } else if (getStartVertexId(items, _pos, _vertexId)) {
       VertexId v =
           arangodb::traverser::IdStringToVertexId(_resolver, _vertexId);
       _traverser->setStartVertex(v);
-    } else {
-      _engine->getQuery()->registerWarning(TRI_ERROR_BAD_PARAMETER,
-                                           "Invalid input for traversal: Only "
-                                           "id strings or objects with _id are "
-                                           "allowed");
     }
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read the id of the start vertex from an input row
+////////////////////////////////////////////////////////////////////////////////
+
+bool TraversalBlock::getStartVertexId(AqlItemBlock const* items, size_t pos,
+                                      std::string& result) {
+  auto in = items->getValueReference(pos, _reg);
+  if (in.isShaped()) {
+    auto col = items->getDocumentCollection(_reg);
+    result = _resolver->getCollectionNameCluster(col->_info.id()) + "/" +
+             TRI_EXTRACT_MARKER_KEY(in.getMarker());
+    return true;
+  }
+  if (in.isObject()) {
+    Json input = in.toJson(_trx, nullptr, false);
+    if (input.has(TRI_VOC_ATTRIBUTE_ID)) {
+      Json _idJson = input.get(TRI_VOC_ATTRIBUTE_ID);
+      if (_idJson.isString()) {
+        result =
+            arangodb::basics::JsonHelper::getStringValue(_idJson.json(), "");
+        return true;
+      }
+    }
+    return false;
+  }
+  if (in.isString()) {
+    result = in.toString();
+    return true;
+  }
+  _engine->getQuery()->registerWarning(TRI_ERROR_BAD_PARAMETER,
+                                       "Invalid input for traversal: Only "
+                                       "id strings or objects with _id are "
+                                       "allowed");
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief traverse from the start vertices of the next input rows with all
+/// workers. the start vertices are read on the query's thread, which also
+/// registers the warnings. the workers take the rows one by one, so the
+/// output stays in the order of the input rows. the memory of the buffered
+/// paths is charged to the query once all workers are done
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalBlock::traverseParallel(AqlItemBlock const* items) {
+  freeRowPaths();
+
+  size_t const n = (std::min)(items->size() - _pos, _parallelRows);
+  _parallelRows =
+      (std::min)(2 * _parallelRows, _parallelism * ParallelRowsPerThread);
+
+  _rowPaths.resize(n);
+  _firstParallelRow = _pos;
+
+  for (size_t i = 0; i < n; ++i) {
+    if (!getStartVertexId(items, _pos + i, _rowPaths[i].startVertex)) {
+      _rowPaths[i].startVertex.clear();
+    }
+  }
+
+  if (_workers.empty()) {
+    for (size_t i = 0; i < _parallelism; ++i) {
+      auto worker = std::make_unique<Worker>();
+      worker->resolver.reset(new CollectionNameResolver(_trx->vocbase()));
+      worker->traverser.reset(
+          createTraverser(worker->resolver.get(), &_trxLock));
+      _workers.emplace_back(std::move(worker));
+    }
+    _pool.reset(
+        new arangodb::basics::ThreadPool(_parallelism - 1, "AqlTraversal"));
+  }
+
+  size_t const numWorkers = (std::min)(_workers.size(), n);
+  std::atomic<size_t> next(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr error;
+  std::mutex mutex;
+
+  auto work = [&](size_t worker) -> void {
+    try {
+      traverseRows(*_workers[worker], next, failed);
+    } catch (...) {
+      std::lock_guard<std::mutex> guard(mutex);
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+      failed = true;
+    }
+  };
+
+  if (numWorkers > 1) {
+    arangodb::basics::Barrier barrier(numWorkers - 1);
+
+    for (size_t worker = 1; worker < numWorkers; ++worker) {
+      try {
+        _pool->enqueue([&work, &barrier, worker]() -> void {
+          arangodb::basics::BarrierTask task(&barrier);
+          work(worker);
+        });
+      } catch (...) {
+        // the running workers will process the remaining rows
+        barrier.join();
+      }
+    }
+
+    work(0);
+    // barrier waits here until all workers are done
+  } else {
+    work(0);
+  }
+
+  for (auto& worker : _workers) {
+    _engine->_stats.scannedIndex += worker->scannedIndex;
+    _engine->_stats.filtered += worker->filtered;
+    worker->scannedIndex = 0;
+    worker->filtered = 0;
+  }
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+
+  size_t memoryUsage = 0;
+  for (auto const& row : _rowPaths) {
+    memoryUsage += row.memoryUsage;
+  }
+  _engine->getQuery()->resourceMonitor()->increaseMemoryUsage(memoryUsage);
+  _rowPathsMemory = memoryUsage;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief traverse from the start vertices of the rows handed out by next.
+/// a row with more than ParallelMaxPathsPerRow paths is given up and marked
+/// as incomplete, its paths are read later on the query's thread
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalBlock::traverseRows(Worker& worker, std::atomic<size_t>& next,
+                                  std::atomic<bool>& failed) {
+  auto traverser = worker.traverser.get();
+  auto resolver = worker.resolver.get();
+  auto en = static_cast<TraversalNode const*>(getPlanNode());
+
+  while (!failed.load()) {
+    size_t const i = next++;
+
+    if (i >= _rowPaths.size()) {
+      break;
+    }
+
+    throwIfKilled();  // check if we were aborted
+
+    RowPaths& row = _rowPaths[i];
+    if (row.startVertex.empty()) {
+      // invalid input
+      continue;
+    }
+
+    VertexId v =
+        arangodb::traverser::IdStringToVertexId(resolver, row.startVertex);
+    traverser->setStartVertex(v);
+
+    size_t numPaths = 0;
+    size_t scannedIndex = 0;
+    while (traverser->hasMore()) {
+      if (numPaths++ == ParallelMaxPathsPerRow) {
+        row.complete = false;
+        freeRowPaths(row);
+        break;
+      }
+
+      std::unique_ptr<arangodb::traverser::TraversalPath> p(traverser->next());
+
+      if (p == nullptr) {
+        break;
+      }
+
+      AqlValue pathValue;
+
+      if (usesPathOutput() || (en->condition() != nullptr)) {
+        pathValue = AqlValue(p->pathToJson(_trx, resolver));
+      }
+
+      if (usesVertexOutput()) {
+        row.vertices.emplace_back(p->lastVertexToJson(_trx, resolver));
+        row.memoryUsage += row.vertices.back().memoryUsage();
+      }
+      if (usesEdgeOutput()) {
+        row.edges.emplace_back(p->lastEdgeToJson(_trx, resolver));
+        row.memoryUsage += row.edges.back().memoryUsage();
+      }
+      if (usesPathOutput()) {
+        row.paths.emplace_back(pathValue);
+        row.memoryUsage += pathValue.memoryUsage();
+      } else {
+        pathValue.destroy();
+      }
+      scannedIndex += p->getReadDocuments();
+    }
+
+    scannedIndex += traverser->getAndResetReadDocuments();
+    size_t filtered = traverser->getAndResetFilteredPaths();
+    if (row.complete) {
+      // incomplete rows are counted when they are traversed again
+      worker.scannedIndex += scannedIndex;
+      worker.filtered += filtered;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free the paths of the rows of the last parallel run
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalBlock::freeRowPaths() {
+  for (auto& row : _rowPaths) {
+    freeRowPaths(row);
+  }
+  _rowPaths.clear();
+  if (_rowPathsMemory > 0) {
+    _engine->getQuery()->resourceMonitor()->decreaseMemoryUsage(
+        _rowPathsMemory);
+    _rowPathsMemory = 0;
+  }
+  _rowPending = false;
+  _serialRow = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free the paths of a single row
+////////////////////////////////////////////////////////////////////////////////
+
+void TraversalBlock::freeRowPaths(RowPaths& row) {
+  for (auto& v : row.vertices) {
+    v.destroy();
+  }
+  row.vertices.clear();
+  for (auto& e : row.edges) {
+    e.destroy();
+  }
+  row.edges.clear();
+  for (auto& p : row.paths) {
+    p.destroy();
+  }
+  row.paths.clear();
+  row.memoryUsage = 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief getSome
 ////////////////////////////////////////////////////////////////////////////////
@@ -407,6 +731,7 @@ AqlItemBlock* TraversalBlock::getSome(size_t,  // atLeast,
         // returnBlock(cur);
         delete cur;
         _pos = 0;
+        freeRowPaths();
       } else {
         initializePaths(cur);
       }
@@ -458,6 +783,7 @@ AqlItemBlock* TraversalBlock::getSome(size_t,  // atLeast,
         // returnBlock(cur);
         delete cur;
         _pos = 0;
+        freeRowPaths();
       } else {
         initializePaths(cur);
       }
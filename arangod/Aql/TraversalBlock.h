@@ -26,9 +26,14 @@
 
 #include "Aql/ExecutionBlock.h"
 #include "Aql/TraversalNode.h"
+#include "Basics/Mutex.h"
 #include "VocBase/Traverser.h"
 
 namespace arangodb {
+namespace basics {
+class ThreadPool;
+}
+
 namespace aql {
 
 class TraversalBlock : public ExecutionBlock {
@@ -70,6 +75,61 @@ class TraversalBlock : public ExecutionBlock {
   size_t skipSome(size_t atLeast, size_t atMost) override final;
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of input rows traversed at once per thread in parallel
+  /// mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  static size_t const ParallelRowsPerThread;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of paths a worker buffers for an input row in
+  /// parallel mode. rows with more paths are traversed on the query's thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  static size_t const ParallelMaxPathsPerRow;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a thread traversing from the start vertices of input rows in
+  /// parallel mode, with its own traverser and name resolver
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Worker {
+    Worker() : scannedIndex(0), filtered(0) {}
+
+    std::unique_ptr<arangodb::CollectionNameResolver> resolver;
+    std::unique_ptr<arangodb::traverser::Traverser> traverser;
+    size_t scannedIndex;
+    size_t filtered;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the paths found for an input row in parallel mode
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct RowPaths {
+    RowPaths() : complete(true), memoryUsage(0) {}
+
+    std::string startVertex;
+    bool complete;
+    size_t memoryUsage;
+    std::vector<arangodb::aql::AqlValue> vertices;
+    std::vector<arangodb::aql::AqlValue> edges;
+    std::vector<arangodb::aql::AqlValue> paths;
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief options of the traversal
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::traverser::TraverserOptions _opts;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the edge collections, only used on single servers
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<TRI_document_collection_t*> _edgeCollections;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief vertices buffer
   //////////////////////////////////////////////////////////////////////////////
@@ -200,6 +260,75 @@ class TraversalBlock : public ExecutionBlock {
 
   std::vector<std::vector<RegisterId>> _inRegs;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of threads traversing from the start vertices of the input
+  /// rows, 1 if the traversal is not run in parallel. taken from the
+  /// maxParallelism option of the query
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _parallelism;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the threads of the parallel mode, except for the query's thread.
+  /// created on first use
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unique_ptr<arangodb::basics::ThreadPool> _pool;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief one worker per thread of the parallel mode. worker 0 runs on the
+  /// query's thread
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief held by all traversers of the block when they look up or add
+  /// collections of the transaction. the query's other blocks do not touch
+  /// the transaction's collection list while the workers run, because they
+  /// are only called from the query's thread, which waits for the workers in
+  /// traverseParallel
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::Mutex _trxLock;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief paths of the input rows traversed by the last parallel run,
+  /// starting with row _firstParallelRow of the current input block
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<RowPaths> _rowPaths;
+
+  size_t _firstParallelRow;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of input rows to traverse in the next parallel run. starts
+  /// with one row per worker and doubles with every run, so that a LIMIT
+  /// below the traversal does not wait for more rows than it needs
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _parallelRows;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief memory of the paths in _rowPaths, charged to the query
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _rowPathsMemory;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the paths of the current input row still have to
+  /// be moved from _rowPaths into the buffers
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _rowPending;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the paths of the current input row are read with
+  /// _traverser, because the row had too many paths to buffer them
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _serialRow;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief continue fetching of paths
   //////////////////////////////////////////////////////////////////////////////
@@ -218,6 +347,47 @@ class TraversalBlock : public ExecutionBlock {
 
   void initializePaths(AqlItemBlock const*);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief read the id of the start vertex from an input row. returns false
+  /// for invalid input
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool getStartVertexId(AqlItemBlock const*, size_t, std::string&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief create a traverser for the edge collections of the block
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::traverser::Traverser* createTraverser(
+      arangodb::CollectionNameResolver*, arangodb::Mutex*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief parallel mode: traverse from the start vertices of the next input
+  /// rows, beginning with the current one, using all workers
+  //////////////////////////////////////////////////////////////////////////////
+
+  void traverseParallel(AqlItemBlock const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief parallel mode: traverse from the start vertices of the input rows
+  /// handed out by next, until there are no more rows
+  //////////////////////////////////////////////////////////////////////////////
+
+  void traverseRows(Worker&, std::atomic<size_t>& next,
+                    std::atomic<bool>& failed);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief free the paths of the rows of the last parallel run
+  //////////////////////////////////////////////////////////////////////////////
+
+  void freeRowPaths();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief free the paths of a single row
+  //////////////////////////////////////////////////////////////////////////////
+
+  void freeRowPaths(RowPaths&);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief Checks if we output the vertex
   //////////////////////////////////////////////////////////////////////////////
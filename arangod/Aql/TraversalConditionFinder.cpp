@@ -248,6 +248,8 @@ bool TraversalConditionFinder::before(ExecutionNode* en) {
     case EN::REMOTE:
     case EN::SUBQUERY:
     case EN::INDEX:
+    case EN::HASH_JOIN:
+    case EN::SHORTEST_PATH:
     case EN::INSERT:
     case EN::REMOVE:
     case EN::REPLACE:
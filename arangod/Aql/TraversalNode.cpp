@@ -34,6 +34,8 @@
 using namespace arangodb::basics;
 using namespace arangodb::aql;
 
+using TraverserOptions = arangodb::traverser::TraverserOptions;
+
 static uint64_t checkTraversalDepthValue(AstNode const* node) {
   if (!node->isNumericValue()) {
     THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_PARSE,
@@ -106,6 +108,36 @@ void SimpleTraverserExpression::toVelocyPack(VPackBuilder& builder) const {
   compareToNode->toVelocyPack(builder, true);
 }
 
+static TraverserOptions::UniquenessLevel parseUniquenessLevel(
+    std::string const& value, char const* name) {
+  if (value == "none") {
+    return TraverserOptions::NONE;
+  }
+  if (value == "path") {
+    return TraverserOptions::PATH;
+  }
+  if (value == "global") {
+    return TraverserOptions::GLOBAL;
+  }
+  THROW_ARANGO_EXCEPTION_MESSAGE(
+      TRI_ERROR_QUERY_PARSE,
+      std::string("invalid value for traversal option '") + name +
+          "'. expecting 'none', 'path' or 'global'");
+}
+
+static char const* uniquenessLevelName(
+    TraverserOptions::UniquenessLevel level) {
+  switch (level) {
+    case TraverserOptions::NONE:
+      return "none";
+    case TraverserOptions::PATH:
+      return "path";
+    case TraverserOptions::GLOBAL:
+      return "global";
+  }
+  return "none";
+}
+
 static TRI_edge_direction_e parseDirection (AstNode const* node) {
   TRI_ASSERT(node->isIntValue());
   auto dirNum = node->getIntValue();
@@ -126,13 +158,17 @@ static TRI_edge_direction_e parseDirection (AstNode const* node) {
 
 TraversalNode::TraversalNode(ExecutionPlan* plan, size_t id,
                              TRI_vocbase_t* vocbase, AstNode const* direction,
-                             AstNode const* start, AstNode const* graph)
+                             AstNode const* start, AstNode const* graph,
+                             AstNode const* options)
     : ExecutionNode(plan, id),
       _vocbase(vocbase),
       _vertexOutVariable(nullptr),
       _edgeOutVariable(nullptr),
       _pathOutVariable(nullptr),
       _inVariable(nullptr),
+      _useBreadthFirst(false),
+      _uniqueVertices(TraverserOptions::NONE),
+      _uniqueEdges(TraverserOptions::PATH),
       _graphObj(nullptr),
       _condition(nullptr) {
   TRI_ASSERT(_vocbase != nullptr);
@@ -247,6 +283,44 @@ TraversalNode::TraversalNode(ExecutionPlan* plan, size_t id,
                                      "invalid start vertex. Must either be an "
                                      "_id string or an object with _id.");
   }
+
+  // Parse options
+  if (options != nullptr && options->type == NODE_TYPE_OBJECT) {
+    size_t n = options->numMembers();
+
+    for (size_t i = 0; i < n; ++i) {
+      auto member = options->getMember(i);
+
+      if (member != nullptr && member->type == NODE_TYPE_OBJECT_ELEMENT) {
+        auto name = member->getStringValue();
+        auto value = member->getMember(0);
+
+        TRI_ASSERT(value->isConstant());
+
+        if (strcmp(name, "bfs") == 0) {
+          _useBreadthFirst = value->isTrue();
+        } else if (strcmp(name, "uniqueVertices") == 0 &&
+                   value->isStringValue()) {
+          _uniqueVertices = parseUniquenessLevel(
+              std::string(value->getStringValue(), value->getStringLength()),
+              name);
+        } else if (strcmp(name, "uniqueEdges") == 0 &&
+                   value->isStringValue()) {
+          _uniqueEdges = parseUniquenessLevel(
+              std::string(value->getStringValue(), value->getStringLength()),
+              name);
+        }
+      }
+    }
+  }
+
+  if (hasGlobalUniqueness() && !_useBreadthFirst) {
+    // a depth-first search would mark vertices as visited on arbitrary,
+    // possibly long paths and would hide their shorter paths
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_QUERY_PARSE,
+                                   "traversal uniqueness 'global' is only "
+                                   "supported with option 'bfs: true'");
+  }
 }
 
 TraversalNode::TraversalNode(ExecutionPlan* plan, size_t id,
@@ -265,6 +339,9 @@ TraversalNode::TraversalNode(ExecutionPlan* plan, size_t id,
       _vertexId(vertexId),
       _minDepth(minDepth),
       _maxDepth(maxDepth),
+      _useBreadthFirst(false),
+      _uniqueVertices(TraverserOptions::NONE),
+      _uniqueEdges(TraverserOptions::PATH),
       _directions(directions),
       _graphObj(nullptr),
       _condition(nullptr) {
@@ -285,12 +362,27 @@ TraversalNode::TraversalNode(ExecutionPlan* plan,
       _edgeOutVariable(nullptr),
       _pathOutVariable(nullptr),
       _inVariable(nullptr),
+      _useBreadthFirst(false),
+      _uniqueVertices(TraverserOptions::NONE),
+      _uniqueEdges(TraverserOptions::PATH),
       _graphObj(nullptr),
       _condition(nullptr) {
   _minDepth =
       arangodb::basics::JsonHelper::stringUInt64(base.json(), "minDepth");
   _maxDepth =
       arangodb::basics::JsonHelper::stringUInt64(base.json(), "maxDepth");
+
+  if (base.has("options")) {
+    auto options = base.get("options");
+    _useBreadthFirst =
+        JsonHelper::getBooleanValue(options.json(), "bfs", false);
+    _uniqueVertices = parseUniquenessLevel(
+        JsonHelper::getStringValue(options.json(), "uniqueVertices", "none"),
+        "uniqueVertices");
+    _uniqueEdges = parseUniquenessLevel(
+        JsonHelper::getStringValue(options.json(), "uniqueEdges", "path"),
+        "uniqueEdges");
+  }
   auto dirList = base.get("directions");
   TRI_ASSERT(dirList.json() != nullptr);
   for (size_t i = 0; i < dirList.size(); ++i) {
@@ -476,6 +568,15 @@ void TraversalNode::toVelocyPackHelper(arangodb::velocypack::Builder& nodes,
   nodes.add("minDepth", VPackValue(_minDepth));
   nodes.add("maxDepth", VPackValue(_maxDepth));
 
+  nodes.add(VPackValue("options"));
+  {
+    VPackObjectBuilder guard(&nodes);
+    nodes.add("bfs", VPackValue(_useBreadthFirst));
+    nodes.add("uniqueVertices",
+              VPackValue(uniquenessLevelName(_uniqueVertices)));
+    nodes.add("uniqueEdges", VPackValue(uniquenessLevelName(_uniqueEdges)));
+  }
+
   {
     // TODO Remove _graphJson
     auto tmp = arangodb::basics::JsonHelper::toVelocyPack(_graphJson.json());
@@ -549,6 +650,9 @@ ExecutionNode* TraversalNode::clone(ExecutionPlan* plan, bool withDependencies,
                                     bool withProperties) const {
   auto c = new TraversalNode(plan, _id, _vocbase, _edgeColls, _inVariable,
                              _vertexId, _directions, _minDepth, _maxDepth);
+  c->_useBreadthFirst = _useBreadthFirst;
+  c->_uniqueVertices = _uniqueVertices;
+  c->_uniqueEdges = _uniqueEdges;
 
   if (usesVertexOutVariable()) {
     auto vertexOutVariable = _vertexOutVariable;
@@ -593,6 +697,7 @@ double TraversalNode::estimateCost(size_t& nrItems) const {
   size_t incoming = 0;
   double depCost = _dependencies.at(0)->getCost(incoming);
   double expectedEdgesPerDepth = 0.0;
+  size_t numberEdges = 0;
   auto collections = _plan->getAst()->query()->collections();
 
   TRI_ASSERT(collections != nullptr);
@@ -607,6 +712,10 @@ double TraversalNode::estimateCost(size_t& nrItems) const {
 
     TRI_ASSERT(collection != nullptr);
 
+    if (hasGlobalUniqueness()) {
+      numberEdges += collection->count();
+    }
+
     for (auto const& index : collection->getIndexes()) {
       if (index->type == arangodb::Index::IndexType::TRI_IDX_TYPE_EDGE_INDEX) {
         // We can only use Edge Index
@@ -619,8 +728,14 @@ double TraversalNode::estimateCost(size_t& nrItems) const {
       }
     }
   }
-  nrItems =
-      static_cast<size_t>(incoming * std::pow(expectedEdgesPerDepth, static_cast<double>(_maxDepth)));
+  double expectedPaths =
+      std::pow(expectedEdgesPerDepth, static_cast<double>(_maxDepth));
+  if (hasGlobalUniqueness()) {
+    // every vertex or every edge is visited at most once per start vertex,
+    // so there cannot be more paths than edges
+    expectedPaths = (std::min)(expectedPaths, static_cast<double>(numberEdges));
+  }
+  nrItems = static_cast<size_t>(incoming * expectedPaths);
   if (nrItems == 0 && incoming > 0) {
     nrItems = 1;  // min value
   }
@@ -631,6 +746,9 @@ void TraversalNode::fillTraversalOptions(
     arangodb::traverser::TraverserOptions& opts) const {
   opts.minDepth = _minDepth;
   opts.maxDepth = _maxDepth;
+  opts.useBreadthFirst = _useBreadthFirst;
+  opts.uniqueVertices = _uniqueVertices;
+  opts.uniqueEdges = _uniqueEdges;
   opts.setCollections(_edgeColls, _directions);
 }
 
@@ -72,7 +72,7 @@ class TraversalNode : public ExecutionNode {
  public:
   TraversalNode(ExecutionPlan* plan, size_t id, TRI_vocbase_t* vocbase,
                 AstNode const* direction, AstNode const* start,
-                AstNode const* graph);
+                AstNode const* graph, AstNode const* options);
 
   TraversalNode(ExecutionPlan* plan, arangodb::basics::Json const& base);
 
@@ -247,6 +247,23 @@ class TraversalNode : public ExecutionNode {
 
   std::vector<std::string> const edgeColls() const { return _edgeColls; }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the traversal runs breadth-first
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool useBreadthFirst() const { return _useBreadthFirst; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not each vertex or edge is visited at most once per
+  /// start vertex
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool hasGlobalUniqueness() const {
+    return _uniqueVertices ==
+               arangodb::traverser::TraverserOptions::GLOBAL ||
+           _uniqueEdges == arangodb::traverser::TraverserOptions::GLOBAL;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief remember the condition to execute for early traversal abortion.
   //////////////////////////////////////////////////////////////////////////////
@@ -355,6 +372,21 @@ class TraversalNode : public ExecutionNode {
 
   uint64_t _maxDepth;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Traverse breadth-first instead of depth-first (OPTIONS bfs)
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool _useBreadthFirst;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Uniqueness of vertices and edges (OPTIONS uniqueVertices and
+  ///        uniqueEdges)
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::traverser::TraverserOptions::UniquenessLevel _uniqueVertices;
+
+  arangodb::traverser::TraverserOptions::UniquenessLevel _uniqueEdges;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief The directions edges are followed
   //////////////////////////////////////////////////////////////////////////////
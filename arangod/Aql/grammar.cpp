@@ -171,15 +171,17 @@ extern int Aqldebug;
     T_ARRAY_CLOSE = 312,
     T_OUTBOUND = 313,
     T_INBOUND = 314,
-    T_ANY = 315,
-    T_ALL = 316,
-    T_NONE = 317,
-    UMINUS = 318,
-    UPLUS = 319,
-    FUNCCALL = 320,
-    REFERENCE = 321,
-    INDEXED = 322,
-    EXPANSION = 323
+    T_SHORTEST_PATH = 315,
+    T_K_SHORTEST_PATHS = 316,
+    T_ANY = 317,
+    T_ALL = 318,
+    T_NONE = 319,
+    UMINUS = 320,
+    UPLUS = 321,
+    FUNCCALL = 322,
+    REFERENCE = 323,
+    INDEXED = 324,
+    EXPANSION = 325
   };
 #endif
 
@@ -198,7 +200,7 @@ union YYSTYPE
   bool                     boolval;
   int64_t                  intval;
 
-#line 202 "Aql/grammar.cpp" /* yacc.c:355  */
+#line 204 "Aql/grammar.cpp" /* yacc.c:355  */
 };
 
 typedef union YYSTYPE YYSTYPE;
@@ -371,7 +373,7 @@ static AstNode const* GetIntoExpression(AstNode const* node) {
 }
 
 
-#line 375 "Aql/grammar.cpp" /* yacc.c:358  */
+#line 377 "Aql/grammar.cpp" /* yacc.c:358  */
 
 #ifdef short
 # undef short
@@ -615,21 +617,21 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  7
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   1122
+#define YYLAST   1261
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  70
+#define YYNTOKENS  72
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  89
+#define YYNNTS  90
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  209
+#define YYNRULES  215
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  346
+#define YYNSTATES  374
 
 /* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
    by yylex, with out-of-bounds checking.  */
 #define YYUNDEFTOK  2
-#define YYMAXUTOK   323
+#define YYMAXUTOK   325
 
 #define YYTRANSLATE(YYX)                                                \
   ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
@@ -642,7 +644,7 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,    69,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,    71,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -670,34 +672,35 @@ static const yytype_uint8 yytranslate[] =
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
       45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
       55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
-      65,    66,    67,    68
+      65,    66,    67,    68,    69,    70
 };
 
 #if YYDEBUG
   /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_uint16 yyrline[] =
 {
-       0,   335,   335,   338,   349,   353,   357,   364,   366,   366,
-     377,   382,   387,   389,   392,   395,   398,   401,   407,   409,
-     414,   416,   418,   420,   422,   424,   426,   428,   430,   432,
-     434,   439,   445,   450,   455,   463,   471,   476,   478,   483,
-     490,   500,   500,   514,   523,   534,   553,   604,   618,   640,
-     642,   647,   654,   657,   660,   669,   683,   700,   700,   714,
-     714,   724,   724,   735,   738,   744,   750,   753,   756,   759,
-     765,   770,   777,   785,   788,   794,   804,   814,   822,   833,
-     838,   846,   857,   862,   865,   871,   871,   922,   925,   928,
-     934,   934,   944,   950,   953,   956,   959,   962,   965,   971,
-     974,   990,   990,  1002,  1005,  1008,  1014,  1017,  1020,  1023,
-    1026,  1029,  1032,  1035,  1038,  1041,  1044,  1047,  1050,  1053,
-    1056,  1059,  1062,  1065,  1068,  1071,  1074,  1077,  1080,  1086,
-    1092,  1094,  1099,  1102,  1102,  1118,  1121,  1127,  1130,  1136,
-    1136,  1145,  1147,  1152,  1155,  1161,  1164,  1178,  1178,  1187,
-    1189,  1194,  1196,  1201,  1215,  1219,  1228,  1235,  1238,  1244,
-    1247,  1253,  1256,  1259,  1265,  1268,  1274,  1277,  1285,  1289,
-    1300,  1304,  1311,  1316,  1316,  1324,  1333,  1342,  1345,  1348,
-    1354,  1357,  1363,  1395,  1398,  1401,  1408,  1418,  1418,  1431,
-    1446,  1460,  1474,  1474,  1517,  1520,  1526,  1533,  1543,  1546,
-    1549,  1552,  1555,  1561,  1564,  1567,  1577,  1583,  1586,  1591
+       0,   341,   341,   344,   355,   359,   363,   370,   372,   372,
+     383,   388,   393,   395,   398,   401,   404,   407,   413,   415,
+     420,   422,   424,   426,   428,   430,   432,   434,   436,   438,
+     440,   445,   451,   457,   463,   469,   479,   489,   502,   510,
+     515,   517,   522,   529,   539,   539,   553,   562,   573,   592,
+     643,   657,   679,   681,   686,   693,   696,   699,   708,   722,
+     739,   739,   753,   753,   763,   763,   774,   777,   783,   789,
+     792,   795,   798,   804,   809,   816,   824,   827,   833,   843,
+     853,   861,   872,   877,   885,   896,   901,   904,   910,   910,
+     961,   964,   967,   973,   973,   983,   989,   992,   995,   998,
+    1001,  1004,  1010,  1013,  1029,  1029,  1041,  1044,  1047,  1053,
+    1056,  1059,  1062,  1065,  1068,  1071,  1074,  1077,  1080,  1083,
+    1086,  1089,  1092,  1095,  1098,  1101,  1104,  1107,  1110,  1113,
+    1116,  1119,  1125,  1131,  1133,  1138,  1141,  1141,  1157,  1160,
+    1166,  1169,  1175,  1175,  1184,  1186,  1191,  1194,  1200,  1203,
+    1217,  1217,  1226,  1228,  1233,  1235,  1240,  1254,  1258,  1267,
+    1274,  1277,  1283,  1286,  1292,  1295,  1298,  1304,  1307,  1313,
+    1316,  1324,  1328,  1339,  1343,  1350,  1355,  1355,  1363,  1372,
+    1381,  1384,  1387,  1393,  1397,  1403,  1435,  1438,  1441,  1448,
+    1458,  1458,  1471,  1486,  1500,  1514,  1514,  1557,  1560,  1566,
+    1573,  1583,  1586,  1589,  1592,  1595,  1601,  1604,  1607,  1617,
+    1623,  1626,  1632,  1635,  1638,  1644
 };
 #endif
 
@@ -723,6 +726,7 @@ static const char *const yytname[] =
   "\"* operator\"", "\"/ operator\"", "\"% operator\"", "\"?\"", "\":\"",
   "\"::\"", "\"..\"", "\",\"", "\"(\"", "\")\"", "\"{\"", "\"}\"", "\"[\"",
   "\"]\"", "\"outbound modifier\"", "\"inbound modifier\"",
+  "\"SHORTEST_PATH keyword\"", "\"K_SHORTEST_PATHS keyword\"",
   "\"any modifier\"", "\"all modifier\"", "\"none modifier\"", "UMINUS",
   "UPLUS", "FUNCCALL", "REFERENCE", "INDEXED", "EXPANSION", "'.'",
   "$accept", "with_collection", "with_collection_list", "optional_with",
@@ -749,7 +753,7 @@ static const char *const yytname[] =
   "graph_collection_list", "graph_subject", "$@12", "graph_direction",
   "graph_direction_steps", "reference", "$@13", "$@14", "simple_value",
   "numeric_value", "value_literal", "collection_name", "bind_parameter",
-  "object_element_name", "variable_name", YY_NULLPTR
+  "object_element_name", "attribute_name", "variable_name", YY_NULLPTR
 };
 #endif
 
@@ -764,16 +768,17 @@ static const yytype_uint16 yytoknum[] =
      285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
      295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
      305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   316,   317,   318,   319,   320,   321,   322,   323,    46
+     315,   316,   317,   318,   319,   320,   321,   322,   323,   324,
+     325,    46
 };
 # endif
 
-#define YYPACT_NINF -296
+#define YYPACT_NINF -322
 
 #define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-296)))
+  (!!((Yystate) == (-322)))
 
-#define YYTABLE_NINF -208
+#define YYTABLE_NINF -213
 
 #define yytable_value_is_error(Yytable_value) \
   0
@@ -782,41 +787,44 @@ static const yytype_uint16 yytoknum[] =
      STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-       4,  -296,  -296,    22,   106,  -296,   363,  -296,  -296,  -296,
-    -296,   112,  -296,    13,    13,  1045,   129,    56,  -296,   205,
-    1045,  1045,  1045,  1045,  -296,  -296,  -296,  -296,  -296,  -296,
-      89,  -296,  -296,  -296,  -296,    11,    35,    41,    48,    72,
-     106,  -296,  -296,    12,    -1,  -296,    62,  -296,  -296,  -296,
-      30,  -296,  -296,  -296,  1045,  1045,  1045,  1045,  -296,  -296,
-     845,    38,  -296,  -296,  -296,  -296,  -296,  -296,  -296,   -29,
-    -296,  -296,  -296,  -296,  -296,   845,   104,  -296,   121,    13,
-     154,  1045,   131,  -296,  -296,   592,   592,  -296,   444,  -296,
-     483,  1045,    13,   121,   158,   154,  -296,   956,    13,    13,
-    1045,  -296,  -296,  -296,   628,  -296,    70,  1045,  1045,  1045,
-    1045,  1045,  1045,  1045,  1045,  1045,  1045,  1045,  1045,  1045,
-    1045,  1045,  1045,  1045,  1045,  -296,  -296,  -296,   139,   160,
-     140,   977,   113,  1045,   183,    13,   152,  -296,   159,  -296,
-     178,   121,   162,  -296,   368,   205,  1066,   161,   121,   121,
-    1045,   121,  1045,   121,   664,   180,  -296,   152,   121,  -296,
-     121,  -296,  -296,  -296,   519,  -296,  1045,    14,  -296,   845,
-    -296,   164,   166,  -296,   167,  1045,   182,   188,  -296,   196,
-     845,   192,   199,   255,   916,   881,   255,   181,   181,   426,
-     426,   426,   426,   150,   150,  -296,  -296,  -296,   700,   305,
-    1045,  1045,  1045,  1045,  1045,  1045,  1045,  1045,  -296,  1011,
-    -296,   737,   208,  -296,  -296,   845,    13,   159,  -296,    13,
-    1045,  -296,  1045,  -296,  -296,  -296,  -296,  -296,    25,   259,
-     337,  -296,  -296,  -296,  -296,  -296,  -296,  -296,   592,  -296,
-     592,  -296,  1045,  1045,    13,  -296,  -296,   234,  -296,   405,
-     956,    13,  -296,  1045,   773,  -296,    70,  1045,  -296,  1045,
-    1045,   255,   255,   181,   181,   426,   426,   426,   426,   845,
-     200,  -296,  -296,   203,  -296,  -296,   251,  -296,  -296,   845,
-    -296,   121,   121,   555,   845,   209,  -296,    97,  -296,   210,
-    -296,   119,  -296,   519,  1045,   264,   845,   236,  -296,   845,
-     845,   845,  -296,  -296,  1045,  1045,   273,  -296,  -296,  -296,
-    -296,  1045,    13,  -296,  -296,  -296,  -296,  -296,   405,   956,
-    1045,  -296,   845,  1045,   280,   592,  -296,   107,  -296,  1045,
-     845,   809,  1045,   231,   121,  -296,   238,   405,  1045,   845,
-    -296,  -296,   107,  -296,   845,  -296
+      17,  -322,  -322,    13,   -10,  -322,   915,  -322,  -322,  -322,
+    -322,    62,  -322,    20,    20,  1179,    93,     6,  -322,   251,
+    1179,  1179,  1179,  1179,  -322,  -322,  -322,  -322,  -322,  -322,
+     168,  -322,  -322,  -322,  -322,    12,    18,    28,    31,    34,
+     -10,  -322,  -322,    11,    19,  -322,    60,  -322,  -322,  -322,
+      47,  -322,  -322,  -322,  1179,  1179,  1179,  1179,  -322,  -322,
+    -322,  -322,  1016,    56,  -322,  -322,  -322,  -322,  -322,  -322,
+    -322,   -39,  -322,  -322,  -322,  -322,  -322,  -322,  1016,    77,
+    -322,    98,    20,   114,  1179,    81,  -322,  -322,   646,   646,
+    -322,   498,  -322,   537,  1179,    20,    98,   112,   114,  -322,
+    1080,    20,    20,  1179,  -322,  -322,  -322,   682,  -322,   166,
+    1179,  1179,  1179,  1179,  1179,  1179,  1179,  1179,  1179,  1179,
+    1179,  1179,  1179,  1179,  1179,  1179,  1179,  1179,  -322,  -322,
+    -322,   286,   122,    99,  1101,   172,  1179,   136,    20,   102,
+    -322,   108,  -322,   130,    98,   133,  -322,    14,   251,  1200,
+     198,    98,    98,  1179,    98,  1179,    98,   718,   158,  -322,
+     102,    98,  -322,    98,  -322,  -322,  -322,   573,    54,  1179,
+      15,  -322,  1016,  -322,   138,   152,  -322,   155,  1179,   165,
+     159,  -322,   181,  -322,  1016,   174,   183,   552,  1052,   308,
+     552,   173,   173,   197,   197,   197,   197,   204,   204,  -322,
+    -322,  -322,   754,   259,  1179,  1179,  1179,  1179,  1179,  1179,
+    1179,  1179,  -322,  1140,  -322,   791,   192,  -322,  -322,  -322,
+    1016,    20,   108,  -322,    20,  1179,  -322,  1179,  -322,  -322,
+    -322,  -322,  -322,   413,   264,   437,  -322,  -322,  -322,  -322,
+    -322,  -322,  -322,   646,  -322,   646,  -322,  1179,  1179,    20,
+    -322,  -322,   388,  -322,  1179,  1179,   459,  1080,    20,  -322,
+    1179,   827,  -322,   166,  1179,  -322,  1179,  1179,   552,   552,
+     173,   173,   197,   197,   197,   197,  1016,   185,  -322,  -322,
+     193,  -322,  -322,   240,  -322,  -322,  1016,  -322,    98,    98,
+     609,  1016,   200,  -322,   866,   905,    74,  -322,   202,    98,
+      67,  -322,   573,   195,  1179,   275,  1016,   241,  -322,  1016,
+    1016,  1016,  -322,  -322,  1179,  1179,   279,  -322,  -322,  -322,
+    -322,  1179,    20,  1179,  1179,  -322,  -322,  -322,  -322,  -322,
+    -322,  1179,   459,  1080,  1179,  -322,  1016,  1179,   285,   646,
+    -322,   459,   459,    68,   944,    98,  -322,  1179,  1016,   980,
+    1179,   236,    98,    98,    98,  -322,   243,  1179,  -322,   459,
+    1179,  1016,  -322,  -322,  -322,  -322,    68,   459,    98,  1016,
+    -322,    98,  -322,  -322
 };
 
   /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -824,69 +832,72 @@ static const yytype_int16 yypact[] =
      means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-       7,     8,    18,     0,     0,    10,     0,     1,     2,   206,
-       4,     9,     3,     0,     0,     0,     0,    41,    61,     0,
-       0,     0,     0,     0,    85,    11,    19,    20,    22,    21,
-      52,    23,    24,    25,    12,    26,    27,    28,    29,    30,
-       0,     6,   209,     0,    36,    37,     0,   200,   201,   202,
-     182,   198,   196,   197,     0,     0,     0,   187,   147,   139,
-      35,   101,   185,    93,    94,    95,   183,   137,   138,    97,
-     199,    96,   184,    90,    72,    92,     0,    59,   145,     0,
-      52,     0,    70,   194,   195,     0,     0,    79,     0,    82,
-       0,     0,     0,   145,   145,    52,     5,     0,     0,     0,
-       0,   105,   103,   104,     0,    18,   149,   141,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,    88,    87,    89,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,    43,    42,    49,
-       0,   145,    62,    63,    66,     0,     0,     0,   145,   145,
-       0,   145,     0,   145,     0,    53,    44,    57,   145,    47,
-     145,   177,   178,   179,    31,   180,     0,     0,    38,    39,
-     186,     0,   153,   208,     0,     0,     0,   150,   151,     0,
-     143,     0,   142,   119,   107,   106,   120,   113,   114,   115,
-     116,   117,   118,   108,   109,   110,   111,   112,     0,    98,
-       0,     0,     0,     0,     0,     0,     0,     0,   100,   133,
-     157,     0,   192,   189,   190,    91,     0,    60,   146,     0,
-       0,    45,     0,    67,    68,    65,    69,    71,   182,   198,
-     206,    73,   203,   204,   205,    74,    75,    76,     0,    77,
-       0,    80,     0,     0,     0,    48,    46,   179,   181,     0,
-       0,     0,   188,     0,     0,   148,     0,     0,   140,     0,
-       0,   127,   128,   121,   122,   123,   124,   125,   126,   132,
-       0,   135,    18,   131,   191,   158,   159,    40,    50,    51,
-      64,   145,   145,     0,    54,    58,    55,     0,   166,   172,
-      32,     0,   167,     0,     0,     0,   155,     0,   152,   154,
-     144,   129,   102,   134,   133,     0,   161,    78,    81,    83,
-      84,     0,     0,   176,   175,   173,   168,   169,     0,     0,
-       0,   136,   160,     0,   164,     0,    56,     0,    33,     0,
-     156,   162,     0,     0,   145,   170,   174,     0,     0,   165,
-     193,    86,     0,    34,   163,   171
+       7,     8,    18,     0,     0,    10,     0,     1,     2,   209,
+       4,     9,     3,     0,     0,     0,     0,    44,    64,     0,
+       0,     0,     0,     0,    88,    11,    19,    20,    22,    21,
+      55,    23,    24,    25,    12,    26,    27,    28,    29,    30,
+       0,     6,   215,     0,    39,    40,     0,   203,   204,   205,
+     185,   201,   199,   200,     0,     0,     0,   190,   150,   142,
+     213,   214,    38,   104,   188,    96,    97,    98,   186,   140,
+     141,   100,   202,    99,   187,   102,    93,    75,    95,     0,
+      62,   148,     0,    55,     0,    73,   197,   198,     0,     0,
+      82,     0,    85,     0,     0,     0,   148,   148,    55,     5,
+       0,     0,     0,     0,   108,   106,   107,     0,    18,   152,
+     144,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,    91,    90,
+      92,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+      46,    45,    52,     0,   148,    65,    66,    69,     0,     0,
+       0,   148,   148,     0,   148,     0,   148,     0,    56,    47,
+      60,   148,    50,   148,   180,   181,   182,    31,   183,     0,
+       0,    41,    42,   189,     0,   156,   211,     0,     0,     0,
+     153,   154,     0,   210,   146,     0,   145,   122,   110,   109,
+     123,   116,   117,   118,   119,   120,   121,   111,   112,   113,
+     114,   115,     0,   101,     0,     0,     0,     0,     0,     0,
+       0,     0,   103,   136,   160,     0,   195,   212,   193,   192,
+      94,     0,    63,   149,     0,     0,    48,     0,    70,    71,
+      68,    72,    74,   185,   201,   209,    76,   206,   207,   208,
+      77,    78,    79,     0,    80,     0,    83,     0,     0,     0,
+      51,    49,   182,   184,     0,     0,     0,     0,     0,   191,
+       0,     0,   151,     0,     0,   143,     0,     0,   130,   131,
+     124,   125,   126,   127,   128,   129,   135,     0,   138,    18,
+     134,   194,   161,   162,    43,    53,    54,    67,   148,   148,
+       0,    57,    61,    58,     0,     0,     0,   169,   175,   148,
+       0,   170,     0,   183,     0,     0,   158,     0,   155,   157,
+     147,   132,   105,   137,   136,     0,   164,    81,    84,    86,
+      87,     0,     0,     0,     0,   179,   178,   176,    32,   171,
+     172,     0,     0,     0,     0,   139,   163,     0,   167,     0,
+      59,     0,     0,     0,     0,   148,   183,     0,   159,   165,
+       0,     0,   148,   148,   148,   173,   177,     0,    33,     0,
+       0,   168,   196,    89,    35,    37,     0,     0,   148,   166,
+     174,   148,    34,    36
 };
 
   /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -296,    27,  -296,  -296,  -296,  -296,  -102,  -296,  -296,  -296,
-    -296,  -296,  -296,  -296,   191,   261,  -296,  -296,  -296,   171,
-      88,   -20,  -296,  -296,  -296,   278,  -296,  -296,  -296,  -296,
-      91,  -296,  -296,  -296,   -78,  -296,  -296,  -296,  -296,  -296,
-    -296,  -296,  -296,  -296,  -296,  -296,  -296,    -2,  -296,  -296,
-    -296,  -296,  -296,  -296,  -296,     7,  -296,  -296,  -296,  -296,
-    -296,  -296,  -296,   -92,   -99,  -296,  -296,  -296,    59,  -296,
-    -296,  -296,  -296,  -257,  -296,  -295,  -296,   -81,  -246,  -296,
-    -296,  -296,   -64,  -296,   -10,   169,    -4,  -296,    -8
+    -322,     0,  -322,  -322,  -322,  -322,   -99,  -322,  -322,  -322,
+    -322,  -322,  -322,  -322,   206,   265,  -322,  -322,  -322,   175,
+      73,    -3,  -322,  -322,  -322,   281,  -322,  -322,  -322,  -322,
+      87,  -322,  -322,  -322,   -85,  -322,  -322,  -322,  -322,  -322,
+    -322,  -322,  -322,  -322,  -322,  -322,  -322,    52,  -322,  -322,
+    -322,  -322,  -322,  -322,  -322,    16,  -322,  -322,  -322,  -322,
+    -322,  -322,  -322,    43,  -125,  -322,  -322,  -322,    66,  -322,
+    -322,  -322,  -322,  -321,  -322,  -230,  -322,   -67,  -247,  -322,
+    -322,  -322,    -6,  -322,   -14,   184,    -4,  -322,  -106,   -12
 };
 
   /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int16 yydefgoto[] =
 {
       -1,    10,    11,     2,     4,     3,     5,    25,     6,    26,
-      27,    28,    29,    44,    45,    78,    30,    79,    31,   138,
-     139,    94,   285,   158,   244,    80,   135,    32,    81,   142,
-     143,   225,    33,    34,   148,    35,    36,    87,    37,    89,
-      38,   311,    39,    91,   128,    74,   133,   144,    61,    62,
-     130,    63,    64,    65,   270,   271,   272,   273,    66,    67,
-     107,   181,   182,   137,    68,   106,   176,   177,   178,   212,
-     306,   324,   333,   289,   336,   290,   327,   291,   166,    69,
-     105,   276,    82,    70,    71,   231,    72,   179,   140
+      27,    28,    29,    44,    45,    81,    30,    82,    31,   141,
+     142,    97,   292,   161,   249,    83,   138,    32,    84,   145,
+     146,   230,    33,    34,   151,    35,    36,    90,    37,    92,
+      38,   321,    39,    94,   131,    77,   136,   147,    63,    64,
+     133,    65,    66,    67,   277,   278,   279,   280,    68,    69,
+     110,   185,   186,   140,    70,   109,   179,   180,   181,   216,
+     316,   338,   351,   298,   356,   299,   343,   300,   169,    71,
+     108,   283,    85,    72,    73,   236,    74,   182,    75,   143
 };
 
   /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -894,303 +905,335 @@ static const yytype_int16 yydefgoto[] =
      number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      12,   156,   159,   171,   294,    43,    46,    12,   149,    83,
-     151,   -13,   153,    60,    75,    84,   165,     1,    85,    86,
-      88,    90,     7,   328,    97,  -203,   250,   131,  -203,  -203,
-    -203,  -203,  -203,  -203,  -203,   -14,    12,   218,    41,    42,
-     132,   -15,   343,  -203,  -203,  -203,  -203,  -203,   -16,   221,
-      99,  -203,   101,   102,   103,   104,   236,   237,   218,   239,
-     141,   241,   -13,    98,   -13,   251,   245,    96,   246,    76,
-     335,    77,   -17,   329,   -99,   160,  -203,   -99,  -203,   -99,
-     226,   227,   -99,   248,   155,   345,   -14,   129,   -14,   154,
-     167,    46,   -15,   100,   -15,   164,   172,   173,   169,   -16,
-     174,   -16,    76,    92,    77,   180,   183,   184,   185,   186,
-     187,   188,   189,   190,   191,   192,   193,   194,   195,   196,
-     197,   198,   199,   -17,   313,   -17,   175,     9,   214,   211,
-     134,   215,     8,   288,    83,    83,     9,     9,     8,   213,
-      84,    84,     9,     9,   183,   316,    73,   136,   238,     9,
-     240,   200,    47,    48,    49,    50,    51,    52,    53,     9,
-     281,    54,   282,    40,   249,   161,   162,   163,    92,   165,
-     303,    55,    56,   254,   201,   202,   203,   204,   205,   206,
-     207,    57,   145,    58,   157,    59,   208,   232,   233,   307,
-     308,   234,   209,   108,   120,   121,   122,   216,   261,   262,
-     263,   264,   265,   266,   267,   268,    58,   269,   277,   220,
-     219,   243,   248,   222,  -207,   253,   111,   252,   279,   114,
-     115,   116,   117,   118,   119,   120,   121,   122,    47,    48,
-      49,   124,    51,    52,    53,     9,   286,   255,   165,   256,
-     283,   284,   341,   295,   257,   292,   -88,   334,   293,   258,
-     259,   296,   275,   302,   304,   299,   305,   300,   301,  -204,
-     312,   315,  -204,  -204,  -204,  -204,  -204,  -204,  -204,   -88,
-     -88,   -88,   -88,   -88,   -88,   -88,   319,  -204,  -204,  -204,
-    -204,  -204,   323,   314,   320,  -204,   332,   317,   340,   342,
-     168,    93,   318,   114,   115,   116,   117,   118,   119,   120,
-     121,   122,   269,   322,   326,   124,   217,   278,    95,   325,
-    -204,   321,  -204,   280,   292,   298,   235,   293,   330,     0,
-       0,   331,     0,   292,     0,     0,     0,   337,     0,     0,
-     339,     0,     0,   292,     0,     0,   344,  -205,   292,     0,
-    -205,  -205,  -205,  -205,  -205,  -205,  -205,   118,   119,   120,
-     121,   122,     0,     0,     0,  -205,  -205,  -205,  -205,  -205,
-       0,     0,     0,  -205,     0,     0,    13,    14,    15,    16,
-      17,    18,    19,     0,     0,     0,     0,     0,   223,   224,
-     108,    20,    21,    22,    23,    24,     0,     0,  -205,     0,
-    -205,    47,    48,    49,     0,    51,    52,    53,     9,     0,
-       0,   109,   110,   111,   112,   113,   114,   115,   116,   117,
-     118,   119,   120,   121,   122,   123,     0,   108,   124,     0,
-       0,   287,     0,     0,     0,     0,     0,     0,   125,   126,
-     127,   288,     0,     0,     0,     9,     0,     0,   109,   110,
-     111,   112,   113,   114,   115,   116,   117,   118,   119,   120,
-     121,   122,   123,     0,     0,   124,   146,   150,   147,     0,
-       0,     0,     0,   161,   162,   247,   126,   127,   118,   119,
-     120,   121,   122,     0,     0,     0,   124,   109,   110,   111,
+      12,    43,    46,   183,   152,    86,   154,    12,   156,   174,
+     304,    41,   -13,     7,   223,    87,     8,   134,   -14,    79,
+       9,    80,   355,   100,   228,   229,   111,   257,   -15,   219,
+       1,   -16,   135,   168,   -17,   223,    12,    47,    48,    49,
+      99,    51,    52,    53,     9,   370,    42,   112,   113,   114,
+     115,   116,   117,   118,   119,   120,   121,   122,   123,   124,
+     125,   126,   101,   -13,   127,   -13,   258,    62,    78,   -14,
+     102,   -14,    88,    89,    91,    93,   128,   129,   130,   -15,
+     144,   -15,   -16,   158,   -16,   -17,   347,   -17,     8,   170,
+      46,   103,     9,   329,   297,   163,  -212,     9,     9,  -212,
+     253,   325,   345,   137,     9,   132,   104,   105,   106,   107,
+      76,   353,   354,    40,   254,   255,    47,    48,    49,    50,
+      51,    52,    53,     9,   139,    54,   164,   165,    95,   368,
+     166,   218,   148,    86,    86,    55,    56,   371,   160,   159,
+     162,   231,   232,    87,    87,    57,   157,    58,   212,    59,
+     221,   213,   167,    60,    61,   172,    58,   183,   288,   224,
+     289,   225,   184,   187,   188,   189,   190,   191,   192,   193,
+     194,   195,   196,   197,   198,   199,   200,   201,   202,   203,
+     313,    79,    95,    80,   227,   111,   215,   226,   220,   248,
+     303,   259,   175,   176,   241,   242,   177,   244,   217,   246,
+    -212,   187,     9,   260,   250,   243,   251,   245,   114,   284,
+     263,   117,   118,   119,   120,   121,   122,   123,   124,   125,
+     262,   256,   178,   127,   237,   238,    60,    61,   239,   264,
+     261,   265,    60,    61,   266,   253,   282,   293,   312,   121,
+     122,   123,   124,   125,   314,   315,   305,   127,   123,   124,
+     125,   322,   301,   327,   352,   331,   268,   269,   270,   271,
+     272,   273,   274,   275,  -207,   276,   346,  -207,  -207,  -207,
+    -207,  -207,  -207,  -207,    47,    48,    49,   286,    51,    52,
+      53,     9,  -207,  -207,  -207,  -207,  -207,   333,   337,   334,
+    -207,   350,   326,   362,   366,    96,   330,   285,   204,   290,
+     291,   121,   122,   123,   124,   125,   294,   295,   171,   302,
+     340,    98,   306,   222,   287,  -207,   309,  -207,   310,   311,
+     111,   205,   206,   207,   208,   209,   210,   211,   301,   308,
+     335,   317,   318,     0,   240,     0,     0,   301,   301,   301,
+       0,   112,   328,   114,   115,   116,   117,   118,   119,   120,
+     121,   122,   123,   124,   125,   301,   332,     0,   127,     0,
+       0,     0,   301,   301,     0,     0,   276,   336,     0,     0,
+     128,   129,   130,   339,     0,   341,   342,     0,     0,     0,
+       0,     0,     0,   344,     0,   302,   348,     0,   358,   349,
+       0,     0,     0,     0,     0,   363,   364,   365,     0,   359,
+     -91,     0,   361,     0,     0,     0,     0,     0,     0,   367,
+       0,   372,   369,  -206,   373,     0,  -206,  -206,  -206,  -206,
+    -206,  -206,  -206,   -91,   -91,   -91,   -91,   -91,   -91,   -91,
+       0,  -206,  -206,  -206,  -206,  -206,     0,  -208,     0,  -206,
+    -208,  -208,  -208,  -208,  -208,  -208,  -208,     0,     0,     0,
+       0,     0,     0,     0,     0,  -208,  -208,  -208,  -208,  -208,
+       0,     0,  -212,  -208,  -206,  -212,  -206,     0,     0,     0,
+       0,   111,     0,     0,     0,   296,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,   297,     0,     0,  -208,     9,
+    -208,     0,   112,   113,   114,   115,   116,   117,   118,   119,
+     120,   121,   122,   123,   124,   125,   126,     0,     0,   127,
+     149,   153,   150,     0,     0,     0,     0,   164,   165,     0,
+       0,   252,   129,   130,     0,     0,     0,     0,     0,     0,
+       0,   112,   113,   114,   115,   116,   117,   118,   119,   120,
+     121,   122,   123,   124,   125,   126,     0,     0,   127,   149,
+     155,   150,     0,     0,     0,     0,     0,     0,     0,     0,
+     128,   129,   130,     0,     0,     0,     0,     0,     0,     0,
      112,   113,   114,   115,   116,   117,   118,   119,   120,   121,
-     122,   123,     0,     0,   124,   146,   152,   147,     0,     0,
-       0,     0,     0,     0,   125,   126,   127,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,   109,   110,   111,   112,
+     122,   123,   124,   125,   126,   111,     0,   127,     0,     0,
+     117,   118,   119,   120,   121,   122,   123,   124,   125,   128,
+     129,   130,   127,     0,     0,     0,   112,   113,   114,   115,
+     116,   117,   118,   119,   120,   121,   122,   123,   124,   125,
+     126,   111,     0,   127,     0,     0,     0,     0,     0,   319,
+     320,   164,   165,     0,     0,   252,   129,   130,     0,     0,
+       0,     0,   112,   113,   114,   115,   116,   117,   118,   119,
+     120,   121,   122,   123,   124,   125,   126,     0,   149,   127,
+     150,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,   128,   129,   130,     0,     0,     0,     0,     0,   112,
      113,   114,   115,   116,   117,   118,   119,   120,   121,   122,
-     123,   108,     0,   124,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,   125,   126,   127,     0,     0,     0,     0,
-       0,     0,   109,   110,   111,   112,   113,   114,   115,   116,
-     117,   118,   119,   120,   121,   122,   123,   108,     0,   124,
-       0,     0,     0,     0,     0,   309,   310,   161,   162,   247,
-     126,   127,     0,     0,     0,     0,     0,     0,   109,   110,
-     111,   112,   113,   114,   115,   116,   117,   118,   119,   120,
-     121,   122,   123,     0,   146,   124,   147,     0,     0,     0,
-       0,     0,     0,     0,     0,   125,   126,   127,     0,     0,
-       0,     0,     0,     0,     0,   109,   110,   111,   112,   113,
-     114,   115,   116,   117,   118,   119,   120,   121,   122,   123,
-     108,     0,   124,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,   125,   126,   127,     0,     0,     0,     0,     0,
-       0,   109,   110,   111,   112,   113,   114,   115,   116,   117,
-     118,   119,   120,   121,   122,   123,   108,     0,   124,     0,
-       0,   170,     0,   242,     0,     0,     0,     0,   125,   126,
-     127,     0,     0,     0,     0,     0,     0,   109,   110,   111,
+     123,   124,   125,   126,   111,     0,   127,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   128,   129,
+     130,     0,     0,     0,     0,   112,   113,   114,   115,   116,
+     117,   118,   119,   120,   121,   122,   123,   124,   125,   126,
+     111,     0,   127,     0,     0,   173,     0,   247,     0,     0,
+       0,     0,     0,     0,   128,   129,   130,     0,     0,     0,
+       0,   112,   113,   114,   115,   116,   117,   118,   119,   120,
+     121,   122,   123,   124,   125,   126,   111,     0,   127,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+     128,   129,   130,     0,     0,     0,     0,   112,   113,   114,
+     115,   116,   117,   118,   119,   120,   121,   122,   123,   124,
+     125,   126,   267,   111,   127,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,   128,   129,   130,     0,
+       0,     0,     0,     0,   112,   113,   114,   115,   116,   117,
+     118,   119,   120,   121,   122,   123,   124,   125,   126,   111,
+       0,   127,     0,     0,     0,     0,     0,     0,   281,     0,
+       0,     0,     0,   128,   129,   130,     0,     0,     0,     0,
      112,   113,   114,   115,   116,   117,   118,   119,   120,   121,
-     122,   123,   108,     0,   124,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,   125,   126,   127,     0,     0,     0,
-       0,     0,     0,   109,   110,   111,   112,   113,   114,   115,
-     116,   117,   118,   119,   120,   121,   122,   123,   260,   108,
-     124,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-     125,   126,   127,     0,     0,     0,     0,     0,     0,     0,
-     109,   110,   111,   112,   113,   114,   115,   116,   117,   118,
-     119,   120,   121,   122,   123,   108,     0,   124,     0,     0,
-       0,     0,     0,     0,   274,     0,     0,   125,   126,   127,
-       0,     0,     0,     0,     0,     0,   109,   110,   111,   112,
+     122,   123,   124,   125,   126,     0,     0,   127,   111,     0,
+       0,     0,     0,     0,   307,     0,     0,     0,     0,   128,
+     129,   130,   323,     0,     0,     0,     0,     0,     0,   112,
+     113,   114,   115,   116,   117,   118,   119,   120,   121,   122,
+     123,   124,   125,   126,     0,     0,   127,   111,    13,    14,
+      15,    16,    17,    18,    19,     0,     0,     0,   128,   129,
+     130,   324,     0,    20,    21,    22,    23,    24,   112,   113,
+     114,   115,   116,   117,   118,   119,   120,   121,   122,   123,
+     124,   125,   126,     0,     0,   127,   111,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,   128,   129,   130,
+     357,     0,     0,     0,     0,     0,     0,   112,   113,   114,
+     115,   116,   117,   118,   119,   120,   121,   122,   123,   124,
+     125,   126,   111,     0,   127,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,   128,   129,   130,     0,
+       0,     0,     0,   112,   113,   114,   115,   116,   117,   118,
+     119,   120,   121,   122,   123,   124,   125,   126,   111,     0,
+     127,   360,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,   128,   129,   130,     0,     0,     0,     0,   112,
      113,   114,   115,   116,   117,   118,   119,   120,   121,   122,
-     123,   108,     0,   124,     0,     0,     0,     0,     0,     0,
-     297,     0,     0,   125,   126,   127,     0,     0,     0,     0,
-       0,     0,   109,   110,   111,   112,   113,   114,   115,   116,
-     117,   118,   119,   120,   121,   122,   123,   108,     0,   124,
-     338,     0,     0,     0,     0,     0,     0,     0,     0,   125,
-     126,   127,     0,     0,     0,     0,     0,     0,   109,   110,
-     111,   112,   113,   114,   115,   116,   117,   118,   119,   120,
-     121,   122,   123,   108,     0,   124,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,   125,   126,   127,     0,     0,
-       0,     0,     0,     0,   109,     0,   111,   112,   113,   114,
-     115,   116,   117,   118,   119,   120,   121,   122,   108,     0,
-       0,   124,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,   125,   126,   127,     0,     0,     0,     0,     0,     0,
-       0,   111,   112,   113,   114,   115,   116,   117,   118,   119,
-     120,   121,   122,     0,     0,     0,   124,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,   125,   126,   127,    47,
-      48,    49,    50,    51,    52,    53,     9,     0,    54,     0,
-       0,     0,     0,     0,     0,     0,     0,     0,    55,    56,
-      47,    48,    49,    50,    51,    52,    53,     9,    57,    54,
-      58,     0,    59,     0,   161,   162,   163,     0,     0,    55,
-      56,   210,     0,     0,     0,     0,     0,     0,     0,    57,
-       0,    58,     0,    59,    47,    48,    49,    50,    51,    52,
-      53,     9,     0,    54,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,    55,    56,     0,     0,     0,     0,     0,
-       0,     0,     0,    57,  -130,    58,     0,    59,    47,    48,
-      49,    50,    51,    52,    53,     9,     0,    54,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,    55,    56,    47,
-      48,    49,   228,   229,    52,    53,   230,    57,    54,    58,
-       0,    59,     0,     0,     0,     0,     0,     0,    55,    56,
-       0,     0,     0,     0,     0,     0,     0,     0,    57,     0,
-      58,     0,    59
+     123,   124,   125,   126,   111,     0,   127,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   128,   129,
+     130,     0,     0,     0,     0,     0,     0,   114,   115,   116,
+     117,   118,   119,   120,   121,   122,   123,   124,   125,     0,
+       0,     0,   127,    47,    48,    49,    50,    51,    52,    53,
+       9,     0,    54,     0,   128,   129,   130,     0,     0,     0,
+       0,     0,    55,    56,    47,    48,    49,    50,    51,    52,
+      53,     9,    57,    54,    58,     0,    59,     0,   164,   165,
+      60,    61,   166,    55,    56,   214,     0,     0,     0,     0,
+       0,     0,     0,    57,     0,    58,     0,    59,     0,     0,
+       0,    60,    61,    47,    48,    49,    50,    51,    52,    53,
+       9,     0,    54,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    55,    56,     0,     0,     0,     0,     0,     0,
+       0,     0,    57,  -133,    58,     0,    59,     0,     0,     0,
+      60,    61,    47,    48,    49,    50,    51,    52,    53,     9,
+       0,    54,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,    55,    56,    47,    48,    49,   233,   234,    52,    53,
+     235,    57,    54,    58,     0,    59,     0,     0,     0,    60,
+      61,     0,    55,    56,     0,     0,     0,     0,     0,     0,
+       0,     0,    57,     0,    58,     0,    59,     0,     0,     0,
+      60,    61
 };
 
 static const yytype_int16 yycheck[] =
 {
-       4,    93,    94,   105,   250,    13,    14,    11,    86,    19,
-      88,     0,    90,    15,    16,    19,    97,    13,    20,    21,
-      22,    23,     0,   318,    12,     0,    12,    56,     3,     4,
-       5,     6,     7,     8,     9,     0,    40,   136,    11,    26,
-      69,     0,   337,    18,    19,    20,    21,    22,     0,   141,
-      51,    26,    54,    55,    56,    57,   148,   149,   157,   151,
-      80,   153,    51,    51,    53,    51,   158,    40,   160,    13,
-     327,    15,     0,   319,    49,    95,    51,    52,    53,    49,
-     144,   145,    52,   164,    92,   342,    51,    49,    53,    91,
-      98,    99,    51,    31,    53,    97,    26,    27,   100,    51,
-      30,    53,    13,    14,    15,   107,   108,   109,   110,   111,
-     112,   113,   114,   115,   116,   117,   118,   119,   120,   121,
-     122,   123,   124,    51,    27,    53,    56,    30,   132,   131,
-      26,   133,    26,    26,   144,   145,    30,    30,    26,    26,
-     144,   145,    30,    30,   146,    26,    17,    26,   150,    30,
-     152,    12,    23,    24,    25,    26,    27,    28,    29,    30,
-     238,    32,   240,    51,   166,    58,    59,    60,    14,   250,
-     272,    42,    43,   175,    35,    36,    37,    38,    39,    40,
-      41,    52,    51,    54,    26,    56,    26,    26,    27,   281,
-     282,    30,    52,    12,    44,    45,    46,    14,   200,   201,
-     202,   203,   204,   205,   206,   207,    54,   209,   216,    31,
-      51,    31,   293,    51,    48,    48,    35,    53,   220,    38,
-      39,    40,    41,    42,    43,    44,    45,    46,    23,    24,
-      25,    50,    27,    28,    29,    30,   244,    55,   319,    51,
-     242,   243,   334,   251,    48,   249,    12,   325,   250,    57,
-      51,   253,    44,    53,    51,   257,     5,   259,   260,     0,
-      51,    51,     3,     4,     5,     6,     7,     8,     9,    35,
-      36,    37,    38,    39,    40,    41,    12,    18,    19,    20,
-      21,    22,     9,   287,    48,    26,     6,   291,    57,    51,
-      99,    30,   294,    38,    39,    40,    41,    42,    43,    44,
-      45,    46,   304,   305,   312,    50,   135,   219,    30,   311,
-      51,   304,    53,   222,   318,   256,   147,   319,   320,    -1,
-      -1,   323,    -1,   327,    -1,    -1,    -1,   329,    -1,    -1,
-     332,    -1,    -1,   337,    -1,    -1,   338,     0,   342,    -1,
-       3,     4,     5,     6,     7,     8,     9,    42,    43,    44,
-      45,    46,    -1,    -1,    -1,    18,    19,    20,    21,    22,
-      -1,    -1,    -1,    26,    -1,    -1,     3,     4,     5,     6,
-       7,     8,     9,    -1,    -1,    -1,    -1,    -1,    10,    11,
-      12,    18,    19,    20,    21,    22,    -1,    -1,    51,    -1,
-      53,    23,    24,    25,    -1,    27,    28,    29,    30,    -1,
-      -1,    33,    34,    35,    36,    37,    38,    39,    40,    41,
-      42,    43,    44,    45,    46,    47,    -1,    12,    50,    -1,
-      -1,    16,    -1,    -1,    -1,    -1,    -1,    -1,    60,    61,
-      62,    26,    -1,    -1,    -1,    30,    -1,    -1,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
-      45,    46,    47,    -1,    -1,    50,    12,    13,    14,    -1,
-      -1,    -1,    -1,    58,    59,    60,    61,    62,    42,    43,
-      44,    45,    46,    -1,    -1,    -1,    50,    33,    34,    35,
+       4,    13,    14,   109,    89,    19,    91,    11,    93,   108,
+     257,    11,     0,     0,   139,    19,    26,    56,     0,    13,
+      30,    15,   343,    12,    10,    11,    12,    12,     0,   135,
+      13,     0,    71,   100,     0,   160,    40,    23,    24,    25,
+      40,    27,    28,    29,    30,   366,    26,    33,    34,    35,
       36,    37,    38,    39,    40,    41,    42,    43,    44,    45,
-      46,    47,    -1,    -1,    50,    12,    13,    14,    -1,    -1,
-      -1,    -1,    -1,    -1,    60,    61,    62,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    33,    34,    35,    36,
+      46,    47,    51,    51,    50,    53,    51,    15,    16,    51,
+      51,    53,    20,    21,    22,    23,    62,    63,    64,    51,
+      83,    53,    51,    95,    53,    51,   333,    53,    26,   101,
+     102,    31,    30,    26,    26,    98,    49,    30,    30,    52,
+     167,    27,   332,    26,    30,    49,    54,    55,    56,    57,
+      17,   341,   342,    51,    60,    61,    23,    24,    25,    26,
+      27,    28,    29,    30,    26,    32,    58,    59,    14,   359,
+      62,   135,    51,   147,   148,    42,    43,   367,    26,    96,
+      97,   147,   148,   147,   148,    52,    94,    54,    26,    56,
+      14,    52,   100,    60,    61,   103,    54,   263,   243,    51,
+     245,    31,   110,   111,   112,   113,   114,   115,   116,   117,
+     118,   119,   120,   121,   122,   123,   124,   125,   126,   127,
+     279,    13,    14,    15,    51,    12,   134,   144,   136,    31,
+     257,    53,    26,    27,   151,   152,    30,   154,    26,   156,
+      48,   149,    30,    48,   161,   153,   163,   155,    35,   221,
+      51,    38,    39,    40,    41,    42,    43,    44,    45,    46,
+      55,   169,    56,    50,    26,    27,    60,    61,    30,    48,
+     178,    57,    60,    61,    51,   302,    44,   249,    53,    42,
+      43,    44,    45,    46,    51,     5,   258,    50,    44,    45,
+      46,    51,   256,    51,   339,    60,   204,   205,   206,   207,
+     208,   209,   210,   211,     0,   213,   333,     3,     4,     5,
+       6,     7,     8,     9,    23,    24,    25,   225,    27,    28,
+      29,    30,    18,    19,    20,    21,    22,    12,     9,    48,
+      26,     6,   296,    57,    51,    30,   300,   224,    12,   247,
+     248,    42,    43,    44,    45,    46,   254,   255,   102,   257,
+     322,    30,   260,   138,   227,    51,   264,    53,   266,   267,
+      12,    35,    36,    37,    38,    39,    40,    41,   332,   263,
+     314,   288,   289,    -1,   150,    -1,    -1,   341,   342,   343,
+      -1,    33,   299,    35,    36,    37,    38,    39,    40,    41,
+      42,    43,    44,    45,    46,   359,   304,    -1,    50,    -1,
+      -1,    -1,   366,   367,    -1,    -1,   314,   315,    -1,    -1,
+      62,    63,    64,   321,    -1,   323,   324,    -1,    -1,    -1,
+      -1,    -1,    -1,   331,    -1,   333,   334,    -1,   345,   337,
+      -1,    -1,    -1,    -1,    -1,   352,   353,   354,    -1,   347,
+      12,    -1,   350,    -1,    -1,    -1,    -1,    -1,    -1,   357,
+      -1,   368,   360,     0,   371,    -1,     3,     4,     5,     6,
+       7,     8,     9,    35,    36,    37,    38,    39,    40,    41,
+      -1,    18,    19,    20,    21,    22,    -1,     0,    -1,    26,
+       3,     4,     5,     6,     7,     8,     9,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    18,    19,    20,    21,    22,
+      -1,    -1,    49,    26,    51,    52,    53,    -1,    -1,    -1,
+      -1,    12,    -1,    -1,    -1,    16,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    26,    -1,    -1,    51,    30,
+      53,    -1,    33,    34,    35,    36,    37,    38,    39,    40,
+      41,    42,    43,    44,    45,    46,    47,    -1,    -1,    50,
+      12,    13,    14,    -1,    -1,    -1,    -1,    58,    59,    -1,
+      -1,    62,    63,    64,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    33,    34,    35,    36,    37,    38,    39,    40,    41,
+      42,    43,    44,    45,    46,    47,    -1,    -1,    50,    12,
+      13,    14,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      62,    63,    64,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
+      43,    44,    45,    46,    47,    12,    -1,    50,    -1,    -1,
+      38,    39,    40,    41,    42,    43,    44,    45,    46,    62,
+      63,    64,    50,    -1,    -1,    -1,    33,    34,    35,    36,
       37,    38,    39,    40,    41,    42,    43,    44,    45,    46,
-      47,    12,    -1,    50,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    60,    61,    62,    -1,    -1,    -1,    -1,
+      47,    12,    -1,    50,    -1,    -1,    -1,    -1,    -1,    20,
+      21,    58,    59,    -1,    -1,    62,    63,    64,    -1,    -1,
       -1,    -1,    33,    34,    35,    36,    37,    38,    39,    40,
-      41,    42,    43,    44,    45,    46,    47,    12,    -1,    50,
-      -1,    -1,    -1,    -1,    -1,    20,    21,    58,    59,    60,
-      61,    62,    -1,    -1,    -1,    -1,    -1,    -1,    33,    34,
-      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
-      45,    46,    47,    -1,    12,    50,    14,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    60,    61,    62,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    33,    34,    35,    36,    37,
+      41,    42,    43,    44,    45,    46,    47,    -1,    12,    50,
+      14,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    62,    63,    64,    -1,    -1,    -1,    -1,    -1,    33,
+      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
+      44,    45,    46,    47,    12,    -1,    50,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    62,    63,
+      64,    -1,    -1,    -1,    -1,    33,    34,    35,    36,    37,
       38,    39,    40,    41,    42,    43,    44,    45,    46,    47,
-      12,    -1,    50,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    60,    61,    62,    -1,    -1,    -1,    -1,    -1,
+      12,    -1,    50,    -1,    -1,    53,    -1,    19,    -1,    -1,
+      -1,    -1,    -1,    -1,    62,    63,    64,    -1,    -1,    -1,
       -1,    33,    34,    35,    36,    37,    38,    39,    40,    41,
       42,    43,    44,    45,    46,    47,    12,    -1,    50,    -1,
-      -1,    53,    -1,    19,    -1,    -1,    -1,    -1,    60,    61,
-      62,    -1,    -1,    -1,    -1,    -1,    -1,    33,    34,    35,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      62,    63,    64,    -1,    -1,    -1,    -1,    33,    34,    35,
       36,    37,    38,    39,    40,    41,    42,    43,    44,    45,
-      46,    47,    12,    -1,    50,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    60,    61,    62,    -1,    -1,    -1,
-      -1,    -1,    -1,    33,    34,    35,    36,    37,    38,    39,
-      40,    41,    42,    43,    44,    45,    46,    47,    48,    12,
-      50,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      60,    61,    62,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      46,    47,    48,    12,    50,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    62,    63,    64,    -1,
+      -1,    -1,    -1,    -1,    33,    34,    35,    36,    37,    38,
+      39,    40,    41,    42,    43,    44,    45,    46,    47,    12,
+      -1,    50,    -1,    -1,    -1,    -1,    -1,    -1,    57,    -1,
+      -1,    -1,    -1,    62,    63,    64,    -1,    -1,    -1,    -1,
       33,    34,    35,    36,    37,    38,    39,    40,    41,    42,
-      43,    44,    45,    46,    47,    12,    -1,    50,    -1,    -1,
-      -1,    -1,    -1,    -1,    57,    -1,    -1,    60,    61,    62,
-      -1,    -1,    -1,    -1,    -1,    -1,    33,    34,    35,    36,
-      37,    38,    39,    40,    41,    42,    43,    44,    45,    46,
-      47,    12,    -1,    50,    -1,    -1,    -1,    -1,    -1,    -1,
-      57,    -1,    -1,    60,    61,    62,    -1,    -1,    -1,    -1,
-      -1,    -1,    33,    34,    35,    36,    37,    38,    39,    40,
-      41,    42,    43,    44,    45,    46,    47,    12,    -1,    50,
-      51,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    60,
-      61,    62,    -1,    -1,    -1,    -1,    -1,    -1,    33,    34,
+      43,    44,    45,    46,    47,    -1,    -1,    50,    12,    -1,
+      -1,    -1,    -1,    -1,    57,    -1,    -1,    -1,    -1,    62,
+      63,    64,    26,    -1,    -1,    -1,    -1,    -1,    -1,    33,
+      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
+      44,    45,    46,    47,    -1,    -1,    50,    12,     3,     4,
+       5,     6,     7,     8,     9,    -1,    -1,    -1,    62,    63,
+      64,    26,    -1,    18,    19,    20,    21,    22,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
-      45,    46,    47,    12,    -1,    50,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    60,    61,    62,    -1,    -1,
-      -1,    -1,    -1,    -1,    33,    -1,    35,    36,    37,    38,
-      39,    40,    41,    42,    43,    44,    45,    46,    12,    -1,
-      -1,    50,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    60,    61,    62,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    35,    36,    37,    38,    39,    40,    41,    42,    43,
-      44,    45,    46,    -1,    -1,    -1,    50,    -1,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    60,    61,    62,    23,
-      24,    25,    26,    27,    28,    29,    30,    -1,    32,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    42,    43,
-      23,    24,    25,    26,    27,    28,    29,    30,    52,    32,
-      54,    -1,    56,    -1,    58,    59,    60,    -1,    -1,    42,
-      43,    44,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    52,
-      -1,    54,    -1,    56,    23,    24,    25,    26,    27,    28,
-      29,    30,    -1,    32,    -1,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    42,    43,    -1,    -1,    -1,    -1,    -1,
-      -1,    -1,    -1,    52,    53,    54,    -1,    56,    23,    24,
-      25,    26,    27,    28,    29,    30,    -1,    32,    -1,    -1,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    42,    43,    23,
-      24,    25,    26,    27,    28,    29,    30,    52,    32,    54,
-      -1,    56,    -1,    -1,    -1,    -1,    -1,    -1,    42,    43,
-      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    52,    -1,
-      54,    -1,    56
+      45,    46,    47,    -1,    -1,    50,    12,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    62,    63,    64,
+      26,    -1,    -1,    -1,    -1,    -1,    -1,    33,    34,    35,
+      36,    37,    38,    39,    40,    41,    42,    43,    44,    45,
+      46,    47,    12,    -1,    50,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    62,    63,    64,    -1,
+      -1,    -1,    -1,    33,    34,    35,    36,    37,    38,    39,
+      40,    41,    42,    43,    44,    45,    46,    47,    12,    -1,
+      50,    51,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    62,    63,    64,    -1,    -1,    -1,    -1,    33,
+      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
+      44,    45,    46,    47,    12,    -1,    50,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    62,    63,
+      64,    -1,    -1,    -1,    -1,    -1,    -1,    35,    36,    37,
+      38,    39,    40,    41,    42,    43,    44,    45,    46,    -1,
+      -1,    -1,    50,    23,    24,    25,    26,    27,    28,    29,
+      30,    -1,    32,    -1,    62,    63,    64,    -1,    -1,    -1,
+      -1,    -1,    42,    43,    23,    24,    25,    26,    27,    28,
+      29,    30,    52,    32,    54,    -1,    56,    -1,    58,    59,
+      60,    61,    62,    42,    43,    44,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    52,    -1,    54,    -1,    56,    -1,    -1,
+      -1,    60,    61,    23,    24,    25,    26,    27,    28,    29,
+      30,    -1,    32,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    42,    43,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    52,    53,    54,    -1,    56,    -1,    -1,    -1,
+      60,    61,    23,    24,    25,    26,    27,    28,    29,    30,
+      -1,    32,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    42,    43,    23,    24,    25,    26,    27,    28,    29,
+      30,    52,    32,    54,    -1,    56,    -1,    -1,    -1,    60,
+      61,    -1,    42,    43,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    52,    -1,    54,    -1,    56,    -1,    -1,    -1,
+      60,    61
 };
 
   /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
      symbol of state STATE-NUM.  */
 static const yytype_uint8 yystos[] =
 {
-       0,    13,    73,    75,    74,    76,    78,     0,    26,    30,
-      71,    72,   156,     3,     4,     5,     6,     7,     8,     9,
-      18,    19,    20,    21,    22,    77,    79,    80,    81,    82,
-      86,    88,    97,   102,   103,   105,   106,   108,   110,   112,
-      51,    71,    26,   158,    83,    84,   158,    23,    24,    25,
+       0,    13,    75,    77,    76,    78,    80,     0,    26,    30,
+      73,    74,   158,     3,     4,     5,     6,     7,     8,     9,
+      18,    19,    20,    21,    22,    79,    81,    82,    83,    84,
+      88,    90,    99,   104,   105,   107,   108,   110,   112,   114,
+      51,    73,    26,   161,    85,    86,   161,    23,    24,    25,
       26,    27,    28,    29,    32,    42,    43,    52,    54,    56,
-     117,   118,   119,   121,   122,   123,   128,   129,   134,   149,
-     153,   154,   156,    17,   115,   117,    13,    15,    85,    87,
-      95,    98,   152,   154,   156,   117,   117,   107,   117,   109,
-     117,   113,    14,    85,    91,    95,    71,    12,    51,    51,
-      31,   117,   117,   117,   117,   150,   135,   130,    12,    33,
-      34,    35,    36,    37,    38,    39,    40,    41,    42,    43,
-      44,    45,    46,    47,    50,    60,    61,    62,   114,    49,
-     120,    56,    69,   116,    26,    96,    26,   133,    89,    90,
-     158,    91,    99,   100,   117,    51,    12,    14,   104,   104,
-      13,   104,    13,   104,   117,   158,   133,    26,    93,   133,
-      91,    58,    59,    60,   117,   147,   148,   158,    84,   117,
-      53,    76,    26,    27,    30,    56,   136,   137,   138,   157,
-     117,   131,   132,   117,   117,   117,   117,   117,   117,   117,
-     117,   117,   117,   117,   117,   117,   117,   117,   117,   117,
-      12,    35,    36,    37,    38,    39,    40,    41,    26,    52,
-      44,   117,   139,    26,   156,   117,    14,    89,   134,    51,
-      31,   133,    51,    10,    11,   101,   152,   152,    26,    27,
-      30,   155,    26,    27,    30,   155,   133,   133,   117,   133,
-     117,   133,    19,    31,    94,   133,   133,    60,   147,   117,
-      12,    51,    53,    48,   117,    55,    51,    48,    57,    51,
-      48,   117,   117,   117,   117,   117,   117,   117,   117,   117,
-     124,   125,   126,   127,    57,    44,   151,   158,    90,   117,
-     100,   104,   104,   117,   117,    92,   158,    16,    26,   143,
-     145,   147,   156,   117,   148,   158,   117,    57,   138,   117,
-     117,   117,    53,    76,    51,     5,   140,   133,   133,    20,
-      21,   111,    51,    27,   156,    51,    26,   156,   117,    12,
-      48,   125,   117,     9,   141,   117,   158,   146,   145,   148,
-     117,   117,     6,   142,   104,   143,   144,   117,    51,   117,
-      57,   133,    51,   145,   117,   143
+      60,    61,   119,   120,   121,   123,   124,   125,   130,   131,
+     136,   151,   155,   156,   158,   160,    17,   117,   119,    13,
+      15,    87,    89,    97,   100,   154,   156,   158,   119,   119,
+     109,   119,   111,   119,   115,    14,    87,    93,    97,    73,
+      12,    51,    51,    31,   119,   119,   119,   119,   152,   137,
+     132,    12,    33,    34,    35,    36,    37,    38,    39,    40,
+      41,    42,    43,    44,    45,    46,    47,    50,    62,    63,
+      64,   116,    49,   122,    56,    71,   118,    26,    98,    26,
+     135,    91,    92,   161,    93,   101,   102,   119,    51,    12,
+      14,   106,   106,    13,   106,    13,   106,   119,   161,   135,
+      26,    95,   135,    93,    58,    59,    62,   119,   149,   150,
+     161,    86,   119,    53,    78,    26,    27,    30,    56,   138,
+     139,   140,   159,   160,   119,   133,   134,   119,   119,   119,
+     119,   119,   119,   119,   119,   119,   119,   119,   119,   119,
+     119,   119,   119,   119,    12,    35,    36,    37,    38,    39,
+      40,    41,    26,    52,    44,   119,   141,    26,   158,   160,
+     119,    14,    91,   136,    51,    31,   135,    51,    10,    11,
+     103,   154,   154,    26,    27,    30,   157,    26,    27,    30,
+     157,   135,   135,   119,   135,   119,   135,    19,    31,    96,
+     135,   135,    62,   149,    60,    61,   119,    12,    51,    53,
+      48,   119,    55,    51,    48,    57,    51,    48,   119,   119,
+     119,   119,   119,   119,   119,   119,   119,   126,   127,   128,
+     129,    57,    44,   153,   161,    92,   119,   102,   106,   106,
+     119,   119,    94,   161,   119,   119,    16,    26,   145,   147,
+     149,   158,   119,   149,   150,   161,   119,    57,   140,   119,
+     119,   119,    53,    78,    51,     5,   142,   135,   135,    20,
+      21,   113,    51,    26,    26,    27,   158,    51,   135,    26,
+     158,    60,   119,    12,    48,   127,   119,     9,   143,   119,
+     161,   119,   119,   148,   119,   147,   149,   150,   119,   119,
+       6,   144,   106,   147,   147,   145,   146,    26,   135,   119,
+      51,   119,    57,   135,   135,   135,    51,   119,   147,   119,
+     145,   147,   135,   135
 };
 
   /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
 static const yytype_uint8 yyr1[] =
 {
-       0,    70,    71,    71,    72,    72,    72,    73,    74,    73,
-      75,    76,    77,    77,    77,    77,    77,    77,    78,    78,
-      79,    79,    79,    79,    79,    79,    79,    79,    79,    79,
-      79,    80,    80,    80,    80,    81,    82,    83,    83,    84,
-      85,    87,    86,    88,    88,    88,    88,    88,    88,    89,
-      89,    90,    91,    91,    91,    92,    92,    94,    93,    96,
-      95,    98,    97,    99,    99,   100,   101,   101,   101,   101,
-     102,   102,   103,   104,   104,   105,   106,   107,   107,   108,
-     109,   109,   110,   111,   111,   113,   112,   114,   114,   114,
-     116,   115,   115,   117,   117,   117,   117,   117,   117,   118,
-     118,   120,   119,   121,   121,   121,   122,   122,   122,   122,
-     122,   122,   122,   122,   122,   122,   122,   122,   122,   122,
-     122,   122,   122,   122,   122,   122,   122,   122,   122,   123,
-     124,   124,   125,   126,   125,   127,   127,   128,   128,   130,
-     129,   131,   131,   132,   132,   133,   133,   135,   134,   136,
-     136,   137,   137,   138,   138,   138,   138,   139,   139,   140,
-     140,   141,   141,   141,   142,   142,   143,   143,   143,   143,
-     144,   144,   145,   146,   145,   145,   145,   147,   147,   147,
-     148,   148,   149,   149,   149,   149,   149,   150,   149,   149,
-     149,   149,   151,   149,   152,   152,   153,   153,   154,   154,
-     154,   154,   154,   155,   155,   155,   156,   157,   157,   158
+       0,    72,    73,    73,    74,    74,    74,    75,    76,    75,
+      77,    78,    79,    79,    79,    79,    79,    79,    80,    80,
+      81,    81,    81,    81,    81,    81,    81,    81,    81,    81,
+      81,    82,    82,    82,    82,    82,    82,    82,    83,    84,
+      85,    85,    86,    87,    89,    88,    90,    90,    90,    90,
+      90,    90,    91,    91,    92,    93,    93,    93,    94,    94,
+      96,    95,    98,    97,   100,    99,   101,   101,   102,   103,
+     103,   103,   103,   104,   104,   105,   106,   106,   107,   108,
+     109,   109,   110,   111,   111,   112,   113,   113,   115,   114,
+     116,   116,   116,   118,   117,   117,   119,   119,   119,   119,
+     119,   119,   120,   120,   122,   121,   123,   123,   123,   124,
+     124,   124,   124,   124,   124,   124,   124,   124,   124,   124,
+     124,   124,   124,   124,   124,   124,   124,   124,   124,   124,
+     124,   124,   125,   126,   126,   127,   128,   127,   129,   129,
+     130,   130,   132,   131,   133,   133,   134,   134,   135,   135,
+     137,   136,   138,   138,   139,   139,   140,   140,   140,   140,
+     141,   141,   142,   142,   143,   143,   143,   144,   144,   145,
+     145,   145,   145,   146,   146,   147,   148,   147,   147,   147,
+     149,   149,   149,   150,   150,   151,   151,   151,   151,   151,
+     152,   151,   151,   151,   151,   153,   151,   154,   154,   155,
+     155,   156,   156,   156,   156,   156,   157,   157,   157,   158,
+     159,   159,   160,   160,   160,   161
 };
 
   /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
@@ -1199,24 +1242,25 @@ static const yytype_uint8 yyr2[] =
        0,     2,     1,     1,     1,     3,     2,     0,     0,     3,
        2,     2,     1,     1,     1,     1,     1,     1,     0,     2,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     4,     6,     8,    10,     2,     2,     1,     3,     3,
-       4,     0,     3,     3,     3,     4,     4,     3,     4,     1,
-       3,     3,     0,     2,     4,     1,     3,     0,     3,     0,
-       3,     0,     3,     1,     3,     2,     0,     1,     1,     1,
-       2,     4,     2,     2,     2,     4,     4,     3,     5,     2,
-       3,     5,     2,     1,     1,     0,     9,     1,     1,     1,
-       0,     3,     1,     1,     1,     1,     1,     1,     3,     1,
-       3,     0,     5,     2,     2,     2,     3,     3,     3,     3,
+       1,     4,     7,     9,    11,    10,    12,    10,     2,     2,
+       1,     3,     3,     4,     0,     3,     3,     3,     4,     4,
+       3,     4,     1,     3,     3,     0,     2,     4,     1,     3,
+       0,     3,     0,     3,     0,     3,     1,     3,     2,     0,
+       1,     1,     1,     2,     4,     2,     2,     2,     4,     4,
+       3,     5,     2,     3,     5,     2,     1,     1,     0,     9,
+       1,     1,     1,     0,     3,     1,     1,     1,     1,     1,
+       1,     3,     1,     3,     0,     5,     2,     2,     2,     3,
        3,     3,     3,     3,     3,     3,     3,     3,     3,     3,
-       3,     4,     4,     4,     4,     4,     4,     4,     4,     5,
-       0,     1,     1,     0,     2,     1,     3,     1,     1,     0,
-       4,     0,     1,     1,     3,     0,     2,     0,     4,     0,
-       1,     1,     3,     1,     3,     3,     5,     1,     2,     0,
-       2,     0,     2,     4,     0,     2,     1,     1,     2,     2,
-       1,     3,     1,     0,     4,     2,     2,     1,     1,     1,
-       1,     2,     1,     1,     1,     1,     3,     0,     4,     3,
-       3,     4,     0,     8,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     1
+       3,     3,     3,     3,     4,     4,     4,     4,     4,     4,
+       4,     4,     5,     0,     1,     1,     0,     2,     1,     3,
+       1,     1,     0,     4,     0,     1,     1,     3,     0,     2,
+       0,     4,     0,     1,     1,     3,     1,     3,     3,     5,
+       1,     2,     0,     2,     0,     2,     4,     0,     2,     1,
+       1,     2,     2,     1,     3,     1,     0,     4,     2,     2,
+       1,     1,     1,     1,     2,     1,     1,     1,     1,     3,
+       0,     4,     3,     3,     4,     0,     8,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1
 };
 
 
@@ -1994,15 +2038,15 @@ yyreduce:
   switch (yyn)
     {
         case 2:
-#line 335 "Aql/grammar.y" /* yacc.c:1661  */
+#line 341 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeValueString((yyvsp[0].strval).value, (yyvsp[0].strval).length);
     }
-#line 2002 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2046 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 3:
-#line 338 "Aql/grammar.y" /* yacc.c:1661  */
+#line 344 "Aql/grammar.y" /* yacc.c:1661  */
     {
       char const* p = (yyvsp[0].node)->getStringValue();
       size_t const len = (yyvsp[0].node)->getStringLength();
@@ -2011,297 +2055,345 @@ yyreduce:
       }
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2015 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2059 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 4:
-#line 349 "Aql/grammar.y" /* yacc.c:1661  */
+#line 355 "Aql/grammar.y" /* yacc.c:1661  */
     {
        auto node = static_cast<AstNode*>(parser->peekStack());
        node->addMember((yyvsp[0].node));
      }
-#line 2024 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2068 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 5:
-#line 353 "Aql/grammar.y" /* yacc.c:1661  */
+#line 359 "Aql/grammar.y" /* yacc.c:1661  */
     {
        auto node = static_cast<AstNode*>(parser->peekStack());
        node->addMember((yyvsp[0].node));
      }
-#line 2033 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2077 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 6:
-#line 357 "Aql/grammar.y" /* yacc.c:1661  */
+#line 363 "Aql/grammar.y" /* yacc.c:1661  */
     {
        auto node = static_cast<AstNode*>(parser->peekStack());
        node->addMember((yyvsp[0].node));
      }
-#line 2042 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2086 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 7:
-#line 364 "Aql/grammar.y" /* yacc.c:1661  */
+#line 370 "Aql/grammar.y" /* yacc.c:1661  */
     {
      }
-#line 2049 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2093 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 8:
-#line 366 "Aql/grammar.y" /* yacc.c:1661  */
+#line 372 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
      }
-#line 2058 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2102 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 9:
-#line 369 "Aql/grammar.y" /* yacc.c:1661  */
+#line 375 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = static_cast<AstNode*>(parser->popStack());
       auto withNode = parser->ast()->createNodeWithCollections(node);
       parser->ast()->addOperation(withNode);
      }
-#line 2068 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2112 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 10:
-#line 377 "Aql/grammar.y" /* yacc.c:1661  */
+#line 383 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2075 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2119 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 11:
-#line 382 "Aql/grammar.y" /* yacc.c:1661  */
+#line 388 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2082 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2126 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 12:
-#line 387 "Aql/grammar.y" /* yacc.c:1661  */
+#line 393 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2089 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2133 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 13:
-#line 389 "Aql/grammar.y" /* yacc.c:1661  */
+#line 395 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->endNested();
     }
-#line 2097 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2141 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 14:
-#line 392 "Aql/grammar.y" /* yacc.c:1661  */
+#line 398 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->endNested();
     }
-#line 2105 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2149 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 15:
-#line 395 "Aql/grammar.y" /* yacc.c:1661  */
+#line 401 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->endNested();
     }
-#line 2113 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2157 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 16:
-#line 398 "Aql/grammar.y" /* yacc.c:1661  */
+#line 404 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->endNested();
     }
-#line 2121 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2165 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 17:
-#line 401 "Aql/grammar.y" /* yacc.c:1661  */
+#line 407 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->endNested();
     }
-#line 2129 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2173 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 18:
-#line 407 "Aql/grammar.y" /* yacc.c:1661  */
+#line 413 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2136 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2180 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 19:
-#line 409 "Aql/grammar.y" /* yacc.c:1661  */
+#line 415 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2143 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2187 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 20:
-#line 414 "Aql/grammar.y" /* yacc.c:1661  */
+#line 420 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2150 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2194 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 21:
-#line 416 "Aql/grammar.y" /* yacc.c:1661  */
+#line 422 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2157 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2201 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 22:
-#line 418 "Aql/grammar.y" /* yacc.c:1661  */
+#line 424 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2164 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2208 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 23:
-#line 420 "Aql/grammar.y" /* yacc.c:1661  */
+#line 426 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2171 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2215 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 24:
-#line 422 "Aql/grammar.y" /* yacc.c:1661  */
+#line 428 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2178 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2222 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 25:
-#line 424 "Aql/grammar.y" /* yacc.c:1661  */
+#line 430 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2185 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2229 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 26:
-#line 426 "Aql/grammar.y" /* yacc.c:1661  */
+#line 432 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2192 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2236 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 27:
-#line 428 "Aql/grammar.y" /* yacc.c:1661  */
+#line 434 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2199 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2243 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 28:
-#line 430 "Aql/grammar.y" /* yacc.c:1661  */
+#line 436 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2206 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2250 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 29:
-#line 432 "Aql/grammar.y" /* yacc.c:1661  */
+#line 438 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2213 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2257 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 30:
-#line 434 "Aql/grammar.y" /* yacc.c:1661  */
+#line 440 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2220 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2264 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 31:
-#line 439 "Aql/grammar.y" /* yacc.c:1661  */
+#line 445 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
      
       auto node = parser->ast()->createNodeFor((yyvsp[-2].strval).value, (yyvsp[-2].strval).length, (yyvsp[0].node), true);
       parser->ast()->addOperation(node);
     }
-#line 2231 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2275 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 32:
-#line 445 "Aql/grammar.y" /* yacc.c:1661  */
+#line 451 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
-      auto node = parser->ast()->createNodeTraversal((yyvsp[-4].strval).value, (yyvsp[-4].strval).length, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
+      parser->configureTraversal((yyvsp[0].node));
+      auto node = parser->ast()->createNodeTraversal((yyvsp[-5].strval).value, (yyvsp[-5].strval).length, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2241 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2286 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 33:
-#line 450 "Aql/grammar.y" /* yacc.c:1661  */
+#line 457 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
-      auto node = parser->ast()->createNodeTraversal((yyvsp[-6].strval).value, (yyvsp[-6].strval).length, (yyvsp[-4].strval).value, (yyvsp[-4].strval).length, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
+      parser->configureTraversal((yyvsp[0].node));
+      auto node = parser->ast()->createNodeTraversal((yyvsp[-7].strval).value, (yyvsp[-7].strval).length, (yyvsp[-5].strval).value, (yyvsp[-5].strval).length, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2251 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2297 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 34:
-#line 455 "Aql/grammar.y" /* yacc.c:1661  */
+#line 463 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
-      auto node = parser->ast()->createNodeTraversal((yyvsp[-8].strval).value, (yyvsp[-8].strval).length, (yyvsp[-6].strval).value, (yyvsp[-6].strval).length, (yyvsp[-4].strval).value, (yyvsp[-4].strval).length, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
+      parser->configureTraversal((yyvsp[0].node));
+      auto node = parser->ast()->createNodeTraversal((yyvsp[-9].strval).value, (yyvsp[-9].strval).length, (yyvsp[-7].strval).value, (yyvsp[-7].strval).length, (yyvsp[-5].strval).value, (yyvsp[-5].strval).length, (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2261 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2308 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 35:
-#line 463 "Aql/grammar.y" /* yacc.c:1661  */
+#line 469 "Aql/grammar.y" /* yacc.c:1661  */
     {
-      // operand is a reference. can use it directly
-      auto node = parser->ast()->createNodeFilter((yyvsp[0].node));
+      if (! TRI_CaseEqualString((yyvsp[-3].strval).value, "TO")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'TO'", (yyvsp[-3].strval).value, yylloc.first_line, yylloc.first_column);
+      }
+
+      parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
+      parser->configureTraversal((yyvsp[0].node));
+      auto node = parser->ast()->createNodeShortestPath((yyvsp[-8].strval).value, (yyvsp[-8].strval).length, (yyvsp[-6].intval), (yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2271 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2323 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 36:
-#line 471 "Aql/grammar.y" /* yacc.c:1661  */
+#line 479 "Aql/grammar.y" /* yacc.c:1661  */
     {
+      if (! TRI_CaseEqualString((yyvsp[-3].strval).value, "TO")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'TO'", (yyvsp[-3].strval).value, yylloc.first_line, yylloc.first_column);
+      }
+
+      parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
+      parser->configureTraversal((yyvsp[0].node));
+      auto node = parser->ast()->createNodeShortestPath((yyvsp[-10].strval).value, (yyvsp[-10].strval).length, (yyvsp[-8].strval).value, (yyvsp[-8].strval).length, (yyvsp[-6].intval), (yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
+      parser->ast()->addOperation(node);
     }
-#line 2278 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2338 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 37:
-#line 476 "Aql/grammar.y" /* yacc.c:1661  */
+#line 489 "Aql/grammar.y" /* yacc.c:1661  */
     {
+      if (! TRI_CaseEqualString((yyvsp[-3].strval).value, "TO")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'TO'", (yyvsp[-3].strval).value, yylloc.first_line, yylloc.first_column);
+      }
+
+      parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
+      parser->configureTraversal((yyvsp[0].node));
+      auto node = parser->ast()->createNodeKShortestPaths((yyvsp[-8].strval).value, (yyvsp[-8].strval).length, (yyvsp[-6].intval), (yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
+      parser->ast()->addOperation(node);
     }
-#line 2285 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2353 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 38:
-#line 478 "Aql/grammar.y" /* yacc.c:1661  */
+#line 502 "Aql/grammar.y" /* yacc.c:1661  */
     {
+      // operand is a reference. can use it directly
+      auto node = parser->ast()->createNodeFilter((yyvsp[0].node));
+      parser->ast()->addOperation(node);
     }
-#line 2292 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2363 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
   case 39:
-#line 483 "Aql/grammar.y" /* yacc.c:1661  */
+#line 510 "Aql/grammar.y" /* yacc.c:1661  */
+    {
+    }
+#line 2370 "Aql/grammar.cpp" /* yacc.c:1661  */
+    break;
+
+  case 40:
+#line 515 "Aql/grammar.y" /* yacc.c:1661  */
+    {
+    }
+#line 2377 "Aql/grammar.cpp" /* yacc.c:1661  */
+    break;
+
+  case 41:
+#line 517 "Aql/grammar.y" /* yacc.c:1661  */
+    {
+    }
+#line 2384 "Aql/grammar.cpp" /* yacc.c:1661  */
+    break;
+
+  case 42:
+#line 522 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeLet((yyvsp[-2].strval).value, (yyvsp[-2].strval).length, (yyvsp[0].node), true);
       parser->ast()->addOperation(node);
     }
-#line 2301 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2393 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 40:
-#line 490 "Aql/grammar.y" /* yacc.c:1661  */
+  case 43:
+#line 529 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! TRI_CaseEqualString((yyvsp[-2].strval).value, "COUNT")) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'COUNT'", (yyvsp[-2].strval).value, yylloc.first_line, yylloc.first_column);
@@ -2309,20 +2401,20 @@ yyreduce:
 
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 2313 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2405 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 41:
-#line 500 "Aql/grammar.y" /* yacc.c:1661  */
+  case 44:
+#line 539 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2322 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2414 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 42:
-#line 503 "Aql/grammar.y" /* yacc.c:1661  */
+  case 45:
+#line 542 "Aql/grammar.y" /* yacc.c:1661  */
     { 
       auto list = static_cast<AstNode*>(parser->popStack());
 
@@ -2331,11 +2423,11 @@ yyreduce:
       }
       (yyval.node) = list;
     }
-#line 2335 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2427 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 43:
-#line 514 "Aql/grammar.y" /* yacc.c:1661  */
+  case 46:
+#line 553 "Aql/grammar.y" /* yacc.c:1661  */
     {
       /* COLLECT WITH COUNT INTO var OPTIONS ... */
       auto scopes = parser->ast()->scopes();
@@ -2345,11 +2437,11 @@ yyreduce:
       auto node = parser->ast()->createNodeCollectCount(parser->ast()->createNodeArray(), (yyvsp[-1].strval).value, (yyvsp[-1].strval).length, (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2349 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2441 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 44:
-#line 523 "Aql/grammar.y" /* yacc.c:1661  */
+  case 47:
+#line 562 "Aql/grammar.y" /* yacc.c:1661  */
     {
       /* COLLECT var = expr WITH COUNT INTO var OPTIONS ... */
       auto scopes = parser->ast()->scopes();
@@ -2361,11 +2453,11 @@ yyreduce:
       auto node = parser->ast()->createNodeCollectCount((yyvsp[-2].node), (yyvsp[-1].strval).value, (yyvsp[-1].strval).length, (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2365 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2457 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 45:
-#line 534 "Aql/grammar.y" /* yacc.c:1661  */
+  case 48:
+#line 573 "Aql/grammar.y" /* yacc.c:1661  */
     {
       /* AGGREGATE var = expr OPTIONS ... */
       auto scopes = parser->ast()->scopes();
@@ -2385,11 +2477,11 @@ yyreduce:
       auto node = parser->ast()->createNodeCollect(parser->ast()->createNodeArray(), (yyvsp[-2].node), into, intoExpression, nullptr, (yyvsp[-1].node));
       parser->ast()->addOperation(node);
     }
-#line 2389 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2481 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 46:
-#line 553 "Aql/grammar.y" /* yacc.c:1661  */
+  case 49:
+#line 592 "Aql/grammar.y" /* yacc.c:1661  */
     {
       /* COLLECT var = expr AGGREGATE var = expr OPTIONS ... */
       auto scopes = parser->ast()->scopes();
@@ -2441,11 +2533,11 @@ yyreduce:
       auto node = parser->ast()->createNodeCollect((yyvsp[-3].node), (yyvsp[-2].node), into, intoExpression, nullptr, (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2445 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2537 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 47:
-#line 604 "Aql/grammar.y" /* yacc.c:1661  */
+  case 50:
+#line 643 "Aql/grammar.y" /* yacc.c:1661  */
     {
       /* COLLECT var = expr INTO var OPTIONS ... */
       auto scopes = parser->ast()->scopes();
@@ -2460,11 +2552,11 @@ yyreduce:
       auto node = parser->ast()->createNodeCollect((yyvsp[-2].node), parser->ast()->createNodeArray(), into, intoExpression, nullptr, (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2464 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2556 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 48:
-#line 618 "Aql/grammar.y" /* yacc.c:1661  */
+  case 51:
+#line 657 "Aql/grammar.y" /* yacc.c:1661  */
     {
       /* COLLECT var = expr INTO var KEEP ... OPTIONS ... */
       auto scopes = parser->ast()->scopes();
@@ -2484,61 +2576,61 @@ yyreduce:
       auto node = parser->ast()->createNodeCollect((yyvsp[-3].node), parser->ast()->createNodeArray(), into, intoExpression, (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2488 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2580 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 49:
-#line 640 "Aql/grammar.y" /* yacc.c:1661  */
+  case 52:
+#line 679 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2495 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2587 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 50:
-#line 642 "Aql/grammar.y" /* yacc.c:1661  */
+  case 53:
+#line 681 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2502 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2594 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 51:
-#line 647 "Aql/grammar.y" /* yacc.c:1661  */
+  case 54:
+#line 686 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeAssign((yyvsp[-2].strval).value, (yyvsp[-2].strval).length, (yyvsp[0].node));
       parser->pushArrayElement(node);
     }
-#line 2511 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2603 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 52:
-#line 654 "Aql/grammar.y" /* yacc.c:1661  */
+  case 55:
+#line 693 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = nullptr;
     }
-#line 2519 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2611 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 53:
-#line 657 "Aql/grammar.y" /* yacc.c:1661  */
+  case 56:
+#line 696 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeValueString((yyvsp[0].strval).value, (yyvsp[0].strval).length);
     }
-#line 2527 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2619 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 54:
-#line 660 "Aql/grammar.y" /* yacc.c:1661  */
+  case 57:
+#line 699 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeArray();
       node->addMember(parser->ast()->createNodeValueString((yyvsp[-2].strval).value, (yyvsp[-2].strval).length));
       node->addMember((yyvsp[0].node));
       (yyval.node) = node;
     }
-#line 2538 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2630 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 55:
-#line 669 "Aql/grammar.y" /* yacc.c:1661  */
+  case 58:
+#line 708 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! parser->ast()->scopes()->existsVariable((yyvsp[0].strval).value, (yyvsp[0].strval).length)) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of unknown variable '%s' for KEEP", (yyvsp[0].strval).value, yylloc.first_line, yylloc.first_column);
@@ -2553,11 +2645,11 @@ yyreduce:
       node->setFlag(FLAG_KEEP_VARIABLENAME);
       parser->pushArrayElement(node);
     }
-#line 2557 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2649 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 56:
-#line 683 "Aql/grammar.y" /* yacc.c:1661  */
+  case 59:
+#line 722 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! parser->ast()->scopes()->existsVariable((yyvsp[0].strval).value, (yyvsp[0].strval).length)) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "use of unknown variable '%s' for KEEP", (yyvsp[0].strval).value, yylloc.first_line, yylloc.first_column);
@@ -2572,11 +2664,11 @@ yyreduce:
       node->setFlag(FLAG_KEEP_VARIABLENAME);
       parser->pushArrayElement(node);
     }
-#line 2576 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2668 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 57:
-#line 700 "Aql/grammar.y" /* yacc.c:1661  */
+  case 60:
+#line 739 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! TRI_CaseEqualString((yyvsp[0].strval).value, "KEEP")) {
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'KEEP'", (yyvsp[0].strval).value, yylloc.first_line, yylloc.first_column);
@@ -2585,158 +2677,158 @@ yyreduce:
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2589 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2681 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 58:
-#line 707 "Aql/grammar.y" /* yacc.c:1661  */
+  case 61:
+#line 746 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto list = static_cast<AstNode*>(parser->popStack());
       (yyval.node) = list;
     }
-#line 2598 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2690 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 59:
-#line 714 "Aql/grammar.y" /* yacc.c:1661  */
+  case 62:
+#line 753 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2607 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2699 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 60:
-#line 717 "Aql/grammar.y" /* yacc.c:1661  */
+  case 63:
+#line 756 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto list = static_cast<AstNode*>(parser->popStack());
       (yyval.node) = list;
     }
-#line 2616 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2708 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 61:
-#line 724 "Aql/grammar.y" /* yacc.c:1661  */
+  case 64:
+#line 763 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 2625 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2717 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 62:
-#line 727 "Aql/grammar.y" /* yacc.c:1661  */
+  case 65:
+#line 766 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto list = static_cast<AstNode const*>(parser->popStack());
       auto node = parser->ast()->createNodeSort(list);
       parser->ast()->addOperation(node);
     }
-#line 2635 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2727 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 63:
-#line 735 "Aql/grammar.y" /* yacc.c:1661  */
+  case 66:
+#line 774 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2643 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2735 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 64:
-#line 738 "Aql/grammar.y" /* yacc.c:1661  */
+  case 67:
+#line 777 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 2651 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2743 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 65:
-#line 744 "Aql/grammar.y" /* yacc.c:1661  */
+  case 68:
+#line 783 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeSortElement((yyvsp[-1].node), (yyvsp[0].node));
     }
-#line 2659 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2751 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 66:
-#line 750 "Aql/grammar.y" /* yacc.c:1661  */
+  case 69:
+#line 789 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 2667 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2759 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 67:
-#line 753 "Aql/grammar.y" /* yacc.c:1661  */
+  case 70:
+#line 792 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 2675 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2767 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 68:
-#line 756 "Aql/grammar.y" /* yacc.c:1661  */
+  case 71:
+#line 795 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeValueBool(false);
     }
-#line 2683 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2775 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 69:
-#line 759 "Aql/grammar.y" /* yacc.c:1661  */
+  case 72:
+#line 798 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2691 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2783 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 70:
-#line 765 "Aql/grammar.y" /* yacc.c:1661  */
+  case 73:
+#line 804 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto offset = parser->ast()->createNodeValueInt(0);
       auto node = parser->ast()->createNodeLimit(offset, (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2701 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2793 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 71:
-#line 770 "Aql/grammar.y" /* yacc.c:1661  */
+  case 74:
+#line 809 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeLimit((yyvsp[-2].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2710 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2802 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 72:
-#line 777 "Aql/grammar.y" /* yacc.c:1661  */
+  case 75:
+#line 816 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeReturn((yyvsp[0].node));
       parser->ast()->addOperation(node);
       parser->ast()->scopes()->endNested();
     }
-#line 2720 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2812 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 73:
-#line 785 "Aql/grammar.y" /* yacc.c:1661  */
+  case 76:
+#line 824 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2728 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2820 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 74:
-#line 788 "Aql/grammar.y" /* yacc.c:1661  */
+  case 77:
+#line 827 "Aql/grammar.y" /* yacc.c:1661  */
     {
        (yyval.node) = (yyvsp[0].node);
      }
-#line 2736 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2828 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 75:
-#line 794 "Aql/grammar.y" /* yacc.c:1661  */
+  case 78:
+#line 833 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! parser->configureWriteQuery((yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2744,11 +2836,11 @@ yyreduce:
       auto node = parser->ast()->createNodeRemove((yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2748 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2840 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 76:
-#line 804 "Aql/grammar.y" /* yacc.c:1661  */
+  case 79:
+#line 843 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! parser->configureWriteQuery((yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2756,11 +2848,11 @@ yyreduce:
       auto node = parser->ast()->createNodeInsert((yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2760 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2852 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 77:
-#line 814 "Aql/grammar.y" /* yacc.c:1661  */
+  case 80:
+#line 853 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! parser->configureWriteQuery((yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2769,11 +2861,11 @@ yyreduce:
       AstNode* node = parser->ast()->createNodeUpdate(nullptr, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2773 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2865 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 78:
-#line 822 "Aql/grammar.y" /* yacc.c:1661  */
+  case 81:
+#line 861 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! parser->configureWriteQuery((yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2782,18 +2874,18 @@ yyreduce:
       AstNode* node = parser->ast()->createNodeUpdate((yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2786 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2878 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 79:
-#line 833 "Aql/grammar.y" /* yacc.c:1661  */
+  case 82:
+#line 872 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2793 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2885 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 80:
-#line 838 "Aql/grammar.y" /* yacc.c:1661  */
+  case 83:
+#line 877 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! parser->configureWriteQuery((yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2802,11 +2894,11 @@ yyreduce:
       AstNode* node = parser->ast()->createNodeReplace(nullptr, (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2806 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2898 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 81:
-#line 846 "Aql/grammar.y" /* yacc.c:1661  */
+  case 84:
+#line 885 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! parser->configureWriteQuery((yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2815,44 +2907,44 @@ yyreduce:
       AstNode* node = parser->ast()->createNodeReplace((yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2819 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2911 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 82:
-#line 857 "Aql/grammar.y" /* yacc.c:1661  */
+  case 85:
+#line 896 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 2826 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2918 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 83:
-#line 862 "Aql/grammar.y" /* yacc.c:1661  */
+  case 86:
+#line 901 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.intval) = static_cast<int64_t>(NODE_TYPE_UPDATE);
     }
-#line 2834 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2926 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 84:
-#line 865 "Aql/grammar.y" /* yacc.c:1661  */
+  case 87:
+#line 904 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.intval) = static_cast<int64_t>(NODE_TYPE_REPLACE);
     }
-#line 2842 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2934 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 85:
-#line 871 "Aql/grammar.y" /* yacc.c:1661  */
+  case 88:
+#line 910 "Aql/grammar.y" /* yacc.c:1661  */
     { 
       // reserve a variable named "$OLD", we might need it in the update expression
       // and in a later return thing
       parser->pushStack(parser->ast()->createNodeVariable(TRI_CHAR_LENGTH_PAIR(Variable::NAME_OLD), true));
     }
-#line 2852 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2944 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 86:
-#line 875 "Aql/grammar.y" /* yacc.c:1661  */
+  case 89:
+#line 914 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if (! parser->configureWriteQuery((yyvsp[-1].node), (yyvsp[0].node))) {
         YYABORT;
@@ -2897,35 +2989,35 @@ yyreduce:
       auto node = parser->ast()->createNodeUpsert(static_cast<AstNodeType>((yyvsp[-3].intval)), parser->ast()->createNodeReference(TRI_CHAR_LENGTH_PAIR(Variable::NAME_OLD)), (yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[-1].node), (yyvsp[0].node));
       parser->ast()->addOperation(node);
     }
-#line 2901 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 2993 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 87:
-#line 922 "Aql/grammar.y" /* yacc.c:1661  */
+  case 90:
+#line 961 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeQuantifier(Quantifier::ALL);
     }
-#line 2909 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3001 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 88:
-#line 925 "Aql/grammar.y" /* yacc.c:1661  */
+  case 91:
+#line 964 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeQuantifier(Quantifier::ANY);
     }
-#line 2917 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3009 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 89:
-#line 928 "Aql/grammar.y" /* yacc.c:1661  */
+  case 92:
+#line 967 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeQuantifier(Quantifier::NONE);
     }
-#line 2925 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3017 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 90:
-#line 934 "Aql/grammar.y" /* yacc.c:1661  */
+  case 93:
+#line 973 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto const scopeType = parser->ast()->scopes()->type();
 
@@ -2934,83 +3026,83 @@ yyreduce:
         parser->registerParseError(TRI_ERROR_QUERY_PARSE, "cannot use DISTINCT modifier on top-level query element", yylloc.first_line, yylloc.first_column);
       }
     }
-#line 2938 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3030 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 91:
-#line 941 "Aql/grammar.y" /* yacc.c:1661  */
+  case 94:
+#line 980 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeDistinct((yyvsp[0].node));
     }
-#line 2946 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3038 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 92:
-#line 944 "Aql/grammar.y" /* yacc.c:1661  */
+  case 95:
+#line 983 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2954 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3046 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 93:
-#line 950 "Aql/grammar.y" /* yacc.c:1661  */
+  case 96:
+#line 989 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2962 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3054 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 94:
-#line 953 "Aql/grammar.y" /* yacc.c:1661  */
+  case 97:
+#line 992 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2970 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3062 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 95:
-#line 956 "Aql/grammar.y" /* yacc.c:1661  */
+  case 98:
+#line 995 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2978 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3070 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 96:
-#line 959 "Aql/grammar.y" /* yacc.c:1661  */
+  case 99:
+#line 998 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2986 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3078 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 97:
-#line 962 "Aql/grammar.y" /* yacc.c:1661  */
+  case 100:
+#line 1001 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 2994 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3086 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 98:
-#line 965 "Aql/grammar.y" /* yacc.c:1661  */
+  case 101:
+#line 1004 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeRange((yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3002 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3094 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 99:
-#line 971 "Aql/grammar.y" /* yacc.c:1661  */
+  case 102:
+#line 1010 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 3010 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3102 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 100:
-#line 974 "Aql/grammar.y" /* yacc.c:1661  */
+  case 103:
+#line 1013 "Aql/grammar.y" /* yacc.c:1661  */
     {
       std::string temp((yyvsp[-2].strval).value, (yyvsp[-2].strval).length);
       temp.append("::");
@@ -3024,278 +3116,278 @@ yyreduce:
       (yyval.strval).value = p;
       (yyval.strval).length = temp.size();
     }
-#line 3028 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3120 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 101:
-#line 990 "Aql/grammar.y" /* yacc.c:1661  */
+  case 104:
+#line 1029 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->pushStack((yyvsp[0].strval).value);
 
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 3039 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3131 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 102:
-#line 995 "Aql/grammar.y" /* yacc.c:1661  */
+  case 105:
+#line 1034 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto list = static_cast<AstNode const*>(parser->popStack());
       (yyval.node) = parser->ast()->createNodeFunctionCall(static_cast<char const*>(parser->popStack()), list);
     }
-#line 3048 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3140 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 103:
-#line 1002 "Aql/grammar.y" /* yacc.c:1661  */
+  case 106:
+#line 1041 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_PLUS, (yyvsp[0].node));
     }
-#line 3056 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3148 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 104:
-#line 1005 "Aql/grammar.y" /* yacc.c:1661  */
+  case 107:
+#line 1044 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_MINUS, (yyvsp[0].node));
     }
-#line 3064 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3156 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 105:
-#line 1008 "Aql/grammar.y" /* yacc.c:1661  */
+  case 108:
+#line 1047 "Aql/grammar.y" /* yacc.c:1661  */
     { 
       (yyval.node) = parser->ast()->createNodeUnaryOperator(NODE_TYPE_OPERATOR_UNARY_NOT, (yyvsp[0].node));
     }
-#line 3072 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3164 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 106:
-#line 1014 "Aql/grammar.y" /* yacc.c:1661  */
+  case 109:
+#line 1053 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_OR, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3080 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3172 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 107:
-#line 1017 "Aql/grammar.y" /* yacc.c:1661  */
+  case 110:
+#line 1056 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_AND, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3088 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3180 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 108:
-#line 1020 "Aql/grammar.y" /* yacc.c:1661  */
+  case 111:
+#line 1059 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_PLUS, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3096 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3188 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 109:
-#line 1023 "Aql/grammar.y" /* yacc.c:1661  */
-    {
+  case 112:
+#line 1062 "Aql/grammar.y" /* yacc.c:1661  */
+    {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_MINUS, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3104 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3196 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 110:
-#line 1026 "Aql/grammar.y" /* yacc.c:1661  */
+  case 113:
+#line 1065 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_TIMES, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3112 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3204 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 111:
-#line 1029 "Aql/grammar.y" /* yacc.c:1661  */
+  case 114:
+#line 1068 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_DIV, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3120 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3212 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 112:
-#line 1032 "Aql/grammar.y" /* yacc.c:1661  */
+  case 115:
+#line 1071 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_MOD, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3128 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3220 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 113:
-#line 1035 "Aql/grammar.y" /* yacc.c:1661  */
+  case 116:
+#line 1074 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_EQ, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3136 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3228 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 114:
-#line 1038 "Aql/grammar.y" /* yacc.c:1661  */
+  case 117:
+#line 1077 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_NE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3144 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3236 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 115:
-#line 1041 "Aql/grammar.y" /* yacc.c:1661  */
+  case 118:
+#line 1080 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_LT, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3152 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3244 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 116:
-#line 1044 "Aql/grammar.y" /* yacc.c:1661  */
+  case 119:
+#line 1083 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GT, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3160 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3252 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 117:
-#line 1047 "Aql/grammar.y" /* yacc.c:1661  */
+  case 120:
+#line 1086 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_LE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3168 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3260 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 118:
-#line 1050 "Aql/grammar.y" /* yacc.c:1661  */
+  case 121:
+#line 1089 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_GE, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3176 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3268 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 119:
-#line 1053 "Aql/grammar.y" /* yacc.c:1661  */
+  case 122:
+#line 1092 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_IN, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3184 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3276 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 120:
-#line 1056 "Aql/grammar.y" /* yacc.c:1661  */
+  case 123:
+#line 1095 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryOperator(NODE_TYPE_OPERATOR_BINARY_NIN, (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3192 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3284 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 121:
-#line 1059 "Aql/grammar.y" /* yacc.c:1661  */
+  case 124:
+#line 1098 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryArrayOperator(NODE_TYPE_OPERATOR_BINARY_ARRAY_EQ, (yyvsp[-3].node), (yyvsp[0].node), (yyvsp[-2].node));
     }
-#line 3200 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3292 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 122:
-#line 1062 "Aql/grammar.y" /* yacc.c:1661  */
+  case 125:
+#line 1101 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryArrayOperator(NODE_TYPE_OPERATOR_BINARY_ARRAY_NE, (yyvsp[-3].node), (yyvsp[0].node), (yyvsp[-2].node));
     }
-#line 3208 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3300 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 123:
-#line 1065 "Aql/grammar.y" /* yacc.c:1661  */
+  case 126:
+#line 1104 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryArrayOperator(NODE_TYPE_OPERATOR_BINARY_ARRAY_LT, (yyvsp[-3].node), (yyvsp[0].node), (yyvsp[-2].node));
     }
-#line 3216 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3308 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 124:
-#line 1068 "Aql/grammar.y" /* yacc.c:1661  */
+  case 127:
+#line 1107 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryArrayOperator(NODE_TYPE_OPERATOR_BINARY_ARRAY_GT, (yyvsp[-3].node), (yyvsp[0].node), (yyvsp[-2].node));
     }
-#line 3224 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3316 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 125:
-#line 1071 "Aql/grammar.y" /* yacc.c:1661  */
+  case 128:
+#line 1110 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryArrayOperator(NODE_TYPE_OPERATOR_BINARY_ARRAY_LE, (yyvsp[-3].node), (yyvsp[0].node), (yyvsp[-2].node));
     }
-#line 3232 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3324 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 126:
-#line 1074 "Aql/grammar.y" /* yacc.c:1661  */
+  case 129:
+#line 1113 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryArrayOperator(NODE_TYPE_OPERATOR_BINARY_ARRAY_GE, (yyvsp[-3].node), (yyvsp[0].node), (yyvsp[-2].node));
     }
-#line 3240 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3332 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 127:
-#line 1077 "Aql/grammar.y" /* yacc.c:1661  */
+  case 130:
+#line 1116 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryArrayOperator(NODE_TYPE_OPERATOR_BINARY_ARRAY_IN, (yyvsp[-3].node), (yyvsp[0].node), (yyvsp[-2].node));
     }
-#line 3248 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3340 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 128:
-#line 1080 "Aql/grammar.y" /* yacc.c:1661  */
+  case 131:
+#line 1119 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeBinaryArrayOperator(NODE_TYPE_OPERATOR_BINARY_ARRAY_NIN, (yyvsp[-3].node), (yyvsp[0].node), (yyvsp[-2].node));
     }
-#line 3256 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3348 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 129:
-#line 1086 "Aql/grammar.y" /* yacc.c:1661  */
+  case 132:
+#line 1125 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeTernaryOperator((yyvsp[-4].node), (yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3264 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3356 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 130:
-#line 1092 "Aql/grammar.y" /* yacc.c:1661  */
+  case 133:
+#line 1131 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 3271 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3363 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 131:
-#line 1094 "Aql/grammar.y" /* yacc.c:1661  */
+  case 134:
+#line 1133 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 3278 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3370 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 132:
-#line 1099 "Aql/grammar.y" /* yacc.c:1661  */
+  case 135:
+#line 1138 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3286 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3378 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 133:
-#line 1102 "Aql/grammar.y" /* yacc.c:1661  */
+  case 136:
+#line 1141 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_SUBQUERY);
       parser->ast()->startSubQuery();
     }
-#line 3295 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3387 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 134:
-#line 1105 "Aql/grammar.y" /* yacc.c:1661  */
+  case 137:
+#line 1144 "Aql/grammar.y" /* yacc.c:1661  */
     {
       AstNode* node = parser->ast()->endSubQuery();
       parser->ast()->scopes()->endCurrent();
@@ -3306,98 +3398,98 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeReference(variableName);
     }
-#line 3310 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3402 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 135:
-#line 1118 "Aql/grammar.y" /* yacc.c:1661  */
+  case 138:
+#line 1157 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 3318 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3410 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 136:
-#line 1121 "Aql/grammar.y" /* yacc.c:1661  */
+  case 139:
+#line 1160 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 3326 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3418 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 137:
-#line 1127 "Aql/grammar.y" /* yacc.c:1661  */
+  case 140:
+#line 1166 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3334 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3426 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 138:
-#line 1130 "Aql/grammar.y" /* yacc.c:1661  */
+  case 141:
+#line 1169 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3342 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3434 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 139:
-#line 1136 "Aql/grammar.y" /* yacc.c:1661  */
+  case 142:
+#line 1175 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
     }
-#line 3351 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3443 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 140:
-#line 1139 "Aql/grammar.y" /* yacc.c:1661  */
+  case 143:
+#line 1178 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = static_cast<AstNode*>(parser->popStack());
     }
-#line 3359 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3451 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 141:
-#line 1145 "Aql/grammar.y" /* yacc.c:1661  */
+  case 144:
+#line 1184 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 3366 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3458 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 142:
-#line 1147 "Aql/grammar.y" /* yacc.c:1661  */
+  case 145:
+#line 1186 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 3373 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3465 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 143:
-#line 1152 "Aql/grammar.y" /* yacc.c:1661  */
+  case 146:
+#line 1191 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 3381 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3473 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 144:
-#line 1155 "Aql/grammar.y" /* yacc.c:1661  */
+  case 147:
+#line 1194 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->pushArrayElement((yyvsp[0].node));
     }
-#line 3389 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3481 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 145:
-#line 1161 "Aql/grammar.y" /* yacc.c:1661  */
+  case 148:
+#line 1200 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = nullptr;
     }
-#line 3397 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3489 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 146:
-#line 1164 "Aql/grammar.y" /* yacc.c:1661  */
+  case 149:
+#line 1203 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if ((yyvsp[0].node) == nullptr) {
         ABORT_OOM
@@ -3409,56 +3501,56 @@ yyreduce:
 
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3413 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3505 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 147:
-#line 1178 "Aql/grammar.y" /* yacc.c:1661  */
+  case 150:
+#line 1217 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeObject();
       parser->pushStack(node);
     }
-#line 3422 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3514 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 148:
-#line 1181 "Aql/grammar.y" /* yacc.c:1661  */
+  case 151:
+#line 1220 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = static_cast<AstNode*>(parser->popStack());
     }
-#line 3430 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3522 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 149:
-#line 1187 "Aql/grammar.y" /* yacc.c:1661  */
+  case 152:
+#line 1226 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 3437 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3529 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 150:
-#line 1189 "Aql/grammar.y" /* yacc.c:1661  */
+  case 153:
+#line 1228 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 3444 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3536 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 151:
-#line 1194 "Aql/grammar.y" /* yacc.c:1661  */
+  case 154:
+#line 1233 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 3451 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3543 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 152:
-#line 1196 "Aql/grammar.y" /* yacc.c:1661  */
+  case 155:
+#line 1235 "Aql/grammar.y" /* yacc.c:1661  */
     {
     }
-#line 3458 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3550 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 153:
-#line 1201 "Aql/grammar.y" /* yacc.c:1661  */
+  case 156:
+#line 1240 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // attribute-name-only (comparable to JS enhanced object literals, e.g. { foo, bar })
       auto ast = parser->ast();
@@ -3473,20 +3565,20 @@ yyreduce:
       auto node = ast->createNodeReference(variable);
       parser->pushObjectElement((yyvsp[0].strval).value, (yyvsp[0].strval).length, node);
     }
-#line 3477 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3569 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 154:
-#line 1215 "Aql/grammar.y" /* yacc.c:1661  */
+  case 157:
+#line 1254 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // attribute-name : attribute-value
       parser->pushObjectElement((yyvsp[-2].strval).value, (yyvsp[-2].strval).length, (yyvsp[0].node));
     }
-#line 3486 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3578 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 155:
-#line 1219 "Aql/grammar.y" /* yacc.c:1661  */
+  case 158:
+#line 1258 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // bind-parameter : attribute-value
       if ((yyvsp[-2].strval).length < 1 || (yyvsp[-2].strval).value[0] == '@') {
@@ -3496,100 +3588,100 @@ yyreduce:
       auto param = parser->ast()->createNodeParameter((yyvsp[-2].strval).value, (yyvsp[-2].strval).length);
       parser->pushObjectElement(param, (yyvsp[0].node));
     }
-#line 3500 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3592 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 156:
-#line 1228 "Aql/grammar.y" /* yacc.c:1661  */
+  case 159:
+#line 1267 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // [ attribute-name-expression ] : attribute-value
       parser->pushObjectElement((yyvsp[-3].node), (yyvsp[0].node));
     }
-#line 3509 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3601 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 157:
-#line 1235 "Aql/grammar.y" /* yacc.c:1661  */
+  case 160:
+#line 1274 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.intval) = 1;
     }
-#line 3517 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3609 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 158:
-#line 1238 "Aql/grammar.y" /* yacc.c:1661  */
+  case 161:
+#line 1277 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.intval) = (yyvsp[-1].intval) + 1;
     }
-#line 3525 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3617 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 159:
-#line 1244 "Aql/grammar.y" /* yacc.c:1661  */
+  case 162:
+#line 1283 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = nullptr;
     }
-#line 3533 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3625 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 160:
-#line 1247 "Aql/grammar.y" /* yacc.c:1661  */
+  case 163:
+#line 1286 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3541 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3633 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 161:
-#line 1253 "Aql/grammar.y" /* yacc.c:1661  */
+  case 164:
+#line 1292 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = nullptr;
     }
-#line 3549 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3641 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 162:
-#line 1256 "Aql/grammar.y" /* yacc.c:1661  */
+  case 165:
+#line 1295 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeArrayLimit(nullptr, (yyvsp[0].node));
     }
-#line 3557 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3649 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 163:
-#line 1259 "Aql/grammar.y" /* yacc.c:1661  */
+  case 166:
+#line 1298 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeArrayLimit((yyvsp[-2].node), (yyvsp[0].node));
     }
-#line 3565 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3657 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 164:
-#line 1265 "Aql/grammar.y" /* yacc.c:1661  */
+  case 167:
+#line 1304 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = nullptr;
     }
-#line 3573 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3665 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 165:
-#line 1268 "Aql/grammar.y" /* yacc.c:1661  */
+  case 168:
+#line 1307 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3581 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3673 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 166:
-#line 1274 "Aql/grammar.y" /* yacc.c:1661  */
+  case 169:
+#line 1313 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeValueString((yyvsp[0].strval).value, (yyvsp[0].strval).length);
     }
-#line 3589 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3681 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 167:
-#line 1277 "Aql/grammar.y" /* yacc.c:1661  */
+  case 170:
+#line 1316 "Aql/grammar.y" /* yacc.c:1661  */
     {
       char const* p = (yyvsp[0].node)->getStringValue();
       size_t const len = (yyvsp[0].node)->getStringLength();
@@ -3598,20 +3690,20 @@ yyreduce:
       }
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3602 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3694 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 168:
-#line 1285 "Aql/grammar.y" /* yacc.c:1661  */
+  case 171:
+#line 1324 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto tmp = parser->ast()->createNodeValueString((yyvsp[0].strval).value, (yyvsp[0].strval).length);
       (yyval.node) = parser->ast()->createNodeCollectionDirection((yyvsp[-1].intval), tmp);
     }
-#line 3611 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3703 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 169:
-#line 1289 "Aql/grammar.y" /* yacc.c:1661  */
+  case 172:
+#line 1328 "Aql/grammar.y" /* yacc.c:1661  */
     {
       char const* p = (yyvsp[0].node)->getStringValue();
       size_t const len = (yyvsp[0].node)->getStringLength();
@@ -3620,58 +3712,58 @@ yyreduce:
       }
       (yyval.node) = parser->ast()->createNodeCollectionDirection((yyvsp[-1].intval), (yyvsp[0].node));
     }
-#line 3624 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3716 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 170:
-#line 1300 "Aql/grammar.y" /* yacc.c:1661  */
+  case 173:
+#line 1339 "Aql/grammar.y" /* yacc.c:1661  */
     {
        auto node = static_cast<AstNode*>(parser->peekStack());
        node->addMember((yyvsp[0].node));
      }
-#line 3633 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3725 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 171:
-#line 1304 "Aql/grammar.y" /* yacc.c:1661  */
+  case 174:
+#line 1343 "Aql/grammar.y" /* yacc.c:1661  */
     {
        auto node = static_cast<AstNode*>(parser->peekStack());
        node->addMember((yyvsp[0].node));
      }
-#line 3642 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3734 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 172:
-#line 1311 "Aql/grammar.y" /* yacc.c:1661  */
+  case 175:
+#line 1350 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = parser->ast()->createNodeArray();
       node->addMember((yyvsp[0].node));
       (yyval.node) = parser->ast()->createNodeCollectionList(node);
     }
-#line 3652 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3744 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 173:
-#line 1316 "Aql/grammar.y" /* yacc.c:1661  */
+  case 176:
+#line 1355 "Aql/grammar.y" /* yacc.c:1661  */
     { 
       auto node = parser->ast()->createNodeArray();
       parser->pushStack(node);
       node->addMember((yyvsp[-1].node));
     }
-#line 3662 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3754 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 174:
-#line 1320 "Aql/grammar.y" /* yacc.c:1661  */
+  case 177:
+#line 1359 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto node = static_cast<AstNode*>(parser->popStack());
       (yyval.node) = parser->ast()->createNodeCollectionList(node);
     }
-#line 3671 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3763 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 175:
-#line 1324 "Aql/grammar.y" /* yacc.c:1661  */
+  case 178:
+#line 1363 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // graph name
       char const* p = (yyvsp[0].node)->getStringValue();
@@ -3681,60 +3773,61 @@ yyreduce:
       }
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3685 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3777 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 176:
-#line 1333 "Aql/grammar.y" /* yacc.c:1661  */
+  case 179:
+#line 1372 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // graph name
       (yyval.node) = parser->ast()->createNodeValueString((yyvsp[0].strval).value, (yyvsp[0].strval).length);
     }
-#line 3694 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3786 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 177:
-#line 1342 "Aql/grammar.y" /* yacc.c:1661  */
+  case 180:
+#line 1381 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.intval) = 2;
     }
-#line 3702 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3794 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 178:
-#line 1345 "Aql/grammar.y" /* yacc.c:1661  */
+  case 181:
+#line 1384 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.intval) = 1;
     }
-#line 3710 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3802 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 179:
-#line 1348 "Aql/grammar.y" /* yacc.c:1661  */
+  case 182:
+#line 1387 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.intval) = 0; 
     }
-#line 3718 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3810 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 180:
-#line 1354 "Aql/grammar.y" /* yacc.c:1661  */
+  case 183:
+#line 1393 "Aql/grammar.y" /* yacc.c:1661  */
     {
+      // a graph keyword following the direction starts a path query, not a start vertex
       (yyval.node) = parser->ast()->createNodeDirection((yyvsp[0].intval), 1);
     }
-#line 3726 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3819 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 181:
-#line 1357 "Aql/grammar.y" /* yacc.c:1661  */
+  case 184:
+#line 1397 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeDirection((yyvsp[0].intval), (yyvsp[-1].node));
     }
-#line 3734 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3827 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 182:
-#line 1363 "Aql/grammar.y" /* yacc.c:1661  */
+  case 185:
+#line 1403 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // variable or collection
       auto ast = parser->ast();
@@ -3767,27 +3860,27 @@ yyreduce:
 
       (yyval.node) = node;
     }
-#line 3771 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3864 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 183:
-#line 1395 "Aql/grammar.y" /* yacc.c:1661  */
+  case 186:
+#line 1435 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3779 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3872 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 184:
-#line 1398 "Aql/grammar.y" /* yacc.c:1661  */
+  case 187:
+#line 1438 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3787 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3880 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 185:
-#line 1401 "Aql/grammar.y" /* yacc.c:1661  */
+  case 188:
+#line 1441 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
       
@@ -3795,11 +3888,11 @@ yyreduce:
         ABORT_OOM
       }
     }
-#line 3799 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3892 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 186:
-#line 1408 "Aql/grammar.y" /* yacc.c:1661  */
+  case 189:
+#line 1448 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if ((yyvsp[-1].node)->type == NODE_TYPE_EXPANSION) {
         // create a dummy passthru node that reduces and evaluates the expansion first
@@ -3810,20 +3903,20 @@ yyreduce:
         (yyval.node) = (yyvsp[-1].node);
       }
     }
-#line 3814 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3907 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 187:
-#line 1418 "Aql/grammar.y" /* yacc.c:1661  */
+  case 190:
+#line 1458 "Aql/grammar.y" /* yacc.c:1661  */
     {
       parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_SUBQUERY);
       parser->ast()->startSubQuery();
     }
-#line 3823 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3916 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 188:
-#line 1421 "Aql/grammar.y" /* yacc.c:1661  */
+  case 191:
+#line 1461 "Aql/grammar.y" /* yacc.c:1661  */
     {
       AstNode* node = parser->ast()->endSubQuery();
       parser->ast()->scopes()->endCurrent();
@@ -3834,11 +3927,11 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeReference(variableName);
     }
-#line 3838 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3931 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 189:
-#line 1431 "Aql/grammar.y" /* yacc.c:1661  */
+  case 192:
+#line 1471 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // named variable access, e.g. variable.reference
       if ((yyvsp[-2].node)->type == NODE_TYPE_EXPANSION) {
@@ -3854,11 +3947,11 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeAttributeAccess((yyvsp[-2].node), (yyvsp[0].strval).value, (yyvsp[0].strval).length);
       }
     }
-#line 3858 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3951 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 190:
-#line 1446 "Aql/grammar.y" /* yacc.c:1661  */
+  case 193:
+#line 1486 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // named variable access, e.g. variable.@reference
       if ((yyvsp[-2].node)->type == NODE_TYPE_EXPANSION) {
@@ -3873,11 +3966,11 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeBoundAttributeAccess((yyvsp[-2].node), (yyvsp[0].node));
       }
     }
-#line 3877 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3970 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 191:
-#line 1460 "Aql/grammar.y" /* yacc.c:1661  */
+  case 194:
+#line 1500 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // indexed variable access, e.g. variable[index]
       if ((yyvsp[-3].node)->type == NODE_TYPE_EXPANSION) {
@@ -3892,11 +3985,11 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeIndexedAccess((yyvsp[-3].node), (yyvsp[-1].node));
       }
     }
-#line 3896 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 3989 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 192:
-#line 1474 "Aql/grammar.y" /* yacc.c:1661  */
+  case 195:
+#line 1514 "Aql/grammar.y" /* yacc.c:1661  */
     {
       // variable expansion, e.g. variable[*], with optional FILTER, LIMIT and RETURN clauses
       if ((yyvsp[0].intval) > 1 && (yyvsp[-2].node)->type == NODE_TYPE_EXPANSION) {
@@ -3920,11 +4013,11 @@ yyreduce:
       auto scopes = parser->ast()->scopes();
       scopes->stackCurrentVariable(scopes->getVariable(nextName));
     }
-#line 3924 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4017 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 193:
-#line 1496 "Aql/grammar.y" /* yacc.c:1661  */
+  case 196:
+#line 1536 "Aql/grammar.y" /* yacc.c:1661  */
     {
       auto scopes = parser->ast()->scopes();
       scopes->unstackCurrentVariable();
@@ -3943,27 +4036,27 @@ yyreduce:
         (yyval.node) = parser->ast()->createNodeExpansion((yyvsp[-5].intval), iterator, parser->ast()->createNodeReference(variable->name), (yyvsp[-3].node), (yyvsp[-2].node), (yyvsp[-1].node));
       }
     }
-#line 3947 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4040 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 194:
-#line 1517 "Aql/grammar.y" /* yacc.c:1661  */
+  case 197:
+#line 1557 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3955 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4048 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 195:
-#line 1520 "Aql/grammar.y" /* yacc.c:1661  */
+  case 198:
+#line 1560 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3963 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4056 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 196:
-#line 1526 "Aql/grammar.y" /* yacc.c:1661  */
+  case 199:
+#line 1566 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if ((yyvsp[0].node) == nullptr) {
         ABORT_OOM
@@ -3971,11 +4064,11 @@ yyreduce:
       
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3975 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4068 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 197:
-#line 1533 "Aql/grammar.y" /* yacc.c:1661  */
+  case 200:
+#line 1573 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if ((yyvsp[0].node) == nullptr) {
         ABORT_OOM
@@ -3983,67 +4076,67 @@ yyreduce:
 
       (yyval.node) = (yyvsp[0].node);
     }
-#line 3987 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4080 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 198:
-#line 1543 "Aql/grammar.y" /* yacc.c:1661  */
+  case 201:
+#line 1583 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeValueString((yyvsp[0].strval).value, (yyvsp[0].strval).length);
     }
-#line 3995 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4088 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 199:
-#line 1546 "Aql/grammar.y" /* yacc.c:1661  */
+  case 202:
+#line 1586 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = (yyvsp[0].node);
     }
-#line 4003 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4096 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 200:
-#line 1549 "Aql/grammar.y" /* yacc.c:1661  */
+  case 203:
+#line 1589 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeValueNull();
     }
-#line 4011 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4104 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 201:
-#line 1552 "Aql/grammar.y" /* yacc.c:1661  */
+  case 204:
+#line 1592 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeValueBool(true);
     }
-#line 4019 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4112 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 202:
-#line 1555 "Aql/grammar.y" /* yacc.c:1661  */
+  case 205:
+#line 1595 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeValueBool(false);
     }
-#line 4027 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4120 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 203:
-#line 1561 "Aql/grammar.y" /* yacc.c:1661  */
+  case 206:
+#line 1601 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeCollection((yyvsp[0].strval).value, TRI_TRANSACTION_WRITE);
     }
-#line 4035 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4128 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 204:
-#line 1564 "Aql/grammar.y" /* yacc.c:1661  */
+  case 207:
+#line 1604 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeCollection((yyvsp[0].strval).value, TRI_TRANSACTION_WRITE);
     }
-#line 4043 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4136 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 205:
-#line 1567 "Aql/grammar.y" /* yacc.c:1661  */
+  case 208:
+#line 1607 "Aql/grammar.y" /* yacc.c:1661  */
     {
       if ((yyvsp[0].strval).length < 2 || (yyvsp[0].strval).value[0] != '@') {
         parser->registerParseError(TRI_ERROR_QUERY_BIND_PARAMETER_TYPE, TRI_errno_string(TRI_ERROR_QUERY_BIND_PARAMETER_TYPE), (yyvsp[0].strval).value, yylloc.first_line, yylloc.first_column);
@@ -4051,43 +4144,67 @@ yyreduce:
 
       (yyval.node) = parser->ast()->createNodeParameter((yyvsp[0].strval).value, (yyvsp[0].strval).length);
     }
-#line 4055 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4148 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 206:
-#line 1577 "Aql/grammar.y" /* yacc.c:1661  */
+  case 209:
+#line 1617 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.node) = parser->ast()->createNodeParameter((yyvsp[0].strval).value, (yyvsp[0].strval).length);
     }
-#line 4063 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4156 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 207:
-#line 1583 "Aql/grammar.y" /* yacc.c:1661  */
+  case 210:
+#line 1623 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 4071 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4164 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 208:
-#line 1586 "Aql/grammar.y" /* yacc.c:1661  */
+  case 211:
+#line 1626 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 4079 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4172 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
-  case 209:
-#line 1591 "Aql/grammar.y" /* yacc.c:1661  */
+  case 212:
+#line 1632 "Aql/grammar.y" /* yacc.c:1661  */
+    {
+      (yyval.strval) = (yyvsp[0].strval);
+    }
+#line 4180 "Aql/grammar.cpp" /* yacc.c:1661  */
+    break;
+
+  case 213:
+#line 1635 "Aql/grammar.y" /* yacc.c:1661  */
+    {
+      (yyval.strval) = (yyvsp[0].strval);
+    }
+#line 4188 "Aql/grammar.cpp" /* yacc.c:1661  */
+    break;
+
+  case 214:
+#line 1638 "Aql/grammar.y" /* yacc.c:1661  */
+    {
+      (yyval.strval) = (yyvsp[0].strval);
+    }
+#line 4196 "Aql/grammar.cpp" /* yacc.c:1661  */
+    break;
+
+  case 215:
+#line 1644 "Aql/grammar.y" /* yacc.c:1661  */
     {
       (yyval.strval) = (yyvsp[0].strval);
     }
-#line 4087 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4204 "Aql/grammar.cpp" /* yacc.c:1661  */
     break;
 
 
-#line 4091 "Aql/grammar.cpp" /* yacc.c:1661  */
+#line 4208 "Aql/grammar.cpp" /* yacc.c:1661  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -103,15 +103,17 @@ extern int Aqldebug;
     T_ARRAY_CLOSE = 312,
     T_OUTBOUND = 313,
     T_INBOUND = 314,
-    T_ANY = 315,
-    T_ALL = 316,
-    T_NONE = 317,
-    UMINUS = 318,
-    UPLUS = 319,
-    FUNCCALL = 320,
-    REFERENCE = 321,
-    INDEXED = 322,
-    EXPANSION = 323
+    T_SHORTEST_PATH = 315,
+    T_K_SHORTEST_PATHS = 316,
+    T_ANY = 317,
+    T_ALL = 318,
+    T_NONE = 319,
+    UMINUS = 320,
+    UPLUS = 321,
+    FUNCCALL = 322,
+    REFERENCE = 323,
+    INDEXED = 324,
+    EXPANSION = 325
   };
 #endif
 
@@ -130,7 +132,7 @@ union YYSTYPE
   bool                     boolval;
   int64_t                  intval;
 
-#line 134 "Aql/grammar.hpp" /* yacc.c:1915  */
+#line 136 "Aql/grammar.hpp" /* yacc.c:1915  */
 };
 
 typedef union YYSTYPE YYSTYPE;
@@ -241,6 +241,8 @@ static AstNode const* GetIntoExpression(AstNode const* node) {
 
 %token T_OUTBOUND "outbound modifier"
 %token T_INBOUND "inbound modifier"
+%token T_SHORTEST_PATH "SHORTEST_PATH keyword"
+%token T_K_SHORTEST_PATHS "K_SHORTEST_PATHS keyword"
 
 %token T_ANY "any modifier"
 %token T_ALL "all modifier"
@@ -256,6 +258,7 @@ static AstNode const* GetIntoExpression(AstNode const* node) {
 %left T_OR 
 %left T_AND
 %nonassoc T_OUTBOUND T_INBOUND T_ANY T_ALL T_NONE
+%nonassoc T_SHORTEST_PATH T_K_SHORTEST_PATHS
 %left T_EQ T_NE 
 %left T_IN T_NIN 
 %left T_LT T_GT T_LE T_GE
@@ -272,6 +275,8 @@ static AstNode const* GetIntoExpression(AstNode const* node) {
 /* define token return types */
 %type <strval> T_STRING
 %type <strval> T_QUOTED_STRING
+%type <strval> T_SHORTEST_PATH
+%type <strval> T_K_SHORTEST_PATHS
 %type <node> T_INTEGER
 %type <node> T_DOUBLE
 %type <strval> T_PARAMETER; 
@@ -306,6 +311,7 @@ static AstNode const* GetIntoExpression(AstNode const* node) {
 %type <node> object_elements_list;
 %type <node> object_element;
 %type <strval> object_element_name;
+%type <strval> attribute_name;
 %type <intval> array_filter_operator;
 %type <node> optional_array_filter;
 %type <node> optional_array_limit;
@@ -442,19 +448,52 @@ for_statement:
       auto node = parser->ast()->createNodeFor($2.value, $2.length, $4, true);
       parser->ast()->addOperation(node);
     }
-    | T_FOR variable_name T_IN graph_direction_steps expression graph_subject {
+    | T_FOR variable_name T_IN graph_direction_steps expression graph_subject options {
       parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
-      auto node = parser->ast()->createNodeTraversal($2.value, $2.length, $4, $5, $6);
+      parser->configureTraversal($7);
+      auto node = parser->ast()->createNodeTraversal($2.value, $2.length, $4, $5, $6, $7);
       parser->ast()->addOperation(node);
     }
-    | T_FOR variable_name T_COMMA variable_name T_IN graph_direction_steps expression graph_subject {
+    | T_FOR variable_name T_COMMA variable_name T_IN graph_direction_steps expression graph_subject options {
       parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
-      auto node = parser->ast()->createNodeTraversal($2.value, $2.length, $4.value, $4.length, $6, $7, $8);
+      parser->configureTraversal($9);
+      auto node = parser->ast()->createNodeTraversal($2.value, $2.length, $4.value, $4.length, $6, $7, $8, $9);
       parser->ast()->addOperation(node);
     }
-    | T_FOR variable_name T_COMMA variable_name T_COMMA variable_name T_IN graph_direction_steps expression graph_subject {
+    | T_FOR variable_name T_COMMA variable_name T_COMMA variable_name T_IN graph_direction_steps expression graph_subject options {
       parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
-      auto node = parser->ast()->createNodeTraversal($2.value, $2.length, $4.value, $4.length, $6.value, $6.length, $8, $9, $10);
+      parser->configureTraversal($11);
+      auto node = parser->ast()->createNodeTraversal($2.value, $2.length, $4.value, $4.length, $6.value, $6.length, $8, $9, $10, $11);
+      parser->ast()->addOperation(node);
+    }
+    | T_FOR variable_name T_IN graph_direction T_SHORTEST_PATH expression T_STRING expression graph_subject options {
+      if (! TRI_CaseEqualString($7.value, "TO")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'TO'", $7.value, yylloc.first_line, yylloc.first_column);
+      }
+
+      parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
+      parser->configureTraversal($10);
+      auto node = parser->ast()->createNodeShortestPath($2.value, $2.length, $4, $6, $8, $9, $10);
+      parser->ast()->addOperation(node);
+    }
+    | T_FOR variable_name T_COMMA variable_name T_IN graph_direction T_SHORTEST_PATH expression T_STRING expression graph_subject options {
+      if (! TRI_CaseEqualString($9.value, "TO")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'TO'", $9.value, yylloc.first_line, yylloc.first_column);
+      }
+
+      parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
+      parser->configureTraversal($12);
+      auto node = parser->ast()->createNodeShortestPath($2.value, $2.length, $4.value, $4.length, $6, $8, $10, $11, $12);
+      parser->ast()->addOperation(node);
+    }
+    | T_FOR variable_name T_IN graph_direction T_K_SHORTEST_PATHS expression T_STRING expression graph_subject options {
+      if (! TRI_CaseEqualString($7.value, "TO")) {
+        parser->registerParseError(TRI_ERROR_QUERY_PARSE, "unexpected qualifier '%s', expecting 'TO'", $7.value, yylloc.first_line, yylloc.first_column);
+      }
+
+      parser->ast()->scopes()->start(arangodb::aql::AQL_SCOPE_FOR);
+      parser->configureTraversal($10);
+      auto node = parser->ast()->createNodeKShortestPaths($2.value, $2.length, $4, $6, $8, $9, $10);
       parser->ast()->addOperation(node);
     }
   ;
@@ -968,7 +1007,7 @@ expression:
   ;
 
 function_name:
-    T_STRING {
+    attribute_name {
       $$ = $1;
     }
   | function_name T_SCOPE T_STRING {
@@ -1351,7 +1390,8 @@ graph_direction:
   ;
 
 graph_direction_steps:
-    graph_direction {
+    graph_direction %prec T_OUTBOUND {
+      // a graph keyword following the direction starts a path query, not a start vertex
       $$ = parser->ast()->createNodeDirection($1, 1);
     }
   | expression graph_direction %prec T_OUTBOUND {
@@ -1428,7 +1468,7 @@ reference:
 
       $$ = parser->ast()->createNodeReference(variableName);
     } 
-  | reference '.' T_STRING %prec REFERENCE {
+  | reference '.' attribute_name %prec REFERENCE {
       // named variable access, e.g. variable.reference
       if ($1->type == NODE_TYPE_EXPANSION) {
         // if left operand is an expansion already...
@@ -1580,13 +1620,26 @@ bind_parameter:
   ;
 
 object_element_name:
-    T_STRING {
+    attribute_name {
       $$ = $1;
     }
   | T_QUOTED_STRING {
       $$ = $1;
     }
 
+attribute_name:
+    // graph keywords are valid function and attribute names
+    T_STRING {
+      $$ = $1;
+    }
+  | T_SHORTEST_PATH {
+      $$ = $1;
+    }
+  | T_K_SHORTEST_PATHS {
+      $$ = $1;
+    }
+  ;
+
 variable_name:
     T_STRING {
       $$ = $1;
@@ -366,8 +366,8 @@ static void yy_fatal_error (yyconst char msg[] ,yyscan_t yyscanner );
 	*yy_cp = '\0'; \
 	yyg->yy_c_buf_p = yy_cp;
 
-#define YY_NUM_RULES 96
-#define YY_END_OF_BUFFER 97
+#define YY_NUM_RULES 98
+#define YY_END_OF_BUFFER 99
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -375,35 +375,37 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static yyconst flex_int16_t yy_accept[243] =
+static yyconst flex_int16_t yy_accept[271] =
     {   0,
         0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
-        0,    0,    0,    0,    0,    0,   97,   95,   82,   83,
-       39,   69,   95,   46,   95,   74,   52,   53,   44,   42,
-       51,   43,   95,   45,   79,   79,   49,   37,   38,   35,
-       47,   95,   58,   58,   58,   58,   58,   58,   58,   58,
-       58,   58,   58,   58,   58,   58,   58,   56,   57,   95,
-       59,   54,   95,   55,   95,   63,   62,   63,   60,   68,
-       67,   68,   68,   78,   77,   75,   78,   73,   72,   70,
-       73,   86,   85,   89,   91,   90,   94,   93,   93,   94,
-       82,   33,   58,   40,   50,   87,   84,    0,    0,   79,
-
-       48,   36,   32,   34,   81,    0,    0,   58,   58,   58,
-       58,   58,   58,   58,   58,   58,   58,   58,   58,   15,
-       58,   58,   58,   58,   14,   58,   58,   58,   58,   58,
-       58,   58,    0,   41,   64,   61,   66,   65,   76,   71,
-       86,   89,   88,   92,   80,    0,   80,   81,   81,   58,
-       27,   13,   26,   10,   58,   58,   58,   58,   58,    1,
-       58,   58,   58,   58,    2,   58,   58,   12,   58,   58,
-       58,   58,   58,   58,   58,   58,   58,   58,   58,   58,
-       81,   81,   58,   58,   11,   58,   58,   58,   58,   58,
-       58,   16,   58,   28,   29,   58,   58,   58,   58,    6,
-
-       30,   58,   58,   17,   58,   58,   58,   31,   58,   23,
-       58,   58,    7,   58,   58,   58,   58,   58,   58,   58,
-       58,   58,    3,   58,   19,   58,   18,   58,    4,   20,
-       22,   58,    5,   58,   25,   58,   21,   58,    8,   24,
-        9,    0
+        0,    0,    0,    0,    0,    0,   99,   97,   84,   85,
+       41,   71,   97,   48,   97,   76,   54,   55,   46,   44,
+       53,   45,   97,   47,   81,   81,   51,   39,   40,   37,
+       49,   97,   60,   60,   60,   60,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   58,   59,
+       97,   61,   56,   97,   57,   97,   65,   64,   65,   62,
+       70,   69,   70,   70,   80,   79,   77,   80,   75,   74,
+       72,   75,   88,   87,   91,   93,   92,   96,   95,   95,
+       96,   84,   35,   60,   42,   52,   89,   86,    0,    0,
+
+       81,   50,   38,   34,   36,   83,    0,    0,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,   60,
+       15,   60,   60,   60,   60,   60,   14,   60,   60,   60,
+       60,   60,   60,   60,   60,    0,   43,   66,   63,   68,
+       67,   78,   73,   88,   91,   90,   94,   82,    0,   82,
+       83,   83,   60,   29,   13,   28,   10,   60,   60,   60,
+       60,   60,    1,   60,   60,   60,   60,   60,    2,   60,
+       60,   12,   60,   60,   60,   60,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   83,   83,   60,   60,   11,
+       60,   60,   60,   60,   60,   60,   16,   60,   60,   30,
+
+       31,   60,   60,   60,   60,   60,    6,   32,   60,   60,
+       17,   60,   60,   60,   33,   60,   23,   60,   60,   60,
+        7,   60,   60,   60,   60,   60,   60,   60,   60,   60,
+       60,    3,   60,   19,   60,   60,   18,   60,    4,   60,
+       20,   22,   60,    5,   60,   25,   60,   60,   21,   60,
+       60,    8,   60,   24,   60,    9,   60,   60,   60,   60,
+       60,   60,   60,   60,   60,   26,   60,   60,   27,    0
     } ;
 
 static yyconst flex_int32_t yy_ec[256] =
@@ -415,20 +417,20 @@ static yyconst flex_int32_t yy_ec[256] =
        11,   12,   13,   14,   15,   16,   17,   18,   19,   19,
        19,   19,   19,   19,   19,   19,   19,   20,    1,   21,
        22,   23,   24,   25,   26,   27,   28,   29,   30,   31,
-       32,   33,   34,   35,   35,   36,   37,   38,   39,   40,
-       35,   41,   42,   43,   44,   45,   46,   35,   47,   35,
-       48,   49,   50,    1,   51,   52,   53,   54,   55,   56,
+       32,   33,   34,   35,   36,   37,   38,   39,   40,   41,
+       35,   42,   43,   44,   45,   46,   47,   35,   48,   35,
+       49,   50,   51,    1,   52,   53,   54,   55,   56,   57,
 
-       57,   58,   59,   60,   61,   35,   35,   62,   63,   64,
-       65,   66,   35,   67,   68,   69,   70,   71,   72,   35,
-       73,   35,   74,   75,   76,    1,    1,    1,    1,    1,
+       58,   59,   60,   61,   62,   35,   63,   64,   65,   66,
+       67,   68,   35,   69,   70,   71,   72,   73,   74,   35,
+       75,   35,   76,   77,   78,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,   77,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,   79,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,   78,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,   80,    1,    1,    1,    1,    1,    1,
 
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -438,157 +440,170 @@ static yyconst flex_int32_t yy_ec[256] =
         1,    1,    1,    1,    1
     } ;
 
-static yyconst flex_int32_t yy_meta[79] =
+static yyconst flex_int32_t yy_meta[81] =
     {   0,
         1,    1,    2,    1,    1,    1,    1,    1,    1,    1,
         1,    3,    1,    1,    1,    1,    1,    4,    4,    1,
         1,    1,    1,    1,    5,    6,    6,    6,    6,    6,
         6,    6,    6,    6,    6,    6,    6,    6,    6,    6,
-        6,    6,    6,    6,    6,    6,    6,    1,    1,    1,
-        7,    1,    6,    6,    6,    6,    6,    6,    6,    6,
+        6,    6,    6,    6,    6,    6,    6,    6,    1,    1,
+        1,    7,    1,    6,    6,    6,    6,    6,    6,    6,
         6,    6,    6,    6,    6,    6,    6,    6,    6,    6,
-        6,    6,    6,    1,    1,    1,    1,    1
+        6,    6,    6,    6,    6,    1,    1,    1,    1,    1
     } ;
 
-static yyconst flex_int16_t yy_base[266] =
+static yyconst flex_int16_t yy_base[294] =
     {   0,
-        0,    0,   76,   77,   78,   81,   82,   83,   84,   85,
-      386,  385,   90,   91,   80,  102,  387,  537,  384,  537,
-      320,  537,    0,  537,  280,  537,  537,  537,  537,  537,
-      537,  537,  269,   83,   80,   90,  256,  217,  198,  189,
-      537,   72,   80,    0,   59,  115,  112,   76,   97,  123,
-      116,  123,   83,  113,  121,  126,  124,  537,  537,  123,
-      537,  537,   96,  537,   77,  537,  537,    0,  537,  537,
-      537,    0,   73,  537,  537,  537,    0,  537,  537,  537,
-        0,    0,  537,    0,  537,  104,  537,  537,  537,  130,
-      117,  537,    0,  537,  537,  537,  537,  151,  182,  180,
-
-      537,  537,  537,  537,    0,  154,   64,    0,  143,  146,
-      160,  159,  147,  149,  161,  168,  170,  171,  187,  192,
-      172,  181,  183,  186,    0,  180,  188,  183,  183,  213,
-      193,  240,   60,  537,  537,  537,  537,  537,  537,  537,
-        0,    0,  537,  537,  245,  247,  249,    0,   56,  204,
-        0,    0,    0,    0,  220,  215,  229,  231,  231,    0,
-      237,  239,  249,  244,    0,  246,  254,    0,  250,  260,
-      250,  254,  248,  250,  264,  269,  266,  264,    0,  307,
-       50,    0,  271,  275,    0,  274,  280,  283,  284,  276,
-      286,    0,  286,    0,    0,  291,  286,  307,  295,    0,
-
-        0,  295,  298,    0,  302,  313,  305,    0,  304,    0,
-      309,  305,    0,  305,  320,  323,  316,  322,  316,  337,
-      323,  339,    0,  341,    0,  334,    0,  346,    0,    0,
-        0,  338,    0,  339,    0,  354,    0,  354,    0,    0,
-        0,  537,  411,  418,  425,  432,  439,  446,  453,   93,
-      457,  461,  463,  470,  477,  484,  491,  498,  505,  509,
-      513,  517,  521,  525,  529
+        0,    0,   78,   79,   80,   83,   84,   85,   86,   87,
+      444,  442,   92,   93,   82,  104,  444,  589,  441,  589,
+      418,  589,    0,  589,  431,  589,  589,  589,  589,  589,
+      589,  589,  421,   85,   82,   92,  414,  363,  360,  326,
+      589,   74,   81,    0,   60,   91,  122,   73,   80,  278,
+      109,  114,  110,  127,  132,  119,  123,  134,  589,  589,
+      235,  589,  589,  154,  589,  146,  589,  589,    0,  589,
+      589,  589,    0,  138,  589,  589,  589,    0,  589,  589,
+      589,    0,    0,  589,    0,  589,  161,  589,  589,  589,
+      131,  167,  589,    0,  589,  589,  589,  589,  155,  185,
+
+      176,  589,  589,  589,  589,    0,  150,  106,    0,  145,
+      143,  161,  155,  150,  158,  165,  173,  175,  171,  189,
+      189,  176,  176,  183,  183,  186,    0,  180,  214,  186,
+      187,  185,  232,  194,  244,   71,  589,  589,  589,  589,
+      589,  589,  589,    0,    0,  589,  589,  248,  223,  250,
+        0,   65,  203,    0,    0,    0,    0,  227,  242,  229,
+      231,  232,    0,  236,  240,  241,  241,  250,    0,  250,
+      256,    0,  251,  263,  252,  256,  249,  253,  253,  275,
+      283,  280,  280,    0,  298,   62,    0,  293,  295,    0,
+      292,  297,  298,  296,  286,  290,    0,  294,  291,    0,
+
+        0,  296,  293,  314,  300,  299,    0,    0,  300,  303,
+        0,  314,  319,  310,    0,  310,    0,  321,  320,  323,
+        0,  322,  343,  349,  341,  348,  351,  339,  358,  342,
+      360,    0,  360,    0,  349,  356,    0,  360,    0,  353,
+        0,    0,  353,    0,  354,    0,  369,  371,    0,  358,
+      373,    0,  365,    0,   57,    0,  367,  373,   51,  378,
+      374,  375,  395,  393,  386,    0,  400,  393,    0,  589,
+      463,  470,  477,  484,  491,  498,  505,   95,  509,  513,
+      515,  522,  529,  536,  543,  550,  557,  561,  565,  569,
+      573,  577,  581
+
     } ;
 
-static yyconst flex_int16_t yy_def[266] =
+static yyconst flex_int16_t yy_def[294] =
     {   0,
-      242,    1,  243,  243,  244,  244,  245,  245,  246,  246,
-      247,  247,  248,  248,  249,  249,  242,  242,  242,  242,
-      242,  242,  250,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  251,  252,  252,  252,  252,  252,  252,  252,  252,
-      252,  252,  252,  252,  252,  252,  252,  242,  242,  253,
-      242,  242,  242,  242,  242,  242,  242,  254,  242,  242,
-      242,  255,  242,  242,  242,  242,  256,  242,  242,  242,
-      257,  258,  242,  259,  242,  242,  242,  242,  242,  242,
-      242,  242,  252,  242,  242,  242,  242,  242,  242,  242,
-
-      242,  242,  242,  242,  260,  251,  261,  252,  252,  252,
-      252,  252,  252,  252,  252,  252,  252,  252,  252,  252,
-      252,  252,  252,  252,  252,  252,  252,  252,  252,  252,
-      252,  262,  253,  242,  242,  242,  242,  242,  242,  242,
-      258,  259,  242,  242,  242,  242,  242,  260,  263,  252,
-      252,  252,  252,  252,  252,  252,  252,  252,  252,  252,
-      252,  252,  252,  252,  252,  252,  252,  252,  252,  252,
-      252,  252,  252,  252,  252,  252,  252,  252,  264,  262,
-      263,  265,  252,  252,  252,  252,  252,  252,  252,  252,
-      252,  252,  252,  252,  252,  252,  252,  252,  252,  252,
-
-      252,  252,  252,  252,  252,  252,  252,  252,  252,  252,
-      252,  252,  252,  252,  252,  252,  252,  252,  252,  252,
-      252,  252,  252,  252,  252,  252,  252,  252,  252,  252,
-      252,  252,  252,  252,  252,  252,  252,  252,  252,  252,
-      252,    0,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242
+      270,    1,  271,  271,  272,  272,  273,  273,  274,  274,
+      275,  275,  276,  276,  277,  277,  270,  270,  270,  270,
+      270,  270,  278,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  279,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  270,  270,
+      281,  270,  270,  270,  270,  270,  270,  270,  282,  270,
+      270,  270,  283,  270,  270,  270,  270,  284,  270,  270,
+      270,  285,  286,  270,  287,  270,  270,  270,  270,  270,
+      270,  270,  270,  280,  270,  270,  270,  270,  270,  270,
+
+      270,  270,  270,  270,  270,  288,  279,  289,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  290,  281,  270,  270,  270,  270,
+      270,  270,  270,  286,  287,  270,  270,  270,  270,  270,
+      288,  291,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  292,  290,  291,  293,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,  280,
+      280,  280,  280,  280,  280,  280,  280,  280,  280,    0,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270
+
     } ;
 
-static yyconst flex_int16_t yy_nxt[616] =
+static yyconst flex_int16_t yy_nxt[670] =
     {   0,
        18,   19,   20,   21,   22,   23,   24,   25,   26,   27,
        28,   29,   30,   31,   32,   33,   34,   35,   36,   37,
        38,   39,   40,   41,   42,   43,   44,   45,   46,   44,
-       47,   48,   44,   49,   44,   50,   44,   51,   52,   44,
-       53,   54,   55,   56,   44,   57,   44,   58,   18,   59,
-       60,   61,   43,   44,   45,   46,   44,   47,   48,   44,
-       49,   50,   44,   51,   52,   44,   53,   54,   55,   56,
-       44,   57,   44,   62,   63,   64,   18,   65,   67,   67,
-       71,   88,   89,   71,   75,   75,   79,   79,   80,   80,
-       76,   76,   85,   85,   96,   98,  106,  113,   93,   97,
-
-      182,   86,   86,   88,   89,   98,  182,  100,  100,   99,
-      133,  109,  127,   90,  107,  110,  119,  111,   91,   99,
-      143,  112,  107,  113,   68,   68,   72,   69,   69,   72,
-       77,   77,   81,   81,  120,   90,   99,  116,  109,  127,
-       90,  110,  119,  111,  114,  117,   99,  112,  115,  138,
-      118,  128,  121,  135,  123,   73,  122,  131,   73,  124,
-      120,  129,   90,  125,  116,  130,  126,  144,  145,  145,
-      134,  114,  117,  133,  150,  115,  118,  128,  242,  121,
-      123,  151,  155,  122,  131,  124,  154,  129,  152,  125,
-      156,  130,  126,  144,  146,   98,  146,  100,  100,  147,
-
-      147,  150,  157,  158,  107,  159,  153,  151,  155,   99,
-      104,  160,  161,  154,  165,  152,  156,  166,  162,  103,
-      167,  169,  170,  174,  171,  168,  175,  172,  157,  158,
-      173,  159,  153,  163,  164,  178,   99,  160,  102,  161,
-      165,  176,  185,  166,  183,  162,  167,  169,  170,  174,
-      171,  168,  175,  172,  177,  184,  173,  179,  179,  163,
-      164,  178,  145,  145,  147,  147,  147,  147,  176,  185,
-      183,  186,  187,  188,   99,  101,  189,  190,  191,  193,
-      177,  184,  192,  194,   95,  195,  196,   94,  197,  198,
-      179,  199,  200,  201,  202,  203,  204,  186,  187,  188,
-
-      205,   99,  189,  190,  206,  191,  193,  207,  192,  208,
-      194,  195,  209,  196,  197,  198,  210,  199,  200,  211,
-      201,  202,  203,  204,  179,  179,  212,  205,  213,  214,
-      215,  206,  216,  220,  207,  217,  208,  218,  219,  209,
-      221,   92,  222,  210,  223,  211,  224,  225,  226,  227,
-      228,  230,  212,  229,  213,  214,  215,  179,  231,  216,
-      220,  217,  232,  218,  219,  233,  234,  221,  222,  235,
-      223,  236,  224,  225,  226,  237,  227,  228,  230,  229,
-      238,  239,  240,  241,  231,   91,  242,   83,   83,  232,
-      242,  233,  242,  234,  242,  242,  235,  236,  242,  242,
-
-      242,  242,  237,  242,  242,  242,  238,  239,  242,  240,
-      241,   66,   66,   66,   66,   66,   66,   66,   70,   70,
-       70,   70,   70,   70,   70,   74,   74,   74,   74,   74,
-       74,   74,   78,   78,   78,   78,   78,   78,   78,   82,
-       82,   82,   82,   82,   82,   82,   84,   84,   84,   84,
-       84,   84,   84,   87,   87,   87,   87,   87,   87,   87,
-      105,  105,  105,  105,  108,  242,  108,  108,  132,  132,
-      136,  242,  136,  136,  136,  136,  136,  137,  242,  137,
-      137,  137,  137,  137,  139,  242,  139,  139,  139,  139,
-      139,  140,  242,  140,  140,  140,  140,  140,  141,  242,
-
-      141,  141,  141,  141,  141,  142,  242,  242,  142,  142,
-      142,  142,  148,  242,  148,  148,  149,  242,  149,  149,
-      180,  242,  180,  180,  181,  242,  181,  181,  179,  242,
-      179,  179,  182,  242,  182,  182,   17,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242
+       47,   48,   44,   49,   44,   50,   51,   44,   52,   53,
+       44,   54,   55,   56,   57,   44,   58,   44,   59,   18,
+       60,   61,   62,   43,   44,   45,   46,   44,   47,   48,
+       44,   49,   50,   51,   44,   52,   53,   44,   54,   55,
+       56,   57,   44,   58,   44,   63,   64,   65,   18,   66,
+       68,   68,   72,   89,   90,   72,   76,   76,   80,   80,
+       81,   81,   77,   77,   86,   86,   97,   99,  107,  114,
+
+       94,   98,  261,   87,   87,   89,   90,   99,  258,  101,
+      101,  100,  110,  187,  120,   91,  187,  111,  121,  112,
+      115,  100,  136,  113,  116,  108,  114,   69,   69,   73,
+       70,   70,   73,   78,   78,   82,   82,   91,  123,  100,
+      110,  120,  124,   91,  111,  121,  112,  117,  115,  100,
+      113,  127,  116,  125,  128,  118,  129,  108,  126,   74,
+      132,  119,   74,  133,  130,   91,  123,  134,   92,  147,
+      124,  131,  148,  148,  270,  117,  153,  146,  127,  154,
+      125,  128,  157,  118,  129,  126,  158,  132,  119,  155,
+      133,   99,  130,  101,  101,  134,  147,  149,  131,  149,
+
+      159,  108,  150,  150,  153,  100,  154,  160,  156,  161,
+      157,  162,  163,  158,  164,  165,  141,  155,  168,  169,
+      170,  171,  173,  174,  138,  178,  172,  159,  179,  180,
+      137,  166,  167,  100,  160,  156,  161,  183,  162,  163,
+      150,  150,  164,  165,  188,  168,  169,  170,  171,  173,
+      174,  175,  178,  172,  176,  179,  180,  177,  166,  167,
+      181,  184,  184,  189,  183,  148,  148,  150,  150,  190,
+      196,  188,  191,  192,  182,  193,  194,  100,  175,  195,
+      197,  176,  198,  199,  177,  200,  136,  201,  181,  202,
+      189,  203,  204,  205,  206,  184,  207,  190,  196,  191,
+
+      192,  182,  193,  194,  208,  100,  195,  197,  209,  210,
+      198,  199,  211,  200,  201,  184,  184,  202,  203,  204,
+      205,  206,  212,  207,  213,  214,  215,  216,  217,  122,
+      218,  219,  208,  220,  221,  222,  209,  210,  223,  224,
+      211,  225,  226,  227,  228,  229,  230,  105,  231,  184,
+      212,  232,  213,  214,  215,  216,  217,  218,  219,  233,
+      220,  221,  222,  234,  235,  223,  236,  224,  225,  226,
+      227,  228,  237,  229,  230,  231,  238,  240,  232,  239,
+      241,  104,  242,  243,  103,  244,  233,  245,  246,  249,
+      234,  235,  247,  236,  248,  250,  251,  252,  253,  254,
+
+      237,  255,  256,  262,  238,  240,  239,  257,  241,  242,
+      259,  243,  244,  260,  263,  245,  246,  249,  264,  247,
+      265,  248,  250,  251,  252,  266,  253,  254,  255,  267,
+      256,  262,  268,  102,  257,  269,   96,  259,   95,   93,
+      260,  263,   92,  270,   84,  264,   84,  270,  265,  270,
+      270,  270,  270,  266,  270,  270,  267,  270,  270,  270,
+      268,  270,  269,   67,   67,   67,   67,   67,   67,   67,
+       71,   71,   71,   71,   71,   71,   71,   75,   75,   75,
+       75,   75,   75,   75,   79,   79,   79,   79,   79,   79,
+       79,   83,   83,   83,   83,   83,   83,   83,   85,   85,
+
+       85,   85,   85,   85,   85,   88,   88,   88,   88,   88,
+       88,   88,  106,  106,  106,  106,  109,  270,  109,  109,
+      135,  135,  139,  270,  139,  139,  139,  139,  139,  140,
+      270,  140,  140,  140,  140,  140,  142,  270,  142,  142,
+      142,  142,  142,  143,  270,  143,  143,  143,  143,  143,
+      144,  270,  144,  144,  144,  144,  144,  145,  270,  270,
+      145,  145,  145,  145,  151,  270,  151,  151,  152,  270,
+      152,  152,  185,  270,  185,  185,  186,  270,  186,  186,
+      184,  270,  184,  184,  187,  270,  187,  187,   17,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270
     } ;
 
-static yyconst flex_int16_t yy_chk[616] =
+static yyconst flex_int16_t yy_chk[670] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -597,77 +612,82 @@ static yyconst flex_int16_t yy_chk[616] =
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    3,    4,
-        5,   15,   15,    6,    7,    8,    9,   10,    9,   10,
-        7,    8,   13,   14,   34,   35,   42,   45,  250,   34,
-
-      181,   13,   14,   16,   16,   36,  149,   36,   36,   35,
-      133,   43,   53,   15,  107,   43,   48,   43,   91,   36,
-       86,   43,   42,   45,    3,    4,    5,    3,    4,    6,
-        7,    8,    9,   10,   49,   16,   35,   47,   43,   53,
-       15,   43,   48,   43,   46,   47,   36,   43,   46,   73,
-       47,   54,   50,   65,   51,    5,   50,   57,    6,   51,
-       49,   55,   16,   52,   47,   56,   52,   90,   98,   98,
-       63,   46,   47,   60,  109,   46,   47,   54,  106,   50,
-       51,  110,  113,   50,   57,   51,  112,   55,  111,   52,
-      114,   56,   52,   90,   99,  100,   99,  100,  100,   99,
-
-       99,  109,  115,  116,  106,  117,  111,  110,  113,  100,
-       40,  118,  119,  112,  121,  111,  114,  122,  120,   39,
-      123,  124,  126,  128,  127,  123,  129,  127,  115,  116,
-      127,  117,  111,  120,  120,  131,  100,  118,   38,  119,
-      121,  130,  156,  122,  150,  120,  123,  124,  126,  128,
-      127,  123,  129,  127,  130,  155,  127,  132,  132,  120,
-      120,  131,  145,  145,  146,  146,  147,  147,  130,  156,
-      150,  157,  158,  159,  145,   37,  161,  162,  163,  166,
-      130,  155,  164,  167,   33,  169,  170,   25,  171,  172,
-      132,  173,  174,  175,  176,  177,  178,  157,  158,  159,
-
-      183,  145,  161,  162,  184,  163,  166,  186,  164,  187,
-      167,  169,  188,  170,  171,  172,  189,  173,  174,  190,
-      175,  176,  177,  178,  180,  180,  191,  183,  193,  196,
-      197,  184,  198,  205,  186,  199,  187,  202,  203,  188,
-      206,   21,  207,  189,  209,  190,  211,  212,  214,  215,
-      216,  218,  191,  217,  193,  196,  197,  180,  219,  198,
-      205,  199,  220,  202,  203,  221,  222,  206,  207,  224,
-      209,  226,  211,  212,  214,  228,  215,  216,  218,  217,
-      232,  234,  236,  238,  219,   19,   17,   12,   11,  220,
-        0,  221,    0,  222,    0,    0,  224,  226,    0,    0,
-
-        0,    0,  228,    0,    0,    0,  232,  234,    0,  236,
-      238,  243,  243,  243,  243,  243,  243,  243,  244,  244,
-      244,  244,  244,  244,  244,  245,  245,  245,  245,  245,
-      245,  245,  246,  246,  246,  246,  246,  246,  246,  247,
-      247,  247,  247,  247,  247,  247,  248,  248,  248,  248,
-      248,  248,  248,  249,  249,  249,  249,  249,  249,  249,
-      251,  251,  251,  251,  252,    0,  252,  252,  253,  253,
-      254,    0,  254,  254,  254,  254,  254,  255,    0,  255,
-      255,  255,  255,  255,  256,    0,  256,  256,  256,  256,
-      256,  257,    0,  257,  257,  257,  257,  257,  258,    0,
-
-      258,  258,  258,  258,  258,  259,    0,    0,  259,  259,
-      259,  259,  260,    0,  260,  260,  261,    0,  261,  261,
-      262,    0,  262,  262,  263,    0,  263,  263,  264,    0,
-      264,  264,  265,    0,  265,  265,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-
-      242,  242,  242,  242,  242,  242,  242,  242,  242,  242,
-      242,  242,  242,  242,  242
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        3,    4,    5,   15,   15,    6,    7,    8,    9,   10,
+        9,   10,    7,    8,   13,   14,   34,   35,   42,   45,
+
+      278,   34,  259,   13,   14,   16,   16,   36,  255,   36,
+       36,   35,   43,  186,   48,   15,  152,   43,   49,   43,
+       46,   36,  136,   43,   46,   42,   45,    3,    4,    5,
+        3,    4,    6,    7,    8,    9,   10,   16,   51,   35,
+       43,   48,   51,   15,   43,   49,   43,   47,   46,   36,
+       43,   53,   46,   52,   53,   47,   54,  108,   52,    5,
+       56,   47,    6,   57,   55,   16,   51,   58,   92,   91,
+       51,   55,   99,   99,  107,   47,  110,   87,   53,  111,
+       52,   53,  113,   47,   54,   52,  114,   56,   47,  112,
+       57,  101,   55,  101,  101,   58,   91,  100,   55,  100,
+
+      115,  107,  100,  100,  110,  101,  111,  116,  112,  117,
+      113,  118,  119,  114,  120,  121,   74,  112,  122,  123,
+      124,  125,  126,  128,   66,  130,  125,  115,  131,  132,
+       64,  121,  121,  101,  116,  112,  117,  134,  118,  119,
+      149,  149,  120,  121,  153,  122,  123,  124,  125,  126,
+      128,  129,  130,  125,  129,  131,  132,  129,  121,  121,
+      133,  135,  135,  158,  134,  148,  148,  150,  150,  159,
+      166,  153,  160,  161,  133,  162,  164,  148,  129,  165,
+      167,  129,  168,  170,  129,  171,   61,  173,  133,  174,
+      158,  175,  176,  177,  178,  135,  179,  159,  166,  160,
+
+      161,  133,  162,  164,  180,  148,  165,  167,  181,  182,
+      168,  170,  183,  171,  173,  185,  185,  174,  175,  176,
+      177,  178,  188,  179,  189,  191,  192,  193,  194,   50,
+      195,  196,  180,  198,  199,  202,  181,  182,  203,  204,
+      183,  205,  206,  209,  210,  212,  213,   40,  214,  185,
+      188,  216,  189,  191,  192,  193,  194,  195,  196,  218,
+      198,  199,  202,  219,  220,  203,  222,  204,  205,  206,
+      209,  210,  223,  212,  213,  214,  224,  226,  216,  225,
+      227,   39,  228,  229,   38,  230,  218,  231,  233,  238,
+      219,  220,  235,  222,  236,  240,  243,  245,  247,  248,
+
+      223,  250,  251,  260,  224,  226,  225,  253,  227,  228,
+      257,  229,  230,  258,  261,  231,  233,  238,  262,  235,
+      263,  236,  240,  243,  245,  264,  247,  248,  250,  265,
+      251,  260,  267,   37,  253,  268,   33,  257,   25,   21,
+      258,  261,   19,   17,   12,  262,   11,    0,  263,    0,
+        0,    0,    0,  264,    0,    0,  265,    0,    0,    0,
+      267,    0,  268,  271,  271,  271,  271,  271,  271,  271,
+      272,  272,  272,  272,  272,  272,  272,  273,  273,  273,
+      273,  273,  273,  273,  274,  274,  274,  274,  274,  274,
+      274,  275,  275,  275,  275,  275,  275,  275,  276,  276,
+
+      276,  276,  276,  276,  276,  277,  277,  277,  277,  277,
+      277,  277,  279,  279,  279,  279,  280,    0,  280,  280,
+      281,  281,  282,    0,  282,  282,  282,  282,  282,  283,
+        0,  283,  283,  283,  283,  283,  284,    0,  284,  284,
+      284,  284,  284,  285,    0,  285,  285,  285,  285,  285,
+      286,    0,  286,  286,  286,  286,  286,  287,    0,    0,
+      287,  287,  287,  287,  288,    0,  288,  288,  289,    0,
+      289,  289,  290,    0,  290,  290,  291,    0,  291,  291,
+      292,    0,  292,  292,  293,    0,  293,  293,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270,  270,
+      270,  270,  270,  270,  270,  270,  270,  270,  270
     } ;
 
 /* Table of booleans, true if rule could match eol. */
-static yyconst flex_int32_t yy_rule_can_match_eol[97] =
+static yyconst flex_int32_t yy_rule_can_match_eol[99] =
     {   0,
 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-    0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 
-    0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0,     };
+    0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 
+    0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0,     };
 
 /* The intent behind this definition is that it'll catch
  * any uses of REJECT which flex missed.
@@ -1017,13 +1037,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 243 )
+				if ( yy_current_state >= 271 )
 					yy_c = yy_meta[(unsigned int) yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
 			++yy_cp;
 			}
-		while ( yy_current_state != 242 );
+		while ( yy_current_state != 270 );
 		yy_cp = yyg->yy_last_accepting_cpos;
 		yy_current_state = yyg->yy_last_accepting_state;
 
@@ -1208,17 +1228,35 @@ YY_RULE_SETUP
 case 26:
 YY_RULE_SETUP
 {
-  return T_ANY;
+  /* keyword, but also usable as function or attribute name */
+  yylval->strval.value = yyextra->query()->registerString(yytext, yyleng);
+  yylval->strval.length = yyleng;
+  return T_SHORTEST_PATH;
 }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
 {
-  return T_ALL;
+  /* keyword, but also usable as function or attribute name */
+  yylval->strval.value = yyextra->query()->registerString(yytext, yyleng);
+  yylval->strval.length = yyleng;
+  return T_K_SHORTEST_PATHS;
 }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
+{
+  return T_ANY;
+}
+	YY_BREAK
+case 29:
+YY_RULE_SETUP
+{
+  return T_ALL;
+}
+	YY_BREAK
+case 30:
+YY_RULE_SETUP
 {
   return T_NONE;
 }
@@ -1226,19 +1264,19 @@ YY_RULE_SETUP
 /* ---------------------------------------------------------------------------
   * predefined type literals
   * --------------------------------------------------------------------------- */
-case 29:
+case 31:
 YY_RULE_SETUP
 {
   return T_NULL;
 }
 	YY_BREAK
-case 30:
+case 32:
 YY_RULE_SETUP
 {
   return T_TRUE;
 }
 	YY_BREAK
-case 31:
+case 33:
 YY_RULE_SETUP
 {
   return T_FALSE;
@@ -1247,115 +1285,115 @@ YY_RULE_SETUP
 /* ---------------------------------------------------------------------------
   * operators
   * --------------------------------------------------------------------------- */
-case 32:
+case 34:
 YY_RULE_SETUP
 {
   return T_EQ;
 }
 	YY_BREAK
-case 33:
+case 35:
 YY_RULE_SETUP
 {
   return T_NE;
 }
 	YY_BREAK
-case 34:
+case 36:
 YY_RULE_SETUP
 {
   return T_GE;
 }
 	YY_BREAK
-case 35:
+case 37:
 YY_RULE_SETUP
 {
   return T_GT;
 }
 	YY_BREAK
-case 36:
+case 38:
 YY_RULE_SETUP
 {
   return T_LE;
 }
 	YY_BREAK
-case 37:
+case 39:
 YY_RULE_SETUP
 {
   return T_LT;
 }
 	YY_BREAK
-case 38:
+case 40:
 YY_RULE_SETUP
 {
   return T_ASSIGN;
 }
 	YY_BREAK
-case 39:
+case 41:
 YY_RULE_SETUP
 {
   return T_NOT;
 }
 	YY_BREAK
-case 40:
+case 42:
 YY_RULE_SETUP
 {
   return T_AND;
 }
 	YY_BREAK
-case 41:
+case 43:
 YY_RULE_SETUP
 {
   return T_OR;
 }
 	YY_BREAK
-case 42:
+case 44:
 YY_RULE_SETUP
 {
   return T_PLUS;
 }
 	YY_BREAK
-case 43:
+case 45:
 YY_RULE_SETUP
 {
   return T_MINUS;
 }
 	YY_BREAK
-case 44:
+case 46:
 YY_RULE_SETUP
 {
   return T_TIMES;
 }
 	YY_BREAK
-case 45:
+case 47:
 YY_RULE_SETUP
 {
   return T_DIV;
 }
 	YY_BREAK
-case 46:
+case 48:
 YY_RULE_SETUP
 {
   return T_MOD;
 }
 	YY_BREAK
-case 47:
+case 49:
 YY_RULE_SETUP
 {
   return T_QUESTION;
 }
 	YY_BREAK
-case 48:
+case 50:
 YY_RULE_SETUP
 {
   return T_SCOPE;
 }
 	YY_BREAK
-case 49:
+case 51:
 YY_RULE_SETUP
 {
   return T_COLON;
 }
 	YY_BREAK
-case 50:
+case 52:
 YY_RULE_SETUP
 {
   return T_RANGE; 
@@ -1364,43 +1402,43 @@ YY_RULE_SETUP
 /* ---------------------------------------------------------------------------
   * punctuation
   * --------------------------------------------------------------------------- */
-case 51:
+case 53:
 YY_RULE_SETUP
 {
   return T_COMMA;
 }
 	YY_BREAK
-case 52:
+case 54:
 YY_RULE_SETUP
 {
   return T_OPEN;
 }
 	YY_BREAK
-case 53:
+case 55:
 YY_RULE_SETUP
 {
   return T_CLOSE;
 }
 	YY_BREAK
-case 54:
+case 56:
 YY_RULE_SETUP
 {
   return T_OBJECT_OPEN;
 }
 	YY_BREAK
-case 55:
+case 57:
 YY_RULE_SETUP
 {
   return T_OBJECT_CLOSE;
 }
 	YY_BREAK
-case 56:
+case 58:
 YY_RULE_SETUP
 {
   return T_ARRAY_OPEN;
 }
 	YY_BREAK
-case 57:
+case 59:
 YY_RULE_SETUP
 {
   return T_ARRAY_CLOSE;
@@ -1409,7 +1447,7 @@ YY_RULE_SETUP
 /* ---------------------------------------------------------------------------
   * identifiers
   * --------------------------------------------------------------------------- */
-case 58:
+case 60:
 YY_RULE_SETUP
 { 
   /* unquoted string */
@@ -1418,7 +1456,7 @@ YY_RULE_SETUP
   return T_STRING; 
 }
 	YY_BREAK
-case 59:
+case 61:
 YY_RULE_SETUP
 {
   /* string enclosed in backticks */
@@ -1426,7 +1464,7 @@ YY_RULE_SETUP
   BEGIN(BACKTICK);
 }
 	YY_BREAK
-case 60:
+case 62:
 YY_RULE_SETUP
 {
   /* end of backtick-enclosed string */
@@ -1437,26 +1475,26 @@ YY_RULE_SETUP
   return T_STRING;
 }
 	YY_BREAK
-case 61:
+case 63:
 YY_RULE_SETUP
 {
   /* character escaped by backslash */
 }
 	YY_BREAK
-case 62:
-/* rule 62 can match eol */
+case 64:
+/* rule 64 can match eol */
 YY_RULE_SETUP
 {
   /* newline character inside backtick */
 }
 	YY_BREAK
-case 63:
+case 65:
 YY_RULE_SETUP
 {
   /* any character (except newline) inside backtick */
 }
 	YY_BREAK
-case 64:
+case 66:
 YY_RULE_SETUP
 {
   /* string enclosed in forwardticks */
@@ -1464,7 +1502,7 @@ YY_RULE_SETUP
   BEGIN(FORWARDTICK);
 }
 	YY_BREAK
-case 65:
+case 67:
 YY_RULE_SETUP
 {
   /* end of forwardtick-enclosed string */
@@ -1475,20 +1513,20 @@ YY_RULE_SETUP
   return T_STRING;
 }
 	YY_BREAK
-case 66:
+case 68:
 YY_RULE_SETUP
 {
   /* character escaped by backslash */
 }
 	YY_BREAK
-case 67:
-/* rule 67 can match eol */
+case 69:
+/* rule 69 can match eol */
 YY_RULE_SETUP
 {
   /* newline character inside forwardtick */
 }
 	YY_BREAK
-case 68:
+case 70:
 YY_RULE_SETUP
 {
   /* any character (except newline) inside forwardtick */
@@ -1497,14 +1535,14 @@ YY_RULE_SETUP
 /* ---------------------------------------------------------------------------
   * strings
   * --------------------------------------------------------------------------- */
-case 69:
+case 71:
 YY_RULE_SETUP
 {
   yyextra->marker(yyextra->queryString() + yyextra->offset());
   BEGIN(DOUBLE_QUOTE);
 }
 	YY_BREAK
-case 70:
+case 72:
 YY_RULE_SETUP
 {
   /* end of quote-enclosed string */
@@ -1515,33 +1553,33 @@ YY_RULE_SETUP
   return T_QUOTED_STRING;
 }
 	YY_BREAK
-case 71:
+case 73:
 YY_RULE_SETUP
 {
   /* character escaped by backslash */
 }
 	YY_BREAK
-case 72:
-/* rule 72 can match eol */
+case 74:
+/* rule 74 can match eol */
 YY_RULE_SETUP
 {
   /* newline character inside quote */
 }
 	YY_BREAK
-case 73:
+case 75:
 YY_RULE_SETUP
 {
   /* any character (except newline) inside quote */
 }
 	YY_BREAK
-case 74:
+case 76:
 YY_RULE_SETUP
 {
   yyextra->marker(yyextra->queryString() + yyextra->offset());
   BEGIN(SINGLE_QUOTE);
 }
 	YY_BREAK
-case 75:
+case 77:
 YY_RULE_SETUP
 {
   /* end of quote-enclosed string */
@@ -1552,20 +1590,20 @@ YY_RULE_SETUP
   return T_QUOTED_STRING;
 }
 	YY_BREAK
-case 76:
+case 78:
 YY_RULE_SETUP
 {
   /* character escaped by backslash */
 }
 	YY_BREAK
-case 77:
-/* rule 77 can match eol */
+case 79:
+/* rule 79 can match eol */
 YY_RULE_SETUP
 {
   /* newline character inside quote */ 
 }
 	YY_BREAK
-case 78:
+case 80:
 YY_RULE_SETUP
 {
   /* any character (except newline) inside quote */
@@ -1574,7 +1612,7 @@ YY_RULE_SETUP
 /* ---------------------------------------------------------------------------
   * number literals
   * --------------------------------------------------------------------------- */
-case 79:
+case 81:
 YY_RULE_SETUP
 {  
   /* a numeric integer value */
@@ -1602,7 +1640,7 @@ YY_RULE_SETUP
   return T_INTEGER;
 }
 	YY_BREAK
-case 80:
+case 82:
 YY_RULE_SETUP
 { 
   /* a numeric double value */
@@ -1627,7 +1665,7 @@ YY_RULE_SETUP
 /* ---------------------------------------------------------------------------
   * bind parameters
   * --------------------------------------------------------------------------- */
-case 81:
+case 83:
 YY_RULE_SETUP
 {
   /* bind parameters must start with a @
@@ -1640,14 +1678,14 @@ YY_RULE_SETUP
 /* ---------------------------------------------------------------------------
   * whitespace etc.
   * --------------------------------------------------------------------------- */
-case 82:
+case 84:
 YY_RULE_SETUP
 {
   /* whitespace is ignored */ 
 }
 	YY_BREAK
-case 83:
-/* rule 83 can match eol */
+case 85:
+/* rule 85 can match eol */
 YY_RULE_SETUP
 {
   yycolumn = 0;
@@ -1656,14 +1694,14 @@ YY_RULE_SETUP
 /* ---------------------------------------------------------------------------
   * comments
   * --------------------------------------------------------------------------- */
-case 84:
+case 86:
 YY_RULE_SETUP
 {
   BEGIN(COMMENT_SINGLE);
 }
 	YY_BREAK
-case 85:
-/* rule 85 can match eol */
+case 87:
+/* rule 87 can match eol */
 YY_RULE_SETUP
 {
   /* line numbers are counted elsewhere already */
@@ -1671,38 +1709,38 @@ YY_RULE_SETUP
   BEGIN(INITIAL);
 }
 	YY_BREAK
-case 86:
+case 88:
 YY_RULE_SETUP
 { 
   /* everything else */
 }
 	YY_BREAK
-case 87:
+case 89:
 YY_RULE_SETUP
 {
   BEGIN(COMMENT_MULTI);
 }
 	YY_BREAK
-case 88:
+case 90:
 YY_RULE_SETUP
 {
   BEGIN(INITIAL);
 }
 	YY_BREAK
-case 89:
+case 91:
 YY_RULE_SETUP
 { 
   // eat comment in chunks
 }
 	YY_BREAK
-case 90:
+case 92:
 YY_RULE_SETUP
 {
   // eat the lone star
 }
 	YY_BREAK
-case 91:
-/* rule 91 can match eol */
+case 93:
+/* rule 93 can match eol */
 YY_RULE_SETUP
 {
   /* line numbers are counted elsewhere already */
@@ -1712,7 +1750,7 @@ YY_RULE_SETUP
 /* ---------------------------------------------------------------------------
   * special transformation for NOT IN to T_NIN
   * --------------------------------------------------------------------------- */
-case 92:
+case 94:
 YY_RULE_SETUP
 {
   /* T_NOT + T_IN => T_NIN */
@@ -1720,14 +1758,14 @@ YY_RULE_SETUP
   return T_NIN;
 }
 	YY_BREAK
-case 93:
-/* rule 93 can match eol */
+case 95:
+/* rule 95 can match eol */
 YY_RULE_SETUP
 {
   /* ignore whitespace */
 }
 	YY_BREAK
-case 94:
+case 96:
 YY_RULE_SETUP
 {
   /* found something different to T_IN */
@@ -1744,14 +1782,14 @@ case YY_STATE_EOF(NOT):
   return T_NOT;
 }
 	YY_BREAK
-case 95:
+case 97:
 YY_RULE_SETUP
 {
   /* anything else is returned as it is */
   return (int) yytext[0];
 }
 	YY_BREAK
-case 96:
+case 98:
 YY_RULE_SETUP
 ECHO;
 	YY_BREAK
@@ -2055,7 +2093,7 @@ static int yy_get_next_buffer (yyscan_t yyscanner)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 243 )
+			if ( yy_current_state >= 271 )
 				yy_c = yy_meta[(unsigned int) yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
@@ -2084,11 +2122,11 @@ static int yy_get_next_buffer (yyscan_t yyscanner)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 243 )
+		if ( yy_current_state >= 271 )
 			yy_c = yy_meta[(unsigned int) yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-	yy_is_jam = (yy_current_state == 242);
+	yy_is_jam = (yy_current_state == 270);
 
 	return yy_is_jam ? 0 : yy_current_state;
 }
@@ -163,6 +163,20 @@ namespace arangodb {
   return T_INBOUND;
 }
 
+(?i:SHORTEST_PATH) {
+  /* keyword, but also usable as function or attribute name */
+  yylval->strval.value = yyextra->query()->registerString(yytext, yyleng);
+  yylval->strval.length = yyleng;
+  return T_SHORTEST_PATH;
+}
+
+(?i:K_SHORTEST_PATHS) {
+  /* keyword, but also usable as function or attribute name */
+  yylval->strval.value = yyextra->query()->registerString(yytext, yyleng);
+  yylval->strval.length = yyleng;
+  return T_K_SHORTEST_PATHS;
+}
+
 (?i:ANY) {
   return T_ANY;
 }
@@ -1204,12 +1204,17 @@ int getAllEdgesOnCoordinator(
   return res;
 }
 
-int getFilteredEdgesOnCoordinator(
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sends an edges request to all shards of an edge collection and
+/// collects the edges and the summed up statistics of the shards in result
+////////////////////////////////////////////////////////////////////////////////
+
+static int fetchEdgesFromShards(
     std::string const& dbname, std::string const& collname,
-    std::string const& vertex, TRI_edge_direction_e const& direction,
-    std::vector<traverser::TraverserExpression*> const& expressions,
-    arangodb::rest::HttpResponse::HttpResponseCode& responseCode,
-    std::string& contentType, arangodb::basics::Json& result) {
+    arangodb::rest::HttpRequest::HttpRequestType reqType,
+    std::string const& queryParameters,
+    std::shared_ptr<std::string const> reqBodyString,
+    arangodb::basics::Json& result) {
   TRI_ASSERT(result.isObject());
   TRI_ASSERT(result.members() == 0);
 
@@ -1226,41 +1231,22 @@ int getFilteredEdgesOnCoordinator(
 
   auto shards = collinfo->shardIds();
   CoordTransactionID coordTransactionID = TRI_NewTickServer();
-  std::string queryParameters = "?vertex=" + StringUtils::urlEncode(vertex);
-  if (direction == TRI_EDGE_IN) {
-    queryParameters += "&direction=in";
-  } else if (direction == TRI_EDGE_OUT) {
-    queryParameters += "&direction=out";
-  }
-  auto reqBodyString = std::make_shared<std::string>();
-  if (!expressions.empty()) {
-    arangodb::basics::Json body(Json::Array, expressions.size());
-    for (auto& e : expressions) {
-      arangodb::basics::Json tmp(Json::Object);
-      e->toJson(tmp, TRI_UNKNOWN_MEM_ZONE);
-      body.add(tmp.steal());
-    }
-    reqBodyString->append(body.toString());
-  }
+
   for (auto const& p : *shards) {
     std::unique_ptr<std::map<std::string, std::string>> headers(
         new std::map<std::string, std::string>());
-    cc->asyncRequest("", coordTransactionID, "shard:" + p.first,
-                     arangodb::rest::HttpRequest::HTTP_REQUEST_PUT,
+    cc->asyncRequest("", coordTransactionID, "shard:" + p.first, reqType,
                      "/_db/" + StringUtils::urlEncode(dbname) + "/_api/edges/" +
                          p.first + queryParameters,
                      reqBodyString, headers, nullptr, 3600.0);
   }
   // Now listen to the results:
-  int count;
-  responseCode = arangodb::rest::HttpResponse::OK;
-  contentType = "application/json; charset=utf-8";
   size_t filtered = 0;
   size_t scannedIndex = 0;
 
   arangodb::basics::Json documents(arangodb::basics::Json::Array);
 
-  for (count = (int)shards->size(); count > 0; count--) {
+  for (int count = (int)shards->size(); count > 0; count--) {
     auto res = cc->wait("", coordTransactionID, 0, "", 0.0);
     if (res.status == CL_COMM_TIMEOUT) {
       cc->drop("", coordTransactionID, 0, "");
@@ -1270,20 +1256,20 @@ int getFilteredEdgesOnCoordinator(
       cc->drop("", coordTransactionID, 0, "");
       return TRI_ERROR_INTERNAL;
     }
-    if (res.status == CL_COMM_RECEIVED) {
-    }
 
     std::unique_ptr<TRI_json_t> shardResult(
         TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, res.answer->body()));
 
     if (shardResult == nullptr || !TRI_IsObjectJson(shardResult.get())) {
+      cc->drop("", coordTransactionID, 0, "");
       return TRI_ERROR_INTERNAL;
     }
 
     bool const isError = arangodb::basics::JsonHelper::checkAndGetBooleanValue(
         shardResult.get(), "error");
     if (isError) {
-      // shared returned an error
+      // shard returned an error
+      cc->drop("", coordTransactionID, 0, "");
       return arangodb::basics::JsonHelper::getNumericValue<int>(
           shardResult.get(), "errorNum", TRI_ERROR_INTERNAL);
     }
@@ -1291,6 +1277,7 @@ int getFilteredEdgesOnCoordinator(
     auto docs = TRI_LookupObjectJson(shardResult.get(), "edges");
 
     if (!TRI_IsArrayJson(docs)) {
+      cc->drop("", coordTransactionID, 0, "");
       return TRI_ERROR_INTERNAL;
     }
 
@@ -1328,6 +1315,80 @@ int getFilteredEdgesOnCoordinator(
   return TRI_ERROR_NO_ERROR;
 }
 
+int getFilteredEdgesOnCoordinator(
+    std::string const& dbname, std::string const& collname,
+    std::string const& vertex, TRI_edge_direction_e const& direction,
+    std::vector<traverser::TraverserExpression*> const& expressions,
+    arangodb::rest::HttpResponse::HttpResponseCode& responseCode,
+    std::string& contentType, arangodb::basics::Json& result) {
+  std::string queryParameters = "?vertex=" + StringUtils::urlEncode(vertex);
+  if (direction == TRI_EDGE_IN) {
+    queryParameters += "&direction=in";
+  } else if (direction == TRI_EDGE_OUT) {
+    queryParameters += "&direction=out";
+  }
+  auto reqBodyString = std::make_shared<std::string>();
+  if (!expressions.empty()) {
+    arangodb::basics::Json body(Json::Array, expressions.size());
+    for (auto& e : expressions) {
+      arangodb::basics::Json tmp(Json::Object);
+      e->toJson(tmp, TRI_UNKNOWN_MEM_ZONE);
+      body.add(tmp.steal());
+    }
+    reqBodyString->append(body.toString());
+  }
+
+  responseCode = arangodb::rest::HttpResponse::OK;
+  contentType = "application/json; charset=utf-8";
+
+  return fetchEdgesFromShards(dbname, collname,
+                              arangodb::rest::HttpRequest::HTTP_REQUEST_PUT,
+                              queryParameters, reqBodyString, result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get a filtered set of edges for a list of vertices on Coordinator
+////////////////////////////////////////////////////////////////////////////////
+
+int getFilteredEdgesOfVerticesOnCoordinator(
+    std::string const& dbname, std::string const& collname,
+    std::vector<std::string> const& vertices,
+    TRI_edge_direction_e const& direction,
+    std::vector<traverser::TraverserExpression*> const& expressions,
+    arangodb::basics::Json& result) {
+  std::string queryParameters;
+  if (direction == TRI_EDGE_IN) {
+    queryParameters = "?direction=in";
+  } else if (direction == TRI_EDGE_OUT) {
+    queryParameters = "?direction=out";
+  } else {
+    queryParameters = "?direction=any";
+  }
+
+  // Edges of a vertex can be located in any shard, so every shard gets
+  // the full list of vertices
+  arangodb::basics::Json body(Json::Object, 2);
+  arangodb::basics::Json list(Json::Array, vertices.size());
+  for (auto const& v : vertices) {
+    list.add(arangodb::basics::Json(v));
+  }
+  body("vertices", list);
+  if (!expressions.empty()) {
+    arangodb::basics::Json filter(Json::Array, expressions.size());
+    for (auto& e : expressions) {
+      arangodb::basics::Json tmp(Json::Object);
+      e->toJson(tmp, TRI_UNKNOWN_MEM_ZONE);
+      filter.add(tmp.steal());
+    }
+    body("filter", filter);
+  }
+  auto reqBodyString = std::make_shared<std::string>(body.toString());
+
+  return fetchEdgesFromShards(dbname, collname,
+                              arangodb::rest::HttpRequest::HTTP_REQUEST_POST,
+                              queryParameters, reqBodyString, result);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief modify a document in a coordinator
 ////////////////////////////////////////////////////////////////////////////////
@@ -192,6 +192,19 @@ int getFilteredEdgesOnCoordinator(
     arangodb::rest::HttpResponse::HttpResponseCode& responseCode,
     std::string& contentType, arangodb::basics::Json& resultJson);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get a filtered set of edges for a list of vertices on Coordinator.
+///        Sends one request per shard, all shards are asked in parallel.
+///        The result has the same format as getFilteredEdgesOnCoordinator
+////////////////////////////////////////////////////////////////////////////////
+
+int getFilteredEdgesOfVerticesOnCoordinator(
+    std::string const& dbname, std::string const& collname,
+    std::vector<std::string> const& vertices,
+    TRI_edge_direction_e const& direction,
+    std::vector<traverser::TraverserExpression*> const& expressions,
+    arangodb::basics::Json& resultJson);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief modify a document in a coordinator
 ////////////////////////////////////////////////////////////////////////////////
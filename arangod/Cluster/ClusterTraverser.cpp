@@ -27,6 +27,9 @@
 using ClusterTraversalPath = arangodb::traverser::ClusterTraversalPath;
 using ClusterTraverser = arangodb::traverser::ClusterTraverser;
 
+size_t const ClusterTraverser::UnfilteredDepth =
+    std::numeric_limits<size_t>::max();
+
 arangodb::basics::Json* ClusterTraversalPath::pathToJson(
     arangodb::Transaction*, arangodb::CollectionNameResolver*) {
   auto result =
@@ -120,34 +123,18 @@ void ClusterTraverser::EdgeGetter::operator()(std::string const& startVertex,
   size_t depth = result.size();
   if (last == nullptr) {
     TRI_ASSERT(_traverser->_iteratorCache.size() == result.size());
-    // We have to request the next level
-    arangodb::basics::Json resultEdges(arangodb::basics::Json::Object);
-    arangodb::rest::HttpResponse::HttpResponseCode responseCode;
-    std::string contentType;
-    std::vector<TraverserExpression*> expEdges;
-    auto found = _traverser->_expressions->find(depth);
-    if (found != _traverser->_expressions->end()) {
-      expEdges = found->second;
+    auto key = std::make_pair(_traverser->edgeDepthKey(depth), eColIdx);
+    auto& adjacency = _traverser->_adjacency[key];
+    auto edges = adjacency.find(startVertex);
+    if (edges == adjacency.end()) {
+      // Fetch the edges of this vertex together with the other vertices
+      // of this depth
+      _traverser->fetchLevel(startVertex, depth);
+      edges = adjacency.find(startVertex);
+      TRI_ASSERT(edges != adjacency.end());
     }
 
-    int res = getFilteredEdgesOnCoordinator(
-        _traverser->_dbname, collName, startVertex, dir,
-        expEdges, responseCode, contentType, resultEdges);
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION(res);
-    }
-    arangodb::basics::Json edgesJson = resultEdges.get("edges");
-
-    arangodb::basics::Json statsJson = resultEdges.get("stats");
-    size_t read = arangodb::basics::JsonHelper::getNumericValue<size_t>(
-        statsJson.json(), "scannedIndex", 0);
-    size_t filter = arangodb::basics::JsonHelper::getNumericValue<size_t>(
-        statsJson.json(), "filtered", 0);
-    _traverser->_readDocuments += read;
-    _traverser->_filteredPaths += filter;
-
-    size_t count = edgesJson.size();
-    if (count == 0) {
+    if (edges->second.empty()) {
       last = nullptr;
       eColIdx++;
       operator()(startVertex, result, last, eColIdx, unused);
@@ -155,53 +142,18 @@ void ClusterTraverser::EdgeGetter::operator()(std::string const& startVertex,
     }
     std::stack<std::string> stack;
     std::unordered_set<std::string> verticesToFetch;
-    for (size_t i = 0; i < edgesJson.size(); ++i) {
-      arangodb::basics::Json edge = edgesJson.at(i);
-      std::string edgeId =
-          arangodb::basics::JsonHelper::getStringValue(edge.json(), "_id", "");
+    for (auto const& edgeId : edges->second) {
       stack.push(edgeId);
-      std::string fromId = arangodb::basics::JsonHelper::getStringValue(
-          edge.json(), "_from", "");
-      if (_traverser->_vertices.find(fromId) == _traverser->_vertices.end()) {
-        verticesToFetch.emplace(fromId);
-      }
-      std::string toId =
-          arangodb::basics::JsonHelper::getStringValue(edge.json(), "_to", "");
-      if (_traverser->_vertices.find(toId) == _traverser->_vertices.end()) {
-        verticesToFetch.emplace(toId);
-      }
-      std::unique_ptr<TRI_json_t> copy(edge.copy().steal());
-      if (copy != nullptr) {
-        if (_traverser->_edges.emplace(edgeId, copy.get()).second) {
-          // if insertion was successful, hand over the ownership
-          copy.release();
-        }
-        // else we have a duplicate and we need to free the copy again
-      }
-    }
-
-    std::vector<TraverserExpression*> expVertices;
-    found = _traverser->_expressions->find(depth + 1);
-    if (found != _traverser->_expressions->end()) {
-      expVertices = found->second;
-    }
-
-    std::unique_ptr<std::map<std::string, std::string>> headers(
-        new std::map<std::string, std::string>());
-    _traverser->_readDocuments += verticesToFetch.size();
-    res = getFilteredDocumentsOnCoordinator(_traverser->_dbname, expVertices,
-                                            headers, verticesToFetch,
-                                            _traverser->_vertices);
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION(res);
-    }
-    // By convention verticesToFetch now contains all _ids of vertices that
-    // could not be found.
-    // Store them as NULL
-    for (auto const& it : verticesToFetch) {
-      _traverser->_vertices.emplace(it,
-                                    TRI_CreateNullJson(TRI_UNKNOWN_MEM_ZONE));
+      TRI_json_t const* edge = _traverser->_edges.find(edgeId)->second;
+      verticesToFetch.emplace(
+          arangodb::basics::JsonHelper::getStringValue(edge, "_from", ""));
+      verticesToFetch.emplace(
+          arangodb::basics::JsonHelper::getStringValue(edge, "_to", ""));
     }
+    // Usually all of them have been fetched with their level already.
+    // Vertices checked only with the filter of another depth are fetched
+    // again with the filter of this depth.
+    _traverser->fetchVertices(verticesToFetch, depth + 1);
     std::string next = stack.top();
     stack.pop();
     last = &_continueConst;
@@ -247,6 +199,7 @@ void ClusterTraverser::setStartVertex(arangodb::traverser::VertexId const& v) {
       new arangodb::basics::PathEnumerator<std::string, std::string, size_t>(
           _edgeGetter, _vertexGetter, id));
   _done = false;
+  _frontier.clear();
   auto it = _vertices.find(id);
   if (it == _vertices.end()) {
     arangodb::rest::HttpResponse::HttpResponseCode responseCode;
@@ -284,10 +237,19 @@ void ClusterTraverser::setStartVertex(arangodb::traverser::VertexId const& v) {
 bool ClusterTraverser::vertexMatchesCondition(
     TRI_json_t* v,
     std::vector<arangodb::traverser::TraverserExpression*> const& exp) {
+  if (!vertexMatches(v, exp)) {
+    ++_filteredPaths;
+    return false;
+  }
+  return true;
+}
+
+bool ClusterTraverser::vertexMatches(
+    TRI_json_t* v,
+    std::vector<arangodb::traverser::TraverserExpression*> const& exp) {
   for (auto const& e : exp) {
     if (!e->isEdgeAccess) {
       if (v == nullptr || !e->matchesCheck(v)) {
-        ++_filteredPaths;
         return false;
       }
     }
@@ -295,6 +257,211 @@ bool ClusterTraverser::vertexMatchesCondition(
   return true;
 }
 
+size_t ClusterTraverser::vertexDepthKey(size_t depth) const {
+  auto found = _expressions->find(depth);
+  if (found != _expressions->end()) {
+    for (auto const& e : found->second) {
+      if (!e->isEdgeAccess) {
+        return depth;
+      }
+    }
+  }
+  return UnfilteredDepth;
+}
+
+size_t ClusterTraverser::edgeDepthKey(size_t depth) const {
+  auto found = _expressions->find(depth);
+  if (found != _expressions->end()) {
+    for (auto const& e : found->second) {
+      if (e->isEdgeAccess) {
+        return depth;
+      }
+    }
+  }
+  return UnfilteredDepth;
+}
+
+void ClusterTraverser::fetchEdges(std::vector<std::string> const& vertices,
+                                  size_t depth, size_t eColIdx,
+                                  std::unordered_set<std::string>& reached) {
+  std::string collName;
+  TRI_edge_direction_e dir;
+  if (!_opts.getCollection(eColIdx, collName, dir)) {
+    return;
+  }
+  std::vector<TraverserExpression*> expEdges;
+  auto found = _expressions->find(depth);
+  if (found != _expressions->end()) {
+    expEdges = found->second;
+  }
+
+  arangodb::basics::Json resultEdges(arangodb::basics::Json::Object);
+  int res = getFilteredEdgesOfVerticesOnCoordinator(
+      _dbname, collName, vertices, dir, expEdges, resultEdges);
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+  arangodb::basics::Json edgesJson = resultEdges.get("edges");
+
+  arangodb::basics::Json statsJson = resultEdges.get("stats");
+  _readDocuments += arangodb::basics::JsonHelper::getNumericValue<size_t>(
+      statsJson.json(), "scannedIndex", 0);
+  _filteredPaths += arangodb::basics::JsonHelper::getNumericValue<size_t>(
+      statsJson.json(), "filtered", 0);
+
+  auto& adjacency = _adjacency[std::make_pair(edgeDepthKey(depth), eColIdx)];
+  for (auto const& v : vertices) {
+    // Also vertices without edges are known now
+    adjacency[v];
+  }
+
+  // With direction any an edge between two requested vertices is returned
+  // for both of them, it has to be assigned only once
+  std::unordered_set<std::string> seen;
+  for (size_t i = 0; i < edgesJson.size(); ++i) {
+    arangodb::basics::Json edge = edgesJson.at(i);
+    std::string edgeId =
+        arangodb::basics::JsonHelper::getStringValue(edge.json(), "_id", "");
+    if (!seen.emplace(edgeId).second) {
+      continue;
+    }
+    std::string fromId =
+        arangodb::basics::JsonHelper::getStringValue(edge.json(), "_from", "");
+    std::string toId =
+        arangodb::basics::JsonHelper::getStringValue(edge.json(), "_to", "");
+    if (dir != TRI_EDGE_IN) {
+      auto it = adjacency.find(fromId);
+      if (it != adjacency.end()) {
+        it->second.emplace_back(edgeId);
+        reached.emplace(toId);
+      }
+    }
+    if (dir != TRI_EDGE_OUT && toId != fromId) {
+      auto it = adjacency.find(toId);
+      if (it != adjacency.end()) {
+        it->second.emplace_back(edgeId);
+        reached.emplace(fromId);
+      }
+    }
+    std::unique_ptr<TRI_json_t> copy(edge.copy().steal());
+    if (copy != nullptr) {
+      if (_edges.emplace(edgeId, copy.get()).second) {
+        // if insertion was successful, hand over the ownership
+        copy.release();
+      }
+      // else we have a duplicate and we need to free the copy again
+    }
+  }
+}
+
+void ClusterTraverser::fetchVertices(std::unordered_set<std::string>& ids,
+                                     size_t depth) {
+  // Vertices that have been returned once can be checked here for any
+  // depth. Vertices that have been rejected by a filter are only known to
+  // be rejected by the filter of that depth.
+  auto& checked = _checkedVertices[vertexDepthKey(depth)];
+  std::unordered_set<std::string> verticesToFetch;
+  for (auto const& it : ids) {
+    if (_vertices.find(it) == _vertices.end() &&
+        checked.find(it) == checked.end()) {
+      verticesToFetch.emplace(it);
+    }
+  }
+  if (verticesToFetch.empty()) {
+    return;
+  }
+  checked.insert(verticesToFetch.begin(), verticesToFetch.end());
+
+  std::vector<TraverserExpression*> expVertices;
+  auto found = _expressions->find(depth);
+  if (found != _expressions->end()) {
+    expVertices = found->second;
+  }
+
+  std::unique_ptr<std::map<std::string, std::string>> headers(
+      new std::map<std::string, std::string>());
+  _readDocuments += verticesToFetch.size();
+  int res = getFilteredDocumentsOnCoordinator(_dbname, expVertices, headers,
+                                              verticesToFetch, _vertices);
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+  // By convention verticesToFetch now contains all _ids of vertices that
+  // could not be found.
+  // Store them as NULL
+  for (auto const& it : verticesToFetch) {
+    _vertices.emplace(it, TRI_CreateNullJson(TRI_UNKNOWN_MEM_ZONE));
+  }
+}
+
+void ClusterTraverser::fetchLevel(std::string const& vertex, size_t depth) {
+  // The vertex itself and up to MaxBatchSize - 1 other vertices
+  // reached at this depth
+  std::vector<std::string> batch({vertex});
+  if (depth < _frontier.size()) {
+    auto& pending = _frontier[depth];
+    pending.erase(vertex);
+    auto it = pending.begin();
+    while (it != pending.end() && batch.size() < MaxBatchSize) {
+      batch.emplace_back(*it);
+      it = pending.erase(it);
+    }
+  }
+
+  std::unordered_set<std::string> reached;
+  std::string collName;
+  TRI_edge_direction_e dir;
+  size_t const key = edgeDepthKey(depth);
+  for (size_t eColIdx = 0; _opts.getCollection(eColIdx, collName, dir);
+       ++eColIdx) {
+    auto const& adjacency = _adjacency[std::make_pair(key, eColIdx)];
+    std::vector<std::string> request;
+    for (auto const& v : batch) {
+      auto it = adjacency.find(v);
+      if (it == adjacency.end()) {
+        request.emplace_back(v);
+        continue;
+      }
+      for (auto const& edgeId : it->second) {
+        TRI_json_t const* edge = _edges.find(edgeId)->second;
+        std::string other =
+            arangodb::basics::JsonHelper::getStringValue(edge, "_from", "");
+        if (other == v) {
+          other = arangodb::basics::JsonHelper::getStringValue(edge, "_to", "");
+        }
+        reached.emplace(other);
+      }
+    }
+    if (!request.empty()) {
+      fetchEdges(request, depth, eColIdx, reached);
+    }
+  }
+
+  // All vertices of the next depth are fetched in one go
+  fetchVertices(reached, depth + 1);
+
+  if (depth + 1 >= _opts.maxDepth) {
+    // The enumeration does not continue with these vertices
+    return;
+  }
+
+  if (_frontier.size() <= depth + 1) {
+    _frontier.resize(depth + 2);
+  }
+  auto& next = _frontier[depth + 1];
+  auto exp = _expressions->find(depth + 1);
+  for (auto const& v : reached) {
+    if (exp != _expressions->end()) {
+      // Same check as in VertexGetter, paths ending here are not continued
+      auto it = _vertices.find(v);
+      if (it == _vertices.end() || !vertexMatches(it->second, exp->second)) {
+        continue;
+      }
+    }
+    next.emplace(v);
+  }
+}
+
 arangodb::traverser::TraversalPath* ClusterTraverser::next() {
   TRI_ASSERT(!_done);
   if (_pruneNext) {
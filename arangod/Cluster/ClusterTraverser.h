@@ -66,9 +66,55 @@ class ClusterTraverser : public Traverser {
   arangodb::basics::Json* vertexToJson(std::string const&) const;
 
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief depth key used for edges fetched without an edge filter,
+  ///        these can be shared by all depths
+  //////////////////////////////////////////////////////////////////////////////
+
+  static size_t const UnfilteredDepth;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief maximal number of vertices of one depth whose edges are fetched
+  ///        together
+  //////////////////////////////////////////////////////////////////////////////
+
+  static size_t const MaxBatchSize = 1000;
+
   bool vertexMatchesCondition(TRI_json_t*,
                               std::vector<TraverserExpression*> const&);
 
+  static bool vertexMatches(TRI_json_t*,
+                            std::vector<TraverserExpression*> const&);
+
+  size_t vertexDepthKey(size_t) const;
+
+  size_t edgeDepthKey(size_t) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fetch the edges of all given vertices at the given depth with one
+  ///        request per shard. Collects the connected vertices in the set.
+  //////////////////////////////////////////////////////////////////////////////
+
+  void fetchEdges(std::vector<std::string> const&, size_t, size_t,
+                  std::unordered_set<std::string>&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fetch all given vertices that are neither cached nor checked
+  ///        with the vertex filter of the given depth yet
+  //////////////////////////////////////////////////////////////////////////////
+
+  void fetchVertices(std::unordered_set<std::string>&, size_t);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fetch the edges of the given vertex together with the other
+  ///        vertices reached at the same depth, and the connected vertices.
+  ///        Called when the enumeration first needs the edges of a vertex,
+  ///        so that it does not have to ask the DBservers for every single
+  ///        vertex
+  //////////////////////////////////////////////////////////////////////////////
+
+  void fetchLevel(std::string const&, size_t);
+
   class VertexGetter {
    public:
     explicit VertexGetter(ClusterTraverser* traverser)
@@ -99,6 +145,29 @@ class ClusterTraverser : public Traverser {
 
   std::unordered_map<std::string, TRI_json_t*> _vertices;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the ids of the edges of each vertex, by depth key and
+  ///        edge collection index
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::map<std::pair<size_t, size_t>,
+           std::unordered_map<std::string, std::vector<std::string>>>
+      _adjacency;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the ids of the vertices looked up with the vertex filter of a
+  ///        depth key. Vertices rejected by the filter are not in _vertices
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unordered_map<size_t, std::unordered_set<std::string>> _checkedVertices;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the vertices reached from the current start vertex whose edges
+  ///        have not been fetched yet, by depth
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<std::unordered_set<std::string>> _frontier;
+
   std::stack<std::stack<std::string>> _iteratorCache;
 
   std::vector<std::string> _edgeCols;
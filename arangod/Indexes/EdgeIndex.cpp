@@ -583,6 +583,20 @@ void EdgeIndex::lookup(arangodb::Transaction* trx,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief looks up all edges of multiple vertices in one direction at once
+////////////////////////////////////////////////////////////////////////////////
+
+void EdgeIndex::lookup(arangodb::Transaction* trx,
+                       TRI_edge_direction_e direction,
+                       std::vector<TRI_edge_header_t const*> const& vertices,
+                       std::vector<std::vector<TRI_doc_mptr_t*>>& result) const {
+  TRI_ASSERT(direction == TRI_EDGE_OUT || direction == TRI_EDGE_IN);
+
+  (direction == TRI_EDGE_OUT ? _edgesFrom : _edgesTo)
+      ->lookupByKeys(trx, vertices, result);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief provides a size hint for the edge index
 ////////////////////////////////////////////////////////////////////////////////
@@ -697,6 +711,87 @@ arangodb::aql::AstNode* EdgeIndex::specializeCondition(
   return matcher.specializeOne(this, node, reference);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief looks up the edges for many _from or _to values at once
+////////////////////////////////////////////////////////////////////////////////
+
+int EdgeIndex::batchLookup(
+    arangodb::Transaction* trx, IndexIteratorContext* context,
+    arangodb::aql::AstNode const* attrNode,
+    std::vector<arangodb::aql::AstNode const*> const& valNodes,
+    std::vector<std::vector<TRI_doc_mptr_t*>>& result) const {
+  TRI_ASSERT(attrNode->type == aql::NODE_TYPE_ATTRIBUTE_ACCESS);
+
+  // _from or _to?
+  bool const isFrom =
+      (strcmp(attrNode->getStringValue(), TRI_VOC_ATTRIBUTE_FROM) == 0);
+
+  size_t const n = valNodes.size();
+  result.clear();
+  result.resize(n);
+
+  // only look up the valid keys, but remember where their results go
+  std::vector<TRI_edge_header_t> keys;
+  std::vector<size_t> positions;
+  keys.reserve(n);
+  positions.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    TRI_edge_header_t key(0, nullptr);
+
+    if (extractKey(context, valNodes[i], key)) {
+      keys.emplace_back(key);
+      positions.emplace_back(i);
+    }
+  }
+
+  // keys does not change size anymore, so pointers into it are stable
+  std::vector<TRI_edge_header_t const*> lookupKeys;
+  lookupKeys.reserve(keys.size());
+  for (auto const& it : keys) {
+    lookupKeys.emplace_back(&it);
+  }
+
+  std::vector<std::vector<TRI_doc_mptr_t*>> found;
+  (isFrom ? _edgesFrom : _edgesTo)->lookupByKeys(trx, lookupKeys, found);
+  TRI_ASSERT(found.size() == keys.size());
+
+  for (size_t i = 0; i < found.size(); ++i) {
+    result[positions[i]] = std::move(found[i]);
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the edge header from a lookup value
+////////////////////////////////////////////////////////////////////////////////
+
+bool EdgeIndex::extractKey(IndexIteratorContext* context,
+                           arangodb::aql::AstNode const* valNode,
+                           TRI_edge_header_t& result) const {
+  if (!valNode->isStringValue()) {
+    return false;
+  }
+  if (valNode->getStringLength() == 0) {
+    return false;
+  }
+
+  TRI_voc_cid_t cid;
+  char const* key;
+  int res = context->resolveId(valNode->getStringValue(), cid, key);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return false;
+  }
+
+  TRI_ASSERT(key != nullptr);
+  TRI_ASSERT(cid != 0);
+
+  result = TRI_edge_header_t(cid, const_cast<char*>(key));
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create the iterator
 ////////////////////////////////////////////////////////////////////////////////
@@ -711,27 +806,13 @@ IndexIterator* EdgeIndex::createIterator(
   keys.reserve(n);
 
   for (size_t i = 0; i < n; ++i) {
-    auto valNode = valNodes[i];
+    TRI_edge_header_t key(0, nullptr);
 
-    if (!valNode->isStringValue()) {
+    if (!extractKey(context, valNodes[i], key)) {
       continue;
     }
-    if (valNode->getStringLength() == 0) {
-      continue;
-    }
-
-    TRI_voc_cid_t cid;
-    char const* key;
-    int res = context->resolveId(valNode->getStringValue(), cid, key);
-
-    if (res != TRI_ERROR_NO_ERROR) {
-      continue;
-    }
-
-    TRI_ASSERT(key != nullptr);
-    TRI_ASSERT(cid != 0);
 
-    keys.emplace_back(TRI_edge_header_t(cid, const_cast<char*>(key)));
+    keys.emplace_back(key);
     TRI_IF_FAILURE("EdgeIndex::collectKeys") {
       THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
     }
@@ -123,6 +123,15 @@ class EdgeIndex final : public Index {
   void lookup(arangodb::Transaction*, TRI_edge_index_iterator_t const*,
               std::vector<TRI_doc_mptr_copy_t>&, TRI_doc_mptr_t*&, size_t);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief looks up all edges of multiple vertices in one direction at once.
+  /// the result contains one vector of edges per vertex
+  //////////////////////////////////////////////////////////////////////////////
+
+  void lookup(arangodb::Transaction*, TRI_edge_direction_e,
+              std::vector<TRI_edge_header_t const*> const&,
+              std::vector<std::vector<TRI_doc_mptr_t*>>&) const;
+
   int batchInsert(arangodb::Transaction*,
                   std::vector<TRI_doc_mptr_t const*> const*,
                   size_t) override final;
@@ -149,7 +158,22 @@ class EdgeIndex final : public Index {
   arangodb::aql::AstNode* specializeCondition(
       arangodb::aql::AstNode*, arangodb::aql::Variable const*) const override;
 
+  bool hasBatchLookup() const override final { return true; }
+
+  int batchLookup(arangodb::Transaction*, IndexIteratorContext*,
+                  arangodb::aql::AstNode const*,
+                  std::vector<arangodb::aql::AstNode const*> const&,
+                  std::vector<std::vector<TRI_doc_mptr_t*>>&) const override;
+
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief extract the edge header from a lookup value. returns false if
+  /// the value cannot match any edge
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool extractKey(IndexIteratorContext*, arangodb::aql::AstNode const*,
+                  TRI_edge_header_t&) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief create the iterator
   //////////////////////////////////////////////////////////////////////////////
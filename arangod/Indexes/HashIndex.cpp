@@ -110,6 +110,16 @@ static bool IsEqualKeyElementHash(
 }
 
 TRI_doc_mptr_t* HashIndexIterator::next() {
+  TRI_index_element_t* element = nextElement();
+
+  if (element == nullptr) {
+    return nullptr;
+  }
+
+  return element->document();
+}
+
+TRI_index_element_t* HashIndexIterator::nextElement() {
   while (true) {
     if (_posInBuffer >= _buffer.size()) {
       if (_position >= _keys.size()) {
@@ -238,8 +248,11 @@ void TRI_hash_index_search_value_t::destroy() {
 HashIndex::HashIndex(
     TRI_idx_iid_t iid, TRI_document_collection_t* collection,
     std::vector<std::vector<arangodb::basics::AttributeName>> const& fields,
+    std::vector<std::vector<arangodb::basics::AttributeName>> const&
+        storedValues,
     bool unique, bool sparse)
-    : PathBasedIndex(iid, collection, fields, unique, sparse, false),
+    : PathBasedIndex(iid, collection, fields, storedValues, unique, sparse,
+                     false),
       _uniqueArray(nullptr) {
   uint32_t indexBuckets = 1;
 
@@ -446,6 +459,44 @@ int HashIndex::lookup(arangodb::Transaction* trx,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief locates the index elements in the hash index given shaped json
+/// objects
+////////////////////////////////////////////////////////////////////////////////
+
+int HashIndex::lookup(arangodb::Transaction* trx,
+                      TRI_hash_index_search_value_t* searchValue,
+                      std::vector<TRI_index_element_t*>& elements) const {
+  if (_unique) {
+    TRI_index_element_t* found =
+        _uniqueArray->_hashArray->findByKey(trx, searchValue);
+
+    if (found != nullptr) {
+      // unique hash index: maximum number is 1
+      elements.emplace_back(found);
+    }
+
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  std::vector<TRI_index_element_t*>* results = nullptr;
+  try {
+    results = _multiArray->_hashArray->lookupByKey(trx, searchValue);
+  } catch (...) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+  if (results != nullptr) {
+    try {
+      elements.insert(elements.end(), results->begin(), results->end());
+      delete results;
+    } catch (...) {
+      delete results;
+      return TRI_ERROR_OUT_OF_MEMORY;
+    }
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief locates entries in the hash index given shaped json objects
 ////////////////////////////////////////////////////////////////////////////////
@@ -925,6 +976,91 @@ IndexIterator* HashIndex::iteratorForCondition(
   return new HashIndexIterator(trx, this, searchValues);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief looks up the documents for many values of the (single) indexed
+/// attribute at once
+////////////////////////////////////////////////////////////////////////////////
+
+int HashIndex::batchLookup(
+    arangodb::Transaction* trx, IndexIteratorContext*,
+    arangodb::aql::AstNode const*,
+    std::vector<arangodb::aql::AstNode const*> const& valNodes,
+    std::vector<std::vector<TRI_doc_mptr_t*>>& result) const {
+  TRI_ASSERT(hasBatchLookup());
+
+  size_t const n = valNodes.size();
+  result.clear();
+  result.resize(n);
+
+  // only look up values that exist as shapes, but remember where their
+  // results go
+  std::vector<std::unique_ptr<TRI_hash_index_search_value_t>> searchValues;
+  std::vector<TRI_hash_index_search_value_t const*> keys;
+  std::vector<size_t> positions;
+  searchValues.reserve(n);
+  keys.reserve(n);
+  positions.reserve(n);
+
+  auto shaper = _collection->getShaper();
+
+  for (size_t i = 0; i < n; ++i) {
+    std::shared_ptr<VPackBuilder> valBuilder =
+        valNodes[i]->toVelocyPackValue();
+
+    if (valBuilder == nullptr) {
+      continue;
+    }
+
+    auto shaped = TRI_ShapedJsonVelocyPack(shaper, valBuilder->slice(), false);
+
+    if (shaped == nullptr) {
+      // no such shape exists. this means we won't find this value
+      continue;
+    }
+
+    auto searchValue = std::make_unique<TRI_hash_index_search_value_t>();
+    searchValue->reserve(1);
+    searchValue->_values[0] = *shaped;
+    TRI_Free(shaper->memoryZone(), shaped);
+
+    keys.emplace_back(searchValue.get());
+    positions.emplace_back(i);
+    searchValues.emplace_back(std::move(searchValue));
+  }
+
+  try {
+    if (_unique) {
+      std::vector<TRI_index_element_t*> found;
+      _uniqueArray->_hashArray->findByKeys(trx, keys, found);
+      TRI_ASSERT(found.size() == keys.size());
+
+      for (size_t i = 0; i < found.size(); ++i) {
+        if (found[i] != nullptr) {
+          // unique hash index: maximum number is 1
+          result[positions[i]].emplace_back(found[i]->document());
+        }
+      }
+    } else {
+      std::vector<std::vector<TRI_index_element_t*>> found;
+      _multiArray->_hashArray->lookupByKeys(trx, keys, found);
+      TRI_ASSERT(found.size() == keys.size());
+
+      for (size_t i = 0; i < found.size(); ++i) {
+        auto& documents = result[positions[i]];
+        documents.reserve(found[i].size());
+
+        for (auto const& it : found[i]) {
+          documents.emplace_back(it->document());
+        }
+      }
+    }
+  } catch (...) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief specializes the condition for use with the index
 ////////////////////////////////////////////////////////////////////////////////
@@ -78,6 +78,10 @@ class HashIndexIterator final : public IndexIterator {
 
   TRI_doc_mptr_t* next() override;
 
+  bool hasElements() const override { return true; }
+
+  TRI_index_element_t* nextElement() override;
+
   void reset() override;
 
  private:
@@ -85,7 +89,7 @@ class HashIndexIterator final : public IndexIterator {
   HashIndex const* _index;
   std::vector<TRI_hash_index_search_value_t*> _keys;
   size_t _position;
-  std::vector<TRI_doc_mptr_t*> _buffer;
+  std::vector<TRI_index_element_t*> _buffer;
   size_t _posInBuffer;
 };
 
@@ -94,6 +98,7 @@ class HashIndex final : public PathBasedIndex {
   HashIndex() = delete;
 
   HashIndex(TRI_idx_iid_t, struct TRI_document_collection_t*,
+            std::vector<std::vector<arangodb::basics::AttributeName>> const&,
             std::vector<std::vector<arangodb::basics::AttributeName>> const&,
             bool, bool);
 
@@ -143,6 +148,14 @@ class HashIndex final : public PathBasedIndex {
   int lookup(arangodb::Transaction*, TRI_hash_index_search_value_t*,
              std::vector<TRI_doc_mptr_t*>&) const;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief locates the index elements in the hash index given shaped json
+  /// objects
+  //////////////////////////////////////////////////////////////////////////////
+
+  int lookup(arangodb::Transaction*, TRI_hash_index_search_value_t*,
+             std::vector<TRI_index_element_t*>&) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief locates entries in the hash index given shaped json objects
   //////////////////////////////////////////////////////////////////////////////
@@ -165,6 +178,15 @@ class HashIndex final : public PathBasedIndex {
   arangodb::aql::AstNode* specializeCondition(
       arangodb::aql::AstNode*, arangodb::aql::Variable const*) const override;
 
+  bool hasBatchLookup() const override final {
+    return _fields.size() == 1 && !isAttributeExpanded(0);
+  }
+
+  int batchLookup(arangodb::Transaction*, IndexIteratorContext*,
+                  arangodb::aql::AstNode const*,
+                  std::vector<arangodb::aql::AstNode const*> const&,
+                  std::vector<std::vector<TRI_doc_mptr_t*>>&) const override;
+
  private:
   int insertUnique(arangodb::Transaction*, struct TRI_doc_mptr_t const*, bool);
 
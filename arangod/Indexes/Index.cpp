@@ -44,6 +44,7 @@ Index::Index(
     : _iid(iid),
       _collection(collection),
       _fields(fields),
+      _storedValues(),
       _unique(unique),
       _sparse(sparse),
       _selectivityEstimate(0.0) {
@@ -62,6 +63,7 @@ Index::Index(VPackSlice const& slice)
                                                                      "id"))),
       _collection(nullptr),
       _fields(),
+      _storedValues(),
       _unique(arangodb::basics::VelocyPackHelper::getBooleanValue(
           slice, "unique", false)),
       _sparse(arangodb::basics::VelocyPackHelper::getBooleanValue(
@@ -88,6 +90,21 @@ Index::Index(VPackSlice const& slice)
     _fields.emplace_back(parsedAttributes);
   }
 
+  VPackSlice const storedValues = slice.get("storedValues");
+
+  if (storedValues.isArray()) {
+    for (auto const& name : VPackArrayIterator(storedValues)) {
+      if (!name.isString()) {
+        THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                       "invalid index description");
+      }
+
+      std::vector<arangodb::basics::AttributeName> parsedAttributes;
+      TRI_ParseAttributeString(name.copyString(), parsedAttributes);
+      _storedValues.emplace_back(parsedAttributes);
+    }
+  }
+
   _selectivityEstimate =
       arangodb::basics::VelocyPackHelper::getNumericValue<double>(
           slice, "selectivityEstimate", 0.0);
@@ -304,6 +321,24 @@ bool Index::Compare(VPackSlice const& lhs, VPackSlice const& rhs) {
     }
   }
 
+  if (type == IndexType::TRI_IDX_TYPE_HASH_INDEX ||
+      type == IndexType::TRI_IDX_TYPE_SKIPLIST_INDEX) {
+    // storedValues must be identical. a missing attribute is the same as
+    // an empty array
+    VPackSlice const l = lhs.get("storedValues");
+    VPackSlice const r = rhs.get("storedValues");
+    bool const lEmpty = (!l.isArray() || l.length() == 0);
+    bool const rEmpty = (!r.isArray() || r.length() == 0);
+
+    if (lEmpty != rEmpty) {
+      return false;
+    }
+    if (!lEmpty &&
+        arangodb::basics::VelocyPackHelper::compare(l, r, false) != 0) {
+      return false;
+    }
+  }
+
   // other index types: fields must be identical if present
   value = lhs.get("fields");
 
@@ -402,6 +437,17 @@ void Index::toVelocyPack(VPackBuilder& builder, bool withFigures) const {
     }
   }
 
+  if (!_storedValues.empty()) {
+    builder.add(VPackValue("storedValues"));
+    VPackArrayBuilder b1(&builder);
+
+    for (auto const& field : _storedValues) {
+      std::string fieldString;
+      TRI_AttributeNamesToString(field, fieldString);
+      builder.add(VPackValue(fieldString));
+    }
+  }
+
   if (hasSelectivityEstimate()) {
     builder.add("selectivityEstimate", VPackValue(selectivityEstimate()));
   }
@@ -473,6 +519,21 @@ int Index::cleanup() {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default implementation for needsStatisticsUpdate
+////////////////////////////////////////////////////////////////////////////////
+
+bool Index::needsStatisticsUpdate() const { return false; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default implementation for updateStatistics
+////////////////////////////////////////////////////////////////////////////////
+
+int Index::updateStatistics() {
+  // do nothing
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief default implementation for sizeHint
 ////////////////////////////////////////////////////////////////////////////////
@@ -540,6 +601,25 @@ arangodb::aql::AstNode* Index::specializeCondition(
   return node;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default implementation for hasBatchLookup
+////////////////////////////////////////////////////////////////////////////////
+
+bool Index::hasBatchLookup() const { return false; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default implementation for batchLookup
+////////////////////////////////////////////////////////////////////////////////
+
+int Index::batchLookup(
+    arangodb::Transaction*, IndexIteratorContext*,
+    arangodb::aql::AstNode const*,
+    std::vector<arangodb::aql::AstNode const*> const&,
+    std::vector<std::vector<TRI_doc_mptr_t*>>&) const {
+  // the derived index classes have to implement this if they support it
+  return TRI_ERROR_NOT_IMPLEMENTED;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief perform some base checks for an index condition part
 ////////////////////////////////////////////////////////////////////////////////
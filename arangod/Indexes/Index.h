@@ -179,6 +179,16 @@ class Index {
     return _fields;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the additional attributes whose values are stored in the
+  /// index elements, but that are not indexed
+  //////////////////////////////////////////////////////////////////////////////
+
+  inline std::vector<std::vector<arangodb::basics::AttributeName>> const&
+  storedValues() const {
+    return _storedValues;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief return the index fields names
   //////////////////////////////////////////////////////////////////////////////
@@ -353,6 +363,13 @@ class Index {
   // a garbage collection function for the index
   virtual int cleanup();
 
+  // whether or not the statistics of the index are outdated
+  virtual bool needsStatisticsUpdate() const;
+
+  // rebuilds the statistics used for cost estimation. must be called
+  // while the collection is at least read-locked
+  virtual int updateStatistics();
+
   // give index a hint about the expected size
   virtual int sizeHint(arangodb::Transaction*, size_t);
 
@@ -376,6 +393,17 @@ class Index {
   virtual arangodb::aql::AstNode* specializeCondition(
       arangodb::aql::AstNode*, arangodb::aql::Variable const*) const;
 
+  // whether or not the index can look up many equality values at once
+  virtual bool hasBatchLookup() const;
+
+  // looks up the documents for all values in one go. the values are
+  // compared for equality with the attribute in the given attribute access
+  // node. the result contains one vector of documents per value
+  virtual int batchLookup(arangodb::Transaction*, IndexIteratorContext*,
+                          arangodb::aql::AstNode const*,
+                          std::vector<arangodb::aql::AstNode const*> const&,
+                          std::vector<std::vector<TRI_doc_mptr_t*>>&) const;
+
   bool canUseConditionPart(arangodb::aql::AstNode const* access,
                            arangodb::aql::AstNode const* other,
                            arangodb::aql::AstNode const* op,
@@ -389,6 +417,8 @@ class Index {
 
   std::vector<std::vector<arangodb::basics::AttributeName>> _fields;
 
+  std::vector<std::vector<arangodb::basics::AttributeName>> _storedValues;
+
   bool const _unique;
 
   bool const _sparse;
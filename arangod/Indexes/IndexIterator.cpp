@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "IndexIterator.h"
+#include "Basics/Exceptions.h"
 #include "Basics/StringUtils.h"
 #include "Cluster/ServerState.h"
 #include "Utils/CollectionNameResolver.h"
@@ -93,6 +94,20 @@ IndexIterator::~IndexIterator() {}
 
 TRI_doc_mptr_t* IndexIterator::next() { return nullptr; }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default implementation for hasElements
+////////////////////////////////////////////////////////////////////////////////
+
+bool IndexIterator::hasElements() const { return false; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default implementation for nextElement
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_index_element_t* IndexIterator::nextElement() {
+  THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief default implementation for reset
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,8 @@
 #include "VocBase/document-collection.h"
 #include "VocBase/vocbase.h"
 
+struct TRI_index_element_t;
+
 namespace arangodb {
 class CollectionNameResolver;
 
@@ -69,6 +71,15 @@ class IndexIterator {
 
   virtual TRI_doc_mptr_t* next();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the next index element instead of only its document.
+  /// only iterators of indexes that store their elements support this
+  //////////////////////////////////////////////////////////////////////////////
+
+  virtual bool hasElements() const;
+
+  virtual TRI_index_element_t* nextElement();
+
   virtual void reset();
 };
 }
@@ -49,16 +49,22 @@ arangodb::aql::AstNode const* PathBasedIndex::PermutationState::getValue()
 PathBasedIndex::PathBasedIndex(
     TRI_idx_iid_t iid, TRI_document_collection_t* collection,
     std::vector<std::vector<arangodb::basics::AttributeName>> const& fields,
+    std::vector<std::vector<arangodb::basics::AttributeName>> const&
+        storedValues,
     bool unique, bool sparse, bool allowPartialIndex)
     : Index(iid, collection, fields, unique, sparse),
       _shaper(_collection->getShaper()),
       _paths(fillPidPaths()),
+      _storedPaths(),
       _useExpansion(false),
       _allowPartialIndex(allowPartialIndex) {
   TRI_ASSERT(!fields.empty());
 
   TRI_ASSERT(iid != 0);
 
+  _storedValues = storedValues;
+  _storedPaths = fillStoredPaths();
+
   for (auto const& it : fields) {
     if (TRI_AttributeNamesHaveExpansion(it)) {
       _useExpansion = true;
@@ -76,6 +82,7 @@ PathBasedIndex::PathBasedIndex(VPackSlice const& slice, bool allowPartialIndex)
     : Index(slice),
       _shaper(nullptr),
       _paths(),
+      _storedPaths(),
       _useExpansion(false),
       _allowPartialIndex(allowPartialIndex) {
   TRI_ASSERT(!_fields.empty());
@@ -132,7 +139,8 @@ int PathBasedIndex::fillElement(std::vector<TRI_index_element_t*>& elements,
       char const* ptr =
           document->getShapedJsonPtr();  // ONLY IN INDEX, PROTECTED by RUNTIME
 
-      TRI_index_element_t* element = TRI_index_element_t::allocate(n);
+      TRI_index_element_t* element =
+          TRI_index_element_t::allocate(n + _storedPaths.size());
 
       if (element == nullptr) {
         return TRI_ERROR_OUT_OF_MEMORY;
@@ -150,6 +158,8 @@ int PathBasedIndex::fillElement(std::vector<TRI_index_element_t*>& elements,
         TRI_FillShapedSub(&subObjects[i], &shapes[i], ptr);
       }
 
+      fillStoredValues(element, &shapedJson, ptr);
+
       try {
         TRI_IF_FAILURE("FillElementOOM2") {
           THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
@@ -175,7 +185,8 @@ int PathBasedIndex::fillElement(std::vector<TRI_index_element_t*>& elements,
 
       for (auto& info : toInsert) {
         TRI_ASSERT(info.size() == n);
-        TRI_index_element_t* element = TRI_index_element_t::allocate(n);
+        TRI_index_element_t* element =
+            TRI_index_element_t::allocate(n + _storedPaths.size());
 
         if (element == nullptr) {
           return TRI_ERROR_OUT_OF_MEMORY;
@@ -193,6 +204,8 @@ int PathBasedIndex::fillElement(std::vector<TRI_index_element_t*>& elements,
           TRI_FillShapedSub(&subObjects[j], &info[j], ptr);
         }
 
+        fillStoredValues(element, &shapedJson, ptr);
+
         try {
           TRI_IF_FAILURE("FillElementOOM2") {
             THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
@@ -210,6 +223,34 @@ int PathBasedIndex::fillElement(std::vector<TRI_index_element_t*>& elements,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fill the sub objects for the stored values of an element. missing
+/// attributes are stored as null
+////////////////////////////////////////////////////////////////////////////////
+
+void PathBasedIndex::fillStoredValues(TRI_index_element_t* element,
+                                      TRI_shaped_json_t const* documentShape,
+                                      char const* ptr) {
+  size_t const n = _paths.size();
+  TRI_shaped_sub_t* subObjects = element->subObjects();
+
+  for (size_t i = 0; i < _storedPaths.size(); ++i) {
+    TRI_shaped_json_t shapedJson;
+    TRI_shape_t const* shape = nullptr;
+
+    bool check = _shaper->extractShapedJson(documentShape, 0, _storedPaths[i],
+                                            &shapedJson, &shape);
+
+    if (!check || shape == nullptr) {
+      shapedJson._sid = BasicShapes::TRI_SHAPE_SID_NULL;
+      shapedJson._data.data = nullptr;
+      shapedJson._data.length = 0;
+    }
+
+    TRI_FillShapedSub(&subObjects[n + i], &shapedJson, ptr);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief helper function to create the sole index value insert
 ////////////////////////////////////////////////////////////////////////////////
@@ -447,3 +488,24 @@ PathBasedIndex::fillPidPaths() {
 
   return result;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief helper function to transform the stored values into pids
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<TRI_shape_pid_t> PathBasedIndex::fillStoredPaths() {
+  TRI_ASSERT(_shaper != nullptr);
+
+  std::vector<TRI_shape_pid_t> result;
+
+  for (auto const& list : _storedValues) {
+    // stored values cannot be expanded
+    TRI_ASSERT(!TRI_AttributeNamesHaveExpansion(list));
+
+    std::string name;
+    TRI_AttributeNamesToString(list, name, true);
+    result.emplace_back(_shaper->findOrCreateAttributePathByName(name.c_str()));
+  }
+
+  return result;
+}
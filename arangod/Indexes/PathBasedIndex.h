@@ -67,6 +67,7 @@ class PathBasedIndex : public Index {
   PathBasedIndex(
       TRI_idx_iid_t, struct TRI_document_collection_t*,
       std::vector<std::vector<arangodb::basics::AttributeName>> const&,
+      std::vector<std::vector<arangodb::basics::AttributeName>> const&,
       bool unique, bool sparse, bool allowPartialIndex);
 
   PathBasedIndex(VPackSlice const&, bool);
@@ -94,9 +95,17 @@ class PathBasedIndex : public Index {
   //////////////////////////////////////////////////////////////////////////////
 
   inline size_t elementSize() const {
-    return TRI_index_element_t::memoryUsage(_paths.size());
+    return TRI_index_element_t::memoryUsage(_paths.size() +
+                                            _storedPaths.size());
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the number of sub objects for stored values in each
+  /// element. they follow the sub objects of the indexed attributes
+  //////////////////////////////////////////////////////////////////////////////
+
+  inline size_t numStoredValues() const { return _storedPaths.size(); }
+
  protected:
   //////////////////////////////////////////////////////////////////////////////
   /// @brief helper function to insert a document into any index type
@@ -119,6 +128,19 @@ class PathBasedIndex : public Index {
 
   std::vector<std::vector<std::pair<TRI_shape_pid_t, bool>>> fillPidPaths();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief helper function to transform the stored values into pids
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<TRI_shape_pid_t> fillStoredPaths();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief fill the sub objects for the stored values of an element
+  //////////////////////////////////////////////////////////////////////////////
+
+  void fillStoredValues(TRI_index_element_t*, TRI_shaped_json_t const*,
+                        char const*);
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief helper function to create a set of index combinations to insert
   //////////////////////////////////////////////////////////////////////////////
@@ -148,6 +170,12 @@ class PathBasedIndex : public Index {
 
   std::vector<std::vector<std::pair<TRI_shape_pid_t, bool>>> const _paths;
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the attribute paths of the stored values
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<TRI_shape_pid_t> _storedPaths;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief whether or not at least one attribute is expanded
   //////////////////////////////////////////////////////////////////////////////
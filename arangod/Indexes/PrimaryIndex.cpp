@@ -200,6 +200,34 @@ TRI_doc_mptr_t* PrimaryIndex::lookupSequential(
   return _primaryIndex->findSequential(trx, position, total);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of buckets of the index
+////////////////////////////////////////////////////////////////////////////////
+
+size_t PrimaryIndex::numberBuckets() const {
+  return _primaryIndex->numberBuckets();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of slots of a bucket
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t PrimaryIndex::bucketSize(size_t bucketId) const {
+  return _primaryIndex->bucketSize(bucketId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a method to iterate over the elements in the slots [position, end)
+///        of a bucket.
+///        Returns nullptr if all elements of the range have been returned.
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_doc_mptr_t* PrimaryIndex::lookupSequentialInRange(
+    arangodb::Transaction* trx, size_t bucketId, uint64_t& position,
+    uint64_t end) const {
+  return _primaryIndex->findSequentialInRange(trx, bucketId, position, end);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief a method to iterate over all elements in the index in
 ///        reversed sequential order.
@@ -360,62 +388,121 @@ arangodb::aql::AstNode* PrimaryIndex::specializeCondition(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief create the iterator
+/// @brief looks up the documents for many _key or _id values at once
 ////////////////////////////////////////////////////////////////////////////////
 
-IndexIterator* PrimaryIndex::createIterator(
+int PrimaryIndex::batchLookup(
     arangodb::Transaction* trx, IndexIteratorContext* context,
     arangodb::aql::AstNode const* attrNode,
-    std::vector<arangodb::aql::AstNode const*> const& valNodes) const {
+    std::vector<arangodb::aql::AstNode const*> const& valNodes,
+    std::vector<std::vector<TRI_doc_mptr_t*>>& result) const {
+  TRI_ASSERT(attrNode->type == aql::NODE_TYPE_ATTRIBUTE_ACCESS);
+
   // _key or _id?
   bool const isId =
       (strcmp(attrNode->getStringValue(), TRI_VOC_ATTRIBUTE_ID) == 0);
 
-  // only leave the valid elements in the vector
   size_t const n = valNodes.size();
+  result.clear();
+  result.resize(n);
+
+  // only look up the valid keys, but remember where their results go
   std::vector<char const*> keys;
+  std::vector<size_t> positions;
   keys.reserve(n);
+  positions.reserve(n);
 
   for (size_t i = 0; i < n; ++i) {
-    auto valNode = valNodes[i];
+    char const* key;
 
-    if (!valNode->isStringValue()) {
-      continue;
+    if (extractKey(context, isId, valNodes[i], key)) {
+      keys.emplace_back(key);
+      positions.emplace_back(i);
     }
-    if (valNode->getStringLength() == 0) {
-      continue;
+  }
+
+  std::vector<TRI_doc_mptr_t*> found;
+  _primaryIndex->findByKeys(trx, keys, found);
+  TRI_ASSERT(found.size() == keys.size());
+
+  for (size_t i = 0; i < found.size(); ++i) {
+    if (found[i] != nullptr) {
+      result[positions[i]].emplace_back(found[i]);
     }
+  }
 
-    if (isId) {
-      // lookup by _id. now validate if the lookup is performed for the
-      // correct collection (i.e. _collection)
-      TRI_voc_cid_t cid;
-      char const* key;
-      int res = context->resolveId(valNode->getStringValue(), cid, key);
+  return TRI_ERROR_NO_ERROR;
+}
 
-      if (res != TRI_ERROR_NO_ERROR) {
-        continue;
-      }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the document key from a lookup value
+////////////////////////////////////////////////////////////////////////////////
 
-      TRI_ASSERT(cid != 0);
-      TRI_ASSERT(key != nullptr);
+bool PrimaryIndex::extractKey(IndexIteratorContext* context, bool isId,
+                              arangodb::aql::AstNode const* valNode,
+                              char const*& key) const {
+  if (!valNode->isStringValue()) {
+    return false;
+  }
+  if (valNode->getStringLength() == 0) {
+    return false;
+  }
 
-      if (!context->isCluster() && cid != _collection->_info.id()) {
-        // only continue lookup if the id value is syntactically correct and
-        // refers to "our" collection, using local collection id
-        continue;
-      }
+  if (!isId) {
+    key = valNode->getStringValue();
+    return true;
+  }
 
-      if (context->isCluster() && cid != _collection->_info.planId()) {
-        // only continue lookup if the id value is syntactically correct and
-        // refers to "our" collection, using cluster collection id
-        continue;
-      }
+  // lookup by _id. now validate if the lookup is performed for the
+  // correct collection (i.e. _collection)
+  TRI_voc_cid_t cid;
+  int res = context->resolveId(valNode->getStringValue(), cid, key);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return false;
+  }
+
+  TRI_ASSERT(cid != 0);
+  TRI_ASSERT(key != nullptr);
+
+  if (!context->isCluster() && cid != _collection->_info.id()) {
+    // only continue lookup if the id value is syntactically correct and
+    // refers to "our" collection, using local collection id
+    return false;
+  }
+
+  if (context->isCluster() && cid != _collection->_info.planId()) {
+    // only continue lookup if the id value is syntactically correct and
+    // refers to "our" collection, using cluster collection id
+    return false;
+  }
+
+  // use _key value from _id
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the iterator
+////////////////////////////////////////////////////////////////////////////////
+
+IndexIterator* PrimaryIndex::createIterator(
+    arangodb::Transaction* trx, IndexIteratorContext* context,
+    arangodb::aql::AstNode const* attrNode,
+    std::vector<arangodb::aql::AstNode const*> const& valNodes) const {
+  // _key or _id?
+  bool const isId =
+      (strcmp(attrNode->getStringValue(), TRI_VOC_ATTRIBUTE_ID) == 0);
+
+  // only leave the valid elements in the vector
+  size_t const n = valNodes.size();
+  std::vector<char const*> keys;
+  keys.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    char const* key;
 
-      // use _key value from _id
-      keys.push_back(key);
-    } else {
-      keys.emplace_back(valNode->getStringValue());
+    if (extractKey(context, isId, valNodes[i], key)) {
+      keys.emplace_back(key);
     }
   }
 
@@ -128,6 +128,28 @@ class PrimaryIndex final : public Index {
                                    arangodb::basics::BucketPosition& position,
                                    uint64_t& total);
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the number of buckets of the index
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t numberBuckets() const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the number of slots of a bucket
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t bucketSize(size_t) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a method to iterate over the elements in the slots [position,
+  ///        end) of a bucket. This allows partitioning the index so that
+  ///        multiple threads can scan it at the same time.
+  ///        Returns nullptr if all elements of the range have been returned.
+  //////////////////////////////////////////////////////////////////////////////
+
+  TRI_doc_mptr_t* lookupSequentialInRange(arangodb::Transaction*, size_t,
+                                          uint64_t&, uint64_t) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief a method to iterate over all elements in the index in
   ///        reversed sequential order.
@@ -173,7 +195,22 @@ class PrimaryIndex final : public Index {
   arangodb::aql::AstNode* specializeCondition(
       arangodb::aql::AstNode*, arangodb::aql::Variable const*) const override;
 
+  bool hasBatchLookup() const override final { return true; }
+
+  int batchLookup(arangodb::Transaction*, IndexIteratorContext*,
+                  arangodb::aql::AstNode const*,
+                  std::vector<arangodb::aql::AstNode const*> const&,
+                  std::vector<std::vector<TRI_doc_mptr_t*>>&) const override;
+
  private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief extract the document key from a lookup value. returns false if
+  /// the value cannot match any document in the index
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool extractKey(IndexIteratorContext*, bool,
+                  arangodb::aql::AstNode const*, char const*&) const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief create the iterator
   //////////////////////////////////////////////////////////////////////////////
@@ -22,13 +22,18 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "SkiplistIndex.h"
+#include "Aql/Ast.h"
 #include "Aql/AstNode.h"
 #include "Aql/SortCondition.h"
 #include "Basics/AttributeNameParser.h"
 #include "Basics/debugging.h"
+#include "Basics/json-utilities.h"
+#include "Basics/MutexLocker.h"
 #include "VocBase/document-collection.h"
 #include "VocBase/VocShaper.h"
 
+#include <cmath>
+
 #include <velocypack/Iterator.h>
 #include <velocypack/velocypack-aliases.h>
 
@@ -206,6 +211,148 @@ static int CompareElementElement(TRI_index_element_t const* left,
       &rightSubobjects[rightPosition], nullptr, shaper);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of buckets of the histogram in the index statistics
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const StatisticsBuckets = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of items the index statistics are computed from. larger
+/// indexes are sampled, as the statistics are built under the collection lock
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const StatisticsSampleSize = 4096;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts the value of an element's index attribute to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_json_t* ElementValueToJson(TRI_index_element_t const* element,
+                                      size_t position, VocShaper* shaper) {
+  TRI_shaped_sub_t const* sub = &element->subObjects()[position];
+
+  TRI_shaped_json_t shaped;
+  shaped._sid = sub->_sid;
+  char const* ptr;
+  size_t length;
+  TRI_InspectShapedSub(sub, element->document(), ptr, length);
+  shaped._data.data = const_cast<char*>(ptr);
+  shaped._data.length = static_cast<uint32_t>(length);
+
+  TRI_json_t* json = TRI_JsonShapedJson(shaper, &shaped);
+
+  if (json == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return json;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroys the statistics
+////////////////////////////////////////////////////////////////////////////////
+
+SkiplistIndexStatistics::~SkiplistIndexStatistics() {
+  for (auto& it : boundaries) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimated fraction of the items with a first attribute value
+/// equal to the value
+////////////////////////////////////////////////////////////////////////////////
+
+double SkiplistIndexStatistics::equalFraction(TRI_json_t const* value) const {
+  size_t const n = buckets();
+
+  if (n == 0 || distinctValues == 0) {
+    return 0.0;
+  }
+
+  if (TRI_CompareValuesJson(value, boundaries.front(), true) < 0 ||
+      TRI_CompareValuesJson(value, boundaries.back(), true) > 0) {
+    // value is outside of the indexed range
+    return 0.0;
+  }
+
+  // a value spanning several boundaries fills the buckets between them
+  size_t equal = 0;
+  for (auto const& it : boundaries) {
+    if (TRI_CompareValuesJson(value, it, true) == 0) {
+      ++equal;
+    }
+  }
+
+  double fraction = 1.0 / static_cast<double>(distinctValues);
+
+  if (equal >= 2) {
+    fraction = (std::max)(
+        fraction, static_cast<double>(equal - 1) / static_cast<double>(n));
+  }
+
+  return (std::min)(fraction, 1.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimated fraction of the items with a first attribute value
+/// less than (or equal to) the value
+////////////////////////////////////////////////////////////////////////////////
+
+double SkiplistIndexStatistics::lessFraction(TRI_json_t const* value,
+                                             bool includeEqual) const {
+  size_t const n = buckets();
+
+  if (n == 0) {
+    return 0.0;
+  }
+
+  // first boundary not less than the value
+  size_t lower = 0;
+  while (lower <= n &&
+         TRI_CompareValuesJson(boundaries[lower], value, true) < 0) {
+    ++lower;
+  }
+
+  if (lower > n) {
+    // all values are less than the value
+    return 1.0;
+  }
+
+  double fraction;
+
+  if (TRI_CompareValuesJson(boundaries[lower], value, true) == 0) {
+    // the value is a boundary itself
+    fraction = static_cast<double>(lower) / static_cast<double>(n);
+  } else if (lower == 0) {
+    // all values are greater than the value
+    return 0.0;
+  } else {
+    // the value is inside bucket lower - 1. interpolate numbers, and assume
+    // the middle of the bucket for everything else
+    TRI_json_t const* low = boundaries[lower - 1];
+    TRI_json_t const* high = boundaries[lower];
+    double position = 0.5;
+
+    if (TRI_IsNumberJson(low) && TRI_IsNumberJson(high) &&
+        TRI_IsNumberJson(value) &&
+        high->_value._number > low->_value._number) {
+      position = (value->_value._number - low->_value._number) /
+                 (high->_value._number - low->_value._number);
+    }
+
+    fraction = (static_cast<double>(lower - 1) + position) /
+               static_cast<double>(n);
+  }
+
+  if (includeEqual) {
+    fraction += equalFraction(value);
+  }
+
+  return (std::min)(fraction, 1.0);
+}
+
 static int FillLookupOperator(TRI_index_operator_t* slOperator,
                               TRI_document_collection_t* document) {
   if (slOperator == nullptr) {
@@ -690,6 +837,16 @@ TRI_index_element_t* SkiplistIterator::nextIteration() {
 }
 
 TRI_doc_mptr_t* SkiplistIndexIterator::next() {
+  TRI_index_element_t* element = nextElement();
+
+  if (element == nullptr) {
+    return nullptr;
+  }
+
+  return element->document();
+}
+
+TRI_index_element_t* SkiplistIndexIterator::nextElement() {
   while (_iterator == nullptr) {
     if (_currentOperator == _operators.size()) {
       // Sorry nothing found at all
@@ -716,7 +873,7 @@ TRI_doc_mptr_t* SkiplistIndexIterator::next() {
     _iterator = _index->lookup(_trx, _operators[_currentOperator], _reverse);
     res = _iterator->next();
   }
-  return res->document();
+  return res;
 }
 
 void SkiplistIndexIterator::reset() {
@@ -732,11 +889,17 @@ void SkiplistIndexIterator::reset() {
 SkiplistIndex::SkiplistIndex(
     TRI_idx_iid_t iid, TRI_document_collection_t* collection,
     std::vector<std::vector<arangodb::basics::AttributeName>> const& fields,
+    std::vector<std::vector<arangodb::basics::AttributeName>> const&
+        storedValues,
     bool unique, bool sparse)
-    : PathBasedIndex(iid, collection, fields, unique, sparse, true),
+    : PathBasedIndex(iid, collection, fields, storedValues, unique, sparse,
+                     true),
       CmpElmElm(this),
       CmpKeyElm(this),
-      _skiplistIndex(nullptr) {
+      _skiplistIndex(nullptr),
+      _modifications(0),
+      _statisticsLock(),
+      _statistics() {
   _skiplistIndex =
       new TRI_Skiplist(CmpElmElm, CmpKeyElm, FreeElm, unique, _useExpansion);
 }
@@ -750,7 +913,10 @@ SkiplistIndex::SkiplistIndex(VPackSlice const& slice)
     : PathBasedIndex(slice, true),
       CmpElmElm(this),
       CmpKeyElm(this),
-      _skiplistIndex(nullptr) {}
+      _skiplistIndex(nullptr),
+      _modifications(0),
+      _statisticsLock(),
+      _statistics() {}
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the skiplist index
@@ -782,6 +948,16 @@ void SkiplistIndex::toVelocyPackFigures(VPackBuilder& builder) const {
   TRI_ASSERT(builder.isOpenObject());
   builder.add("memory", VPackValue(memory()));
   _skiplistIndex->appendToVelocyPack(builder);
+
+  auto statistics = this->statistics();
+
+  if (statistics != nullptr) {
+    builder.add("statistics", VPackValue(VPackValueType::Object));
+    builder.add("items", VPackValue(statistics->items));
+    builder.add("distinctValues", VPackValue(statistics->distinctValues));
+    builder.add("buckets", VPackValue(statistics->buckets()));
+    builder.close();
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -830,6 +1006,11 @@ int SkiplistIndex::insert(arangodb::Transaction*, TRI_doc_mptr_t const* doc,
       break;
     }
   }
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    ++_modifications;
+  }
+
   return res;
 }
 
@@ -869,9 +1050,156 @@ int SkiplistIndex::remove(arangodb::Transaction*, TRI_doc_mptr_t const* doc,
     TRI_index_element_t::freeElement(elements[i]);
   }
 
+  ++_modifications;
+
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the statistics are outdated. they are rebuilt when
+/// at least a tenth of the items were inserted or removed since
+////////////////////////////////////////////////////////////////////////////////
+
+bool SkiplistIndex::needsStatisticsUpdate() const {
+  if (_skiplistIndex == nullptr) {
+    // coordinator stub
+    return false;
+  }
+
+  uint64_t const modifications = _modifications.load();
+
+  if (modifications == 0) {
+    return false;
+  }
+
+  auto statistics = this->statistics();
+
+  return (statistics == nullptr ||
+          modifications >= static_cast<uint64_t>(statistics->items / 10));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief rebuilds the statistics from a sample of the skiplist. the sample
+/// consists of the nodes of the lowest level with at most about
+/// StatisticsSampleSize nodes, plus the first and the last node, so that the
+/// histogram covers the whole value range. the number of distinct values is
+/// extrapolated from the sample with the GEE estimator
+////////////////////////////////////////////////////////////////////////////////
+
+int SkiplistIndex::updateStatistics() {
+  if (_skiplistIndex == nullptr) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  try {
+    uint64_t const modifications = _modifications.load();
+    auto statistics = std::make_shared<SkiplistIndexStatistics>();
+    size_t const n = static_cast<size_t>(_skiplistIndex->getNrUsed());
+
+    if (n > 0) {
+      auto shaper = _collection->getShaper();
+
+      int level = 0;
+      while (level + 1 < _skiplistIndex->height() &&
+             (n >> level) > StatisticsSampleSize) {
+        ++level;
+      }
+
+      auto first = _skiplistIndex->nextNode(_skiplistIndex->startNode());
+      auto last = _skiplistIndex->prevNode(_skiplistIndex->endNode());
+
+      std::vector<TRI_index_element_t const*> sample;
+      sample.reserve(2 * (n >> level) + 2);
+      sample.emplace_back(first->document());
+
+      auto node = _skiplistIndex->nextNode(_skiplistIndex->startNode(), level);
+      while (node != nullptr) {
+        if (node != first) {
+          sample.emplace_back(node->document());
+        }
+        node = _skiplistIndex->nextNode(node, level);
+      }
+
+      if (last != first && sample.back() != last->document()) {
+        sample.emplace_back(last->document());
+      }
+
+      size_t const s = sample.size();
+      size_t const buckets =
+          (std::max)(static_cast<size_t>(1),
+                     (std::min)(StatisticsBuckets, s - 1));
+      statistics->boundaries.reserve(buckets + 1);
+
+      size_t boundary = 0;
+      size_t distinct = 0;
+      size_t singles = 0;
+      size_t run = 0;
+
+      for (size_t rank = 0; rank < s; ++rank) {
+        TRI_index_element_t const* element = sample[rank];
+
+        if (rank == 0 ||
+            CompareElementElement(sample[rank - 1], 0, element, 0, shaper) !=
+                0) {
+          if (run == 1) {
+            ++singles;
+          }
+          ++distinct;
+          run = 0;
+        }
+        ++run;
+
+        // several boundaries fall onto the same rank for small indexes
+        while (boundary <= buckets && boundary * (s - 1) / buckets == rank) {
+          // does not throw, as the boundaries were reserved
+          statistics->boundaries.emplace_back(
+              ElementValueToJson(element, 0, shaper));
+          ++boundary;
+        }
+      }
+
+      if (run == 1) {
+        ++singles;
+      }
+
+      // values seen once in the sample may occur once or many times in the
+      // index, the GEE estimator scales them by sqrt(n / s). this is exact
+      // if the whole index was sampled
+      double const estimate =
+          std::sqrt(static_cast<double>(n) / static_cast<double>(s)) *
+              static_cast<double>(singles) +
+          static_cast<double>(distinct - singles);
+
+      statistics->items = n;
+      statistics->distinctValues = (std::min)(
+          n, (std::max)(distinct, static_cast<size_t>(estimate + 0.5)));
+    }
+
+    {
+      MUTEX_LOCKER(mutexLocker, _statisticsLock);
+      _statistics = statistics;
+    }
+
+    _modifications -= modifications;
+  } catch (arangodb::basics::Exception const& ex) {
+    return ex.code();
+  } catch (...) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the current statistics of the index, may be a nullptr
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<SkiplistIndexStatistics const> SkiplistIndex::statistics()
+    const {
+  MUTEX_LOCKER(mutexLocker, _statisticsLock);
+  return _statistics;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief attempts to locate an entry in the skip list index
 ///
@@ -1131,6 +1459,117 @@ void SkiplistIndex::matchAttributes(
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimates the fraction of the items matched by the conditions on
+/// the first index attribute, using the histogram of the statistics. returns
+/// false if the conditions cannot be estimated this way. for IN lists, the
+/// average fraction per value is returned, as the caller multiplies the
+/// estimate by the number of lookup values
+////////////////////////////////////////////////////////////////////////////////
+
+bool SkiplistIndex::estimateFraction(
+    SkiplistIndexStatistics const* statistics,
+    std::vector<arangodb::aql::AstNode const*> const& nodes,
+    double& fraction) const {
+  double lower = 0.0;
+  double upper = 1.0;
+  double equal = 1.0;
+  bool hasEquality = false;
+
+  auto valueFraction = [&statistics](arangodb::aql::AstNode const* value,
+                                     std::function<double(TRI_json_t const*)>
+                                         estimate) -> double {
+    TRI_json_t* json = value->toJsonValue(TRI_UNKNOWN_MEM_ZONE);
+
+    if (json == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    double result = estimate(json);
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, json);
+    return result;
+  };
+
+  for (auto const& op : nodes) {
+    TRI_ASSERT(op->numMembers() == 2);
+    auto lhs = op->getMember(0);
+    auto rhs = op->getMember(1);
+    auto type = op->type;
+
+    if (type == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_IN) {
+      if (!rhs->isArray() || !rhs->isConstant() || rhs->numMembers() == 0) {
+        return false;
+      }
+
+      double sum = 0.0;
+      for (size_t i = 0; i < rhs->numMembers(); ++i) {
+        sum += valueFraction(rhs->getMember(i), [&statistics](
+                                                    TRI_json_t const* json) {
+          return statistics->equalFraction(json);
+        });
+      }
+      equal = (std::min)(equal, sum / static_cast<double>(rhs->numMembers()));
+      hasEquality = true;
+      continue;
+    }
+
+    arangodb::aql::AstNode const* value;
+
+    if (rhs->isConstant() && !lhs->isConstant()) {
+      // attribute <op> value
+      value = rhs;
+    } else if (lhs->isConstant() && !rhs->isConstant()) {
+      // value <op> attribute
+      value = lhs;
+      type = arangodb::aql::Ast::ReverseOperator(type);
+    } else {
+      return false;
+    }
+
+    switch (type) {
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_EQ:
+        equal = (std::min)(
+            equal, valueFraction(value, [&statistics](TRI_json_t const* json) {
+              return statistics->equalFraction(json);
+            }));
+        hasEquality = true;
+        break;
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GT:
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GE: {
+        bool const includeEqual =
+            (type == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_GT);
+        lower = (std::max)(
+            lower, valueFraction(value, [&statistics, includeEqual](
+                                            TRI_json_t const* json) {
+              return statistics->lessFraction(json, includeEqual);
+            }));
+        break;
+      }
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LT:
+      case arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LE: {
+        bool const includeEqual =
+            (type == arangodb::aql::NODE_TYPE_OPERATOR_BINARY_LE);
+        upper = (std::min)(
+            upper, valueFraction(value, [&statistics, includeEqual](
+                                            TRI_json_t const* json) {
+              return statistics->lessFraction(json, includeEqual);
+            }));
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  if (hasEquality) {
+    fraction = equal;
+  } else {
+    fraction = (std::max)(0.0, upper - lower);
+  }
+
+  return true;
+}
+
 bool SkiplistIndex::supportsFilterCondition(
     arangodb::aql::AstNode const* node,
     arangodb::aql::Variable const* reference, size_t itemsInIndex,
@@ -1139,6 +1578,13 @@ bool SkiplistIndex::supportsFilterCondition(
   size_t values = 0;
   matchAttributes(node, reference, found, values, false);
 
+  // the histogram is only meaningful if each document has a single value
+  // for the first attribute
+  std::shared_ptr<SkiplistIndexStatistics const> statistics;
+  if (!_useExpansion) {
+    statistics = this->statistics();
+  }
+
   bool lastContainsEquality = true;
   size_t attributesCovered = 0;
   size_t attributesCoveredByEquality = 0;
@@ -1170,7 +1616,19 @@ bool SkiplistIndex::supportsFilterCondition(
     }
 
     ++attributesCovered;
-    if (containsEquality) {
+
+    double fraction;
+    if (i == 0 && statistics != nullptr && statistics->buckets() > 0 &&
+        estimateFraction(statistics.get(), nodes, fraction)) {
+      // estimate based on the value distribution of the first attribute.
+      // never estimate less than a single document
+      estimatedCost = (std::max)(estimatedCost * fraction, 1.0);
+
+      if (containsEquality) {
+        ++attributesCoveredByEquality;
+        equalityReductionFactor *= 0.25;
+      }
+    } else if (containsEquality) {
       ++attributesCoveredByEquality;
       estimatedCost /= equalityReductionFactor;
 
@@ -26,6 +26,7 @@
 
 #include "Basics/Common.h"
 #include "Aql/AstNode.h"
+#include "Basics/Mutex.h"
 #include "Basics/SkipList.h"
 #include "Indexes/IndexIterator.h"
 #include "Indexes/PathBasedIndex.h"
@@ -51,6 +52,50 @@ struct Variable;
 class SkiplistIndex;
 class Transaction;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief statistics of a skiplist index, used for estimating the number of
+/// documents a condition matches. contains an equi-depth histogram over the
+/// values of the first index attribute: boundaries[i] is the value at
+/// rank i * (items - 1) / buckets, so values occurring in many documents
+/// show up as runs of equal boundaries. for large indexes, the boundaries
+/// and the number of distinct values are estimated from a sample
+////////////////////////////////////////////////////////////////////////////////
+
+struct SkiplistIndexStatistics {
+  SkiplistIndexStatistics(SkiplistIndexStatistics const&) = delete;
+  SkiplistIndexStatistics& operator=(SkiplistIndexStatistics const&) = delete;
+
+  SkiplistIndexStatistics() : items(0), distinctValues(0), boundaries() {}
+
+  ~SkiplistIndexStatistics();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of histogram buckets
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t buckets() const {
+    return boundaries.empty() ? 0 : boundaries.size() - 1;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief estimated fraction of the items with a first attribute value
+  /// equal to the value
+  //////////////////////////////////////////////////////////////////////////////
+
+  double equalFraction(TRI_json_t const*) const;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief estimated fraction of the items with a first attribute value
+  /// less than (or equal to) the value
+  //////////////////////////////////////////////////////////////////////////////
+
+  double lessFraction(TRI_json_t const*, bool) const;
+
+  size_t items;
+  size_t distinctValues;
+  std::vector<TRI_json_t*> boundaries;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Iterator structure for skip list. We require a start and stop node
 ///
@@ -150,6 +195,10 @@ class SkiplistIndexIterator final : public IndexIterator {
 
   TRI_doc_mptr_t* next() override;
 
+  bool hasElements() const override { return true; }
+
+  TRI_index_element_t* nextElement() override;
+
   void reset() override;
 
  private:
@@ -195,6 +244,7 @@ class SkiplistIndex final : public PathBasedIndex {
 
   SkiplistIndex(
       TRI_idx_iid_t, struct TRI_document_collection_t*,
+      std::vector<std::vector<arangodb::basics::AttributeName>> const&,
       std::vector<std::vector<arangodb::basics::AttributeName>> const&, bool,
       bool);
 
@@ -222,6 +272,16 @@ class SkiplistIndex final : public PathBasedIndex {
   int remove(arangodb::Transaction*, struct TRI_doc_mptr_t const*,
              bool) override final;
 
+  bool needsStatisticsUpdate() const override final;
+
+  int updateStatistics() override final;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the current statistics of the index, may be a nullptr
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::shared_ptr<SkiplistIndexStatistics const> statistics() const;
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief attempts to locate an entry in the skip list index
   ///
@@ -274,6 +334,10 @@ class SkiplistIndex final : public PathBasedIndex {
       std::unordered_map<size_t, std::vector<arangodb::aql::AstNode const*>>&,
       size_t&, bool) const;
 
+  bool estimateFraction(SkiplistIndexStatistics const*,
+                        std::vector<arangodb::aql::AstNode const*> const&,
+                        double&) const;
+
  private:
   ElementElementComparator CmpElmElm;
 
@@ -284,6 +348,20 @@ class SkiplistIndex final : public PathBasedIndex {
   //////////////////////////////////////////////////////////////////////////////
 
   TRI_Skiplist* _skiplistIndex;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of inserts and removals since the statistics were built
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::atomic<uint64_t> _modifications;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief protects the statistics pointer
+  //////////////////////////////////////////////////////////////////////////////
+
+  mutable arangodb::Mutex _statisticsLock;
+
+  std::shared_ptr<SkiplistIndexStatistics const> _statistics;
 };
 }
 
@@ -352,6 +352,9 @@ std::shared_ptr<VPackBuilder> RestCursorHandler::buildExtra(
       }
       queryResult.profile = nullptr;
     }
+    if (queryResult.plan != nullptr) {
+      extra->add("plan", queryResult.plan->slice());
+    }
     if (queryResult.warnings == nullptr) {
       extra->add("warnings", VPackValue(VPackValueType::Array));
       extra->close();
@@ -262,6 +262,8 @@ bool RestEdgesHandler::readEdges(
 /// Internal function to receive all edges for a list of vertices
 /// Not publicly documented on purpose.
 /// NOTE: It ONLY except _id strings. Nothing else
+/// The body is either the array of vertices or an object with the array in
+/// "vertices" and an array of TraverserExpressions for filtering in "filter"
 ////////////////////////////////////////////////////////////////////////////////
 
 bool RestEdgesHandler::readEdgesForMultipleVertices() {
@@ -285,6 +287,30 @@ bool RestEdgesHandler::readEdgesForMultipleVertices() {
   }
   VPackSlice body = parsedBody->slice();
 
+  std::vector<traverser::TraverserExpression*> expressions;
+  arangodb::basics::ScopeGuard guard{[]() -> void {},
+                                     [&expressions]() -> void {
+                                       for (auto& e : expressions) {
+                                         delete e;
+                                       }
+                                     }};
+
+  if (body.isObject()) {
+    VPackSlice filter = body.get("filter");
+    if (filter.isArray()) {
+      expressions.reserve(filter.length());
+      for (auto const& exp : VPackArrayIterator(filter)) {
+        if (exp.isObject()) {
+          auto expression =
+              std::make_unique<traverser::TraverserExpression>(exp);
+          expressions.emplace_back(expression.get());
+          expression.release();
+        }
+      }
+    }
+    body = body.get("vertices");
+  }
+
   if (!body.isArray()) {
     generateError(HttpResponse::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
                   "Expected an array of vertex _id's in body parameter");
@@ -355,7 +381,6 @@ bool RestEdgesHandler::readEdgesForMultipleVertices() {
 
   size_t filtered = 0;
   size_t scannedIndex = 0;
-  std::vector<traverser::TraverserExpression*> const expressions;
 
   arangodb::basics::Json documents(arangodb::basics::Json::Array);
   for (auto const& vertexSlice : VPackArrayIterator(body)) {
@@ -59,6 +59,7 @@ class RestEdgesHandler : public RestVocbaseBaseHandler {
 
   //////////////////////////////////////////////////////////////////////////////
   /// @brief reads all edges in given direction for a given list of vertices
+  ///        Optionally filtered by TraverserExpressions
   //////////////////////////////////////////////////////////////////////////////
 
   bool readEdgesForMultipleVertices();
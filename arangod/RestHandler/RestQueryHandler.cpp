@@ -23,6 +23,7 @@
 
 #include "RestQueryHandler.h"
 
+#include "Aql/PlanCache.h"
 #include "Aql/Query.h"
 #include "Aql/QueryList.h"
 #include "Basics/conversions.h"
@@ -39,6 +40,9 @@
 #include "VocBase/document-collection.h"
 #include "VocBase/vocbase.h"
 
+#include <velocypack/Iterator.h>
+#include <velocypack/velocypack-aliases.h>
+
 using namespace arangodb;
 using namespace arangodb::aql;
 using namespace arangodb::basics;
@@ -147,6 +151,11 @@ bool RestQueryHandler::readQuery(bool slow) {
       result.add("started", VPackValue(timeString));
       result.add("runTime", VPackValue(q.runTime));
       result.add("state", VPackValue(queryState));
+      result.add("peakMemoryUsage", VPackValue(q.peakMemoryUsage));
+      if (q.plan != nullptr) {
+        // only present for slow queries that were profiled
+        result.add("plan", q.plan->slice());
+      }
       result.close();
     }
     result.close();
@@ -167,6 +176,27 @@ bool RestQueryHandler::readQuery(bool slow) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the statistics of the plan cache for the database
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::readPlanCache() {
+  VPackBuilder properties = PlanCache::instance()->properties(_vocbase);
+
+  VPackBuilder result;
+  result.add(VPackValue(VPackValueType::Object));
+  result.add("error", VPackValue(false));
+  result.add("code", VPackValue(HttpResponse::OK));
+  for (auto const& it : VPackObjectIterator(properties.slice())) {
+    result.add(it.key.copyString(), it.value);
+  }
+  result.close();
+  VPackSlice slice = result.slice();
+
+  generateResult(slice);
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns AQL query tracking
 ////////////////////////////////////////////////////////////////////////////////
@@ -188,11 +218,14 @@ bool RestQueryHandler::readQuery() {
     return readQuery(false);
   } else if (name == "properties") {
     return readQueryProperties();
+  } else if (name == "plan-cache") {
+    return readPlanCache();
   }
 
   generateError(HttpResponse::NOT_FOUND, TRI_ERROR_HTTP_NOT_FOUND,
                 "unknown type '" + name +
-                    "', expecting 'slow', 'current', or 'properties'");
+                    "', expecting 'slow', 'current', 'properties' or "
+                    "'plan-cache'");
   return true;
 }
 
@@ -211,6 +244,20 @@ bool RestQueryHandler::deleteQuerySlow() {
   return true;
 }
 
+bool RestQueryHandler::deletePlanCache() {
+  PlanCache::instance()->invalidate(_vocbase);
+
+  VPackBuilder result;
+  result.add(VPackValue(VPackValueType::Object));
+  result.add("error", VPackValue(false));
+  result.add("code", VPackValue(HttpResponse::OK));
+  result.close();
+  VPackSlice slice = result.slice();
+  generateResult(slice);
+
+  return true;
+}
+
 bool RestQueryHandler::deleteQuery(std::string const& name) {
   auto id = StringUtils::uint64(name);
   auto queryList = static_cast<arangodb::aql::QueryList*>(_vocbase->_queries);
@@ -242,7 +289,8 @@ bool RestQueryHandler::deleteQuery() {
 
   if (suffix.size() != 1) {
     generateError(HttpResponse::BAD, TRI_ERROR_HTTP_BAD_PARAMETER,
-                  "expecting DELETE /_api/query/<id> or /_api/query/slow");
+                  "expecting DELETE /_api/query/<id>, /_api/query/slow or "
+                  "/_api/query/plan-cache");
     return true;
   }
 
@@ -250,6 +298,8 @@ bool RestQueryHandler::deleteQuery() {
 
   if (name == "slow") {
     return deleteQuerySlow();
+  } else if (name == "plan-cache") {
+    return deletePlanCache();
   }
   return deleteQuery(name);
 }
@@ -62,12 +62,24 @@ class RestQueryHandler : public RestVocbaseBaseHandler {
 
   bool readQuery();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the statistics of the plan cache
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool readPlanCache();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief removes the slow log
   //////////////////////////////////////////////////////////////////////////////
 
   bool deleteQuerySlow();
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief removes all cached plans of the database
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool deletePlanCache();
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief interrupts a named query
   //////////////////////////////////////////////////////////////////////////////
@@ -39,6 +39,7 @@
 #include "Actions/actions.h"
 #include "ApplicationServer/ApplicationServer.h"
 #include "Aql/Query.h"
+#include "Aql/PlanCache.h"
 #include "Aql/QueryCache.h"
 #include "Aql/RestAqlHandler.h"
 #include "Basics/FileUtils.h"
@@ -395,6 +396,11 @@ ArangoServer::ArangoServer(int argc, char** argv)
       _ignoreDatafileErrors(false),
       _disableReplicationApplier(false),
       _disableQueryTracking(false),
+      _querySortSpillThreshold(0),
+      _queryCollectSpillThreshold(0),
+      _queryMaxParallelism(1),
+      _queryMemoryLimit(0),
+      _queryPlanCacheSize(128),
       _throwCollectionNotLoadedError(false),
       _foxxQueues(true),
       _foxxQueuesPollInterval(1.0),
@@ -1096,6 +1102,21 @@ void ArangoServer::buildApplicationServer() {
       "mode for the AQL query cache (on, off, demand)")(
       "database.query-cache-max-results", &_queryCacheMaxResults,
       "maximum number of results in query cache per database")(
+      "database.query-sort-spill-threshold", &_querySortSpillThreshold,
+      "number of rows an AQL SORT keeps in memory before spilling to "
+      "temporary files (0 = never spill)")(
+      "database.query-collect-spill-threshold", &_queryCollectSpillThreshold,
+      "number of groups an AQL COLLECT keeps in memory before spilling to "
+      "temporary files (0 = never spill)")(
+      "database.query-max-parallelism", &_queryMaxParallelism,
+      "number of threads a single AQL collection scan or traversal may use "
+      "(1 = no parallelism)")(
+      "database.query-memory-limit", &_queryMemoryLimit,
+      "maximum number of bytes a single AQL query may use "
+      "(0 = no limit)")(
+      "database.query-plan-cache-size", &_queryPlanCacheSize,
+      "maximum number of optimized AQL plans cached per database "
+      "(0 = plan cache disabled)")(
       "database.index-threads", &_indexThreads,
       "threads to start for parallel background index creation")(
       "database.throw-collection-not-loaded-error",
@@ -1289,6 +1310,22 @@ void ArangoServer::buildApplicationServer() {
   // set global query tracking flag
   arangodb::aql::Query::DisableQueryTracking(_disableQueryTracking);
 
+  // set global default for spilling AQL sorts to disk
+  arangodb::aql::Query::SortSpillThreshold(_querySortSpillThreshold);
+
+  // set global default for spilling AQL collects to disk
+  arangodb::aql::Query::CollectSpillThreshold(_queryCollectSpillThreshold);
+
+  // set global default for parallel AQL collection scans
+  arangodb::aql::Query::MaxParallelism(_queryMaxParallelism);
+
+  // set global default for the memory limit of AQL queries
+  arangodb::aql::Query::MemoryLimit(_queryMemoryLimit);
+
+  // configure the plan cache
+  arangodb::aql::PlanCache::instance()->maxEntries(
+      static_cast<size_t>(_queryPlanCacheSize));
+
   // configure the query cache
   {
     std::pair<std::string, size_t> cacheProperties{_queryCacheMode,
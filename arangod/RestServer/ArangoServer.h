@@ -382,6 +382,41 @@ class ArangoServer {
 
   bool _disableQueryTracking;
 
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief default number of rows an AQL SORT may keep in memory before
+  /// spilling sorted runs to temporary files (0 = never spill)
+  ////////////////////////////////////////////////////////////////////////////////
+
+  uint64_t _querySortSpillThreshold;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief default number of groups an AQL COLLECT may keep in memory before
+  /// spilling input rows to temporary files (0 = never spill)
+  ////////////////////////////////////////////////////////////////////////////////
+
+  uint64_t _queryCollectSpillThreshold;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief default number of threads a single AQL collection scan or
+  /// traversal may use (1 = no parallelism)
+  ////////////////////////////////////////////////////////////////////////////////
+
+  uint64_t _queryMaxParallelism;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief default maximum number of bytes a single AQL query may use
+  /// (0 = no limit)
+  ////////////////////////////////////////////////////////////////////////////////
+
+  uint64_t _queryMemoryLimit;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief maximum number of optimized AQL plans cached per database
+  /// (0 = plan cache disabled)
+  ////////////////////////////////////////////////////////////////////////////////
+
+  uint64_t _queryPlanCacheSize;
+
   ////////////////////////////////////////////////////////////////////////////////
   /// @brief was docuBlock databaseThrowCollectionNotLoadedError
   ////////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "V8Traverser.h"
+#include "Basics/MutexLocker.h"
 #include "Indexes/EdgeIndex.h"
 #include "Utils/transactions.h"
 #include "Utils/V8ResolverGuard.h"
@@ -373,6 +374,46 @@ void NeighborsOptions::addCollectionRestriction(TRI_voc_cid_t cid) {
   _explicitCollections.emplace(cid);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a weight calculator reading the attribute keyWeight
+////////////////////////////////////////////////////////////////////////////////
+
+AttributeWeightCalculator::AttributeWeightCalculator(
+    std::string const& keyWeight, double defaultWeight, VocShaper* shaper)
+    : _defaultWeight(defaultWeight), _shaper(shaper) {
+  _shapePid = _shaper->lookupAttributePathByName(keyWeight.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Callable weight calculator for edge
+////////////////////////////////////////////////////////////////////////////////
+
+double AttributeWeightCalculator::operator()(TRI_doc_mptr_copy_t const& edge) {
+  if (_shapePid == 0) {
+    return _defaultWeight;
+  }
+
+  TRI_shape_sid_t sid;
+  TRI_EXTRACT_SHAPE_IDENTIFIER_MARKER(sid, edge.getDataPtr());
+  TRI_shape_access_t const* accessor = _shaper->findAccessor(sid, _shapePid);
+  TRI_shaped_json_t shapedJson;
+  TRI_EXTRACT_SHAPED_JSON_MARKER(shapedJson, edge.getDataPtr());
+  TRI_shaped_json_t resultJson;
+  TRI_ExecuteShapeAccessor(accessor, &shapedJson, &resultJson);
+
+  if (resultJson._sid != TRI_SHAPE_NUMBER) {
+    return _defaultWeight;
+  }
+
+  std::unique_ptr<TRI_json_t> json(TRI_JsonShapedJson(_shaper, &resultJson));
+
+  if (json == nullptr) {
+    return _defaultWeight;
+  }
+
+  return json.get()->_value._number;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Wrapper for the shortest path computation
 ////////////////////////////////////////////////////////////////////////////////
@@ -675,6 +716,53 @@ void TRI_RunNeighborsSearch(std::vector<EdgeCollectionInfo*>& collectionInfos,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the transaction collection for reading documents of a
+/// collection, adding the collection to the transaction if it is not yet
+/// part of it
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_transaction_collection_t* ReadCollection(Transaction* trx,
+                                                    TRI_voc_cid_t cid) {
+  auto collection = trx->trxCollection(cid);
+  if (collection == nullptr) {
+    int res = TRI_AddCollectionTransaction(trx->getInternals(), cid,
+                                           TRI_TRANSACTION_READ,
+                                           trx->nestingLevel(), true, true);
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+
+    TRI_EnsureCollectionsTransaction(trx->getInternals());
+    collection = trx->trxCollection(cid);
+
+    if (collection == nullptr) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                     "collection is a nullptr");
+    }
+  }
+  if (collection->_ditch == nullptr) {
+    trx->orderDitch(collection);
+  }
+  return collection;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief same as above, holding the lock if traversals share the
+/// transaction with other threads. all traversers sharing the transaction
+/// must use the same lock, as only they are serialized by it
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_transaction_collection_t* ReadCollection(Transaction* trx,
+                                                    TRI_voc_cid_t cid,
+                                                    arangodb::Mutex* lock) {
+  if (lock == nullptr) {
+    return ReadCollection(trx, cid);
+  }
+  MUTEX_LOCKER(guard, *lock);
+  return ReadCollection(trx, cid);
+}
+
 Json* SingleServerTraversalPath::pathToJson(Transaction* trx,
                                             CollectionNameResolver* resolver) {
   auto path = std::make_unique<Json>(Json::Object, 2);
@@ -718,11 +806,7 @@ Json* SingleServerTraversalPath::lastVertexToJson(
 Json* SingleServerTraversalPath::edgeToJson(Transaction* trx,
                                             CollectionNameResolver* resolver,
                                             EdgeInfo const& e) {
-  auto collection = trx->trxCollection(e.cid);
-
-  if (collection == nullptr) {
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
-  }
+  auto collection = ReadCollection(trx, e.cid, _trxLock);
   TRI_ASSERT(collection != nullptr);
 
   TRI_shaped_json_t shapedJson;
@@ -735,28 +819,7 @@ Json* SingleServerTraversalPath::edgeToJson(Transaction* trx,
 Json* SingleServerTraversalPath::vertexToJson(Transaction* trx,
                                               CollectionNameResolver* resolver,
                                               VertexId const& v) {
-  auto collection = trx->trxCollection(v.cid);
-  if (collection == nullptr) {
-    int res = TRI_AddCollectionTransaction(trx->getInternals(), v.cid,
-                                           TRI_TRANSACTION_READ,
-                                           trx->nestingLevel(), true, true);
-    if (res != TRI_ERROR_NO_ERROR) {
-      THROW_ARANGO_EXCEPTION(res);
-    }
-
-    TRI_EnsureCollectionsTransaction(trx->getInternals());
-    collection = trx->trxCollection(v.cid);
-
-    if (collection == nullptr) {
-      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
-                                     "collection is a nullptr");
-    }
-
-    auto trxCollection = trx->trxCollection(v.cid);
-    if (trxCollection != nullptr) {
-      trx->orderDitch(trxCollection);
-    }
-  }
+  auto collection = ReadCollection(trx, v.cid, _trxLock);
   TRI_doc_mptr_copy_t mptr;
   int res = trx->readSingle(collection, &mptr, v.key);
   ++_readDocuments;
@@ -771,21 +834,49 @@ Json* SingleServerTraversalPath::vertexToJson(Transaction* trx,
                            resolver, v.cid, &mptr));
 }
 
-DepthFirstTraverser::DepthFirstTraverser(
+SingleServerTraverser::SingleServerTraverser(
     std::vector<TRI_document_collection_t*> const& edgeCollections,
     TraverserOptions& opts, CollectionNameResolver* resolver, Transaction* trx,
     std::unordered_map<size_t, std::vector<TraverserExpression*>> const*
         expressions)
     : Traverser(opts, expressions),
       _resolver(resolver),
-      _edgeGetter(this, opts, resolver, trx),
       _edgeCols(edgeCollections),
-      _trx(trx) {
-  _defInternalFunctions();
+      _trx(trx),
+      _trxLock(nullptr) {}
+
+VertexId SingleServerTraverser::otherVertex(EdgeInfo const& edge,
+                                            VertexId const& vertex) {
+  auto mptr = &edge.mptr;
+  if (strcmp(TRI_EXTRACT_MARKER_FROM_KEY(mptr), vertex.key) == 0 &&
+      TRI_EXTRACT_MARKER_FROM_CID(mptr) == vertex.cid) {
+    return VertexId(TRI_EXTRACT_MARKER_TO_CID(mptr),
+                    TRI_EXTRACT_MARKER_TO_KEY(mptr));
+  }
+  return VertexId(TRI_EXTRACT_MARKER_FROM_CID(mptr),
+                  TRI_EXTRACT_MARKER_FROM_KEY(mptr));
 }
 
-bool DepthFirstTraverser::edgeMatchesConditions(TRI_doc_mptr_t& e,
-                                                size_t& eColIdx, size_t depth) {
+EdgeIndex* SingleServerTraverser::getEdgeIndex(std::string const& eColName,
+                                               TRI_voc_cid_t& cid) {
+  auto it = _indexCache.find(eColName);
+  if (it == _indexCache.end()) {
+    cid = _resolver->getCollectionId(eColName);
+    TRI_transaction_collection_t* trxCollection =
+        ReadCollection(_trx, cid, _trxLock);
+    TRI_ASSERT(trxCollection != nullptr);
+    TRI_document_collection_t* ecl = trxCollection->_collection->_collection;
+    arangodb::EdgeIndex* edgeIndex = ecl->edgeIndex();
+    _indexCache.emplace(eColName, std::make_pair(cid, edgeIndex));
+    return edgeIndex;
+  }
+  cid = it->second.first;
+  return it->second.second;
+}
+
+bool SingleServerTraverser::edgeMatchesConditions(TRI_doc_mptr_t& e,
+                                                  size_t& eColIdx,
+                                                  size_t depth) {
   TRI_ASSERT(_expressions != nullptr);
 
   auto it = _expressions->find(depth);
@@ -804,8 +895,8 @@ bool DepthFirstTraverser::edgeMatchesConditions(TRI_doc_mptr_t& e,
   return true;
 }
 
-bool DepthFirstTraverser::vertexMatchesConditions(VertexId const& v,
-                                                  size_t depth) {
+bool SingleServerTraverser::vertexMatchesConditions(VertexId const& v,
+                                                    size_t depth) {
   TRI_ASSERT(_expressions != nullptr);
 
   auto it = _expressions->find(depth);
@@ -820,26 +911,7 @@ bool DepthFirstTraverser::vertexMatchesConditions(VertexId const& v,
       if (!exp->isEdgeAccess) {
         if (fetchVertex) {
           fetchVertex = false;
-          auto collection = _trx->trxCollection(v.cid);
-          if (collection == nullptr) {
-            int res = TRI_AddCollectionTransaction(
-                _trx->getInternals(), v.cid, TRI_TRANSACTION_READ,
-                _trx->nestingLevel(), true, true);
-            if (res != TRI_ERROR_NO_ERROR) {
-              THROW_ARANGO_EXCEPTION(res);
-            }
-            TRI_EnsureCollectionsTransaction(_trx->getInternals());
-            collection = _trx->trxCollection(v.cid);
-
-            if (collection == nullptr) {
-              THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
-                                             "collection is a nullptr");
-            }
-            auto trxCollection = _trx->trxCollection(v.cid);
-            if (trxCollection != nullptr) {
-              _trx->orderDitch(trxCollection);
-            }
-          }
+          auto collection = ReadCollection(_trx, v.cid, _trxLock);
 
           int res = _trx->readSingle(collection, &mptr, v.key);
           ++_readDocuments;
@@ -876,24 +948,7 @@ bool DepthFirstTraverser::vertexMatchesConditions(VertexId const& v,
   return true;
 }
 
-void DepthFirstTraverser::_defInternalFunctions() {
-  _getVertex = [](EdgeInfo const& edge, VertexId const& vertex, size_t depth,
-                  VertexId& result) -> bool {
-    auto mptr = edge.mptr;
-    if (strcmp(TRI_EXTRACT_MARKER_FROM_KEY(&mptr), vertex.key) == 0 &&
-        TRI_EXTRACT_MARKER_FROM_CID(&mptr) == vertex.cid) {
-      result = VertexId(TRI_EXTRACT_MARKER_TO_CID(&mptr),
-                        TRI_EXTRACT_MARKER_TO_KEY(&mptr));
-    } else {
-      result = VertexId(TRI_EXTRACT_MARKER_FROM_CID(&mptr),
-                        TRI_EXTRACT_MARKER_FROM_KEY(&mptr));
-    }
-    return true;
-  };
-}
-
-void DepthFirstTraverser::setStartVertex(
-    arangodb::traverser::VertexId const& v) {
+bool SingleServerTraverser::startVertexMatchesConditions(VertexId const& v) {
   TRI_ASSERT(_expressions != nullptr);
 
   auto it = _expressions->find(0);
@@ -909,46 +964,53 @@ void DepthFirstTraverser::setStartVertex(
         if (!exp->isEdgeAccess) {
           if (fetchVertex) {
             fetchVertex = false;
-            auto collection = _trx->trxCollection(v.cid);
-            if (collection == nullptr) {
-              int res = TRI_AddCollectionTransaction(
-                  _trx->getInternals(), v.cid, TRI_TRANSACTION_READ,
-                  _trx->nestingLevel(), true, true);
-              if (res != TRI_ERROR_NO_ERROR) {
-                THROW_ARANGO_EXCEPTION(res);
-              }
-              TRI_EnsureCollectionsTransaction(_trx->getInternals());
-              collection = _trx->trxCollection(v.cid);
-
-              if (collection == nullptr) {
-                THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
-                                               "collection is a nullptr");
-              }
-              auto trxCollection = _trx->trxCollection(v.cid);
-              if (trxCollection != nullptr) {
-                _trx->orderDitch(trxCollection);
-              }
-            }
+            auto collection = ReadCollection(_trx, v.cid, _trxLock);
 
             int res = _trx->readSingle(collection, &mptr, v.key);
             ++_readDocuments;
             if (res != TRI_ERROR_NO_ERROR) {
               // Vertex does not exist
-              _done = true;
-              return;
+              return false;
             }
             docCol = collection->_collection->_collection;
           }
           TRI_ASSERT(docCol != nullptr);
           if (!exp->matchesCheck(mptr, docCol, _resolver)) {
             ++_filteredPaths;
-            _done = true;
-            return;
+            return false;
           }
         }
       }
     }
   }
+  return true;
+}
+
+DepthFirstTraverser::DepthFirstTraverser(
+    std::vector<TRI_document_collection_t*> const& edgeCollections,
+    TraverserOptions& opts, CollectionNameResolver* resolver, Transaction* trx,
+    std::unordered_map<size_t, std::vector<TraverserExpression*>> const*
+        expressions)
+    : SingleServerTraverser(edgeCollections, opts, resolver, trx, expressions),
+      _edgeGetter(this, opts, trx) {
+  _defInternalFunctions();
+}
+
+void DepthFirstTraverser::_defInternalFunctions() {
+  _getVertex = [](EdgeInfo const& edge, VertexId const& vertex, size_t depth,
+                  VertexId& result) -> bool {
+    result = otherVertex(edge, vertex);
+    return true;
+  };
+}
+
+void DepthFirstTraverser::setStartVertex(
+    arangodb::traverser::VertexId const& v) {
+  if (!startVertexMatchesConditions(v)) {
+    _done = true;
+    return;
+  }
+  _startVertex = v;
   _enumerator.reset(new PathEnumerator<EdgeInfo, VertexId, TRI_doc_mptr_t>(
       _edgeGetter, _getVertex, v));
   _done = false;
@@ -969,7 +1031,7 @@ TraversalPath* DepthFirstTraverser::next() {
     return nullptr;
   }
 
-  auto p = std::make_unique<SingleServerTraversalPath>(path);
+  auto p = std::make_unique<SingleServerTraversalPath>(path, _trxLock);
   if (countEdges >= _opts.maxDepth) {
     _pruneNext = true;
   }
@@ -979,23 +1041,6 @@ TraversalPath* DepthFirstTraverser::next() {
   return p.release();
 }
 
-EdgeIndex* DepthFirstTraverser::EdgeGetter::getEdgeIndex(
-    std::string const& eColName,
-    TRI_voc_cid_t& cid) {
-  auto it = _indexCache.find(eColName);
-  if (it == _indexCache.end()) {
-    cid = _resolver->getCollectionId(eColName);
-    TRI_transaction_collection_t* trxCollection = _trx->trxCollection(cid);
-    TRI_ASSERT(trxCollection != nullptr);
-    TRI_document_collection_t* ecl = trxCollection->_collection->_collection;
-    arangodb::EdgeIndex* edgeIndex = ecl->edgeIndex();
-    _indexCache.emplace(eColName, std::make_pair(cid, edgeIndex));
-    return edgeIndex;
-  }
-  cid = it->second.first;
-  return it->second.second;
-}
-
 void DepthFirstTraverser::EdgeGetter::operator()(VertexId const& startVertex,
                                                  std::vector<EdgeInfo>& edges,
                                                  TRI_doc_mptr_t*& last,
@@ -1008,7 +1053,7 @@ void DepthFirstTraverser::EdgeGetter::operator()(VertexId const& startVertex,
       return;
     }
     TRI_voc_cid_t cid;
-    arangodb::EdgeIndex* edgeIndex = getEdgeIndex(eColName, cid);
+    arangodb::EdgeIndex* edgeIndex = _traverser->getEdgeIndex(eColName, cid);
     std::vector<TRI_doc_mptr_copy_t> tmp;
     if (direction == TRI_EDGE_ANY) {
       TRI_edge_direction_e currentDir = dir ? TRI_EDGE_OUT : TRI_EDGE_IN;
@@ -1047,19 +1092,252 @@ void DepthFirstTraverser::EdgeGetter::operator()(VertexId const& startVertex,
       continue;
     }
     EdgeInfo e(cid, tmp.back());
-    VertexId other;
-    // This always returns true and third parameter is ignored
-    _traverser->_getVertex(e, startVertex, 0, other);
-    if (!_traverser->vertexMatchesConditions(other, edges.size() + 1)) {
-      // Retry with the next element
+    if (_opts.uniqueEdges == TraverserOptions::PATH) {
+      auto search = std::find(edges.begin(), edges.end(), e);
+      if (search != edges.end()) {
+        // The edge is included twice. Go on with the next
+        continue;
+      }
+    }
+    VertexId other = otherVertex(e, startVertex);
+    if (_opts.uniqueVertices == TraverserOptions::PATH &&
+        isOnPath(other, edges)) {
+      // The vertex is included twice. Go on with the next
       continue;
     }
-    auto search = std::find(edges.begin(), edges.end(), e);
-    if (search != edges.end()) {
-      // The edge is included twice. Go on with the next
+    if (!_traverser->vertexMatchesConditions(other, edges.size() + 1)) {
+      // Retry with the next element
       continue;
     }
     edges.push_back(e);
     return;
   }
 }
+
+bool DepthFirstTraverser::EdgeGetter::isOnPath(
+    VertexId const& vertex, std::vector<EdgeInfo> const& edges) const {
+  VertexId current = _traverser->_startVertex;
+  if (current == vertex) {
+    return true;
+  }
+  for (auto const& e : edges) {
+    current = otherVertex(e, current);
+    if (current == vertex) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+BreadthFirstTraverser::BreadthFirstTraverser(
+    std::vector<TRI_document_collection_t*> const& edgeCollections,
+    TraverserOptions& opts, CollectionNameResolver* resolver, Transaction* trx,
+    std::unordered_map<size_t, std::vector<TraverserExpression*>> const*
+        expressions)
+    : SingleServerTraverser(edgeCollections, opts, resolver, trx, expressions),
+      _levelStart(0),
+      _position(0) {}
+
+void BreadthFirstTraverser::setStartVertex(
+    arangodb::traverser::VertexId const& v) {
+  _steps.clear();
+  _visitedVertices.clear();
+  _visitedEdges.clear();
+  _pruneNext = false;
+
+  if (!startVertexMatchesConditions(v)) {
+    _done = true;
+    return;
+  }
+
+  TRI_doc_mptr_copy_t noEdge;
+  _steps.emplace_back(0, 0, v, EdgeInfo(0, noEdge));
+  if (_opts.uniqueVertices == TraverserOptions::GLOBAL) {
+    _visitedVertices.emplace(v);
+  }
+  _levelStart = 0;
+  // the start vertex itself is not a result
+  _position = 1;
+  _done = false;
+}
+
+TraversalPath* BreadthFirstTraverser::next() {
+  TRI_ASSERT(!_done);
+  if (_pruneNext) {
+    _pruneNext = false;
+    TRI_ASSERT(_position > 0);
+    _steps[_position - 1].pruned = true;
+  }
+
+  while (_position == _steps.size() ||
+         _steps[_position].depth < _opts.minDepth) {
+    if (_position == _steps.size() && !expandLevel()) {
+      _done = true;
+      // Done traversing
+      return nullptr;
+    }
+    if (_steps[_position].depth < _opts.minDepth) {
+      ++_position;
+    }
+  }
+
+  EnumeratedPath<EdgeInfo, VertexId> path;
+  size_t current = _position++;
+  while (current != 0) {
+    Step const& step = _steps[current];
+    path.vertices.emplace_back(step.vertex);
+    path.edges.emplace_back(step.edge);
+    current = step.parent;
+  }
+  path.vertices.emplace_back(_steps[0].vertex);
+  std::reverse(path.vertices.begin(), path.vertices.end());
+  std::reverse(path.edges.begin(), path.edges.end());
+
+  return new SingleServerTraversalPath(path, _trxLock);
+}
+
+bool BreadthFirstTraverser::expandLevel() {
+  size_t const levelEnd = _steps.size();
+
+  std::vector<size_t> parents;
+  std::vector<TRI_edge_header_t> vertices;
+
+  for (size_t i = _levelStart; i < levelEnd; ++i) {
+    Step const& step = _steps[i];
+    if (!step.pruned && step.depth < _opts.maxDepth) {
+      parents.emplace_back(i);
+      vertices.emplace_back(step.vertex.cid,
+                            const_cast<char*>(step.vertex.key));
+    }
+  }
+  _levelStart = levelEnd;
+
+  if (parents.empty()) {
+    return false;
+  }
+
+  // vertices does not change size anymore, so pointers into it are stable
+  std::vector<TRI_edge_header_t const*> lookupVertices;
+  lookupVertices.reserve(vertices.size());
+  for (auto const& it : vertices) {
+    lookupVertices.emplace_back(&it);
+  }
+
+  // look up the edges of the whole level once per edge collection and
+  // direction. the results are only evaluated when all lookups are done,
+  // so that the steps extending the same path stay next to each other
+  struct Lookup {
+    size_t eColIdx;
+    TRI_voc_cid_t cid;
+    std::vector<std::vector<TRI_doc_mptr_t*>> edges;
+
+    Lookup(size_t eColIdx, TRI_voc_cid_t cid) : eColIdx(eColIdx), cid(cid) {}
+  };
+
+  std::vector<Lookup> lookups;
+  std::string eColName;
+  TRI_edge_direction_e direction;
+
+  for (size_t eColIdx = 0;
+       _opts.getCollection(eColIdx, eColName, direction); ++eColIdx) {
+    TRI_voc_cid_t cid;
+    arangodb::EdgeIndex* edgeIndex = getEdgeIndex(eColName, cid);
+
+    for (auto const& dir : {TRI_EDGE_OUT, TRI_EDGE_IN}) {
+      if (direction == TRI_EDGE_ANY || direction == dir) {
+        lookups.emplace_back(eColIdx, cid);
+        edgeIndex->lookup(_trx, dir, lookupVertices, lookups.back().edges);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < parents.size(); ++i) {
+    for (auto const& lookup : lookups) {
+      for (auto const& edge : lookup.edges[i]) {
+        addStep(parents[i], lookup.eColIdx, lookup.cid, edge);
+      }
+    }
+  }
+
+  return _steps.size() > levelEnd;
+}
+
+void BreadthFirstTraverser::addStep(size_t parent, size_t eColIdx,
+                                    TRI_voc_cid_t cid, TRI_doc_mptr_t* mptr) {
+  ++_readDocuments;
+
+  // number of edges on the path before the new one
+  size_t const depth = _steps[parent].depth;
+
+  if (!edgeMatchesConditions(*mptr, eColIdx, depth)) {
+    return;
+  }
+
+  TRI_doc_mptr_copy_t copy(*mptr);
+  EdgeInfo edge(cid, copy);
+  EdgeId edgeId(cid, TRI_EXTRACT_MARKER_KEY(mptr));
+
+  if (_opts.uniqueEdges == TraverserOptions::GLOBAL) {
+    if (_visitedEdges.find(edgeId) != _visitedEdges.end()) {
+      return;
+    }
+  } else if (_opts.uniqueEdges == TraverserOptions::PATH &&
+             isEdgeOnPath(parent, edge)) {
+    return;
+  }
+
+  VertexId vertex = otherVertex(edge, _steps[parent].vertex);
+
+  if (_opts.uniqueVertices == TraverserOptions::GLOBAL) {
+    if (_visitedVertices.find(vertex) != _visitedVertices.end()) {
+      return;
+    }
+  } else if (_opts.uniqueVertices == TraverserOptions::PATH &&
+             isVertexOnPath(parent, vertex)) {
+    return;
+  }
+
+  if (!vertexMatchesConditions(vertex, depth + 1)) {
+    return;
+  }
+
+  // only mark vertices and edges of paths that are actually followed. a
+  // vertex filtered at this depth may still be reached on another path
+  if (_opts.uniqueVertices == TraverserOptions::GLOBAL) {
+    _visitedVertices.emplace(vertex);
+  }
+  if (_opts.uniqueEdges == TraverserOptions::GLOBAL) {
+    _visitedEdges.emplace(edgeId);
+  }
+
+  _steps.emplace_back(parent, depth + 1, vertex, edge);
+}
+
+bool BreadthFirstTraverser::isVertexOnPath(size_t parent,
+                                           VertexId const& vertex) const {
+  size_t current = parent;
+  while (true) {
+    Step const& step = _steps[current];
+    if (step.vertex == vertex) {
+      return true;
+    }
+    if (current == 0) {
+      return false;
+    }
+    current = step.parent;
+  }
+}
+
+bool BreadthFirstTraverser::isEdgeOnPath(size_t parent,
+                                         EdgeInfo const& edge) const {
+  size_t current = parent;
+  while (current != 0) {
+    Step const& step = _steps[current];
+    if (step.edge == edge) {
+      return true;
+    }
+    current = step.parent;
+  }
+  return false;
+}
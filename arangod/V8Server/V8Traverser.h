@@ -24,6 +24,7 @@
 #ifndef ARANGOD_V8_SERVER_V8_TRAVERSER_H
 #define ARANGOD_V8_SERVER_V8_TRAVERSER_H 1
 
+#include "Basics/Mutex.h"
 #include "Utils/ExplicitTransaction.h"
 #include "VocBase/edge-collection.h"
 #include "VocBase/ExampleMatcher.h"
@@ -85,6 +86,11 @@ typedef arangodb::basics::ConstDistanceFinder<arangodb::traverser::VertexId,
                                               arangodb::traverser::EdgeId>
     ArangoDBConstDistancePathFinder;
 
+typedef arangodb::basics::KShortestPathsFinder<arangodb::traverser::VertexId,
+                                               arangodb::traverser::EdgeId,
+                                               double>
+    ArangoDBKShortestPathsFinder;
+
 namespace arangodb {
 namespace traverser {
 
@@ -175,9 +181,10 @@ struct ShortestPathOptions : BasicOptions {
 
 class SingleServerTraversalPath : public TraversalPath {
  public:
-  explicit SingleServerTraversalPath(
-      arangodb::basics::EnumeratedPath<EdgeInfo, VertexId> const& path)
-      : _path(path) {}
+  SingleServerTraversalPath(
+      arangodb::basics::EnumeratedPath<EdgeInfo, VertexId> const& path,
+      arangodb::Mutex* trxLock)
+      : _path(path), _trxLock(trxLock) {}
 
   ~SingleServerTraversalPath() {}
 
@@ -200,9 +207,95 @@ class SingleServerTraversalPath : public TraversalPath {
                                        VertexId const& v);
 
   arangodb::basics::EnumeratedPath<EdgeInfo, VertexId> _path;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief lock of the transaction, see SingleServerTraverser
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::Mutex* _trxLock;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief common part of the traversers working on local collections: the
+/// transaction, the edge indexes and the checks of the filter expressions
+////////////////////////////////////////////////////////////////////////////////
+
+class SingleServerTraverser : public Traverser {
+ public:
+  SingleServerTraverser(
+      std::vector<TRI_document_collection_t*> const&, TraverserOptions&,
+      CollectionNameResolver*, Transaction*,
+      std::unordered_map<size_t, std::vector<TraverserExpression*>> const*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the vertex on the other side of an edge
+  //////////////////////////////////////////////////////////////////////////////
+
+  static VertexId otherVertex(EdgeInfo const&, VertexId const&);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief set a lock to hold while looking up or adding collections of the
+  /// transaction. required if several traversers use the same transaction
+  /// in different threads
+  //////////////////////////////////////////////////////////////////////////////
+
+  void setTransactionLock(arangodb::Mutex* lock) { _trxLock = lock; }
+
+ protected:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Get an edge index for the given collection by name
+  //////////////////////////////////////////////////////////////////////////////
+
+  EdgeIndex* getEdgeIndex(std::string const&, TRI_voc_cid_t&);
+
+  bool edgeMatchesConditions(TRI_doc_mptr_t&, size_t&, size_t);
+
+  bool vertexMatchesConditions(VertexId const&, size_t);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief check the conditions on depth 0. returns false if the start
+  /// vertex does not exist or does not match
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool startVertexMatchesConditions(VertexId const&);
+
+ protected:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief collection name resolver
+  //////////////////////////////////////////////////////////////////////////////
+
+  CollectionNameResolver* _resolver;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a vector containing all required edge collection structures
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<TRI_document_collection_t*> _edgeCols;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Outer top level transaction
+  ///        All Edge Collections have to be properly locked before traversing!
+  //////////////////////////////////////////////////////////////////////////////
+
+  Transaction* _trx;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief lock of the transaction, nullptr if the traverser is the only
+  /// user of the transaction
+  //////////////////////////////////////////////////////////////////////////////
+
+  arangodb::Mutex* _trxLock;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Cache for indexes. Maps collectionName to Index
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unordered_map<std::string, std::pair<TRI_voc_cid_t, EdgeIndex*>>
+      _indexCache;
 };
 
-class DepthFirstTraverser : public Traverser {
+class DepthFirstTraverser : public SingleServerTraverser {
 
  private:
   //////////////////////////////////////////////////////////////////////////////
@@ -212,9 +305,8 @@ class DepthFirstTraverser : public Traverser {
   class EdgeGetter {
    public:
     EdgeGetter(DepthFirstTraverser* traverser,
-                        TraverserOptions const& opts,
-                        CollectionNameResolver* resolver, Transaction* trx)
-        : _traverser(traverser), _resolver(resolver), _opts(opts), _trx(trx) {}
+                        TraverserOptions const& opts, Transaction* trx)
+        : _traverser(traverser), _opts(opts), _trx(trx) {}
 
     //////////////////////////////////////////////////////////////////////////////
     /// @brief Function to fill the list of edges properly.
@@ -226,26 +318,15 @@ class DepthFirstTraverser : public Traverser {
    private:
 
     //////////////////////////////////////////////////////////////////////////////
-    /// @brief Get an edge index for the given collection by name
+    /// @brief whether or not the vertex is already on the path
     //////////////////////////////////////////////////////////////////////////////
-    
-    EdgeIndex* getEdgeIndex(std::string const&, TRI_voc_cid_t&);
 
-    //////////////////////////////////////////////////////////////////////////////
-    /// @brief Collection name resolver
-    //////////////////////////////////////////////////////////////////////////////
-    DepthFirstTraverser* _traverser;
+    bool isOnPath(VertexId const&, std::vector<EdgeInfo> const&) const;
 
     //////////////////////////////////////////////////////////////////////////////
-    /// @brief Collection name resolver
+    /// @brief the traverser
     //////////////////////////////////////////////////////////////////////////////
-    CollectionNameResolver* _resolver;
-
-    //////////////////////////////////////////////////////////////////////////////
-    /// @brief Cache for indexes. Maps collectionName to Index
-    //////////////////////////////////////////////////////////////////////////////
-    std::unordered_map<std::string, std::pair<TRI_voc_cid_t, EdgeIndex*>>
-        _indexCache;
+    DepthFirstTraverser* _traverser;
 
     //////////////////////////////////////////////////////////////////////////////
     /// @brief Traverser options
@@ -259,12 +340,6 @@ class DepthFirstTraverser : public Traverser {
     Transaction* _trx;
   };
 
-  //////////////////////////////////////////////////////////////////////////////
-  /// @brief collection name resolver
-  //////////////////////////////////////////////////////////////////////////////
-
-  CollectionNameResolver* _resolver;
-
   //////////////////////////////////////////////////////////////////////////////
   /// @brief internal cursor to enumerate the paths of a graph
   //////////////////////////////////////////////////////////////////////////////
@@ -286,25 +361,69 @@ class DepthFirstTraverser : public Traverser {
       _getVertex;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief a vector containing all required edge collection structures
+  /// @brief the start vertex of the current traversal
   //////////////////////////////////////////////////////////////////////////////
 
-  std::vector<TRI_document_collection_t*> _edgeCols;
+  VertexId _startVertex;
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief Outer top level transaction
+  /// @brief internal function to define the _getVertex and _getEdge functions
   //////////////////////////////////////////////////////////////////////////////
 
-  Transaction* _trx;
+  void _defInternalFunctions();
+
+ public:
+  DepthFirstTraverser(
+      std::vector<TRI_document_collection_t*> const&, TraverserOptions&,
+      CollectionNameResolver*, Transaction*,
+      std::unordered_map<size_t, std::vector<TraverserExpression*>> const*);
 
   //////////////////////////////////////////////////////////////////////////////
-  /// @brief internal function to define the _getVertex and _getEdge functions
+  /// @brief Reset the traverser to use another start vertex
   //////////////////////////////////////////////////////////////////////////////
 
-  void _defInternalFunctions();
+  void setStartVertex(VertexId const& v) override;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Get the next possible path in the graph.
+  //////////////////////////////////////////////////////////////////////////////
+
+  TraversalPath* next() override;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief traverser visiting the graph level by level. the edges of all
+/// vertices of a level are looked up with one batch lookup per edge index
+/// and direction. with global uniqueness every vertex (or edge) is visited
+/// only once, on one of its shortest paths from the start vertex, which
+/// keeps the work linear in the size of the reachable subgraph
+////////////////////////////////////////////////////////////////////////////////
+
+class BreadthFirstTraverser : public SingleServerTraverser {
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a path found so far, stored as its last edge and a reference
+  /// to the path it extends. the start vertex has no edge
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Step {
+    size_t parent;
+    size_t depth;
+    bool pruned;
+    VertexId vertex;
+    EdgeInfo edge;
+
+    Step(size_t parent, size_t depth, VertexId const& vertex,
+         EdgeInfo const& edge)
+        : parent(parent),
+          depth(depth),
+          pruned(false),
+          vertex(vertex),
+          edge(edge) {}
+  };
 
  public:
-  DepthFirstTraverser(
+  BreadthFirstTraverser(
       std::vector<TRI_document_collection_t*> const&, TraverserOptions&,
       CollectionNameResolver*, Transaction*,
       std::unordered_map<size_t, std::vector<TraverserExpression*>> const*);
@@ -322,9 +441,57 @@ class DepthFirstTraverser : public Traverser {
   TraversalPath* next() override;
 
  private:
-  bool edgeMatchesConditions(TRI_doc_mptr_t&, size_t&, size_t);
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compute the next level from the steps of the current one.
+  /// returns false if the next level is empty
+  //////////////////////////////////////////////////////////////////////////////
 
-  bool vertexMatchesConditions(VertexId const&, size_t);
+  bool expandLevel();
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief add the step for an edge of the step at position parent, if the
+  /// edge and its vertex pass the uniqueness checks and the conditions
+  //////////////////////////////////////////////////////////////////////////////
+
+  void addStep(size_t parent, size_t eColIdx, TRI_voc_cid_t,
+               TRI_doc_mptr_t*);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the vertex or the edge occurs on the path ending
+  /// at the step at position parent
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool isVertexOnPath(size_t parent, VertexId const&) const;
+
+  bool isEdgeOnPath(size_t parent, EdgeInfo const&) const;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief all steps found so far, ordered by depth
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<Step> _steps;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief first step of the deepest level found so far
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _levelStart;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief next step to return
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t _position;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief vertices and edges visited from the start vertex, only used for
+  /// global uniqueness
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unordered_set<VertexId> _visitedVertices;
+
+  std::unordered_set<EdgeId> _visitedEdges;
 };
 }
 }
@@ -336,6 +503,27 @@ class DepthFirstTraverser : public Traverser {
 typedef std::function<double(TRI_doc_mptr_copy_t& edge)>
     WeightCalculatorFunction;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Define edge weight by ony special attribute.
+///        Uses the default weight for edges without a numeric attribute.
+////////////////////////////////////////////////////////////////////////////////
+
+class AttributeWeightCalculator {
+  TRI_shape_pid_t _shapePid;
+  double _defaultWeight;
+  VocShaper* _shaper;
+
+ public:
+  AttributeWeightCalculator(std::string const& keyWeight, double defaultWeight,
+                            VocShaper* shaper);
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief Callable weight calculator for edge
+  //////////////////////////////////////////////////////////////////////////////
+
+  double operator()(TRI_doc_mptr_copy_t const& edge);
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Information required internally of the traverser.
 ///        Used to easily pass around collections.
@@ -1238,6 +1238,10 @@ static void JS_ExecuteAqlJson(v8::FunctionCallbackInfo<v8::Value> const& args) {
     result->ForceSet(TRI_V8_ASCII_STRING("profile"),
                      TRI_ObjectJson(isolate, queryResult.profile));
   }
+  if (queryResult.plan != nullptr) {
+    result->ForceSet(TRI_V8_ASCII_STRING("plan"),
+                     TRI_VPackToV8(isolate, queryResult.plan->slice()));
+  }
   if (queryResult.warnings == nullptr) {
     result->ForceSet(TRI_V8_ASCII_STRING("warnings"), v8::Array::New(isolate));
   } else {
@@ -1340,6 +1344,10 @@ static void JS_ExecuteAql(v8::FunctionCallbackInfo<v8::Value> const& args) {
     result->ForceSet(TRI_V8_ASCII_STRING("profile"),
                      TRI_ObjectJson(isolate, queryResult.profile));
   }
+  if (queryResult.plan != nullptr) {
+    result->ForceSet(TRI_V8_ASCII_STRING("plan"),
+                     TRI_VPackToV8(isolate, queryResult.plan->slice()));
+  }
   if (queryResult.warnings == nullptr) {
     result->ForceSet(TRI_V8_ASCII_STRING("warnings"), v8::Array::New(isolate));
   } else {
@@ -1464,6 +1472,9 @@ static void JS_QueriesCurrentAql(
       obj->Set(TRI_V8_ASCII_STRING("runTime"),
                v8::Number::New(isolate, q.runTime));
       obj->Set(TRI_V8_ASCII_STRING("state"), TRI_V8_STD_STRING(queryState));
+      obj->Set(TRI_V8_ASCII_STRING("peakMemoryUsage"),
+               v8::Number::New(isolate,
+                               static_cast<double>(q.peakMemoryUsage)));
       result->Set(i++, obj);
     }
 
@@ -1517,6 +1528,13 @@ static void JS_QueriesSlowAql(v8::FunctionCallbackInfo<v8::Value> const& args) {
       obj->Set(TRI_V8_ASCII_STRING("runTime"),
                v8::Number::New(isolate, q.runTime));
       obj->Set(TRI_V8_ASCII_STRING("state"), TRI_V8_STD_STRING(queryState));
+      obj->Set(TRI_V8_ASCII_STRING("peakMemoryUsage"),
+               v8::Number::New(isolate,
+                               static_cast<double>(q.peakMemoryUsage)));
+      if (q.plan != nullptr) {
+        obj->Set(TRI_V8_ASCII_STRING("plan"),
+                 TRI_VPackToV8(isolate, q.plan->slice()));
+      }
       result->Set(i++, obj);
     }
 
@@ -2018,54 +2036,6 @@ class HopWeightCalculator {
   double operator()(TRI_doc_mptr_copy_t& edge) { return 1; }
 };
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief Define edge weight by ony special attribute.
-///        Respectively 1 for any edge.
-////////////////////////////////////////////////////////////////////////////////
-
-class AttributeWeightCalculator {
-  TRI_shape_pid_t _shapePid;
-  double _defaultWeight;
-  VocShaper* _shaper;
-
- public:
-  AttributeWeightCalculator(std::string const& keyWeight, double defaultWeight,
-                            VocShaper* shaper)
-      : _defaultWeight(defaultWeight), _shaper(shaper) {
-    _shapePid = _shaper->lookupAttributePathByName(keyWeight.c_str());
-  }
-
-  //////////////////////////////////////////////////////////////////////////////
-  /// @brief Callable weight calculator for edge
-  //////////////////////////////////////////////////////////////////////////////
-
-  double operator()(TRI_doc_mptr_copy_t const& edge) {
-    if (_shapePid == 0) {
-      return _defaultWeight;
-    }
-
-    TRI_shape_sid_t sid;
-    TRI_EXTRACT_SHAPE_IDENTIFIER_MARKER(sid, edge.getDataPtr());
-    TRI_shape_access_t const* accessor = _shaper->findAccessor(sid, _shapePid);
-    TRI_shaped_json_t shapedJson;
-    TRI_EXTRACT_SHAPED_JSON_MARKER(shapedJson, edge.getDataPtr());
-    TRI_shaped_json_t resultJson;
-    TRI_ExecuteShapeAccessor(accessor, &shapedJson, &resultJson);
-
-    if (resultJson._sid != TRI_SHAPE_NUMBER) {
-      return _defaultWeight;
-    }
-
-    std::unique_ptr<TRI_json_t> json(TRI_JsonShapedJson(_shaper, &resultJson));
-
-    if (json == nullptr) {
-      return _defaultWeight;
-    }
-
-    return json.get()->_value._number;
-  }
-};
-
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Executes a shortest Path Traversal
 ////////////////////////////////////////////////////////////////////////////////
@@ -183,6 +183,70 @@ static int ProcessIndexFields(v8::Isolate* isolate,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the optional list of stored values and add them to the json
+////////////////////////////////////////////////////////////////////////////////
+
+static int ProcessIndexStoredValues(v8::Isolate* isolate,
+                                    v8::Handle<v8::Object> const obj,
+                                    VPackBuilder& builder) {
+  v8::HandleScope scope(isolate);
+
+  v8::Handle<v8::String> storedValuesString =
+      TRI_V8_ASCII_STRING("storedValues");
+  if (!obj->Has(storedValuesString)) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  if (!obj->Get(storedValuesString)->IsArray()) {
+    return TRI_ERROR_BAD_PARAMETER;
+  }
+
+  std::set<std::string> storedValues;
+  v8::Handle<v8::Array> storedList =
+      v8::Handle<v8::Array>::Cast(obj->Get(storedValuesString));
+
+  uint32_t const n = storedList->Length();
+
+  for (uint32_t i = 0; i < n; ++i) {
+    if (!storedList->Get(i)->IsString()) {
+      return TRI_ERROR_BAD_PARAMETER;
+    }
+
+    std::string const f = TRI_ObjectToString(storedList->Get(i));
+
+    if (f.empty() || f[0] == '_' || f.find('.') != std::string::npos ||
+        f.find("[*]") != std::string::npos) {
+      // internal attributes, attribute paths and array expansions cannot be
+      // stored
+      return TRI_ERROR_BAD_PARAMETER;
+    }
+
+    if (storedValues.find(f) != storedValues.end()) {
+      // duplicate attribute name
+      return TRI_ERROR_BAD_PARAMETER;
+    }
+
+    storedValues.insert(f);
+  }
+
+  if (n == 0) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  try {
+    builder.add(VPackValue("storedValues"));
+    int res = TRI_V8ToVPack(isolate, builder, obj->Get(storedValuesString),
+                            false);
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+  } catch (...) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief process the geojson flag and add it to the json
 ////////////////////////////////////////////////////////////////////////////////
@@ -271,6 +335,9 @@ static int EnhanceJsonIndexHash(v8::Isolate* isolate,
                                 v8::Handle<v8::Object> const obj,
                                 VPackBuilder& builder, bool create) {
   int res = ProcessIndexFields(isolate, obj, builder, 0, create);
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = ProcessIndexStoredValues(isolate, obj, builder);
+  }
   ProcessIndexSparseFlag(isolate, obj, builder, create);
   ProcessIndexUniqueFlag(isolate, obj, builder);
   return res;
@@ -284,6 +351,9 @@ static int EnhanceJsonIndexSkiplist(v8::Isolate* isolate,
                                     v8::Handle<v8::Object> const obj,
                                     VPackBuilder& builder, bool create) {
   int res = ProcessIndexFields(isolate, obj, builder, 0, create);
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = ProcessIndexStoredValues(isolate, obj, builder);
+  }
   ProcessIndexSparseFlag(isolate, obj, builder, create);
   ProcessIndexUniqueFlag(isolate, obj, builder);
   return res;
@@ -602,6 +672,17 @@ static void EnsureIndexLocal(v8::FunctionCallbackInfo<v8::Value> const& args,
     }
   }
 
+  // extract the optional stored values
+  std::vector<std::string> storedValues;
+  value = slice.get("storedValues");
+  if (value.isArray()) {
+    for (auto const& v : VPackArrayIterator(value)) {
+      if (v.isString()) {
+        storedValues.emplace_back(v.copyString());
+      }
+    }
+  }
+
   SingleCollectionReadOnlyTransaction trx(
       new V8TransactionContext(true), collection->_vocbase, collection->_cid);
 
@@ -678,11 +759,13 @@ static void EnsureIndexLocal(v8::FunctionCallbackInfo<v8::Value> const& args,
       if (create) {
         idx = static_cast<arangodb::HashIndex*>(
             TRI_EnsureHashIndexDocumentCollection(
-                &trx, document, iid, attributes, sparse, unique, created));
+                &trx, document, iid, attributes, storedValues, sparse, unique,
+                created));
       } else {
         idx = static_cast<arangodb::HashIndex*>(
             TRI_LookupHashIndexDocumentCollection(document, attributes,
-                                                  sparsity, unique));
+                                                  storedValues, sparsity,
+                                                  unique));
       }
 
       break;
@@ -696,11 +779,12 @@ static void EnsureIndexLocal(v8::FunctionCallbackInfo<v8::Value> const& args,
       if (create) {
         idx = static_cast<arangodb::SkiplistIndex*>(
             TRI_EnsureSkiplistIndexDocumentCollection(
-                &trx, document, iid, attributes, sparse, unique, created));
+                &trx, document, iid, attributes, storedValues, sparse, unique,
+                created));
       } else {
         idx = static_cast<arangodb::SkiplistIndex*>(
-            TRI_LookupSkiplistIndexDocumentCollection(document, attributes,
-                                                      sparsity, unique));
+            TRI_LookupSkiplistIndexDocumentCollection(
+                document, attributes, storedValues, sparsity, unique));
       }
       break;
     }
@@ -184,12 +184,30 @@ struct TraverserOptions {
   std::vector<TRI_edge_direction_e> _directions;
 
  public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief scope in which a vertex or an edge may occur only once. PATH
+  /// rejects it twice on the same path, GLOBAL rejects it twice within the
+  /// traversal from one start vertex
+  //////////////////////////////////////////////////////////////////////////////
+
+  enum UniquenessLevel { NONE, PATH, GLOBAL };
 
   uint64_t minDepth;
 
   uint64_t maxDepth;
 
-  TraverserOptions() : minDepth(1), maxDepth(1) {}
+  bool useBreadthFirst;
+
+  UniquenessLevel uniqueVertices;
+
+  UniquenessLevel uniqueEdges;
+
+  TraverserOptions()
+      : minDepth(1),
+        maxDepth(1),
+        useBreadthFirst(false),
+        uniqueVertices(NONE),
+        uniqueEdges(PATH) {}
 
   void setCollections(std::vector<std::string> const&, TRI_edge_direction_e);
   void setCollections(std::vector<std::string> const&, std::vector<TRI_edge_direction_e> const&);
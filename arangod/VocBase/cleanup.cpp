@@ -49,6 +49,12 @@ static int const CLEANUP_CURSOR_ITERATIONS = 3;
 
 static int const CLEANUP_INDEX_ITERATIONS = 5;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief how many cleanup iterations until index statistics are refreshed
+////////////////////////////////////////////////////////////////////////////////
+
+static int const CLEANUP_STATISTICS_ITERATIONS = 5;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checks all datafiles of a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -287,6 +293,16 @@ void TRI_CleanupVocBase(void* data) {
           document->cleanupIndexes(document);
         }
 
+        // refresh outdated index statistics used by the AQL optimizer
+        if (iterations % (uint64_t)CLEANUP_STATISTICS_ITERATIONS == 0) {
+          int res = TRI_UpdateIndexStatisticsDocumentCollection(document);
+
+          if (res != TRI_ERROR_NO_ERROR) {
+            LOG(WARN) << "cannot update index statistics: "
+                      << TRI_errno_string(res);
+          }
+        }
+
         CleanupDocumentCollection(collection, document);
       }
 
@@ -23,6 +23,7 @@
 
 #include "document-collection.h"
 
+#include "Aql/PlanCache.h"
 #include "Aql/QueryCache.h"
 #include "Basics/Barrier.h"
 #include "Basics/conversions.h"
@@ -3208,6 +3209,24 @@ static int FillIndex(arangodb::Transaction* trx,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parses the names of the stored values of an index
+////////////////////////////////////////////////////////////////////////////////
+
+static std::vector<std::vector<arangodb::basics::AttributeName>>
+StoredValuesByAttributeNames(std::vector<std::string> const& attributes) {
+  std::vector<std::vector<arangodb::basics::AttributeName>> result;
+  result.reserve(attributes.size());
+
+  for (auto const& name : attributes) {
+    std::vector<arangodb::basics::AttributeName> parsed;
+    TRI_ParseAttributeString(name, parsed);
+    result.emplace_back(parsed);
+  }
+
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief finds a path based, unique or non-unique index
 ////////////////////////////////////////////////////////////////////////////////
@@ -3215,6 +3234,8 @@ static int FillIndex(arangodb::Transaction* trx,
 static arangodb::Index* LookupPathIndexDocumentCollection(
     TRI_document_collection_t* collection,
     std::vector<std::vector<arangodb::basics::AttributeName>> const& paths,
+    std::vector<std::vector<arangodb::basics::AttributeName>> const&
+        storedValues,
     arangodb::Index::IndexType type, int sparsity, bool unique,
     bool allowAnyAttributeOrder) {
   for (auto const& idx : collection->allIndexes()) {
@@ -3222,6 +3243,12 @@ static arangodb::Index* LookupPathIndexDocumentCollection(
       continue;
     }
 
+    // the stored values must be identical, in the same order
+    if (!arangodb::basics::AttributeName::isIdentical(idx->storedValues(),
+                                                      storedValues, false)) {
+      continue;
+    }
+
     // .........................................................................
     // Now perform checks which are specific to the type of index
     // .........................................................................
@@ -3333,6 +3360,7 @@ static int PathBasedIndexFromVelocyPack(
     VPackSlice const& definition, TRI_idx_iid_t iid,
     arangodb::Index* (*creator)(arangodb::Transaction*,
                                 TRI_document_collection_t*,
+                                std::vector<std::string> const&,
                                 std::vector<std::string> const&, TRI_idx_iid_t,
                                 bool, bool, bool&),
     arangodb::Index** dst) {
@@ -3398,9 +3426,24 @@ static int PathBasedIndexFromVelocyPack(
     attributes.emplace_back(fieldStr.copyString());
   }
 
+  // find stored values
+  std::vector<std::string> storedValues;
+  VPackSlice stored = definition.get("storedValues");
+
+  if (stored.isArray()) {
+    for (auto const& it : VPackArrayIterator(stored)) {
+      if (!it.isString()) {
+        LOG(ERR) << "ignoring index " << iid << ", invalid stored value";
+        return TRI_set_errno(TRI_ERROR_BAD_PARAMETER);
+      }
+      storedValues.emplace_back(it.copyString());
+    }
+  }
+
   // create the index
   bool created;
-  auto idx = creator(trx, document, attributes, iid, sparse, unique, created);
+  auto idx = creator(trx, document, attributes, storedValues, iid, sparse,
+                     unique, created);
 
   if (dst != nullptr) {
     *dst = idx;
@@ -3532,6 +3575,39 @@ std::vector<std::shared_ptr<VPackBuilder>> TRI_IndexesDocumentCollection(
   return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief rebuilds the outdated statistics of the indexes of a collection
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_UpdateIndexStatisticsDocumentCollection(
+    TRI_document_collection_t* document) {
+  int res = TRI_ERROR_NO_ERROR;
+  bool updated = false;
+
+  {
+    READ_LOCKER(readLocker, document->_lock);
+
+    for (auto& idx : document->allIndexes()) {
+      if (idx->needsStatisticsUpdate()) {
+        res = idx->updateStatistics();
+
+        if (res != TRI_ERROR_NO_ERROR) {
+          break;
+        }
+        updated = true;
+      }
+    }
+  }
+
+  if (updated) {
+    // cached plans were chosen based on the previous statistics
+    arangodb::aql::PlanCache::instance()->invalidate(
+        document->_vocbase, document->_info.namec_str());
+  }
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief drops an index, including index file removal and replication
 ////////////////////////////////////////////////////////////////////////////////
@@ -3552,6 +3628,8 @@ bool TRI_DropIndexDocumentCollection(TRI_document_collection_t* document,
 
     arangodb::aql::QueryCache::instance()->invalidate(
         vocbase, document->_info.namec_str());
+    arangodb::aql::PlanCache::instance()->invalidate(
+        vocbase, document->_info.namec_str());
     found = document->removeIndex(iid);
   }
 
@@ -3837,6 +3915,8 @@ arangodb::Index* TRI_EnsureCapConstraintDocumentCollection(
     if (created) {
       arangodb::aql::QueryCache::instance()->invalidate(
           document->_vocbase, document->_info.namec_str());
+      arangodb::aql::PlanCache::instance()->invalidate(
+          document->_vocbase, document->_info.namec_str());
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -4133,6 +4213,8 @@ arangodb::Index* TRI_EnsureGeoIndex1DocumentCollection(
     if (created) {
       arangodb::aql::QueryCache::instance()->invalidate(
           document->_vocbase, document->_info.namec_str());
+      arangodb::aql::PlanCache::instance()->invalidate(
+          document->_vocbase, document->_info.namec_str());
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -4163,6 +4245,8 @@ arangodb::Index* TRI_EnsureGeoIndex2DocumentCollection(
     if (created) {
       arangodb::aql::QueryCache::instance()->invalidate(
           document->_vocbase, document->_info.namec_str());
+      arangodb::aql::PlanCache::instance()->invalidate(
+          document->_vocbase, document->_info.namec_str());
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -4180,8 +4264,9 @@ arangodb::Index* TRI_EnsureGeoIndex2DocumentCollection(
 
 static arangodb::Index* CreateHashIndexDocumentCollection(
     arangodb::Transaction* trx, TRI_document_collection_t* document,
-    std::vector<std::string> const& attributes, TRI_idx_iid_t iid, bool sparse,
-    bool unique, bool& created) {
+    std::vector<std::string> const& attributes,
+    std::vector<std::string> const& storedValues, TRI_idx_iid_t iid,
+    bool sparse, bool unique, bool& created) {
   created = false;
   std::vector<TRI_shape_pid_t> paths;
   std::vector<std::vector<arangodb::basics::AttributeName>> fields;
@@ -4204,8 +4289,8 @@ static arangodb::Index* CreateHashIndexDocumentCollection(
 
   int sparsity = sparse ? 1 : 0;
   auto idx = LookupPathIndexDocumentCollection(
-      document, fields, arangodb::Index::TRI_IDX_TYPE_HASH_INDEX, sparsity,
-      unique, false);
+      document, fields, StoredValuesByAttributeNames(storedValues),
+      arangodb::Index::TRI_IDX_TYPE_HASH_INDEX, sparsity, unique, false);
 
   if (idx != nullptr) {
     LOG(TRACE) << "hash-index already created";
@@ -4220,8 +4305,9 @@ static arangodb::Index* CreateHashIndexDocumentCollection(
   // create the hash index. we'll provide it with the current number of
   // documents
   // in the collection so the index can do a sensible memory preallocation
-  auto hashIndex = std::make_unique<arangodb::HashIndex>(iid, document, fields,
-                                                         unique, sparse);
+  auto hashIndex = std::make_unique<arangodb::HashIndex>(
+      iid, document, fields, StoredValuesByAttributeNames(storedValues), unique,
+      sparse);
   idx = static_cast<arangodb::Index*>(hashIndex.get());
 
   // initializes the index with all existing documents
@@ -4267,7 +4353,8 @@ static int HashIndexFromVelocyPack(arangodb::Transaction* trx,
 
 arangodb::Index* TRI_LookupHashIndexDocumentCollection(
     TRI_document_collection_t* document,
-    std::vector<std::string> const& attributes, int sparsity, bool unique) {
+    std::vector<std::string> const& attributes,
+    std::vector<std::string> const& storedValues, int sparsity, bool unique) {
   std::vector<TRI_shape_pid_t> paths;
   std::vector<std::vector<arangodb::basics::AttributeName>> fields;
 
@@ -4282,8 +4369,8 @@ arangodb::Index* TRI_LookupHashIndexDocumentCollection(
   }
 
   return LookupPathIndexDocumentCollection(
-      document, fields, arangodb::Index::TRI_IDX_TYPE_HASH_INDEX, sparsity,
-      unique, true);
+      document, fields, StoredValuesByAttributeNames(storedValues),
+      arangodb::Index::TRI_IDX_TYPE_HASH_INDEX, sparsity, unique, true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4292,19 +4379,22 @@ arangodb::Index* TRI_LookupHashIndexDocumentCollection(
 
 arangodb::Index* TRI_EnsureHashIndexDocumentCollection(
     arangodb::Transaction* trx, TRI_document_collection_t* document,
-    TRI_idx_iid_t iid, std::vector<std::string> const& attributes, bool sparse,
-    bool unique, bool& created) {
+    TRI_idx_iid_t iid, std::vector<std::string> const& attributes,
+    std::vector<std::string> const& storedValues, bool sparse, bool unique,
+    bool& created) {
   READ_LOCKER(readLocker, document->_vocbase->_inventoryLock);
 
   WRITE_LOCKER(writeLocker, document->_lock);
 
-  auto idx = CreateHashIndexDocumentCollection(trx, document, attributes, iid,
-                                               sparse, unique, created);
+  auto idx = CreateHashIndexDocumentCollection(
+      trx, document, attributes, storedValues, iid, sparse, unique, created);
 
   if (idx != nullptr) {
     if (created) {
       arangodb::aql::QueryCache::instance()->invalidate(
           document->_vocbase, document->_info.namec_str());
+      arangodb::aql::PlanCache::instance()->invalidate(
+          document->_vocbase, document->_info.namec_str());
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -4322,8 +4412,9 @@ arangodb::Index* TRI_EnsureHashIndexDocumentCollection(
 
 static arangodb::Index* CreateSkiplistIndexDocumentCollection(
     arangodb::Transaction* trx, TRI_document_collection_t* document,
-    std::vector<std::string> const& attributes, TRI_idx_iid_t iid, bool sparse,
-    bool unique, bool& created) {
+    std::vector<std::string> const& attributes,
+    std::vector<std::string> const& storedValues, TRI_idx_iid_t iid,
+    bool sparse, bool unique, bool& created) {
   created = false;
   std::vector<TRI_shape_pid_t> paths;
   std::vector<std::vector<arangodb::basics::AttributeName>> fields;
@@ -4345,8 +4436,8 @@ static arangodb::Index* CreateSkiplistIndexDocumentCollection(
 
   int sparsity = sparse ? 1 : 0;
   auto idx = LookupPathIndexDocumentCollection(
-      document, fields, arangodb::Index::TRI_IDX_TYPE_SKIPLIST_INDEX, sparsity,
-      unique, false);
+      document, fields, StoredValuesByAttributeNames(storedValues),
+      arangodb::Index::TRI_IDX_TYPE_SKIPLIST_INDEX, sparsity, unique, false);
 
   if (idx != nullptr) {
     LOG(TRACE) << "skiplist-index already created";
@@ -4360,7 +4451,8 @@ static arangodb::Index* CreateSkiplistIndexDocumentCollection(
 
   // Create the skiplist index
   auto skiplistIndex = std::make_unique<arangodb::SkiplistIndex>(
-      iid, document, fields, unique, sparse);
+      iid, document, fields, StoredValuesByAttributeNames(storedValues), unique,
+      sparse);
   idx = static_cast<arangodb::Index*>(skiplistIndex.get());
 
   // initializes the index with all existing documents
@@ -4408,7 +4500,8 @@ static int SkiplistIndexFromVelocyPack(arangodb::Transaction* trx,
 
 arangodb::Index* TRI_LookupSkiplistIndexDocumentCollection(
     TRI_document_collection_t* document,
-    std::vector<std::string> const& attributes, int sparsity, bool unique) {
+    std::vector<std::string> const& attributes,
+    std::vector<std::string> const& storedValues, int sparsity, bool unique) {
   std::vector<TRI_shape_pid_t> paths;
   std::vector<std::vector<arangodb::basics::AttributeName>> fields;
 
@@ -4423,8 +4516,8 @@ arangodb::Index* TRI_LookupSkiplistIndexDocumentCollection(
   }
 
   return LookupPathIndexDocumentCollection(
-      document, fields, arangodb::Index::TRI_IDX_TYPE_SKIPLIST_INDEX, sparsity,
-      unique, true);
+      document, fields, StoredValuesByAttributeNames(storedValues),
+      arangodb::Index::TRI_IDX_TYPE_SKIPLIST_INDEX, sparsity, unique, true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4433,19 +4526,22 @@ arangodb::Index* TRI_LookupSkiplistIndexDocumentCollection(
 
 arangodb::Index* TRI_EnsureSkiplistIndexDocumentCollection(
     arangodb::Transaction* trx, TRI_document_collection_t* document,
-    TRI_idx_iid_t iid, std::vector<std::string> const& attributes, bool sparse,
-    bool unique, bool& created) {
+    TRI_idx_iid_t iid, std::vector<std::string> const& attributes,
+    std::vector<std::string> const& storedValues, bool sparse, bool unique,
+    bool& created) {
   READ_LOCKER(readLocker, document->_vocbase->_inventoryLock);
 
   WRITE_LOCKER(writeLocker, document->_lock);
 
   auto idx = CreateSkiplistIndexDocumentCollection(
-      trx, document, attributes, iid, sparse, unique, created);
+      trx, document, attributes, storedValues, iid, sparse, unique, created);
 
   if (idx != nullptr) {
     if (created) {
       arangodb::aql::QueryCache::instance()->invalidate(
           document->_vocbase, document->_info.namec_str());
+      arangodb::aql::PlanCache::instance()->invalidate(
+          document->_vocbase, document->_info.namec_str());
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -4628,6 +4724,8 @@ arangodb::Index* TRI_EnsureFulltextIndexDocumentCollection(
     if (created) {
       arangodb::aql::QueryCache::instance()->invalidate(
           document->_vocbase, document->_info.namec_str());
+      arangodb::aql::PlanCache::instance()->invalidate(
+          document->_vocbase, document->_info.namec_str());
       int res = TRI_SaveIndex(document, idx, true);
 
       if (res != TRI_ERROR_NO_ERROR) {
@@ -789,6 +789,12 @@ TRI_IndexesDocumentCollection(TRI_document_collection_t*, bool);
 bool TRI_DropIndexDocumentCollection(TRI_document_collection_t*, TRI_idx_iid_t,
                                      bool);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief rebuilds the outdated statistics of the indexes of a collection
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_UpdateIndexStatisticsDocumentCollection(TRI_document_collection_t*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief looks up a cap constraint
 ////////////////////////////////////////////////////////////////////////////////
@@ -847,7 +853,8 @@ arangodb::Index* TRI_EnsureGeoIndex2DocumentCollection(
 ////////////////////////////////////////////////////////////////////////////////
 
 arangodb::Index* TRI_LookupHashIndexDocumentCollection(
-    TRI_document_collection_t*, std::vector<std::string> const&, int, bool);
+    TRI_document_collection_t*, std::vector<std::string> const&,
+    std::vector<std::string> const&, int, bool);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief ensures that a hash index exists
@@ -855,7 +862,8 @@ arangodb::Index* TRI_LookupHashIndexDocumentCollection(
 
 arangodb::Index* TRI_EnsureHashIndexDocumentCollection(
     arangodb::Transaction* trx, TRI_document_collection_t*, TRI_idx_iid_t,
-    std::vector<std::string> const&, bool, bool, bool&);
+    std::vector<std::string> const&, std::vector<std::string> const&, bool,
+    bool, bool&);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief finds a skiplist index
@@ -864,7 +872,8 @@ arangodb::Index* TRI_EnsureHashIndexDocumentCollection(
 ////////////////////////////////////////////////////////////////////////////////
 
 arangodb::Index* TRI_LookupSkiplistIndexDocumentCollection(
-    TRI_document_collection_t*, std::vector<std::string> const&, int, bool);
+    TRI_document_collection_t*, std::vector<std::string> const&,
+    std::vector<std::string> const&, int, bool);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief ensures that a skiplist index exists
@@ -872,7 +881,8 @@ arangodb::Index* TRI_LookupSkiplistIndexDocumentCollection(
 
 arangodb::Index* TRI_EnsureSkiplistIndexDocumentCollection(
     arangodb::Transaction* trx, TRI_document_collection_t*, TRI_idx_iid_t,
-    std::vector<std::string> const&, bool, bool, bool&);
+    std::vector<std::string> const&, std::vector<std::string> const&, bool,
+    bool, bool&);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief finds a fulltext index
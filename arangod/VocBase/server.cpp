@@ -27,6 +27,7 @@
 #include "Basics/win-utils.h"
 #endif
 
+#include "Aql/PlanCache.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryRegistry.h"
 #include "Basics/Exceptions.h"
@@ -1844,6 +1845,7 @@ int TRI_DropDatabaseServer(TRI_server_t* server, char const* name,
 
   // invalidate all entries for the database
   arangodb::aql::QueryCache::instance()->invalidate(vocbase);
+  arangodb::aql::PlanCache::instance()->invalidate(vocbase);
 
   int res = TRI_ERROR_NO_ERROR;
 
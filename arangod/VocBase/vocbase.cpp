@@ -27,6 +27,7 @@
 
 #include "vocbase.h"
 
+#include "Aql/PlanCache.h"
 #include "Aql/QueryCache.h"
 #include "Aql/QueryList.h"
 #include "Basics/conversions.h"
@@ -723,6 +724,8 @@ static int RenameCollection(TRI_vocbase_t* vocbase,
   // invalidate all entries for the two collections
   arangodb::aql::QueryCache::instance()->invalidate(
       vocbase, std::vector<std::string>{oldName, newName});
+  arangodb::aql::PlanCache::instance()->invalidate(
+      vocbase, std::vector<std::string>{oldName, newName});
 
   return TRI_ERROR_NO_ERROR;
 }
@@ -1068,6 +1071,7 @@ static int DropCollection(TRI_vocbase_t* vocbase, TRI_vocbase_col_t* collection,
   TRI_EVENTUAL_WRITE_LOCK_STATUS_VOCBASE_COL(collection);
 
   arangodb::aql::QueryCache::instance()->invalidate(vocbase, colName.c_str());
+  arangodb::aql::PlanCache::instance()->invalidate(vocbase, colName.c_str());
 
   // .............................................................................
   // collection already deleted
@@ -40,6 +40,7 @@
     "ERROR_FILE_EXISTS"            : { "code" : 27, "message" : "file exists" },
     "ERROR_LOCKED"                 : { "code" : 28, "message" : "locked" },
     "ERROR_DEADLOCK"               : { "code" : 29, "message" : "deadlock detected" },
+    "ERROR_RESOURCE_LIMIT"         : { "code" : 30, "message" : "resource limit exceeded" },
     "ERROR_HTTP_BAD_PARAMETER"     : { "code" : 400, "message" : "bad parameter" },
     "ERROR_HTTP_UNAUTHORIZED"      : { "code" : 401, "message" : "unauthorized" },
     "ERROR_HTTP_FORBIDDEN"         : { "code" : 403, "message" : "forbidden" },
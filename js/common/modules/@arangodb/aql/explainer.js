@@ -712,9 +712,12 @@ function processQuery (query, explain) {
         return keyword("EMPTY") + "   " + annotation("/* empty result set */");
       case "EnumerateCollectionNode":
         collectionVariables[node.outVariable.id] = node.collection;
-        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* full collection scan" + (node.random ? ", random order" : "") + " */");
+        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* full collection scan" + (node.random ? ", random order" : "") + (node.filter ? ", parallel" : "") + " */") + (node.filter ? " " + keyword("FILTER") + " " + buildExpression(node.filter) : "");
       case "EnumerateListNode":
         return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + variableName(node.inVariable) + "   " + annotation("/* list iteration */");
+      case "HashJoinNode":
+        collectionVariables[node.outVariable.id] = node.collection;
+        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* hash join on " + node.outVariable.name + "." + node.buildAttribute.join(".") + " == " + node.probeVariable.name + "." + node.probeAttribute.join(".") + " */");
       case "IndexNode":
         collectionVariables[node.outVariable.id] = node.collection;
         var types = [ ];
@@ -733,6 +736,9 @@ function processQuery (query, explain) {
           } 
           indexes.push(idx);
         });
+        if (node.projections && node.projections.length > 0) {
+          types.push("projections: " + node.projections.join(", "));
+        }
         return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* " + types.join(", ") + " */");
       case "IndexRangeNode":
         collectionVariables[node.outVariable.id] = node.collection;
@@ -788,6 +794,13 @@ function processQuery (query, explain) {
           rc += keyword("GRAPH") +  " '" + value(node.graph) + "'";
         }
 
+        if (node.hasOwnProperty('options') &&
+            (node.options.bfs ||
+             node.options.uniqueVertices !== "none" ||
+             node.options.uniqueEdges !== "path")) {
+          rc += "  " + keyword("OPTIONS") + " " + value(JSON.stringify(node.options));
+        }
+
         traversalDetails.push(node);
         if (node.hasOwnProperty('simpleExpressions')) {
           node.ConditionStr = buildSimpleExpression(node.simpleExpressions);
@@ -819,6 +832,61 @@ function processQuery (query, explain) {
         }
         return rc;
 
+      case "ShortestPathNode":
+        var sp = keyword("FOR ");
+        if (node.hasOwnProperty('pathOutVariable')) {
+          sp += variableName(node.pathOutVariable) +
+            "  " + annotation("/* path */");
+        }
+        else {
+          sp += variableName(node.vertexOutVariable) +
+            "  " + annotation("/* vertex */");
+        }
+
+        if (node.hasOwnProperty('edgeOutVariable')) {
+          sp += "  , " + variableName(node.edgeOutVariable) +
+            "  " + annotation("/* edge */");
+        }
+        sp += "  " + keyword("IN") + " ";
+
+        var spTranslate = ["ANY", "INBOUND", "OUTBOUND"];
+        var spDirection = node.directions[0];
+        sp += keyword(spTranslate[spDirection]) + " " +
+          keyword(node.hasOwnProperty('pathOutVariable') ? "K_SHORTEST_PATHS" : "SHORTEST_PATH");
+        if (node.hasOwnProperty("startVertexId")) {
+          sp += " '" + value(node.startVertexId) + "' ";
+        }
+        else {
+          sp += " " + variableName(node.startInVariable) + " ";
+        }
+        sp += annotation("/* startnode */") + "  " + keyword("TO");
+        if (node.hasOwnProperty("targetVertexId")) {
+          sp += " '" + value(node.targetVertexId) + "' ";
+        }
+        else {
+          sp += " " + variableName(node.targetInVariable) + " ";
+        }
+        sp += annotation("/* targetnode */") + "  ";
+
+        if (Array.isArray(node.graph)) {
+          sp += node.graph.map(function(g, index) {
+            var tmp = "";
+            if (node.directions[index] !== spDirection) {
+              tmp += keyword(spTranslate[node.directions[index]]);
+              tmp += " ";
+            }
+            return tmp + collection(g);
+          }).join(", ");
+        }
+        else {
+          sp += keyword("GRAPH") +  " '" + value(node.graph) + "'";
+        }
+
+        if (node.hasOwnProperty('options') && node.options.weightAttribute !== "") {
+          sp += "  " + keyword("OPTIONS") + " " + value(JSON.stringify(node.options));
+        }
+        return sp;
+
       case "CalculationNode":
         return keyword("LET") + " " + variableName(node.outVariable) + " = " + buildExpression(node.expression) + "   " + annotation("/* " + node.expressionType + " expression */");
       case "FilterNode":
@@ -850,12 +918,13 @@ function processQuery (query, explain) {
           (node.count ? " " + keyword("WITH COUNT") : "") + 
           (node.outVariable ? " " + keyword("INTO") + " " + variableName(node.outVariable) : "") +
           (node.keepVariables ? " " + keyword("KEEP") + " " + node.keepVariables.map(function(variable) { return variableName(variable); }).join(", ") : "") +
-          "   " + annotation("/* " + node.collectOptions.method + "*/");
+          "   " + annotation("/* " + node.collectOptions.method + 
+            (node.aggregationStep && node.aggregationStep !== "complete" ? ", " + node.aggregationStep : "") + "*/");
         return collect;
       case "SortNode":
         return keyword("SORT") + " " + node.elements.map(function(node) {
           return variableName(node.inVariable) + " " + keyword(node.ascending ? "ASC" : "DESC"); 
-        }).join(", ");
+        }).join(", ") + (node.limit > 0 ? "   " + annotation("/* top " + node.limit + " */") : "");
       case "LimitNode":
         return keyword("LIMIT") + " " + value(JSON.stringify(node.offset)) + ", " + value(JSON.stringify(node.limit)); 
       case "ReturnNode":
@@ -890,7 +959,7 @@ function processQuery (query, explain) {
       case "ScatterNode":
         return keyword("SCATTER");
       case "GatherNode":
-        return keyword("GATHER");
+        return keyword("GATHER") + (node.limit > 0 ? "   " + annotation("/* limit: " + node.limit + " */") : "");
     }
 
     return "unhandled node type (" + node.type + ")";
@@ -915,6 +984,7 @@ function processQuery (query, explain) {
 
     if ([ "EnumerateCollectionNode",
           "EnumerateListNode",
+          "HashJoinNode",
           "IndexRangeNode",
           "IndexNode",
           "SubqueryNode" ].indexOf(node.type) !== -1) {
@@ -0,0 +1,198 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for calculations that are evaluated for whole blocks
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("@arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function calculationBatchTestSuite () {
+  var c;
+  var values = [ null, false, true, -1, 0, 0.5, 7, "", "foo", "7", [ 1 ], { a: 1 } ];
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      for (var i = 0; i < 2000; ++i) {
+        c.save({ _key: "test" + i, nr: i, value: values[i % values.length], sub: { nr: i % 10 } });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test numeric filters on documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testNumericFilters : function () {
+      var query = "FOR doc IN " + c.name() + " FILTER doc.nr >= 100 && doc.nr < 200 && doc.sub.nr != 3 SORT doc.nr RETURN doc.nr";
+      var expected = [ ];
+      for (var i = 100; i < 200; ++i) {
+        if (i % 10 !== 3) {
+          expected.push(i);
+        }
+      }
+      assertEqual(expected, AQL_EXECUTE(query).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test arithmetic on documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testArithmetic : function () {
+      var query = "FOR doc IN " + c.name() + " SORT doc.nr RETURN [ doc.nr * 2 + 1, doc.nr - doc.sub.nr, doc.nr % 7, doc.sub.nr / 4 ]";
+      var actual = AQL_EXECUTE(query).json;
+      assertEqual(2000, actual.length);
+      for (var i = 0; i < 2000; ++i) {
+        assertEqual([ i * 2 + 1, i - (i % 10), i % 7, (i % 10) / 4 ], actual[i]);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test mixed value types, including those that are evaluated one by
+/// one
+////////////////////////////////////////////////////////////////////////////////
+
+    testMixedTypes : function () {
+      var query = "FOR doc IN " + c.name() + " SORT doc.nr LIMIT 24 RETURN [ doc.value == 7, doc.value < 'a', doc.value > 0, doc.value + 1, NOT doc.value, doc.value || 'x' ]";
+      var actual = AQL_EXECUTE(query).json;
+      var expected = [
+        [ false, true, false, 1, true, "x" ],
+        [ false, true, false, 1, true, "x" ],
+        [ false, true, false, 2, false, true ],
+        [ false, true, false, 0, false, -1 ],
+        [ false, true, false, 1, true, "x" ],
+        [ false, true, true, 1.5, false, 0.5 ],
+        [ true, true, true, 8, false, 7 ],
+        [ false, true, true, 1, true, "x" ],
+        [ false, false, true, null, false, "foo" ],
+        [ false, true, true, 8, false, "7" ],
+        [ false, false, true, 2, false, [ 1 ] ],
+        [ false, false, true, null, false, { a: 1 } ]
+      ];
+      assertEqual(expected.concat(expected), actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the ternary operator
+////////////////////////////////////////////////////////////////////////////////
+
+    testTernary : function () {
+      var query = "FOR doc IN " + c.name() + " SORT doc.nr RETURN doc.nr % 2 == 0 ? doc.nr / 2 : (doc.sub.nr > 4 ? 'high' : doc._key)";
+      var actual = AQL_EXECUTE(query).json;
+      for (var i = 0; i < 2000; ++i) {
+        if (i % 2 === 0) {
+          assertEqual(i / 2, actual[i]);
+        } else {
+          assertEqual((i % 10) > 4 ? "high" : "test" + i, actual[i]);
+        }
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test string comparisons
+////////////////////////////////////////////////////////////////////////////////
+
+    testStringComparisons : function () {
+      var query = "FOR doc IN " + c.name() + " FILTER doc._key >= 'test1990' && doc._key != 'test1995' SORT doc.nr RETURN doc._key";
+      assertEqual([ "test1990", "test1991", "test1992", "test1993", "test1994",
+                    "test1996", "test1997", "test1998", "test1999" ], AQL_EXECUTE(query).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that string comparisons give the same results as the scalar
+/// evaluation, which is used for function calls
+////////////////////////////////////////////////////////////////////////////////
+
+    testStringComparisonsUtf8 : function () {
+      var strings = [ "a", "A", "b", "B", "ä", "Ä", "\u00e4", "a\u0308", "z", "ß", "ss", "", "a\u0000b", "a" ];
+      var pairs = [ ];
+      strings.forEach(function (l) {
+        strings.forEach(function (r) {
+          pairs.push([ l, r ]);
+        });
+      });
+      var comparisons = " LET eq = l == r LET ne = l != r LET lt = l < r LET le = l <= r LET gt = l > r LET ge = l >= r RETURN [ eq, ne, lt, le, gt, ge ]";
+      var batch = "FOR p IN @pairs LET l = p[0] LET r = p[1]" + comparisons;
+      var scalar = "FOR p IN @pairs LET l = PASSTHRU(p[0]) LET r = PASSTHRU(p[1]) LET eq = PASSTHRU(l == r) LET ne = PASSTHRU(l != r) LET lt = PASSTHRU(l < r) LET le = PASSTHRU(l <= r) LET gt = PASSTHRU(l > r) LET ge = PASSTHRU(l >= r) RETURN [ eq, ne, lt, le, gt, ge ]";
+      assertEqual(AQL_EXECUTE(scalar, { pairs: pairs }).json, AQL_EXECUTE(batch, { pairs: pairs }).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test division by zero warnings
+////////////////////////////////////////////////////////////////////////////////
+
+    testDivisionByZero : function () {
+      var query = "FOR i IN 0..29 RETURN 1 / (i % 10)";
+      var result = AQL_EXECUTE(query);
+      assertEqual(30, result.json.length);
+      for (var i = 0; i < 30; ++i) {
+        assertEqual((i % 10) === 0 ? null : 1 / (i % 10), result.json[i]);
+      }
+      assertEqual(3, result.warnings.length);
+      result.warnings.forEach(function(warning) {
+        assertEqual(1562, warning.code);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test calculations on non-document values
+////////////////////////////////////////////////////////////////////////////////
+
+    testValues : function () {
+      var query = "FOR i IN @values LET x = i + 1 RETURN [ i == x - 1, i < 5, x * 2 ]";
+      var actual = AQL_EXECUTE(query, { values: [ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 ] }).json;
+      for (var i = 0; i < 10; ++i) {
+        assertEqual([ true, i < 5, (i + 1) * 2 ], actual[i]);
+      }
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(calculationBatchTestSuite);
+
+return jsunity.done();
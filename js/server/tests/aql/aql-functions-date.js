@@ -1183,6 +1183,75 @@ function ahuacatlDateFunctionsTestSuite () {
       }); 
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test date_timestamp function with timezone offsets, extended years
+/// and other variants of ISO 8601 dates
+////////////////////////////////////////////////////////////////////////////////
+
+    testDateTimestampFormats : function () {
+      var values = [
+        [ "2012-02-12T13:24:12+01:00", 1329049452000 ],
+        [ "2012-02-12T13:24:12+0100", 1329049452000 ],
+        [ "2012-02-12T13:24:12+01", 1329049452000 ],
+        [ "2012-02-12 13:24:12+01:00", 1329049452000 ],
+        [ "2012-02-12T13:24:12-05:30", 1329072852000 ],
+        [ "2012-02-12T13:24:12.5+00:00", 1329053052500 ],
+        [ "1970-01-01T00:30:00+01:00", -1800000 ],
+        [ "1969-12-31T23:30:00-01:00", 1800000 ],
+        [ "2012-02-12t13:24:12Z", 1329053052000 ],
+        [ "2012-02-12T13:24:12.123456Z", 1329053052123 ],
+        [ "2012-02-12T13:24:12.1Z", 1329053052100 ],
+        [ "2012-02-12T13:24Z", 1329053040000 ],
+        [ "2012-02-12T3:24:12Z", 1329017052000 ],
+        [ "  2012-02-12T13:24:12Z  ", 1329053052000 ],
+        [ "\t2012-02-12\n", 1329004800000 ],
+        [ "+002012-02-12", 1329004800000 ],
+        [ "+010000-01-01", 253402300800000 ],
+        [ "-000001-01-01", -62198755200000 ],
+        [ "+000000-02-29", -62162121600000 ]
+      ];
+
+      values.forEach(function (value) {
+        var actual = getQueryResults("RETURN [ IS_DATESTRING(@value), DATE_TIMESTAMP(@value) ]", { value: value[0] });
+        assertEqual([ [ true, value[1] ] ], actual, value);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test date_timestamp function with invalid date strings
+////////////////////////////////////////////////////////////////////////////////
+
+    testDateTimestampInvalidFormats : function () {
+      var values = [
+        "2012-02-12T",
+        "2012-02-12T13",
+        "2012-02-12T13:2",
+        "2012-02-12T13:24:",
+        "2012-02-12T13:24:12.",
+        "2012-02-12TT13:24:12",
+        "2012-02-12T13:24:12+1",
+        "2012-02-12T13:24:12+24:00",
+        "2012-02-12T13:24:12+01:60",
+        "2012-02-12T13:24:12+01:00Z",
+        "2012-02-12T13:24:12+01:00:00",
+        "2012-02-12T13:24:12Zfoo",
+        "2012-02-12 13:24:12 Z",
+        "2012--02",
+        "201-02-12",
+        "002012-02-12",
+        "+2012-02-12",
+        "-2012-02-12",
+        "+275761-01-01",
+        "-275761-01-01",
+        "2012-02-12 13:24:12 foo"
+      ];
+
+      values.forEach(function (value) {
+        assertEqual([ false ], getQueryResults("RETURN IS_DATESTRING(@value)", { value: value }), value);
+        assertQueryWarningAndNull(errors.ERROR_QUERY_INVALID_DATE_VALUE.code, "RETURN DATE_TIMESTAMP(@value)", { value: value });
+      });
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test date_iso8601 function
 ////////////////////////////////////////////////////////////////////////////////
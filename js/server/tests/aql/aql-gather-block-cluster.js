@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false, maxlen: 500 */
-/*global assertEqual, assertTrue, AQL_EXPLAIN, AQL_EXECUTE */
+/*global assertEqual, assertTrue, assertFalse, AQL_EXPLAIN, AQL_EXECUTE */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tests for optimizer rules
@@ -358,6 +358,154 @@ function gatherBlockTestSuite () {
       var actual = AQL_EXECUTE(query).json;
 
       assertEqual(expected, actual, query);
+    },
+
+    testNonSimpleManyShards : function () {
+      var cn4 = "UnitTestsGatherBlock4";
+      db._drop(cn4);
+      var c4 = db._create(cn4, {numberOfShards:16});
+
+      try {
+        // the shards run out of buffered rows at different times while
+        // merging, as their values are unevenly distributed
+        var i, values = [ ];
+        for (i = 0; i < 5000; i++) {
+          values.push((i * 7919) % 3001);
+        }
+        values.forEach(function(v) {
+          c4.insert({ value: v });
+        });
+
+        var query = "FOR d IN " + cn4 + " SORT d.value RETURN d.value";
+        assertTrue(explain(AQL_EXPLAIN(query)).indexOf("GatherNode") !== -1, query);
+
+        var expected = values.sort(function(l, r) { return l - r; });
+        assertEqual(expected, AQL_EXECUTE(query).json, query);
+
+        query = "FOR d IN " + cn4 + " SORT d.value DESC LIMIT 1234, 2000 RETURN d.value";
+        assertEqual(expected.slice().reverse().slice(1234, 3234), AQL_EXECUTE(query).json, query);
+      }
+      finally {
+        db._drop(cn4);
+      }
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for prefetching remote results and gathering from the
+/// shards in parallel
+////////////////////////////////////////////////////////////////////////////////
+
+function remotePrefetchTestSuite () {
+  var cn = "UnitTestsRemotePrefetch";
+  var c;
+  // several batches per shard, so that there is a prefetch in flight
+  // whenever the coordinator stops reading from a shard
+  var n = 12000;
+
+  var explain = function (result) {
+    return helper.getCompactPlan(result).map(function(node) 
+        { return node.type; });
+  };
+
+  var range = function (from, to) {
+    var result = [ ];
+    for (var i = from; i < to; i++) {
+      result.push(i);
+    }
+    return result;
+  };
+
+  var sorted = function (values) {
+    return values.sort(function(l, r) { return l - r; });
+  };
+
+  // all remote queries of the test have been shut down and released their
+  // locks, so that the collection can be modified again
+  var assertNoLeftovers = function () {
+    assertEqual([ ], require("@arangodb/aql/queries").current().filter(function(q) {
+      return q.query.indexOf(cn) !== -1;
+    }));
+    assertEqual(n, c.count());
+    c.truncate();
+    assertEqual(0, c.count());
+  };
+
+  return {
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn, {numberOfShards:5});
+      db._query("FOR i IN 0.." + (n - 1) + " INSERT { value: i } INTO " + cn);
+    },
+
+    tearDown : function () {
+      db._drop(cn);
+      c = null;
+    },
+
+    testPrefetchAllShards : function () {
+      var query = "FOR d IN " + cn + " RETURN d.value";
+      assertTrue(explain(AQL_EXPLAIN(query)).indexOf("GatherNode") !== -1, query);
+
+      assertEqual(range(0, n), sorted(AQL_EXECUTE(query).json), query);
+
+      query = "FOR d IN " + cn + " FILTER d.value % 7 == 3 RETURN d.value";
+      assertEqual(range(0, n).filter(function(v) { return v % 7 === 3; }),
+                  sorted(AQL_EXECUTE(query).json), query);
+      assertNoLeftovers();
+    },
+
+    testPrefetchSorted : function () {
+      var query = "FOR d IN " + cn + " SORT d.value DESC RETURN d.value";
+      assertEqual(range(0, n).reverse(), AQL_EXECUTE(query).json, query);
+
+      query = "FOR d IN " + cn + " SORT d.value LIMIT 2995, 10 RETURN d.value";
+      assertEqual(range(2995, 3005), AQL_EXECUTE(query).json, query);
+      assertNoLeftovers();
+    },
+
+    testPrefetchLimit : function () {
+      [ [ 0, 1 ], [ 0, 10 ], [ 999, 2 ], [ 1000, 1000 ], [ 2500, 10 ], [ n - 5, 10 ] ].forEach(function(limit) {
+        var query = "FOR d IN " + cn + " LIMIT " + limit[0] + ", " + limit[1] + " RETURN d.value";
+        var actual = AQL_EXECUTE(query).json;
+        assertEqual(Math.min(limit[1], n - limit[0]), actual.length, query);
+
+        // no duplicates
+        var seen = { };
+        actual.forEach(function(v) {
+          assertFalse(seen.hasOwnProperty(v), query);
+          seen[v] = true;
+        });
+      });
+
+      var result = AQL_EXECUTE("FOR d IN " + cn + " LIMIT 10, 5 RETURN d.value", { }, { fullCount: true });
+      assertEqual(5, result.json.length);
+      assertEqual(n, result.stats.fullCount);
+      assertNoLeftovers();
+    },
+
+    testPrefetchEarlyTermination : function () {
+      // the coordinator stops reading while requests to the shards are
+      // still in flight. shutting down the query must wait for them
+      for (var i = 0; i < 20; i++) {
+        assertEqual(1, AQL_EXECUTE("FOR d IN " + cn + " LIMIT 1 RETURN d.value").json.length);
+        assertEqual([ 0 ], AQL_EXECUTE("FOR d IN " + cn + " SORT d.value LIMIT 1 RETURN d.value").json);
+      }
+      assertNoLeftovers();
+    },
+
+    testPrefetchSubquery : function () {
+      // the remote blocks are reinitialized for every iteration, while the
+      // prefetch of the previous one may still be in flight
+      var query = "FOR i IN 1..10 LET s = (FOR d IN " + cn + " FILTER d.value >= i LIMIT 3 RETURN d.value) RETURN LENGTH(s)";
+      assertEqual([ 3, 3, 3, 3, 3, 3, 3, 3, 3, 3 ], AQL_EXECUTE(query).json, query);
+
+      query = "FOR i IN 1..3 LET s = (FOR d IN " + cn + " FILTER d.value >= i SORT d.value LIMIT 2 RETURN d.value) RETURN s";
+      assertEqual([ [ 1, 2 ], [ 2, 3 ], [ 3, 4 ] ], AQL_EXECUTE(query).json, query);
+      assertNoLeftovers();
     }
 
   };
@@ -368,6 +516,7 @@ function gatherBlockTestSuite () {
 ////////////////////////////////////////////////////////////////////////////////
 
 jsunity.run(gatherBlockTestSuite);
+jsunity.run(remotePrefetchTestSuite);
 
 return jsunity.done();
 
@@ -1931,7 +1931,6 @@ function ahuacatlQueryGeneralTraversalTestSuite() {
       assertEqual(actual[0]["UnitTests_Leipziger/Gerda"].toFixed(2), (1).toFixed(2));
     },
 
-    /*
     testGRAPH_BETWEENNESS: function () {
       var actual;
 
@@ -1944,18 +1943,16 @@ function ahuacatlQueryGeneralTraversalTestSuite() {
       assertEqual(actual[0]["UnitTests_Hamburger/Dieter"], 16);
       assertEqual(actual[0]["UnitTests_Leipziger/Gerda"], 18);
 
-
       actual = getQueryResults("RETURN GRAPH_BETWEENNESS('werKenntWen', {algorithm : 'Floyd-Warshall'})");
 
       assertEqual(actual[0]["UnitTests_Berliner/Anton"], 0);
-      assertEqual(actual[0]["UnitTests_Berliner/Berta"].toFixed(2), 0.89);
-      assertEqual(actual[0]["UnitTests_Frankfurter/Emil"].toFixed(2), 0.56);
+      assertEqual(actual[0]["UnitTests_Berliner/Berta"].toFixed(2), (0.89).toFixed(2));
+      assertEqual(actual[0]["UnitTests_Frankfurter/Emil"].toFixed(2), (0.56).toFixed(2));
       assertEqual(actual[0]["UnitTests_Frankfurter/Fritz"], 0);
       assertEqual(actual[0]["UnitTests_Hamburger/Caesar"], 0);
-      assertEqual(actual[0]["UnitTests_Hamburger/Dieter"].toFixed(2), 0.89);
+      assertEqual(actual[0]["UnitTests_Hamburger/Dieter"].toFixed(2), (0.89).toFixed(2));
       assertEqual(actual[0]["UnitTests_Leipziger/Gerda"], 1);
 
-
       actual = getQueryResults("RETURN GRAPH_ABSOLUTE_BETWEENNESS('werKenntWen', {algorithm : 'Floyd-Warshall', direction : 'inbound'})");
       assertEqual(actual[0]["UnitTests_Berliner/Anton"], 0);
       assertEqual(actual[0]["UnitTests_Berliner/Berta"], 4);
@@ -1967,27 +1964,38 @@ function ahuacatlQueryGeneralTraversalTestSuite() {
 
       actual = getQueryResults("RETURN GRAPH_BETWEENNESS('werKenntWen', {algorithm : 'Floyd-Warshall', direction : 'inbound'})");
       assertEqual(actual[0]["UnitTests_Berliner/Anton"], 0);
-      assertEqual(actual[0]["UnitTests_Berliner/Berta"].toFixed(2), 0.67);
-      assertEqual(actual[0]["UnitTests_Frankfurter/Emil"].toFixed(2), 0.67);
+      assertEqual(actual[0]["UnitTests_Berliner/Berta"].toFixed(2), (0.67).toFixed(2));
+      assertEqual(actual[0]["UnitTests_Frankfurter/Emil"].toFixed(2), (0.67).toFixed(2));
       assertEqual(actual[0]["UnitTests_Frankfurter/Fritz"], 0);
       assertEqual(actual[0]["UnitTests_Hamburger/Caesar"], 0);
       assertEqual(actual[0]["UnitTests_Hamburger/Dieter"], 1);
       assertEqual(actual[0]["UnitTests_Leipziger/Gerda"], 1);
 
-
-
       actual = getQueryResults("RETURN GRAPH_BETWEENNESS('werKenntWen', {weight : 'entfernung', defaultWeight : 80, algorithm : 'Floyd-Warshall'})");
       assertEqual(actual[0]["UnitTests_Berliner/Anton"], 0);
       assertEqual(actual[0]["UnitTests_Berliner/Berta"], 1);
-      assertEqual(actual[0]["UnitTests_Frankfurter/Emil"].toFixed(2), 0.56);
+      assertEqual(actual[0]["UnitTests_Frankfurter/Emil"].toFixed(2), (0.56).toFixed(2));
       assertEqual(actual[0]["UnitTests_Frankfurter/Fritz"], 0);
       assertEqual(actual[0]["UnitTests_Hamburger/Caesar"], 0);
-      assertEqual(actual[0]["UnitTests_Hamburger/Dieter"].toFixed(2), 0.89);
+      assertEqual(actual[0]["UnitTests_Hamburger/Dieter"].toFixed(2), (0.89).toFixed(2));
       assertEqual(actual[0]["UnitTests_Leipziger/Gerda"], 1);
+    },
+
+    testGRAPH_BETWEENNESS_SAMPLES: function () {
+      var exact, actual;
 
+      exact = getQueryResults("RETURN GRAPH_ABSOLUTE_BETWEENNESS('werKenntWen')")[0];
 
+      // sampling all of the vertices is exact
+      actual = getQueryResults("RETURN GRAPH_ABSOLUTE_BETWEENNESS('werKenntWen', {samples : 7})")[0];
+      assertEqual(exact, actual);
+
+      actual = getQueryResults("RETURN GRAPH_ABSOLUTE_BETWEENNESS('werKenntWen', {samples : 3})")[0];
+      assertEqual(Object.keys(exact).sort(), Object.keys(actual).sort());
+      assertEqual(actual["UnitTests_Berliner/Anton"], 0);
+      assertEqual(actual["UnitTests_Frankfurter/Fritz"], 0);
+      assertEqual(actual["UnitTests_Hamburger/Caesar"], 0);
     },
-*/
 
     testGRAPH_DIAMETER_AND_RADIUS: function () {
       var actual;
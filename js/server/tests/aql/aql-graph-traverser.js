@@ -1,5 +1,5 @@
 /*jshint esnext: true */
-/*global assertEqual, fail, AQL_EXECUTE, AQL_EXPLAIN, AQL_EXECUTEJSON */
+/*global assertEqual, fail, AQL_EXECUTE, AQL_EXPLAIN, AQL_EXECUTEJSON, AQL_PARSE */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Spec for the AQL FOR x IN GRAPH name statement
@@ -1928,6 +1928,592 @@ function multiEdgeDirectionSuite () {
   };
 }
 
+function traversalOptionsSuite () {
+
+  var keys = function (query, bindVars) {
+    return db._query(query, bindVars).toArray();
+  };
+
+  return {
+
+    setUp: function () {
+      cleanup();
+      createBaseGraph();
+    },
+
+    tearDown: cleanup,
+
+    testDefaultUniqueness: function () {
+      // B is visited a second time via the cycle B -> C -> F -> E -> B
+      var query = `FOR x IN 1..5 OUTBOUND @start ${en} RETURN x._key`;
+      var bindVars = { start: vertex.A };
+      var expected = [ "B", "B", "C", "D", "E", "F" ];
+      assertEqual(expected, keys(query, bindVars).sort());
+
+      query = `FOR x IN 1..5 OUTBOUND @start ${en} OPTIONS { bfs: true } RETURN x._key`;
+      assertEqual(expected, keys(query, bindVars).sort());
+    },
+
+    testUniqueVerticesPath: function () {
+      var bindVars = { start: vertex.A };
+      var expected = [ "B", "C", "D", "E", "F" ];
+      [ "", ", bfs: true" ].forEach(function (bfs) {
+        var query = `FOR x IN 1..5 OUTBOUND @start ${en} OPTIONS { uniqueVertices: "path"${bfs} } RETURN x._key`;
+        assertEqual(expected, keys(query, bindVars).sort());
+      });
+    },
+
+    testUniqueEdgesNone: function () {
+      // without edge uniqueness the cycle is followed again
+      var query = `FOR x IN 6..6 OUTBOUND @start ${en} OPTIONS { uniqueEdges: "none" } RETURN x._key`;
+      var bindVars = { start: vertex.A };
+      assertEqual([ "C" ], keys(query, bindVars));
+
+      query = `FOR x IN 6..6 OUTBOUND @start ${en} RETURN x._key`;
+      assertEqual([ ], keys(query, bindVars));
+    },
+
+    testBreadthFirstOrder: function () {
+      var query = `FOR x, e, p IN 1..5 ANY @start ${en} OPTIONS { bfs: true } RETURN LENGTH(p.edges)`;
+      var result = keys(query, { start: vertex.A });
+      assertEqual(result.slice().sort(), result);
+      assertEqual(1, result[0]);
+      assertEqual(5, result[result.length - 1]);
+    },
+
+    testUniqueVerticesGlobal: function () {
+      var query = `FOR x, e, p IN 1..5 ANY @start ${en} OPTIONS { bfs: true, uniqueVertices: "global" } RETURN p.vertices[*]._key`;
+      var result = keys(query, { start: vertex.A });
+      // every vertex once, on one of its shortest paths
+      assertEqual([
+        [ "A", "B" ],
+        [ "A", "B", "C" ],
+        [ "A", "B", "E" ],
+        [ "A", "B", "C", "D" ],
+        [ "A", "B", "C", "F" ]
+      ], _.sortBy(result, function (p) { return p.length + p.join(); }));
+    },
+
+    testUniqueEdgesGlobal: function () {
+      // F is reached via two different edges, but B is not revisited via
+      // the edges AB and EB
+      var query = `FOR x IN 1..3 ANY @start ${en} OPTIONS { bfs: true, uniqueEdges: "global" } RETURN x._key`;
+      var bindVars = { start: vertex.A };
+      assertEqual([ "B", "C", "D", "E", "F", "F" ], keys(query, bindVars).sort());
+    },
+
+    testGlobalUniquenessWithFilter: function () {
+      var query = `FOR x, e, p IN 1..5 OUTBOUND @start ${en} OPTIONS { bfs: true, uniqueVertices: "global" } FILTER p.vertices[2]._key != "C" RETURN x._key`;
+      assertEqual([ "B" ], keys(query, { start: vertex.A }));
+    },
+
+    testGlobalUniquenessRequiresBfs: function () {
+      [ "uniqueVertices", "uniqueEdges" ].forEach(function (option) {
+        var query = `FOR x IN 1..5 OUTBOUND @start ${en} OPTIONS { ${option}: "global" } RETURN x`;
+        try {
+          keys(query, { start: vertex.A });
+          fail();
+        } catch (e) {
+          assertEqual(e.errorNum, errors.ERROR_QUERY_PARSE.code);
+        }
+      });
+    },
+
+    testInvalidUniqueness: function () {
+      var query = `FOR x IN 1..5 OUTBOUND @start ${en} OPTIONS { uniqueVertices: "foo" } RETURN x`;
+      try {
+        keys(query, { start: vertex.A });
+        fail();
+      } catch (e) {
+        assertEqual(e.errorNum, errors.ERROR_QUERY_PARSE.code);
+      }
+    },
+
+    testNonConstantOptions: function () {
+      var query = `FOR y IN [ true ] FOR x IN 1..5 OUTBOUND @start ${en} OPTIONS { bfs: y } RETURN x`;
+      try {
+        keys(query, { start: vertex.A });
+        fail();
+      } catch (e) {
+        assertEqual(e.errorNum, errors.ERROR_QUERY_COMPILE_TIME_OPTIONS.code);
+      }
+    },
+
+    testOptionsInPlan: function () {
+      var query = `FOR x IN 1..5 OUTBOUND @start ${en} OPTIONS { bfs: true, uniqueVertices: "global" } RETURN x`;
+      var plan = AQL_EXPLAIN(query, { start: vertex.A }).plan;
+      var nodes = plan.nodes.filter(function (node) {
+        return node.type === "TraversalNode";
+      });
+      assertEqual(1, nodes.length);
+      assertEqual({ bfs: true, uniqueVertices: "global", uniqueEdges: "path" }, nodes[0].options);
+    }
+
+  };
+}
+
+function shortestPathSuite () {
+
+  var query = function (q, bindVars) {
+    return db._query(q, bindVars).toArray();
+  };
+
+  return {
+
+    setUp: function () {
+      cleanup();
+      createBaseGraph();
+    },
+
+    tearDown: cleanup,
+
+    testShortestPathOutbound: function () {
+      var q = `FOR v, e IN OUTBOUND SHORTEST_PATH @start TO @target ${en} RETURN [ v._id, e === null ? null : e._id ]`;
+      assertEqual([
+        [ vertex.A, null ],
+        [ vertex.B, edge.AB ],
+        [ vertex.C, edge.BC ],
+        [ vertex.D, edge.CD ]
+      ], query(q, { start: vertex.A, target: vertex.D }));
+    },
+
+    testShortestPathDirections: function () {
+      var q = `FOR v IN OUTBOUND SHORTEST_PATH @start TO @target ${en} RETURN v._key`;
+      assertEqual([ ], query(q, { start: vertex.D, target: vertex.A }));
+
+      q = `FOR v IN INBOUND SHORTEST_PATH @start TO @target ${en} RETURN v._key`;
+      assertEqual([ "D", "C", "B", "A" ], query(q, { start: vertex.D, target: vertex.A }));
+
+      q = `FOR v IN ANY SHORTEST_PATH @start TO @target ${en} RETURN v._key`;
+      assertEqual([ "E", "B", "A" ], query(q, { start: vertex.E, target: vertex.A }));
+    },
+
+    testShortestPathStartIsTarget: function () {
+      var q = `FOR v, e IN OUTBOUND SHORTEST_PATH @start TO @start ${en} RETURN [ v._key, e ]`;
+      assertEqual([ [ "A", null ] ], query(q, { start: vertex.A }));
+    },
+
+    testShortestPathVariableInput: function () {
+      var q = `FOR s IN @starts FOR v IN OUTBOUND SHORTEST_PATH s TO DOCUMENT(@target) ${en} RETURN v._key`;
+      assertEqual([ "A", "B", "C", "D", "E", "B", "C", "D" ],
+                  query(q, { starts: [ vertex.A, vertex.E ], target: vertex.D }));
+    },
+
+    testShortestPathInvalidInput: function () {
+      var q = `FOR s IN [ 42 ] FOR v IN OUTBOUND SHORTEST_PATH s TO @target ${en} RETURN v`;
+      var result = AQL_EXECUTE(q, { target: vertex.D });
+      assertEqual([ ], result.json);
+      assertEqual(1, result.warnings.length);
+      assertEqual(errors.ERROR_BAD_PARAMETER.code, result.warnings[0].code);
+    },
+
+    testShortestPathWeighted: function () {
+      edge.AE = ec.save(vertex.A, vertex.E, { weight: 10 })._id;
+
+      var q = `FOR v IN OUTBOUND SHORTEST_PATH @start TO @target ${en} RETURN v._key`;
+      var bindVars = { start: vertex.A, target: vertex.E };
+      assertEqual([ "A", "E" ], query(q, bindVars));
+
+      q = `FOR v IN OUTBOUND SHORTEST_PATH @start TO @target ${en} OPTIONS { weightAttribute: "weight" } RETURN v._key`;
+      assertEqual([ "A", "B", "C", "F", "E" ], query(q, bindVars));
+
+      q = `FOR v IN OUTBOUND SHORTEST_PATH @start TO @target ${en} OPTIONS { weightAttribute: "weight", defaultWeight: 3 } RETURN v._key`;
+      assertEqual([ "A", "E" ], query(q, bindVars));
+    },
+
+    testShortestPathNamedGraph: function () {
+      var gn = "UnitTestShortestPathGraph";
+      try {
+        gm._drop(gn);
+      } catch (ignore) {
+      }
+      gm._create(gn, [ gm._relation(en, vn, vn) ]);
+      try {
+        var q = `FOR v IN OUTBOUND SHORTEST_PATH @start TO @target GRAPH @graph RETURN v._key`;
+        assertEqual([ "A", "B", "C", "F" ],
+                    query(q, { start: vertex.A, target: vertex.F, graph: gn }));
+      } finally {
+        gm._drop(gn);
+      }
+    },
+
+    testShortestPathExpectsTo: function () {
+      var q = `FOR v IN OUTBOUND SHORTEST_PATH @start FROM @target ${en} RETURN v`;
+      try {
+        query(q, { start: vertex.A, target: vertex.D });
+        fail();
+      } catch (e) {
+        assertEqual(e.errorNum, errors.ERROR_QUERY_PARSE.code);
+      }
+    },
+
+    testShortestPathNonConstantOptions: function () {
+      var q = `FOR y IN [ "weight" ] FOR v IN OUTBOUND SHORTEST_PATH @start TO @target ${en} OPTIONS { weightAttribute: y } RETURN v`;
+      try {
+        query(q, { start: vertex.A, target: vertex.D });
+        fail();
+      } catch (e) {
+        assertEqual(e.errorNum, errors.ERROR_QUERY_COMPILE_TIME_OPTIONS.code);
+      }
+    },
+
+    testShortestPathInPlan: function () {
+      var q = `FOR v IN OUTBOUND SHORTEST_PATH @start TO @target ${en} OPTIONS { weightAttribute: "weight" } RETURN v`;
+      var plan = AQL_EXPLAIN(q, { start: vertex.A, target: vertex.D }).plan;
+      var nodes = plan.nodes.filter(function (node) {
+        return node.type === "ShortestPathNode";
+      });
+      assertEqual(1, nodes.length);
+      assertEqual(vertex.A, nodes[0].startVertexId);
+      assertEqual(vertex.D, nodes[0].targetVertexId);
+      assertEqual({ weightAttribute: "weight", defaultWeight: 1 }, nodes[0].options);
+    },
+
+    testShortestPathKeywordAsName: function () {
+      // the function and attributes named like the keyword still parse
+      var nodes = AQL_PARSE(`RETURN SHORTEST_PATH(@@v, @@e, @start, @target, "outbound", { })`).ast[0].subNodes;
+      assertEqual("return", nodes[0].type);
+      assertEqual("function call", nodes[0].subNodes[0].type);
+      assertEqual("SHORTEST_PATH", nodes[0].subNodes[0].name);
+
+      nodes = AQL_PARSE(`FOR v IN OUTBOUND SHORTEST_PATH @start TO @target ${en} RETURN v`).ast[0].subNodes;
+      assertEqual("shortest path", nodes[0].type);
+
+      assertEqual([ 1 ], query(`RETURN { shortest_path: 1 }.shortest_path`));
+      assertEqual([ "A" ], query(`FOR v IN OUTBOUND SHORTEST_PATH @start TO @start ${en} RETURN { SHORTEST_PATH: v._key }.SHORTEST_PATH`,
+                                 { start: vertex.A }));
+    }
+
+  };
+}
+
+function kShortestPathsSuite () {
+
+  var query = function (q, bindVars) {
+    return db._query(q, bindVars).toArray();
+  };
+
+  return {
+
+    setUp: function () {
+      cleanup();
+      createBaseGraph();
+    },
+
+    tearDown: cleanup,
+
+    testKShortestPathsSinglePath: function () {
+      var q = `FOR p IN OUTBOUND K_SHORTEST_PATHS @start TO @target ${en} RETURN p`;
+      var result = query(q, { start: vertex.A, target: vertex.D });
+      assertEqual(1, result.length);
+      assertEqual([ vertex.A, vertex.B, vertex.C, vertex.D ], result[0].vertices.map(function (v) { return v._id; }));
+      assertEqual([ edge.AB, edge.BC, edge.CD ], result[0].edges.map(function (e) { return e._id; }));
+      assertEqual(3, result[0].weight);
+    },
+
+    testKShortestPathsAny: function () {
+      var q = `FOR p IN ANY K_SHORTEST_PATHS @start TO @target ${en} RETURN p.vertices[*]._key`;
+      assertEqual([ [ "A", "B", "E" ], [ "A", "B", "C", "F", "E" ] ],
+                  query(q, { start: vertex.A, target: vertex.E }));
+    },
+
+    testKShortestPathsNoPath: function () {
+      var q = `FOR p IN OUTBOUND K_SHORTEST_PATHS @start TO @target ${en} RETURN p`;
+      assertEqual([ ], query(q, { start: vertex.D, target: vertex.A }));
+    },
+
+    testKShortestPathsStartIsTarget: function () {
+      var q = `FOR p IN OUTBOUND K_SHORTEST_PATHS @start TO @start ${en} RETURN [ p.vertices[*]._key, p.edges, p.weight ]`;
+      assertEqual([ [ [ "A" ], [ ], 0 ] ], query(q, { start: vertex.A }));
+    },
+
+    testKShortestPathsWeighted: function () {
+      edge.AE = ec.save(vertex.A, vertex.E, { weight: 10 })._id;
+
+      var q = `FOR p IN OUTBOUND K_SHORTEST_PATHS @start TO @target ${en} OPTIONS { weightAttribute: "weight" } RETURN [ p.vertices[*]._key, p.weight ]`;
+      assertEqual([ [ [ "A", "B", "C", "F", "E" ], 4 ], [ [ "A", "E" ], 10 ] ],
+                  query(q, { start: vertex.A, target: vertex.E }));
+    },
+
+    testKShortestPathsLimit: function () {
+      edge.AE = ec.save(vertex.A, vertex.E, { weight: 10 })._id;
+
+      var q = `FOR p IN ANY K_SHORTEST_PATHS @start TO @target ${en} OPTIONS { weightAttribute: "weight" } LIMIT 2 RETURN p.weight`;
+      var result = query(q, { start: vertex.A, target: vertex.E });
+      assertEqual([ 2, 4 ], result);
+    },
+
+    testKShortestPathsParallelEdges: function () {
+      var second = ec.save(vertex.A, vertex.B, { })._id;
+
+      var q = `FOR p IN OUTBOUND K_SHORTEST_PATHS @start TO @target ${en} RETURN p.edges[0]._id`;
+      var result = query(q, { start: vertex.A, target: vertex.D });
+      assertEqual([ edge.AB, second ].sort(), result.sort());
+    },
+
+    testKShortestPathsInPlan: function () {
+      var q = `FOR p IN OUTBOUND K_SHORTEST_PATHS @start TO @target ${en} RETURN p`;
+      var plan = AQL_EXPLAIN(q, { start: vertex.A, target: vertex.D }).plan;
+      var nodes = plan.nodes.filter(function (node) {
+        return node.type === "ShortestPathNode";
+      });
+      assertEqual(1, nodes.length);
+      assertEqual("p", nodes[0].pathOutVariable.name);
+      assertFalse(nodes[0].hasOwnProperty("vertexOutVariable"));
+    },
+
+    testKShortestPathsKeywordAsName: function () {
+      var nodes = AQL_PARSE(`FOR p IN OUTBOUND K_SHORTEST_PATHS @start TO @target ${en} RETURN p`).ast[0].subNodes;
+      assertEqual("k shortest paths", nodes[0].type);
+
+      var q = `FOR p IN OUTBOUND K_SHORTEST_PATHS @start TO @target ${en} RETURN { k_shortest_paths: p.weight }.k_shortest_paths`;
+      assertEqual([ 3 ], query(q, { start: vertex.A, target: vertex.D }));
+    }
+
+  };
+}
+
+function parallelTraversalSuite () {
+
+  var serial = { maxParallelism: 1 };
+  var parallel = { maxParallelism: 4 };
+
+  var compare = function (q, bindVars) {
+    var expected = AQL_EXECUTE(q, bindVars, serial);
+    var actual = AQL_EXECUTE(q, bindVars, parallel);
+    assertEqual(expected.json, actual.json);
+    assertEqual(expected.warnings, actual.warnings);
+    assertEqual(expected.stats.scannedIndex, actual.stats.scannedIndex);
+    return actual;
+  };
+
+  return {
+
+    setUp: function () {
+      cleanup();
+      createBaseGraph();
+    },
+
+    tearDown: cleanup,
+
+    testParallelTraversalKeepsOrder: function () {
+      var q = `FOR i IN 1..100 FOR s IN @starts FOR v, e, p IN 1..3 ANY s ${en} RETURN [ i, s, v._key, e._key, p.vertices[*]._key ]`;
+      var result = compare(q, { starts: Object.keys(vertex).map(function (k) { return vertex[k]; }) });
+      assertTrue(result.json.length > 0);
+    },
+
+    testParallelTraversalDocumentInput: function () {
+      var q = `FOR s IN ${vn} SORT s._key FOR v IN 1..2 OUTBOUND s ${en} RETURN [ s._key, v._key ]`;
+      compare(q, { });
+    },
+
+    testParallelTraversalInvalidInput: function () {
+      var q = `FOR s IN [ @A, 42, { }, "UnitTestVertexCollection/unknown", @B ] FOR v IN 1..2 OUTBOUND s ${en} RETURN [ s, v._key ]`;
+      var result = compare(q, { A: vertex.A, B: vertex.B });
+      assertEqual(1, result.warnings.length);
+      assertEqual(errors.ERROR_BAD_PARAMETER.code, result.warnings[0].code);
+    },
+
+    testParallelTraversalFilter: function () {
+      var q = `FOR s IN @starts FOR v, e, p IN 1..3 OUTBOUND s ${en} FILTER p.vertices[1]._key != "C" RETURN [ s, v._key ]`;
+      compare(q, { starts: [ vertex.A, vertex.B, vertex.E, vertex.F ] });
+    },
+
+    testParallelTraversalBreadthFirst: function () {
+      var q = `FOR s IN @starts FOR v IN 1..3 ANY s ${en} OPTIONS { bfs: true, uniqueVertices: "global" } RETURN [ s, v._key ]`;
+      compare(q, { starts: [ vertex.A, vertex.C, vertex.E ] });
+    },
+
+    testParallelTraversalLimit: function () {
+      var q = `FOR i IN 1..100 FOR v IN 1..3 OUTBOUND @start ${en} LIMIT 150, 20 RETURN [ i, v._key ]`;
+      compare(q, { start: vertex.A });
+
+      q = `FOR s IN @starts FOR v IN 1..3 OUTBOUND s ${en} LIMIT 3, 5 RETURN [ s, v._key ]`;
+      compare(q, { starts: [ vertex.A, vertex.B, vertex.C, vertex.E ] });
+    },
+
+    testParallelTraversalManyPathsLimit: function () {
+      // the hub has more paths than a worker buffers for one row
+      var hub = vc.save({_key: "hub"})._id;
+      for (var i = 0; i < 1500; ++i) {
+        ec.save(hub, vc.save({_key: "leaf" + i, value: i})._id, {});
+      }
+      var starts = [ vertex.A, hub, vertex.B, hub, vertex.C ];
+
+      var q = `FOR s IN @starts FOR v IN 1 OUTBOUND s ${en} RETURN [ s, v._key ]`;
+      var result = compare(q, { starts: starts });
+      assertEqual(3000 + 3, result.json.length);
+
+      q = `FOR s IN @starts FOR v IN 1 OUTBOUND s ${en} LIMIT 1400, 10 RETURN [ s, v._key ]`;
+      result = compare(q, { starts: starts });
+      assertEqual(10, result.json.length);
+
+      q = `FOR s IN @starts FOR v IN 1 OUTBOUND s ${en} LIMIT 2 RETURN [ s, v._key ]`;
+      result = compare(q, { starts: starts });
+      assertEqual(2, result.json.length);
+    },
+
+    testParallelTraversalMemoryLimit: function () {
+      // the buffered paths are charged to the query
+      var hub = vc.save({_key: "hub"})._id;
+      var padding = Array(201).join("x");
+      for (var i = 0; i < 500; ++i) {
+        ec.save(hub, vc.save({_key: "leaf" + i, padding: padding})._id, {});
+      }
+      var q = `FOR s IN @starts FOR v IN 1 OUTBOUND s ${en} RETURN v`;
+      try {
+        AQL_EXECUTE(q, { starts: [ hub, hub, hub, hub ] },
+                    { maxParallelism: 4, memoryLimit: 100 * 1000 });
+        fail();
+      } catch (e) {
+        assertEqual(errors.ERROR_RESOURCE_LIMIT.code, e.errorNum);
+      }
+    }
+
+  };
+}
+
+function levelFetchingSuite () {
+
+  /***********************************************************************
+   * Graph under test:
+   *
+   *  A -> B -> X -> Y
+   *  |         /|\
+   *   ---------
+   *
+   * X is reached at depth 1 and at depth 2, so filters on different
+   * depths decide differently about it. In a cluster the vertices and
+   * edges fetched for one depth are reused for the others.
+   ***********************************************************************/
+
+  var paths = function (query, bindVars) {
+    return db._query(query, bindVars).toArray().map(function (p) {
+      return p.join(",");
+    }).sort();
+  };
+
+  return {
+
+    setUp: function () {
+      cleanup();
+      vc = db._create(vn, {numberOfShards: 4});
+      ec = db._createEdgeCollection(en, {numberOfShards: 4});
+
+      vertex.A = vc.save({_key: "A"})._id;
+      vertex.B = vc.save({_key: "B"})._id;
+      vertex.X = vc.save({_key: "X"})._id;
+      vertex.Y = vc.save({_key: "Y"})._id;
+
+      ec.save(vertex.A, vertex.B, {});
+      ec.save(vertex.A, vertex.X, {});
+      ec.save(vertex.B, vertex.X, {});
+      ec.save(vertex.X, vertex.Y, {});
+    },
+
+    tearDown: cleanup,
+
+    testFilterVertexOnDepth1: function () {
+      var q = `FOR v, e, p IN 1..3 OUTBOUND @start ${en}
+        FILTER p.vertices[1]._key != "X"
+        RETURN p.vertices[*]._key`;
+      assertEqual(["A,B", "A,B,X", "A,B,X,Y"], paths(q, { start: vertex.A }));
+    },
+
+    testFilterVertexOnDepth2: function () {
+      var q = `FOR v, e, p IN 1..3 OUTBOUND @start ${en}
+        FILTER p.vertices[2]._key != "X"
+        RETURN p.vertices[*]._key`;
+      assertEqual(["A,B", "A,X", "A,X,Y"], paths(q, { start: vertex.A }));
+    },
+
+    testFilterVertexOnDifferentDepths: function () {
+      var q = `FOR v, e, p IN 1..3 OUTBOUND @start ${en}
+        FILTER p.vertices[1]._key != "B"
+        FILTER p.vertices[2]._key == "Y"
+        RETURN p.vertices[*]._key`;
+      assertEqual(["A,X,Y"], paths(q, { start: vertex.A }));
+    },
+
+    testFilterEdgeOnDepth: function () {
+      var q = `FOR v, e, p IN 1..3 OUTBOUND @start ${en}
+        FILTER p.edges[0]._to != @X
+        RETURN p.vertices[*]._key`;
+      assertEqual(["A,B", "A,B,X", "A,B,X,Y"], paths(q, { start: vertex.A, X: vertex.X }));
+
+      q = `FOR v, e, p IN 1..3 OUTBOUND @start ${en}
+        FILTER p.edges[1]._to != @X
+        RETURN p.vertices[*]._key`;
+      assertEqual(["A,B", "A,X", "A,X,Y"], paths(q, { start: vertex.A, X: vertex.X }));
+    },
+
+    testFilterSeveralStartVertices: function () {
+      // X is rejected at depth 2 for A, but has to be found at depth 1 for B
+      var q = `FOR s IN @starts FOR v, e, p IN 1..2 OUTBOUND s ${en}
+        FILTER p.vertices[2]._key != "X"
+        RETURN p.vertices[*]._key`;
+      assertEqual(["A,B", "A,X", "A,X,Y", "B,X", "B,X,Y"],
+                  paths(q, { starts: [ vertex.A, vertex.B ] }));
+
+      // and the other way round
+      q = `FOR s IN @starts FOR v, e, p IN 1..2 OUTBOUND s ${en}
+        FILTER p.vertices[1]._key != "X"
+        RETURN p.vertices[*]._key`;
+      assertEqual(["A,B", "A,B,X"],
+                  paths(q, { starts: [ vertex.A, vertex.B ] }));
+    },
+
+    testAnyDirection: function () {
+      // the edge B - X is found for both vertices of depth 1
+      var q = `FOR v, e, p IN 1..2 ANY @start ${en}
+        RETURN p.vertices[*]._key`;
+      assertEqual(["A,B", "A,B,X", "A,X", "A,X,B", "A,X,Y"],
+                  paths(q, { start: vertex.A }));
+
+      q = `FOR v, e, p IN 1..2 ANY @start ${en}
+        FILTER p.vertices[1]._key != "B"
+        RETURN p.vertices[*]._key`;
+      assertEqual(["A,X", "A,X,B", "A,X,Y"], paths(q, { start: vertex.A }));
+    },
+
+    testMinMaxDepth: function () {
+      var check = function (min, max, expected) {
+        var q = `FOR v, e, p IN ${min}..${max} OUTBOUND @start ${en}
+          RETURN p.vertices[*]._key`;
+        assertEqual(expected, paths(q, { start: vertex.A }), q);
+      };
+      check(0, 0, ["A"]);
+      check(0, 1, ["A", "A,B", "A,X"]);
+      check(2, 2, ["A,B,X", "A,X,Y"]);
+      check(2, 3, ["A,B,X", "A,B,X,Y", "A,X,Y"]);
+      check(3, 3, ["A,B,X,Y"]);
+      check(4, 10, []);
+    },
+
+    testManyVerticesOnOneDepth: function () {
+      // more vertices on depth 1 than the edges of are fetched together
+      var hub = vc.save({_key: "hub"})._id;
+      var target = vc.save({_key: "target"})._id;
+      var i, leaf;
+      for (i = 0; i < 1500; ++i) {
+        leaf = vc.save({_key: "leaf" + i, value: i})._id;
+        ec.save(hub, leaf, {});
+        ec.save(leaf, target, {});
+      }
+
+      var q = `FOR v, e, p IN 2..2 OUTBOUND @start ${en}
+        FILTER p.vertices[1].value % 3 == 0
+        COLLECT key = v._key WITH COUNT INTO n
+        RETURN [ key, n ]`;
+      assertEqual([ [ "target", 500 ] ], db._query(q, { start: hub }).toArray());
+
+      q = `FOR v IN 1..2 OUTBOUND @start ${en} LIMIT 5 RETURN v`;
+      assertEqual(5, db._query(q, { start: hub }).toArray().length);
+    }
+
+  };
+}
+
 jsunity.run(namedGraphSuite);
 jsunity.run(multiCollectionGraphSuite);
 jsunity.run(multiEdgeCollectionGraphSuite);
@@ -1936,5 +2522,12 @@ jsunity.run(complexInternaSuite);
 jsunity.run(complexFilteringSuite);
 jsunity.run(brokenGraphSuite);
 jsunity.run(multiEdgeDirectionSuite);
+jsunity.run(levelFetchingSuite);
+if (!isCluster) {
+  jsunity.run(traversalOptionsSuite);
+  jsunity.run(shortestPathSuite);
+  jsunity.run(kShortestPathsSuite);
+  jsunity.run(parallelTraversalSuite);
+}
 
 return jsunity.done();
@@ -0,0 +1,175 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for index lookups that are done for whole blocks
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+
+var jsunity = require("jsunity");
+var db = require("@arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function indexBatchLookupTestSuite () {
+  var c1, c2, e;
+  var noIndexes = { optimizer: { rules: [ "-use-indexes", "-use-hash-join" ] } };
+
+  var sorted = function (values) {
+    return values.map(function(value) {
+      return JSON.stringify(value);
+    }).sort();
+  };
+
+  var runQuery = function (query) {
+    var nodes = AQL_EXPLAIN(query).plan.nodes.map(function(node) {
+      return node.type;
+    });
+    assertNotEqual(-1, nodes.indexOf("IndexNode"), query);
+
+    var expected = AQL_EXECUTE(query, { }, noIndexes).json;
+    var actual = AQL_EXECUTE(query).json;
+    assertEqual(sorted(expected), sorted(actual), query);
+    return actual;
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection1");
+      db._drop("UnitTestsCollection2");
+      db._drop("UnitTestsEdges");
+      c1 = db._create("UnitTestsCollection1");
+      c2 = db._create("UnitTestsCollection2");
+      e = db._createEdgeCollection("UnitTestsEdges");
+
+      var i;
+      for (i = 0; i < 200; ++i) {
+        c1.save({ _key: "test" + i, value: i, unique: "u" + i, multi: i % 13 });
+      }
+      // outer values with many duplicates, nulls and missing attributes
+      for (i = 0; i < 3000; ++i) {
+        if (i % 100 === 0) {
+          c2.save({ nr: i });
+        }
+        else if (i % 100 === 1) {
+          c2.save({ nr: i, ref: null, key: null });
+        }
+        else {
+          c2.save({ nr: i, ref: i % 250, key: "test" + (i % 250), id: c1.name() + "/test" + (i % 250) });
+        }
+      }
+      for (i = 0; i < 400; ++i) {
+        e.save(c1.name() + "/test" + (i % 50), c1.name() + "/test" + (i % 7), { nr: i });
+      }
+
+      c1.ensureIndex({ type: "hash", fields: [ "unique" ], unique: true });
+      c1.ensureIndex({ type: "hash", fields: [ "multi" ] });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection1");
+      db._drop("UnitTestsCollection2");
+      db._drop("UnitTestsEdges");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test lookups in the primary index
+////////////////////////////////////////////////////////////////////////////////
+
+    testPrimaryIndex : function () {
+      var actual = runQuery("FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a._key == b.key RETURN [ a.value, b.nr ]");
+      var expected = 0;
+      for (var i = 0; i < 3000; ++i) {
+        if (i % 100 > 1 && i % 250 < 200) {
+          ++expected;
+        }
+      }
+      assertEqual(expected, actual.length);
+
+      runQuery("FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a._id == b.id RETURN [ a.value, b.nr ]");
+      runQuery("FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER b.key == a._key RETURN [ a.value, b.nr ]");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test lookups in a unique hash index
+////////////////////////////////////////////////////////////////////////////////
+
+    testUniqueHashIndex : function () {
+      runQuery("FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.unique == CONCAT('u', b.ref) RETURN [ a.value, b.nr ]");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test lookups in a non-unique hash index
+////////////////////////////////////////////////////////////////////////////////
+
+    testMultiHashIndex : function () {
+      runQuery("FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.multi == b.ref RETURN [ a.value, b.nr ]");
+      runQuery("FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.multi == b.ref % 13 RETURN [ a.value, b.nr ]");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test lookups in the edge index
+////////////////////////////////////////////////////////////////////////////////
+
+    testEdgeIndex : function () {
+      runQuery("FOR a IN " + c1.name() + " FOR x IN " + e.name() + " FILTER x._from == a._id RETURN [ a.value, x.nr ]");
+      runQuery("FOR a IN " + c1.name() + " FOR x IN " + e.name() + " FILTER x._to == a._id RETURN [ a.value, x.nr ]");
+      runQuery("FOR b IN " + c2.name() + " FOR x IN " + e.name() + " FILTER x._from == b.id RETURN [ b.nr, x.nr ]");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test skipping and limits
+////////////////////////////////////////////////////////////////////////////////
+
+    testLimit : function () {
+      var query = "FOR b IN " + c2.name() + " SORT b.nr FOR a IN " + c1.name() + " FILTER a.multi == b.ref % 13 LIMIT 1000, 50 RETURN [ b.nr, a.value ]";
+      var expected = AQL_EXECUTE(query, { }, noIndexes).json;
+      var actual = AQL_EXECUTE(query).json;
+      assertEqual(50, actual.length);
+      assertEqual(sorted(expected), sorted(actual));
+
+      query = "FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.multi == b.ref % 13 COLLECT WITH COUNT INTO n RETURN n";
+      assertEqual(AQL_EXECUTE(query, { }, noIndexes).json, AQL_EXECUTE(query).json);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(indexBatchLookupTestSuite);
+
+return jsunity.done();
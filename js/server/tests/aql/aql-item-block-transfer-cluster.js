@@ -0,0 +1,160 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for the transfer of AqlItemBlocks between cluster nodes
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Copyright 2016, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var db = require("@arangodb").db;
+var jsunity = require("jsunity");
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function itemBlockTransferTestSuite () {
+  var cn1 = "UnitTestsItemBlockTransfer1";
+  var cn2 = "UnitTestsItemBlockTransfer2";
+  var c1, c2;
+
+  // runs a query with AqlItemBlocks transferred in VelocyPack and in JSON,
+  // the results must be the same
+  var compare = function (query, expected) {
+    var json = AQL_EXECUTE(query, { }, { transferVelocyPack: false }).json;
+    var vpack = AQL_EXECUTE(query, { }, { transferVelocyPack: true }).json;
+    assertEqual(json, vpack, query);
+    if (expected !== undefined) {
+      assertEqual(expected, vpack, query);
+    }
+    return vpack;
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn1);
+      db._drop(cn2);
+      c1 = db._create(cn1, { numberOfShards: 3 });
+      c2 = db._create(cn2, { numberOfShards: 2 });
+
+      for (var i = 0; i < 2500; ++i) {
+        c1.save({ _key: "test" + i, value: i, group: i % 7, text: "täxt" + i, sub: { a: [ i, null, true ] } });
+      }
+      for (i = 0; i < 10; ++i) {
+        c2.save({ _key: "test" + i, value: i });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn1);
+      db._drop(cn2);
+      c1 = null;
+      c2 = null;
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief documents, which are shaped values on the DB servers
+////////////////////////////////////////////////////////////////////////////////
+
+    testTransferShaped : function () {
+      var result = compare("FOR d IN " + cn1 + " SORT d.value RETURN d");
+      assertEqual(2500, result.length);
+      assertEqual("test1234", result[1234]._key);
+      assertEqual({ a: [ 1234, null, true ] }, result[1234].sub);
+      assertEqual("täxt1234", result[1234].text);
+
+      compare("FOR d IN " + cn1 + " FILTER d.group == 3 RETURN d.sub");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief values calculated on the DB servers
+////////////////////////////////////////////////////////////////////////////////
+
+    testTransferJson : function () {
+      compare("FOR d IN " + cn1 + " LET x = { v: d.value * 1.5, s: CONCAT(d.text, '-'), l: [ d.group, null, false ], e: { } } SORT d.value RETURN x");
+      compare("FOR d IN " + cn1 + " FILTER d.value < 10 SORT d.value RETURN [ d.value, -d.value, d.value / 3, 1e300 * d.value ]",
+              [ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 ].map(function (v) { return [ v, -v, v / 3, 1e300 * v ]; }));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ranges
+////////////////////////////////////////////////////////////////////////////////
+
+    testTransferRange : function () {
+      compare("FOR d IN " + cn1 + " FILTER d.value < 5 LET r = d.value .. (d.value + 3) SORT d.value RETURN r",
+              [ [ 0, 1, 2, 3 ], [ 1, 2, 3, 4 ], [ 2, 3, 4, 5 ], [ 3, 4, 5, 6 ], [ 4, 5, 6, 7 ] ]);
+
+      // the range is sent to the DB servers with the rows of the outer loop
+      compare("LET r = 3..5 FOR i IN r LET s = (FOR d IN " + cn2 + " FILTER d.value == i RETURN [ d.value, r ]) RETURN s",
+              [ [ [ 3, [ 3, 4, 5 ] ] ], [ [ 4, [ 3, 4, 5 ] ] ], [ [ 5, [ 3, 4, 5 ] ] ] ]);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief subquery results and groups
+////////////////////////////////////////////////////////////////////////////////
+
+    testTransferDocvec : function () {
+      compare("FOR d IN " + cn2 + " LET s = (FOR i IN 1..3 RETURN d.value * i) SORT d.value RETURN s",
+              [ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 ].map(function (v) { return [ v, 2 * v, 3 * v ]; }));
+
+      var result = compare("FOR d IN " + cn1 + " COLLECT g = d.group INTO docs RETURN [ g, LENGTH(docs), docs[0].d.group ]");
+      assertEqual(7, result.length);
+      result.forEach(function (r) {
+        assertEqual(r[0], r[2]);
+        assertTrue(r[1] >= 357);
+      });
+
+      // documents of the outer loop are sent to the DB servers with the rows
+      compare("FOR x IN " + cn2 + " SORT x.value LET s = (FOR d IN " + cn1 + " FILTER d.value == x.value RETURN [ d._key, x._key ]) RETURN s",
+              [ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 ].map(function (v) { return [ [ "test" + v, "test" + v ] ]; }));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief empty registers and large results
+////////////////////////////////////////////////////////////////////////////////
+
+    testTransferMixed : function () {
+      compare("FOR d IN " + cn1 + " LET x = d.group == 0 ? d : (d.group == 1 ? d.value .. (d.value + 1) : (d.group == 2 ? null : d.text)) SORT d.value RETURN x");
+      compare("FOR d IN " + cn1 + " SORT d.value LIMIT 1000, 1200 RETURN d._key");
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(itemBlockTransferTestSuite);
+
+return jsunity.done();
@@ -0,0 +1,101 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, fail, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for query memory accounting and memory limits
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+var errors = internal.errors;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function memoryLimitTestSuite () {
+  var assertResourceLimit = function (query, options) {
+    try {
+      AQL_EXECUTE(query, { }, options);
+      fail();
+    }
+    catch (e) {
+      assertEqual(errors.ERROR_RESOURCE_LIMIT.code, e.errorNum, query);
+    }
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the peak memory usage is reported
+////////////////////////////////////////////////////////////////////////////////
+
+    testPeakMemoryUsage : function () {
+      var small = AQL_EXECUTE("FOR i IN 1..10 RETURN i");
+      var large = AQL_EXECUTE("FOR i IN 1..10000 SORT i DESC RETURN CONCAT('test', i)");
+
+      assertTrue(small.stats.peakMemoryUsage > 0);
+      assertTrue(large.stats.peakMemoryUsage > small.stats.peakMemoryUsage);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that queries within the limit succeed
+////////////////////////////////////////////////////////////////////////////////
+
+    testWithinLimit : function () {
+      var result = AQL_EXECUTE("FOR i IN 1..100 RETURN i", { }, { memoryLimit: 10 * 1000 * 1000 });
+      assertEqual(100, result.json.length);
+      assertTrue(result.stats.peakMemoryUsage <= 10 * 1000 * 1000);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that queries exceeding the limit fail
+////////////////////////////////////////////////////////////////////////////////
+
+    testExceedLimit : function () {
+      var options = { memoryLimit: 100 * 1000 };
+
+      assertResourceLimit("FOR i IN 1..100000 SORT i DESC RETURN i", options);
+      assertResourceLimit("FOR i IN 1..100000 COLLECT g = i RETURN g", options);
+      assertResourceLimit("LET values = (FOR i IN 1..100000 RETURN CONCAT('test', i)) RETURN LENGTH(values)", options);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the limit is not applied if turned off
+////////////////////////////////////////////////////////////////////////////////
+
+    testNoLimit : function () {
+      var result = AQL_EXECUTE("FOR i IN 1..100000 SORT i DESC LIMIT 1 RETURN i", { }, { memoryLimit: 0 });
+      assertEqual([ 100000 ], result.json);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(memoryLimitTestSuite);
+
+return jsunity.done();
@@ -341,6 +341,40 @@ function optimizerCollectMethodsTestSuite () {
 
       assertEqual([ 1, 2, 3, 4 ], result[0]);
       assertEqual([ 2, 3, 4, 5, 6 ], result[1]);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test hashed collect with spilling to disk
+////////////////////////////////////////////////////////////////////////////////
+
+    testHashedSpill : function () {
+      var queries = [
+        "FOR i IN 1..5000 COLLECT v = i % 1777 OPTIONS { method: 'hash' } RETURN v",
+        "FOR i IN 1..5000 COLLECT v = i % 1777 WITH COUNT INTO l OPTIONS { method: 'hash' } RETURN [ v, l ]",
+        "FOR i IN 1..5000 COLLECT v = i % 1777, w = CONCAT('x', i % 3) AGGREGATE s = SUM(i), m = MAX(i), a = AVERAGE(i), l = LENGTH(i) OPTIONS { method: 'hash' } RETURN [ v, w, s, m, a, l ]",
+        "FOR j IN " + c.name() + " COLLECT g = j.group, v = j.value % 700 AGGREGATE m = MIN(j.value) OPTIONS { method: 'hash' } RETURN [ g, v, m ]",
+        "FOR j IN " + c.name() + " COLLECT doc = j WITH COUNT INTO l OPTIONS { method: 'hash' } RETURN [ doc.value, l ]"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query).json;
+        [ 1, 17, 1000, 1776, 1777 ].forEach(function(threshold) {
+          var actual = AQL_EXECUTE(query, { }, { collectSpillThreshold: threshold }).json;
+          assertEqual(expected, actual, query);
+        });
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test hashed collect with spilling to disk inside a subquery
+////////////////////////////////////////////////////////////////////////////////
+
+    testHashedSpillSubquery : function () {
+      var query = "FOR j IN 1..3 LET s = (FOR i IN 1..2500 COLLECT v = (i * j) % 997 WITH COUNT INTO l OPTIONS { method: 'hash' } RETURN [ v, l ]) RETURN s";
+      var expected = AQL_EXECUTE(query).json;
+      var actual = AQL_EXECUTE(query, { }, { collectSpillThreshold: 100 }).json;
+      assertEqual(3, actual.length);
+      assertEqual(expected, actual);
     }
 
   };
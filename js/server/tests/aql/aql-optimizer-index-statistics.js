@@ -0,0 +1,179 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, fail, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for cost estimation with skiplist index statistics
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+var db = require("@arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerIndexStatisticsTestSuite () {
+  var c;
+
+  var getIndexNodes = function (query) {
+    return AQL_EXPLAIN(query).plan.nodes.filter(function(node) {
+      return node.type === "IndexNode";
+    });
+  };
+
+  // the statistics are built by the cleanup thread in the background
+  var waitForStatistics = function () {
+    for (var i = 0; i < 600; ++i) {
+      var indexes = c.getIndexes(true).filter(function(idx) {
+        return idx.type === "skiplist";
+      });
+
+      if (indexes.every(function(idx) {
+            return idx.figures.statistics !== undefined &&
+                   idx.figures.statistics.items === 1000;
+          })) {
+        return;
+      }
+
+      internal.wait(0.1);
+    }
+
+    fail();
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      // "skewed" is 0 for 900 documents, "uniform" is unique
+      db._query("FOR i IN 0..999 INSERT { skewed: i < 900 ? 0 : i - 899, uniform: i } INTO " + c.name());
+
+      c.ensureIndex({ type: "skiplist", fields: [ "skewed" ] });
+      c.ensureIndex({ type: "skiplist", fields: [ "uniform" ] });
+
+      waitForStatistics();
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the statistics figures
+////////////////////////////////////////////////////////////////////////////////
+
+    testFigures : function () {
+      var indexes = c.getIndexes(true).filter(function(idx) {
+        return idx.type === "skiplist";
+      });
+
+      assertEqual(2, indexes.length);
+      indexes.forEach(function(idx) {
+        assertEqual(1000, idx.figures.statistics.items);
+        assertEqual(64, idx.figures.statistics.buckets);
+        if (idx.fields[0] === "skewed") {
+          assertEqual(101, idx.figures.statistics.distinctValues);
+        }
+        else {
+          assertEqual(1000, idx.figures.statistics.distinctValues);
+        }
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test equality estimates on skewed values
+////////////////////////////////////////////////////////////////////////////////
+
+    testEqualityEstimates : function () {
+      var nodes = getIndexNodes("FOR doc IN " + c.name() + " FILTER doc.skewed == 0 RETURN doc");
+      assertEqual(1, nodes.length);
+      assertTrue(nodes[0].estimatedNrItems > 700, nodes[0].estimatedNrItems);
+
+      nodes = getIndexNodes("FOR doc IN " + c.name() + " FILTER doc.skewed == 5 RETURN doc");
+      assertEqual(1, nodes.length);
+      assertTrue(nodes[0].estimatedNrItems < 50, nodes[0].estimatedNrItems);
+
+      nodes = getIndexNodes("FOR doc IN " + c.name() + " FILTER doc.skewed == 5000 RETURN doc");
+      assertEqual(1, nodes.length);
+      assertEqual(1, nodes[0].estimatedNrItems);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test range estimates
+////////////////////////////////////////////////////////////////////////////////
+
+    testRangeEstimates : function () {
+      var nodes = getIndexNodes("FOR doc IN " + c.name() + " FILTER doc.uniform >= 900 RETURN doc");
+      assertEqual(1, nodes.length);
+      assertTrue(nodes[0].estimatedNrItems >= 50 && nodes[0].estimatedNrItems <= 200, nodes[0].estimatedNrItems);
+
+      nodes = getIndexNodes("FOR doc IN " + c.name() + " FILTER doc.uniform > 100 && doc.uniform < 600 RETURN doc");
+      assertEqual(1, nodes.length);
+      assertTrue(nodes[0].estimatedNrItems >= 400 && nodes[0].estimatedNrItems <= 600, nodes[0].estimatedNrItems);
+
+      nodes = getIndexNodes("FOR doc IN " + c.name() + " FILTER 100 < doc.uniform RETURN doc");
+      assertEqual(1, nodes.length);
+      assertTrue(nodes[0].estimatedNrItems >= 800, nodes[0].estimatedNrItems);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the more selective index is picked
+////////////////////////////////////////////////////////////////////////////////
+
+    testIndexSelection : function () {
+      var query = "FOR doc IN " + c.name() + " FILTER doc.skewed == 0 && doc.uniform >= 990 RETURN doc.uniform";
+      var nodes = getIndexNodes(query);
+      assertEqual(1, nodes.length);
+      assertEqual([ "uniform" ], nodes[0].indexes[0].fields);
+
+      var result = AQL_EXECUTE(query).json;
+      assertEqual([ ], result);
+
+      query = "FOR doc IN " + c.name() + " FILTER doc.skewed == 3 && doc.uniform >= 100 RETURN doc.uniform";
+      nodes = getIndexNodes(query);
+      assertEqual(1, nodes.length);
+      assertEqual([ "skewed" ], nodes[0].indexes[0].fields);
+
+      result = AQL_EXECUTE(query).json;
+      assertEqual([ 902 ], result);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerIndexStatisticsTestSuite);
+
+return jsunity.done();
@@ -0,0 +1,211 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var db = require("@arangodb").db;
+var jsunity = require("jsunity");
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "distribute-collect-to-cluster";
+  var thisRuleEnabled  = { optimizer: { rules: [ "+all" ] } };
+  var thisRuleDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+
+  var cn = "UnitTestsAqlOptimizerRuleDistributeCollect";
+  var c;
+
+  var getCollectNodes = function (query) {
+    return AQL_EXPLAIN(query, { }, thisRuleEnabled).plan.nodes.filter(function(node) {
+      return node.type === "CollectNode";
+    });
+  };
+
+  // partial states are merged in a different order than the values are
+  // aggregated on a single server, so floating point results may differ
+  // in the last digits
+  var assertSameResult = function (expected, actual, query) {
+    if (typeof expected === "number" && typeof actual === "number") {
+      assertTrue(Math.abs(expected - actual) <= 1e-9 * Math.max(1, Math.abs(expected)), query);
+      return;
+    }
+    if (Array.isArray(expected)) {
+      assertTrue(Array.isArray(actual), query);
+      assertEqual(expected.length, actual.length, query);
+      for (var i = 0; i < expected.length; ++i) {
+        assertSameResult(expected[i], actual[i], query);
+      }
+      return;
+    }
+    assertEqual(expected, actual, query);
+  };
+
+  var compareResults = function (query) {
+    var expected = AQL_EXECUTE(query, { }, thisRuleDisabled).json;
+    var actual = AQL_EXECUTE(query, { }, thisRuleEnabled).json;
+    assertSameResult(expected, actual, query);
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn, { numberOfShards: 5 });
+
+      for (var i = 0; i < 1000; ++i) {
+        c.save({ group: i % 10, value: i, mixed: (i % 7 === 0 ? null : i), text: "test" + (i % 3) });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the rule splits the COLLECT
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleFires : function () {
+      var queries = [
+        "FOR doc IN " + cn + " COLLECT g = doc.group AGGREGATE s = SUM(doc.value) RETURN [ g, s ]",
+        "FOR doc IN " + cn + " COLLECT g = doc.group AGGREGATE s = SUM(doc.value) OPTIONS { method: 'hash' } RETURN [ g, s ]",
+        "FOR doc IN " + cn + " COLLECT AGGREGATE min = MIN(doc.value), max = MAX(doc.value) RETURN [ min, max ]",
+        "FOR doc IN " + cn + " RETURN DISTINCT doc.group"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, thisRuleEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+
+        var nodes = result.plan.nodes.filter(function(node) {
+          return node.type === "CollectNode";
+        });
+        assertEqual(2, nodes.length, query);
+        assertEqual("partial", nodes[0].aggregationStep, query);
+        assertEqual("merge", nodes[1].aggregationStep, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the rule does not fire for COLLECTs that need all rows
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        "FOR doc IN " + cn + " COLLECT g = doc.group INTO docs RETURN [ g, LENGTH(docs) ]",
+        "FOR doc IN " + cn + " COLLECT g = doc.group INTO values = doc.value RETURN [ g, values ]",
+        "FOR doc IN " + cn + " COLLECT g = doc.group WITH COUNT INTO count RETURN [ g, count ]"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, thisRuleEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the merged group mapping
+////////////////////////////////////////////////////////////////////////////////
+
+    testMergeTypes : function () {
+      var nodes = getCollectNodes("FOR doc IN " + cn + " COLLECT g = doc.group AGGREGATE l = LENGTH(1), a = AVERAGE(doc.value) RETURN [ g, l, a ]");
+      assertEqual(2, nodes.length);
+      assertEqual([ "LENGTH", "AVERAGE" ], nodes[0].aggregates.map(function(a) { return a.type; }));
+      assertEqual([ "SUM", "AVERAGE" ], nodes[1].aggregates.map(function(a) { return a.type; }));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the results of the aggregate functions
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var aggregates = [
+        "SUM(doc.value)", "SUM(doc.mixed)", "SUM(doc.text)",
+        "MIN(doc.value)", "MIN(doc.text)",
+        "MAX(doc.value)", "MAX(doc.text)",
+        "LENGTH(1)", "COUNT(doc.value)",
+        "AVERAGE(doc.value)", "AVERAGE(doc.mixed)",
+        "VARIANCE_POPULATION(doc.value)", "VARIANCE_SAMPLE(doc.mixed)",
+        "STDDEV_POPULATION(doc.value)", "STDDEV_SAMPLE(doc.value)"
+      ];
+
+      aggregates.forEach(function(aggregate) {
+        [ "sorted", "hash" ].forEach(function(method) {
+          compareResults("FOR doc IN " + cn + " COLLECT g = doc.group AGGREGATE a = " + aggregate + " OPTIONS { method: '" + method + "' } SORT g RETURN [ g, a ]");
+          compareResults("FOR doc IN " + cn + " COLLECT g = doc.text, h = doc.group AGGREGATE a = " + aggregate + " OPTIONS { method: '" + method + "' } SORT g, h RETURN [ g, h, a ]");
+        });
+        compareResults("FOR doc IN " + cn + " COLLECT AGGREGATE a = " + aggregate + " RETURN a");
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test empty and small inputs
+////////////////////////////////////////////////////////////////////////////////
+
+    testEmptyInput : function () {
+      var queries = [
+        "FOR doc IN " + cn + " FILTER doc.value < 0 COLLECT AGGREGATE s = SUM(doc.value), l = LENGTH(1), m = MIN(doc.value) RETURN [ s, l, m ]",
+        "FOR doc IN " + cn + " FILTER doc.value < 0 COLLECT g = doc.group AGGREGATE s = SUM(doc.value) RETURN [ g, s ]",
+        "FOR doc IN " + cn + " FILTER doc.value == 42 COLLECT AGGREGATE v = VARIANCE_SAMPLE(doc.value), a = AVERAGE(doc.value) RETURN [ v, a ]"
+      ];
+
+      queries.forEach(function(query) {
+        compareResults(query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test DISTINCT
+////////////////////////////////////////////////////////////////////////////////
+
+    testDistinct : function () {
+      var query = "FOR doc IN " + cn + " RETURN DISTINCT doc.text";
+      var expected = AQL_EXECUTE(query, { }, thisRuleDisabled).json.sort();
+      var actual = AQL_EXECUTE(query, { }, thisRuleEnabled).json.sort();
+      assertEqual(expected, actual);
+      assertEqual([ "test0", "test1", "test2" ], actual);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
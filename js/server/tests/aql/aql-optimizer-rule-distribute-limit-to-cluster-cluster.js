@@ -0,0 +1,171 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var db = require("@arangodb").db;
+var jsunity = require("jsunity");
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "distribute-limit-to-cluster";
+  var thisRuleEnabled  = { optimizer: { rules: [ "+all" ] } };
+  var thisRuleDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+
+  var cn = "UnitTestsAqlOptimizerRuleDistributeLimit";
+  var c;
+
+  var getNodes = function (query, type) {
+    return AQL_EXPLAIN(query, { }, thisRuleEnabled).plan.nodes.filter(function(node) {
+      return node.type === type;
+    });
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn, { numberOfShards: 5 });
+
+      for (var i = 0; i < 1000; ++i) {
+        c.save({ value: i, group: i % 10 });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the rule copies the LIMIT into the shard snippets
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleFires : function () {
+      var queries = [
+        [ "FOR doc IN " + cn + " LIMIT 10 RETURN doc", 10 ],
+        [ "FOR doc IN " + cn + " SORT doc.value LIMIT 5, 10 RETURN doc.value", 15 ],
+        [ "FOR doc IN " + cn + " SORT doc.value DESC LET v = doc.value * 2 LIMIT 3 RETURN v", 3 ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, thisRuleEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+
+        var nodes = getNodes(query[0], "LimitNode");
+        assertEqual(2, nodes.length, query[0]);
+        assertEqual(0, nodes[0].offset, query[0]);
+        assertEqual(query[1], nodes[0].limit, query[0]);
+
+        nodes = getNodes(query[0], "GatherNode");
+        assertEqual(1, nodes.length, query[0]);
+        assertEqual(query[1], nodes[0].limit, query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the rule does not fire if all rows are needed
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        "FOR doc IN " + cn + " LIMIT 10 RETURN doc",
+        "FOR doc IN " + cn + " SORT doc.value LIMIT 0 RETURN doc",
+        "FOR doc IN " + cn + " COLLECT g = doc.group INTO docs LIMIT 2 RETURN g",
+        "FOR doc IN " + cn + " FILTER doc.value > 10 RETURN doc"
+      ];
+
+      queries.forEach(function(query, i) {
+        var options = thisRuleEnabled;
+        if (i === 0) {
+          options = { fullCount: true, optimizer: thisRuleEnabled.optimizer };
+        }
+        var result = AQL_EXPLAIN(query, { }, options);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the results with and without the rule
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [
+        "FOR doc IN " + cn + " SORT doc.value LIMIT 10 RETURN doc.value",
+        "FOR doc IN " + cn + " SORT doc.value LIMIT 995, 10 RETURN doc.value",
+        "FOR doc IN " + cn + " SORT doc.value DESC LIMIT 100, 1 RETURN doc.value",
+        "FOR doc IN " + cn + " SORT doc.group, doc.value LIMIT 17, 250 RETURN [ doc.group, doc.value ]",
+        "FOR doc IN " + cn + " FILTER doc.group == 3 SORT doc.value LIMIT 3, 5 RETURN doc.value"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, thisRuleDisabled).json;
+        var actual = AQL_EXECUTE(query, { }, thisRuleEnabled).json;
+        assertEqual(expected, actual, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that unsorted results have the right number of documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testUnsorted : function () {
+      var result = AQL_EXECUTE("FOR doc IN " + cn + " LIMIT 10, 50 RETURN doc.value", { }, thisRuleEnabled).json;
+      assertEqual(50, result.length);
+
+      result = AQL_EXECUTE("FOR doc IN " + cn + " LIMIT 990, 50 RETURN doc.value", { }, thisRuleEnabled).json;
+      assertEqual(10, result.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that fullCount still counts all documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testFullCount : function () {
+      var result = AQL_EXECUTE("FOR doc IN " + cn + " SORT doc.value LIMIT 5 RETURN doc.value", { }, { fullCount: true });
+      assertEqual([ 0, 1, 2, 3, 4 ], result.json);
+      assertEqual(1000, result.stats.fullCount);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
@@ -0,0 +1,188 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+
+var jsunity = require("jsunity");
+var helper = require("@arangodb/aql-helper");
+var db = require("@arangodb").db;
+var removeAlwaysOnClusterRules = helper.removeAlwaysOnClusterRules;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "late-document-materialization";
+  // various choices to control the optimizer:
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var c;
+
+  var getNodeTypes = function (result) {
+    return result.plan.nodes.map(function(node) {
+      return node.type;
+    });
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      for (var i = 0; i < 200; ++i) {
+        c.save({ _key: "test" + i, name: "name" + (i % 37), age: i % 80, sub: { value: i } });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var query = "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } FILTER p.age > 30 RETURN p";
+
+      var result = AQL_EXPLAIN(query, { }, paramNone);
+      assertEqual([ ], removeAlwaysOnClusterRules(result.plan.rules));
+
+      result = AQL_EXPLAIN(query, { }, paramDisabled);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } RETURN p", // no attribute access
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } FILTER p.foo == 1 RETURN p", // unknown attribute
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } FILTER p.age > 30 && p != null RETURN p", // whole object used
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age + 1 } FILTER p.age > 30 RETURN p", // value is not an attribute
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: RAND() } FILTER p.age > 0.5 RETURN p", // value is not an attribute
+        "FOR d IN " + c.name() + " LET p = { [ d.name ]: d.age } FILTER p.name0 > 30 RETURN p", // dynamic attribute name
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } COLLECT x = p INTO g RETURN x.age" // COLLECT
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } FILTER p.age > 30 RETURN p",
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } SORT p.name LIMIT 10 RETURN p",
+        "FOR d IN " + c.name() + " LET p = { name: d.name, value: d.sub.value, c: 1 } FILTER p.value > 10 && p.c == 1 RETURN p.name",
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } FOR i IN 1..2 FILTER p.age == i RETURN p"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the projection is only built after the LIMIT
+////////////////////////////////////////////////////////////////////////////////
+
+    testProjectionMovedBelowLimit : function () {
+      var query = "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } FILTER p.age > 30 SORT p.name LIMIT 10 RETURN p";
+      var result = AQL_EXPLAIN(query);
+      assertNotEqual(-1, result.plan.rules.indexOf(ruleName));
+
+      var nodeTypes = getNodeTypes(result);
+      var calculations = result.plan.nodes.filter(function(node) {
+        return node.type === "CalculationNode" && node.outVariable.name === "p";
+      });
+      assertEqual(1, calculations.length);
+      assertEqual(nodeTypes.indexOf("LimitNode") + 1, nodeTypes.lastIndexOf("CalculationNode"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that an index can be used for a filter on a projection
+////////////////////////////////////////////////////////////////////////////////
+
+    testIndexUsed : function () {
+      c.ensureIndex({ type: "skiplist", fields: [ "age" ] });
+
+      var query = "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } FILTER p.age == 30 RETURN p";
+      var result = AQL_EXPLAIN(query);
+      assertNotEqual(-1, result.plan.rules.indexOf(ruleName));
+      assertNotEqual(-1, getNodeTypes(result).indexOf("IndexNode"));
+      assertEqual(-1, getNodeTypes(result).indexOf("EnumerateCollectionNode"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } FILTER p.age > 30 SORT d._key RETURN p",
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } SORT p.name, p.age, d._key LIMIT 10 RETURN p",
+        "FOR d IN " + c.name() + " LET p = { name: d.name, value: d.sub.value, c: 1 } FILTER p.value > 10 && p.c == 1 SORT p.value RETURN p.name",
+        "FOR d IN " + c.name() + " LET p = { name: d.name, missing: d.missing } FILTER p.missing == null SORT d._key RETURN p",
+        "FOR d IN " + c.name() + " LET p = { name: d.name, age: d.age } FOR i IN 1..2 FILTER p.age == i SORT d._key, i RETURN [ p, i ]"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, paramNone).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+
+        actual = AQL_EXECUTE(query).json;
+        assertEqual(expected, actual, query);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
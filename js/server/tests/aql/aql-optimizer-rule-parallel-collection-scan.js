@@ -0,0 +1,256 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, assertTrue, assertFalse, fail, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+
+var jsunity = require("jsunity");
+var helper = require("@arangodb/aql-helper");
+var db = require("@arangodb").db;
+var removeAlwaysOnClusterRules = helper.removeAlwaysOnClusterRules;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "parallel-collection-scan";
+  // various choices to control the optimizer:
+  var paramNone     = { maxParallelism: 4, optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { maxParallelism: 4, optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { maxParallelism: 4, optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var paramSerial   = { maxParallelism: 1, optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var c;
+
+  var getCollectionNodes = function (result) {
+    return result.plan.nodes.filter(function(node) {
+      return node.type === "EnumerateCollectionNode";
+    });
+  };
+
+  var sorted = function (values) {
+    return values.sort(function (l, r) {
+      return JSON.stringify(l) < JSON.stringify(r) ? -1 : 1;
+    });
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      // enough documents to split the primary index into several ranges
+      db._query("FOR i IN 0..49999 INSERT { _key: CONCAT('test', i), value: i, group: i % 13, name: CONCAT('name', i % 101), zero: 0, list: [ i ] } INTO " + c.name());
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var query = "FOR d IN " + c.name() + " FILTER d.value > 30 RETURN d";
+
+      var result = AQL_EXPLAIN(query, { }, paramNone);
+      assertEqual([ ], removeAlwaysOnClusterRules(result.plan.rules));
+
+      result = AQL_EXPLAIN(query, { }, paramDisabled);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName));
+
+      // parallelism is turned off by default
+      result = AQL_EXPLAIN(query);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName));
+
+      result = AQL_EXPLAIN(query, { }, paramSerial);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        "FOR d IN " + c.name() + " RETURN d", // no filter
+        "FOR d IN " + c.name() + " SORT RAND() RETURN d", // random order
+        "FOR d IN " + c.name() + " FILTER LENGTH(d.list) > 0 RETURN d", // function call
+        "FOR d IN " + c.name() + " LET a = d.value > 10 FILTER a RETURN a", // condition used later
+        "FOR i IN 1..2 FOR d IN " + c.name() + " FILTER d.value == i RETURN d", // inner loop
+        "FOR i IN 1..2 FOR d IN " + c.name() + " FILTER d.value == 1 RETURN d" // inner loop
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        "FOR d IN " + c.name() + " FILTER d.value > 30 RETURN d",
+        "FOR d IN " + c.name() + " FILTER d.value > 30 FILTER d.group == 3 RETURN d.value",
+        "FOR d IN " + c.name() + " FILTER d.value > 30 && d.name != 'name1' RETURN d",
+        "FOR d IN " + c.name() + " FILTER d.value * 2 < 100 SORT d.value RETURN d"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+
+        var nodes = getCollectionNodes(result);
+        assertEqual(1, nodes.length, query);
+        assertTrue(nodes[0].hasOwnProperty("filter"), query);
+
+        // the filters are now part of the scan
+        result.plan.nodes.forEach(function(node) {
+          assertNotEqual("FilterNode", node.type, query);
+        });
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      c.save({ _key: "missing" });
+      c.save({ _key: "null", value: null, group: null, name: null });
+      c.save({ _key: "object", value: { a: 1 }, group: [ 1, 2 ], name: [ "name1" ] });
+      c.save({ _key: "string", value: "12345", group: "3", name: "name1" });
+
+      var queries = [
+        "FOR d IN " + c.name() + " FILTER d.value > 49000 RETURN d._key",
+        "FOR d IN " + c.name() + " FILTER d.group == 3 FILTER d.value < 1000 RETURN d.value",
+        "FOR d IN " + c.name() + " FILTER d.name == 'name1' RETURN d._key",
+        "FOR d IN " + c.name() + " FILTER d.value == null RETURN d._key",
+        "FOR d IN " + c.name() + " FILTER d.group != 3 && (d.value < 100 || d.value > 49900) RETURN d._key",
+        "FOR d IN " + c.name() + " FILTER d.value % 1000 == 0 SORT d.value RETURN d.value",
+        "FOR d IN " + c.name() + " FILTER d.value > 10 COLLECT g = d.group WITH COUNT INTO n RETURN [ g, n ]",
+        "FOR d IN " + c.name() + " FILTER d.value > 10 COLLECT WITH COUNT INTO n RETURN n"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = sorted(AQL_EXECUTE(query, { }, paramNone).json);
+        var actual = sorted(AQL_EXECUTE(query, { }, paramEnabled).json);
+        assertEqual(expected, actual, query);
+
+        actual = sorted(AQL_EXECUTE(query, { }, paramDisabled).json);
+        assertEqual(expected, actual, query);
+
+        actual = sorted(AQL_EXECUTE(query, { }, { maxParallelism: 4 }).json);
+        assertEqual(expected, actual, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test statistics
+////////////////////////////////////////////////////////////////////////////////
+
+    testStatistics : function () {
+      var query = "FOR d IN " + c.name() + " FILTER d.value >= 1000 RETURN d";
+
+      var result = AQL_EXECUTE(query, { }, paramEnabled);
+      assertEqual(49000, result.json.length);
+      assertEqual(50000, result.stats.scannedFull);
+      assertEqual(1000, result.stats.filtered);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test skipping
+////////////////////////////////////////////////////////////////////////////////
+
+    testLimit : function () {
+      var query = "FOR d IN " + c.name() + " FILTER d.group == 5 LIMIT 1000, 2000 RETURN d";
+
+      var result = AQL_EXECUTE(query, { }, paramEnabled);
+      assertEqual(2000, result.json.length);
+      result.json.forEach(function(doc) {
+        assertEqual(5, doc.group);
+      });
+
+      query = "FOR d IN " + c.name() + " FILTER d.group == 5 LIMIT 3800, 1000 RETURN d";
+      assertEqual(AQL_EXECUTE(query, { }, paramNone).json.length,
+                  AQL_EXECUTE(query, { }, paramEnabled).json.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test scans that are restarted, reusing the scanner's threads, and
+/// scans that are stopped while the workers are still running
+////////////////////////////////////////////////////////////////////////////////
+
+    testRepeatedScans : function () {
+      var query = "FOR i IN 1..20 LET n = LENGTH(FOR d IN " + c.name() + " FILTER d.value < 100 RETURN 1) RETURN n";
+      var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+      assertEqual(20, actual.length);
+      actual.forEach(function(n) {
+        assertEqual(100, n);
+      });
+
+      query = "FOR i IN 1..20 LET n = (FOR d IN " + c.name() + " FILTER d.group == 5 LIMIT 3 RETURN d.group) RETURN n";
+      actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+      assertEqual(20, actual.length);
+      actual.forEach(function(n) {
+        assertEqual([ 5, 5, 5 ], n);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that warnings are produced by the scanning threads' filters
+////////////////////////////////////////////////////////////////////////////////
+
+    testWarnings : function () {
+      var query = "FOR d IN " + c.name() + " FILTER d.value < 10 && d.value / d.zero == null RETURN d.value";
+
+      var expected = AQL_EXECUTE(query, { }, paramNone);
+      var actual = AQL_EXECUTE(query, { }, paramEnabled);
+      assertEqual(sorted(expected.json), sorted(actual.json));
+      assertEqual(10, actual.json.length);
+      assertTrue(expected.warnings.length > 0);
+      assertTrue(actual.warnings.length > 0);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
@@ -0,0 +1,173 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var helper = require("@arangodb/aql-helper");
+var db = require("@arangodb").db;
+var removeAlwaysOnClusterRules = helper.removeAlwaysOnClusterRules;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "sort-limit";
+  // various choices to control the optimizer:
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var c;
+
+  var getSortNode = function (result) {
+    return result.plan.nodes.filter(function(node) {
+      return node.type === "SortNode";
+    })[0];
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      for (var i = 0; i < 3000; ++i) {
+        c.save({ value: i % 1000, nr: i });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i",
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 5, 10 RETURN i"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual([ ], removeAlwaysOnClusterRules(result.plan.rules));
+        assertEqual(0, getSortNode(result).limit);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        "FOR i IN " + c.name() + " SORT i.value RETURN i", // no limit
+        "FOR i IN " + c.name() + " LIMIT 10 SORT i.value RETURN i", // limit before sort
+        "FOR i IN " + c.name() + " SORT i.value FILTER i.nr > 5 LIMIT 10 RETURN i", // filter in between
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 0 RETURN i" // limit 0
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when fullCount is requested
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffectFullCount : function () {
+      var query = "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i";
+      var result = AQL_EXPLAIN(query, { }, { fullCount: true, optimizer: { rules: [ "-all", "+" + ruleName ] } });
+      assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+
+      result = AQL_EXECUTE(query, { }, { fullCount: true });
+      assertEqual(10, result.json.length);
+      assertEqual(3000, result.stats.fullCount);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        [ "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i", 10 ],
+        [ "FOR i IN " + c.name() + " SORT i.value DESC LIMIT 5, 10 RETURN i", 15 ],
+        [ "FOR i IN " + c.name() + " SORT i.value, i.nr LIMIT 2500 RETURN i", 2500 ],
+        [ "FOR i IN " + c.name() + " SORT i.value LET x = i.nr + 1 LIMIT 7 RETURN x", 7 ],
+        [ "FOR j IN 1..3 LET s = (FOR i IN " + c.name() + " SORT i.value LIMIT 3 RETURN i) RETURN s", 3 ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+        assertEqual(query[1], getSortNode(result).limit, query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 10 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.value DESC LIMIT 5, 10 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.value, i.nr DESC LIMIT 2500 RETURN [ i.value, i.nr ]",
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 100, 1200 RETURN i.value",
+        "FOR i IN " + c.name() + " SORT i.nr % 7, i.nr LIMIT 1, 2999 RETURN i.nr",
+        "FOR i IN " + c.name() + " SORT i.value LIMIT 5000 RETURN i.value"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, paramDisabled).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
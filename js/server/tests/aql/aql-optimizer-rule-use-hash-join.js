@@ -0,0 +1,301 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+
+var jsunity = require("jsunity");
+var helper = require("@arangodb/aql-helper");
+var db = require("@arangodb").db;
+var removeAlwaysOnClusterRules = helper.removeAlwaysOnClusterRules;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "use-hash-join";
+  // various choices to control the optimizer:
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var c1, c2;
+
+  var getNodeTypes = function (result) {
+    return result.plan.nodes.map(function(node) {
+      return node.type;
+    });
+  };
+
+  var sorted = function (values) {
+    return values.map(function(value) {
+      return JSON.stringify(value);
+    }).sort();
+  };
+
+  var fill = function () {
+    db._drop("UnitTestsCollection1");
+    db._drop("UnitTestsCollection2");
+    c1 = db._create("UnitTestsCollection1");
+    c2 = db._create("UnitTestsCollection2");
+
+    var i;
+    for (i = 0; i < 100; ++i) {
+      c1.save({ _key: "test" + i, value: i, sub: { value: i % 10 } });
+    }
+    // documents with duplicate values, null values and missing attributes
+    for (i = 0; i < 500; ++i) {
+      if (i % 50 === 0) {
+        c2.save({ nr: i });
+      }
+      else if (i % 50 === 1) {
+        c2.save({ nr: i, ref: null });
+      }
+      else {
+        c2.save({ nr: i, ref: i % 120, sub: { ref: "test" + (i % 7) } });
+      }
+    }
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      fill();
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection1");
+      db._drop("UnitTestsCollection2");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var query = "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value == b.ref RETURN b";
+
+      var result = AQL_EXPLAIN(query, { }, paramNone);
+      assertEqual([ ], removeAlwaysOnClusterRules(result.plan.rules));
+      assertEqual(-1, getNodeTypes(result).indexOf("HashJoinNode"));
+
+      result = AQL_EXPLAIN(query, { }, paramDisabled);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName));
+      assertEqual(-1, getNodeTypes(result).indexOf("HashJoinNode"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        "FOR b IN " + c2.name() + " FILTER b.ref == 1 RETURN b", // no outer loop
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value < b.ref RETURN b", // no equality
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value == b.ref || b.nr == 1 RETURN b", // disjunction
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER b.ref == b.nr RETURN b", // same variable
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value + 1 == b.ref RETURN b", // no attribute
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " RETURN b" // no filter
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that no hash table is built on a modified collection
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffectModification : function () {
+      var queries = [
+        "FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.value == b.ref UPDATE a WITH { seen: true } IN " + c1.name(),
+        "FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.value == b.ref REPLACE a WITH { value: a.value } IN " + c1.name(),
+        "FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.value == b.ref REMOVE a IN " + c1.name(),
+        "FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.value == b.ref INSERT { value: a.value } IN " + c1.name(),
+        "FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.value == b.ref UPSERT { value: a.value } INSERT { } UPDATE { seen: true } IN " + c1.name()
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertEqual(-1, getNodeTypes(result).indexOf("HashJoinNode"), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the loops are not swapped to build the hash table on a
+/// modified collection
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoSwapModification : function () {
+      var query = "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value == b.ref UPDATE a WITH { seen: true } IN " + c1.name();
+      var result = AQL_EXPLAIN(query, { }, paramEnabled);
+      var nodes = result.plan.nodes.filter(function(node) {
+        return node.type === "HashJoinNode";
+      });
+      assertEqual(1, nodes.length);
+      assertEqual(c2.name(), nodes[0].collection);
+      assertEqual("b", nodes[0].outVariable.name);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that an index is preferred over a hash join
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffectIndex : function () {
+      c2.ensureIndex({ type: "hash", fields: [ "ref" ] });
+
+      var query = "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value == b.ref RETURN b";
+      var result = AQL_EXPLAIN(query);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      assertNotEqual(-1, getNodeTypes(result).indexOf("IndexNode"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value == b.ref RETURN [ a, b ]",
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER b.ref == a.value RETURN [ a, b ]",
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER b.sub.ref == a._key && b.nr > 10 RETURN [ a, b ]",
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.sub.value == b.ref RETURN [ a, b ]",
+        "FOR a IN " + c1.name() + " FILTER a.value < 20 FOR b IN " + c2.name() + " FILTER a.value == b.ref RETURN [ a, b ]"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+        assertNotEqual(-1, getNodeTypes(result).indexOf("HashJoinNode"), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the hash table is built on the smaller collection
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleSwapsLoops : function () {
+      var query = "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value == b.ref RETURN [ a, b ]";
+      var result = AQL_EXPLAIN(query, { }, paramEnabled);
+      var nodes = result.plan.nodes.filter(function(node) {
+        return node.type === "HashJoinNode";
+      });
+      assertEqual(1, nodes.length);
+      assertEqual(c1.name(), nodes[0].collection);
+      assertEqual("a", nodes[0].outVariable.name);
+      assertEqual([ "value" ], nodes[0].buildAttribute);
+      assertEqual("b", nodes[0].probeVariable.name);
+      assertEqual([ "ref" ], nodes[0].probeAttribute);
+
+      // c1 is the inner loop here, and the smaller collection
+      query = "FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.value == b.ref RETURN [ a, b ]";
+      result = AQL_EXPLAIN(query, { }, paramEnabled);
+      nodes = result.plan.nodes.filter(function(node) {
+        return node.type === "HashJoinNode";
+      });
+      assertEqual(1, nodes.length);
+      assertEqual(c1.name(), nodes[0].collection);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value == b.ref RETURN [ a.value, b.nr ]",
+        "FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.value == b.ref RETURN [ a.value, b.nr ]",
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER b.sub.ref == a._key && b.nr > 10 RETURN [ a._key, b.nr ]",
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.sub.value == b.ref RETURN [ a.value, b.nr ]",
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.missing == b.ref RETURN [ a.value, b.nr ]",
+        "FOR a IN " + c1.name() + " FILTER a.value < 20 FOR b IN " + c2.name() + " FILTER a.value == b.ref RETURN [ a.value, b.nr ]",
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value == b.ref LIMIT 3, 10 RETURN [ a.value, b.nr ]",
+        "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.value == b.ref COLLECT WITH COUNT INTO n RETURN n"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, paramNone).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled);
+        if (query.indexOf("LIMIT") === -1) {
+          assertEqual(sorted(expected), sorted(actual.json), query);
+        }
+        else {
+          assertEqual(expected.length, actual.json.length, query);
+        }
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results of a query that modifies the inner collection
+////////////////////////////////////////////////////////////////////////////////
+
+    testResultsModification : function () {
+      var query = "FOR b IN " + c2.name() + " FOR a IN " + c1.name() + " FILTER a.value == b.ref UPDATE a WITH { value: a.value + 1 } IN " + c1.name() + " RETURN NEW.value";
+      var expected = AQL_EXECUTE(query, { }, paramNone).json;
+      var expectedDocuments = AQL_EXECUTE("FOR a IN " + c1.name() + " RETURN [ a._key, a.value ]").json;
+
+      fill();
+      var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+      var actualDocuments = AQL_EXECUTE("FOR a IN " + c1.name() + " RETURN [ a._key, a.value ]").json;
+
+      assertEqual(sorted(expected), sorted(actual));
+      assertEqual(sorted(expectedDocuments), sorted(actualDocuments));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that strings are compared like the == operator does
+////////////////////////////////////////////////////////////////////////////////
+
+    testResultsUtf8 : function () {
+      [ "caf\u00e9", "cafe\u0301", "Caf\u00e9", "\u00c5ngstr\u00f6m", "A\u030angstro\u0308m", "stra\u00dfe", "strasse" ].forEach(function(name, i) {
+        c1.save({ name: name, nr: i });
+        c2.save({ name: name, nr: i });
+      });
+
+      var query = "FOR a IN " + c1.name() + " FOR b IN " + c2.name() + " FILTER a.name == b.name RETURN [ a.nr, b.nr ]";
+      var expected = AQL_EXECUTE(query, { }, paramNone).json;
+      var result = AQL_EXECUTE(query, { }, paramEnabled);
+      assertNotEqual(-1, getNodeTypes(AQL_EXPLAIN(query, { }, paramEnabled)).indexOf("HashJoinNode"));
+      assertEqual(sorted(expected), sorted(result.json));
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
@@ -0,0 +1,208 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertNotEqual, assertTrue, assertFalse, fail, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+
+var jsunity = require("jsunity");
+var helper = require("@arangodb/aql-helper");
+var db = require("@arangodb").db;
+var errors = require("@arangodb").errors;
+var removeAlwaysOnClusterRules = helper.removeAlwaysOnClusterRules;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "use-index-projections";
+  // various choices to control the optimizer:
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+use-indexes", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var c;
+
+  var getIndexNodes = function (result) {
+    return result.plan.nodes.filter(function(node) {
+      return node.type === "IndexNode";
+    });
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsCollection");
+      c = db._create("UnitTestsCollection");
+
+      for (var i = 0; i < 200; ++i) {
+        c.save({ _key: "test" + i, name: "name" + (i % 37), age: i % 80, city: "a rather long city name " + (i % 7), sub: { value: i } });
+      }
+
+      c.ensureIndex({ type: "skiplist", fields: [ "age" ], storedValues: [ "name", "city" ] });
+      c.ensureIndex({ type: "hash", fields: [ "name" ] });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsCollection");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that stored values are part of the index definition
+////////////////////////////////////////////////////////////////////////////////
+
+    testIndexDefinition : function () {
+      var indexes = c.getIndexes();
+      assertEqual(3, indexes.length);
+      assertEqual("skiplist", indexes[1].type);
+      assertEqual([ "name", "city" ], indexes[1].storedValues);
+      assertEqual("hash", indexes[2].type);
+      assertEqual(undefined, indexes[2].storedValues);
+
+      // an index with different stored values is a different index
+      var idx = c.ensureIndex({ type: "skiplist", fields: [ "age" ], storedValues: [ "name" ] });
+      assertTrue(idx.isNewlyCreated);
+      idx = c.ensureIndex({ type: "skiplist", fields: [ "age" ], storedValues: [ "name", "city" ] });
+      assertFalse(idx.isNewlyCreated);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test invalid stored values
+////////////////////////////////////////////////////////////////////////////////
+
+    testInvalidStoredValues : function () {
+      [ "name", [ 1 ], [ "" ], [ "_key" ], [ "a", "a" ], [ "a.b" ], [ "a[*]" ] ].forEach(function(value) {
+        try {
+          c.ensureIndex({ type: "hash", fields: [ "age" ], storedValues: value });
+          fail();
+        } catch (err) {
+          assertEqual(errors.ERROR_BAD_PARAMETER.code, err.errorNum, value);
+        }
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var query = "FOR d IN " + c.name() + " FILTER d.age == 30 RETURN d.name";
+
+      var result = AQL_EXPLAIN(query, { }, paramNone);
+      assertEqual([ ], removeAlwaysOnClusterRules(result.plan.rules));
+
+      result = AQL_EXPLAIN(query, { }, paramDisabled);
+      assertEqual(-1, result.plan.rules.indexOf(ruleName));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        "FOR d IN " + c.name() + " FILTER d.age == 30 RETURN d", // whole document used
+        "FOR d IN " + c.name() + " FILTER d.age == 30 RETURN d._key", // attribute not stored
+        "FOR d IN " + c.name() + " FILTER d.age == 30 RETURN d.sub.value", // attribute not stored
+        "FOR d IN " + c.name() + " FILTER d.name == 'name1' RETURN d.age", // attribute not stored
+        "FOR d IN " + c.name() + " FILTER d.age == 30 || d.name == 'name1' RETURN d.name", // not stored in both indexes
+        "FOR d IN " + c.name() + " FILTER d.age == 30 COLLECT a = d.age INTO g RETURN a", // COLLECT INTO
+        "FOR d IN " + c.name() + " FILTER d.age == 30 RETURN (FOR x IN [ d ] RETURN x.name)" // subquery
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertEqual(-1, result.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        [ "FOR d IN " + c.name() + " FILTER d.age == 30 RETURN d.name", [ "name" ] ],
+        [ "FOR d IN " + c.name() + " FILTER d.age > 30 SORT d.age RETURN { name: d.name, city: d.city }", [ "age", "city", "name" ] ],
+        [ "FOR d IN " + c.name() + " FILTER d.age IN [ 1, 2, 3 ] FILTER d.city != null RETURN d.age", [ "age", "city" ] ],
+        [ "FOR d IN " + c.name() + " FILTER d.name == 'name1' RETURN d.name", [ "name" ] ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+
+        var nodes = getIndexNodes(result);
+        assertEqual(1, nodes.length, query[0]);
+        assertEqual(query[1], nodes[0].projections, query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      c.save({ _key: "missing", age: 30 });
+      c.save({ _key: "null", age: 31, name: null, city: null });
+      c.save({ _key: "object", age: 31, name: { first: "a", last: "b" }, city: [ 1, 2, 3 ] });
+
+      var queries = [
+        "FOR d IN " + c.name() + " FILTER d.age == 30 SORT d.name RETURN d.name",
+        "FOR d IN " + c.name() + " FILTER d.age > 30 && d.age < 40 RETURN { name: d.name, city: d.city, age: d.age }",
+        "FOR d IN " + c.name() + " FILTER d.age > 70 SORT d.age DESC RETURN [ d.age, d.city ]",
+        "FOR d IN " + c.name() + " FILTER d.age IN [ 31, 3, 5 ] SORT d.age, d.name, d.city RETURN d.city",
+        "FOR d IN " + c.name() + " FILTER d.age == 31 FILTER d.name != null SORT d.city RETURN d.name",
+        "FOR d IN " + c.name() + " FILTER d.name == 'name1' RETURN d.name",
+        "FOR i IN 1..3 FOR d IN " + c.name() + " FILTER d.age == i SORT i, d.name RETURN [ i, d.name ]"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query, { }, paramNone).json;
+        var actual = AQL_EXECUTE(query, { }, paramEnabled).json;
+        assertEqual(expected, actual, query);
+
+        actual = AQL_EXECUTE(query, { }, paramDisabled).json;
+        assertEqual(expected, actual, query);
+
+        actual = AQL_EXECUTE(query).json;
+        assertEqual(expected, actual, query);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
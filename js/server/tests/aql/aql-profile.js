@@ -0,0 +1,144 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, assertFalse, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for per-node query profiling
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014-2016 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var queries = require("@arangodb/aql/queries");
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function profileTestSuite () {
+  var profiled = { profile: true };
+
+  var getNodes = function (plan, type) {
+    return plan.nodes.filter(function(node) {
+      return node.type === type;
+    });
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that nothing is returned without the profile option
+////////////////////////////////////////////////////////////////////////////////
+
+    testNoProfile : function () {
+      var result = AQL_EXECUTE("FOR i IN 1..10 RETURN i");
+      assertFalse(result.hasOwnProperty("plan"));
+      assertFalse(result.stats.hasOwnProperty("nodes"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the per-node statistics
+////////////////////////////////////////////////////////////////////////////////
+
+    testNodeStatistics : function () {
+      var result = AQL_EXECUTE("FOR i IN 1..100 FILTER i % 2 == 0 RETURN i", { }, profiled);
+      assertEqual(50, result.json.length);
+      assertTrue(result.stats.nodes.length > 0);
+
+      result.plan.nodes.forEach(function(node) {
+        assertTrue(node.profile.calls > 0, node);
+        assertTrue(node.profile.runtime >= 0, node);
+      });
+
+      var filter = getNodes(result.plan, "FilterNode")[0];
+      assertEqual(100, filter.profile.itemsIn);
+      assertEqual(50, filter.profile.itemsOut);
+
+      var ret = getNodes(result.plan, "ReturnNode")[0];
+      assertEqual(50, ret.profile.itemsIn);
+      assertEqual(50, ret.profile.itemsOut);
+      assertTrue(ret.profile.runtime >= filter.profile.runtime);
+
+      var singleton = getNodes(result.plan, "SingletonNode")[0];
+      assertEqual(0, singleton.profile.itemsIn);
+      assertEqual(1, singleton.profile.itemsOut);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the statistics of skipped rows
+////////////////////////////////////////////////////////////////////////////////
+
+    testSkip : function () {
+      var result = AQL_EXECUTE("FOR i IN 1..100 LIMIT 10, 5 RETURN i", { }, profiled);
+      assertEqual([ 11, 12, 13, 14, 15 ], result.json);
+
+      var limit = getNodes(result.plan, "LimitNode")[0];
+      assertEqual(5, limit.profile.itemsOut);
+      assertTrue(limit.profile.itemsIn >= 15);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the nodes of subqueries are profiled
+////////////////////////////////////////////////////////////////////////////////
+
+    testSubquery : function () {
+      var result = AQL_EXECUTE("FOR i IN 1..10 LET sub = (FOR j IN 1..i RETURN j) RETURN LENGTH(sub)", { }, profiled);
+      assertEqual([ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 ], result.json);
+
+      var subquery = getNodes(result.plan, "SubqueryNode")[0];
+      var ret = getNodes(subquery.subquery, "ReturnNode")[0];
+      assertEqual(55, ret.profile.itemsOut);
+      assertTrue(ret.profile.calls >= 10);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that the plan of a profiled slow query is kept
+////////////////////////////////////////////////////////////////////////////////
+
+    testSlowQueryLog : function () {
+      var properties = queries.properties();
+      queries.properties({ slowQueryThreshold: 0 });
+
+      try {
+        queries.clearSlow();
+        AQL_EXECUTE("FOR i IN 1..10 RETURN i");
+        AQL_EXECUTE("FOR i IN 1..10 RETURN i * 2", { }, profiled);
+
+        var slow = queries.slow();
+        assertEqual(2, slow.length);
+        assertFalse(slow[0].hasOwnProperty("plan"));
+        assertEqual(10, getNodes(slow[1].plan, "ReturnNode")[0].profile.itemsOut);
+      }
+      finally {
+        queries.properties(properties);
+        queries.clearSlow();
+      }
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(profileTestSuite);
+
+return jsunity.done();
@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false, maxlen: 500 */
-/*global assertEqual, AQL_EXPLAIN */
+/*global assertEqual, AQL_EXPLAIN, AQL_EXECUTE */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tests for query language, sort optimizations
@@ -428,6 +428,61 @@ function ahuacatlQueryOptimizerSortTestSuite () {
       assertEqual(99, actual[99].value);
       
       assertEqual([ "SingletonNode", "IndexNode", "CalculationNode", "FilterNode", "CalculationNode", "SortNode", "ReturnNode" ], explain(query));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check sorting with spilling to disk
+////////////////////////////////////////////////////////////////////////////////
+
+    testSortSpill : function () {
+      var queries = [
+        "FOR i IN 1..5000 SORT i % 17, i DESC RETURN i",
+        "FOR i IN 1..5000 SORT i % 17 DESC, i RETURN i",
+        "FOR i IN 1..5000 SORT CONCAT('x', i) RETURN { v: i, s: CONCAT('x', i) }",
+        "FOR i IN 1..5000 SORT i % 17, i LIMIT 100, 10 RETURN i",
+        "FOR c IN " + cn + " SORT c.value DESC RETURN c.value"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query).json;
+        [ 1, 99, 1000, 4999, 5000 ].forEach(function(threshold) {
+          var actual = AQL_EXECUTE(query, { }, { sortSpillThreshold: threshold }).json;
+          assertEqual(expected, actual, query);
+        });
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check sorting with more spilled runs than are merged at once
+////////////////////////////////////////////////////////////////////////////////
+
+    testSortSpillMultiPassMerge : function () {
+      var queries = [
+        "FOR i IN 1..12000 SORT i % 17, i DESC RETURN i",
+        "FOR i IN 1..12000 SORT CONCAT('x', i) RETURN { v: i, s: CONCAT('x', i) }",
+        "FOR i IN 1..12000 SORT i % 17, i LIMIT 100, 10 RETURN i"
+      ];
+
+      queries.forEach(function(query) {
+        var expected = AQL_EXECUTE(query).json;
+        // 12 runs of 1000 rows each, merged in up to four passes
+        [ 2, 3, 5, 11, 12 ].forEach(function(fanIn) {
+          var actual = AQL_EXECUTE(query, { }, { sortSpillThreshold: 1, sortMergeFanIn: fanIn }).json;
+          assertEqual(expected, actual, query);
+        });
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check sorting with spilling to disk inside a subquery
+////////////////////////////////////////////////////////////////////////////////
+
+    testSortSpillSubquery : function () {
+      var query = "FOR j IN 1..3 LET s = (FOR i IN 1..2500 SORT (i * j) % 13, i RETURN i) RETURN s";
+      var expected = AQL_EXECUTE(query).json;
+      var actual = AQL_EXECUTE(query, { }, { sortSpillThreshold: 1000 }).json;
+      assertEqual(3, actual.length);
+      assertEqual(expected, actual);
     }
 
   };
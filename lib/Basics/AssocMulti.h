@@ -828,6 +828,65 @@ class AssocMulti {
     return result.release();
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief lookups the elements for multiple keys at once. the result will
+  /// contain one vector of elements per key. the hashes of all keys are
+  /// computed first and the table slots they map to are prefetched, so that
+  /// the cache misses of the individual lookups overlap instead of being
+  /// serialized
+  //////////////////////////////////////////////////////////////////////////////
+
+  void lookupByKeys(UserData* userData, std::vector<Key const*> const& keys,
+                    std::vector<std::vector<Element*>>& result) const {
+    size_t const numKeys = keys.size();
+    std::vector<uint64_t> hashes;
+    hashes.reserve(numKeys);
+
+    for (size_t j = 0; j < numKeys; ++j) {
+      uint64_t hashByKey = _hashKey(userData, keys[j]);
+      hashes.emplace_back(hashByKey);
+
+      Bucket const& b = _buckets[hashByKey & _bucketsMask];
+      TRI_PREFETCH(&b._table[hashToIndex(hashByKey) % b._nrAlloc]);
+    }
+
+    result.clear();
+    result.resize(numKeys);
+
+    for (size_t j = 0; j < numKeys; ++j) {
+      uint64_t const hashByKey = hashes[j];
+      Key const* key = keys[j];
+      Bucket const& b = _buckets[hashByKey & _bucketsMask];
+      IndexType i = hashToIndex(hashByKey) % b._nrAlloc;
+
+#ifdef TRI_INTERNAL_STATS
+      // update statistics
+      _nrFinds++;
+#endif
+
+      // search the table
+      while (b._table[i].ptr != nullptr &&
+             (b._table[i].prev != INVALID_INDEX ||
+              (useHashCache && b._table[i].readHashCache() != hashByKey) ||
+              !_isEqualKeyElement(userData, key, b._table[i].ptr))) {
+        i = incr(b, i);
+#ifdef TRI_INTERNAL_STATS
+        _nrProbesF++;
+#endif
+      }
+
+      if (b._table[i].ptr != nullptr) {
+        // We found the beginning of the linked list:
+        auto& found = result[j];
+
+        do {
+          found.push_back(b._table[i].ptr);
+          i = b._table[i].next;
+        } while (i != INVALID_INDEX);
+      }
+    }
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief looks up all elements with the same key as a given element
   //////////////////////////////////////////////////////////////////////////////
@@ -530,6 +530,66 @@ class AssocUnique {
     return b._table[i];
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief finds the elements for multiple keys at once. the result will
+  /// contain one entry per key, which is NULL if the key was not found.
+  /// the hashes of all keys are computed first and the table slots they map
+  /// to are prefetched, so that the cache misses of the individual lookups
+  /// overlap instead of being serialized
+  //////////////////////////////////////////////////////////////////////////////
+
+  void findByKeys(UserData* userData, std::vector<Key const*> const& keys,
+                  std::vector<Element*>& result) const {
+    size_t const numKeys = keys.size();
+    std::vector<uint64_t> hashes;
+    hashes.reserve(numKeys);
+
+    for (size_t j = 0; j < numKeys; ++j) {
+      uint64_t hash = _hashKey(userData, keys[j]);
+      hashes.emplace_back(hash);
+
+      Bucket const& b = _buckets[hash & _bucketsMask];
+      TRI_PREFETCH(&b._table[hash % b._nrAlloc]);
+    }
+
+    // the slots are hopefully in the cache now. prefetch the elements
+    // they point to, as the key comparison will need them
+    for (size_t j = 0; j < numKeys; ++j) {
+      Bucket const& b = _buckets[hashes[j] & _bucketsMask];
+      Element const* element = b._table[hashes[j] % b._nrAlloc];
+
+      if (element != nullptr) {
+        TRI_PREFETCH(element);
+      }
+    }
+
+    result.clear();
+    result.reserve(numKeys);
+
+    for (size_t j = 0; j < numKeys; ++j) {
+      uint64_t const hash = hashes[j];
+      Key const* key = keys[j];
+      Bucket const& b = _buckets[hash & _bucketsMask];
+
+      uint64_t const n = b._nrAlloc;
+      uint64_t i = hash % n;
+      uint64_t k = i;
+
+      for (; i < n && b._table[i] != nullptr &&
+                 !_isEqualKeyElement(userData, key, hash, b._table[i]);
+           ++i)
+        ;
+      if (i == n) {
+        for (i = 0; i < k && b._table[i] != nullptr &&
+                        !_isEqualKeyElement(userData, key, hash, b._table[i]);
+             ++i)
+          ;
+      }
+
+      result.emplace_back(b._table[i]);
+    }
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief adds an element to the array
   //////////////////////////////////////////////////////////////////////////////
@@ -923,6 +983,46 @@ class AssocUnique {
     }
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the number of buckets
+  //////////////////////////////////////////////////////////////////////////////
+
+  size_t numberBuckets() const { return _buckets.size(); }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief returns the number of slots of a bucket
+  //////////////////////////////////////////////////////////////////////////////
+
+  uint64_t bucketSize(size_t bucketId) const {
+    return _buckets[bucketId]._nrAlloc;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a method to iterate over the elements in the slots [position,
+  ///        end) of a bucket. Different ranges can be iterated over by
+  ///        different threads at the same time.
+  ///        Returns nullptr if all elements of the range have been returned.
+  //////////////////////////////////////////////////////////////////////////////
+
+  Element* findSequentialInRange(UserData* userData, size_t bucketId,
+                                 uint64_t& position, uint64_t end) const {
+    Bucket const& b = _buckets[bucketId];
+
+    if (end > b._nrAlloc) {
+      end = b._nrAlloc;
+    }
+
+    while (position < end) {
+      Element* found = b._table[position++];
+
+      if (found != nullptr) {
+        return found;
+      }
+    }
+
+    return nullptr;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief a method to iterate over all elements in the index in
   ///        reversed sequential order.
@@ -231,6 +231,17 @@ static inline uint32_t TRI_64to32(uint64_t x) {
 #define TRI_ALIGNAS(x) alignas(x)
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hint the CPU to load the cache line at the given address for
+/// reading. this is a no-op on compilers without a prefetch intrinsic
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TRI_PREFETCH(addr) __builtin_prefetch((addr), 0, 1)
+#else
+#define TRI_PREFETCH(addr) do { } while (0)
+#endif
+
 // -----------------------------------------------------------------------------
 // --SECTIONS--                                               deferred execution
 // -----------------------------------------------------------------------------
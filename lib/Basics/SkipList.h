@@ -222,6 +222,20 @@ class SkipList {
     return nullptr == node ? _end : node->_prev;
   }
 
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the successor node on a level or nullptr if there is
+  /// none. a level links the nodes higher than the level, which are about
+  /// every 2^level-th node. the level must be less than height()
+  //////////////////////////////////////////////////////////////////////////////
+
+  Node* nextNode(Node* node, int level) const { return node->_next[level]; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the number of levels of the skiplist
+  //////////////////////////////////////////////////////////////////////////////
+
+  int height() const { return _start->_height; }
+
   //////////////////////////////////////////////////////////////////////////////
   /// @brief inserts a new document into a skiplist
   ///
@@ -31,6 +31,7 @@
 #include <deque>
 #include <functional>
 #include <mutex>
+#include <queue>
 #include <stack>
 #include <thread>
 
@@ -1089,6 +1090,312 @@ class PathFinder {
   bool _bidirectional;
 };
 
+template <typename VertexId, typename EdgeId, typename EdgeWeight>
+class KShortestPathsFinder {
+  // This class enumerates the loopless paths between a start and a
+  // target vertex in the order of increasing weight (Yen's algorithm).
+  // The first path is the shortest path. Every further path leaves an
+  // already returned path at some vertex of it (the spur vertex) and
+  // continues with the shortest path from there to the target that
+  // neither visits a vertex before the spur vertex again nor leaves it
+  // by an edge already taken by a returned path with the same prefix.
+  // These spur paths are computed with the PathFinder, and the candidate
+  // paths wait in a PriorityQueue until they are the lightest one left.
+  // Paths are only computed when next() is called, so a caller that stops
+  // after k paths does no work for the (k + 1)th path. The expanders must
+  // report every edge of a vertex, including parallel edges.
+
+ public:
+  typedef PathFinder<VertexId, EdgeId, EdgeWeight> Finder;
+  typedef typename Finder::Path Path;
+  typedef typename Finder::Step Step;
+  typedef typename Finder::ExpanderFunction ExpanderFunction;
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a candidate path in the priority queue
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Candidate {
+    size_t _id;
+    Path* _path;
+
+    Candidate(size_t id, Path* path) : _id(id), _path(path) {}
+
+    ~Candidate() { delete _path; }
+
+    EdgeWeight weight() const { return _path->weight; }
+
+    void setWeight(EdgeWeight w) { _path->weight = w; }
+
+    size_t const& getKey() const { return _id; }
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief a returned path, with the weight of its prefixes. _prefix[i] is
+  /// the weight of the first i edges
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Result {
+    std::unique_ptr<Path> _path;
+    std::vector<EdgeWeight> _prefix;
+  };
+
+ public:
+  KShortestPathsFinder(KShortestPathsFinder const&) = delete;
+  KShortestPathsFinder& operator=(KShortestPathsFinder const&) = delete;
+  KShortestPathsFinder() = delete;
+
+  KShortestPathsFinder(ExpanderFunction forwardExpander,
+                       ExpanderFunction backwardExpander, VertexId const& start,
+                       VertexId const& target)
+      : _forwardExpander(forwardExpander),
+        _backwardExpander(backwardExpander),
+        _start(start),
+        _target(target),
+        _nextId(0),
+        _done(false) {}
+
+  ~KShortestPathsFinder() {}
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief return the next path, nullptr if there are no more paths. The
+  /// path belongs to the finder and stays valid as long as the finder lives
+  //////////////////////////////////////////////////////////////////////////////
+
+  Path const* next() {
+    if (_done) {
+      return nullptr;
+    }
+
+    if (_results.empty()) {
+      std::unordered_set<VertexId> noVertices;
+      std::unordered_set<EdgeId> noEdges;
+      Path* path = spurPath(_start, noVertices, noEdges);
+      if (path == nullptr) {
+        _done = true;
+        return nullptr;
+      }
+      return accept(path);
+    }
+
+    addCandidates(_results.back()._path.get());
+
+    size_t id;
+    Candidate* candidate;
+    if (!_candidates.popMinimal(id, candidate)) {
+      _done = true;
+      return nullptr;
+    }
+
+    std::unique_ptr<Candidate> guard(candidate);
+    Path* path = candidate->_path;
+    candidate->_path = nullptr;
+    return accept(path);
+  }
+
+ private:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the shortest path from a spur vertex to the target that avoids
+  /// the given vertices and edges, nullptr if there is none
+  //////////////////////////////////////////////////////////////////////////////
+
+  Path* spurPath(VertexId const& spur,
+                 std::unordered_set<VertexId> const& vertices,
+                 std::unordered_set<EdgeId> const& edges) {
+    Finder finder(filter(_forwardExpander, vertices, edges),
+                  filter(_backwardExpander, vertices, edges), true);
+    VertexId start(spur);
+    VertexId target(_target);
+    return finder.shortestPath(start, target);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief wrap an expander to skip the given vertices and edges. Only the
+  /// lightest edge to every neighbor is kept, as the PathFinder does not
+  /// replace the edge of a step when it finds a lighter one
+  //////////////////////////////////////////////////////////////////////////////
+
+  static ExpanderFunction filter(ExpanderFunction const& expander,
+                                 std::unordered_set<VertexId> const& vertices,
+                                 std::unordered_set<EdgeId> const& edges) {
+    return [&expander, &vertices, &edges](VertexId& v,
+                                          std::vector<Step*>& result) {
+      std::vector<Step*> steps;
+      expander(v, steps);
+
+      std::unordered_map<VertexId, size_t> candidates;
+      for (Step* step : steps) {
+        if (vertices.find(step->_vertex) != vertices.end() ||
+            edges.find(step->_edge) != edges.end()) {
+          delete step;
+          continue;
+        }
+        auto it = candidates.find(step->_vertex);
+        if (it == candidates.end()) {
+          candidates.emplace(step->_vertex, result.size());
+          result.emplace_back(step);
+        } else if (step->weight() < result[it->second]->weight()) {
+          delete result[it->second];
+          result[it->second] = step;
+        } else {
+          delete step;
+        }
+      }
+    };
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compute the spur paths of the last returned path
+  //////////////////////////////////////////////////////////////////////////////
+
+  void addCandidates(Path const* last) {
+    std::equal_to<VertexId> eqVertex;
+    std::equal_to<EdgeId> eqEdge;
+    Result const& lastResult = _results.back();
+
+    std::unordered_set<VertexId> vertices;
+    std::unordered_set<EdgeId> edges;
+
+    for (size_t i = 0; i + 1 < last->vertices.size(); ++i) {
+      // the edges by which returned paths with the same prefix leave the
+      // spur vertex
+      edges.clear();
+      for (auto const& result : _results) {
+        Path const* other = result._path.get();
+        if (other->edges.size() <= i) {
+          continue;
+        }
+        bool samePrefix = true;
+        for (size_t j = 0; j < i && samePrefix; ++j) {
+          samePrefix = eqEdge(other->edges[j], last->edges[j]);
+        }
+        if (samePrefix && eqVertex(other->vertices[i], last->vertices[i])) {
+          edges.emplace(other->edges[i]);
+        }
+      }
+
+      std::unique_ptr<Path> spur(spurPath(last->vertices[i], vertices, edges));
+
+      // the prefix must not be visited again by later spur paths
+      vertices.emplace(last->vertices[i]);
+
+      if (spur == nullptr) {
+        continue;
+      }
+
+      std::deque<VertexId> pathVertices(last->vertices.begin(),
+                                        last->vertices.begin() + i);
+      pathVertices.insert(pathVertices.end(), spur->vertices.begin(),
+                          spur->vertices.end());
+      std::deque<EdgeId> pathEdges(last->edges.begin(),
+                                   last->edges.begin() + i);
+      pathEdges.insert(pathEdges.end(), spur->edges.begin(),
+                       spur->edges.end());
+
+      size_t hash = hashEdges(pathEdges);
+      if (isKnown(hash, pathEdges)) {
+        continue;
+      }
+
+      std::unique_ptr<Candidate> candidate(new Candidate(
+          _nextId++, new Path(pathVertices, pathEdges,
+                              lastResult._prefix[i] + spur->weight)));
+      _known.emplace(hash, candidate->_path);
+      _candidates.insert(candidate->_id, candidate.get());
+      candidate.release();
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief remember a path as returned and compute the weights of its
+  /// prefixes, which are needed for its spur paths
+  //////////////////////////////////////////////////////////////////////////////
+
+  Path const* accept(Path* path) {
+    Result result;
+    result._path.reset(path);
+
+    if (_results.empty()) {
+      _known.emplace(hashEdges(path->edges), path);
+    }
+
+    std::equal_to<EdgeId> eq;
+    result._prefix.reserve(path->vertices.size());
+    result._prefix.emplace_back(0);
+    for (size_t i = 0; i < path->edges.size(); ++i) {
+      std::vector<Step*> steps;
+      VertexId v(path->vertices[i]);
+      _forwardExpander(v, steps);
+      EdgeWeight weight = 0;
+      for (Step* step : steps) {
+        if (eq(step->_edge, path->edges[i])) {
+          weight = step->weight();
+        }
+        delete step;
+      }
+      result._prefix.emplace_back(result._prefix.back() + weight);
+    }
+
+    _results.emplace_back(std::move(result));
+    return path;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether a path with these edges was found before
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool isKnown(size_t hash, std::deque<EdgeId> const& edges) const {
+    std::equal_to<EdgeId> eq;
+    auto range = _known.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (edges.size() == it->second->edges.size() &&
+          std::equal(edges.begin(), edges.end(), it->second->edges.begin(),
+                     eq)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static size_t hashEdges(std::deque<EdgeId> const& edges) {
+    std::hash<EdgeId> hasher;
+    size_t hash = edges.size();
+    for (auto const& e : edges) {
+      hash ^= hasher(e) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+
+ private:
+  ExpanderFunction _forwardExpander;
+  ExpanderFunction _backwardExpander;
+  VertexId _start;
+  VertexId _target;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the paths returned so far, in order
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<Result> _results;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the candidates for the next path, by weight
+  //////////////////////////////////////////////////////////////////////////////
+
+  PriorityQueue<size_t, Candidate, EdgeWeight> _candidates;
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief all returned paths and candidates, by the hash of their edges
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::unordered_multimap<size_t, Path const*> _known;
+
+  size_t _nextId;
+
+  bool _done;
+};
+
 template <typename edgeIdentifier, typename vertexIdentifier>
 struct EnumeratedPath {
   std::vector<edgeIdentifier> edges;
@@ -1376,6 +1683,216 @@ class ConstDistanceFinder {
     return nullptr;
   }
 };
+
+template <typename EdgeWeight>
+class ShortestPathTree {
+  // This class computes the shortest paths from a single source vertex
+  // to all vertices reachable from it. Vertices are identified by their
+  // position 0..n-1 in a graph the caller has numbered densely, and the
+  // neighbors of a vertex are provided by an expander function that
+  // returns a range of Neighbor entries. Unweighted graphs are
+  // searched breadth first, weighted ones with Dijkstra's algorithm,
+  // so all weights must be non-negative.
+  // Besides the distances, the tree keeps the number of shortest paths
+  // to every vertex, its predecessors on these paths and the order in
+  // which the vertices were settled, which is everything needed for
+  // Brandes' betweenness accumulation.
+  // An instance can be reused for many sources, and resetting it only
+  // costs time proportional to the vertices reached by the previous
+  // search. It must not be shared between threads.
+
+ public:
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief an outgoing edge of a vertex
+  //////////////////////////////////////////////////////////////////////////////
+
+  struct Neighbor {
+    size_t vertex;
+    EdgeWeight weight;
+
+    Neighbor(size_t vertex, EdgeWeight weight)
+        : vertex(vertex), weight(weight) {}
+  };
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief callback to find neighbours, sets [begin, end) to the
+  /// neighbors of the vertex
+  //////////////////////////////////////////////////////////////////////////////
+
+  typedef std::function<void(size_t vertex, Neighbor const*& begin,
+                             Neighbor const*& end)> ExpanderFunction;
+
+ private:
+  typedef std::pair<EdgeWeight, size_t> QueueEntry;
+
+  ExpanderFunction _expander;
+
+  bool const _weighted;
+
+  std::vector<EdgeWeight> _distances;
+
+  std::vector<double> _paths;
+
+  std::vector<std::vector<size_t>> _predecessors;
+
+  std::vector<bool> _settled;
+
+  std::vector<size_t> _order;
+
+ public:
+  ShortestPathTree(size_t numVertices, bool weighted, ExpanderFunction expander)
+      : _expander(expander),
+        _weighted(weighted),
+        _distances(numVertices, 0),
+        _paths(numVertices, 0.0),
+        _predecessors(numVertices),
+        _settled(numVertices, false) {
+    _order.reserve(numVertices);
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief compute the shortest paths starting at source
+  //////////////////////////////////////////////////////////////////////////////
+
+  void compute(size_t source) {
+    TRI_ASSERT(source < _paths.size());
+    reset();
+
+    _distances[source] = 0;
+    _paths[source] = 1.0;
+
+    if (_weighted) {
+      dijkstra(source);
+    } else {
+      breadthFirst(source);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the reached vertices by ascending distance from the source,
+  /// starting with the source itself
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<size_t> const& order() const { return _order; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief whether or not the vertex was reached from the source
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool reached(size_t vertex) const { return _paths[vertex] > 0.0; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief distance of a reached vertex from the source
+  //////////////////////////////////////////////////////////////////////////////
+
+  EdgeWeight distance(size_t vertex) const { return _distances[vertex]; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief number of distinct shortest paths from the source to the vertex.
+  /// this is a double because the number grows exponentially in some graphs
+  //////////////////////////////////////////////////////////////////////////////
+
+  double paths(size_t vertex) const { return _paths[vertex]; }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief the vertices preceding the vertex on its shortest paths
+  //////////////////////////////////////////////////////////////////////////////
+
+  std::vector<size_t> const& predecessors(size_t vertex) const {
+    return _predecessors[vertex];
+  }
+
+ private:
+  void reset() {
+    for (auto const& v : _order) {
+      _paths[v] = 0.0;
+      _predecessors[v].clear();
+      _settled[v] = false;
+    }
+    _order.clear();
+  }
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// @brief relax the edge from vertex to neighbor, returns true if the
+  /// distance of the neighbor was decreased
+  //////////////////////////////////////////////////////////////////////////////
+
+  bool relax(size_t vertex, Neighbor const& neighbor) {
+    size_t const w = neighbor.vertex;
+    EdgeWeight const d = _distances[vertex] + neighbor.weight;
+
+    if (_paths[w] == 0.0 || d < _distances[w]) {
+      _distances[w] = d;
+      _paths[w] = _paths[vertex];
+      _predecessors[w].clear();
+      _predecessors[w].emplace_back(vertex);
+      return true;
+    }
+    if (d == _distances[w]) {
+      _paths[w] += _paths[vertex];
+      _predecessors[w].emplace_back(vertex);
+    }
+    return false;
+  }
+
+  void breadthFirst(size_t source) {
+    _settled[source] = true;
+    _order.emplace_back(source);
+
+    // _order doubles as the queue of the search
+    Neighbor const* begin;
+    Neighbor const* end;
+    for (size_t i = 0; i < _order.size(); ++i) {
+      size_t const v = _order[i];
+      _expander(v, begin, end);
+      for (; begin != end; ++begin) {
+        size_t const w = begin->vertex;
+        if (_settled[w]) {
+          if (_distances[w] == _distances[v] + 1) {
+            _paths[w] += _paths[v];
+            _predecessors[w].emplace_back(v);
+          }
+          continue;
+        }
+        _settled[w] = true;
+        _distances[w] = _distances[v] + 1;
+        _paths[w] = _paths[v];
+        _predecessors[w].emplace_back(v);
+        _order.emplace_back(w);
+      }
+    }
+  }
+
+  void dijkstra(size_t source) {
+    // entries are not updated in place. a vertex is pushed again whenever
+    // its distance decreases, and outdated entries are skipped when popped
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                        std::greater<QueueEntry>> queue;
+    queue.emplace(0, source);
+
+    Neighbor const* begin;
+    Neighbor const* end;
+    while (!queue.empty()) {
+      size_t const v = queue.top().second;
+      queue.pop();
+      if (_settled[v]) {
+        continue;
+      }
+      _settled[v] = true;
+      _order.emplace_back(v);
+
+      _expander(v, begin, end);
+      for (; begin != end; ++begin) {
+        if (_settled[begin->vertex]) {
+          continue;
+        }
+        if (relax(v, *begin)) {
+          queue.emplace(_distances[begin->vertex], begin->vertex);
+        }
+      }
+    }
+  }
+};
 }
 }
 
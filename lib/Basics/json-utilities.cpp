@@ -186,6 +186,33 @@ static TRI_json_t* GetMergedKeyArray(TRI_json_t const* lhs,
   return TRI_UniquifyArrayJson(keys.get());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compare two strings the way TRI_CompareValuesJson does
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_CompareStringValuesJson(char const* left, size_t nl,
+                                char const* right, size_t nr, bool useUTF8) {
+  int res;
+  if (useUTF8) {
+    res = TRI_compare_utf8(left, nl, right, nr);
+  } else {
+    // beware of strings containing NUL bytes
+    size_t len = nl < nr ? nl : nr;
+    res = memcmp(left, right, len);
+  }
+  if (res < 0) {
+    return -1;
+  } else if (res > 0) {
+    return 1;
+  }
+  // res == 0
+  if (nl == nr) {
+    return 0;
+  }
+  // res == 0, but different string lengths
+  return nl < nr ? -1 : 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief compare two json values
 ////////////////////////////////////////////////////////////////////////////////
@@ -254,28 +281,9 @@ int TRI_CompareValuesJson(TRI_json_t const* lhs, TRI_json_t const* rhs,
       // same for STRING and STRING_REFERENCE
       TRI_ASSERT(lhs->_value._string.data != nullptr);
       TRI_ASSERT(rhs->_value._string.data != nullptr);
-      int res;
-      size_t const nl = lhs->_value._string.length - 1;
-      size_t const nr = rhs->_value._string.length - 1;
-      if (useUTF8) {
-        res = TRI_compare_utf8(lhs->_value._string.data, nl,
-                               rhs->_value._string.data, nr);
-      } else {
-        // beware of strings containing NUL bytes
-        size_t len = nl < nr ? nl : nr;
-        res = memcmp(lhs->_value._string.data, rhs->_value._string.data, len);
-      }
-      if (res < 0) {
-        return -1;
-      } else if (res > 0) {
-        return 1;
-      }
-      // res == 0
-      if (nl == nr) {
-        return 0;
-      }
-      // res == 0, but different string lengths
-      return nl < nr ? -1 : 1;
+      return TRI_CompareStringValuesJson(
+          lhs->_value._string.data, lhs->_value._string.length - 1,
+          rhs->_value._string.data, rhs->_value._string.length - 1, useUTF8);
     }
 
     case TRI_JSON_ARRAY: {
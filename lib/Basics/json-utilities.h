@@ -43,6 +43,14 @@
 int TRI_CompareValuesJson(TRI_json_t const*, TRI_json_t const*,
                           bool useUTF8 = true);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compare two strings the way TRI_CompareValuesJson compares string
+/// values, returns -1, 0 or 1
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_CompareStringValuesJson(char const*, size_t, char const*, size_t,
+                                bool useUTF8 = true);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief check if two json values are the same
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,6 +36,7 @@ void TRI_InitializeErrorMessages () {
   REG_ERROR(ERROR_FILE_EXISTS, "file exists");
   REG_ERROR(ERROR_LOCKED, "locked");
   REG_ERROR(ERROR_DEADLOCK, "deadlock detected");
+  REG_ERROR(ERROR_RESOURCE_LIMIT, "resource limit exceeded");
   REG_ERROR(ERROR_HTTP_BAD_PARAMETER, "bad parameter");
   REG_ERROR(ERROR_HTTP_UNAUTHORIZED, "unauthorized");
   REG_ERROR(ERROR_HTTP_FORBIDDEN, "forbidden");
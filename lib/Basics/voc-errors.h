@@ -70,6 +70,9 @@
 ///   Will be raised when a resource or an operation is locked.
 /// - 29: @LIT{deadlock detected}
 ///   Will be raised when a deadlock is detected when accessing collections.
+/// - 30: @LIT{resource limit exceeded}
+///   Will be raised when a resource limit, e.g. the memory limit of a query,
+///   is exceeded.
 /// - 400: @LIT{bad parameter}
 ///   Will be raised when the HTTP request does not fulfill the requirements.
 /// - 401: @LIT{unauthorized}
@@ -948,6 +951,17 @@ void TRI_InitializeErrorMessages ();
 
 #define TRI_ERROR_DEADLOCK                                                (29)
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief 30: ERROR_RESOURCE_LIMIT
+///
+/// resource limit exceeded
+///
+/// Will be raised when a resource limit, e.g. the memory limit of a query, is
+/// exceeded.
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_ERROR_RESOURCE_LIMIT                                          (30)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief 400: ERROR_HTTP_BAD_PARAMETER
 ///